@@ -21,6 +21,8 @@ extern "C" {
 #include "EbDebugMacros.h"
 
 struct SvtMetadataArray;
+struct SvtAv1RoiMap;
+struct SvtAv1FrameStats;
 
 // API Version
 #define SVT_AV1_VERSION_MAJOR 0
@@ -127,6 +129,14 @@ typedef struct EbBufferHeaderType {
     double cb_ssim;
 
     struct SvtMetadataArray *metadata;
+
+    // region of interest map of an input picture, read only when the
+    // encoder enable_roi_map is set
+    struct SvtAv1RoiMap *roi_map;
+
+    // statistics of an output packet, set when the encoder enable_frame_stats
+    // is set
+    struct SvtAv1FrameStats *frame_stats;
 } EbBufferHeaderType;
 
 typedef struct EbComponentType {
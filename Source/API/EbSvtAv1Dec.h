@@ -113,7 +113,9 @@ typedef struct EbSvtAv1DecConfiguration {
     uint32_t threads;
 
     /* Number of frames that can be processed
-       in parallel. Default is 1 */
+       in parallel. The threads are shared between the frames,
+       with at least 2 threads per frame. Output pictures are
+       delayed by num_p_frames - 1 frames. Default is 1 */
     uint32_t num_p_frames;
 
     // Application Specific parameters
@@ -140,6 +142,18 @@ typedef struct EbSvtAv1DecConfiguration {
  *
  * Default is 0. */
     Bool is_16bit_pipeline;
+
+    /* External frame buffer allocator. When both callbacks are set, the reference
+     * and output picture buffers are allocated through them and
+     * svt_av1_dec_get_picture() returns the decoded picture without copying it.
+     * The returned picture is read only and stays valid until it is given back
+     * with svt_av1_dec_release_picture().
+     *
+     * Default is NULL, the output picture is copied to the application buffer. */
+    EbAllocateFrameBuffer allocate_frame_buffer;
+    EbReleaseFrameBuffer  release_frame_buffer;
+    /* Private data passed to the frame buffer callbacks */
+    void *frame_buffer_private_data;
 } EbSvtAv1DecConfiguration;
 
 /* STEP 1: Call the library to construct a Component Handle.
@@ -177,7 +191,18 @@ EB_API EbErrorType svt_av1_dec_init(EbComponentType *svt_dec_component);
      * @ *data                  Buffer with data
      * @ data_size              Data size in bytes
      *
-     *  Returns EB_ErrorNone if the coded data has been processed successfully. */
+     * A NULL data or a data_size of 0 signals the end of the stream, after which
+     * svt_av1_dec_get_picture() returns the pictures still in flight.
+     *
+     * Shown frames are never dropped: all the pictures ready for output should be
+     * taken with svt_av1_dec_get_picture() before the next call.
+     *
+     *  Returns EB_ErrorNone if the coded data has been processed successfully.
+     *  With num_p_frames > 1, returns EB_ErrorInsufficientResources, without
+     *  consuming the data, if pictures ready for output have not been taken.
+     *  Otherwise a picture not taken is replaced by the next shown frame.
+     *  With frames decoded in parallel, the error of a frame may be returned by a
+     *  later call. */
 EB_API EbErrorType svt_av1_dec_frame(EbComponentType *svt_dec_component, const uint8_t *data,
                                      const size_t data_size, uint32_t is_annexb);
 
@@ -195,12 +220,25 @@ EB_API EbErrorType svt_av1_dec_frame(EbComponentType *svt_dec_component, const u
      *
      *  Returns EB_ErrorNone if the picture has been returned successfully.
      *  Returns EB_DecNoOutputPicture if the next output picture has not
-     *  been generated yet. Calling a decoding function is needed to generate more pictures. */
+     *  been generated yet. Calling a decoding function is needed to generate more pictures.
+     *  Returns an error code in place of a picture, or of a hidden frame, which failed
+     *  to decode; the next picture is returned by the next call. */
 EB_API EbErrorType svt_av1_dec_get_picture(EbComponentType    *svt_dec_component,
                                            EbBufferHeaderType *p_buffer,
                                            EbAV1StreamInfo    *stream_info,
                                            EbAV1FrameInfo     *frame_info);
 
+/* STEP 5-1: Give back a picture returned by svt_av1_dec_get_picture() when
+     * the external frame buffer allocator is used. The picture planes are then
+     * reused or released by the decoder. No-op when the output is copied.
+     * All the pictures should be given back before svt_av1_dec_deinit().
+     *
+     * Parameter:
+     * @ *svt_dec_component     Decoder handle.
+     * @ *p_buffer              Header pointer filled by svt_av1_dec_get_picture(). */
+EB_API EbErrorType svt_av1_dec_release_picture(EbComponentType    *svt_dec_component,
+                                               EbBufferHeaderType *p_buffer);
+
 /* STEP 6: Deinitialize decoder library.
      *
      * Parameter:
@@ -142,6 +142,8 @@ typedef enum SvtAv1IntraRefreshType {
 typedef enum {
     SVT_AV1_STREAM_INFO_START                = 1,
     SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_OUT = SVT_AV1_STREAM_INFO_START,
+    SVT_AV1_STREAM_INFO_INPUT_LAYOUT,
+    SVT_AV1_STREAM_INFO_PIPELINE_STATS,
 
     SVT_AV1_STREAM_INFO_END,
 } SVT_AV1_STREAM_INFO_ID;
@@ -155,6 +157,191 @@ typedef struct SvtAv1FixedBuf {
     uint64_t sz; /**< Length of the buffer, in chars */
 } SvtAv1FixedBuf; /**< alias for struct aom_fixed_buf */
 
+#define SVT_AV1_STATS_MAGIC 0x53545653 /**< "SVTS" in a little endian file */
+#define SVT_AV1_STATS_VERSION 1
+
+/*!\brief Header of a multi-pass statistics file
+ *
+ * A statistics file starts with this header, followed by frame_count
+ * records of record_size bytes, one per frame in display order, and one
+ * record holding the totals of the sequence.  The record of frame n is at
+ * header_size + n * record_size, so a range of frames can be read or
+ * mapped without touching the rest of the file, see
+ * svt_av1_enc_map_stats().
+ */
+typedef struct SvtAv1StatsHeader {
+    uint32_t magic; /**< SVT_AV1_STATS_MAGIC */
+    uint16_t version; /**< SVT_AV1_STATS_VERSION */
+    uint16_t header_size; /**< offset of the first frame record, in bytes */
+    uint32_t record_size; /**< size of one record, in bytes */
+    uint32_t reserved;
+    uint64_t frame_count; /**< number of frame records, excluding the totals */
+    uint64_t reserved1;
+} SvtAv1StatsHeader;
+
+/*!\brief Encoder settings that can change while encoding
+ *
+ * Passed to svt_av1_enc_reconfigure(), the changes apply from the next
+ * picture sent to the encoder, without a key frame.  A field left to 0
+ * keeps its current value.
+ */
+typedef struct SvtAv1EncReconfig {
+    /* Target bitrate in bits/second, VBR and CBR only.  With VBR, the bits
+     * not yet spent of the sequence, key frame and GF group budgets are
+     * scaled to the new rate. */
+    uint32_t target_bit_rate;
+    /* Maximum bitrate in bits/second, only when a maximum bitrate was
+     * configured. */
+    uint32_t max_bit_rate;
+    /* Client buffer size in ms, CBR only. */
+    int64_t maximum_buffer_size_ms;
+    /* Coded width scaling denominator [8-16] of all the frames, 8 is the
+     * full width.  The frames are coded at a reduced width and upscaled
+     * (super-resolution), which needs superres_mode SUPERRES_FIXED and
+     * superres_reconfig. */
+    uint8_t superres_denom;
+} SvtAv1EncReconfig;
+
+/*!\brief Region of interest map of one picture
+ *
+ * Attached to the picture through EbBufferHeaderType.roi_map when
+ * enable_roi_map is set.  The map has one entry per 64x64 block of the
+ * picture in raster order, ((width + 63) / 64) * ((height + 63) / 64)
+ * entries.  The encoder copies the map in svt_av1_enc_send_picture().
+ */
+typedef struct SvtAv1RoiMap {
+    /* Number of entries of the arrays, must match the picture size. */
+    uint32_t b64_count;
+    /* qindex offset [-255, 255] of each block, relative to the frame qindex
+     * picked by the rate control.  A picture can use at most 8 distinct
+     * offsets (AV1 segments). */
+    int16_t *qp_offset;
+    /* Optional, NULL or nonzero for the blocks known to be static.  Mode
+     * decision only tests 64x64 partitions for these blocks in inter
+     * pictures. */
+    uint8_t *skip;
+} SvtAv1RoiMap;
+
+/*!\brief Statistics of one coded frame
+ *
+ * Attached to the output packets through EbBufferHeaderType.frame_stats when
+ * enable_frame_stats is set, NULL otherwise.  The statistics describe the
+ * frame coded last in the packet, or the shown frame of a show existing
+ * packet.  They are owned by the packet and stay valid until
+ * svt_av1_enc_release_out_buffer().
+ */
+typedef struct SvtAv1FrameStats {
+    uint64_t picture_number; /**< display order of the frame */
+    uint32_t temporal_layer_index;
+    uint32_t qindex; /**< base qindex of the frame */
+    uint32_t frame_size; /**< bytes of the frame, without the other frames of the packet */
+    /* Per plane (Y, Cb, Cr) quality, only computed with stat_report, 0
+     * otherwise. */
+    double psnr[3];
+    double ssim[3];
+    uint32_t  tile_count; /**< coded tiles of the frame */
+    uint32_t *tile_size; /**< bytes of each tile in raster order, tile_count entries */
+    /* Fractions of the coded area using intra blocks, inter blocks and
+     * blocks without residual (any mode). */
+    double intra_ratio;
+    double inter_ratio;
+    double skip_ratio;
+    /* Average motion vector length of the inter blocks, in pixels and
+     * weighted by the block area. */
+    double avg_mv_magnitude;
+    double tpl_r0; /**< TPL propagation factor, 0 when TPL does not cover the frame */
+    /* Lookahead analysis of the source picture, the only statistics filled with
+     * lookahead_only. */
+    Bool     scene_change; /**< a scene transition was detected at the frame (random access) */
+    uint32_t variance; /**< average variance of the 64x64 blocks, 0 when not computed */
+    /* Sum of the ME SAD of the 8x8 (up to 480p) or 16x16 blocks, 0 for intra
+     * frames. */
+    uint64_t me_sad;
+    double   tpl_beta; /**< average TPL beta of the superblocks, 1 when TPL does not cover the frame */
+    /* Wall-clock time between the pipeline hand-offs of the frame, in us.
+     * They include the waits in the queues, the sum is the encode latency of
+     * the frame. */
+    uint64_t analysis_time_us; /**< from svt_av1_enc_send_picture() to the end of ME */
+    uint64_t lookahead_time_us; /**< TPL and rate control, until the frame qindex is set */
+    uint64_t encode_time_us; /**< mode decision and reconstruction, including the recodes */
+    uint64_t filter_time_us; /**< deblocking, CDEF and loop restoration */
+    uint64_t entropy_time_us; /**< entropy coding, until the packetization */
+} SvtAv1FrameStats;
+
+/*!\brief Input picture layout for zero-copy input
+ *
+ * Returned by svt_av1_enc_get_stream_info(SVT_AV1_STREAM_INFO_INPUT_LAYOUT).
+ * The application allocates each plane with luma_size / chroma_size bytes,
+ * using the given strides, and points the EbSvtIOFormat luma/cb/cr pointers
+ * at (origin_x, origin_y) inside those buffers (origin halved for chroma
+ * according to the subsampling).  The encoder pads and filters the picture
+ * in place, so the buffers must stay untouched until release_input_picture
+ * is called for them.
+ */
+typedef struct SvtAv1InputLayout {
+    uint32_t y_stride; /**< luma stride, in pixels */
+    uint32_t uv_stride; /**< chroma stride, in pixels */
+    uint32_t origin_x; /**< luma horizontal offset of the visible picture */
+    uint32_t origin_y; /**< luma vertical offset of the visible picture */
+    uint64_t luma_size; /**< bytes to allocate for the luma plane */
+    uint64_t chroma_size; /**< bytes to allocate for each chroma plane */
+} SvtAv1InputLayout;
+
+/*!\brief Encoder pipeline stages, see SvtAv1PipelineStats */
+typedef enum SvtAv1PipelineStage {
+    SVT_AV1_STAGE_RESOURCE_COORDINATION,
+    SVT_AV1_STAGE_PICTURE_ANALYSIS,
+    SVT_AV1_STAGE_PICTURE_DECISION,
+    SVT_AV1_STAGE_MOTION_ESTIMATION,
+    SVT_AV1_STAGE_INITIAL_RATE_CONTROL,
+    SVT_AV1_STAGE_SOURCE_BASED_OPERATIONS,
+    SVT_AV1_STAGE_TPL_DISPENSER,
+    SVT_AV1_STAGE_PICTURE_MANAGER,
+    SVT_AV1_STAGE_RATE_CONTROL,
+    SVT_AV1_STAGE_MODE_DECISION_CONFIGURATION,
+    SVT_AV1_STAGE_ENC_DEC,
+    SVT_AV1_STAGE_DLF,
+    SVT_AV1_STAGE_CDEF,
+    SVT_AV1_STAGE_REST,
+    SVT_AV1_STAGE_ENTROPY_CODING,
+    SVT_AV1_STAGE_PACKETIZATION,
+    SVT_AV1_STAGE_COUNT
+} SvtAv1PipelineStage;
+
+typedef struct SvtAv1StageStats {
+    uint32_t thread_count; /**< threads dedicated to the stage */
+    uint32_t queue_depth; /**< tasks waiting in the input queue of the stage */
+    uint32_t task_count; /**< tasks taken from the input queue so far */
+    uint64_t busy_time_us; /**< thread time spent out of the input queue wait, in us */
+    uint64_t idle_time_us; /**< thread time spent waiting for input tasks, in us */
+} SvtAv1StageStats;
+
+typedef struct SvtAv1PoolStats {
+    uint32_t total_count; /**< objects in the pool */
+    uint32_t in_use_count; /**< objects currently held by the pipeline */
+    uint64_t stall_time_us; /**< time spent waiting for a free object, in us */
+} SvtAv1PoolStats;
+
+/*!\brief Pipeline telemetry
+ *
+ * Returned by svt_av1_enc_get_stream_info(SVT_AV1_STREAM_INFO_PIPELINE_STATS)
+ * at any time after svt_av1_enc_init().  Times are cumulative since the end of
+ * svt_av1_enc_init(); sample twice and subtract to look at an interval.  The
+ * busy time of a stage includes the time its threads are blocked on a full
+ * output pool, the stall time of the pools tells how much of it that is.
+ * With enable_worker_pool the busy time also includes the pool workers.
+ */
+typedef struct SvtAv1PipelineStats {
+    uint64_t         elapsed_time_us; /**< time since the end of svt_av1_enc_init() */
+    SvtAv1StageStats stage[SVT_AV1_STAGE_COUNT];
+    SvtAv1PoolStats  input_pool; /**< input pictures, stalls block svt_av1_enc_send_picture() */
+    SvtAv1PoolStats  parent_pcs_pool; /**< picture_control_set_pool_init_count */
+    SvtAv1PoolStats  child_pcs_pool;
+    SvtAv1PoolStats  pa_reference_pool;
+    SvtAv1PoolStats  reference_pool;
+    SvtAv1PoolStats  output_stream_pool;
+} SvtAv1PipelineStats;
+
 // Will contain the EbEncApi which will live in the EncHandle class
 // Only modifiable during config-time.
 typedef struct EbSvtAv1EncConfiguration {
@@ -311,6 +498,24 @@ typedef struct EbSvtAv1EncConfiguration {
     // input / output buffer to be used for multi-pass encoding
     SvtAv1FixedBuf rc_stats_buffer;
     int            pass;
+    /* Chunked encoding, first frame of the chunk in the full sequence.
+     * The chunk must start on a key frame of the full sequence encode (closed
+     * GOP, fixed intra period, no scene change detection) and is encoded
+     * with the same GOP decisions. The frame numbers (order hints) and the
+     * two-pass stats (rc_stats_buffer holds the stats of the full sequence)
+     * continue from the full sequence, and the rate control budget of the
+     * chunk follows its first pass error relative to the full sequence, so
+     * that the streams of consecutive chunks can be concatenated.
+     *
+     * -1 = off, the input is the full sequence.
+     *
+     * Default is -1. */
+    int64_t chunk_start_frame;
+    /* Number of frames of the chunk, 0 for all the remaining frames of the
+     * stats.
+     *
+     * Default is 0. */
+    uint32_t chunk_frame_count;
 
     // Deblock Filter
 
@@ -448,6 +653,15 @@ typedef struct EbSvtAv1EncConfiguration {
      */
     uint32_t recode_loop;
 
+    /* Replace the recode of whole pictures by a recode of the remaining SB
+     * rows. The picture size is projected once the top SB rows are coded, the
+     * remaining rows are then coded with the q adjustment signalled through
+     * delta q. Only applies to pictures with a single tile group that could
+     * be recoded under recode_loop.
+     *
+     * Default is false. */
+    Bool sb_row_recode;
+
     /* Flag to signal the content being a screen sharing content type
     *
     * Default is 0. */
@@ -458,6 +672,30 @@ typedef struct EbSvtAv1EncConfiguration {
      * Default is 2. */
     uint8_t enable_adaptive_quantization;
 
+    /* Enable the per picture region of interest map, see SvtAv1RoiMap.  The
+     * map offsets are coded through segmentation, pictures with a map do not
+     * use the SB delta q of enable_adaptive_quantization 2.
+     *
+     * Default is 0. */
+    Bool enable_roi_map;
+
+    /* Attach a SvtAv1FrameStats to every output packet.  The statistics are
+     * allocated with the output buffers, the PSNR and SSIM need stat_report.
+     *
+     * Default is 0. */
+    Bool enable_frame_stats;
+
+    /* Stop the pipeline after the lookahead: resource coordination, picture
+     * analysis and decision, ME, TPL and the rate control run, mode decision,
+     * reconstruction, in-loop filtering and entropy coding do not.  The output
+     * packets have no usable bitstream, they carry the lookahead fields of
+     * SvtAv1FrameStats (enable_frame_stats is forced on).  Requires the CRF /
+     * CQP rate control, a single pass and no super-resolution, recon output or
+     * stat report; tiles are ignored.
+     *
+     * Default is 0. */
+    Bool lookahead_only;
+
     // Tresholds
 
     /**
@@ -552,6 +790,14 @@ typedef struct EbSvtAv1EncConfiguration {
      * Default is -1. */
     int32_t target_socket;
 
+    /* Run the parallel stages on a shared pool of worker threads. Each stage
+     * keeps one dedicated thread and the pool workers pick up the work of
+     * whichever stage has queued tasks, instead of sizing a thread array per
+     * stage.
+     *
+     * Default is false. */
+    Bool enable_worker_pool;
+
     // Debug tools
 
     /**
@@ -589,6 +835,13 @@ typedef struct EbSvtAv1EncConfiguration {
     uint8_t superres_qthres;
     uint8_t superres_kf_qthres;
     uint8_t superres_auto_search_type;
+    /* Allow svt_av1_enc_reconfigure() to change the super-resolution
+     * denominator while encoding, superres_mode must be SUPERRES_FIXED.
+     * SUPERRES_FIXED with denominators of 8 then stays on, instead of being
+     * turned off, so that the encode can start at full width.
+     *
+     * Default is false. */
+    Bool superres_reconfig;
 
     /**
      * @brief API signal containing the manual prediction structure parameters.
@@ -666,6 +919,22 @@ typedef struct EbSvtAv1EncConfiguration {
     */
 #endif
     uint8_t fast_decode;
+    /* Zero-copy input release callback
+    * When set, and the stream is eligible (8-bit input, see
+    * SVT_AV1_STREAM_INFO_INPUT_LAYOUT), svt_av1_enc_send_picture() references
+    * the application planes instead of copying them, and the callback is
+    * invoked once the encoder no longer reads them.  Otherwise the picture is
+    * copied and the callback is invoked before svt_av1_enc_send_picture()
+    * returns.  The callback runs on an encoder thread and must not call back
+    * into the encoder.  For referenced planes, the header passed to the
+    * callback is a copy made by svt_av1_enc_send_picture() holding the
+    * p_buffer, p_app_private and pts of the sent header, which can be reused
+    * as soon as svt_av1_enc_send_picture() returns.
+    Default is NULL. */
+    void (*release_input_picture)(EbBufferHeaderType *p_buffer, void *private_data);
+    /* Opaque pointer passed back to release_input_picture.
+    Default is NULL. */
+    void *release_input_private_data;
 } EbSvtAv1EncConfiguration;
 
 /**
@@ -740,6 +1009,16 @@ EB_API EbErrorType svt_av1_enc_stream_header_release(EbBufferHeaderType *stream_
 EB_API EbErrorType svt_av1_enc_send_picture(EbComponentType    *svt_enc_component,
                                             EbBufferHeaderType *p_buffer);
 
+/* OPTIONAL: Change the rate control target or the coded width while
+     * encoding, see SvtAv1EncReconfig.  Only for single pass encodes.
+     * Several calls between two pictures are merged.
+     *
+     * Parameter:
+     * @ *svt_enc_component  Encoder handler.
+     * @ *reconfig           changes, applied from the next picture sent. */
+EB_API EbErrorType svt_av1_enc_reconfigure(EbComponentType         *svt_enc_component,
+                                           const SvtAv1EncReconfig *reconfig);
+
 /* STEP 5: Receive packet.
      * Parameter:
     * @ *svt_enc_component  Encoder handler.
@@ -772,6 +1051,35 @@ EB_API EbErrorType svt_av1_get_recon(EbComponentType    *svt_enc_component,
 EB_API EbErrorType svt_av1_enc_get_stream_info(EbComponentType *svt_enc_component,
                                                uint32_t stream_info_id, void *info);
 
+/* OPTIONAL: Fill the header of a statistics file.
+     *
+     * Parameter:
+     * @ *header           output, to be written in front of the stats.
+     * @ *rc_stats_buffer  stats returned by svt_av1_enc_get_stream_info(
+     *                    SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_OUT). */
+EB_API void svt_av1_enc_init_stats_header(SvtAv1StatsHeader    *header,
+                                          const SvtAv1FixedBuf *rc_stats_buffer);
+
+/* OPTIONAL: Map a range of frames of a statistics file, to be passed as
+     * rc_stats_buffer.  Only the pages of the range are mapped, privately, so
+     * several encoders can share one file.  When the range does not cover
+     * the whole file, the totals record is recomputed over the range.
+     * Returns EB_ErrorBadParameter for a file without a valid header.
+     *
+     * Parameter:
+     * @ *path             statistics file.
+     * @ first_frame       first frame of the range.
+     * @ frame_count       frames in the range, 0 for all the remaining frames.
+     * @ *rc_stats_buffer  output, the records of the range and the totals. */
+EB_API EbErrorType svt_av1_enc_map_stats(const char *path, uint64_t first_frame,
+                                         uint64_t frame_count, SvtAv1FixedBuf *rc_stats_buffer);
+
+/* OPTIONAL: Release a buffer returned by svt_av1_enc_map_stats().
+     *
+     * Parameter:
+     * @ *rc_stats_buffer  buffer to release, reset to empty. */
+EB_API void svt_av1_enc_unmap_stats(SvtAv1FixedBuf *rc_stats_buffer);
+
 /* STEP 6: Deinitialize encoder library.
      *
      * Parameter:
@@ -60,6 +60,24 @@ int init_pic_buffer(EbSvtIOFormat *pic_buffer, CliInput *cli, EbSvtAv1DecConfigu
     return 0;
 }
 
+/* Frame buffers for the decoder, the decoded pictures are output from them */
+static int app_allocate_frame_buffer(EbExtFrameBuf *frame_buf, uint32_t min_size,
+                                     void *private_data) {
+    (void)private_data;
+    frame_buf->buffer       = (uint8_t *)malloc(min_size);
+    frame_buf->buffer_size  = frame_buf->buffer ? min_size : 0;
+    frame_buf->private_data = NULL;
+    return frame_buf->buffer ? 0 : -1;
+}
+
+static int app_release_frame_buffer(EbExtFrameBuf *frame_buf, void *private_data) {
+    (void)private_data;
+    free(frame_buf->buffer);
+    frame_buf->buffer      = NULL;
+    frame_buf->buffer_size = 0;
+    return 0;
+}
+
 int read_input_frame(DecInputContext *input, uint8_t **buffer, size_t *bytes_read,
                      size_t *buffer_size, int64_t *pts) {
     CliInput *cli = input->cli_ctx;
@@ -139,13 +157,14 @@ int32_t main(int32_t argc, char *argv[]) {
     EbSvtAv1DecConfiguration *config_ptr   = (EbSvtAv1DecConfiguration *)malloc(
         sizeof(EbSvtAv1DecConfiguration));
     CliInput cli;
-    cli.in_file     = NULL;
-    cli.out_file    = NULL;
-    cli.enable_md5  = 0;
-    cli.fps_frm     = 0;
-    cli.fps_summary = 0;
-    cli.width       = 0;
-    cli.height      = 0;
+    cli.in_file       = NULL;
+    cli.out_file      = NULL;
+    cli.enable_md5    = 0;
+    cli.fps_frm       = 0;
+    cli.fps_summary   = 0;
+    cli.ext_frame_buf = 0;
+    cli.width         = 0;
+    cli.height        = 0;
 
     DecInputContext    input   = {NULL, NULL};
     ObuDecInputContext obu_ctx = {NULL, 0, 0, 0, 0};
@@ -178,8 +197,12 @@ int32_t main(int32_t argc, char *argv[]) {
         goto fail;
     }
 
-    if (read_command_line(argc, argv, config_ptr, &cli, &obu_ctx) == 0 &&
-        !svt_av1_dec_set_parameter(p_handle, config_ptr)) {
+    int cli_error = read_command_line(argc, argv, config_ptr, &cli, &obu_ctx);
+    if (cli.ext_frame_buf) {
+        config_ptr->allocate_frame_buffer = app_allocate_frame_buffer;
+        config_ptr->release_frame_buffer  = app_release_frame_buffer;
+    }
+    if (cli_error == 0 && !svt_av1_dec_set_parameter(p_handle, config_ptr)) {
         return_error = svt_av1_dec_init(p_handle);
         if (return_error != EB_ErrorNone) {
             return_error |= svt_av1_dec_deinit_handle(p_handle);
@@ -204,9 +227,18 @@ int32_t main(int32_t argc, char *argv[]) {
         int size = (config_ptr->max_bit_depth == EB_EIGHT_BIT) ? sizeof(uint8_t) : sizeof(uint16_t);
         size     = size * w * h;
         assert(recon_buffer->p_buffer != NULL);
-        ((EbSvtIOFormat *)recon_buffer->p_buffer)->luma = (uint8_t *)malloc(size);
-        ((EbSvtIOFormat *)recon_buffer->p_buffer)->cb   = (uint8_t *)malloc(size >> 2);
-        ((EbSvtIOFormat *)recon_buffer->p_buffer)->cr   = (uint8_t *)malloc(size >> 2);
+        EbSvtIOFormat *out_img = (EbSvtIOFormat *)recon_buffer->p_buffer;
+        /* With external frame buffers the planes are set by the decoder */
+        if (cli.ext_frame_buf) {
+            out_img->luma = NULL;
+            out_img->cb   = NULL;
+            out_img->cr   = NULL;
+        } else {
+            out_img->luma = (uint8_t *)malloc(size);
+            out_img->cb   = (uint8_t *)malloc(size >> 2);
+            out_img->cr   = (uint8_t *)malloc(size >> 2);
+        }
+        recon_buffer->wrapper_ptr = NULL;
 
         if (!init_pic_buffer((EbSvtIOFormat *)recon_buffer->p_buffer, &cli, config_ptr)) {
             fprintf(stderr, "Decoding \n");
@@ -232,13 +264,21 @@ int32_t main(int32_t argc, char *argv[]) {
                     return_error |= svt_av1_dec_frame(
                         p_handle, buf, bytes_in_buffer, obu_ctx.is_annexb);
 
-                    dec_timer_mark(&timer);
-                    dx_time += dec_timer_elapsed(&timer);
-
                     in_frame++;
 
-                    if (svt_av1_dec_get_picture(p_handle, recon_buffer, stream_info, frame_info) !=
-                        EB_DecNoOutputPicture) {
+                    /* With frames in parallel the decode completes in get_picture.
+                       All the pictures ready are taken before the next frame */
+                    EbErrorType out_status;
+                    while ((out_status = svt_av1_dec_get_picture(
+                                p_handle, recon_buffer, stream_info, frame_info)) !=
+                           EB_DecNoOutputPicture) {
+                        dec_timer_mark(&timer);
+                        dx_time += dec_timer_elapsed(&timer);
+                        if (out_status != EB_ErrorNone) {
+                            return_error |= out_status;
+                            dec_timer_start(&timer);
+                            continue;
+                        }
                         if (fps_frm)
                             show_progress(in_frame, dx_time);
 
@@ -246,10 +286,34 @@ int32_t main(int32_t argc, char *argv[]) {
                             write_md5(recon_buffer, &md5_ctx);
                         if (cli.out_file != NULL)
                             write_frame(recon_buffer, &cli);
+                        svt_av1_dec_release_picture(p_handle, recon_buffer);
+                        dec_timer_start(&timer);
                     }
+                    dec_timer_mark(&timer);
+                    dx_time += dec_timer_elapsed(&timer);
                 } else
                     break;
             }
+
+            /* Flush the frames still in flight */
+            dec_timer_start(&timer);
+            return_error |= svt_av1_dec_frame(p_handle, NULL, 0, obu_ctx.is_annexb);
+            EbErrorType out_status;
+            while ((out_status = svt_av1_dec_get_picture(
+                        p_handle, recon_buffer, stream_info, frame_info)) !=
+                   EB_DecNoOutputPicture) {
+                if (out_status != EB_ErrorNone) {
+                    return_error |= out_status;
+                    continue;
+                }
+                if (enable_md5)
+                    write_md5(recon_buffer, &md5_ctx);
+                if (cli.out_file != NULL)
+                    write_frame(recon_buffer, &cli);
+                svt_av1_dec_release_picture(p_handle, recon_buffer);
+            }
+            dec_timer_mark(&timer);
+            dx_time += dec_timer_elapsed(&timer);
             if (fps_summary || fps_frm) {
                 assert(dx_time > 0);
                 show_progress(in_frame, dx_time);
@@ -267,9 +331,11 @@ int32_t main(int32_t argc, char *argv[]) {
             free(stream_info);
         }
 
-        free(((EbSvtIOFormat *)recon_buffer->p_buffer)->cr);
-        free(((EbSvtIOFormat *)recon_buffer->p_buffer)->cb);
-        free(((EbSvtIOFormat *)recon_buffer->p_buffer)->luma);
+        if (!cli.ext_frame_buf) {
+            free(((EbSvtIOFormat *)recon_buffer->p_buffer)->cr);
+            free(((EbSvtIOFormat *)recon_buffer->p_buffer)->cb);
+            free(((EbSvtIOFormat *)recon_buffer->p_buffer)->luma);
+        }
 
         free(recon_buffer->p_buffer);
         free(recon_buffer);
@@ -54,18 +54,10 @@ static void set_colour_space(const char *value, EbSvtAv1DecConfiguration *cfg) {
     cfg->max_color_format = parse_name(value, csp_names);
 };
 static void set_num_thread(const char *value, EbSvtAv1DecConfiguration *cfg) {
-    // cfg->threads = strtoul(value, NULL, 0);
-    (void)value;
-    (void)cfg;
+    cfg->threads = strtoul(value, NULL, 0);
 };
 static void set_num_pframes(const char *value, EbSvtAv1DecConfiguration *cfg) {
     cfg->num_p_frames = strtoul(value, NULL, 0);
-    if (cfg->num_p_frames != 1) {
-        fprintf(
-            stderr,
-            "Warning : Multi frame parallelism not supported. Setting parallel frames to 1. \n");
-        cfg->num_p_frames = 1;
-    }
 };
 
 /**********************************
@@ -98,13 +90,14 @@ static void show_help() {
     H0(" -w <arg>                  Input picture width \n");
     H0(" -h <arg>                  Input picture height \n");
     H0(" -colour-space <arg>       Input picture colour space. [400, 420, 422, 444]\n");
-    H0(" -threads <arg>            Disabled for now \n");
+    H0(" -threads <arg>            Number of threads used by the decoder \n");
     H0(" -parallel-frames <arg>    Number of frames to be processed in parallel \n");
     H0(" -md5                      MD5 support flag \n");
     H0(" -fps-frm                  Show fps after each frame decoded\n");
     H0(" -fps-summary              Show fps summary");
     H0(" -skip-film-grain          Disable Film Grain");
     H0(" -16bit-pipeline           Enable 16b pipeline. [1 - enable, 0 - disable]");
+    H0(" -ext-frame-buf            Decode to application allocated frame buffers, no output copy \n");
 
     exit(1);
 }
@@ -163,6 +156,8 @@ EbErrorType read_command_line(int32_t argc, char *const argv[], EbSvtAv1DecConfi
                 cli->skip_film_grain = 1;
             else if (strcmp(cmd_copy[token_index], ANNEX_B_TOKEN) == 0)
                 obu_ctx->is_annexb = 1;
+            else if (strcmp(cmd_copy[token_index], EXT_FRAME_BUF_TOKEN) == 0)
+                cli->ext_frame_buf = 1;
             else if (strcmp(cmd_copy[token_index], HELP_TOKEN) == 0)
                 show_help();
             else {
@@ -51,6 +51,7 @@
 #define FPS_SUMMARY_TOKEN "-fps-summary"
 #define FILM_GRAIN_TOKEN "-skip-film-grain"
 #define ANNEX_B_TOKEN "-annex-b"
+#define EXT_FRAME_BUF_TOKEN "-ext-frame-buf"
 #define MAX_NUM_TOKENS 200
 
 /**********************************
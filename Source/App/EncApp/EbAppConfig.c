@@ -48,7 +48,11 @@
 #define PASS_TOKEN "--pass"
 #define TWO_PASS_STATS_TOKEN "--stats"
 #define PASSES_TOKEN "--passes"
+#define CHUNK_START_TOKEN "--chunk-start"
+#define CHUNK_FRAMES_TOKEN "--chunk-frames"
 #define STAT_FILE_TOKEN "--stat-file"
+#define FRAME_STATS_FILE_TOKEN "--frame-stats-file"
+#define LOOKAHEAD_ONLY_TOKEN "--lookahead-only"
 #define INPUT_PREDSTRUCT_FILE_TOKEN "--pred-struct-file"
 #define WIDTH_TOKEN "-w"
 #define HEIGHT_TOKEN "-h"
@@ -56,6 +60,7 @@
 #define BUFFERED_INPUT_TOKEN "--nb"
 #define NO_PROGRESS_TOKEN "--no-progress" // tbd if it should be removed
 #define PROGRESS_TOKEN "--progress"
+#define PIPELINE_STATS_TOKEN "--pipeline-stats"
 #define QP_TOKEN "-q"
 #define USE_QP_FILE_TOKEN "--use-q-file"
 
@@ -114,6 +119,7 @@
 #define BUFFER_INITIAL_SIZE_TOKEN "--buf-initial-sz"
 #define BUFFER_OPTIMAL_SIZE_TOKEN "--buf-optimal-sz"
 #define RECODE_LOOP_TOKEN "--recode-loop"
+#define SB_ROW_RECODE_TOKEN "--sb-row-recode"
 #define ENABLE_TPL_LA_TOKEN "--enable-tpl-la"
 #define SUPER_BLOCK_SIZE_TOKEN "--sb-size"
 #define TILE_ROW_TOKEN "--tile-rows"
@@ -126,6 +132,7 @@
 #define THREAD_MGMNT "--lp"
 #define PIN_TOKEN "--pin"
 #define TARGET_SOCKET "--ss"
+#define WORKER_POOL_TOKEN "--worker-pool"
 #define RESTRICTED_MOTION_VECTOR "--rmv"
 #define CONFIG_FILE_COMMENT_CHAR '#'
 #define CONFIG_FILE_NEWLINE_CHAR '\n'
@@ -145,6 +152,7 @@
 //double dash
 #define PRESET_TOKEN "--preset"
 #define QP_FILE_NEW_TOKEN "--qpfile"
+#define ROI_MAP_FILE_TOKEN "--roi-map-file"
 #define INPUT_DEPTH_TOKEN "--input-depth"
 #define KEYINT_TOKEN "--keyint"
 #define LOOKAHEAD_NEW_TOKEN "--lookahead"
@@ -203,15 +211,22 @@ static Bool fopen_and_lock(FILE **file, const char *name, Bool write) {
     if (!*file)
         return FALSE;
 
+    // Readers share the lock, so parallel encoders can use the same stats
 #ifdef _WIN32
     HANDLE handle = get_file_handle(*file);
     if (handle == INVALID_HANDLE_VALUE)
         return FALSE;
-    if (LockFile(handle, 0, 0, MAXDWORD, MAXDWORD))
+    OVERLAPPED overlapped = {0};
+    if (LockFileEx(handle,
+                   (write ? LOCKFILE_EXCLUSIVE_LOCK : 0) | LOCKFILE_FAIL_IMMEDIATELY,
+                   0,
+                   MAXDWORD,
+                   MAXDWORD,
+                   &overlapped))
         return TRUE;
 #else
     int fd = fileno(*file);
-    if (flock(fd, LOCK_EX | LOCK_NB) == 0)
+    if (flock(fd, (write ? LOCK_EX : LOCK_SH) | LOCK_NB) == 0)
         return TRUE;
 #endif
     fprintf(stderr, "ERROR: locking %s failed, is it used by other encoder?\n", name);
@@ -296,6 +311,12 @@ static void set_cfg_qp_file(const char *value, EbConfig *cfg) {
     }
     FOPEN(cfg->qp_file, value, "r");
 };
+static void set_cfg_roi_map_file(const char *value, EbConfig *cfg) {
+    if (cfg->roi_map_file)
+        fclose(cfg->roi_map_file);
+    FOPEN(cfg->roi_map_file, value, "r");
+    cfg->config.enable_roi_map = cfg->roi_map_file != NULL;
+};
 static void set_pass(const char *value, EbConfig *cfg) {
     cfg->config.pass = strtol(value, NULL, 0);
 }
@@ -307,6 +328,13 @@ static void set_two_pass_stats(const char *value, EbConfig *cfg) {
 #endif
 }
 
+static void set_chunk_start(const char *value, EbConfig *cfg) {
+    cfg->config.chunk_start_frame = strtoll(value, NULL, 0);
+}
+static void set_chunk_frames(const char *value, EbConfig *cfg) {
+    cfg->config.chunk_frame_count = strtoul(value, NULL, 0);
+}
+
 static void set_passes(const char *value, EbConfig *cfg) {
     (void)value;
     (void)cfg;
@@ -319,6 +347,20 @@ static void set_cfg_stat_file(const char *value, EbConfig *cfg) {
     }
     FOPEN(cfg->stat_file, value, "wb");
 };
+static void set_cfg_frame_stats_file(const char *value, EbConfig *cfg) {
+    if (cfg->frame_stats_file)
+        fclose(cfg->frame_stats_file);
+    FOPEN(cfg->frame_stats_file, value, "w");
+    cfg->config.enable_frame_stats = cfg->frame_stats_file != NULL;
+    if (cfg->frame_stats_file)
+        fprintf(cfg->frame_stats_file,
+                "picture\tlayer\tqindex\tbytes\tpsnr_y\tpsnr_u\tpsnr_v\tssim_y\tssim_u\tssim_v\t"
+                "intra\tinter\tskip\tmv\tr0\tscene_change\tvariance\tme_sad\tbeta\tanalysis_ms\t"
+                "lookahead_ms\tencode_ms\tfilter_ms\tentropy_ms\ttile_bytes\n");
+};
+static void set_lookahead_only(const char *value, EbConfig *cfg) {
+    cfg->config.lookahead_only = (Bool)strtoul(value, NULL, 0);
+};
 static void set_stat_report(const char *value, EbConfig *cfg) {
     cfg->config.stat_report = (uint8_t)strtoul(value, NULL, 0);
 };
@@ -347,6 +389,9 @@ static void set_progress(const char *value, EbConfig *cfg) {
     default: cfg->progress = 1; break; // default progress
     }
 }
+static void set_pipeline_stats(const char *value, EbConfig *cfg) {
+    cfg->pipeline_stats = (Bool)strtoul(value, NULL, 0);
+}
 static void set_frame_rate(const char *value, EbConfig *cfg) {
     cfg->config.frame_rate = strtoul(value, NULL, 0);
     if (cfg->config.frame_rate <= 1000) {
@@ -629,6 +674,9 @@ static void set_buf_optimal_sz(const char *value, EbConfig *cfg) {
 static void set_recode_loop(const char *value, EbConfig *cfg) {
     cfg->config.recode_loop = strtoul(value, NULL, 0);
 };
+static void set_sb_row_recode(const char *value, EbConfig *cfg) {
+    cfg->config.sb_row_recode = (Bool)strtoul(value, NULL, 0);
+};
 static void set_adaptive_quantization(const char *value, EbConfig *cfg) {
     cfg->config.enable_adaptive_quantization = (Bool)strtol(value, NULL, 0);
 };
@@ -742,6 +790,9 @@ static void set_pinned_execution(const char *value, EbConfig *cfg) {
 static void set_target_socket(const char *value, EbConfig *cfg) {
     cfg->config.target_socket = (int32_t)strtol(value, NULL, 0);
 };
+static void set_worker_pool(const char *value, EbConfig *cfg) {
+    cfg->config.enable_worker_pool = (Bool)strtoul(value, NULL, 0);
+};
 static void set_restricted_motion_vector(const char *value, EbConfig *cfg) {
     cfg->config.restricted_motion_vector = !!strtol(value, NULL, 0);
 };
@@ -823,6 +874,16 @@ ConfigEntry config_entry_options[] = {
      STAT_FILE_TOKEN,
      "PSNR / SSIM per picture stat output file path, requires `--enable-stat-report 1`",
      set_cfg_stat_file},
+    {SINGLE_INPUT,
+     FRAME_STATS_FILE_TOKEN,
+     "Per frame statistics output file path (size, tiles, block types, motion, stage times), "
+     "the PSNR / SSIM columns require `--enable-stat-report 1`",
+     set_cfg_frame_stats_file},
+    {SINGLE_INPUT,
+     LOOKAHEAD_ONLY_TOKEN,
+     "Only run the lookahead analysis (scene changes, variance, ME SAD, TPL), no bitstream is "
+     "written, use with `--frame-stats-file` [0-1]",
+     set_lookahead_only},
 
     {SINGLE_INPUT,
      INPUT_PREDSTRUCT_FILE_TOKEN,
@@ -838,6 +899,11 @@ ConfigEntry config_entry_options[] = {
      "Do not print out progress, default is 0 [1: `" PROGRESS_TOKEN " 0`, 0: `" PROGRESS_TOKEN
      " 1`]",
      set_no_progress},
+    {SINGLE_INPUT,
+     PIPELINE_STATS_TOKEN,
+     "Print the busy / idle time and queue depth of each encoder stage and the picture pools "
+     "occupancy at the end of the encode, default is 0 [0-1]",
+     set_pipeline_stats},
 
     {SINGLE_INPUT,
      PRESET_TOKEN,
@@ -963,6 +1029,11 @@ ConfigEntry config_entry_global_options[] = {
      "Specifies which socket to run on, assumes a max of two sockets. Refer to Appendix A.1 of the "
      "user guide, default is -1 [-1, 0, -1]",
      set_target_socket},
+    {SINGLE_INPUT,
+     WORKER_POOL_TOKEN,
+     "Run the parallel stages on a shared pool of --lp worker threads instead of per stage "
+     "thread arrays, default is 0 [0-1]",
+     set_worker_pool},
     // Termination
     {SINGLE_INPUT, NULL, NULL, NULL}};
 
@@ -997,6 +1068,11 @@ ConfigEntry config_entry_rc[] = {
      QP_FILE_NEW_TOKEN,
      "Path to a file containing per picture QP value separated by newlines",
      set_cfg_qp_file},
+    {SINGLE_INPUT,
+     ROI_MAP_FILE_TOKEN,
+     "Path to a file of ROI maps: a frame number followed by one qindex offset per 64x64 block, "
+     "a map applies until the next one",
+     set_cfg_roi_map_file},
     {SINGLE_INPUT,
      MAX_QP_TOKEN,
      "Maximum (highest) quantizer, only applicable for VBR and CBR, default is 63 [1-63]",
@@ -1087,6 +1163,11 @@ ConfigEntry config_entry_rc[] = {
      "Recode loop level, refer to \"Recode loop level table\" in the user guide for more info [0: "
      "off, 4: preset based]",
      set_recode_loop},
+    {SINGLE_INPUT,
+     SB_ROW_RECODE_TOKEN,
+     "Recode the remaining SB rows with a delta q adjustment instead of the whole picture, "
+     "default is 0 [0-1]",
+     set_sb_row_recode},
     {SINGLE_INPUT,
      VBR_BIAS_PCT_TOKEN,
      "CBR/VBR bias, default is 50 [0: CBR-like, 1-99, 100: VBR-like]",
@@ -1119,6 +1200,15 @@ ConfigEntry config_entry_2p[] = {
      "Number of encoding passes, default is preset dependent but generally 1 [1: one pass encode, "
      "2: multi-pass encode]",
      set_passes},
+    {SINGLE_INPUT,
+     CHUNK_START_TOKEN,
+     "Index of the first frame of the chunk in the stats of the whole sequence, the input only "
+     "holds the frames of the chunk, default is -1 [-1: off, 0-`(2^63)-1`]",
+     set_chunk_start},
+    {SINGLE_INPUT,
+     CHUNK_FRAMES_TOKEN,
+     "Number of frames of the chunk, default is 0 [0: frames to be encoded, 1-`(2^32)-1`]",
+     set_chunk_frames},
     // Termination
     {SINGLE_INPUT, NULL, NULL, NULL}};
 
@@ -1308,9 +1398,12 @@ ConfigEntry config_entry[] = {
     {SINGLE_INPUT, OUTPUT_RECON_TOKEN, "ReconFile", set_cfg_recon_file},
     {SINGLE_INPUT, OUTPUT_RECON_LONG_TOKEN, "ReconFile", set_cfg_recon_file},
     {SINGLE_INPUT, STAT_FILE_TOKEN, "StatFile", set_cfg_stat_file},
+    {SINGLE_INPUT, FRAME_STATS_FILE_TOKEN, "FrameStatsFile", set_cfg_frame_stats_file},
+    {SINGLE_INPUT, LOOKAHEAD_ONLY_TOKEN, "LookaheadOnly", set_lookahead_only},
     {SINGLE_INPUT, INPUT_PREDSTRUCT_FILE_TOKEN, "PredStructFile", set_pred_struct_file},
     {SINGLE_INPUT, PROGRESS_TOKEN, "Progress", set_progress},
     {SINGLE_INPUT, NO_PROGRESS_TOKEN, "NoProgress", set_no_progress},
+    {SINGLE_INPUT, PIPELINE_STATS_TOKEN, "PipelineStats", set_pipeline_stats},
     {SINGLE_INPUT, PRESET_TOKEN, "EncoderMode", set_enc_mode},
     {SINGLE_INPUT, SVTAV1_PARAMS, "SvtAv1Params", parse_svtav1_params},
 
@@ -1361,6 +1454,7 @@ ConfigEntry config_entry[] = {
     {SINGLE_INPUT, THREAD_MGMNT, "LogicalProcessors", set_logical_processors},
     {SINGLE_INPUT, PIN_TOKEN, "PinnedExecution", set_pinned_execution},
     {SINGLE_INPUT, TARGET_SOCKET, "TargetSocket", set_target_socket},
+    {SINGLE_INPUT, WORKER_POOL_TOKEN, "WorkerPool", set_worker_pool},
 
     // Rate Control Options
     {SINGLE_INPUT, RATE_CONTROL_ENABLE_TOKEN, "RateControlMode", set_rate_control_mode},
@@ -1372,6 +1466,7 @@ ConfigEntry config_entry[] = {
 
     {SINGLE_INPUT, USE_QP_FILE_TOKEN, "UseQpFile", set_cfg_use_qp_file},
     {SINGLE_INPUT, QP_FILE_NEW_TOKEN, "QpFile", set_cfg_qp_file},
+    {SINGLE_INPUT, ROI_MAP_FILE_TOKEN, "RoiMapFile", set_cfg_roi_map_file},
 
     {SINGLE_INPUT, MAX_QP_TOKEN, "MaxQpAllowed", set_max_qp_allowed},
     {SINGLE_INPUT, MIN_QP_TOKEN, "MinQpAllowed", set_min_qp_allowed},
@@ -1425,6 +1520,7 @@ ConfigEntry config_entry[] = {
     {SINGLE_INPUT, BUFFER_INITIAL_SIZE_TOKEN, "BufInitialSz", set_buf_initial_sz},
     {SINGLE_INPUT, BUFFER_OPTIMAL_SIZE_TOKEN, "BufOptimalSz", set_buf_optimal_sz},
     {SINGLE_INPUT, RECODE_LOOP_TOKEN, "RecodeLoop", set_recode_loop},
+    {SINGLE_INPUT, SB_ROW_RECODE_TOKEN, "SbRowRecode", set_sb_row_recode},
     {SINGLE_INPUT, VBR_BIAS_PCT_TOKEN, "VBRBiasPct", set_vbr_bias_pct},
     {SINGLE_INPUT, VBR_MIN_SECTION_PCT_TOKEN, "MinSectionPct", set_vbr_min_section_pct},
     {SINGLE_INPUT, VBR_MAX_SECTION_PCT_TOKEN, "MaxSectionPct", set_vbr_max_section_pct},
@@ -1433,6 +1529,8 @@ ConfigEntry config_entry[] = {
     {SINGLE_INPUT, PASS_TOKEN, "Pass", set_pass},
     {SINGLE_INPUT, TWO_PASS_STATS_TOKEN, "Stats", set_two_pass_stats},
     {SINGLE_INPUT, PASSES_TOKEN, "Passes", set_passes},
+    {SINGLE_INPUT, CHUNK_START_TOKEN, "ChunkStart", set_chunk_start},
+    {SINGLE_INPUT, CHUNK_FRAMES_TOKEN, "ChunkFrames", set_chunk_frames},
 
     // GOP size and type Options
     {SINGLE_INPUT, INTRA_PERIOD_TOKEN, "IntraPeriod", set_cfg_intra_period},
@@ -1553,10 +1651,26 @@ void svt_config_dtor(EbConfig *config_ptr) {
         config_ptr->qp_file = (FILE *)NULL;
     }
 
+    if (config_ptr->roi_map_file) {
+        fclose(config_ptr->roi_map_file);
+        config_ptr->roi_map_file = (FILE *)NULL;
+    }
+    free(config_ptr->roi_map.qp_offset);
+    free(config_ptr->roi_map.skip);
+    free(config_ptr->roi_next_qp_offset);
+    free(config_ptr->roi_next_skip);
+
     if (config_ptr->stat_file) {
         fclose(config_ptr->stat_file);
         config_ptr->stat_file = (FILE *)NULL;
     }
+
+    if (config_ptr->frame_stats_file) {
+        fclose(config_ptr->frame_stats_file);
+        config_ptr->frame_stats_file = (FILE *)NULL;
+    }
+    if (config_ptr->stats_mapped)
+        svt_av1_enc_unmap_stats(&config_ptr->config.rc_stats_buffer);
     free((void *)config_ptr->stats);
     free(config_ptr);
     return;
@@ -1878,6 +1992,7 @@ EbErrorType handle_stats_file(EbConfig *config, EncPass enc_pass,
             }
         }
         // Final pass: pass = 2 for CRF and pass = 3 for VBR
+        // The stats are only read, map them when the file has a header
         else if ((config->config.pass == 2 && config->config.rate_control_mode == 0) ||
                  (config->config.pass == 3 && config->config.rate_control_mode == 1)) {
             if (!fopen_and_lock(&config->input_stat_file, stats, FALSE)) {
@@ -1887,7 +2002,10 @@ EbErrorType handle_stats_file(EbConfig *config, EncPass enc_pass,
                         stats);
                 return EB_ErrorBadParameter;
             }
-            if (!load_twopass_stats_in(config)) {
+            if (svt_av1_enc_map_stats(stats, 0, 0, &config->config.rc_stats_buffer) ==
+                EB_ErrorNone)
+                config->stats_mapped = TRUE;
+            else if (!load_twopass_stats_in(config)) {
                 fprintf(config->error_log_file,
                         "Error instance %u: can't load file %s\n",
                         channel_number + 1,
@@ -2815,6 +2933,14 @@ EbErrorType read_command_line(int32_t argc, char *const argv[], EncChannel *chan
                 if (c->return_error == EB_ErrorNone && config->frames_to_be_encoded == 0)
                     config->frames_to_be_encoded = compute_frames_to_be_encoded(config);
 
+                // A chunk covers the frames to be encoded, its timestamps follow the
+                // previous chunks
+                if (c->return_error == EB_ErrorNone && config->config.chunk_start_frame >= 0) {
+                    if (!config->config.chunk_frame_count && config->frames_to_be_encoded > 0)
+                        config->config.chunk_frame_count = (uint32_t)config->frames_to_be_encoded;
+                    config->ivf_count = (uint64_t)config->config.chunk_start_frame;
+                }
+
                 // For pipe input it is fine if we have -1 here (we will update on end of stream)
                 if (config->frames_to_be_encoded == -1 && config->input_file != stdin &&
                     !config->input_file_is_fifo) {
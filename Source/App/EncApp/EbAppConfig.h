@@ -184,18 +184,29 @@ typedef struct EbConfig {
     FILE      *recon_file;
     FILE      *error_log_file;
     FILE      *stat_file;
+    FILE      *frame_stats_file;
     FILE      *buffer_file;
     FILE      *qp_file;
+    /* ROI map file, roi_map is the map of the current picture and roi_next_* the next map of
+     * the file, which starts at roi_next_frame (-1 at the end of the file) */
+    FILE        *roi_map_file;
+    SvtAv1RoiMap roi_map;
+    Bool         roi_map_active;
+    int64_t      roi_next_frame;
+    int16_t     *roi_next_qp_offset;
+    uint8_t     *roi_next_skip;
     /* two pass */
     const char   *stats;
     FILE         *input_stat_file;
     FILE         *output_stat_file;
+    Bool          stats_mapped; // rc_stats_buffer comes from svt_av1_enc_map_stats()
     FILE         *input_pred_struct_file;
     char         *input_pred_struct_filename;
     Bool        y4m_input;
     unsigned char y4m_buf[9];
 
     uint8_t progress; // 0 = no progress output, 1 = normal, 2 = aomenc style verbose progress
+    Bool    pipeline_stats; // print the encoder pipeline telemetry at the end of the encode
     /****************************************
      * Computational Performance Data
      ****************************************/
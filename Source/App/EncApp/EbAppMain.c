@@ -328,6 +328,77 @@ static void print_summary(const EncContext* const enc_context) {
     fflush(stdout);
 }
 
+static void print_pool_stats(const char* name, const SvtAv1PoolStats* pool) {
+    fprintf(stderr,
+            "%-28s%6u/%-6u%12.0f\n",
+            name,
+            pool->in_use_count,
+            pool->total_count,
+            (double)pool->stall_time_us / 1000);
+}
+
+static void print_pipeline_stats(const EncContext* const enc_context) {
+    static const char* stage_names[SVT_AV1_STAGE_COUNT] = {"Resource Coordination",
+                                                           "Picture Analysis",
+                                                           "Picture Decision",
+                                                           "Motion Estimation",
+                                                           "Initial Rate Control",
+                                                           "Source Based Operations",
+                                                           "TPL Dispenser",
+                                                           "Picture Manager",
+                                                           "Rate Control",
+                                                           "Mode Decision Configuration",
+                                                           "EncDec",
+                                                           "DLF",
+                                                           "CDEF",
+                                                           "Restoration",
+                                                           "Entropy Coding",
+                                                           "Packetization"};
+    for (uint32_t inst_cnt = 0; inst_cnt < enc_context->num_channels; ++inst_cnt) {
+        const EncChannel*   c = enc_context->channels + inst_cnt;
+        SvtAv1PipelineStats stats;
+        if (!c->config->pipeline_stats || c->return_error != EB_ErrorNone ||
+            svt_av1_enc_get_stream_info(c->app_callback->svt_encoder_handle,
+                                        SVT_AV1_STREAM_INFO_PIPELINE_STATS,
+                                        &stats) != EB_ErrorNone)
+            continue;
+        fprintf(stderr,
+                "\nPIPELINE ------------------------------- Channel %u  "
+                "--------------------------------\n",
+                inst_cnt + 1);
+        fprintf(stderr, "Elapsed Time:\t%.0f ms\n", (double)stats.elapsed_time_us / 1000);
+        fprintf(stderr,
+                "%-28s%8s%8s%8s%12s%12s%8s\n",
+                "Stage",
+                "Threads",
+                "Tasks",
+                "Queued",
+                "Busy (ms)",
+                "Idle (ms)",
+                "Busy %");
+        for (int i = 0; i < SVT_AV1_STAGE_COUNT; i++) {
+            const SvtAv1StageStats* stage = &stats.stage[i];
+            const uint64_t thread_time = stage->busy_time_us + stage->idle_time_us;
+            fprintf(stderr,
+                    "%-28s%8u%8u%8u%12.0f%12.0f%7.1f%%\n",
+                    stage_names[i],
+                    stage->thread_count,
+                    stage->task_count,
+                    stage->queue_depth,
+                    (double)stage->busy_time_us / 1000,
+                    (double)stage->idle_time_us / 1000,
+                    thread_time ? 100.0 * stage->busy_time_us / thread_time : 0.0);
+        }
+        fprintf(stderr, "\n%-28s%13s%12s\n", "Pool", "In Use", "Stall (ms)");
+        print_pool_stats("Input", &stats.input_pool);
+        print_pool_stats("Parent PCS", &stats.parent_pcs_pool);
+        print_pool_stats("Child PCS", &stats.child_pcs_pool);
+        print_pool_stats("PA Reference", &stats.pa_reference_pool);
+        print_pool_stats("Reference", &stats.reference_pool);
+        print_pool_stats("Output Stream", &stats.output_stream_pool);
+    }
+}
+
 static void print_performance(const EncContext* const enc_context) {
     for (uint32_t inst_cnt = 0; inst_cnt < enc_context->num_channels; ++inst_cnt) {
         const EncChannel* c = enc_context->channels + inst_cnt;
@@ -451,6 +522,7 @@ static EbErrorType encode(EncApp* enc_app, EncContext* enc_context) {
     }
     print_summary(enc_context);
     print_performance(enc_context);
+    print_pipeline_stats(enc_context);
     return return_error;
 }
 
@@ -494,6 +494,66 @@ static unsigned char send_qp_on_the_fly(FILE *const qp_file, Bool *use_qp_file)
     return (unsigned)CLIP3(0, 63, tmp_qp);
 }
 
+/**
+ * Reads the next map of the ROI map file into roi_next_qp_offset / roi_next_skip. A map is a
+ * frame number followed by one qindex offset per 64x64 block in raster order, an offset followed
+ * by 's' (e.g. "-20s") marks a static block
+ * @return frame number of the map, -1 at the end of the file or on a malformed map
+ */
+static int64_t read_next_roi_map(EbConfig *config) {
+    char token[32], frame_token[32], *end;
+    if (fscanf(config->roi_map_file, "%31s", frame_token) != 1)
+        return -1;
+    const int64_t frame = strtoll(frame_token, &end, 0);
+    if (*end || frame < 0) {
+        fprintf(stderr, "\nWarning: Invalid frame number %s in the ROI map file\n", frame_token);
+        return -1;
+    }
+    for (uint32_t i = 0; i < config->roi_map.b64_count; i++) {
+        if (fscanf(config->roi_map_file, "%31s", token) != 1) {
+            fprintf(stderr,
+                    "\nWarning: The ROI map of frame %s needs %u offsets\n",
+                    frame_token,
+                    config->roi_map.b64_count);
+            return -1;
+        }
+        config->roi_next_qp_offset[i] = (int16_t)strtol(token, &end, 0);
+        config->roi_next_skip[i]      = *end == 's';
+    }
+    return frame;
+}
+
+/**
+ * Returns the ROI map of a frame, NULL before the first map of the file
+ */
+static SvtAv1RoiMap *get_roi_map(EbConfig *config, uint64_t frame) {
+    if (!config->roi_map.qp_offset) {
+        const uint32_t b64_count = ((config->config.source_width + 63) / 64) *
+            ((config->config.source_height + 63) / 64);
+        config->roi_map.b64_count  = b64_count;
+        config->roi_map.qp_offset  = (int16_t *)calloc(b64_count, sizeof(int16_t));
+        config->roi_map.skip       = (uint8_t *)calloc(b64_count, sizeof(uint8_t));
+        config->roi_next_qp_offset = (int16_t *)calloc(b64_count, sizeof(int16_t));
+        config->roi_next_skip      = (uint8_t *)calloc(b64_count, sizeof(uint8_t));
+        config->roi_next_frame     = -1;
+        if (!config->roi_map.qp_offset || !config->roi_map.skip || !config->roi_next_qp_offset ||
+            !config->roi_next_skip)
+            return NULL;
+        config->roi_next_frame = read_next_roi_map(config);
+    }
+    while (config->roi_next_frame >= 0 && (uint64_t)config->roi_next_frame <= frame) {
+        int16_t *qp_offset         = config->roi_map.qp_offset;
+        uint8_t *skip              = config->roi_map.skip;
+        config->roi_map.qp_offset  = config->roi_next_qp_offset;
+        config->roi_map.skip       = config->roi_next_skip;
+        config->roi_next_qp_offset = qp_offset;
+        config->roi_next_skip      = skip;
+        config->roi_map_active     = TRUE;
+        config->roi_next_frame     = read_next_roi_map(config);
+    }
+    return config->roi_map_active ? &config->roi_map : NULL;
+}
+
 static void injector(uint64_t processed_frame_count, uint32_t injector_frame_rate) {
     static uint64_t start_times_seconds;
     static uint64_t start_timesu_seconds;
@@ -575,6 +635,9 @@ void process_input_buffer(EncChannel *channel) {
             // Configuration parameters changed on the fly
             if (config->config.use_qp_file && config->qp_file)
                 header_ptr->qp = send_qp_on_the_fly(config->qp_file, &config->config.use_qp_file);
+            header_ptr->roi_map = config->roi_map_file
+                ? get_roi_map(config, config->processed_frame_count - 1)
+                : NULL;
 
             if (keep_running == 0 && !config->stop_encoder)
                 config->stop_encoder = TRUE;
@@ -600,6 +663,7 @@ void process_input_buffer(EncChannel *channel) {
             header_ptr->p_buffer      = NULL;
             header_ptr->pic_type      = EB_AV1_INVALID_PICTURE;
             header_ptr->metadata      = NULL;
+            header_ptr->roi_map       = NULL;
             svt_av1_enc_send_picture(component_handle, header_ptr);
         }
 
@@ -763,6 +827,39 @@ void process_output_statistics_buffer(EbBufferHeaderType *header_ptr, EbConfig *
     return;
 }
 
+static void process_output_frame_stats(const SvtAv1FrameStats *stats, FILE *file) {
+    fprintf(file,
+            "%d\t%u\t%u\t%u\t%.4f\t%.4f\t%.4f\t%.6f\t%.6f\t%.6f\t%.4f\t%.4f\t%.4f\t%.3f\t"
+            "%.4f\t%d\t%u\t%.0f\t%.4f\t%.3f\t%.3f\t%.3f\t%.3f\t%.3f\t",
+            (int)stats->picture_number,
+            stats->temporal_layer_index,
+            stats->qindex,
+            stats->frame_size,
+            stats->psnr[0],
+            stats->psnr[1],
+            stats->psnr[2],
+            stats->ssim[0],
+            stats->ssim[1],
+            stats->ssim[2],
+            stats->intra_ratio,
+            stats->inter_ratio,
+            stats->skip_ratio,
+            stats->avg_mv_magnitude,
+            stats->tpl_r0,
+            (int)stats->scene_change,
+            stats->variance,
+            (double)stats->me_sad,
+            stats->tpl_beta,
+            (double)stats->analysis_time_us / 1000,
+            (double)stats->lookahead_time_us / 1000,
+            (double)stats->encode_time_us / 1000,
+            (double)stats->filter_time_us / 1000,
+            (double)stats->entropy_time_us / 1000);
+    for (uint32_t i = 0; i < stats->tile_count; i++)
+        fprintf(file, i ? ",%u" : "%u", stats->tile_size[i]);
+    fprintf(file, "\n");
+}
+
 void process_output_stream_buffer(EncChannel *channel, EncApp *enc_app, int32_t *frame_count) {
     EbConfig            *config        = channel->config;
     EbAppContext        *app_call_back = channel->app_callback;
@@ -824,10 +921,11 @@ void process_output_stream_buffer(EncChannel *channel, EncApp *enc_app, int32_t
                     finish_s_time,
                     finish_u_time);
 
-            // Write Stream Data to file
-            if (stream_file) {
+            // Write Stream Data to file, the lookahead only packets have no usable bitstream
+            if (stream_file && !config->config.lookahead_only) {
+                // Chunks after the first one are appended to the first one's file
                 if (config->performance_context.frame_count == 1 &&
-                    !(flags & EB_BUFFERFLAG_IS_ALT_REF)) {
+                    !(flags & EB_BUFFERFLAG_IS_ALT_REF) && config->config.chunk_start_frame <= 0) {
                     write_ivf_stream_header(config);
                 }
                 write_ivf_frame_header(config, header_ptr->n_filled_len);
@@ -838,6 +936,8 @@ void process_output_stream_buffer(EncChannel *channel, EncApp *enc_app, int32_t
 
             if (config->config.stat_report && !(flags & EB_BUFFERFLAG_IS_ALT_REF))
                 process_output_statistics_buffer(header_ptr, config);
+            if (config->frame_stats_file && header_ptr->frame_stats)
+                process_output_frame_stats(header_ptr->frame_stats, config->frame_stats_file);
 
             // Update Output Port Activity State
             *port_state  = (flags & EB_BUFFERFLAG_EOS) ? APP_PortInactive : *port_state;
@@ -855,6 +955,9 @@ void process_output_stream_buffer(EncChannel *channel, EncApp *enc_app, int32_t
                         &first_pass_stat);
                     if (ret == EB_ErrorNone) {
                         if (config->output_stat_file) {
+                            SvtAv1StatsHeader stats_header;
+                            svt_av1_enc_init_stats_header(&stats_header, &first_pass_stat);
+                            fwrite(&stats_header, 1, sizeof(stats_header), config->output_stat_file);
                             fwrite(first_pass_stat.buf,
                                    1,
                                    first_pass_stat.sz,
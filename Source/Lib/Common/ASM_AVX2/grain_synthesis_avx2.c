@@ -0,0 +1,252 @@
+/*
+* Copyright(c) 2022 Intel Corporation
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include <immintrin.h>
+#include "EbDefinitions.h"
+#include "common_dsp_rtcd.h"
+
+// Looks up 8 scaling values, the high bit depth indices are interpolated
+// between two entries, the lut has 257 entries so that index 255 reads a
+// copy of itself and gives the same value as the C version
+static INLINE __m256i scale_lut_avx2(const int32_t *scaling_lut, const __m256i index,
+                                     const int32_t bit_depth) {
+    if (bit_depth == 8)
+        return _mm256_i32gather_epi32(scaling_lut, index, 4);
+
+    const __m128i shift = _mm_cvtsi32_si128(bit_depth - 8);
+    const __m256i x     = _mm256_srl_epi32(index, shift);
+    const __m256i start = _mm256_i32gather_epi32(scaling_lut, x, 4);
+    const __m256i end   = _mm256_i32gather_epi32(
+        scaling_lut, _mm256_add_epi32(x, _mm256_set1_epi32(1)), 4);
+    const __m256i frac  = _mm256_and_si256(index, _mm256_set1_epi32((1 << (bit_depth - 8)) - 1));
+    const __m256i delta = _mm256_add_epi32(
+        _mm256_mullo_epi32(_mm256_sub_epi32(end, start), frac),
+        _mm256_set1_epi32(1 << (bit_depth - 9)));
+    return _mm256_add_epi32(start, _mm256_sra_epi32(delta, shift));
+}
+
+static INLINE __m256i add_grain_avx2(const __m256i pixel, const __m256i scale,
+                                     const int32_t *grain, const __m256i rounding,
+                                     const __m128i scaling_shift, const __m256i min_val,
+                                     const __m256i max_val) {
+    const __m256i g     = _mm256_loadu_si256((const __m256i *)grain);
+    const __m256i noise = _mm256_sra_epi32(
+        _mm256_add_epi32(_mm256_mullo_epi32(scale, g), rounding), scaling_shift);
+    return _mm256_min_epi32(_mm256_max_epi32(_mm256_add_epi32(pixel, noise), min_val), max_val);
+}
+
+static INLINE void store_8x8_avx2(uint8_t *dst, const __m256i val) {
+    const __m128i val_16 = _mm_packus_epi32(_mm256_castsi256_si128(val),
+                                            _mm256_extracti128_si256(val, 1));
+    _mm_storel_epi64((__m128i *)dst, _mm_packus_epi16(val_16, val_16));
+}
+
+static INLINE void store_8x16_avx2(uint16_t *dst, const __m256i val) {
+    _mm_storeu_si128(
+        (__m128i *)dst,
+        _mm_packus_epi32(_mm256_castsi256_si128(val), _mm256_extracti128_si256(val, 1)));
+}
+
+void svt_av1_add_luma_grain_avx2(uint8_t *luma, int32_t luma_stride, const int32_t *grain,
+                                 int32_t grain_stride, int32_t width, int32_t height,
+                                 const int32_t *scaling_lut, int32_t scaling_shift,
+                                 int32_t min_luma, int32_t max_luma) {
+    const int32_t w8       = width & ~7;
+    const __m256i rounding = _mm256_set1_epi32(1 << (scaling_shift - 1));
+    const __m128i shift    = _mm_cvtsi32_si128(scaling_shift);
+    const __m256i min_val  = _mm256_set1_epi32(min_luma);
+    const __m256i max_val  = _mm256_set1_epi32(max_luma);
+
+    for (int32_t i = 0; i < height; i++) {
+        uint8_t       *l = luma + i * luma_stride;
+        const int32_t *g = grain + i * grain_stride;
+        for (int32_t j = 0; j < w8; j += 8) {
+            const __m256i pixel = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(l + j)));
+            const __m256i scale = _mm256_i32gather_epi32(scaling_lut, pixel, 4);
+            store_8x8_avx2(l + j,
+                           add_grain_avx2(pixel, scale, g + j, rounding, shift, min_val, max_val));
+        }
+    }
+    if (w8 < width)
+        svt_av1_add_luma_grain_c(luma + w8,
+                                 luma_stride,
+                                 grain + w8,
+                                 grain_stride,
+                                 width - w8,
+                                 height,
+                                 scaling_lut,
+                                 scaling_shift,
+                                 min_luma,
+                                 max_luma);
+}
+
+void svt_av1_add_luma_grain_hbd_avx2(uint16_t *luma, int32_t luma_stride, const int32_t *grain,
+                                     int32_t grain_stride, int32_t width, int32_t height,
+                                     const int32_t *scaling_lut, int32_t scaling_shift,
+                                     int32_t min_luma, int32_t max_luma, int32_t bit_depth) {
+    const int32_t w8       = width & ~7;
+    const __m256i rounding = _mm256_set1_epi32(1 << (scaling_shift - 1));
+    const __m128i shift    = _mm_cvtsi32_si128(scaling_shift);
+    const __m256i min_val  = _mm256_set1_epi32(min_luma);
+    const __m256i max_val  = _mm256_set1_epi32(max_luma);
+
+    for (int32_t i = 0; i < height; i++) {
+        uint16_t      *l = luma + i * luma_stride;
+        const int32_t *g = grain + i * grain_stride;
+        for (int32_t j = 0; j < w8; j += 8) {
+            const __m256i pixel = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(l + j)));
+            const __m256i scale = scale_lut_avx2(scaling_lut, pixel, bit_depth);
+            store_8x16_avx2(l + j,
+                            add_grain_avx2(pixel, scale, g + j, rounding, shift, min_val, max_val));
+        }
+    }
+    if (w8 < width)
+        svt_av1_add_luma_grain_hbd_c(luma + w8,
+                                     luma_stride,
+                                     grain + w8,
+                                     grain_stride,
+                                     width - w8,
+                                     height,
+                                     scaling_lut,
+                                     scaling_shift,
+                                     min_luma,
+                                     max_luma,
+                                     bit_depth);
+}
+
+// Index of the chroma scaling, computed from the co-located luma average
+static INLINE __m256i chroma_merged_avx2(const __m256i average_luma, const __m256i chroma,
+                                         const __m256i luma_mult, const __m256i mult,
+                                         const __m256i offset, const __m256i max_index) {
+    const __m256i combined = _mm256_add_epi32(_mm256_mullo_epi32(average_luma, luma_mult),
+                                              _mm256_mullo_epi32(chroma, mult));
+    const __m256i merged   = _mm256_add_epi32(_mm256_srai_epi32(combined, 6), offset);
+    return _mm256_min_epi32(_mm256_max_epi32(merged, _mm256_setzero_si256()), max_index);
+}
+
+// Average of the 8 pairs of the 16 luma samples
+static INLINE __m256i average_luma_avx2(const __m256i luma_16) {
+    const __m256i sum = _mm256_madd_epi16(luma_16, _mm256_set1_epi16(1));
+    return _mm256_srli_epi32(_mm256_add_epi32(sum, _mm256_set1_epi32(1)), 1);
+}
+
+void svt_av1_add_chroma_grain_avx2(uint8_t *chroma, int32_t chroma_stride, const uint8_t *luma,
+                                   int32_t luma_stride, const int32_t *grain, int32_t grain_stride,
+                                   int32_t width, int32_t height, const int32_t *scaling_lut,
+                                   int32_t luma_mult, int32_t mult, int32_t offset,
+                                   int32_t scaling_shift, int32_t min_chroma, int32_t max_chroma,
+                                   int32_t chroma_subsamp_y, int32_t chroma_subsamp_x) {
+    const int32_t w8          = width & ~7;
+    const __m256i rounding    = _mm256_set1_epi32(1 << (scaling_shift - 1));
+    const __m128i shift       = _mm_cvtsi32_si128(scaling_shift);
+    const __m256i min_val     = _mm256_set1_epi32(min_chroma);
+    const __m256i max_val     = _mm256_set1_epi32(max_chroma);
+    const __m256i luma_mult_v = _mm256_set1_epi32(luma_mult);
+    const __m256i mult_v      = _mm256_set1_epi32(mult);
+    const __m256i offset_v    = _mm256_set1_epi32(offset);
+    const __m256i max_index   = _mm256_set1_epi32(255);
+
+    for (int32_t i = 0; i < height; i++) {
+        uint8_t       *c = chroma + i * chroma_stride;
+        const uint8_t *l = luma + (i << chroma_subsamp_y) * luma_stride;
+        const int32_t *g = grain + i * grain_stride;
+        for (int32_t j = 0; j < w8; j += 8) {
+            __m256i average_luma;
+            if (chroma_subsamp_x)
+                average_luma = average_luma_avx2(
+                    _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(l + (j << 1)))));
+            else
+                average_luma = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(l + j)));
+            const __m256i pixel  = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(c + j)));
+            const __m256i merged = chroma_merged_avx2(
+                average_luma, pixel, luma_mult_v, mult_v, offset_v, max_index);
+            const __m256i scale = _mm256_i32gather_epi32(scaling_lut, merged, 4);
+            store_8x8_avx2(c + j,
+                           add_grain_avx2(pixel, scale, g + j, rounding, shift, min_val, max_val));
+        }
+    }
+    if (w8 < width)
+        svt_av1_add_chroma_grain_c(chroma + w8,
+                                   chroma_stride,
+                                   luma + (w8 << chroma_subsamp_x),
+                                   luma_stride,
+                                   grain + w8,
+                                   grain_stride,
+                                   width - w8,
+                                   height,
+                                   scaling_lut,
+                                   luma_mult,
+                                   mult,
+                                   offset,
+                                   scaling_shift,
+                                   min_chroma,
+                                   max_chroma,
+                                   chroma_subsamp_y,
+                                   chroma_subsamp_x);
+}
+
+void svt_av1_add_chroma_grain_hbd_avx2(uint16_t *chroma, int32_t chroma_stride,
+                                       const uint16_t *luma, int32_t luma_stride,
+                                       const int32_t *grain, int32_t grain_stride, int32_t width,
+                                       int32_t height, const int32_t *scaling_lut,
+                                       int32_t luma_mult, int32_t mult, int32_t offset,
+                                       int32_t scaling_shift, int32_t min_chroma,
+                                       int32_t max_chroma, int32_t chroma_subsamp_y,
+                                       int32_t chroma_subsamp_x, int32_t bit_depth) {
+    const int32_t w8          = width & ~7;
+    const __m256i rounding    = _mm256_set1_epi32(1 << (scaling_shift - 1));
+    const __m128i shift       = _mm_cvtsi32_si128(scaling_shift);
+    const __m256i min_val     = _mm256_set1_epi32(min_chroma);
+    const __m256i max_val     = _mm256_set1_epi32(max_chroma);
+    const __m256i luma_mult_v = _mm256_set1_epi32(luma_mult);
+    const __m256i mult_v      = _mm256_set1_epi32(mult);
+    const __m256i offset_v    = _mm256_set1_epi32(offset);
+    const __m256i max_index   = _mm256_set1_epi32((256 << (bit_depth - 8)) - 1);
+
+    for (int32_t i = 0; i < height; i++) {
+        uint16_t       *c = chroma + i * chroma_stride;
+        const uint16_t *l = luma + (i << chroma_subsamp_y) * luma_stride;
+        const int32_t  *g = grain + i * grain_stride;
+        for (int32_t j = 0; j < w8; j += 8) {
+            __m256i average_luma;
+            if (chroma_subsamp_x)
+                average_luma = average_luma_avx2(
+                    _mm256_loadu_si256((const __m256i *)(l + (j << 1))));
+            else
+                average_luma = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(l + j)));
+            const __m256i pixel  = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(c + j)));
+            const __m256i merged = chroma_merged_avx2(
+                average_luma, pixel, luma_mult_v, mult_v, offset_v, max_index);
+            const __m256i scale = scale_lut_avx2(scaling_lut, merged, bit_depth);
+            store_8x16_avx2(c + j,
+                            add_grain_avx2(pixel, scale, g + j, rounding, shift, min_val, max_val));
+        }
+    }
+    if (w8 < width)
+        svt_av1_add_chroma_grain_hbd_c(chroma + w8,
+                                       chroma_stride,
+                                       luma + (w8 << chroma_subsamp_x),
+                                       luma_stride,
+                                       grain + w8,
+                                       grain_stride,
+                                       width - w8,
+                                       height,
+                                       scaling_lut,
+                                       luma_mult,
+                                       mult,
+                                       offset,
+                                       scaling_shift,
+                                       min_chroma,
+                                       max_chroma,
+                                       chroma_subsamp_y,
+                                       chroma_subsamp_x,
+                                       bit_depth);
+}
@@ -0,0 +1,252 @@
+/*
+* Copyright(c) 2022 Intel Corporation
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include "EbDefinitions.h"
+
+#if EN_AVX512_SUPPORT
+#include <immintrin.h>
+#include "common_dsp_rtcd.h"
+
+// Same as scale_lut_avx2() on 16 values, reads entry 256 of the lut
+static INLINE __m512i scale_lut_avx512(const int32_t *scaling_lut, const __m512i index,
+                                       const int32_t bit_depth) {
+    if (bit_depth == 8)
+        return _mm512_i32gather_epi32(index, scaling_lut, 4);
+
+    const __m128i shift = _mm_cvtsi32_si128(bit_depth - 8);
+    const __m512i x     = _mm512_srl_epi32(index, shift);
+    const __m512i start = _mm512_i32gather_epi32(x, scaling_lut, 4);
+    const __m512i end   = _mm512_i32gather_epi32(
+        _mm512_add_epi32(x, _mm512_set1_epi32(1)), scaling_lut, 4);
+    const __m512i frac  = _mm512_and_si512(index, _mm512_set1_epi32((1 << (bit_depth - 8)) - 1));
+    const __m512i delta = _mm512_add_epi32(
+        _mm512_mullo_epi32(_mm512_sub_epi32(end, start), frac),
+        _mm512_set1_epi32(1 << (bit_depth - 9)));
+    return _mm512_add_epi32(start, _mm512_sra_epi32(delta, shift));
+}
+
+static INLINE __m512i add_grain_avx512(const __m512i pixel, const __m512i scale,
+                                       const int32_t *grain, const __m512i rounding,
+                                       const __m128i scaling_shift, const __m512i min_val,
+                                       const __m512i max_val) {
+    const __m512i g     = _mm512_loadu_si512((const __m512i *)grain);
+    const __m512i noise = _mm512_sra_epi32(
+        _mm512_add_epi32(_mm512_mullo_epi32(scale, g), rounding), scaling_shift);
+    return _mm512_min_epi32(_mm512_max_epi32(_mm512_add_epi32(pixel, noise), min_val), max_val);
+}
+
+void svt_av1_add_luma_grain_avx512(uint8_t *luma, int32_t luma_stride, const int32_t *grain,
+                                   int32_t grain_stride, int32_t width, int32_t height,
+                                   const int32_t *scaling_lut, int32_t scaling_shift,
+                                   int32_t min_luma, int32_t max_luma) {
+    const int32_t w16      = width & ~15;
+    const __m512i rounding = _mm512_set1_epi32(1 << (scaling_shift - 1));
+    const __m128i shift    = _mm_cvtsi32_si128(scaling_shift);
+    const __m512i min_val  = _mm512_set1_epi32(min_luma);
+    const __m512i max_val  = _mm512_set1_epi32(max_luma);
+
+    for (int32_t i = 0; i < height; i++) {
+        uint8_t       *l = luma + i * luma_stride;
+        const int32_t *g = grain + i * grain_stride;
+        for (int32_t j = 0; j < w16; j += 16) {
+            const __m512i pixel = _mm512_cvtepu8_epi32(_mm_loadu_si128((const __m128i *)(l + j)));
+            const __m512i scale = _mm512_i32gather_epi32(pixel, scaling_lut, 4);
+            _mm_storeu_si128(
+                (__m128i *)(l + j),
+                _mm512_cvtepi32_epi8(
+                    add_grain_avx512(pixel, scale, g + j, rounding, shift, min_val, max_val)));
+        }
+    }
+    if (w16 < width)
+        svt_av1_add_luma_grain_c(luma + w16,
+                                 luma_stride,
+                                 grain + w16,
+                                 grain_stride,
+                                 width - w16,
+                                 height,
+                                 scaling_lut,
+                                 scaling_shift,
+                                 min_luma,
+                                 max_luma);
+}
+
+void svt_av1_add_luma_grain_hbd_avx512(uint16_t *luma, int32_t luma_stride, const int32_t *grain,
+                                       int32_t grain_stride, int32_t width, int32_t height,
+                                       const int32_t *scaling_lut, int32_t scaling_shift,
+                                       int32_t min_luma, int32_t max_luma, int32_t bit_depth) {
+    const int32_t w16      = width & ~15;
+    const __m512i rounding = _mm512_set1_epi32(1 << (scaling_shift - 1));
+    const __m128i shift    = _mm_cvtsi32_si128(scaling_shift);
+    const __m512i min_val  = _mm512_set1_epi32(min_luma);
+    const __m512i max_val  = _mm512_set1_epi32(max_luma);
+
+    for (int32_t i = 0; i < height; i++) {
+        uint16_t      *l = luma + i * luma_stride;
+        const int32_t *g = grain + i * grain_stride;
+        for (int32_t j = 0; j < w16; j += 16) {
+            const __m512i pixel = _mm512_cvtepu16_epi32(
+                _mm256_loadu_si256((const __m256i *)(l + j)));
+            const __m512i scale = scale_lut_avx512(scaling_lut, pixel, bit_depth);
+            _mm256_storeu_si256(
+                (__m256i *)(l + j),
+                _mm512_cvtepi32_epi16(
+                    add_grain_avx512(pixel, scale, g + j, rounding, shift, min_val, max_val)));
+        }
+    }
+    if (w16 < width)
+        svt_av1_add_luma_grain_hbd_c(luma + w16,
+                                     luma_stride,
+                                     grain + w16,
+                                     grain_stride,
+                                     width - w16,
+                                     height,
+                                     scaling_lut,
+                                     scaling_shift,
+                                     min_luma,
+                                     max_luma,
+                                     bit_depth);
+}
+
+static INLINE __m512i chroma_merged_avx512(const __m512i average_luma, const __m512i chroma,
+                                           const __m512i luma_mult, const __m512i mult,
+                                           const __m512i offset, const __m512i max_index) {
+    const __m512i combined = _mm512_add_epi32(_mm512_mullo_epi32(average_luma, luma_mult),
+                                              _mm512_mullo_epi32(chroma, mult));
+    const __m512i merged   = _mm512_add_epi32(_mm512_srai_epi32(combined, 6), offset);
+    return _mm512_min_epi32(_mm512_max_epi32(merged, _mm512_setzero_si512()), max_index);
+}
+
+static INLINE __m512i average_luma_avx512(const __m512i luma_16) {
+    const __m512i sum = _mm512_madd_epi16(luma_16, _mm512_set1_epi16(1));
+    return _mm512_srli_epi32(_mm512_add_epi32(sum, _mm512_set1_epi32(1)), 1);
+}
+
+void svt_av1_add_chroma_grain_avx512(uint8_t *chroma, int32_t chroma_stride, const uint8_t *luma,
+                                     int32_t luma_stride, const int32_t *grain,
+                                     int32_t grain_stride, int32_t width, int32_t height,
+                                     const int32_t *scaling_lut, int32_t luma_mult, int32_t mult,
+                                     int32_t offset, int32_t scaling_shift, int32_t min_chroma,
+                                     int32_t max_chroma, int32_t chroma_subsamp_y,
+                                     int32_t chroma_subsamp_x) {
+    const int32_t w16         = width & ~15;
+    const __m512i rounding    = _mm512_set1_epi32(1 << (scaling_shift - 1));
+    const __m128i shift       = _mm_cvtsi32_si128(scaling_shift);
+    const __m512i min_val     = _mm512_set1_epi32(min_chroma);
+    const __m512i max_val     = _mm512_set1_epi32(max_chroma);
+    const __m512i luma_mult_v = _mm512_set1_epi32(luma_mult);
+    const __m512i mult_v      = _mm512_set1_epi32(mult);
+    const __m512i offset_v    = _mm512_set1_epi32(offset);
+    const __m512i max_index   = _mm512_set1_epi32(255);
+
+    for (int32_t i = 0; i < height; i++) {
+        uint8_t       *c = chroma + i * chroma_stride;
+        const uint8_t *l = luma + (i << chroma_subsamp_y) * luma_stride;
+        const int32_t *g = grain + i * grain_stride;
+        for (int32_t j = 0; j < w16; j += 16) {
+            __m512i average_luma;
+            if (chroma_subsamp_x)
+                average_luma = average_luma_avx512(
+                    _mm512_cvtepu8_epi16(_mm256_loadu_si256((const __m256i *)(l + (j << 1)))));
+            else
+                average_luma = _mm512_cvtepu8_epi32(_mm_loadu_si128((const __m128i *)(l + j)));
+            const __m512i pixel  = _mm512_cvtepu8_epi32(_mm_loadu_si128((const __m128i *)(c + j)));
+            const __m512i merged = chroma_merged_avx512(
+                average_luma, pixel, luma_mult_v, mult_v, offset_v, max_index);
+            const __m512i scale = _mm512_i32gather_epi32(merged, scaling_lut, 4);
+            _mm_storeu_si128(
+                (__m128i *)(c + j),
+                _mm512_cvtepi32_epi8(
+                    add_grain_avx512(pixel, scale, g + j, rounding, shift, min_val, max_val)));
+        }
+    }
+    if (w16 < width)
+        svt_av1_add_chroma_grain_c(chroma + w16,
+                                   chroma_stride,
+                                   luma + (w16 << chroma_subsamp_x),
+                                   luma_stride,
+                                   grain + w16,
+                                   grain_stride,
+                                   width - w16,
+                                   height,
+                                   scaling_lut,
+                                   luma_mult,
+                                   mult,
+                                   offset,
+                                   scaling_shift,
+                                   min_chroma,
+                                   max_chroma,
+                                   chroma_subsamp_y,
+                                   chroma_subsamp_x);
+}
+
+void svt_av1_add_chroma_grain_hbd_avx512(uint16_t *chroma, int32_t chroma_stride,
+                                         const uint16_t *luma, int32_t luma_stride,
+                                         const int32_t *grain, int32_t grain_stride,
+                                         int32_t width, int32_t height,
+                                         const int32_t *scaling_lut, int32_t luma_mult,
+                                         int32_t mult, int32_t offset, int32_t scaling_shift,
+                                         int32_t min_chroma, int32_t max_chroma,
+                                         int32_t chroma_subsamp_y, int32_t chroma_subsamp_x,
+                                         int32_t bit_depth) {
+    const int32_t w16         = width & ~15;
+    const __m512i rounding    = _mm512_set1_epi32(1 << (scaling_shift - 1));
+    const __m128i shift       = _mm_cvtsi32_si128(scaling_shift);
+    const __m512i min_val     = _mm512_set1_epi32(min_chroma);
+    const __m512i max_val     = _mm512_set1_epi32(max_chroma);
+    const __m512i luma_mult_v = _mm512_set1_epi32(luma_mult);
+    const __m512i mult_v      = _mm512_set1_epi32(mult);
+    const __m512i offset_v    = _mm512_set1_epi32(offset);
+    const __m512i max_index   = _mm512_set1_epi32((256 << (bit_depth - 8)) - 1);
+
+    for (int32_t i = 0; i < height; i++) {
+        uint16_t       *c = chroma + i * chroma_stride;
+        const uint16_t *l = luma + (i << chroma_subsamp_y) * luma_stride;
+        const int32_t  *g = grain + i * grain_stride;
+        for (int32_t j = 0; j < w16; j += 16) {
+            __m512i average_luma;
+            if (chroma_subsamp_x)
+                average_luma = average_luma_avx512(
+                    _mm512_loadu_si512((const __m512i *)(l + (j << 1))));
+            else
+                average_luma = _mm512_cvtepu16_epi32(
+                    _mm256_loadu_si256((const __m256i *)(l + j)));
+            const __m512i pixel = _mm512_cvtepu16_epi32(
+                _mm256_loadu_si256((const __m256i *)(c + j)));
+            const __m512i merged = chroma_merged_avx512(
+                average_luma, pixel, luma_mult_v, mult_v, offset_v, max_index);
+            const __m512i scale = scale_lut_avx512(scaling_lut, merged, bit_depth);
+            _mm256_storeu_si256(
+                (__m256i *)(c + j),
+                _mm512_cvtepi32_epi16(
+                    add_grain_avx512(pixel, scale, g + j, rounding, shift, min_val, max_val)));
+        }
+    }
+    if (w16 < width)
+        svt_av1_add_chroma_grain_hbd_c(chroma + w16,
+                                       chroma_stride,
+                                       luma + (w16 << chroma_subsamp_x),
+                                       luma_stride,
+                                       grain + w16,
+                                       grain_stride,
+                                       width - w16,
+                                       height,
+                                       scaling_lut,
+                                       luma_mult,
+                                       mult,
+                                       offset,
+                                       scaling_shift,
+                                       min_chroma,
+                                       max_chroma,
+                                       chroma_subsamp_y,
+                                       chroma_subsamp_x,
+                                       bit_depth);
+}
+#endif // EN_AVX512_SUPPORT
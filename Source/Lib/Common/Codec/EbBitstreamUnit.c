@@ -61,12 +61,18 @@ EbErrorType output_bitstream_reset(OutputBitstreamUnit *bitstream_ptr) {
 /********************************************************************************************************************************/
 /********************************************************************************************************************************/
 // daalaboolwriter.c
-void svt_aom_daala_start_encode(DaalaWriter *br, OutputBitstreamUnit *source) {
+void svt_aom_daala_start_encode(DaalaWriter *br, OutputBitstreamUnit *source, uint32_t size) {
     br->buffer        = source->buffer_av1;
     br->buffer_size   = source->size;
     br->buffer_parent = source;
     br->pos           = 0;
-    svt_od_ec_enc_init(&br->ec, 62025);
+    // The coder buffers are kept from one picture to the next, they are
+    // only reallocated when the expected size does not fit
+    if (br->ec.storage < size || br->ec.precarry_storage < size) {
+        svt_od_ec_enc_clear(&br->ec);
+        svt_od_ec_enc_init(&br->ec, size);
+    } else
+        svt_od_ec_enc_reset(&br->ec);
 }
 
 /* Realloc when bitstream pointer size is not enough to write data of size sz */
@@ -101,7 +107,6 @@ int32_t svt_aom_daala_stop_encode(DaalaWriter *br) {
         svt_memcpy_c(br->buffer, daala_data, daala_bytes);
 
     br->pos = daala_bytes;
-    svt_od_ec_enc_clear(&br->ec);
     return nb_bits;
 }
 
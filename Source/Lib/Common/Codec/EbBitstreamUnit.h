@@ -238,7 +238,8 @@ struct DaalaWriter {
 
 typedef struct DaalaWriter DaalaWriter;
 
-void        svt_aom_daala_start_encode(DaalaWriter *br, OutputBitstreamUnit *source);
+void        svt_aom_daala_start_encode(DaalaWriter *br, OutputBitstreamUnit *source,
+                                       uint32_t size);
 EbErrorType svt_realloc_output_bitstream_unit(OutputBitstreamUnit *output_bitstream_ptr,
                                               uint32_t             sz);
 int32_t     svt_aom_daala_stop_encode(DaalaWriter *w);
@@ -263,8 +264,9 @@ static INLINE void daala_write_symbol(DaalaWriter *w, int32_t symb, const AomCdf
 /********************************************************************************************************************************/
 // bitwriter.h
 typedef struct DaalaWriter AomWriter;
-static INLINE void         aom_start_encode(AomWriter *bc, OutputBitstreamUnit *buffer) {
-    svt_aom_daala_start_encode(bc, buffer);
+static INLINE void         aom_start_encode(AomWriter *bc, OutputBitstreamUnit *buffer,
+                                            uint32_t size) {
+    svt_aom_daala_start_encode(bc, buffer, size);
 }
 static INLINE int32_t aom_stop_encode(AomWriter *bc) { return svt_aom_daala_stop_encode(bc); }
 
@@ -15,30 +15,20 @@
 #include "EbSystemResourceManager.h"
 #include "EbDefinitions.h"
 #include "EbThreads.h"
+#include "EbTime.h"
 #if SRM_REPORT
 #include "EbLog.h"
 #endif
-static void svt_fifo_dctor(EbPtr p) {
-    EbFifo *obj = (EbFifo *)p;
-    EB_DESTROY_SEMAPHORE(obj->counting_semaphore);
-    EB_DESTROY_MUTEX(obj->lockout_mutex);
-}
+// number of tries on the object count before sleeping on the semaphore
+#define EB_FIFO_SPIN_COUNT 32
+
+static void svt_fifo_dctor(EbPtr p) { (void)p; }
+
 /**************************************
  * svt_fifo_ctor
  **************************************/
-static EbErrorType svt_fifo_ctor(EbFifo *fifoPtr, uint32_t initial_count, uint32_t max_count,
-                                 EbObjectWrapper *firstWrapperPtr, EbObjectWrapper *lastWrapperPtr,
-                                 EbMuxingQueue *queue_ptr) {
+static EbErrorType svt_fifo_ctor(EbFifo *fifoPtr, EbMuxingQueue *queue_ptr) {
     fifoPtr->dctor = svt_fifo_dctor;
-    // Create Counting Semaphore
-    EB_CREATE_SEMAPHORE(fifoPtr->counting_semaphore, initial_count, max_count);
-
-    // Create Buffer Pool Mutex
-    EB_CREATE_MUTEX(fifoPtr->lockout_mutex);
-
-    // Initialize Fifo First & Last ptrs
-    fifoPtr->first_ptr = firstWrapperPtr;
-    fifoPtr->last_ptr  = lastWrapperPtr;
 
     // Copy the Muxing Queue ptr this Fifo belongs to
     fifoPtr->queue_ptr = queue_ptr;
@@ -46,153 +36,12 @@ static EbErrorType svt_fifo_ctor(EbFifo *fifoPtr, uint32_t initial_count, uint32
     return EB_ErrorNone;
 }
 
-/**************************************
- * svt_fifo_push_back
- **************************************/
-static EbErrorType svt_fifo_push_back(EbFifo *fifoPtr, EbObjectWrapper *wrapper_ptr) {
-    EbErrorType return_error = EB_ErrorNone;
-
-    // If FIFO is empty
-    if (fifoPtr->first_ptr == (EbObjectWrapper *)NULL) {
-        fifoPtr->first_ptr = wrapper_ptr;
-        fifoPtr->last_ptr  = wrapper_ptr;
-    } else {
-        fifoPtr->last_ptr->next_ptr = wrapper_ptr;
-        fifoPtr->last_ptr           = wrapper_ptr;
-    }
-
-    fifoPtr->last_ptr->next_ptr = (EbObjectWrapper *)NULL;
-
-    return return_error;
-}
-
-/**************************************
- * svt_fifo_pop_front
- **************************************/
-static EbErrorType svt_fifo_pop_front(EbFifo *fifoPtr, EbObjectWrapper **wrapper_ptr) {
-    EbErrorType return_error = EB_ErrorNone;
-
-    // Set wrapper_ptr to head of BufferPool
-    *wrapper_ptr = fifoPtr->first_ptr;
-
-    // Update tail of BufferPool if the BufferPool is now empty
-    fifoPtr->last_ptr = (fifoPtr->first_ptr == fifoPtr->last_ptr) ? (EbObjectWrapper *)NULL
-                                                                  : fifoPtr->last_ptr;
-
-    // Update head of BufferPool
-    fifoPtr->first_ptr = fifoPtr->first_ptr->next_ptr;
-
-    return return_error;
-}
-
-static EbErrorType svt_fifo_shutdown(EbFifo *fifo_ptr) {
-    EbErrorType return_error = EB_ErrorNone;
-
-    // Acquire lockout Mutex
-    svt_block_on_mutex(fifo_ptr->lockout_mutex);
-    fifo_ptr->quit_signal = TRUE;
-    // Release Mutex
-    svt_release_mutex(fifo_ptr->lockout_mutex);
-    //Wake up the waiting process if any
-    svt_post_semaphore(fifo_ptr->counting_semaphore);
-
-    return return_error;
-}
-
-static void svt_circular_buffer_dctor(EbPtr p) {
-    EbCircularBuffer *obj = (EbCircularBuffer *)p;
-    EB_FREE(obj->array_ptr);
-}
-
-/**************************************
- * svt_circular_buffer_ctor
- **************************************/
-static EbErrorType svt_circular_buffer_ctor(EbCircularBuffer *bufferPtr,
-                                            uint32_t          buffer_total_count) {
-    bufferPtr->dctor = svt_circular_buffer_dctor;
-
-    bufferPtr->buffer_total_count = buffer_total_count;
-
-    EB_CALLOC(bufferPtr->array_ptr, bufferPtr->buffer_total_count, sizeof(EbPtr));
-
-    return EB_ErrorNone;
-}
-
-/**************************************
- * svt_circular_buffer_empty_check
- **************************************/
-static Bool svt_circular_buffer_empty_check(EbCircularBuffer *bufferPtr) {
-    return ((bufferPtr->head_index == bufferPtr->tail_index) &&
-            (bufferPtr->array_ptr[bufferPtr->head_index] == NULL))
-        ? TRUE
-        : FALSE;
-}
-
-/**************************************
- * svt_circular_buffer_pop_front
- **************************************/
-static EbErrorType svt_circular_buffer_pop_front(EbCircularBuffer *bufferPtr, EbPtr *object_ptr) {
-    EbErrorType return_error = EB_ErrorNone;
-
-    // Copy the head of the buffer into the object_ptr
-    *object_ptr                                 = bufferPtr->array_ptr[bufferPtr->head_index];
-    bufferPtr->array_ptr[bufferPtr->head_index] = NULL;
-
-    // Increment the head & check for rollover
-    bufferPtr->head_index = (bufferPtr->head_index == bufferPtr->buffer_total_count - 1)
-        ? 0
-        : bufferPtr->head_index + 1;
-
-    // Decrement the Current Count
-    --bufferPtr->current_count;
-
-    return return_error;
-}
-
-/**************************************
- * svt_circular_buffer_push_back
- **************************************/
-static EbErrorType svt_circular_buffer_push_back(EbCircularBuffer *bufferPtr, EbPtr object_ptr) {
-    EbErrorType return_error = EB_ErrorNone;
-
-    // Copy the pointer into the array
-    bufferPtr->array_ptr[bufferPtr->tail_index] = object_ptr;
-
-    // Increment the tail & check for rollover
-    bufferPtr->tail_index = (bufferPtr->tail_index == bufferPtr->buffer_total_count - 1)
-        ? 0
-        : bufferPtr->tail_index + 1;
-
-    // Increment the Current Count
-    ++bufferPtr->current_count;
-
-    return return_error;
-}
-
-/**************************************
- * svt_circular_buffer_push_front
- **************************************/
-static EbErrorType svt_circular_buffer_push_front(EbCircularBuffer *bufferPtr, EbPtr object_ptr) {
-    EbErrorType return_error = EB_ErrorNone;
-
-    // Decrement the head_index
-    bufferPtr->head_index = (bufferPtr->head_index == 0) ? bufferPtr->buffer_total_count - 1
-                                                         : bufferPtr->head_index - 1;
-
-    // Copy the pointer into the array
-    bufferPtr->array_ptr[bufferPtr->head_index] = object_ptr;
-
-    // Increment the Current Count
-    ++bufferPtr->current_count;
-
-    return return_error;
-}
-
 void svt_muxing_queue_dctor(EbPtr p) {
     EbMuxingQueue *obj = (EbMuxingQueue *)p;
     EB_DELETE_PTR_ARRAY(obj->process_fifo_ptr_array, obj->process_total_count);
-    EB_DELETE(obj->object_queue);
-    EB_DELETE(obj->process_queue);
+    EB_FREE(obj->cell_array);
+    EB_DESTROY_SEMAPHORE(obj->wait_semaphore);
+    EB_DESTROY_MUTEX(obj->stats_mutex);
     EB_DESTROY_MUTEX(obj->lockout_mutex);
 }
 
@@ -202,6 +51,7 @@ void svt_muxing_queue_dctor(EbPtr p) {
 static EbErrorType svt_muxing_queue_ctor(EbMuxingQueue *queue_ptr, uint32_t object_total_count,
                                          uint32_t process_total_count) {
     uint32_t    process_index;
+    uint32_t    cell_count   = 2;
     EbErrorType return_error = EB_ErrorNone;
 
     queue_ptr->dctor               = svt_muxing_queue_dctor;
@@ -209,86 +59,133 @@ static EbErrorType svt_muxing_queue_ctor(EbMuxingQueue *queue_ptr, uint32_t obje
 
     // Lockout Mutex
     EB_CREATE_MUTEX(queue_ptr->lockout_mutex);
+    EB_CREATE_MUTEX(queue_ptr->stats_mutex);
+    // Every waiting process gets at most one post, plus one per process at shutdown
+    EB_CREATE_SEMAPHORE(
+        queue_ptr->wait_semaphore, 0, object_total_count + queue_ptr->process_total_count);
+
+    // The ring holds every object of the SystemResource, so a push never finds it full
+    while (cell_count < object_total_count) cell_count <<= 1;
+    EB_CALLOC(queue_ptr->cell_array, cell_count, sizeof(EbFifoCell));
+    for (uint32_t cell_index = 0; cell_index < cell_count; ++cell_index)
+        queue_ptr->cell_array[cell_index].sequence = cell_index;
+    queue_ptr->cell_mask    = cell_count - 1;
+    queue_ptr->enqueue_pos  = 0;
+    queue_ptr->dequeue_pos  = 0;
+    queue_ptr->object_count = 0;
+    queue_ptr->quit_signal  = FALSE;
 
-    // Construct Object Circular Buffer
-    EB_NEW(queue_ptr->object_queue, svt_circular_buffer_ctor, object_total_count);
-    // Construct Process Circular Buffer
-    EB_NEW(queue_ptr->process_queue, svt_circular_buffer_ctor, queue_ptr->process_total_count);
     // Construct the Process Fifos
     EB_ALLOC_PTR_ARRAY(queue_ptr->process_fifo_ptr_array, queue_ptr->process_total_count);
 
     for (process_index = 0; process_index < queue_ptr->process_total_count; ++process_index) {
-        EB_NEW(queue_ptr->process_fifo_ptr_array[process_index],
-               svt_fifo_ctor,
-               0,
-               object_total_count,
-               (EbObjectWrapper *)NULL,
-               (EbObjectWrapper *)NULL,
-               queue_ptr);
+        EB_NEW(queue_ptr->process_fifo_ptr_array[process_index], svt_fifo_ctor, queue_ptr);
     }
 
     return return_error;
 }
 
 /**************************************
- * svt_muxing_queue_assignation
+ * svt_muxing_queue_object_push_back
+ *   Publishes the object in the next cell of the ring, then wakes
+ *   up one waiting process if the queue was empty.
  **************************************/
-static EbErrorType svt_muxing_queue_assignation(EbMuxingQueue *queue_ptr) {
-    EbErrorType      return_error = EB_ErrorNone;
-    EbFifo          *process_fifo_ptr;
-    EbObjectWrapper *wrapper_ptr;
+static void svt_muxing_queue_object_push_back(EbMuxingQueue *queue_ptr,
+                                              EbObjectWrapper *object_ptr) {
+    const uint32_t pos  = svt_atomic_fetch_add_u32(&queue_ptr->enqueue_pos, 1);
+    EbFifoCell    *cell = &queue_ptr->cell_array[pos & queue_ptr->cell_mask];
 
-    // while loop
-    while ((svt_circular_buffer_empty_check(queue_ptr->object_queue) == FALSE) &&
-           (svt_circular_buffer_empty_check(queue_ptr->process_queue) == FALSE)) {
-        // Get the next process
-        svt_circular_buffer_pop_front(queue_ptr->process_queue, (void **)&process_fifo_ptr);
+    // The cell may still be read by a process that got the object one lap ago
+    while (svt_atomic_load_u32(&cell->sequence) != pos) svt_cpu_relax();
+    cell->wrapper_ptr = object_ptr;
+    svt_atomic_store_u32(&cell->sequence, pos + 1);
 
-        // Get the next object
-        svt_circular_buffer_pop_front(queue_ptr->object_queue, (void **)&wrapper_ptr);
-
-        // Block on the Process Fifo's Mutex
-        svt_block_on_mutex(process_fifo_ptr->lockout_mutex);
-
-        // Put the object on the fifo
-        svt_fifo_push_back(process_fifo_ptr, wrapper_ptr);
+    if ((int32_t)svt_atomic_fetch_add_u32(&queue_ptr->object_count, 1) < 0)
+        svt_post_semaphore(queue_ptr->wait_semaphore);
+}
 
-        // Release the Process Fifo's Mutex
-        svt_release_mutex(process_fifo_ptr->lockout_mutex);
+/**************************************
+ * svt_muxing_queue_object_pop_front
+ *   Must only be called once an object has been reserved with
+ *   svt_muxing_queue_try_reserve or svt_muxing_queue_reserve.
+ **************************************/
+static EbObjectWrapper *svt_muxing_queue_object_pop_front(EbMuxingQueue *queue_ptr) {
+    const uint32_t   pos  = svt_atomic_fetch_add_u32(&queue_ptr->dequeue_pos, 1);
+    EbFifoCell      *cell = &queue_ptr->cell_array[pos & queue_ptr->cell_mask];
+    EbObjectWrapper *wrapper_ptr;
 
-        // Post the semaphore
-        svt_post_semaphore(process_fifo_ptr->counting_semaphore);
-    }
+    // The reserved object may be published out of order by a concurrent push
+    while (svt_atomic_load_u32(&cell->sequence) != pos + 1) svt_cpu_relax();
+    wrapper_ptr = cell->wrapper_ptr;
+    svt_atomic_store_u32(&cell->sequence, pos + queue_ptr->cell_mask + 1);
 
-    return return_error;
+    return wrapper_ptr;
 }
 
 /**************************************
- * svt_muxing_queue_object_push_back
+ * svt_muxing_queue_try_reserve
+ *   Takes one object from the count without blocking.
  **************************************/
-static EbErrorType svt_muxing_queue_object_push_back(EbMuxingQueue   *queue_ptr,
-                                                     EbObjectWrapper *object_ptr) {
-    EbErrorType return_error = EB_ErrorNone;
+static Bool svt_muxing_queue_try_reserve(EbMuxingQueue *queue_ptr) {
+    uint32_t count = svt_atomic_load_u32(&queue_ptr->object_count);
 
-    svt_circular_buffer_push_back(queue_ptr->object_queue, object_ptr);
-
-    svt_muxing_queue_assignation(queue_ptr);
-
-    return return_error;
+    while ((int32_t)count > 0) {
+        if (svt_atomic_cas_u32(&queue_ptr->object_count, count, count - 1))
+            return TRUE;
+        count = svt_atomic_load_u32(&queue_ptr->object_count);
+    }
+    return FALSE;
 }
 
 /**************************************
-* svt_muxing_queue_object_push_front
-**************************************/
-static EbErrorType svt_muxing_queue_object_push_front(EbMuxingQueue   *queue_ptr,
-                                                      EbObjectWrapper *object_ptr) {
-    EbErrorType return_error = EB_ErrorNone;
+ * svt_muxing_queue_reserve
+ *   Takes one object from the count, spins shortly then sleeps until
+ *   a push (or a shutdown) posts the semaphore if the queue is empty.
+ **************************************/
+static void svt_muxing_queue_reserve(EbMuxingQueue *queue_ptr) {
+    for (int spin = 0; spin < EB_FIFO_SPIN_COUNT; ++spin) {
+        if (svt_muxing_queue_try_reserve(queue_ptr))
+            return;
+        svt_cpu_relax();
+    }
+    if ((int32_t)svt_atomic_fetch_add_u32(&queue_ptr->object_count, (uint32_t)-1) <= 0) {
+        // Only the sleeps are timed, the fast path stays free of clock reads
+        const uint64_t start_time = svt_av1_get_time_us();
+        svt_block_on_mutex(queue_ptr->stats_mutex);
+        queue_ptr->wait_process_count++;
+        queue_ptr->wait_start_sum += start_time;
+        svt_release_mutex(queue_ptr->stats_mutex);
+
+        svt_block_on_semaphore(queue_ptr->wait_semaphore);
+
+        const uint64_t end_time = svt_av1_get_time_us();
+        svt_block_on_mutex(queue_ptr->stats_mutex);
+        queue_ptr->wait_process_count--;
+        queue_ptr->wait_start_sum -= start_time;
+        queue_ptr->wait_time += end_time - start_time;
+        svt_release_mutex(queue_ptr->stats_mutex);
+    }
+}
 
-    svt_circular_buffer_push_front(queue_ptr->object_queue, object_ptr);
+/**************************************
+ * svt_muxing_queue_get_wait_time
+ *   Sleep time of the finished waits plus the ongoing ones.
+ **************************************/
+static uint64_t svt_muxing_queue_get_wait_time(EbMuxingQueue *queue_ptr) {
+    const uint64_t now = svt_av1_get_time_us();
+    uint64_t       wait_time;
 
-    svt_muxing_queue_assignation(queue_ptr);
+    svt_block_on_mutex(queue_ptr->stats_mutex);
+    wait_time = queue_ptr->wait_time + queue_ptr->wait_process_count * now -
+        queue_ptr->wait_start_sum;
+    svt_release_mutex(queue_ptr->stats_mutex);
+    return wait_time;
+}
 
-    return return_error;
+// Objects in the queue, the count goes negative while processes wait on it
+static uint32_t svt_muxing_queue_get_object_count(EbMuxingQueue *queue_ptr) {
+    const int32_t count = (int32_t)svt_atomic_load_u32(&queue_ptr->object_count);
+    return count > 0 ? (uint32_t)count : 0;
 }
 
 static EbFifo *svt_muxing_queue_get_fifo(EbMuxingQueue *queue_ptr, uint32_t index) {
@@ -514,36 +411,16 @@ EbErrorType svt_shutdown_process(const EbSystemResource *resource_ptr) {
         return EB_ErrorNone;
 
     //notify all consumers we are shutting down
-    for (unsigned int i = 0; i < resource_ptr->full_queue->process_total_count; i++) {
-        EbFifo *fifo_ptr = svt_system_resource_get_consumer_fifo(resource_ptr, i);
-        svt_fifo_shutdown(fifo_ptr);
-    }
+    svt_atomic_store_u32(&resource_ptr->full_queue->quit_signal, TRUE);
+    for (unsigned int i = 0; i < resource_ptr->full_queue->process_total_count; i++)
+        svt_post_semaphore(resource_ptr->full_queue->wait_semaphore);
     return EB_ErrorNone;
 }
 
-/*********************************************************************
- * EbSystemResourceReleaseProcess
- *********************************************************************/
-static EbErrorType svt_release_process(EbFifo *process_fifo_ptr) {
-    EbErrorType return_error = EB_ErrorNone;
-
-    svt_block_on_mutex(process_fifo_ptr->queue_ptr->lockout_mutex);
-
-    svt_circular_buffer_push_front(process_fifo_ptr->queue_ptr->process_queue, process_fifo_ptr);
-
-    svt_muxing_queue_assignation(process_fifo_ptr->queue_ptr);
-
-    svt_release_mutex(process_fifo_ptr->queue_ptr->lockout_mutex);
-
-    return return_error;
-}
-
 /*********************************************************************
  * EbSystemResourcePostObject
  *   Queues a full EbObjectWrapper to the SystemResource. This
- *   function posts the SystemResource fullFifo counting_semaphore.
- *   This function is write protected by the SystemResource fullFifo
- *   lockout_mutex.
+ *   function does not lock, the full queue is lock-free.
  *
  *   resource_ptr
  *      pointer to the SystemResource that the EbObjectWrapper is
@@ -555,27 +432,41 @@ static EbErrorType svt_release_process(EbFifo *process_fifo_ptr) {
 EbErrorType svt_post_full_object(EbObjectWrapper *object_ptr) {
     EbErrorType return_error = EB_ErrorNone;
 
-    svt_block_on_mutex(object_ptr->system_resource_ptr->full_queue->lockout_mutex);
-
     svt_muxing_queue_object_push_back(object_ptr->system_resource_ptr->full_queue, object_ptr);
 
-    svt_release_mutex(object_ptr->system_resource_ptr->full_queue->lockout_mutex);
+    if (object_ptr->system_resource_ptr->post_callback)
+        object_ptr->system_resource_ptr->post_callback(
+            object_ptr->system_resource_ptr->post_callback_ctx);
 
     return return_error;
 }
 
+/*********************************************************************
+ * svt_object_push_empty
+ *   Queues a released EbObjectWrapper to the empty queue. The release
+ *   callback runs first, out of the empty queue lockout_mutex: the
+ *   object can not be reused before it returns.
+ *********************************************************************/
+static void svt_object_push_empty(EbObjectWrapper *object_ptr) {
+    if (object_ptr->system_resource_ptr->release_callback)
+        object_ptr->system_resource_ptr->release_callback(
+            object_ptr->object_ptr, object_ptr->system_resource_ptr->release_callback_ctx);
+
+    svt_muxing_queue_object_push_back(object_ptr->system_resource_ptr->empty_queue, object_ptr);
+}
+
 /*********************************************************************
  * EbSystemResourceReleaseObject
  *   Queues an empty EbObjectWrapper to the SystemResource. This
- *   function posts the SystemResource emptyFifo counting_semaphore.
- *   This function is write protected by the SystemResource emptyFifo
- *   lockout_mutex.
+ *   function is write protected by the SystemResource emptyFifo
+ *   lockout_mutex, which guards the live_count.
  *
  *   object_ptr
  *      pointer to EbObjectWrapper to be released.
  *********************************************************************/
 EbErrorType svt_release_object(EbObjectWrapper *object_ptr) {
     EbErrorType return_error = EB_ErrorNone;
+    Bool        released     = FALSE;
 
     svt_block_on_mutex(object_ptr->system_resource_ptr->empty_queue->lockout_mutex);
 
@@ -590,8 +481,7 @@ EbErrorType svt_release_object(EbObjectWrapper *object_ptr) {
         // Set live_count to EB_ObjectWrapperReleasedValue
         object_ptr->live_count = EB_ObjectWrapperReleasedValue;
 
-        svt_muxing_queue_object_push_front(object_ptr->system_resource_ptr->empty_queue,
-                                           object_ptr);
+        released = TRUE;
 #if SRM_REPORT
         object_ptr->pic_number = 99999999;
         //increment the fullness
@@ -605,11 +495,15 @@ EbErrorType svt_release_object(EbObjectWrapper *object_ptr) {
 
     svt_release_mutex(object_ptr->system_resource_ptr->empty_queue->lockout_mutex);
 
+    if (released)
+        svt_object_push_empty(object_ptr);
+
     return return_error;
 }
 
 EbErrorType svt_release_dual_object(EbObjectWrapper *object_ptr, EbObjectWrapper *sec_object_ptr) {
     EbErrorType return_error = EB_ErrorNone;
+    Bool        released     = FALSE;
 
     svt_block_on_mutex(object_ptr->system_resource_ptr->empty_queue->lockout_mutex);
 
@@ -624,8 +518,7 @@ EbErrorType svt_release_dual_object(EbObjectWrapper *object_ptr, EbObjectWrapper
         // Set live_count to EB_ObjectWrapperReleasedValue
         object_ptr->live_count = EB_ObjectWrapperReleasedValue;
 
-        svt_muxing_queue_object_push_front(object_ptr->system_resource_ptr->empty_queue,
-                                           object_ptr);
+        released = TRUE;
 
 #if SRM_REPORT
 
@@ -642,6 +535,9 @@ EbErrorType svt_release_dual_object(EbObjectWrapper *object_ptr, EbObjectWrapper
 
     svt_release_mutex(object_ptr->system_resource_ptr->empty_queue->lockout_mutex);
 
+    if (released)
+        svt_object_push_empty(object_ptr);
+
     return return_error;
 }
 #if SRM_REPORT
@@ -663,9 +559,7 @@ EbErrorType dump_srm_content(EbSystemResource *resource_ptr, uint8_t log) {
 /*********************************************************************
  * EbSystemResourceGetEmptyObject
  *   Dequeues an empty EbObjectWrapper from the SystemResource.  This
- *   function blocks on the SystemResource emptyFifo counting_semaphore.
- *   This function is write protected by the SystemResource emptyFifo
- *   lockout_mutex.
+ *   function only blocks when the SystemResource empty queue is empty.
  *
  *   resource_ptr
  *      pointer to the SystemResource that provides the empty
@@ -678,17 +572,11 @@ EbErrorType dump_srm_content(EbSystemResource *resource_ptr, uint8_t log) {
 EbErrorType svt_get_empty_object(EbFifo *empty_fifo_ptr, EbObjectWrapper **wrapper_dbl_ptr) {
     EbErrorType return_error = EB_ErrorNone;
 
-    // Queue the Fifo requesting the empty fifo
-    svt_release_process(empty_fifo_ptr);
-
-    // Block on the counting Semaphore until an empty buffer is available
-    svt_block_on_semaphore(empty_fifo_ptr->counting_semaphore);
-
-    // Acquire lockout Mutex
-    svt_block_on_mutex(empty_fifo_ptr->lockout_mutex);
+    // Block until an empty buffer is available
+    svt_muxing_queue_reserve(empty_fifo_ptr->queue_ptr);
 
     // Get the empty object
-    svt_fifo_pop_front(empty_fifo_ptr, wrapper_dbl_ptr);
+    *wrapper_dbl_ptr = svt_muxing_queue_object_pop_front(empty_fifo_ptr->queue_ptr);
 
 #if SRM_REPORT
     //decrement the fullness
@@ -709,18 +597,13 @@ EbErrorType svt_get_empty_object(EbFifo *empty_fifo_ptr, EbObjectWrapper **wrapp
     // Object release enable
     (*wrapper_dbl_ptr)->release_enable = TRUE;
 
-    // Release Mutex
-    svt_release_mutex(empty_fifo_ptr->lockout_mutex);
-
     return return_error;
 }
 
 /*********************************************************************
  * EbSystemResourceGetFullObject
  *   Dequeues an full EbObjectWrapper from the SystemResource. This
- *   function blocks on the SystemResource fullFifo counting_semaphore.
- *   This function is write protected by the SystemResource fullFifo
- *   lockout_mutex.
+ *   function only blocks when the SystemResource full queue is empty.
  *
  *   resource_ptr
  *      pointer to the SystemResource that provides the full
@@ -731,64 +614,47 @@ EbErrorType svt_get_empty_object(EbFifo *empty_fifo_ptr, EbObjectWrapper **wrapp
  *      EbObjectWrapper pointer.
  *********************************************************************/
 EbErrorType svt_get_full_object(EbFifo *full_fifo_ptr, EbObjectWrapper **wrapper_dbl_ptr) {
-    EbErrorType return_error = EB_ErrorNone;
+    EbMuxingQueue *queue_ptr = full_fifo_ptr->queue_ptr;
 
-    // Queue the Fifo requesting the full fifo
-    svt_release_process(full_fifo_ptr);
+    if (!svt_atomic_load_u32(&queue_ptr->quit_signal)) {
+        // Block until a full buffer is available
+        svt_muxing_queue_reserve(queue_ptr);
 
-    // Block on the counting Semaphore until an empty buffer is available
-    svt_block_on_semaphore(full_fifo_ptr->counting_semaphore);
-
-    // Acquire lockout Mutex
-    svt_block_on_mutex(full_fifo_ptr->lockout_mutex);
-
-    if (!full_fifo_ptr->quit_signal) {
-        svt_fifo_pop_front(full_fifo_ptr, wrapper_dbl_ptr);
-    } else {
-        *wrapper_dbl_ptr = NULL;
-        return_error     = EB_NoErrorFifoShutdown;
+        // The wake up may come from svt_shutdown_process
+        if (!svt_atomic_load_u32(&queue_ptr->quit_signal)) {
+            *wrapper_dbl_ptr = svt_muxing_queue_object_pop_front(queue_ptr);
+            return EB_ErrorNone;
+        }
     }
-
-    // Release Mutex
-    svt_release_mutex(full_fifo_ptr->lockout_mutex);
-
-    return return_error;
-}
-
-/**************************************
-* svt_fifo_pop_front
-**************************************/
-static Bool svt_fifo_peak_front(EbFifo *fifoPtr) {
-    // Set wrapper_ptr to head of BufferPool
-    if (fifoPtr->first_ptr == (EbObjectWrapper *)NULL)
-        return TRUE;
-    else
-        return FALSE;
+    *wrapper_dbl_ptr = NULL;
+    return EB_NoErrorFifoShutdown;
 }
 
 EbErrorType svt_get_full_object_non_blocking(EbFifo           *full_fifo_ptr,
                                              EbObjectWrapper **wrapper_dbl_ptr) {
-    EbErrorType return_error = EB_ErrorNone;
-    Bool      fifo_empty;
-    // Queue the Fifo requesting the full fifo
-    svt_release_process(full_fifo_ptr);
-
-    // Acquire lockout Mutex
-    svt_block_on_mutex(full_fifo_ptr->lockout_mutex);
+    EbMuxingQueue *queue_ptr = full_fifo_ptr->queue_ptr;
 
     //if the fifo is shutting down, we will not give any buffer to caller
-    if (!full_fifo_ptr->quit_signal)
-        fifo_empty = svt_fifo_peak_front(full_fifo_ptr);
-    else
-        fifo_empty = TRUE;
-
-    // Release Mutex
-    svt_release_mutex(full_fifo_ptr->lockout_mutex);
-
-    if (fifo_empty == FALSE)
-        svt_get_full_object(full_fifo_ptr, wrapper_dbl_ptr);
+    if (!svt_atomic_load_u32(&queue_ptr->quit_signal) && svt_muxing_queue_try_reserve(queue_ptr))
+        *wrapper_dbl_ptr = svt_muxing_queue_object_pop_front(queue_ptr);
     else
         *wrapper_dbl_ptr = (EbObjectWrapper *)NULL;
 
-    return return_error;
+    return EB_ErrorNone;
+}
+
+void svt_system_resource_get_stats(const EbSystemResource *resource_ptr,
+                                   EbSystemResourceStats  *stats_ptr) {
+    stats_ptr->object_total_count = resource_ptr->object_total_count;
+    stats_ptr->empty_count        = svt_muxing_queue_get_object_count(resource_ptr->empty_queue);
+    stats_ptr->producer_wait_time = svt_muxing_queue_get_wait_time(resource_ptr->empty_queue);
+    if (resource_ptr->full_queue) {
+        stats_ptr->full_count = svt_muxing_queue_get_object_count(resource_ptr->full_queue);
+        stats_ptr->full_get_count = svt_atomic_load_u32(&resource_ptr->full_queue->dequeue_pos);
+        stats_ptr->consumer_wait_time = svt_muxing_queue_get_wait_time(resource_ptr->full_queue);
+    } else {
+        stats_ptr->full_count         = 0;
+        stats_ptr->full_get_count     = 0;
+        stats_ptr->consumer_wait_time = 0;
+    }
 }
@@ -48,10 +48,6 @@ typedef struct EbObjectWrapper {
     // system_resource_ptr - a pointer to the SystemResourceManager
     //   that the object belongs to.
     struct EbSystemResource *system_resource_ptr;
-
-    // next_ptr - a pointer to a different EbObjectWrapper.  Used
-    //   only in the implemenation of a single-linked Fifo.
-    struct EbObjectWrapper *next_ptr;
 #if SRM_REPORT
     uint64_t pic_number;
 #endif
@@ -59,31 +55,12 @@ typedef struct EbObjectWrapper {
 
 /*********************************************************************
      * Fifo
-     *   Defines a static (i.e. no dynamic memory allocation) single
-     *   linked-list, constant time fifo implmentation. The fifo uses
-     *   the EbObjectWrapper member next_ptr to create the linked-list.
-     *   The Fifo also contains a counting_semaphore for OS thread-blocking
-     *   and dynamic EbObjectWrapper counting.
+     *   Handle used by one producer or consumer process to access a
+     *   MuxingQueue.  The objects are shared by all the processes of
+     *   the queue, the first process to ask gets the next object.
      *********************************************************************/
 typedef struct EbFifo {
     EbDctor dctor;
-    // counting_semaphore - used for OS thread-blocking & dynamically
-    //   counting the number of EbObjectWrappers currently in the
-    //   EbFifo.
-    EbHandle counting_semaphore;
-
-    // lockout_mutex - used to prevent more than one thread from
-    //   modifying EbFifo simultaneously.
-    EbHandle lockout_mutex;
-
-    // first_ptr - pointer the the head of the Fifo
-    EbObjectWrapper *first_ptr;
-
-    // last_ptr - pointer to the tail of the Fifo
-    EbObjectWrapper *last_ptr;
-
-    // quit_signal - a flag that main thread sets to break out from kernels
-    Bool quit_signal;
 
     // queue_ptr - pointer to MuxingQueue that the EbFifo is
     //   associated with.
@@ -91,31 +68,55 @@ typedef struct EbFifo {
 } EbFifo;
 
 /*********************************************************************
-     * CircularBuffer
+     * FifoCell
+     *   Slot of the MuxingQueue ring.  sequence tells whether the slot
+     *   is ready to be written (== position) or read (== position + 1).
      *********************************************************************/
-typedef struct EbCircularBuffer {
-    EbDctor  dctor;
-    EbPtr   *array_ptr;
-    uint32_t head_index;
-    uint32_t tail_index;
-    uint32_t buffer_total_count;
-    uint32_t current_count;
-} EbCircularBuffer;
+typedef struct EbFifoCell {
+    uint32_t         sequence;
+    EbObjectWrapper *wrapper_ptr;
+} EbFifoCell;
+
+#define EB_CACHE_LINE_SIZE 64
 
 /*********************************************************************
      * MuxingQueue
+     *   Bounded lock-free multi-producer / multi-consumer ring of
+     *   EbObjectWrappers.  object_count counts the objects available to
+     *   the consumers, it goes negative when consumers have to wait, in
+     *   which case they sleep on wait_semaphore.  Producers and consumers
+     *   only enter the OS when the queue is empty.
      *********************************************************************/
 typedef struct EbMuxingQueue {
-    EbDctor           dctor;
-    EbHandle          lockout_mutex;
-    EbCircularBuffer *object_queue;
-    EbCircularBuffer *process_queue;
-    uint32_t          process_total_count;
-    EbFifo          **process_fifo_ptr_array;
+    EbDctor dctor;
+    // lockout_mutex - protects the live_count and release_enable of the
+    //   objects released to this queue (see svt_release_object).
+    EbHandle    lockout_mutex;
+    EbHandle    wait_semaphore;
+    EbFifoCell *cell_array;
+    uint32_t    cell_mask;
+    uint32_t    process_total_count;
+    EbFifo    **process_fifo_ptr_array;
+    // quit_signal - set by svt_shutdown_process to break the consumers out
+    uint32_t quit_signal;
+    // stats_mutex - protects the wait statistics below, it is only taken
+    //   by the processes going to sleep on wait_semaphore (in us)
+    EbHandle stats_mutex;
+    uint32_t wait_process_count;
+    uint64_t wait_start_sum;
+    uint64_t wait_time;
 #if SRM_REPORT
     uint32_t curr_count; //run time fullness
     uint8_t  log; //if set monitor out the queue size
 #endif
+    // positions are on their own cache lines, they are hammered by different threads
+    uint8_t  pad0[EB_CACHE_LINE_SIZE];
+    uint32_t enqueue_pos;
+    uint8_t  pad1[EB_CACHE_LINE_SIZE - sizeof(uint32_t)];
+    uint32_t dequeue_pos;
+    uint8_t  pad2[EB_CACHE_LINE_SIZE - sizeof(uint32_t)];
+    uint32_t object_count;
+    uint8_t  pad3[EB_CACHE_LINE_SIZE - sizeof(uint32_t)];
 } EbMuxingQueue;
 
 /*********************************************************************
@@ -142,8 +143,39 @@ typedef struct EbSystemResource {
 
     // The full FIFO contains a queue of completed buffers
     EbMuxingQueue *full_queue;
+
+    // release_callback - optional, called with the object and
+    //   release_callback_ctx when an EbObjectWrapper goes back to the
+    //   empty queue, before it can be reused.  Called out of the empty
+    //   queue lockout_mutex.
+    void (*release_callback)(EbPtr object_ptr, EbPtr context_ptr);
+    EbPtr release_callback_ctx;
+
+    // post_callback - optional, called with post_callback_ctx once an
+    //   EbObjectWrapper has been queued to the full queue.
+    void (*post_callback)(EbPtr context_ptr);
+    EbPtr post_callback_ctx;
 } EbSystemResource;
 
+/*********************************************************************
+ * SystemResourceStats
+ *   Snapshot of a SystemResource, times are in us and include the
+ *   waits still in progress.
+ *********************************************************************/
+typedef struct EbSystemResourceStats {
+    uint32_t object_total_count;
+    // empty_count - objects available to the producers
+    uint32_t empty_count;
+    // full_count - objects posted and not yet taken by a consumer
+    uint32_t full_count;
+    // full_get_count - objects taken by the consumers so far
+    uint32_t full_get_count;
+    // producer_wait_time - time the producers slept waiting for an empty object
+    uint64_t producer_wait_time;
+    // consumer_wait_time - time the consumers slept waiting for a full object
+    uint64_t consumer_wait_time;
+} EbSystemResourceStats;
+
 /*********************************************************************
      * svt_object_release_enable
      *   Enables the release_enable member of EbObjectWrapper.  Used by
@@ -253,9 +285,8 @@ EbFifo *svt_system_resource_get_consumer_fifo(const EbSystemResource *resource_p
      * EbSystemResourceGetEmptyObject
      *   Dequeues an empty EbObjectWrapper from the SystemResource.  The
      *   new EbObjectWrapper will be populated with the contents of the
-     *   wrapperCopyPtr if wrapperCopyPtr is not NULL. This function blocks
-     *   on the SystemResource emptyFifo counting_semaphore. This function
-     *   is write protected by the SystemResource emptyFifo lockout_mutex.
+     *   wrapperCopyPtr if wrapperCopyPtr is not NULL. This function only
+     *   blocks when the SystemResource empty queue is empty.
      *
      *   resource_ptr
      *      pointer to the SystemResource that provides the empty
@@ -275,9 +306,7 @@ EbErrorType dump_srm_content(EbSystemResource *resource_ptr, uint8_t log);
 /*********************************************************************
      * EbSystemResourcePostObject
      *   Queues a full EbObjectWrapper to the SystemResource. This
-     *   function posts the SystemResource fullFifo counting_semaphore.
-     *   This function is write protected by the SystemResource fullFifo
-     *   lockout_mutex.
+     *   function does not lock, the full queue is lock-free.
      *
      *   resource_ptr
      *      pointer to the SystemResource that the EbObjectWrapper is
@@ -291,9 +320,7 @@ extern EbErrorType svt_post_full_object(EbObjectWrapper *object_ptr);
 /*********************************************************************
      * EbSystemResourceGetFullObject
      *   Dequeues an full EbObjectWrapper from the SystemResource. This
-     *   function blocks on the SystemResource fullFifo counting_semaphore.
-     *   This function is write protected by the SystemResource fullFifo
-     *   lockout_mutex.
+     *   function only blocks when the SystemResource full queue is empty.
      *
      *   resource_ptr
      *      pointer to the SystemResource that provides the full
@@ -308,12 +335,20 @@ extern EbErrorType svt_get_full_object(EbFifo *full_fifo_ptr, EbObjectWrapper **
 extern EbErrorType svt_get_full_object_non_blocking(EbFifo           *full_fifo_ptr,
                                                     EbObjectWrapper **wrapper_dbl_ptr);
 
+/*********************************************************************
+     * svt_system_resource_get_stats
+     *   Fills stats_ptr with the occupancy of the queues and the time
+     *   the processes spent sleeping on them.  Can be called from any
+     *   thread, the counters are sampled without stopping the pipeline.
+     *********************************************************************/
+extern void svt_system_resource_get_stats(const EbSystemResource *resource_ptr,
+                                          EbSystemResourceStats  *stats_ptr);
+
 /*********************************************************************
      * EbSystemResourceReleaseObject
      *   Queues an empty EbObjectWrapper to the SystemResource. This
-     *   function posts the SystemResource emptyFifo counting_semaphore.
-     *   This function is write protected by the SystemResource emptyFifo
-     *   lockout_mutex.
+     *   function is write protected by the SystemResource emptyFifo
+     *   lockout_mutex, which guards the live_count.
      *
      *   object_ptr
      *      pointer to EbObjectWrapper to be released.
@@ -397,13 +397,13 @@ EbErrorType svt_set_cond_var(CondVar *cond_var, int32_t newval) {
     EbErrorType return_error;
 #ifdef _WIN32
     EnterCriticalSection(&cond_var->cs);
-    cond_var->val = newval;
+    svt_atomic_store_u32((volatile uint32_t *)&cond_var->val, (uint32_t)newval);
     WakeAllConditionVariable(&cond_var->cv);
     LeaveCriticalSection(&cond_var->cs);
     return_error = EB_ErrorNone;
 #else
-    return_error  = pthread_mutex_lock(&cond_var->m_mutex);
-    cond_var->val = newval;
+    return_error = pthread_mutex_lock(&cond_var->m_mutex);
+    svt_atomic_store_u32((volatile uint32_t *)&cond_var->val, (uint32_t)newval);
     return_error |= pthread_cond_broadcast(&cond_var->m_cond);
     return_error |= pthread_mutex_unlock(&cond_var->m_mutex);
 #endif
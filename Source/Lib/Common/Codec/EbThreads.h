@@ -119,6 +119,71 @@ extern EbErrorType svt_destroy_mutex(EbHandle mutex_handle);
 
 void atomic_set_u32(AtomicVarU32 *var, uint32_t in);
 
+/**************************************
+     * Lock-free atomics
+     *   load has acquire, store has release and the read-modify-write
+     *   operations have full barrier semantics.
+     **************************************/
+#ifdef _WIN32
+static INLINE uint32_t svt_atomic_load_u32(volatile uint32_t *ptr) {
+    const uint32_t val = *ptr;
+    MemoryBarrier();
+    return val;
+}
+static INLINE void svt_atomic_store_u32(volatile uint32_t *ptr, uint32_t val) {
+    InterlockedExchange((volatile LONG *)ptr, (LONG)val);
+}
+// returns the value before the addition
+static INLINE uint32_t svt_atomic_fetch_add_u32(volatile uint32_t *ptr, uint32_t val) {
+    return (uint32_t)InterlockedExchangeAdd((volatile LONG *)ptr, (LONG)val);
+}
+static INLINE Bool svt_atomic_cas_u32(volatile uint32_t *ptr, uint32_t expected,
+                                      uint32_t desired) {
+    return InterlockedCompareExchange((volatile LONG *)ptr, (LONG)desired, (LONG)expected) ==
+        (LONG)expected;
+}
+static INLINE uint64_t svt_atomic_load_u64(volatile uint64_t *ptr) {
+    return (uint64_t)InterlockedCompareExchange64((volatile LONG64 *)ptr, 0, 0);
+}
+// returns the value before the addition
+static INLINE uint64_t svt_atomic_fetch_add_u64(volatile uint64_t *ptr, uint64_t val) {
+    return (uint64_t)InterlockedExchangeAdd64((volatile LONG64 *)ptr, (LONG64)val);
+}
+static INLINE void svt_cpu_relax(void) { YieldProcessor(); }
+#else
+static INLINE uint32_t svt_atomic_load_u32(volatile uint32_t *ptr) {
+    return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+}
+static INLINE void svt_atomic_store_u32(volatile uint32_t *ptr, uint32_t val) {
+    __atomic_store_n(ptr, val, __ATOMIC_RELEASE);
+}
+// returns the value before the addition
+static INLINE uint32_t svt_atomic_fetch_add_u32(volatile uint32_t *ptr, uint32_t val) {
+    return __atomic_fetch_add(ptr, val, __ATOMIC_SEQ_CST);
+}
+static INLINE Bool svt_atomic_cas_u32(volatile uint32_t *ptr, uint32_t expected,
+                                      uint32_t desired) {
+    return __atomic_compare_exchange_n(
+               ptr, &expected, desired, 0, __ATOMIC_SEQ_CST, __ATOMIC_ACQUIRE)
+        ? TRUE
+        : FALSE;
+}
+static INLINE uint64_t svt_atomic_load_u64(volatile uint64_t *ptr) {
+    return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+}
+// returns the value before the addition
+static INLINE uint64_t svt_atomic_fetch_add_u64(volatile uint64_t *ptr, uint64_t val) {
+    return __atomic_fetch_add(ptr, val, __ATOMIC_SEQ_CST);
+}
+static INLINE void svt_cpu_relax(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+}
+#endif
+
 /*
  Condition variable
 */
@@ -136,6 +201,10 @@ typedef struct CondVar {
 EbErrorType svt_set_cond_var(CondVar *cond_var, int32_t newval);
 EbErrorType svt_wait_cond_var(CondVar *cond_var, int32_t input);
 EbErrorType svt_create_cond_var(CondVar *cond_var);
+// current value of the cond variable, read without the lock (acquire)
+static INLINE int32_t svt_get_cond_var(CondVar *cond_var) {
+    return (int32_t)svt_atomic_load_u32((volatile uint32_t *)&cond_var->val);
+}
 
 #ifdef __cplusplus
 }
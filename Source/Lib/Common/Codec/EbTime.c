@@ -55,3 +55,9 @@ void svt_av1_get_time(uint64_t *const seconds, uint64_t *const useconds) {
     *useconds = curr_time.tv_usec;
 #endif
 }
+
+uint64_t svt_av1_get_time_us(void) {
+    uint64_t seconds, useconds;
+    svt_av1_get_time(&seconds, &useconds);
+    return seconds * 1000000 + useconds;
+}
@@ -0,0 +1,130 @@
+/*
+* Copyright(c) 2022 Intel Corporation
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include "EbWorkerPool.h"
+#include "EbThreads.h"
+#include "EbTime.h"
+
+static void svt_worker_pool_dctor(EbPtr p) {
+    EbWorkerPool *obj = (EbWorkerPool *)p;
+    if (obj->wake_semaphore) {
+        // Wake up every worker, they leave once they see the quit signal
+        svt_atomic_store_u32(&obj->quit_signal, TRUE);
+        for (uint32_t i = 0; i < obj->worker_count; i++) svt_post_semaphore(obj->wake_semaphore);
+    }
+    EB_DESTROY_THREAD_ARRAY(obj->thread_handle_array, obj->worker_count);
+    EB_FREE_ARRAY(obj->worker_array);
+    EB_DESTROY_SEMAPHORE(obj->wake_semaphore);
+}
+
+EbErrorType svt_worker_pool_ctor(EbWorkerPool *pool_ptr, uint32_t worker_count) {
+    pool_ptr->dctor        = svt_worker_pool_dctor;
+    pool_ptr->worker_count = worker_count;
+    pool_ptr->stage_count  = 0;
+    pool_ptr->idle_count   = 0;
+    pool_ptr->quit_signal  = FALSE;
+
+    EB_CREATE_SEMAPHORE(pool_ptr->wake_semaphore, 0, 0x7FFFFFFF);
+    EB_ALLOC_PTR_ARRAY(pool_ptr->thread_handle_array, worker_count);
+    EB_CALLOC_ARRAY(pool_ptr->worker_array, worker_count);
+    for (uint32_t i = 0; i < worker_count; i++) {
+        pool_ptr->worker_array[i].pool_ptr = pool_ptr;
+        pool_ptr->worker_array[i].index    = i;
+    }
+    return EB_ErrorNone;
+}
+
+/*********************************************************************
+ * svt_worker_pool_notify
+ *   post_callback of the stage input resources.  The read of
+ *   idle_count is a full barrier so it cannot pass the push of the
+ *   object, see svt_worker_pool_kernel.
+ *********************************************************************/
+static void svt_worker_pool_notify(EbPtr context_ptr) {
+    EbWorkerPool *pool_ptr = (EbWorkerPool *)context_ptr;
+    if (svt_atomic_fetch_add_u32(&pool_ptr->idle_count, 0))
+        svt_post_semaphore(pool_ptr->wake_semaphore);
+}
+
+EbErrorType svt_worker_pool_add_stage(EbWorkerPool *pool_ptr, EbSystemResource *input_resource_ptr,
+                                      EbWorkerPoolTask task, EbThreadContext **context_ptr_array) {
+    if (pool_ptr->stage_count == EB_WORKER_POOL_MAX_STAGES)
+        return EB_ErrorInsufficientResources;
+
+    EbWorkerPoolStage *stage_ptr = &pool_ptr->stage_array[pool_ptr->stage_count++];
+    stage_ptr->input_resource_ptr = input_resource_ptr;
+    stage_ptr->input_fifo_ptr    = svt_system_resource_get_consumer_fifo(input_resource_ptr, 0);
+    stage_ptr->task              = task;
+    stage_ptr->context_ptr_array = context_ptr_array;
+
+    input_resource_ptr->post_callback     = svt_worker_pool_notify;
+    input_resource_ptr->post_callback_ctx = pool_ptr;
+    return EB_ErrorNone;
+}
+
+/*********************************************************************
+ * svt_worker_pool_run_task
+ *   Runs one task, looking at the home stage of the worker first.
+ *   Returns FALSE when all the stage queues are empty.
+ *********************************************************************/
+static Bool svt_worker_pool_run_task(EbWorkerPool *pool_ptr, EbPoolWorker *worker_ptr) {
+    const uint32_t worker_index = worker_ptr->index;
+    const uint32_t home_stage   = worker_index % pool_ptr->stage_count;
+
+    for (uint32_t i = 0; i < pool_ptr->stage_count; i++) {
+        uint32_t stage_index = home_stage + i;
+        if (stage_index >= pool_ptr->stage_count)
+            stage_index -= pool_ptr->stage_count;
+        EbWorkerPoolStage *stage_ptr = &pool_ptr->stage_array[stage_index];
+        EbObjectWrapper   *input_wrapper_ptr;
+
+        svt_get_full_object_non_blocking(stage_ptr->input_fifo_ptr, &input_wrapper_ptr);
+        if (input_wrapper_ptr) {
+            const uint64_t start_time = svt_av1_get_time_us();
+            stage_ptr->task(stage_ptr->context_ptr_array[worker_index], input_wrapper_ptr);
+            svt_atomic_fetch_add_u64(&worker_ptr->busy_time[stage_index],
+                                     svt_av1_get_time_us() - start_time);
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+void *svt_worker_pool_kernel(void *input_ptr) {
+    EbPoolWorker *worker_ptr = (EbPoolWorker *)input_ptr;
+    EbWorkerPool *pool_ptr   = worker_ptr->pool_ptr;
+
+    while (!svt_atomic_load_u32(&pool_ptr->quit_signal)) {
+        if (svt_worker_pool_run_task(pool_ptr, worker_ptr))
+            continue;
+        // Declare the worker idle before the last look at the queues, an object
+        // posted after that look sees the idle worker and posts the semaphore
+        svt_atomic_fetch_add_u32(&pool_ptr->idle_count, 1);
+        if (!svt_worker_pool_run_task(pool_ptr, worker_ptr) &&
+            !svt_atomic_load_u32(&pool_ptr->quit_signal))
+            svt_block_on_semaphore(pool_ptr->wake_semaphore);
+        svt_atomic_fetch_add_u32(&pool_ptr->idle_count, (uint32_t)-1);
+    }
+    return NULL;
+}
+
+uint64_t svt_worker_pool_get_busy_time(const EbWorkerPool     *pool_ptr,
+                                       const EbSystemResource *input_resource_ptr) {
+    uint64_t busy_time = 0;
+    for (uint32_t stage_index = 0; stage_index < pool_ptr->stage_count; stage_index++) {
+        if (pool_ptr->stage_array[stage_index].input_resource_ptr != input_resource_ptr)
+            continue;
+        for (uint32_t i = 0; i < pool_ptr->worker_count; i++)
+            busy_time += svt_atomic_load_u64(
+                (volatile uint64_t *)&pool_ptr->worker_array[i].busy_time[stage_index]);
+    }
+    return busy_time;
+}
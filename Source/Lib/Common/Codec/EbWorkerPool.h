@@ -0,0 +1,113 @@
+/*
+* Copyright(c) 2022 Intel Corporation
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#ifndef EbWorkerPool_h
+#define EbWorkerPool_h
+
+#include "EbDefinitions.h"
+#include "EbSystemResourceManager.h"
+#include "EbObject.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define EB_WORKER_POOL_MAX_STAGES 16
+
+/*********************************************************************
+     * WorkerPoolTask
+     *   Processes one object of the input queue of a stage, it must
+     *   release the input object as the stage kernel does.
+     *********************************************************************/
+typedef void (*EbWorkerPoolTask)(EbThreadContext *thread_context_ptr,
+                                 EbObjectWrapper *input_wrapper_ptr);
+
+typedef struct EbWorkerPoolStage {
+    EbSystemResource *input_resource_ptr;
+    // input_fifo_ptr - consumer fifo of the stage input queue
+    EbFifo          *input_fifo_ptr;
+    EbWorkerPoolTask task;
+    // context_ptr_array - one context per worker, owned by the caller
+    EbThreadContext **context_ptr_array;
+} EbWorkerPoolStage;
+
+typedef struct EbPoolWorker {
+    struct EbWorkerPool *pool_ptr;
+    uint32_t             index;
+    // busy_time - time spent in the tasks of each stage (in us), only
+    //   written by the worker, read with svt_atomic_load_u64 by the stats
+    volatile uint64_t busy_time[EB_WORKER_POOL_MAX_STAGES];
+} EbPoolWorker;
+
+/*********************************************************************
+     * WorkerPool
+     *   Shared threads running the tasks of several pipeline stages.
+     *   Each worker starts with its home stage (worker index modulo the
+     *   stage count) and steals from the other stages when the home
+     *   queue is empty, so the workers follow the bottleneck stage.
+     *   The workers sleep on wake_semaphore when all the queues are
+     *   empty, the stage input resources post it (post_callback).
+     *
+     *   The pool only adds processing capacity: each stage keeps at
+     *   least one dedicated kernel thread, which guarantees the pipeline
+     *   progress when the workers are blocked inside tasks.
+     *********************************************************************/
+typedef struct EbWorkerPool {
+    EbDctor           dctor;
+    uint32_t          worker_count;
+    uint32_t          stage_count;
+    EbWorkerPoolStage stage_array[EB_WORKER_POOL_MAX_STAGES];
+    EbPoolWorker     *worker_array;
+    EbHandle         *thread_handle_array;
+    EbHandle          wake_semaphore;
+    uint32_t          idle_count;
+    uint32_t          quit_signal;
+} EbWorkerPool;
+
+extern EbErrorType svt_worker_pool_ctor(EbWorkerPool *pool_ptr, uint32_t worker_count);
+
+/*********************************************************************
+     * svt_worker_pool_add_stage
+     *   Registers a stage, must be called before the workers start.
+     *
+     *   input_resource_ptr
+     *      SystemResource whose full queue feeds the stage.
+     *
+     *   context_ptr_array
+     *      worker_count contexts of the stage, worker i runs the task
+     *      with context_ptr_array[i].
+     *********************************************************************/
+extern EbErrorType svt_worker_pool_add_stage(EbWorkerPool     *pool_ptr,
+                                             EbSystemResource *input_resource_ptr,
+                                             EbWorkerPoolTask  task,
+                                             EbThreadContext **context_ptr_array);
+
+/*********************************************************************
+     * svt_worker_pool_kernel
+     *   Thread function of a worker, input_ptr is &worker_array[i].  The
+     *   owner creates the threads in thread_handle_array once all the
+     *   stages are registered, so that they follow its affinity settings;
+     *   the pool destructor stops and joins them.
+     *********************************************************************/
+extern void *svt_worker_pool_kernel(void *input_ptr);
+
+/*********************************************************************
+     * svt_worker_pool_get_busy_time
+     *   Time spent by all the workers in the tasks of the stage fed by
+     *   input_resource_ptr (in us), 0 if no such stage is registered.
+     *********************************************************************/
+extern uint64_t svt_worker_pool_get_busy_time(const EbWorkerPool     *pool_ptr,
+                                              const EbSystemResource *input_resource_ptr);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbWorkerPool_h
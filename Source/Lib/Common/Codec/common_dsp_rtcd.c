@@ -722,6 +722,10 @@ void setup_common_rtcd_internal(CPU_FLAGS flags) {
     SET_AVX2_AVX512(svt_aom_highbd_h_predictor_64x64, svt_aom_highbd_h_predictor_64x64_c, svt_aom_highbd_h_predictor_64x64_avx2, aom_highbd_h_predictor_64x64_avx512);
     SET_SSE2(svt_log2f, log2f_32, Log2f_ASM);
     SET_SSE2(svt_memcpy, svt_memcpy_c, svt_memcpy_intrin_sse);
+    SET_AVX2_AVX512(svt_av1_add_luma_grain, svt_av1_add_luma_grain_c, svt_av1_add_luma_grain_avx2, svt_av1_add_luma_grain_avx512);
+    SET_AVX2_AVX512(svt_av1_add_luma_grain_hbd, svt_av1_add_luma_grain_hbd_c, svt_av1_add_luma_grain_hbd_avx2, svt_av1_add_luma_grain_hbd_avx512);
+    SET_AVX2_AVX512(svt_av1_add_chroma_grain, svt_av1_add_chroma_grain_c, svt_av1_add_chroma_grain_avx2, svt_av1_add_chroma_grain_avx512);
+    SET_AVX2_AVX512(svt_av1_add_chroma_grain_hbd, svt_av1_add_chroma_grain_hbd_c, svt_av1_add_chroma_grain_hbd_avx2, svt_av1_add_chroma_grain_hbd_avx512);
 
 }
 // clang-format on
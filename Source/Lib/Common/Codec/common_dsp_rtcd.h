@@ -1069,6 +1069,14 @@ extern "C" {
     RTCD_EXTERN uint32_t(*svt_log2f)(uint32_t x);
     void svt_memcpy_c(void  *dst_ptr, void  const*src_ptr, size_t size);
     RTCD_EXTERN void (*svt_memcpy)(void  *dst_ptr, void  const*src_ptr, size_t size);
+    void svt_av1_add_luma_grain_c(uint8_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, const int32_t *scaling_lut, int32_t scaling_shift, int32_t min_luma, int32_t max_luma);
+    RTCD_EXTERN void(*svt_av1_add_luma_grain)(uint8_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, const int32_t *scaling_lut, int32_t scaling_shift, int32_t min_luma, int32_t max_luma);
+    void svt_av1_add_luma_grain_hbd_c(uint16_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, const int32_t *scaling_lut, int32_t scaling_shift, int32_t min_luma, int32_t max_luma, int32_t bit_depth);
+    RTCD_EXTERN void(*svt_av1_add_luma_grain_hbd)(uint16_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, const int32_t *scaling_lut, int32_t scaling_shift, int32_t min_luma, int32_t max_luma, int32_t bit_depth);
+    void svt_av1_add_chroma_grain_c(uint8_t *chroma, int32_t chroma_stride, const uint8_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, const int32_t *scaling_lut, int32_t luma_mult, int32_t mult, int32_t offset, int32_t scaling_shift, int32_t min_chroma, int32_t max_chroma, int32_t chroma_subsamp_y, int32_t chroma_subsamp_x);
+    RTCD_EXTERN void(*svt_av1_add_chroma_grain)(uint8_t *chroma, int32_t chroma_stride, const uint8_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, const int32_t *scaling_lut, int32_t luma_mult, int32_t mult, int32_t offset, int32_t scaling_shift, int32_t min_chroma, int32_t max_chroma, int32_t chroma_subsamp_y, int32_t chroma_subsamp_x);
+    void svt_av1_add_chroma_grain_hbd_c(uint16_t *chroma, int32_t chroma_stride, const uint16_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, const int32_t *scaling_lut, int32_t luma_mult, int32_t mult, int32_t offset, int32_t scaling_shift, int32_t min_chroma, int32_t max_chroma, int32_t chroma_subsamp_y, int32_t chroma_subsamp_x, int32_t bit_depth);
+    RTCD_EXTERN void(*svt_av1_add_chroma_grain_hbd)(uint16_t *chroma, int32_t chroma_stride, const uint16_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, const int32_t *scaling_lut, int32_t luma_mult, int32_t mult, int32_t offset, int32_t scaling_shift, int32_t min_chroma, int32_t max_chroma, int32_t chroma_subsamp_y, int32_t chroma_subsamp_x, int32_t bit_depth);
 #ifdef ARCH_X86_64
 
     void svt_aom_blend_a64_vmask_sse4_1(uint8_t *dst, uint32_t dst_stride, const uint8_t *src0, uint32_t src0_stride, const uint8_t *src1, uint32_t src1_stride, const uint8_t *mask, int w, int h);
@@ -2246,6 +2254,16 @@ extern "C" {
     uint32_t Log2f_ASM(uint32_t x);
 
     extern void svt_memcpy_intrin_sse (void  *dst_ptr, void  const *src_ptr, size_t size);
+
+    void svt_av1_add_luma_grain_avx2(uint8_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, const int32_t *scaling_lut, int32_t scaling_shift, int32_t min_luma, int32_t max_luma);
+    void svt_av1_add_luma_grain_hbd_avx2(uint16_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, const int32_t *scaling_lut, int32_t scaling_shift, int32_t min_luma, int32_t max_luma, int32_t bit_depth);
+    void svt_av1_add_chroma_grain_avx2(uint8_t *chroma, int32_t chroma_stride, const uint8_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, const int32_t *scaling_lut, int32_t luma_mult, int32_t mult, int32_t offset, int32_t scaling_shift, int32_t min_chroma, int32_t max_chroma, int32_t chroma_subsamp_y, int32_t chroma_subsamp_x);
+    void svt_av1_add_chroma_grain_hbd_avx2(uint16_t *chroma, int32_t chroma_stride, const uint16_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, const int32_t *scaling_lut, int32_t luma_mult, int32_t mult, int32_t offset, int32_t scaling_shift, int32_t min_chroma, int32_t max_chroma, int32_t chroma_subsamp_y, int32_t chroma_subsamp_x, int32_t bit_depth);
+
+    void svt_av1_add_luma_grain_avx512(uint8_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, const int32_t *scaling_lut, int32_t scaling_shift, int32_t min_luma, int32_t max_luma);
+    void svt_av1_add_luma_grain_hbd_avx512(uint16_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, const int32_t *scaling_lut, int32_t scaling_shift, int32_t min_luma, int32_t max_luma, int32_t bit_depth);
+    void svt_av1_add_chroma_grain_avx512(uint8_t *chroma, int32_t chroma_stride, const uint8_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, const int32_t *scaling_lut, int32_t luma_mult, int32_t mult, int32_t offset, int32_t scaling_shift, int32_t min_chroma, int32_t max_chroma, int32_t chroma_subsamp_y, int32_t chroma_subsamp_x);
+    void svt_av1_add_chroma_grain_hbd_avx512(uint16_t *chroma, int32_t chroma_stride, const uint16_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, const int32_t *scaling_lut, int32_t luma_mult, int32_t mult, int32_t offset, int32_t scaling_shift, int32_t min_chroma, int32_t max_chroma, int32_t chroma_subsamp_y, int32_t chroma_subsamp_x, int32_t bit_depth);
 #endif
 
 
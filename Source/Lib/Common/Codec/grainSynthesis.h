@@ -102,6 +102,61 @@ void svt_av1_add_film_grain_run(AomFilmGrain *grain_params, uint8_t *luma, uint8
                                 int32_t chroma_stride, int32_t use_high_bit_depth,
                                 int32_t chroma_subsamp_y, int32_t chroma_subsamp_x);
 
+/*!\brief Film grain state of a frame
+     *
+     * The grain templates and the scaling functions are generated once per
+     * frame, the grain is then added stripe by stripe so that the stripes can
+     * be split between threads
+     */
+typedef struct FilmGrainFrame {
+    AomFilmGrain params;
+    uint8_t     *luma;
+    uint8_t     *cb;
+    uint8_t     *cr;
+    int32_t      height;
+    int32_t      width;
+    int32_t      luma_stride;
+    int32_t      chroma_stride;
+    int32_t      use_high_bit_depth;
+    int32_t      chroma_subsamp_y;
+    int32_t      chroma_subsamp_x;
+    int32_t     *luma_grain_block;
+    int32_t     *cb_grain_block;
+    int32_t     *cr_grain_block;
+    int32_t      luma_grain_stride;
+    int32_t      chroma_grain_stride;
+    // the last entry repeats entry 255 for the high bit depth interpolation
+    int32_t scaling_lut_y[257];
+    int32_t scaling_lut_cb[257];
+    int32_t scaling_lut_cr[257];
+    int32_t grain_min;
+    int32_t grain_max;
+} FilmGrainFrame;
+
+/*!\brief Generate the grain templates and the scaling functions of a frame
+     *
+     * Takes the same arguments as svt_av1_add_film_grain_run, the grain
+     * templates have to be released with svt_av1_film_grain_free
+     */
+void svt_av1_film_grain_init(FilmGrainFrame *fg, AomFilmGrain *grain_params, uint8_t *luma,
+                             uint8_t *cb, uint8_t *cr, int32_t height, int32_t width,
+                             int32_t luma_stride, int32_t chroma_stride,
+                             int32_t use_high_bit_depth, int32_t chroma_subsamp_y,
+                             int32_t chroma_subsamp_x);
+
+/*!\brief Number of 32 luma rows stripes of the frame */
+int32_t svt_av1_film_grain_num_stripes(const FilmGrainFrame *fg);
+
+/*!\brief Add film grain to the stripes [first_stripe, end_stripe)
+     *
+     * Disjoint ranges of stripes can be processed concurrently, the result is
+     * the same as the one of svt_av1_add_film_grain_run
+     */
+void svt_av1_film_grain_add_stripes(const FilmGrainFrame *fg, int32_t first_stripe,
+                                    int32_t end_stripe);
+
+void svt_av1_film_grain_free(FilmGrainFrame *fg);
+
 /*!\brief Add film grain
      *
      * Add film grain to an image
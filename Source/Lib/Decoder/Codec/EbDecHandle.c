@@ -55,22 +55,15 @@ Bool         alternate_groups = 0;
 cpu_set_t group_affinity;
 #endif
 
-EbMemoryMapEntry *svt_dec_memory_map;
-uint32_t         *svt_dec_memory_map_index;
-uint64_t         *svt_dec_total_lib_memory;
-
-uint32_t svt_dec_lib_malloc_count = 0;
-
-/* Track address for memory during change in resoultion*/
-EbMemoryMapEntry *memory_map_start_address;
-EbMemoryMapEntry *memory_map_end_address;
-
 void        asm_set_convolve_asm_table(void);
 void        init_intra_dc_predictors_c_internal(void);
 void        asm_set_convolve_hbd_asm_table(void);
 void        init_intra_predictors_internal(void);
 extern void svt_av1_init_wedge_masks(void);
 void        dec_sync_all_threads(EbDecHandle *dec_handle_ptr);
+void        dec_wait_frame_slot(EbDecHandle *frame_slot);
+void        dec_close_frame_slots(EbDecHandle *dec_handle_ptr);
+void        dec_film_grain_stripes(EbDecHandle *dec_handle_ptr);
 
 EbErrorType decode_multiple_obu(EbDecHandle *dec_handle_ptr, uint8_t **data, size_t data_size,
                                 uint32_t is_annexb);
@@ -97,24 +90,85 @@ static EbErrorType svt_dec_handle_ctor(EbDecHandle    **decHandleDblPtr,
     *decHandleDblPtr            = dec_handle_ptr;
     if (dec_handle_ptr == (EbDecHandle *)NULL)
         return EB_ErrorInsufficientResources;
-    dec_handle_ptr->memory_map       = (EbMemoryMapEntry *)malloc(sizeof(EbMemoryMapEntry));
-    dec_handle_ptr->memory_map_index = 0;
-    dec_handle_ptr->total_lib_memory = sizeof(EbComponentType) + sizeof(EbDecHandle) +
-        sizeof(EbMemoryMapEntry);
-    dec_handle_ptr->memory_map_init_address = dec_handle_ptr->memory_map;
-    // Save Memory Map Pointers
-    svt_dec_total_lib_memory = &dec_handle_ptr->total_lib_memory;
-    svt_dec_memory_map       = dec_handle_ptr->memory_map;
-    svt_dec_memory_map_index = &dec_handle_ptr->memory_map_index;
-    svt_dec_lib_malloc_count = 0;
-
-    dec_handle_ptr->start_thread_process = FALSE;
-    memory_map_start_address             = NULL;
-    memory_map_end_address               = NULL;
+    EbDecMemMap *mem_map    = (EbDecMemMap *)malloc(sizeof(EbDecMemMap));
+    dec_handle_ptr->mem_map = mem_map;
+    if (mem_map == NULL)
+        return EB_ErrorInsufficientResources;
+    mem_map->memory_map = (EbMemoryMapEntry *)malloc(sizeof(EbMemoryMapEntry));
+    if (mem_map->memory_map == NULL)
+        return EB_ErrorInsufficientResources;
+    mem_map->memory_map->ptr        = NULL;
+    mem_map->memory_map->ptr_type   = EB_PTR_TYPE_TOTAL;
+    mem_map->memory_map->prev_entry = NULL;
+    mem_map->memory_map_index       = 0;
+    mem_map->total_lib_memory       = sizeof(EbComponentType) + sizeof(EbDecHandle) +
+        sizeof(EbDecMemMap) + sizeof(EbMemoryMapEntry);
+    mem_map->memory_map_init_address = mem_map->memory_map;
+
+    dec_handle_ptr->start_thread_process     = FALSE;
+
+    memset(dec_handle_ptr->frame_slots, 0, sizeof(dec_handle_ptr->frame_slots));
+    dec_handle_ptr->next_frame_slot    = 0;
+    dec_handle_ptr->output_queue_start = 0;
+    dec_handle_ptr->output_queue_count = 0;
+    dec_handle_ptr->eos_received       = FALSE;
+    dec_handle_ptr->frame_error        = EB_ErrorNone;
+    dec_handle_ptr->main_dec_handle    = NULL;
+    dec_handle_ptr->pv_pic_mgr         = NULL;
+    dec_handle_ptr->superres_buf       = NULL;
+    dec_handle_ptr->superres_buf_size  = 0;
+
 
     return return_error;
 }
 
+/* Adds the film grain to the output picture. With MT decode, the library
+   threads wait for the next frame, they take stripes with the application
+   thread */
+static void dec_add_film_grain(EbDecHandle *dec_handle_ptr, AomFilmGrain *film_grain_ptr,
+                               uint8_t *luma, uint8_t *cb, uint8_t *cr, int32_t height,
+                               int32_t width, int32_t luma_stride, int32_t chroma_stride,
+                               int32_t use_high_bit_depth, int32_t sy, int32_t sx) {
+    FilmGrainFrame *film_grain = &dec_handle_ptr->film_grain;
+
+    svt_av1_film_grain_init(film_grain,
+                            film_grain_ptr,
+                            luma,
+                            cb,
+                            cr,
+                            height,
+                            width,
+                            luma_stride,
+                            chroma_stride,
+                            use_high_bit_depth,
+                            sy,
+                            sx);
+    int32_t num_stripes = svt_av1_film_grain_num_stripes(film_grain);
+    /* With frame parallel decode, the library threads belong to the busy frame slots */
+    if (dec_handle_ptr->dec_config.threads > 1 && dec_handle_ptr->start_thread_process) {
+        DecMtFrameData *dec_mt_frame_data =
+            &dec_handle_ptr->main_frame_buf.cur_frame_bufs[0].dec_mt_frame_data;
+        DecMtRowInfo *stripe_info = &dec_mt_frame_data->film_grain_stripe_info;
+
+        svt_block_on_mutex(stripe_info->sbrow_mutex);
+        svt_set_cond_var(&dec_mt_frame_data->film_grain_stripes_done, 0);
+        stripe_info->num_sb_rows       = num_stripes;
+        stripe_info->sb_row_to_process = 0;
+        svt_release_mutex(stripe_info->sbrow_mutex);
+        svt_set_cond_var(&dec_mt_frame_data->lib_threads_wake,
+                         svt_get_cond_var(&dec_mt_frame_data->lib_threads_wake) + 1);
+
+        dec_film_grain_stripes(dec_handle_ptr);
+        int32_t stripes_done;
+        while ((stripes_done = svt_get_cond_var(&dec_mt_frame_data->film_grain_stripes_done)) <
+               num_stripes)
+            svt_wait_cond_var(&dec_mt_frame_data->film_grain_stripes_done, stripes_done);
+    } else
+        svt_av1_film_grain_add_stripes(film_grain, 0, num_stripes);
+
+    svt_av1_film_grain_free(film_grain);
+}
+
 /* FilmGrain module req. even dim. for internal operation
    For odd luma, chroma uses data from even pixel in luma*/
 static void copy_even(uint8_t *luma, uint32_t wd, uint32_t ht, uint32_t stride, int32_t use_hbd) {
@@ -133,22 +187,17 @@ static void copy_even(uint8_t *luma, uint32_t wd, uint32_t ht, uint32_t stride,
     }
 }
 /* Copy from recon buffer to out buffer! */
-int svt_dec_out_buf(EbDecHandle *dec_handle_ptr, EbBufferHeaderType *p_buffer) {
-    EbPictureBufferDesc *recon_picture_buf = dec_handle_ptr->cur_pic_buf[0]->ps_pic_buf;
+static int svt_dec_out_buf(EbDecHandle *dec_handle_ptr, DecOutputPic *out_pic,
+                           EbBufferHeaderType *p_buffer) {
+    EbPictureBufferDesc *recon_picture_buf = out_pic->pic_buf->ps_pic_buf;
     EbSvtIOFormat       *out_img           = (EbSvtIOFormat *)p_buffer->p_buffer;
 
     uint8_t *luma = NULL;
     uint8_t *cb   = NULL;
     uint8_t *cr   = NULL;
 
-    /* TODO: Should add logic for show_existing_frame */
-    if (0 == dec_handle_ptr->show_frame) {
-        assert(0 == dec_handle_ptr->show_existing_frame);
-        return 0;
-    }
-
-    uint32_t wd = dec_handle_ptr->frame_header.frame_size.superres_upscaled_width;
-    uint32_t ht = dec_handle_ptr->frame_header.frame_size.frame_height;
+    uint32_t wd = out_pic->pic_buf->superres_upscaled_width;
+    uint32_t ht = out_pic->pic_buf->frame_height;
     int      sx = 0, sy = 0;
     /* FilmGrain module req. even dim. for internal operation */
     int even_w = (wd & 1) ? (wd + 1) : wd;
@@ -371,7 +420,7 @@ int svt_dec_out_buf(EbDecHandle *dec_handle_ptr, EbBufferHeaderType *p_buffer) {
 
     if (!dec_handle_ptr->dec_config.skip_film_grain) {
         /* Need to fill the dst buf with recon data before calling film_grain */
-        AomFilmGrain *film_grain_ptr = &dec_handle_ptr->cur_pic_buf[0]->film_grain_params;
+        AomFilmGrain *film_grain_ptr = &out_pic->film_grain_params;
         if (film_grain_ptr->apply_grain) {
             switch (recon_picture_buf->bit_depth) {
             case EB_8BIT: film_grain_ptr->bit_depth = 8; break;
@@ -379,23 +428,131 @@ int svt_dec_out_buf(EbDecHandle *dec_handle_ptr, EbBufferHeaderType *p_buffer) {
             default: assert(0);
             }
             copy_even(luma, wd, ht, out_img->y_stride, use_high_bit_depth);
-            svt_av1_add_film_grain_run(film_grain_ptr,
-                                       luma,
-                                       cb,
-                                       cr,
-                                       even_h, /*(ht & 1 ? ht + 1 : ht),*/
-                                       even_w, /*(wd & 1 ? wd + 1 : ht),*/
-                                       out_img->y_stride,
-                                       out_img->cb_stride,
-                                       use_high_bit_depth,
-                                       sy,
-                                       sx);
+            dec_add_film_grain(dec_handle_ptr,
+                               film_grain_ptr,
+                               luma,
+                               cb,
+                               cr,
+                               even_h, /*(ht & 1 ? ht + 1 : ht),*/
+                               even_w, /*(wd & 1 ? wd + 1 : ht),*/
+                               out_img->y_stride,
+                               out_img->cb_stride,
+                               use_high_bit_depth,
+                               sy,
+                               sx);
         }
     }
 
     return 1;
 }
 
+/* Zero copy output : the planes of the external frame buffer are handed to
+   the application. Film grain and the 8-bit output of the 16-bit pipeline
+   need a separate output copy, also from the external allocator. */
+static int svt_dec_ext_out_buf(EbDecHandle *dec_handle_ptr, DecOutputPic *out_pic,
+                               EbBufferHeaderType *p_buffer) {
+    EbDecPicBuf         *pic_buf           = out_pic->pic_buf;
+    EbPictureBufferDesc *recon_picture_buf = pic_buf->ps_pic_buf;
+    EbSvtIOFormat       *out_img           = (EbSvtIOFormat *)p_buffer->p_buffer;
+
+    uint32_t wd = pic_buf->superres_upscaled_width;
+    uint32_t ht = pic_buf->frame_height;
+
+    out_img->width     = wd;
+    out_img->height    = ht;
+    out_img->origin_x  = 0;
+    out_img->origin_y  = 0;
+    out_img->color_fmt = recon_picture_buf->color_format;
+    out_img->bit_depth = (EbBitDepth)recon_picture_buf->bit_depth;
+    out_img->luma_ext  = NULL;
+    out_img->cb_ext    = NULL;
+    out_img->cr_ext    = NULL;
+
+    int need_copy = (recon_picture_buf->is_16bit_pipeline &&
+                     recon_picture_buf->bit_depth == EB_8BIT) ||
+        (!dec_handle_ptr->dec_config.skip_film_grain && out_pic->film_grain_params.apply_grain);
+
+    if (!need_copy) {
+        int      use_hbd = recon_picture_buf->bit_depth == EB_8BIT ? 0 : 1;
+        uint16_t ss_x    = recon_picture_buf->color_format == EB_YUV444 ? 0 : 1;
+        uint16_t ss_y    = recon_picture_buf->color_format == EB_YUV420 ? 1 : 0;
+
+        out_img->y_stride  = recon_picture_buf->stride_y;
+        out_img->cb_stride = recon_picture_buf->stride_cb;
+        out_img->cr_stride = recon_picture_buf->stride_cr;
+        out_img->luma      = recon_picture_buf->buffer_y +
+            ((recon_picture_buf->origin_x + recon_picture_buf->origin_y * recon_picture_buf->stride_y)
+             << use_hbd);
+        if (recon_picture_buf->color_format != EB_YUV400) {
+            out_img->cb = recon_picture_buf->buffer_cb +
+                (((recon_picture_buf->origin_x >> ss_x) +
+                  (recon_picture_buf->origin_y >> ss_y) * recon_picture_buf->stride_cb)
+                 << use_hbd);
+            out_img->cr = recon_picture_buf->buffer_cr +
+                (((recon_picture_buf->origin_x >> ss_x) +
+                  (recon_picture_buf->origin_y >> ss_y) * recon_picture_buf->stride_cr)
+                 << use_hbd);
+        } else {
+            out_img->cb = NULL;
+            out_img->cr = NULL;
+        }
+        return 1;
+    }
+
+    /* Same layout as the copy to the application buffer */
+    int      size        = recon_picture_buf->bit_depth == EB_8BIT ? sizeof(uint8_t) : sizeof(uint16_t);
+    uint32_t even_w      = (wd & 1) ? (wd + 1) : wd;
+    uint32_t even_h      = (ht & 1) ? (ht + 1) : ht;
+    uint32_t chroma_size = 0;
+    switch (recon_picture_buf->color_format) {
+    case EB_YUV400:
+        out_img->cb_stride = INT32_MAX;
+        out_img->cr_stride = INT32_MAX;
+        break;
+    case EB_YUV420:
+        out_img->cb_stride = (wd + 1) >> 1;
+        chroma_size        = size * (((wd + 1) >> 1) * ((ht + 1) >> 1));
+        break;
+    case EB_YUV422:
+        out_img->cb_stride = (wd + 1) >> 1;
+        chroma_size        = size * (((wd + 1) >> 1) * ht);
+        break;
+    case EB_YUV444:
+        out_img->cb_stride = wd;
+        chroma_size        = size * ht * wd;
+        break;
+    default: SVT_ERROR("Unsupported colour format.\n"); return 0;
+    }
+    if (recon_picture_buf->color_format != EB_YUV400)
+        out_img->cr_stride = out_img->cb_stride;
+    out_img->y_stride = even_w;
+
+    uint32_t luma_size = size * even_w * even_h;
+    uint32_t min_size  = luma_size + 2 * chroma_size;
+
+    /* The output copy is kept with the picture and reused */
+    EbSvtAv1DecConfiguration *dec_config  = &dec_handle_ptr->dec_config;
+    EbExtFrameBuf            *ext_out_buf = &pic_buf->ext_out_buf;
+    if (ext_out_buf->buffer != NULL && ext_out_buf->buffer_size < min_size) {
+        dec_config->release_frame_buffer(ext_out_buf, dec_config->frame_buffer_private_data);
+        ext_out_buf->buffer = NULL;
+    }
+    if (ext_out_buf->buffer == NULL) {
+        if (dec_config->allocate_frame_buffer(
+                ext_out_buf, min_size, dec_config->frame_buffer_private_data) != 0 ||
+            ext_out_buf->buffer == NULL || ext_out_buf->buffer_size < min_size) {
+            ext_out_buf->buffer = NULL;
+            SVT_ERROR("External output frame buffer allocation failed.\n");
+            return 0;
+        }
+    }
+    out_img->luma = ext_out_buf->buffer;
+    out_img->cb   = chroma_size ? ext_out_buf->buffer + luma_size : NULL;
+    out_img->cr   = chroma_size ? ext_out_buf->buffer + luma_size + chroma_size : NULL;
+
+    return svt_dec_out_buf(dec_handle_ptr, out_pic, p_buffer);
+}
+
 /**********************************
 Set Default Library Params
 **********************************/
@@ -429,6 +586,11 @@ EbErrorType svt_svt_dec_set_default_parameter(EbSvtAv1DecConfiguration *config_p
     config_ptr->threads      = 1;
     config_ptr->num_p_frames = 1;
 
+    /* Output is copied to the application buffer */
+    config_ptr->allocate_frame_buffer     = NULL;
+    config_ptr->release_frame_buffer      = NULL;
+    config_ptr->frame_buffer_private_data = NULL;
+
     return return_error;
 }
 
@@ -510,6 +672,11 @@ EB_API EbErrorType svt_av1_dec_set_parameter(EbComponentType          *svt_dec_c
 
     EbDecHandle *dec_handle_ptr = (EbDecHandle *)svt_dec_component->p_component_private;
 
+    /* The external frame buffer callbacks go together */
+    if ((config_struct->allocate_frame_buffer == NULL) !=
+        (config_struct->release_frame_buffer == NULL))
+        return EB_ErrorBadParameter;
+
     dec_handle_ptr->dec_config        = *config_struct;
     dec_handle_ptr->is_16bit_pipeline = config_struct->is_16bit_pipeline;
 
@@ -528,9 +695,16 @@ EB_API EbErrorType svt_av1_dec_init(EbComponentType *svt_dec_component) {
     CPU_FLAGS cpu_flags = 0;
 #endif
     dec_handle_ptr->dec_cnt       = -1;
-    dec_handle_ptr->num_frms_prll = 1;
-    if (dec_handle_ptr->num_frms_prll > DEC_MAX_NUM_FRM_PRLL)
-        dec_handle_ptr->num_frms_prll = DEC_MAX_NUM_FRM_PRLL;
+    dec_handle_ptr->num_frms_prll = (int32_t)CLIP3(
+        1, DEC_MAX_NUM_FRM_PRLL, (int32_t)dec_handle_ptr->dec_config.num_p_frames);
+    /* Every frame in flight is decoded by its own share of at least 2 threads */
+    if (dec_handle_ptr->num_frms_prll > 1 &&
+        dec_handle_ptr->dec_config.threads / dec_handle_ptr->num_frms_prll < 2) {
+        dec_handle_ptr->num_frms_prll = MAX((int32_t)dec_handle_ptr->dec_config.threads / 2, 1);
+        SVT_WARN("Not enough threads for %u frames in parallel, using %d\n",
+                 dec_handle_ptr->dec_config.num_p_frames,
+                 dec_handle_ptr->num_frms_prll);
+    }
     dec_handle_ptr->seq_header_done = 0;
     dec_handle_ptr->mem_init_done   = 0;
 
@@ -568,9 +742,21 @@ EB_API EbErrorType svt_av1_dec_frame(EbComponentType *svt_dec_component, const u
     if (svt_dec_component == NULL)
         return EB_ErrorBadParameter;
 
-    EbDecHandle *dec_handle_ptr       = (EbDecHandle *)svt_dec_component->p_component_private;
-    uint8_t     *data_start           = (uint8_t *)data;
-    uint8_t     *data_end             = (uint8_t *)data + data_size;
+    EbDecHandle *dec_handle_ptr = (EbDecHandle *)svt_dec_component->p_component_private;
+
+    /* End of stream : the frames in flight are output without delay */
+    dec_handle_ptr->eos_received = (data == NULL || data_size == 0);
+    if (dec_handle_ptr->eos_received)
+        return EB_ErrorNone;
+
+    /* Frame parallel decode never drops shown frames : the pictures ready
+       for output have to be taken before more data is sent */
+    if (dec_handle_ptr->num_frms_prll > 1 &&
+        dec_handle_ptr->output_queue_count >= dec_handle_ptr->num_frms_prll)
+        return EB_ErrorInsufficientResources;
+
+    uint8_t *data_start               = (uint8_t *)data;
+    uint8_t *data_end                 = (uint8_t *)data + data_size;
     dec_handle_ptr->seen_frame_header = 0;
 
     while (data_start < data_end) {
@@ -580,11 +766,42 @@ EB_API EbErrorType svt_av1_dec_frame(EbComponentType *svt_dec_component, const u
 
         uint64_t frame_size = 0;
         frame_size          = data_end - data_start;
+
+        /* No room for the shown frame of the next frame */
+        if (dec_handle_ptr->output_queue_count >= DEC_MAX_OUTPUT_QUEUE) {
+            return_error = EB_ErrorInsufficientResources;
+            break;
+        }
+
+        dec_handle_ptr->show_frame = 0;
         return_error = decode_multiple_obu(dec_handle_ptr, &data_start, frame_size, is_annexb);
 
         if (return_error != EB_ErrorNone)
             assert(0);
 
+        /* Queue the shown frame for output */
+        if (return_error == EB_ErrorNone && dec_handle_ptr->show_frame &&
+            dec_handle_ptr->cur_pic_buf[0] != NULL) {
+            /* One frame at a time : the last shown frame replaces the one not taken */
+            if (dec_handle_ptr->num_frms_prll == 1 && dec_handle_ptr->output_queue_count) {
+                DecOutputPic *old_pic =
+                    &dec_handle_ptr->output_queue[dec_handle_ptr->output_queue_start];
+                dec_pic_mgr_release_pic(old_pic->pic_buf);
+                old_pic->pic_buf                   = NULL;
+                dec_handle_ptr->output_queue_start = (dec_handle_ptr->output_queue_start + 1) %
+                    DEC_MAX_OUTPUT_QUEUE;
+                dec_handle_ptr->output_queue_count--;
+            }
+            DecOutputPic *out_pic =
+                &dec_handle_ptr->output_queue[(dec_handle_ptr->output_queue_start +
+                                               dec_handle_ptr->output_queue_count) %
+                                              DEC_MAX_OUTPUT_QUEUE];
+            out_pic->pic_buf           = dec_handle_ptr->cur_pic_buf[0];
+            out_pic->film_grain_params = dec_handle_ptr->cur_pic_buf[0]->film_grain_params;
+            ++out_pic->pic_buf->ref_count;
+            dec_handle_ptr->output_queue_count++;
+        }
+
         dec_pic_mgr_update_ref_pic(dec_handle_ptr,
                                    (EB_ErrorNone == return_error) ? 1 : 0,
                                    dec_handle_ptr->frame_header.refresh_frame_flags);
@@ -604,6 +821,11 @@ EB_API EbErrorType svt_av1_dec_frame(EbComponentType *svt_dec_component, const u
             dec_handle_ptr->frame_header.frame_type);*/
     }
 
+    /* A frame decoded by a frame slot failed */
+    if (return_error == EB_ErrorNone && dec_handle_ptr->frame_error != EB_ErrorNone) {
+        return_error                = dec_handle_ptr->frame_error;
+        dec_handle_ptr->frame_error = EB_ErrorNone;
+    }
     return return_error;
 }
 
@@ -619,12 +841,71 @@ EB_API EbErrorType svt_av1_dec_get_picture(EbComponentType    *svt_dec_component
         return EB_ErrorBadParameter;
 
     EbDecHandle *dec_handle_ptr = (EbDecHandle *)svt_dec_component->p_component_private;
-    /* Copy from recon pointer and return! TODO: Should remove the svt_memcpy! */
-    if (0 == svt_dec_out_buf(dec_handle_ptr, p_buffer))
-        return_error = EB_DecNoOutputPicture;
+
+    /* A frame decoded by a frame slot failed */
+    if (dec_handle_ptr->frame_error != EB_ErrorNone) {
+        return_error                = dec_handle_ptr->frame_error;
+        dec_handle_ptr->frame_error = EB_ErrorNone;
+        return return_error;
+    }
+
+    /* Frame parallel decode : output is delayed by the frames in flight */
+    if (dec_handle_ptr->output_queue_count == 0 ||
+        (dec_handle_ptr->output_queue_count < dec_handle_ptr->num_frms_prll &&
+         !dec_handle_ptr->eos_received))
+        return EB_DecNoOutputPicture;
+
+    DecOutputPic *out_pic = &dec_handle_ptr->output_queue[dec_handle_ptr->output_queue_start];
+    if (svt_get_cond_var(&out_pic->pic_buf->rows_done) != INT32_MAX) {
+        for (int32_t i = 0; i < DEC_MAX_NUM_FRM_PRLL; i++) {
+            EbDecHandle *frame_slot = dec_handle_ptr->frame_slots[i];
+            if (frame_slot != NULL && frame_slot->frame_slot_busy &&
+                frame_slot->cur_pic_buf[0] == out_pic->pic_buf)
+                dec_wait_frame_slot(frame_slot);
+        }
+    }
+
+    if (svt_get_cond_var(&out_pic->pic_buf->rows_done) == DEC_PIC_FAILED) {
+        /* The error of the frame is returned in place of the picture */
+        return_error                = EB_Corrupt_Frame;
+        dec_handle_ptr->frame_error = EB_ErrorNone;
+        dec_pic_mgr_release_pic(out_pic->pic_buf);
+    } else if (dec_handle_ptr->dec_config.allocate_frame_buffer != NULL) {
+        /* The reference moves to the application until the picture is released */
+        if (0 == svt_dec_ext_out_buf(dec_handle_ptr, out_pic, p_buffer)) {
+            return_error = EB_DecNoOutputPicture;
+            dec_pic_mgr_release_pic(out_pic->pic_buf);
+            p_buffer->wrapper_ptr = NULL;
+        } else
+            p_buffer->wrapper_ptr = out_pic->pic_buf;
+    } else {
+        /* Copy from recon pointer and return! */
+        if (0 == svt_dec_out_buf(dec_handle_ptr, out_pic, p_buffer))
+            return_error = EB_DecNoOutputPicture;
+        dec_pic_mgr_release_pic(out_pic->pic_buf);
+    }
+    out_pic->pic_buf                   = NULL;
+    dec_handle_ptr->output_queue_start = (dec_handle_ptr->output_queue_start + 1) %
+        DEC_MAX_OUTPUT_QUEUE;
+    dec_handle_ptr->output_queue_count--;
     return return_error;
 }
 
+EB_API EbErrorType svt_av1_dec_release_picture(EbComponentType    *svt_dec_component,
+                                               EbBufferHeaderType *p_buffer) {
+    if (svt_dec_component == NULL || p_buffer == NULL)
+        return EB_ErrorBadParameter;
+
+    EbDecHandle *dec_handle_ptr = (EbDecHandle *)svt_dec_component->p_component_private;
+
+    if (dec_handle_ptr->dec_config.allocate_frame_buffer == NULL)
+        return EB_ErrorNone;
+
+    dec_pic_mgr_release_pic((EbDecPicBuf *)p_buffer->wrapper_ptr);
+    p_buffer->wrapper_ptr = NULL;
+    return EB_ErrorNone;
+}
+
 EB_API EbErrorType svt_av1_dec_deinit(EbComponentType *svt_dec_component) {
     if (svt_dec_component == NULL)
         return EB_ErrorBadParameter;
@@ -633,33 +914,19 @@ EB_API EbErrorType svt_av1_dec_deinit(EbComponentType *svt_dec_component) {
 
     if (!dec_handle_ptr)
         return EB_ErrorNone;
-    if (dec_handle_ptr->dec_config.threads > 1)
+    dec_close_frame_slots(dec_handle_ptr);
+    if (dec_handle_ptr->dec_config.threads > 1 && dec_handle_ptr->start_thread_process)
         dec_sync_all_threads(dec_handle_ptr);
-    if (!svt_dec_memory_map)
+    dec_pic_mgr_release_ext_bufs(dec_handle_ptr);
+    EbDecMemMap *mem_map = dec_handle_ptr->mem_map;
+    if (!mem_map)
         return EB_ErrorNone;
 
-    // Loop through the ptr table and free all malloc'd pointers per channel
-    EbMemoryMapEntry *memory_entry = svt_dec_memory_map;
-    do {
-        switch (memory_entry->ptr_type) {
-        case EB_N_PTR: free(memory_entry->ptr); break;
-        case EB_A_PTR:
-#ifdef _WIN32
-            _aligned_free(memory_entry->ptr);
-#else
-            free(memory_entry->ptr);
-#endif
-            break;
-        case EB_SEMAPHORE: svt_destroy_semaphore(memory_entry->ptr); break;
-        case EB_THREAD: svt_destroy_thread(memory_entry->ptr); break;
-        case EB_MUTEX: svt_destroy_mutex(memory_entry->ptr); break;
-        default: return_error = EB_ErrorMax; break;
-        }
-        EbMemoryMapEntry *tmp_memory_entry = memory_entry;
-        memory_entry                       = tmp_memory_entry->prev_entry;
-        free(tmp_memory_entry);
-    } while (memory_entry != dec_handle_ptr->memory_map_init_address && memory_entry);
-    free(dec_handle_ptr->memory_map_init_address);
+    // Free all the resources of the instance
+    dec_mem_map_free(mem_map);
+    free(mem_map->memory_map_init_address);
+    free(mem_map);
+    dec_handle_ptr->mem_map = NULL;
     return return_error;
 }
 
@@ -30,9 +30,26 @@ extern "C" {
 #define DEC_PAD_VALUE (DYNIMIC_PAD_VALUE + 8)
 
 /* Maximum number of frames in parallel */
-#define DEC_MAX_NUM_FRM_PRLL 1
-/** Maximum picture buffers needed **/
-#define MAX_PIC_BUFS (REF_FRAMES + 1 + DEC_MAX_NUM_FRM_PRLL)
+#define DEC_MAX_NUM_FRM_PRLL 4
+/** Maximum picture buffers needed : references, the frame being parsed,
+    the frames in flight and the frames waiting in the output queue **/
+#define MAX_PIC_BUFS (REF_FRAMES + 1 + 2 * DEC_MAX_NUM_FRM_PRLL)
+/* Shown frames waiting for output : the output delay, plus the shown
+   frames of a single svt_av1_dec_frame call */
+#define DEC_MAX_OUTPUT_QUEUE (2 * DEC_MAX_NUM_FRM_PRLL)
+/* Progress of a picture which failed to decode */
+#define DEC_PIC_FAILED -1
+
+/** Memory map of a decoder instance : the allocations are linked from the
+    last one (memory_map) to memory_map_init_address, and released at
+    svt_av1_dec_deinit. Each instance has its own map, so several decoders
+    can run in one process **/
+typedef struct EbDecMemMap {
+    EbMemoryMapEntry *memory_map_init_address;
+    EbMemoryMapEntry *memory_map;
+    uint32_t          memory_map_index;
+    uint64_t          total_lib_memory;
+} EbDecMemMap;
 
 /** Picture Structure **/
 typedef struct EbDecPicBuf {
@@ -80,8 +97,27 @@ typedef struct EbDecPicBuf {
     int8_t ref_deltas[REF_FRAMES];
     // 0 = ZERO_MV, MV
     int8_t mode_deltas[MAX_MODE_LF_DELTAS];
+
+    /* Frame parallel progress of the frame, DEC_PIC_FAILED in both when
+       the frame could not be decoded. parse_done is set once all the tiles
+       are parsed, i.e. mvs, segment_maps and final_frm_ctx are final */
+    CondVar parse_done;
+    /* Number of luma rows final for reference (LR done and padded),
+       updated at SB row level. INT32_MAX once the frame is decoded */
+    CondVar rows_done;
+
+    /* Planes from the external frame buffer allocator : the reconstruction,
+       and the output copy when film grain or a bit depth conversion applies */
+    EbExtFrameBuf ext_frame_buf;
+    EbExtFrameBuf ext_out_buf;
 } EbDecPicBuf;
 
+/* Shown frame waiting for svt_av1_dec_get_picture */
+typedef struct DecOutputPic {
+    EbDecPicBuf *pic_buf;
+    AomFilmGrain film_grain_params;
+} DecOutputPic;
+
 /* Frame level buffers */
 typedef struct CurFrameBuf {
     SBInfo *sb_info;
@@ -229,11 +265,8 @@ typedef struct EbDecHandle {
        for all the frames in parallel */
     MainFrameBuf main_frame_buf;
 
-    // Memory Map
-    EbMemoryMapEntry *memory_map_init_address;
-    EbMemoryMapEntry *memory_map;
-    uint32_t          memory_map_index;
-    uint64_t          total_lib_memory;
+    /* Memory map of the decoder instance, shared by the frame slots */
+    EbDecMemMap *mem_map;
     struct Av1Common  cm;
 
     // Loop filter frame level flag
@@ -245,6 +278,38 @@ typedef struct EbDecHandle {
     EbHandle              thread_semaphore;
     struct DecThreadCtxt *thread_ctxt_pa;
 
+    /* Frame parallel decode : the main handle parses the headers and hands
+       every frame over to one of the num_frms_prll frame slots. Each slot is
+       a decoder handle with its own contexts, MT resources and frame thread */
+    struct EbDecHandle *frame_slots[DEC_MAX_NUM_FRM_PRLL];
+    int32_t             next_frame_slot;
+
+    /* Shown frames in display order, output after num_frms_prll frames */
+    DecOutputPic output_queue[DEC_MAX_OUTPUT_QUEUE];
+    int32_t      output_queue_start;
+    int32_t      output_queue_count;
+    Bool         eos_received;
+
+    /* Frame slot : main handle owning the pictures and the references */
+    struct EbDecHandle *main_dec_handle;
+    EbHandle            frame_thread_handle;
+    EbHandle            frame_start_semaphore;
+    EbHandle            frame_done_semaphore;
+    Bool                frame_slot_busy;
+    Bool                frame_slot_exit;
+    /* Frame slot : status of the last frame decoded by the slot.
+       Main handle : error of a frame slot not returned yet */
+    EbErrorType frame_error;
+    /* Copy of the tile data of the frame in flight */
+    uint8_t *tile_data_buf;
+    size_t   tile_data_buf_size;
+    /* Planes of the frame before the superres upscaling, kept for the next frames */
+    EbByte superres_buf;
+    size_t superres_buf_size;
+
+    /* Film grain of the output picture, see dec_film_grain_stripes */
+    FilmGrainFrame film_grain;
+
     Bool
         is_16bit_pipeline; // internal bit-depth: when equals 1 internal bit-depth is 16bits regardless of the input bit-depth
 } EbDecHandle;
@@ -527,6 +527,16 @@ void svt_make_inter_predictor(PartitionInfo *part_info, int32_t ref, void *src,
         subpel_params.subpel_y = (mv_q4.row & SUBPEL_MASK) << SCALE_EXTRA_BITS;
     }
 
+    /* Frame parallel : wait till the reference rows read by this block are
+       final. Warp and scaled prediction can reach any row of the frame.
+       A failed reference fails the frame, see dec_frame_slot_kernel */
+    if (!is_intrabc && svt_get_cond_var(&ref_buf->rows_done) != INT32_MAX) {
+        const int32_t rows_needed = (do_warp || is_scaled)
+            ? INT32_MAX
+            : MAX((block.y1 + AOM_INTERP_EXTEND) << ss_y, 1);
+        dec_pic_wait_rows(ref_buf, rows_needed);
+    }
+
     if ((!do_warp && !is_intrabc) || (is_scaled && !do_warp && !is_intrabc)) {
         extend_mc_border(src,
                          &src_stride,
@@ -35,8 +35,54 @@
 #include "EbDecLF.h"
 
 #include "EbUtility.h"
+#include "EbLog.h"
+
+void dec_retire_frame_slots(EbDecHandle *dec_handle_ptr);
+
+EbErrorType dec_mem_map_add(EbDecMemMap *mem_map, EbPtr ptr, EbPtrType ptr_type,
+                            size_t size) {
+    EbMemoryMapEntry *node = (EbMemoryMapEntry *)malloc(sizeof(EbMemoryMapEntry));
+    if (node == NULL)
+        return EB_ErrorInsufficientResources;
+    node->ptr_type = ptr_type;
+    node->ptr = ptr;
+    node->prev_entry = mem_map->memory_map;
+    mem_map->memory_map = node;
+    mem_map->memory_map_index++;
+    mem_map->total_lib_memory += ALIGN_POWER_OF_TWO(size, 3) + sizeof(*node);
+    return EB_ErrorNone;
+}
+
+static void dec_mem_map_release_entry(EbMemoryMapEntry *memory_entry) {
+    switch (memory_entry->ptr_type) {
+    case EB_N_PTR: free(memory_entry->ptr); break;
+    case EB_A_PTR:
+#ifdef _WIN32
+        _aligned_free(memory_entry->ptr);
+#else
+        free(memory_entry->ptr);
+#endif
+        break;
+    case EB_SEMAPHORE: svt_destroy_semaphore(memory_entry->ptr); break;
+    case EB_THREAD: svt_destroy_thread(memory_entry->ptr); break;
+    case EB_MUTEX: svt_destroy_mutex(memory_entry->ptr); break;
+    default: break;
+    }
+}
+
+void dec_mem_map_free(EbDecMemMap *mem_map) {
+    EbMemoryMapEntry *memory_entry = mem_map->memory_map;
+    while (memory_entry != mem_map->memory_map_init_address) {
+        EbMemoryMapEntry *prev_entry = (EbMemoryMapEntry *)memory_entry->prev_entry;
+        dec_mem_map_release_entry(memory_entry);
+        free(memory_entry);
+        mem_map->memory_map_index--;
+        memory_entry = prev_entry;
+    }
+    mem_map->memory_map = mem_map->memory_map_init_address;
+}
 
-/*TODO: Remove and harmonize with encoder. Globals prevent harmonization now! */
+/*TODO: Remove and harmonize with encoder. */
 /*****************************************
  * svt_recon_picture_buffer_desc_ctor
  *  Initializes the Buffer Descriptor's
@@ -44,16 +90,19 @@
  *  the descriptor.
  *****************************************/
 EbErrorType dec_eb_recon_picture_buffer_desc_ctor(
+    EbDecMemMap *mem_map,
     EbPtr  *object_dbl_ptr,
     EbPtr   object_init_data_ptr,
-    Bool is_16bit_pipeline /* can be removed as an extra argument once
+    Bool is_16bit_pipeline, /* can be removed as an extra argument once
                                 EbPictureBufferDescInitData adds the support for this */
+    EbSvtAv1DecConfiguration *dec_config,
+    EbExtFrameBuf *ext_frame_buf /* planes from the application allocator if not NULL */
 )
 {
     EbPictureBufferDesc          *picture_buffer_desc_ptr;
     EbPictureBufferDescInitData  *picture_buffer_desc_init_data_ptr = (EbPictureBufferDescInitData*)object_init_data_ptr;
 
-    EB_MALLOC_DEC(EbPictureBufferDesc*, picture_buffer_desc_ptr, sizeof(EbPictureBufferDesc), EB_N_PTR);
+    EB_MALLOC_DEC(mem_map, EbPictureBufferDesc*, picture_buffer_desc_ptr, sizeof(EbPictureBufferDesc), EB_N_PTR);
 
     uint32_t bytes_per_pixel = (picture_buffer_desc_init_data_ptr->bit_depth > EB_8BIT ||
         is_16bit_pipeline) ? 2 : 1;
@@ -102,25 +151,40 @@ EbErrorType dec_eb_recon_picture_buffer_desc_ctor(
     picture_buffer_desc_ptr->stride_bit_inc_cb = 0;
     picture_buffer_desc_ptr->stride_bit_inc_cr = 0;
 
-    // Allocate the Picture Buffers (luma & chroma)
-    if (picture_buffer_desc_init_data_ptr->buffer_enable_mask & PICTURE_BUFFER_DESC_Y_FLAG) {
-        EB_ALLIGN_MALLOC_DEC(EbByte, picture_buffer_desc_ptr->buffer_y, picture_buffer_desc_ptr->luma_size * bytes_per_pixel, EB_A_PTR);
-        memset(picture_buffer_desc_ptr->buffer_y, 0, picture_buffer_desc_ptr->luma_size      * bytes_per_pixel);
-    }
-    else
-        picture_buffer_desc_ptr->buffer_y = 0;
-    if (picture_buffer_desc_init_data_ptr->buffer_enable_mask & PICTURE_BUFFER_DESC_Cb_FLAG) {
-        EB_ALLIGN_MALLOC_DEC(EbByte, picture_buffer_desc_ptr->buffer_cb, picture_buffer_desc_ptr->chroma_size * bytes_per_pixel, EB_A_PTR);
-        memset(picture_buffer_desc_ptr->buffer_cb, 0, picture_buffer_desc_ptr->chroma_size      * bytes_per_pixel);
+    /* All the planes in one buffer, each plane aligned */
+    size_t luma_bytes = ALIGN_POWER_OF_TWO(
+        (size_t)picture_buffer_desc_ptr->luma_size * bytes_per_pixel, 6);
+    size_t chroma_bytes = ALIGN_POWER_OF_TWO(
+        (size_t)picture_buffer_desc_ptr->chroma_size * bytes_per_pixel, 6);
+    EbByte plane;
+
+    if (ext_frame_buf != NULL) {
+        uint32_t min_size = (uint32_t)(luma_bytes + 2 * chroma_bytes + ALVALUE);
+
+        if (dec_config->allocate_frame_buffer(ext_frame_buf, min_size,
+            dec_config->frame_buffer_private_data) != 0 ||
+            ext_frame_buf->buffer == NULL || ext_frame_buf->buffer_size < min_size) {
+            ext_frame_buf->buffer = NULL;
+            return EB_ErrorInsufficientResources;
+        }
+        memset(ext_frame_buf->buffer, 0, min_size);
+        plane = (EbByte)ALIGN_POWER_OF_TWO((uintptr_t)ext_frame_buf->buffer, 6);
     }
-    else
-        picture_buffer_desc_ptr->buffer_cb = 0;
-    if (picture_buffer_desc_init_data_ptr->buffer_enable_mask & PICTURE_BUFFER_DESC_Cr_FLAG) {
-        EB_ALLIGN_MALLOC_DEC(EbByte, picture_buffer_desc_ptr->buffer_cr, picture_buffer_desc_ptr->chroma_size * bytes_per_pixel, EB_A_PTR);
-        memset(picture_buffer_desc_ptr->buffer_cr, 0, picture_buffer_desc_ptr->chroma_size      * bytes_per_pixel);
+    else {
+        /* One allocation of the memory map per picture */
+        size_t buf_size = luma_bytes + 2 * chroma_bytes;
+        EB_ALLIGN_MALLOC_DEC(mem_map, EbByte, plane, buf_size, EB_A_PTR);
+        memset(plane, 0, buf_size);
     }
-    else
-        picture_buffer_desc_ptr->buffer_cr = 0;
+
+    picture_buffer_desc_ptr->buffer_y = (picture_buffer_desc_init_data_ptr->buffer_enable_mask &
+        PICTURE_BUFFER_DESC_Y_FLAG) ? plane : 0;
+    plane += luma_bytes;
+    picture_buffer_desc_ptr->buffer_cb = (picture_buffer_desc_init_data_ptr->buffer_enable_mask &
+        PICTURE_BUFFER_DESC_Cb_FLAG) ? plane : 0;
+    plane += chroma_bytes;
+    picture_buffer_desc_ptr->buffer_cr = (picture_buffer_desc_init_data_ptr->buffer_enable_mask &
+        PICTURE_BUFFER_DESC_Cr_FLAG) ? plane : 0;
     return EB_ErrorNone;
 }
 
@@ -168,16 +232,16 @@ static EbErrorType init_main_frame_ctxt(EbDecHandle  *dec_handle_ptr) {
         cur_frame_buf = &main_frame_buf->cur_frame_bufs[i];
 
         /* SuperBlock str allocation at SB level */
-        EB_MALLOC_DEC(SBInfo*, cur_frame_buf->sb_info,
+        EB_MALLOC_DEC(dec_handle_ptr->mem_map, SBInfo*, cur_frame_buf->sb_info,
             (num_sb * sizeof(SBInfo)), EB_N_PTR);
 
         /* ModeInfo str allocation at 4x4 level */
-        EB_MALLOC_DEC(BlockModeInfo*, cur_frame_buf->mode_info,
+        EB_MALLOC_DEC(dec_handle_ptr->mem_map, BlockModeInfo*, cur_frame_buf->mode_info,
                     (num_sb * num_mis_in_sb * sizeof(BlockModeInfo)), EB_N_PTR);
 
         /* TransformInfo str allocation at 4x4 level
            TO-DO optimize memory based on the chroma subsampling.*/
-        EB_MALLOC_DEC(TransformInfo_t*, cur_frame_buf->trans_info[AOM_PLANE_Y],
+        EB_MALLOC_DEC(dec_handle_ptr->mem_map, TransformInfo_t*, cur_frame_buf->trans_info[AOM_PLANE_Y],
             (num_sb * num_mis_in_sb * sizeof(TransformInfo_t)), EB_N_PTR);
 
         /* Coeff buf (1D compact) allocation for entire frame
@@ -187,16 +251,16 @@ static EbErrorType init_main_frame_ctxt(EbDecHandle  *dec_handle_ptr) {
             /* (16+1) : 1 for Length and 16 for all coeffs in 4x4 */
         if (is_st) {
             /*Size of coeff buf reduced to sb_sizesss*/
-            EB_MALLOC_DEC(int32_t*, cur_frame_buf->coeff[AOM_PLANE_Y],
+            EB_MALLOC_DEC(dec_handle_ptr->mem_map, int32_t*, cur_frame_buf->coeff[AOM_PLANE_Y],
                 (num_mis_in_sb * sizeof(int32_t) * (16 + 1)), EB_N_PTR);
         }
         else {
-            EB_MALLOC_DEC(int32_t*, cur_frame_buf->coeff[AOM_PLANE_Y],
+            EB_MALLOC_DEC(dec_handle_ptr->mem_map, int32_t*, cur_frame_buf->coeff[AOM_PLANE_Y],
                 (num_sb * num_mis_in_sb * sizeof(int32_t) * (16 + 1)), EB_N_PTR);
         }
 
         /*TODO : Change to macro */
-        EB_MALLOC_DEC(TransformInfo_t*, cur_frame_buf->trans_info[AOM_PLANE_U],
+        EB_MALLOC_DEC(dec_handle_ptr->mem_map, TransformInfo_t*, cur_frame_buf->trans_info[AOM_PLANE_U],
             (num_sb * num_mis_in_sb * sizeof(TransformInfo_t) * 2), EB_N_PTR);
 
         /* Coeff buf (1D compact) allocation for entire frame
@@ -208,17 +272,17 @@ static EbErrorType init_main_frame_ctxt(EbDecHandle  *dec_handle_ptr) {
             seq_header->color_config.subsampling_y == 1) // 420
         {
             if (is_st) {
-                EB_MALLOC_DEC(int32_t*, cur_frame_buf->coeff[AOM_PLANE_U],
+                EB_MALLOC_DEC(dec_handle_ptr->mem_map, int32_t*, cur_frame_buf->coeff[AOM_PLANE_U],
                     (num_mis_in_sb * sizeof(int32_t) * (16 + 1) >> 2), EB_N_PTR);
-                EB_MALLOC_DEC(int32_t*, cur_frame_buf->coeff[AOM_PLANE_V],
+                EB_MALLOC_DEC(dec_handle_ptr->mem_map, int32_t*, cur_frame_buf->coeff[AOM_PLANE_V],
                     (num_mis_in_sb * sizeof(int32_t) * (16 + 1) >> 2), EB_N_PTR);
             }
             else {
-                EB_MALLOC_DEC(int32_t*,
+                EB_MALLOC_DEC(dec_handle_ptr->mem_map, int32_t*,
                     cur_frame_buf->coeff[AOM_PLANE_U],
                     (num_sb * num_mis_in_sb * sizeof(int32_t) * (16 + 1) >> 2),
                     EB_N_PTR);
-                EB_MALLOC_DEC(int32_t*,
+                EB_MALLOC_DEC(dec_handle_ptr->mem_map, int32_t*,
                     cur_frame_buf->coeff[AOM_PLANE_V],
                     (num_sb * num_mis_in_sb * sizeof(int32_t) * (16 + 1) >> 2),
                     EB_N_PTR);
@@ -228,17 +292,17 @@ static EbErrorType init_main_frame_ctxt(EbDecHandle  *dec_handle_ptr) {
                  seq_header->color_config.subsampling_y == 0) // 422
         {
             if (is_st) {
-                EB_MALLOC_DEC(int32_t*, cur_frame_buf->coeff[AOM_PLANE_U],
+                EB_MALLOC_DEC(dec_handle_ptr->mem_map, int32_t*, cur_frame_buf->coeff[AOM_PLANE_U],
                     (num_mis_in_sb * sizeof(int32_t) * (16 + 1) >> 1), EB_N_PTR);
-                EB_MALLOC_DEC(int32_t*, cur_frame_buf->coeff[AOM_PLANE_V],
+                EB_MALLOC_DEC(dec_handle_ptr->mem_map, int32_t*, cur_frame_buf->coeff[AOM_PLANE_V],
                     (num_mis_in_sb * sizeof(int32_t) * (16 + 1) >> 1), EB_N_PTR);
             }
             else {
-                EB_MALLOC_DEC(int32_t*,
+                EB_MALLOC_DEC(dec_handle_ptr->mem_map, int32_t*,
                     cur_frame_buf->coeff[AOM_PLANE_U],
                     (num_sb * num_mis_in_sb * sizeof(int32_t) * (16 + 1) >> 1),
                     EB_N_PTR);
-                EB_MALLOC_DEC(int32_t*,
+                EB_MALLOC_DEC(dec_handle_ptr->mem_map, int32_t*,
                     cur_frame_buf->coeff[AOM_PLANE_V],
                     (num_sb * num_mis_in_sb * sizeof(int32_t) * (16 + 1) >> 1),
                     EB_N_PTR);
@@ -248,17 +312,17 @@ static EbErrorType init_main_frame_ctxt(EbDecHandle  *dec_handle_ptr) {
                  seq_header->color_config.subsampling_y == 0) // 444
         {
             if (is_st) {
-                EB_MALLOC_DEC(int32_t*, cur_frame_buf->coeff[AOM_PLANE_U],
+                EB_MALLOC_DEC(dec_handle_ptr->mem_map, int32_t*, cur_frame_buf->coeff[AOM_PLANE_U],
                     (num_mis_in_sb * sizeof(int32_t) * (16 + 1)), EB_N_PTR);
-                EB_MALLOC_DEC(int32_t*, cur_frame_buf->coeff[AOM_PLANE_V],
+                EB_MALLOC_DEC(dec_handle_ptr->mem_map, int32_t*, cur_frame_buf->coeff[AOM_PLANE_V],
                     (num_mis_in_sb * sizeof(int32_t) * (16 + 1)), EB_N_PTR);
             }
             else {
-                EB_MALLOC_DEC(int32_t*,
+                EB_MALLOC_DEC(dec_handle_ptr->mem_map, int32_t*,
                     cur_frame_buf->coeff[AOM_PLANE_U],
                     (num_sb * num_mis_in_sb * sizeof(int32_t) * (16 + 1)),
                     EB_N_PTR);
-                EB_MALLOC_DEC(int32_t*,
+                EB_MALLOC_DEC(dec_handle_ptr->mem_map, int32_t*,
                     cur_frame_buf->coeff[AOM_PLANE_V],
                     (num_sb * num_mis_in_sb * sizeof(int32_t) * (16 + 1)),
                     EB_N_PTR);
@@ -268,11 +332,11 @@ static EbErrorType init_main_frame_ctxt(EbDecHandle  *dec_handle_ptr) {
             assert(0);
 
         /* delta_q allocation at SB level */
-        EB_MALLOC_DEC(int32_t*, cur_frame_buf->delta_q,
+        EB_MALLOC_DEC(dec_handle_ptr->mem_map, int32_t*, cur_frame_buf->delta_q,
             (num_sb * sizeof(int32_t)), EB_N_PTR);
 
         /* cdef_strength allocation at SB level */
-        EB_MALLOC_DEC(int8_t*, cur_frame_buf->cdef_strength,
+        EB_MALLOC_DEC(dec_handle_ptr->mem_map, int8_t*, cur_frame_buf->cdef_strength,
             (num_sb * (seq_header->use_128x128_superblock ? 4 : 1) *
             sizeof(int8_t)), EB_N_PTR);
         memset(cur_frame_buf->cdef_strength, -1, (num_sb *
@@ -280,11 +344,11 @@ static EbErrorType init_main_frame_ctxt(EbDecHandle  *dec_handle_ptr) {
             sizeof(int8_t)));
 
         /* delta_lf allocation at SB level */
-        EB_MALLOC_DEC(int32_t*, cur_frame_buf->delta_lf,
+        EB_MALLOC_DEC(dec_handle_ptr->mem_map, int32_t*, cur_frame_buf->delta_lf,
             (num_sb * FRAME_LF_COUNT * sizeof(int32_t)), EB_N_PTR);
 
         /* tile map allocation at SB level */
-        EB_MALLOC_DEC(uint8_t*, cur_frame_buf->tile_map_sb,
+        EB_MALLOC_DEC(dec_handle_ptr->mem_map, uint8_t*, cur_frame_buf->tile_map_sb,
             (num_sb * sizeof(uint8_t)), EB_N_PTR);
 
         // Allocating lr_unit based on SB_SIZE as worst case memory.
@@ -295,7 +359,7 @@ static EbErrorType init_main_frame_ctxt(EbDecHandle  *dec_handle_ptr) {
         // every SB level loop restoration filter value.
         LrCtxt *lr_ctxt = (LrCtxt *)dec_handle_ptr->pv_lr_ctxt;
         for (int32_t plane = 0; plane <= AOM_PLANE_V; plane++) {
-            EB_MALLOC_DEC(RestorationUnitInfo *, cur_frame_buf->lr_unit[plane],
+            EB_MALLOC_DEC(dec_handle_ptr->mem_map, RestorationUnitInfo *, cur_frame_buf->lr_unit[plane],
                 (num_sb * sizeof(RestorationUnitInfo)), EB_N_PTR);
             lr_ctxt->lr_unit[plane] = cur_frame_buf->lr_unit[plane];
             lr_ctxt->lr_stride[plane] = sb_cols;
@@ -307,10 +371,10 @@ static EbErrorType init_main_frame_ctxt(EbDecHandle  *dec_handle_ptr) {
     frame_mi_map->mi_cols_algnsb = sb_cols * (1 << (sb_size_log2 - MI_SIZE_LOG2));
     frame_mi_map->mi_rows_algnsb = sb_cols * (1 << (sb_size_log2 - MI_SIZE_LOG2));
     /* SBInfo pointers for entire frame */
-    EB_MALLOC_DEC(SBInfo**, frame_mi_map->pps_sb_info,
+    EB_MALLOC_DEC(dec_handle_ptr->mem_map, SBInfo**, frame_mi_map->pps_sb_info,
         sb_rows * sb_cols * sizeof(SBInfo *), EB_N_PTR);
     /* ModeInfo offset wrt it's SB start for entire frame at 4x4 lvl */
-    EB_MALLOC_DEC(uint16_t*, frame_mi_map->p_mi_offset, frame_mi_map->
+    EB_MALLOC_DEC(dec_handle_ptr->mem_map, uint16_t*, frame_mi_map->p_mi_offset, frame_mi_map->
     mi_rows_algnsb * frame_mi_map->mi_cols_algnsb * sizeof(uint16_t), EB_N_PTR);
     frame_mi_map->sb_size_log2 = sb_size_log2;
     frame_mi_map->num_mis_in_sb_wd = (1 << (sb_size_log2 - MI_SIZE_LOG2));
@@ -326,7 +390,7 @@ static EbErrorType init_main_frame_ctxt(EbDecHandle  *dec_handle_ptr) {
 static EbErrorType init_parse_context (EbDecHandle  *dec_handle_ptr) {
     EbErrorType return_error = EB_ErrorNone;
 
-    EB_MALLOC_DEC(void *, dec_handle_ptr->pv_main_parse_ctxt,
+    EB_MALLOC_DEC(dec_handle_ptr->mem_map, void *, dec_handle_ptr->pv_main_parse_ctxt,
         sizeof(MainParseCtxt), EB_N_PTR);
     MainParseCtxt *main_parse_ctx =
         (MainParseCtxt*)dec_handle_ptr->pv_main_parse_ctxt;
@@ -340,6 +404,9 @@ static EbErrorType init_parse_context (EbDecHandle  *dec_handle_ptr) {
     main_parse_ctx->num_tiles = 0;
     main_parse_ctx->parse_tile_data = NULL;
 
+    main_parse_ctx->context_alloc_count = 0;
+    main_parse_ctx->tile_data_alloc_count = 0;
+
     return return_error;
 }
 
@@ -351,7 +418,7 @@ EbErrorType init_dec_mod_ctxt(EbDecHandle  *dec_handle_ptr,
     SeqHeader *seq_header = &dec_handle_ptr->seq_header;
     EbColorConfig *color_config = &seq_header->color_config;
 
-    EB_MALLOC_DEC(void *, *pp_dec_mod_ctxt, sizeof(DecModCtxt), EB_N_PTR);
+    EB_MALLOC_DEC(dec_handle_ptr->mem_map, void *, *pp_dec_mod_ctxt, sizeof(DecModCtxt), EB_N_PTR);
 
     DecModCtxt *p_dec_mod_ctxt = (DecModCtxt*)*pp_dec_mod_ctxt;
     p_dec_mod_ctxt->dec_handle_ptr  = (void *)dec_handle_ptr;
@@ -365,7 +432,7 @@ EbErrorType init_dec_mod_ctxt(EbDecHandle  *dec_handle_ptr,
         (color_config->subsampling_x ? y_size >> 2 : y_size) +
         (color_config->subsampling_y ? y_size >> 2 : y_size);
 
-    EB_MALLOC_DEC(int32_t*, p_dec_mod_ctxt->sb_iquant_ptr,
+    EB_MALLOC_DEC(dec_handle_ptr->mem_map, int32_t*, p_dec_mod_ctxt->sb_iquant_ptr,
         iq_size * sizeof(int32_t), EB_N_PTR);
     av1_inverse_qm_init(p_dec_mod_ctxt, seq_header);
 
@@ -376,17 +443,17 @@ EbErrorType init_dec_mod_ctxt(EbDecHandle  *dec_handle_ptr,
     uint16_t *hbd_mc_buf[2];
     for (int ref = 0; ref < 2; ref++) {
 
-        //EB_MALLOC_DEC(uint8_t**, part_info->mc_buf[ref],
+        //EB_MALLOC_DEC(dec_handle_ptr->mem_map, uint8_t**, part_info->mc_buf[ref],
         //    sizeof(uint8_t*), EB_N_PTR);
         if (use_highbd) {
-            EB_MALLOC_DEC(uint16_t*, hbd_mc_buf[ref],
+            EB_MALLOC_DEC(dec_handle_ptr->mem_map, uint16_t*, hbd_mc_buf[ref],
                 ((2 * sb_size) + (AOM_INTERP_EXTEND * 2))*
                 ((2 * sb_size) + (AOM_INTERP_EXTEND * 2))*
                 sizeof(uint16_t), EB_N_PTR);
             p_dec_mod_ctxt->mc_buf[ref] = (uint8_t *)hbd_mc_buf[ref];
         }
         else {
-            EB_MALLOC_DEC(uint8_t*, p_dec_mod_ctxt->mc_buf[ref],
+            EB_MALLOC_DEC(dec_handle_ptr->mem_map, uint8_t*, p_dec_mod_ctxt->mc_buf[ref],
                 ((2 * sb_size) + (AOM_INTERP_EXTEND * 2))*
                 ((2 * sb_size) + (AOM_INTERP_EXTEND * 2))*
                 sizeof(uint8_t), EB_N_PTR);
@@ -411,15 +478,15 @@ static EbErrorType init_lf_ctxt(EbDecHandle  *dec_handle_ptr) {
     int32_t mi_cols = aligned_width >> MI_SIZE_LOG2;
     int32_t mi_rows = aligned_height >> MI_SIZE_LOG2;
 
-    EB_MALLOC_DEC(void *, dec_handle_ptr->pv_lf_ctxt, sizeof(LfCtxt), EB_N_PTR);
+    EB_MALLOC_DEC(dec_handle_ptr->mem_map, void *, dec_handle_ptr->pv_lf_ctxt, sizeof(LfCtxt), EB_N_PTR);
 
     LfCtxt *lf_ctxt = (LfCtxt *)dec_handle_ptr->pv_lf_ctxt;
     /*Mem allocation for luma parmas 4x4 unit*/
-    EB_MALLOC_DEC(TxSize *, lf_ctxt->tx_size_l,
+    EB_MALLOC_DEC(dec_handle_ptr->mem_map, TxSize *, lf_ctxt->tx_size_l,
         mi_rows * mi_cols * sizeof(TxSize), EB_N_PTR);
 
     /*Allocation of chroma params at 4x4 luma unit, can be optimized */
-    EB_MALLOC_DEC(TxSize *, lf_ctxt->tx_size_uv,
+    EB_MALLOC_DEC(dec_handle_ptr->mem_map, TxSize *, lf_ctxt->tx_size_uv,
         mi_rows * mi_cols * sizeof(TxSize), EB_N_PTR);
 
     return return_error;
@@ -428,7 +495,7 @@ static EbErrorType init_lf_ctxt(EbDecHandle  *dec_handle_ptr) {
 static EbErrorType init_lr_ctxt(EbDecHandle  *dec_handle_ptr)
 {
     EbErrorType return_error = EB_ErrorNone;
-    EB_MALLOC_DEC(void *, dec_handle_ptr->pv_lr_ctxt, sizeof(LrCtxt), EB_N_PTR);
+    EB_MALLOC_DEC(dec_handle_ptr->mem_map, void *, dec_handle_ptr->pv_lr_ctxt, sizeof(LrCtxt), EB_N_PTR);
 
     LrCtxt *lr_ctxt = (LrCtxt*)dec_handle_ptr->pv_lr_ctxt;
     lr_ctxt->dec_handle_ptr = (void *)dec_handle_ptr;
@@ -448,22 +515,22 @@ static EbErrorType init_lr_ctxt(EbDecHandle  *dec_handle_ptr)
     lr_ctxt->is_thread_min = FALSE;
     if (num_instances == dec_handle_ptr->dec_config.threads)
         lr_ctxt->is_thread_min = TRUE;
-    EB_MALLOC_DEC(RestorationLineBuffers ***, lr_ctxt->rlbs,
+    EB_MALLOC_DEC(dec_handle_ptr->mem_map, RestorationLineBuffers ***, lr_ctxt->rlbs,
         num_instances * sizeof(RestorationLineBuffers**), EB_N_PTR);
-    EB_MALLOC_DEC(int32_t **, lr_ctxt->rst_tmpbuf,
+    EB_MALLOC_DEC(dec_handle_ptr->mem_map, int32_t **, lr_ctxt->rst_tmpbuf,
          num_instances * RESTORATION_TMPBUF_SIZE, EB_N_PTR);
     for (uint32_t i = 0; i < num_instances; i++) {
         RestorationLineBuffers **p_rlbs;
-        EB_MALLOC_DEC(RestorationLineBuffers**, lr_ctxt->rlbs[i],
+        EB_MALLOC_DEC(dec_handle_ptr->mem_map, RestorationLineBuffers**, lr_ctxt->rlbs[i],
             num_planes * sizeof(RestorationLineBuffers**), EB_N_PTR);
         p_rlbs = lr_ctxt->rlbs[i];
         for (int32_t pli = 0; pli < num_planes; pli++) {
-            EB_MALLOC_DEC(RestorationLineBuffers *, p_rlbs[pli],
+            EB_MALLOC_DEC(dec_handle_ptr->mem_map, RestorationLineBuffers *, p_rlbs[pli],
                 sizeof(RestorationLineBuffers), EB_N_PTR);
         }
     }
     for (uint32_t i = 0; i < num_instances; i++) {
-        EB_MALLOC_DEC(int32_t *, lr_ctxt->rst_tmpbuf[i],
+        EB_MALLOC_DEC(dec_handle_ptr->mem_map, int32_t *, lr_ctxt->rst_tmpbuf[i],
             RESTORATION_TMPBUF_SIZE, EB_N_PTR);
     }
 
@@ -486,24 +553,75 @@ static EbErrorType init_lr_ctxt(EbDecHandle  *dec_handle_ptr)
         const int buf_size = num_stripes * stride * RESTORATION_CTX_VERT << use_highbd;
         RestorationStripeBoundaries *boundaries = &lr_ctxt->boundaries[plane];
 
-        EB_MALLOC_DEC(uint8_t *, boundaries->stripe_boundary_above,
+        EB_MALLOC_DEC(dec_handle_ptr->mem_map, uint8_t *, boundaries->stripe_boundary_above,
                       buf_size * sizeof(uint8_t), EB_N_PTR);
-        EB_MALLOC_DEC(uint8_t *, boundaries->stripe_boundary_below,
+        EB_MALLOC_DEC(dec_handle_ptr->mem_map, uint8_t *, boundaries->stripe_boundary_below,
                       buf_size * sizeof(uint8_t), EB_N_PTR);
         boundaries->stripe_boundary_size = buf_size;
         boundaries->stripe_boundary_stride = stride;
     }
-    EB_MALLOC_DEC(uint8_t *, lr_ctxt->dst, (MAX_SB_SIZE + 8) *
+    EB_MALLOC_DEC(dec_handle_ptr->mem_map, uint8_t *, lr_ctxt->dst, (MAX_SB_SIZE + 8) *
         RESTORATION_PROC_UNIT_SIZE * sizeof(uint8_t) << use_highbd, EB_N_PTR);
     return return_error;
 }
 
+/* Frame slots for frame parallel decode. Each slot decodes one frame
+   with its share of the threads, using its own module contexts */
+static EbErrorType init_frame_slots(EbDecHandle  *dec_handle_ptr) {
+    EbErrorType return_error = EB_ErrorNone;
+
+    for (int32_t i = 0; i < dec_handle_ptr->num_frms_prll; i++) {
+        EbDecHandle *frame_slot = dec_handle_ptr->frame_slots[i];
+        if (NULL == frame_slot) {
+            EB_MALLOC_DEC(dec_handle_ptr->mem_map, EbDecHandle *, frame_slot, sizeof(EbDecHandle), EB_N_PTR);
+            memset(frame_slot, 0, sizeof(EbDecHandle));
+            frame_slot->main_dec_handle = dec_handle_ptr;
+            frame_slot->mem_map = dec_handle_ptr->mem_map;
+            frame_slot->dec_config = dec_handle_ptr->dec_config;
+            frame_slot->dec_config.threads = dec_handle_ptr->dec_config.threads /
+                dec_handle_ptr->num_frms_prll;
+            frame_slot->num_frms_prll = 1;
+            frame_slot->is_16bit_pipeline = dec_handle_ptr->is_16bit_pipeline;
+            frame_slot->start_thread_process = FALSE;
+            dec_handle_ptr->frame_slots[i] = frame_slot;
+        }
+        frame_slot->seq_header = dec_handle_ptr->seq_header;
+        frame_slot->seq_header_done = 1;
+
+        return_error |= init_parse_context(frame_slot);
+
+        return_error |= init_dec_mod_ctxt(frame_slot,
+                        &frame_slot->pv_dec_mod_ctxt);
+
+        return_error |= init_lf_ctxt(frame_slot);
+
+        return_error |= init_lr_ctxt(frame_slot);
+
+        return_error |= init_main_frame_ctxt(frame_slot);
+
+        frame_slot->mem_init_done = 1;
+    }
+    return return_error;
+}
+
 EbErrorType dec_mem_init(EbDecHandle  *dec_handle_ptr) {
     EbErrorType return_error = EB_ErrorNone;
 
     if (0 == dec_handle_ptr->seq_header_done)
         return EB_ErrorNone;
 
+    /* Frames in flight still use the current contexts */
+    dec_retire_frame_slots(dec_handle_ptr);
+
+    /* Superres upscaling is done at frame level after CDEF,
+       so the rows of a superres frame can not be tracked */
+    if (dec_handle_ptr->num_frms_prll > 1 &&
+        dec_handle_ptr->seq_header.enable_superres) {
+        SVT_WARN("Frame parallel decode is not supported with superres, "
+                 "decoding one frame at a time\n");
+        dec_handle_ptr->num_frms_prll = 1;
+    }
+
     /* init module ctxts */
     return_error |= dec_pic_mgr_init(dec_handle_ptr);
 
@@ -512,12 +630,20 @@ EbErrorType dec_mem_init(EbDecHandle  *dec_handle_ptr) {
     return_error |= init_dec_mod_ctxt(dec_handle_ptr,
                     &dec_handle_ptr->pv_dec_mod_ctxt);
 
-    return_error |= init_lf_ctxt(dec_handle_ptr);
+    if (dec_handle_ptr->num_frms_prll > 1) {
+        /* Frames are reconstructed by the frame slots */
+        dec_handle_ptr->main_frame_buf.tpl_mvs = NULL;
+        dec_handle_ptr->main_frame_buf.tpl_mvs_size = 0;
+        return_error |= init_frame_slots(dec_handle_ptr);
+    }
+    else {
+        return_error |= init_lf_ctxt(dec_handle_ptr);
 
-    return_error |= init_lr_ctxt(dec_handle_ptr);
+        return_error |= init_lr_ctxt(dec_handle_ptr);
 
-    /* init frame buffers */
-    return_error |= init_main_frame_ctxt(dec_handle_ptr);
+        /* init frame buffers */
+        return_error |= init_main_frame_ctxt(dec_handle_ptr);
+    }
 
     /* Initialize the references to NULL */
     for (int i = 0; i < REF_FRAMES; i++) {
@@ -16,85 +16,55 @@
 extern "C" {
 #endif
 
-extern EbMemoryMapEntry *svt_dec_memory_map;
-extern uint32_t         *svt_dec_memory_map_index;
-extern uint64_t         *svt_dec_total_lib_memory;
-extern uint32_t          svt_dec_lib_malloc_count;
+/* Adds an allocated resource to the memory map of the decoder instance,
+   returns EB_ErrorInsufficientResources if the entry can not be allocated */
+EbErrorType dec_mem_map_add(EbDecMemMap *mem_map, EbPtr ptr, EbPtrType ptr_type,
+                            size_t size);
 
-extern EbMemoryMapEntry *memory_map_start_address;
-extern EbMemoryMapEntry *memory_map_end_address;
+/* Frees the resources of all the entries of the memory map */
+void dec_mem_map_free(EbDecMemMap *mem_map);
 
 #ifdef _WIN32
-#define EB_ALLIGN_MALLOC_DEC(type, pointer, n_elements, pointer_class)                \
-    do {                                                                              \
-        pointer = (type)_aligned_malloc(n_elements, ALVALUE);                         \
-        if (pointer == NULL)                                                          \
-            return EB_ErrorInsufficientResources;                                     \
-        EbMemoryMapEntry *node = malloc(sizeof(EbMemoryMapEntry));                    \
-        if (node == NULL) {                                                           \
-            _aligned_free(pointer);                                                   \
-            return EB_ErrorInsufficientResources;                                     \
-        }                                                                             \
-        node->ptr_type     = pointer_class;                                           \
-        node->ptr          = pointer;                                                 \
-        node->prev_entry   = svt_dec_memory_map;                                      \
-        svt_dec_memory_map = node;                                                    \
-        (*svt_dec_memory_map_index)++;                                                \
-        if (n_elements % 8 == 0)                                                      \
-            *svt_dec_total_lib_memory += ((n_elements) + sizeof(*node));              \
-        else                                                                          \
-            *svt_dec_total_lib_memory += (((n_elements) + (8 - ((n_elements) % 8))) + \
-                                          sizeof(*node));                             \
-        svt_dec_lib_malloc_count++;                                                   \
+#define EB_ALLIGN_MALLOC_DEC(mem_map, type, pointer, n_elements, pointer_class) \
+    do {                                                                        \
+        pointer = (type)_aligned_malloc(n_elements, ALVALUE);                   \
+        if (pointer == NULL)                                                    \
+            return EB_ErrorInsufficientResources;                               \
+        if (dec_mem_map_add(mem_map, pointer, pointer_class, n_elements) !=     \
+            EB_ErrorNone) {                                                     \
+            _aligned_free(pointer);                                             \
+            return EB_ErrorInsufficientResources;                               \
+        }                                                                       \
     } while (0)
 #else
-#define EB_ALLIGN_MALLOC_DEC(type, pointer, n_elements, pointer_class)                \
-    do {                                                                              \
-        if (posix_memalign((void **)&(pointer), ALVALUE, n_elements) != 0)            \
-            return EB_ErrorInsufficientResources;                                     \
-        EbMemoryMapEntry *node = malloc(sizeof(*node));                               \
-        if (node == NULL) {                                                           \
-            free(pointer);                                                            \
-            return EB_ErrorInsufficientResources;                                     \
-        }                                                                             \
-        node->ptr_type     = pointer_class;                                           \
-        node->ptr          = pointer;                                                 \
-        node->prev_entry   = svt_dec_memory_map;                                      \
-        svt_dec_memory_map = node;                                                    \
-        (*svt_dec_memory_map_index)++;                                                \
-        if (n_elements % 8 == 0)                                                      \
-            *svt_dec_total_lib_memory += ((n_elements) + sizeof(*node));              \
-        else                                                                          \
-            *svt_dec_total_lib_memory += (((n_elements) + (8 - ((n_elements) % 8))) + \
-                                          sizeof(*node));                             \
-        svt_dec_lib_malloc_count++;                                                   \
+#define EB_ALLIGN_MALLOC_DEC(mem_map, type, pointer, n_elements, pointer_class) \
+    do {                                                                        \
+        if (posix_memalign((void **)&(pointer), ALVALUE, n_elements) != 0)      \
+            return EB_ErrorInsufficientResources;                               \
+        if (dec_mem_map_add(mem_map, pointer, pointer_class, n_elements) !=     \
+            EB_ErrorNone) {                                                     \
+            free(pointer);                                                      \
+            return EB_ErrorInsufficientResources;                               \
+        }                                                                       \
     } while (0)
 #endif
-#define EB_MALLOC_DEC(type, pointer, n_elements, pointer_class)                       \
-    do {                                                                              \
-        pointer = malloc(n_elements);                                                 \
-        if (pointer == NULL)                                                          \
-            return EB_ErrorInsufficientResources;                                     \
-        EbMemoryMapEntry *node = malloc(sizeof(EbMemoryMapEntry));                    \
-        if (node == NULL) {                                                           \
-            free(pointer);                                                            \
-            return EB_ErrorInsufficientResources;                                     \
-        }                                                                             \
-        node->ptr_type     = pointer_class;                                           \
-        node->ptr          = pointer;                                                 \
-        node->prev_entry   = svt_dec_memory_map;                                      \
-        svt_dec_memory_map = node;                                                    \
-        (*svt_dec_memory_map_index)++;                                                \
-        if (n_elements % 8 == 0)                                                      \
-            *svt_dec_total_lib_memory += ((n_elements) + sizeof(*node));              \
-        else                                                                          \
-            *svt_dec_total_lib_memory += (((n_elements) + (8 - ((n_elements) % 8))) + \
-                                          sizeof(*node));                             \
-        svt_dec_lib_malloc_count++;                                                   \
+#define EB_MALLOC_DEC(mem_map, type, pointer, n_elements, pointer_class)    \
+    do {                                                                    \
+        pointer = malloc(n_elements);                                       \
+        if (pointer == NULL)                                                \
+            return EB_ErrorInsufficientResources;                           \
+        if (dec_mem_map_add(mem_map, pointer, pointer_class, n_elements) != \
+            EB_ErrorNone) {                                                 \
+            free(pointer);                                                  \
+            return EB_ErrorInsufficientResources;                           \
+        }                                                                   \
     } while (0)
 
-EbErrorType dec_eb_recon_picture_buffer_desc_ctor(EbPtr *object_dbl_ptr, EbPtr object_init_data_ptr,
-                                                  Bool is_16bit_pipeline);
+EbErrorType dec_eb_recon_picture_buffer_desc_ctor(EbDecMemMap *mem_map, EbPtr *object_dbl_ptr,
+                                                  EbPtr                     object_init_data_ptr,
+                                                  Bool                      is_16bit_pipeline,
+                                                  EbSvtAv1DecConfiguration *dec_config,
+                                                  EbExtFrameBuf            *ext_frame_buf);
 
 EbErrorType dec_mem_init(EbDecHandle *dec_handle_ptr);
 
@@ -155,6 +155,10 @@ typedef struct MainParseCtxt {
 
     /* Array of ParseTileData for each Tile */
     ParseTileData *parse_tile_data;
+
+    /* Allocated number of tile contexts and of ParseTileData, they only grow */
+    int32_t context_alloc_count;
+    int32_t tile_data_alloc_count;
 } MainParseCtxt;
 
 void parse_super_block(EbDecHandle *dec_handle, ParseCtxt *parse_ctxt, uint32_t blk_row,
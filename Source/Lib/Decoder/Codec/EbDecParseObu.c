@@ -42,6 +42,7 @@ void dec_av1_loop_filter_frame_mt(EbDecHandle         *dec_handle_ptr,
                                   DecThreadCtxt *thread_ctxt);
 
 EbErrorType dec_system_resource_init(EbDecHandle *dec_handle_ptr, TilesInfo *tiles_info);
+EbErrorType dec_system_resource_update(EbDecHandle *dec_handle_ptr, TilesInfo *tiles_info);
 
 /* Scan through the Tiles to find Bitstream offsets */
 void svt_av1_scan_tiles(EbDecHandle *dec_handle_ptr, TilesInfo *tiles_info, ObuHeader *obu_header,
@@ -57,6 +58,8 @@ void svt_cdef_frame_mt(EbDecHandle *dec_handle_ptr, DecThreadCtxt *thread_ctxt);
 void svt_av1_queue_lr_jobs(EbDecHandle *dec_handle_ptr);
 void dec_av1_loop_restoration_filter_frame_mt(EbDecHandle *dec_handle, DecThreadCtxt *thread_ctxt);
 
+EbErrorType dec_submit_frame(EbDecHandle *dec_handle_ptr);
+
 #define CONFIG_MAX_DECODE_PROFILE 2
 
 void dec_init_intra_predictors_12b_internal(void);
@@ -1548,72 +1551,106 @@ static INLINE EbErrorType reallocate_parse_context_memory(EbDecHandle   *dec_han
     if (num_instances == 1)
         main_parse_ctx->context_count = num_tiles;
 
-    /* TO-DO this memory will be freed at the end of decode.
-       Can be optimized by reallocating the memory when
-       the number of tiles changes within a sequence. */
-    EB_MALLOC_DEC(
-        ParseCtxt *, main_parse_ctx->tile_parse_ctxt, sizeof(ParseCtxt) * num_ctx, EB_N_PTR);
+    /* The contexts only grow, each one is as wide as the frame so that it
+       fits any tile layout of the sequence */
+    if (num_ctx <= main_parse_ctx->context_alloc_count)
+        return EB_ErrorNone;
+    main_parse_ctx->context_alloc_count = num_ctx;
+
+    EB_MALLOC_DEC(dec_handle_ptr->mem_map,
+                  ParseCtxt *,
+                  main_parse_ctx->tile_parse_ctxt,
+                  sizeof(ParseCtxt) * num_ctx,
+                  EB_N_PTR);
 
-    EB_MALLOC_DEC(ParseAboveNbr4x4Ctxt *,
+    EB_MALLOC_DEC(dec_handle_ptr->mem_map,
+                  ParseAboveNbr4x4Ctxt *,
                   main_parse_ctx->parse_above_nbr4x4_ctxt,
                   sizeof(ParseAboveNbr4x4Ctxt) * num_ctx,
                   EB_N_PTR);
-    EB_MALLOC_DEC(ParseLeftNbr4x4Ctxt *,
+    EB_MALLOC_DEC(dec_handle_ptr->mem_map,
+                  ParseLeftNbr4x4Ctxt *,
                   main_parse_ctx->parse_left_nbr4x4_ctxt,
                   sizeof(ParseLeftNbr4x4Ctxt) * num_ctx,
                   EB_N_PTR);
-    int total_rows = num_instances == 1 ? 1 : tiles_info.tile_rows;
-    int total_cols = num_instances == 1 ? 1 : tiles_info.tile_cols;
-    for (int row = 0; row < total_rows; row++) {
-        for (int col = 0; col < total_cols; col++) {
-            int     instance    = (row * total_cols) + col;
-            int32_t num_mi_tile = tiles_info.tile_col_start_mi[col + 1] -
-                tiles_info.tile_col_start_mi[col];
-            int32_t num_mi_wide = num_instances == 1 ? num_mi_frame : num_mi_tile;
-            num_mi_wide         = ALIGN_POWER_OF_TWO(num_mi_wide, sb_size_log2 - MI_SIZE_LOG2);
-            ParseAboveNbr4x4Ctxt *above_ctx = &main_parse_ctx->parse_above_nbr4x4_ctxt[instance];
-            ParseLeftNbr4x4Ctxt  *left_ctx  = &main_parse_ctx->parse_left_nbr4x4_ctxt[instance];
-            EB_MALLOC_DEC(
-                uint8_t *, above_ctx->above_tx_wd, num_mi_wide * sizeof(uint8_t), EB_N_PTR);
-            EB_MALLOC_DEC(
-                uint8_t *, above_ctx->above_part_wd, num_mi_wide * sizeof(uint8_t), EB_N_PTR);
-            EB_MALLOC_DEC(uint8_t *, left_ctx->left_tx_ht, num_mi_sb * sizeof(uint8_t), EB_N_PTR);
-            EB_MALLOC_DEC(uint8_t *, left_ctx->left_part_ht, num_mi_sb * sizeof(uint8_t), EB_N_PTR);
-            /* TODO : Optimize the size for Chroma */
-            for (int i = 0; i < num_planes; i++) {
-                EB_MALLOC_DEC(
-                    uint8_t *, above_ctx->above_ctx[i], num_mi_wide * sizeof(uint8_t), EB_N_PTR);
-                EB_MALLOC_DEC(uint16_t *,
-                              above_ctx->above_palette_colors[i],
-                              num_mi_64x64 * PALETTE_MAX_SIZE * sizeof(uint16_t),
-                              EB_N_PTR);
-
-                EB_MALLOC_DEC(
-                    uint8_t *, left_ctx->left_ctx[i], num_mi_sb * sizeof(uint8_t), EB_N_PTR);
-                EB_MALLOC_DEC(uint16_t *,
-                              left_ctx->left_palette_colors[i],
-                              num_mi_sb * PALETTE_MAX_SIZE * sizeof(uint16_t),
-                              EB_N_PTR);
-            }
-            EB_MALLOC_DEC(
-                int8_t *, above_ctx->above_comp_grp_idx, num_mi_wide * sizeof(int8_t), EB_N_PTR);
-            EB_MALLOC_DEC(
-                uint8_t *, above_ctx->above_seg_pred_ctx, num_mi_wide * sizeof(uint8_t), EB_N_PTR);
-            EB_MALLOC_DEC(
-                int8_t *, left_ctx->left_comp_grp_idx, num_mi_sb * sizeof(int8_t), EB_N_PTR);
-            EB_MALLOC_DEC(
-                uint8_t *, left_ctx->left_seg_pred_ctx, num_mi_sb * sizeof(uint8_t), EB_N_PTR);
-        }
+    for (int instance = 0; instance < num_ctx; instance++) {
+        ParseAboveNbr4x4Ctxt *above_ctx = &main_parse_ctx->parse_above_nbr4x4_ctxt[instance];
+        ParseLeftNbr4x4Ctxt  *left_ctx  = &main_parse_ctx->parse_left_nbr4x4_ctxt[instance];
+        EB_MALLOC_DEC(dec_handle_ptr->mem_map,
+                      uint8_t *,
+                      above_ctx->above_tx_wd,
+                      num_mi_frame * sizeof(uint8_t),
+                      EB_N_PTR);
+        EB_MALLOC_DEC(dec_handle_ptr->mem_map,
+                      uint8_t *,
+                      above_ctx->above_part_wd,
+                      num_mi_frame * sizeof(uint8_t),
+                      EB_N_PTR);
+        EB_MALLOC_DEC(dec_handle_ptr->mem_map,
+                      uint8_t *,
+                      left_ctx->left_tx_ht,
+                      num_mi_sb * sizeof(uint8_t),
+                      EB_N_PTR);
+        EB_MALLOC_DEC(dec_handle_ptr->mem_map,
+                      uint8_t *,
+                      left_ctx->left_part_ht,
+                      num_mi_sb * sizeof(uint8_t),
+                      EB_N_PTR);
+        /* TODO : Optimize the size for Chroma */
+        for (int i = 0; i < num_planes; i++) {
+            EB_MALLOC_DEC(dec_handle_ptr->mem_map,
+                          uint8_t *,
+                          above_ctx->above_ctx[i],
+                          num_mi_frame * sizeof(uint8_t),
+                          EB_N_PTR);
+            EB_MALLOC_DEC(dec_handle_ptr->mem_map,
+                          uint16_t *,
+                          above_ctx->above_palette_colors[i],
+                          num_mi_64x64 * PALETTE_MAX_SIZE * sizeof(uint16_t),
+                          EB_N_PTR);
+
+            EB_MALLOC_DEC(dec_handle_ptr->mem_map,
+                          uint8_t *,
+                          left_ctx->left_ctx[i],
+                          num_mi_sb * sizeof(uint8_t),
+                          EB_N_PTR);
+            EB_MALLOC_DEC(dec_handle_ptr->mem_map,
+                          uint16_t *,
+                          left_ctx->left_palette_colors[i],
+                          num_mi_sb * PALETTE_MAX_SIZE * sizeof(uint16_t),
+                          EB_N_PTR);
+        }
+        EB_MALLOC_DEC(dec_handle_ptr->mem_map,
+                      int8_t *,
+                      above_ctx->above_comp_grp_idx,
+                      num_mi_frame * sizeof(int8_t),
+                      EB_N_PTR);
+        EB_MALLOC_DEC(dec_handle_ptr->mem_map,
+                      uint8_t *,
+                      above_ctx->above_seg_pred_ctx,
+                      num_mi_frame * sizeof(uint8_t),
+                      EB_N_PTR);
+        EB_MALLOC_DEC(dec_handle_ptr->mem_map,
+                      int8_t *,
+                      left_ctx->left_comp_grp_idx,
+                      num_mi_sb * sizeof(int8_t),
+                      EB_N_PTR);
+        EB_MALLOC_DEC(dec_handle_ptr->mem_map,
+                      uint8_t *,
+                      left_ctx->left_seg_pred_ctx,
+                      num_mi_sb * sizeof(uint8_t),
+                      EB_N_PTR);
     }
     return EB_ErrorNone;
 }
 
-static INLINE EbErrorType reallocate_parse_tile_data(MainParseCtxt *main_parse_ctx, int num_tiles) {
+static INLINE EbErrorType reallocate_parse_tile_data(EbDecMemMap   *mem_map,
+                                                      MainParseCtxt *main_parse_ctx, int num_tiles) {
     main_parse_ctx->num_tiles = num_tiles;
-    /* TO-DO this memory will be freed at the end of decode.
-       Can be optimized by reallocating the memory when
-       the number of tiles changes within a sequence. */
-    EB_MALLOC_DEC(ParseTileData *,
+    if (num_tiles <= main_parse_ctx->tile_data_alloc_count)
+        return EB_ErrorNone;
+    main_parse_ctx->tile_data_alloc_count = num_tiles;
+    EB_MALLOC_DEC(mem_map, ParseTileData *,
                   main_parse_ctx->parse_tile_data,
                   sizeof(ParseTileData) * num_tiles,
                   EB_N_PTR);
@@ -1646,7 +1683,7 @@ static void realloc_parse_memory(EbDecHandle *dec_handle_ptr) {
         reallocate_parse_context_memory(dec_handle_ptr, main_parse_ctx, num_instances);
     }
     if (num_tiles != main_parse_ctx->num_tiles)
-        reallocate_parse_tile_data(main_parse_ctx, num_tiles);
+        reallocate_parse_tile_data(dec_handle_ptr->mem_map, main_parse_ctx, num_tiles);
 }
 
 static void check_mt_support(EbDecHandle *dec_handle_ptr) {
@@ -1694,44 +1731,39 @@ static void check_mt_support(EbDecHandle *dec_handle_ptr) {
     }
 
     if (do_realloc) {
-        EbMemoryMapEntry *memory_entry   = svt_dec_memory_map;
-        EbMemoryMapEntry *previous_entry = NULL;
-        if (memory_entry != memory_map_end_address) {
-            while ((EbMemoryMapEntry *)memory_entry->prev_entry != memory_map_end_address) {
-                memory_entry = (EbMemoryMapEntry *)memory_entry->prev_entry;
-            }
-            previous_entry = memory_entry;
-            memory_entry   = (EbMemoryMapEntry *)memory_entry->prev_entry;
-        }
-        do {
-            switch (memory_entry->ptr_type) {
-            case EB_N_PTR: free(memory_entry->ptr); break;
-            case EB_A_PTR:
-#ifdef _WIN32
-                _aligned_free(memory_entry->ptr);
-#else
-                free(memory_entry->ptr);
-#endif
-                break;
-            case EB_SEMAPHORE: svt_destroy_semaphore(memory_entry->ptr); break;
-            case EB_THREAD: svt_destroy_thread(memory_entry->ptr); break;
-            case EB_MUTEX: svt_destroy_mutex(memory_entry->ptr); break;
-            default: break;
-            }
-            EbMemoryMapEntry *tmp_memory_entry = memory_entry;
-            memory_entry                       = (EbMemoryMapEntry *)tmp_memory_entry->prev_entry;
-            free(tmp_memory_entry);
-        } while (memory_entry != memory_map_start_address && memory_entry);
-        if (previous_entry != NULL)
-            previous_entry->prev_entry = memory_map_start_address;
-        else
-            svt_dec_memory_map = memory_map_start_address;
-        dec_system_resource_init(dec_handle_ptr, &tiles_info);
+        dec_system_resource_update(dec_handle_ptr, &tiles_info);
         set_prev_frame_info(dec_handle_ptr);
         realloc_parse_memory(dec_handle_ptr);
     }
 }
 
+/* Setup the MT resources and the parse contexts for the current frame */
+void dec_setup_frame_ctxt(EbDecHandle *dec_handle_ptr) {
+    MainParseCtxt *main_parse_ctx = (MainParseCtxt *)dec_handle_ptr->pv_main_parse_ctxt;
+    TilesInfo      tiles_info     = dec_handle_ptr->frame_header.tiles_info;
+
+    /* With frame parallel decode the MT resources belong to the frame slots */
+    if (dec_handle_ptr->dec_config.threads > 1 && dec_handle_ptr->num_frms_prll == 1) {
+        /* Call System Resource Init only once */
+        if (FALSE == dec_handle_ptr->start_thread_process) {
+            dec_system_resource_init(dec_handle_ptr, &tiles_info);
+            dec_handle_ptr->start_thread_process = TRUE;
+        }
+        check_mt_support(dec_handle_ptr);
+    }
+
+    int num_tiles     = tiles_info.tile_cols * tiles_info.tile_rows;
+    int num_instances = num_tiles;
+
+    if (dec_handle_ptr->dec_config.threads != 1)
+        num_instances = MIN((int32_t)dec_handle_ptr->dec_config.threads, num_tiles);
+
+    if (num_instances != main_parse_ctx->context_count)
+        realloc_parse_memory(dec_handle_ptr);
+    else if (num_tiles != main_parse_ctx->num_tiles)
+        reallocate_parse_tile_data(dec_handle_ptr->mem_map, main_parse_ctx, num_tiles);
+}
+
 void read_uncompressed_header(Bitstrm *bs, EbDecHandle *dec_handle_ptr, ObuHeader *obu_header,
                               int num_planes) {
     SeqHeader   *seq_header = &dec_handle_ptr->seq_header;
@@ -2076,29 +2108,12 @@ void read_uncompressed_header(Bitstrm *bs, EbDecHandle *dec_handle_ptr, ObuHeade
     MainParseCtxt *main_parse_ctx = (MainParseCtxt *)dec_handle_ptr->pv_main_parse_ctxt;
     if (frame_info->primary_ref_frame == PRIMARY_REF_NONE)
         reset_parse_ctx(&main_parse_ctx->init_frm_ctx, frame_info->quantization_params.base_q_idx);
-    else
-        /* Load CDF */
+    else if (dec_handle_ptr->num_frms_prll == 1)
+        /* Load CDF. In frame parallel mode the frame slot loads it
+           once the primary reference frame is parsed */
         main_parse_ctx->init_frm_ctx = dec_handle_ptr->prev_frame->final_frm_ctx;
 
-    TilesInfo tiles_info = dec_handle_ptr->frame_header.tiles_info;
-
-    if (dec_handle_ptr->dec_config.threads > 1) {
-        /* Call System Resource Init only once */
-        if (FALSE == dec_handle_ptr->start_thread_process) {
-            dec_system_resource_init(dec_handle_ptr, &tiles_info);
-            dec_handle_ptr->start_thread_process = TRUE;
-        }
-        check_mt_support(dec_handle_ptr);
-    }
-
-    int num_tiles     = tiles_info.tile_cols * tiles_info.tile_rows;
-    int num_instances = num_tiles;
-
-    if (dec_handle_ptr->dec_config.threads != 1)
-        num_instances = MIN((int32_t)dec_handle_ptr->dec_config.threads, num_tiles);
-
-    if (num_instances != main_parse_ctx->context_count)
-        realloc_parse_memory(dec_handle_ptr);
+    dec_setup_frame_ctxt(dec_handle_ptr);
 
     frame_info->coded_lossless = 1;
     for (int i = 0; i < MAX_SEGMENTS; ++i) {
@@ -2204,22 +2219,17 @@ EbErrorType read_frame_header_obu(Bitstrm *bs, EbDecHandle *dec_handle_ptr, ObuH
     return status;
 }
 
-// Read Tile group information
-EbErrorType read_tile_group_obu(Bitstrm *bs, EbDecHandle *dec_handle_ptr, TilesInfo *tiles_info,
-                                ObuHeader *obu_header, int *is_last_tg) {
-    EbErrorType status = EB_ErrorNone;
-
+/* MT decode of the frame once all its tile groups are scanned */
+void decode_frame_mt(EbDecHandle *dec_handle_ptr) {
     MainParseCtxt *main_parse_ctxt = (MainParseCtxt *)dec_handle_ptr->pv_main_parse_ctxt;
 
     FrameHeader *frame_header = &dec_handle_ptr->frame_header;
+    TilesInfo   *tiles_info   = &frame_header->tiles_info;
 
     DecMtFrameData *dec_mt_frame_data =
         &dec_handle_ptr->main_frame_buf.cur_frame_bufs[0].dec_mt_frame_data;
 
-    int      num_tiles, tg_start, tg_end, tile_start_and_end_present_flag = 0;
-    uint32_t start_position, end_position, header_bytes;
-    num_tiles = tiles_info->tile_cols * tiles_info->tile_rows;
-
+    int32_t num_tiles          = tiles_info->tile_cols * tiles_info->tile_rows;
     int32_t sb_size_log2       = dec_handle_ptr->seq_header.sb_size_log2;
     int32_t sb_aligned_width   = ALIGN_POWER_OF_TWO(frame_header->frame_size.frame_width,
                                                   sb_size_log2);
@@ -2230,6 +2240,142 @@ EbErrorType read_tile_group_obu(Bitstrm *bs, EbDecHandle *dec_handle_ptr, TilesI
     dec_mt_frame_data->sb_cols = sb_cols;
     dec_mt_frame_data->sb_rows = sb_rows;
 
+    uint32_t num_threads = dec_handle_ptr->dec_config.threads;
+
+    /* PPF flags derivation */
+    Bool no_ibc     = !frame_header->allow_intrabc;
+    Bool do_upscale = no_ibc && !av1_superres_unscaled(&frame_header->frame_size);
+    /* LR */
+    LrParams *lr_param = frame_header->lr_params;
+    Bool      do_lr    = no_ibc &&
+        (lr_param[AOM_PLANE_Y].frame_restoration_type != RESTORE_NONE ||
+         lr_param[AOM_PLANE_U].frame_restoration_type != RESTORE_NONE ||
+         lr_param[AOM_PLANE_V].frame_restoration_type != RESTORE_NONE);
+
+    /* Save CDF. Done upfront, as the frame is available for
+       reference to the following frames once all its tiles are parsed */
+    if (frame_header->disable_frame_end_update_cdf)
+        dec_handle_ptr->cur_pic_buf[0]->final_frm_ctx = main_parse_ctxt->init_frm_ctx;
+
+    {
+        int32_t tiles_ctr;
+
+        for (tiles_ctr = 0; tiles_ctr < num_tiles; tiles_ctr++) {
+            uint32_t *sb_recon_completed_in_row, *sb_recon_row_started;
+            uint32_t *sb_recon_row_parsed;
+            uint32_t  tile_num_sb_rows;
+
+            sb_recon_row_parsed =
+                dec_mt_frame_data->parse_recon_tile_info_array[tiles_ctr].sb_recon_row_parsed;
+            sb_recon_completed_in_row =
+                dec_mt_frame_data->parse_recon_tile_info_array[tiles_ctr].sb_recon_completed_in_row;
+            sb_recon_row_started =
+                dec_mt_frame_data->parse_recon_tile_info_array[tiles_ctr].sb_recon_row_started;
+            tile_num_sb_rows =
+                dec_mt_frame_data->parse_recon_tile_info_array[tiles_ctr].tile_num_sb_rows;
+
+            dec_mt_frame_data->parse_recon_tile_info_array[tiles_ctr].sb_row_to_process = 0;
+
+            memset(sb_recon_row_parsed, 0, tile_num_sb_rows * sizeof(uint32_t));
+            memset(sb_recon_completed_in_row, 0, tile_num_sb_rows * sizeof(uint32_t));
+            memset(sb_recon_row_started, 0, tile_num_sb_rows * sizeof(uint32_t));
+        }
+    }
+
+    const int mvs_rows    = (frame_header->mi_rows + 1) >> 1; //8x8 unit level
+    const int sb_mvs_rows = (mvs_rows + 7) >> 3; //64x64 unit level
+    dec_mt_frame_data->motion_proj_info.num_motion_proj_rows       = sb_mvs_rows;
+    dec_mt_frame_data->motion_proj_info.motion_proj_row_to_process = 0;
+    dec_mt_frame_data->motion_proj_info.motion_proj_init_done      = FALSE;
+    dec_mt_frame_data->num_threads_header                          = 0;
+
+    svt_block_on_mutex(dec_mt_frame_data->temp_mutex);
+    dec_mt_frame_data->start_motion_proj = TRUE;
+    svt_release_mutex(dec_mt_frame_data->temp_mutex);
+    svt_post_semaphore(dec_handle_ptr->thread_semaphore);
+    /* The library threads wait for the frame start in dec_all_stage_kernel */
+    svt_set_cond_var(&dec_mt_frame_data->lib_threads_wake,
+                     svt_get_cond_var(&dec_mt_frame_data->lib_threads_wake) + 1);
+
+    svt_setup_motion_field(dec_handle_ptr, NULL);
+
+    svt_av1_queue_parse_jobs(dec_handle_ptr, tiles_info);
+
+    svt_block_on_mutex(dec_mt_frame_data->temp_mutex);
+    dec_mt_frame_data->start_parse_frame = TRUE;
+
+    dec_mt_frame_data->num_threads_cdefed = 0;
+    dec_mt_frame_data->num_threads_lred   = 0;
+
+    svt_release_mutex(dec_mt_frame_data->temp_mutex);
+    svt_post_semaphore(dec_handle_ptr->thread_semaphore);
+    for (uint32_t lib_thrd = 0; lib_thrd < num_threads - 1; lib_thrd++)
+        svt_post_semaphore(dec_handle_ptr->thread_ctxt_pa[lib_thrd].thread_semaphore);
+
+    svt_av1_queue_lf_jobs(dec_handle_ptr);
+    svt_av1_queue_cdef_jobs(dec_handle_ptr);
+    svt_block_on_mutex(dec_mt_frame_data->temp_mutex);
+
+    dec_mt_frame_data->start_lf_frame = TRUE;
+    /*ToDo : Post outside mutex lock */
+    svt_post_semaphore(dec_handle_ptr->thread_semaphore);
+    for (uint32_t lib_thrd = 0; lib_thrd < num_threads - 1; lib_thrd++)
+        svt_post_semaphore(dec_handle_ptr->thread_ctxt_pa[lib_thrd].thread_semaphore);
+    dec_mt_frame_data->start_cdef_frame = TRUE;
+    svt_post_semaphore(dec_handle_ptr->thread_semaphore);
+    for (uint32_t lib_thrd = 0; lib_thrd < num_threads - 1; lib_thrd++)
+        svt_post_semaphore(dec_handle_ptr->thread_ctxt_pa[lib_thrd].thread_semaphore);
+    svt_release_mutex(dec_mt_frame_data->temp_mutex);
+
+    if (!do_upscale)
+        svt_av1_queue_lr_jobs(dec_handle_ptr);
+
+    parse_frame_tiles(dec_handle_ptr, 0);
+
+    decode_frame_tiles(dec_handle_ptr, NULL);
+
+    dec_av1_loop_filter_frame_mt(dec_handle_ptr,
+                                 dec_handle_ptr->cur_pic_buf[0]->ps_pic_buf,
+                                 dec_handle_ptr->pv_lf_ctxt,
+                                 AOM_PLANE_Y,
+                                 MAX_MB_PLANE,
+                                 NULL);
+
+    svt_cdef_frame_mt(dec_handle_ptr, NULL);
+
+    svt_av1_superres_upscale(dec_handle_ptr,
+                             frame_header,
+                             dec_handle_ptr->cur_pic_buf[0]->ps_pic_buf,
+                             do_upscale);
+
+    if (do_upscale)
+        dec_handle_ptr->cm.frm_size.frame_width = frame_header->frame_size.frame_width;
+
+    if (do_lr && do_upscale)
+        dec_av1_loop_restoration_save_boundary_lines(dec_handle_ptr, 1);
+
+    if (do_upscale)
+        svt_av1_queue_lr_jobs(dec_handle_ptr);
+    dec_mt_frame_data->start_lr_frame = TRUE;
+    svt_post_semaphore(dec_handle_ptr->thread_semaphore);
+    for (uint32_t lib_thrd = 0; lib_thrd < num_threads - 1; lib_thrd++)
+        svt_post_semaphore(dec_handle_ptr->thread_ctxt_pa[lib_thrd].thread_semaphore);
+    dec_av1_loop_restoration_filter_frame_mt(dec_handle_ptr, NULL);
+}
+
+// Read Tile group information
+EbErrorType read_tile_group_obu(Bitstrm *bs, EbDecHandle *dec_handle_ptr, TilesInfo *tiles_info,
+                                ObuHeader *obu_header, int *is_last_tg) {
+    EbErrorType status = EB_ErrorNone;
+
+    MainParseCtxt *main_parse_ctxt = (MainParseCtxt *)dec_handle_ptr->pv_main_parse_ctxt;
+
+    FrameHeader *frame_header = &dec_handle_ptr->frame_header;
+
+    int      num_tiles, tg_start, tg_end, tile_start_and_end_present_flag = 0;
+    uint32_t start_position, end_position, header_bytes;
+    num_tiles = tiles_info->tile_cols * tiles_info->tile_rows;
+
     start_position = get_position(bs);
     if (num_tiles > 1) {
         tile_start_and_end_present_flag = dec_get_bits(bs, 1);
@@ -2273,6 +2419,20 @@ EbErrorType read_tile_group_obu(Bitstrm *bs, EbDecHandle *dec_handle_ptr, TilesI
     uint32_t num_threads = dec_handle_ptr->dec_config.threads;
     int      is_mt       = num_threads != 1;
 
+    /* Set Parse Jobs */
+    if (is_mt) {
+        svt_av1_scan_tiles(dec_handle_ptr, tiles_info, obu_header, bs, tg_start, tg_end);
+        if ((tg_end + 1) != num_tiles)
+            return 0;
+
+        /* Frame parallel : the frame is decoded by one of the frame slots */
+        if (dec_handle_ptr->num_frms_prll > 1)
+            return dec_submit_frame(dec_handle_ptr);
+
+        decode_frame_mt(dec_handle_ptr);
+        return status;
+    }
+
     /* PPF flags derivation */
     Bool no_ibc = !dec_handle_ptr->frame_header.allow_intrabc;
     /* LF */
@@ -2294,145 +2454,49 @@ EbErrorType read_tile_group_obu(Bitstrm *bs, EbDecHandle *dec_handle_ptr, TilesI
          lr_param[AOM_PLANE_U].frame_restoration_type != RESTORE_NONE ||
          lr_param[AOM_PLANE_V].frame_restoration_type != RESTORE_NONE);
 
-    /* Set Parse Jobs */
-    if (is_mt) {
-        svt_av1_scan_tiles(dec_handle_ptr, tiles_info, obu_header, bs, tg_start, tg_end);
-        if ((tg_end + 1) != num_tiles)
-            return 0;
-        {
-            int32_t tiles_ctr;
-
-            for (tiles_ctr = 0; tiles_ctr < num_tiles; tiles_ctr++) {
-                uint32_t *sb_recon_completed_in_row, *sb_recon_row_started;
-                uint32_t *sb_recon_row_parsed;
-                uint32_t  tile_num_sb_rows;
-
-                sb_recon_row_parsed =
-                    dec_mt_frame_data->parse_recon_tile_info_array[tiles_ctr].sb_recon_row_parsed;
-                sb_recon_completed_in_row = dec_mt_frame_data
-                                                ->parse_recon_tile_info_array[tiles_ctr]
-                                                .sb_recon_completed_in_row;
-                sb_recon_row_started =
-                    dec_mt_frame_data->parse_recon_tile_info_array[tiles_ctr].sb_recon_row_started;
-                tile_num_sb_rows =
-                    dec_mt_frame_data->parse_recon_tile_info_array[tiles_ctr].tile_num_sb_rows;
-
-                dec_mt_frame_data->parse_recon_tile_info_array[tiles_ctr].sb_row_to_process = 0;
-
-                memset(sb_recon_row_parsed, 0, tile_num_sb_rows * sizeof(uint32_t));
-                memset(sb_recon_completed_in_row, 0, tile_num_sb_rows * sizeof(uint32_t));
-                memset(sb_recon_row_started, 0, tile_num_sb_rows * sizeof(uint32_t));
-            }
+    //TO-DO assign to appropriate tile_parse_ctxt
+    ParseCtxt *parse_ctxt               = &main_parse_ctxt->tile_parse_ctxt[0];
+    parse_ctxt->seq_header              = &dec_handle_ptr->seq_header;
+    parse_ctxt->frame_header            = &dec_handle_ptr->frame_header;
+    parse_ctxt->parse_above_nbr4x4_ctxt = &main_parse_ctxt->parse_above_nbr4x4_ctxt[0];
+    parse_ctxt->parse_left_nbr4x4_ctxt  = &main_parse_ctxt->parse_left_nbr4x4_ctxt[0];
+
+    for (int tile_num = tg_start; tile_num <= tg_end; tile_num++) {
+        size_t tile_size;
+        if (tile_num == tg_end)
+            tile_size = obu_header->payload_size;
+        else {
+            tile_size = dec_get_bits_le(bs, tiles_info->tile_size_bytes) + 1;
+            obu_header->payload_size -= (tiles_info->tile_size_bytes + tile_size);
         }
 
-        const int mvs_rows    = (dec_handle_ptr->frame_header.mi_rows + 1) >> 1; //8x8 unit level
-        const int sb_mvs_rows = (mvs_rows + 7) >> 3; //64x64 unit level
-        dec_mt_frame_data->motion_proj_info.num_motion_proj_rows       = sb_mvs_rows;
-        dec_mt_frame_data->motion_proj_info.motion_proj_row_to_process = 0;
-        dec_mt_frame_data->motion_proj_info.motion_proj_init_done      = FALSE;
-        dec_mt_frame_data->num_threads_header                          = 0;
-
-        svt_block_on_mutex(dec_mt_frame_data->temp_mutex);
-        dec_mt_frame_data->start_motion_proj = TRUE;
-        svt_release_mutex(dec_mt_frame_data->temp_mutex);
-        svt_post_semaphore(dec_handle_ptr->thread_semaphore);
-        for (uint32_t lib_thrd = 0; lib_thrd < num_threads - 1; lib_thrd++)
-            svt_post_semaphore(dec_handle_ptr->thread_ctxt_pa[lib_thrd].thread_semaphore);
-
-        svt_setup_motion_field(dec_handle_ptr, NULL);
-
-        svt_av1_queue_parse_jobs(dec_handle_ptr, tiles_info);
-
-        svt_block_on_mutex(dec_mt_frame_data->temp_mutex);
-        dec_mt_frame_data->start_parse_frame = TRUE;
+        ParseTileData *parse_tile_data      = main_parse_ctxt->parse_tile_data;
+        parse_tile_data[tile_num].data      = get_bitsteam_buf(bs);
+        parse_tile_data[tile_num].data_end  = bs->buf_max;
+        parse_tile_data[tile_num].tile_size = tile_size;
 
-        dec_mt_frame_data->num_threads_cdefed = 0;
-        dec_mt_frame_data->num_threads_lred   = 0;
-
-        svt_release_mutex(dec_mt_frame_data->temp_mutex);
-        svt_post_semaphore(dec_handle_ptr->thread_semaphore);
-        for (uint32_t lib_thrd = 0; lib_thrd < num_threads - 1; lib_thrd++)
-            svt_post_semaphore(dec_handle_ptr->thread_ctxt_pa[lib_thrd].thread_semaphore);
-
-        svt_av1_queue_lf_jobs(dec_handle_ptr);
-        svt_av1_queue_cdef_jobs(dec_handle_ptr);
-        svt_block_on_mutex(dec_mt_frame_data->temp_mutex);
-
-        dec_mt_frame_data->start_lf_frame = TRUE;
-        /*ToDo : Post outside mutex lock */
-        svt_post_semaphore(dec_handle_ptr->thread_semaphore);
-        for (uint32_t lib_thrd = 0; lib_thrd < num_threads - 1; lib_thrd++)
-            svt_post_semaphore(dec_handle_ptr->thread_ctxt_pa[lib_thrd].thread_semaphore);
-        dec_mt_frame_data->start_cdef_frame = TRUE;
-        svt_post_semaphore(dec_handle_ptr->thread_semaphore);
-        for (uint32_t lib_thrd = 0; lib_thrd < num_threads - 1; lib_thrd++)
-            svt_post_semaphore(dec_handle_ptr->thread_ctxt_pa[lib_thrd].thread_semaphore);
-        svt_release_mutex(dec_mt_frame_data->temp_mutex);
-
-        if (!do_upscale)
-            svt_av1_queue_lr_jobs(dec_handle_ptr);
-
-        parse_frame_tiles(dec_handle_ptr, 0);
-
-        decode_frame_tiles(dec_handle_ptr, NULL);
-    } else {
-        //TO-DO assign to appropriate tile_parse_ctxt
-        ParseCtxt *parse_ctxt               = &main_parse_ctxt->tile_parse_ctxt[0];
-        parse_ctxt->seq_header              = &dec_handle_ptr->seq_header;
-        parse_ctxt->frame_header            = &dec_handle_ptr->frame_header;
-        parse_ctxt->parse_above_nbr4x4_ctxt = &main_parse_ctxt->parse_above_nbr4x4_ctxt[0];
-        parse_ctxt->parse_left_nbr4x4_ctxt  = &main_parse_ctxt->parse_left_nbr4x4_ctxt[0];
-
-        for (int tile_num = tg_start; tile_num <= tg_end; tile_num++) {
-            size_t tile_size;
-            if (tile_num == tg_end)
-                tile_size = obu_header->payload_size;
-            else {
-                tile_size = dec_get_bits_le(bs, tiles_info->tile_size_bytes) + 1;
-                obu_header->payload_size -= (tiles_info->tile_size_bytes + tile_size);
-            }
-
-            ParseTileData *parse_tile_data      = main_parse_ctxt->parse_tile_data;
-            parse_tile_data[tile_num].data      = get_bitsteam_buf(bs);
-            parse_tile_data[tile_num].data_end  = bs->buf_max;
-            parse_tile_data[tile_num].tile_size = tile_size;
-
-            start_parse_tile(dec_handle_ptr, parse_ctxt, tiles_info, tile_num, is_mt);
-            dec_bits_init(bs, (get_bitsteam_buf(bs) + tile_size), obu_header->payload_size);
-        }
+        start_parse_tile(dec_handle_ptr, parse_ctxt, tiles_info, tile_num, is_mt);
+        dec_bits_init(bs, (get_bitsteam_buf(bs) + tile_size), obu_header->payload_size);
     }
 
     if ((tg_end + 1) != num_tiles)
         return 0;
 
-    if (is_mt) {
-        dec_av1_loop_filter_frame_mt(dec_handle_ptr,
-                                     dec_handle_ptr->cur_pic_buf[0]->ps_pic_buf,
-                                     dec_handle_ptr->pv_lf_ctxt,
-                                     AOM_PLANE_Y,
-                                     MAX_MB_PLANE,
-                                     NULL);
-    } else {
-        dec_av1_loop_filter_frame(dec_handle_ptr,
-                                  dec_handle_ptr->cur_pic_buf[0]->ps_pic_buf,
-                                  dec_handle_ptr->pv_lf_ctxt,
-                                  AOM_PLANE_Y,
-                                  MAX_MB_PLANE,
-                                  is_mt,
-                                  do_lf_flag);
-    }
+    dec_av1_loop_filter_frame(dec_handle_ptr,
+                              dec_handle_ptr->cur_pic_buf[0]->ps_pic_buf,
+                              dec_handle_ptr->pv_lf_ctxt,
+                              AOM_PLANE_Y,
+                              MAX_MB_PLANE,
+                              is_mt,
+                              do_lf_flag);
 
-    if (!is_mt && do_lr)
+    if (do_lr)
         dec_av1_loop_restoration_save_boundary_lines(dec_handle_ptr, 0);
 
-    if (is_mt) {
-        svt_cdef_frame_mt(dec_handle_ptr, NULL);
-    } else
-        svt_cdef_frame(dec_handle_ptr, do_cdef);
+    svt_cdef_frame(dec_handle_ptr, do_cdef);
 
-    svt_av1_superres_upscale(&dec_handle_ptr->cm,
+    svt_av1_superres_upscale(dec_handle_ptr,
                              &dec_handle_ptr->frame_header,
-                             &dec_handle_ptr->seq_header,
                              dec_handle_ptr->cur_pic_buf[0]->ps_pic_buf,
                              do_upscale);
 
@@ -2440,27 +2504,16 @@ EbErrorType read_tile_group_obu(Bitstrm *bs, EbDecHandle *dec_handle_ptr, TilesI
         dec_handle_ptr->cm.frm_size.frame_width =
             dec_handle_ptr->frame_header.frame_size.frame_width;
 
-    if (do_lr && (!is_mt || do_upscale))
+    if (do_lr)
         dec_av1_loop_restoration_save_boundary_lines(dec_handle_ptr, 1);
 
-    if (is_mt) {
-        if (do_upscale)
-            svt_av1_queue_lr_jobs(dec_handle_ptr);
-        dec_handle_ptr->main_frame_buf.cur_frame_bufs[0].dec_mt_frame_data.start_lr_frame = TRUE;
-        svt_post_semaphore(dec_handle_ptr->thread_semaphore);
-        for (uint32_t lib_thrd = 0; lib_thrd < num_threads - 1; lib_thrd++)
-            svt_post_semaphore(dec_handle_ptr->thread_ctxt_pa[lib_thrd].thread_semaphore);
-        dec_av1_loop_restoration_filter_frame_mt(dec_handle_ptr, NULL);
-    } else
-        dec_av1_loop_restoration_filter_frame(dec_handle_ptr, 0, /*opt_lr*/ do_lr);
+    dec_av1_loop_restoration_filter_frame(dec_handle_ptr, 0, /*opt_lr*/ do_lr);
 
     /* Save CDF */
     if (frame_header->disable_frame_end_update_cdf)
         dec_handle_ptr->cur_pic_buf[0]->final_frm_ctx = main_parse_ctxt->init_frm_ctx;
 
-    if (!is_mt) {
-        pad_pic(dec_handle_ptr);
-    }
+    pad_pic(dec_handle_ptr);
 
     return status;
 }
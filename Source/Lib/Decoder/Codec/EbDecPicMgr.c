@@ -30,6 +30,8 @@
 
 #define NUM_REF_FRAMES 8 // TODO: remove (reuse EbObuParse.h macro)
 
+void dec_retire_frame_slots(EbDecHandle *dec_handle_ptr);
+
 /**
 *******************************************************************************
 *
@@ -49,8 +51,17 @@
 *******************************************************************************
 */
 
+static void release_ext_frame_buf(EbSvtAv1DecConfiguration *dec_config, EbExtFrameBuf *fb) {
+    if (fb->buffer != NULL) {
+        dec_config->release_frame_buffer(fb, dec_config->frame_buffer_private_data);
+        fb->buffer      = NULL;
+        fb->buffer_size = 0;
+    }
+}
+
 EbErrorType dec_pic_mgr_init(EbDecHandle *dec_handle_ptr) {
     EbDecPicMgr **pps_pic_mgr = (EbDecPicMgr **)&dec_handle_ptr->pv_pic_mgr;
+    EbDecPicMgr  *prev_pic_mgr = *pps_pic_mgr;
     uint32_t      mi_cols     = 2 * ((dec_handle_ptr->seq_header.max_frame_width + 7) >> 3);
     uint32_t      mi_rows     = 2 * ((dec_handle_ptr->seq_header.max_frame_height + 7) >> 3);
     int           size        = mi_cols * mi_rows;
@@ -58,19 +69,40 @@ EbErrorType dec_pic_mgr_init(EbDecHandle *dec_handle_ptr) {
     EbErrorType return_error = EB_ErrorNone;
     int32_t     i;
 
-    EB_MALLOC_DEC(void *, *pps_pic_mgr, sizeof(EbDecPicMgr), EB_N_PTR);
+    /* The external planes of the unused pictures go back to the application,
+       the ones still referenced are released at deinit */
+    if (prev_pic_mgr != NULL && dec_handle_ptr->dec_config.release_frame_buffer != NULL) {
+        for (i = 0; i < MAX_PIC_BUFS; i++) {
+            if (prev_pic_mgr->as_dec_pic[i].is_free) {
+                release_ext_frame_buf(&dec_handle_ptr->dec_config,
+                                      &prev_pic_mgr->as_dec_pic[i].ext_frame_buf);
+                release_ext_frame_buf(&dec_handle_ptr->dec_config,
+                                      &prev_pic_mgr->as_dec_pic[i].ext_out_buf);
+            }
+        }
+    }
+
+    EB_MALLOC_DEC(dec_handle_ptr->mem_map, void *, *pps_pic_mgr, sizeof(EbDecPicMgr), EB_N_PTR);
 
     EbDecPicMgr *ps_pic_mgr = *pps_pic_mgr;
 
+    ps_pic_mgr->prev_pic_mgr = prev_pic_mgr;
     for (i = 0; i < MAX_PIC_BUFS; i++) {
         ps_pic_mgr->as_dec_pic[i].ps_pic_buf = NULL;
         ps_pic_mgr->as_dec_pic[i].is_free    = 1;
         ps_pic_mgr->as_dec_pic[i].size       = 0;
         ps_pic_mgr->as_dec_pic[i].ref_count  = 0;
         ps_pic_mgr->as_dec_pic[i].mvs        = NULL;
-        EB_MALLOC_DEC(
-            uint8_t *, ps_pic_mgr->as_dec_pic[i].segment_maps, size * sizeof(uint8_t), EB_N_PTR);
+        memset(&ps_pic_mgr->as_dec_pic[i].ext_frame_buf, 0, sizeof(EbExtFrameBuf));
+        memset(&ps_pic_mgr->as_dec_pic[i].ext_out_buf, 0, sizeof(EbExtFrameBuf));
+        EB_MALLOC_DEC(dec_handle_ptr->mem_map,
+                      uint8_t *,
+                      ps_pic_mgr->as_dec_pic[i].segment_maps,
+                      size * sizeof(uint8_t),
+                      EB_N_PTR);
         memset(ps_pic_mgr->as_dec_pic[i].segment_maps, 0, size);
+        svt_create_cond_var(&ps_pic_mgr->as_dec_pic[i].parse_done);
+        svt_create_cond_var(&ps_pic_mgr->as_dec_pic[i].rows_done);
     }
 
     ps_pic_mgr->num_pic_bufs = 0;
@@ -78,12 +110,13 @@ EbErrorType dec_pic_mgr_init(EbDecHandle *dec_handle_ptr) {
     return return_error;
 }
 
-static INLINE EbErrorType mvs_8x8_memory_alloc(TemporalMvRef **mvs, FrameHeader *frame_info) {
+static INLINE EbErrorType mvs_8x8_memory_alloc(EbDecMemMap *mem_map, TemporalMvRef **mvs,
+                                               FrameHeader *frame_info) {
     const int frame_mvs_stride = ROUND_POWER_OF_TWO(frame_info->mi_cols, 1);
     const int frame_mvs_rows   = ROUND_POWER_OF_TWO(frame_info->mi_rows, 1);
     const int mvs_buff_size    = frame_mvs_stride * frame_mvs_rows;
 
-    EB_MALLOC_DEC(TemporalMvRef *, *mvs, mvs_buff_size * sizeof(TemporalMvRef), EB_N_PTR);
+    EB_MALLOC_DEC(mem_map, TemporalMvRef *, *mvs, mvs_buff_size * sizeof(TemporalMvRef), EB_N_PTR);
 
     return EB_ErrorNone;
 }
@@ -123,8 +156,18 @@ EbDecPicBuf *dec_pic_mgr_get_cur_pic(EbDecHandle *dec_handle_ptr) {
             break;
     }
 
-    if (i >= MAX_PIC_BUFS)
-        return NULL;
+    if (i >= MAX_PIC_BUFS) {
+        if (dec_handle_ptr->num_frms_prll == 1)
+            return NULL;
+        /* Buffers held by the frames in flight get free once they are decoded */
+        dec_retire_frame_slots(dec_handle_ptr);
+        for (i = 0; i < MAX_PIC_BUFS; i++) {
+            if (ps_pic_mgr->as_dec_pic[i].is_free == 1)
+                break;
+        }
+        if (i >= MAX_PIC_BUFS)
+            return NULL;
+    }
 
     uint16_t       frame_width  = frame_info->frame_size.frame_width;
     uint16_t       frame_height = frame_info->frame_size.frame_height;
@@ -156,10 +199,21 @@ EbDecPicBuf *dec_pic_mgr_get_cur_pic(EbDecHandle *dec_handle_ptr) {
 
         input_pic_buf_desc_init_data.split_mode = FALSE;
 
+        EbExtFrameBuf *ext_frame_buf = NULL;
+        if (dec_handle_ptr->dec_config.allocate_frame_buffer != NULL) {
+            ext_frame_buf = &ps_pic_mgr->as_dec_pic[i].ext_frame_buf;
+            release_ext_frame_buf(&dec_handle_ptr->dec_config, ext_frame_buf);
+            release_ext_frame_buf(&dec_handle_ptr->dec_config,
+                                  &ps_pic_mgr->as_dec_pic[i].ext_out_buf);
+        }
+
         EbErrorType return_error = dec_eb_recon_picture_buffer_desc_ctor(
+            dec_handle_ptr->mem_map,
             (EbPtr *)&(ps_pic_mgr->as_dec_pic[i].ps_pic_buf),
             (EbPtr)&input_pic_buf_desc_init_data,
-            dec_handle_ptr->is_16bit_pipeline);
+            dec_handle_ptr->is_16bit_pipeline,
+            &dec_handle_ptr->dec_config,
+            ext_frame_buf);
 
         if (return_error != EB_ErrorNone)
             return NULL;
@@ -167,7 +221,8 @@ EbDecPicBuf *dec_pic_mgr_get_cur_pic(EbDecHandle *dec_handle_ptr) {
         ps_pic_mgr->as_dec_pic[i].size = frame_size;
 
         /* Memory for storing MV's at 8x8 lvl*/
-        EbErrorType ret_err = mvs_8x8_memory_alloc(&ps_pic_mgr->as_dec_pic[i].mvs, frame_info);
+        EbErrorType ret_err = mvs_8x8_memory_alloc(
+            dec_handle_ptr->mem_map, &ps_pic_mgr->as_dec_pic[i].mvs, frame_info);
         if (ret_err != EB_ErrorNone)
             return NULL;
 
@@ -178,6 +233,16 @@ EbDecPicBuf *dec_pic_mgr_get_cur_pic(EbDecHandle *dec_handle_ptr) {
     ps_pic_mgr->as_dec_pic[i].is_free   = 0;
     ps_pic_mgr->as_dec_pic[i].ref_count = 1;
 
+    /* Without frame parallel decode the frame is complete
+       before any other frame refers to it */
+    if (dec_handle_ptr->num_frms_prll == 1) {
+        svt_set_cond_var(&ps_pic_mgr->as_dec_pic[i].parse_done, 1);
+        svt_set_cond_var(&ps_pic_mgr->as_dec_pic[i].rows_done, INT32_MAX);
+    } else {
+        svt_set_cond_var(&ps_pic_mgr->as_dec_pic[i].parse_done, 0);
+        svt_set_cond_var(&ps_pic_mgr->as_dec_pic[i].rows_done, 0);
+    }
+
     pic_buf = &ps_pic_mgr->as_dec_pic[i];
 
     return pic_buf;
@@ -191,6 +256,49 @@ static INLINE void dec_ref_count_and_rel(EbDecPicBuf *ps_pic_buf) {
     }
 }
 
+/* Release a reference to the picture buffer */
+void dec_pic_mgr_release_pic(EbDecPicBuf *ps_pic_buf) { dec_ref_count_and_rel(ps_pic_buf); }
+
+/* Wait till all the tiles of the picture are parsed.
+   Returns FALSE if the picture failed to decode */
+Bool dec_pic_wait_parse(EbDecPicBuf *ps_pic_buf) {
+    int32_t parse_done;
+    while ((parse_done = svt_get_cond_var(&ps_pic_buf->parse_done)) == 0)
+        svt_wait_cond_var(&ps_pic_buf->parse_done, 0);
+    return parse_done != DEC_PIC_FAILED;
+}
+
+/* Wait till the luma rows above rows of the picture are final for reference.
+   Returns FALSE if the picture failed to decode */
+Bool dec_pic_wait_rows(EbDecPicBuf *ps_pic_buf, int32_t rows) {
+    int32_t rows_done;
+    while ((rows_done = svt_get_cond_var(&ps_pic_buf->rows_done)) < rows &&
+           rows_done != DEC_PIC_FAILED)
+        svt_wait_cond_var(&ps_pic_buf->rows_done, rows_done);
+    return rows_done != DEC_PIC_FAILED;
+}
+
+/* The picture will not be decoded : wake up the frames waiting for it */
+void dec_pic_set_failed(EbDecPicBuf *ps_pic_buf) {
+    svt_set_cond_var(&ps_pic_buf->parse_done, DEC_PIC_FAILED);
+    svt_set_cond_var(&ps_pic_buf->rows_done, DEC_PIC_FAILED);
+}
+
+/* Give all the external planes back to the application allocator */
+void dec_pic_mgr_release_ext_bufs(EbDecHandle *dec_handle_ptr) {
+    if (dec_handle_ptr->dec_config.release_frame_buffer == NULL)
+        return;
+    for (EbDecPicMgr *ps_pic_mgr = (EbDecPicMgr *)dec_handle_ptr->pv_pic_mgr; ps_pic_mgr != NULL;
+         ps_pic_mgr              = ps_pic_mgr->prev_pic_mgr) {
+        for (int32_t i = 0; i < MAX_PIC_BUFS; i++) {
+            release_ext_frame_buf(&dec_handle_ptr->dec_config,
+                                  &ps_pic_mgr->as_dec_pic[i].ext_frame_buf);
+            release_ext_frame_buf(&dec_handle_ptr->dec_config,
+                                  &ps_pic_mgr->as_dec_pic[i].ext_out_buf);
+        }
+    }
+}
+
 /**
 *******************************************************************************
 *
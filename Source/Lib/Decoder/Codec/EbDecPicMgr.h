@@ -24,6 +24,9 @@ typedef struct EbDecPicMgr {
     /* number of picture buffers */
     uint8_t num_pic_bufs;
 
+    /* Manager replaced on a new sequence, its pictures may still be in use */
+    struct EbDecPicMgr *prev_pic_mgr;
+
 } EbDecPicMgr;
 
 typedef struct RefFrameInfo {
@@ -37,6 +40,14 @@ EbErrorType dec_pic_mgr_init(EbDecHandle *dec_handle_ptr);
 
 EbDecPicBuf *dec_pic_mgr_get_cur_pic(EbDecHandle *dec_handle_ptr);
 
+void dec_pic_mgr_release_pic(EbDecPicBuf *ps_pic_buf);
+
+Bool dec_pic_wait_parse(EbDecPicBuf *ps_pic_buf);
+Bool dec_pic_wait_rows(EbDecPicBuf *ps_pic_buf, int32_t rows);
+void dec_pic_set_failed(EbDecPicBuf *ps_pic_buf);
+
+void dec_pic_mgr_release_ext_bufs(EbDecHandle *dec_handle_ptr);
+
 void dec_pic_mgr_update_ref_pic(EbDecHandle *dec_handle_ptr, int32_t frame_decoded,
                                 int32_t refresh_frame_flags);
 
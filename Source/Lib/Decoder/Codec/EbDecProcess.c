@@ -34,6 +34,8 @@
 #include "EbTime.h"
 
 #include "EbDecInverseQuantize.h"
+#include "EbDecPicMgr.h"
+#include "EbDecUtils.h"
 #include "EbLog.h"
 
 #include "EbUtility.h"
@@ -49,6 +51,8 @@ extern Bool         alternate_groups;
 extern cpu_set_t group_affinity;
 #endif
 void *dec_all_stage_kernel(void *input_ptr);
+void  decode_frame_mt(EbDecHandle *dec_handle_ptr);
+void  dec_setup_frame_ctxt(EbDecHandle *dec_handle_ptr);
 /*ToDo : Remove all these replications */
 void svt_av1_loop_filter_frame_init(FrameHeader *frm_hdr, LoopFilterInfoN *lfi, int32_t plane_start,
                                     int32_t plane_end);
@@ -124,6 +128,243 @@ int32_t get_sb_row_to_process(DecMtRowInfo *sb_row_info) {
     return sb_row_to_process;
 }
 
+/* Allocates the MT buffers the current frame needs when the allocated ones
+   are too small. The row buffers are sized for the maximum frame size of the
+   sequence with 64x64 SBs, so the buffers only grow with the sequence and
+   with the number of tiles. The replaced buffers stay in the memory map. */
+static EbErrorType dec_mt_frame_data_alloc(EbDecHandle *dec_handle_ptr, TilesInfo *tiles_info) {
+    DecMtFrameData *dec_mt_frame_data =
+        &dec_handle_ptr->main_frame_buf.cur_frame_bufs[0].dec_mt_frame_data;
+    SeqHeader *seq_header = &dec_handle_ptr->seq_header;
+
+    int32_t num_tiles = tiles_info->tile_cols * tiles_info->tile_rows;
+    int32_t sb_rows   = (seq_header->max_frame_height + (1 << MIN_SB_SIZE_LOG2) - 1) >>
+        MIN_SB_SIZE_LOG2;
+
+    /* Recon */
+    if (sb_rows > dec_mt_frame_data->alloc_sb_rows ||
+        tiles_info->tile_cols > dec_mt_frame_data->alloc_tile_cols) {
+        int32_t tile_cols = MAX(tiles_info->tile_cols, dec_mt_frame_data->alloc_tile_cols);
+        EB_MALLOC_DEC(dec_handle_ptr->mem_map,
+                      uint32_t *,
+                      dec_mt_frame_data->sb_recon_row_map,
+                      MAX(sb_rows, dec_mt_frame_data->alloc_sb_rows) * tile_cols *
+                          sizeof(uint32_t),
+                      EB_N_PTR);
+        dec_mt_frame_data->alloc_tile_cols = tile_cols;
+    }
+
+    /* recon top right sync */
+    if (num_tiles > dec_mt_frame_data->alloc_num_tiles) {
+        DecMtParseReconTileInfo *parse_recon_tile_info_array;
+        EB_MALLOC_DEC(dec_handle_ptr->mem_map,
+                      DecMtParseReconTileInfo *,
+                      parse_recon_tile_info_array,
+                      num_tiles * sizeof(DecMtParseReconTileInfo),
+                      EB_N_PTR);
+        /* The mutexes of the existing tiles are kept */
+        for (int32_t tiles_ctr = 0; tiles_ctr < num_tiles; tiles_ctr++) {
+            if (tiles_ctr < dec_mt_frame_data->alloc_num_tiles)
+                parse_recon_tile_info_array[tiles_ctr].tile_sbrow_mutex =
+                    dec_mt_frame_data->parse_recon_tile_info_array[tiles_ctr].tile_sbrow_mutex;
+            else
+                EB_CREATE_MUTEX(parse_recon_tile_info_array[tiles_ctr].tile_sbrow_mutex);
+        }
+        dec_mt_frame_data->parse_recon_tile_info_array = parse_recon_tile_info_array;
+    }
+    if (sb_rows > dec_mt_frame_data->alloc_sb_rows ||
+        num_tiles > dec_mt_frame_data->alloc_num_tiles) {
+        num_tiles = MAX(num_tiles, dec_mt_frame_data->alloc_num_tiles);
+        /* sb_recon_row_parsed, sb_recon_completed_in_row and
+           sb_recon_row_started of every tile */
+        EB_MALLOC_DEC(dec_handle_ptr->mem_map,
+                      uint32_t *,
+                      dec_mt_frame_data->tile_sb_row_buf,
+                      3 * num_tiles * MAX(sb_rows, dec_mt_frame_data->alloc_sb_rows) *
+                          sizeof(uint32_t),
+                      EB_N_PTR);
+        dec_mt_frame_data->alloc_num_tiles = num_tiles;
+    }
+
+    if (sb_rows > dec_mt_frame_data->alloc_sb_rows) {
+        /* LF */
+        EB_MALLOC_DEC(dec_handle_ptr->mem_map,
+                      int32_t *,
+                      dec_mt_frame_data->lf_frame_info.sb_lf_completed_in_row,
+                      sb_rows * sizeof(int32_t),
+                      EB_N_PTR);
+        EB_MALLOC_DEC(dec_handle_ptr->mem_map,
+                      uint32_t *,
+                      dec_mt_frame_data->lf_row_map,
+                      sb_rows * sizeof(uint32_t),
+                      EB_N_PTR);
+        /* CDEF */
+        EB_MALLOC_DEC(dec_handle_ptr->mem_map,
+                      uint32_t *,
+                      dec_mt_frame_data->cdef_completed_for_row_map,
+                      sb_rows * sizeof(uint32_t),
+                      EB_N_PTR);
+        /* LR */
+        EB_MALLOC_DEC(dec_handle_ptr->mem_map,
+                      int32_t *,
+                      dec_mt_frame_data->sb_lr_completed_in_row,
+                      sb_rows * sizeof(int32_t),
+                      EB_N_PTR);
+        EB_MALLOC_DEC(dec_handle_ptr->mem_map,
+                      uint32_t *,
+                      dec_mt_frame_data->lr_row_map,
+                      sb_rows * sizeof(uint32_t),
+                      EB_N_PTR);
+        dec_mt_frame_data->alloc_sb_rows = sb_rows;
+    }
+
+    /* CDEF */
+    const int32_t num_planes = av1_num_planes(&seq_header->color_config);
+    uint32_t      mi_cols    = 2 * ((seq_header->max_frame_width + 7) >> 3);
+
+    const int32_t nhfb = (mi_cols + MI_SIZE_64X64 - 1) / MI_SIZE_64X64;
+    const int32_t nvfb = (seq_header->max_frame_height + (MI_SIZE_64X64 << MI_SIZE_LOG2) - 1) /
+        (MI_SIZE_64X64 << MI_SIZE_LOG2);
+
+    const int32_t stride = (mi_cols << MI_SIZE_LOG2) + 2 * CDEF_HBORDER;
+    if (nvfb > dec_mt_frame_data->alloc_cdef_rows ||
+        stride > dec_mt_frame_data->cdef_linebuf_stride ||
+        num_planes > dec_mt_frame_data->alloc_num_planes) {
+        dec_mt_frame_data->cdef_linebuf_stride = stride;
+
+        /*ToDo: Linebuff memory we can allocate min(sb_rows , threads)*/
+        /*Currently we r allocating for every (64x64 +1 )rows*/
+        EB_MALLOC_DEC(dec_handle_ptr->mem_map,
+                      uint16_t ***,
+                      dec_mt_frame_data->cdef_linebuf,
+                      (nvfb + 1) * sizeof(uint16_t **),
+                      EB_N_PTR);
+        for (int32_t sb_row = 0; sb_row < (nvfb + 1); sb_row++) {
+            uint16_t **p_linebuf;
+            EB_MALLOC_DEC(dec_handle_ptr->mem_map,
+                          uint16_t **,
+                          dec_mt_frame_data->cdef_linebuf[sb_row],
+                          num_planes * sizeof(uint16_t **),
+                          EB_N_PTR);
+            p_linebuf = dec_mt_frame_data->cdef_linebuf[sb_row];
+            for (int32_t pli = 0; pli < num_planes; pli++) {
+                EB_MALLOC_DEC(dec_handle_ptr->mem_map,
+                              uint16_t *,
+                              p_linebuf[pli],
+                              sizeof(uint16_t) * CDEF_VBORDER * stride,
+                              EB_N_PTR);
+            }
+        }
+
+        dec_mt_frame_data->cdef_map_stride = nhfb + 2;
+        /*For fbr=0, previous row cdef points some junk memory, if we allocate memory only for nvfb 64x64 blocks,
+        to avoid to pointing junck memory, we allocate nvfb+1 64x64 blocks*/
+        EB_MALLOC_DEC(dec_handle_ptr->mem_map,
+                      uint8_t *,
+                      dec_mt_frame_data->row_cdef_map,
+                      (nvfb + 1) * dec_mt_frame_data->cdef_map_stride * sizeof(uint8_t),
+                      EB_N_PTR);
+        memset(dec_mt_frame_data->row_cdef_map,
+               1,
+               (nvfb + 1) * dec_mt_frame_data->cdef_map_stride * sizeof(uint8_t));
+
+        EB_MALLOC_DEC(dec_handle_ptr->mem_map,
+                      uint32_t *,
+                      dec_mt_frame_data->cdef_completed_in_row,
+                      (nvfb + 2) * sizeof(uint32_t),
+                      EB_N_PTR);
+
+        memset(dec_mt_frame_data->cdef_completed_in_row,
+               0,
+               (nvfb + 2) * //Rem here nhbf+2 u replaced with nvfb + 2
+                   sizeof(uint32_t));
+        dec_mt_frame_data->alloc_cdef_rows  = nvfb;
+        dec_mt_frame_data->alloc_num_planes = num_planes;
+    }
+    return EB_ErrorNone;
+}
+
+/* Sets the MT state for the frame size and the tile layout of the current frame */
+static void dec_mt_frame_data_setup(EbDecHandle *dec_handle_ptr, TilesInfo *tiles_info) {
+    DecMtFrameData *dec_mt_frame_data =
+        &dec_handle_ptr->main_frame_buf.cur_frame_bufs[0].dec_mt_frame_data;
+
+    int32_t num_tiles = tiles_info->tile_cols * tiles_info->tile_rows;
+
+    int32_t  sb_size_h            = block_size_high[dec_handle_ptr->seq_header.sb_size];
+    uint32_t picture_height_in_sb = (dec_handle_ptr->frame_header.frame_size.frame_height +
+                                     sb_size_h - 1) /
+        sb_size_h;
+
+    /* Motion Filed Projection*/
+    dec_mt_frame_data->motion_proj_info.num_motion_proj_rows = -1;
+
+    /* Parse */
+    dec_mt_frame_data->parse_tile_info.num_sb_rows       = num_tiles;
+    dec_mt_frame_data->parse_tile_info.sb_row_to_process = 0;
+
+    /* Recon */
+    dec_mt_frame_data->recon_tile_info.num_sb_rows       = num_tiles;
+    dec_mt_frame_data->recon_tile_info.sb_row_to_process = 0;
+
+    uint32_t *tile_sb_row_buf = dec_mt_frame_data->tile_sb_row_buf;
+    for (int32_t tiles_ctr = 0; tiles_ctr < num_tiles; tiles_ctr++) {
+        DecMtParseReconTileInfo *parse_recon_tile_info =
+            &dec_mt_frame_data->parse_recon_tile_info_array[tiles_ctr];
+        int32_t   tile_row  = tiles_ctr / tiles_info->tile_cols;
+        int32_t   tile_col  = tiles_ctr % tiles_info->tile_cols;
+        TileInfo *tile_info = &parse_recon_tile_info->tile_info;
+
+        /* init tile info */
+        svt_tile_init(tile_info, &dec_handle_ptr->frame_header, tile_row, tile_col);
+
+        parse_recon_tile_info->tile_num_sb_rows =
+            ((((tile_info->mi_row_end - 1) << MI_SIZE_LOG2) >>
+              dec_handle_ptr->seq_header.sb_size_log2) -
+             ((tile_info->mi_row_start << MI_SIZE_LOG2) >>
+              dec_handle_ptr->seq_header.sb_size_log2) +
+             1);
+
+        parse_recon_tile_info->sb_recon_row_parsed = tile_sb_row_buf;
+        tile_sb_row_buf += dec_mt_frame_data->alloc_sb_rows;
+        parse_recon_tile_info->sb_recon_completed_in_row = tile_sb_row_buf;
+        tile_sb_row_buf += dec_mt_frame_data->alloc_sb_rows;
+        parse_recon_tile_info->sb_recon_row_started = tile_sb_row_buf;
+        tile_sb_row_buf += dec_mt_frame_data->alloc_sb_rows;
+    }
+
+    /* LF */
+    dec_mt_frame_data->lf_frame_info.lf_sb_row_info.num_sb_rows       = picture_height_in_sb;
+    dec_mt_frame_data->lf_frame_info.lf_sb_row_info.sb_row_to_process = 0;
+
+    /* CDEF */
+    dec_mt_frame_data->cdef_sb_row_info.num_sb_rows       = picture_height_in_sb;
+    dec_mt_frame_data->cdef_sb_row_info.sb_row_to_process = 0;
+
+    /* LR */
+    dec_mt_frame_data->lr_sb_row_info.num_sb_rows       = picture_height_in_sb;
+    dec_mt_frame_data->lr_sb_row_info.sb_row_to_process = 0;
+}
+
+/* Module contexts of the library threads. They depend on the sequence only,
+   so they are created again when the handle got a new module context */
+static EbErrorType dec_thread_mod_ctxt_init(EbDecHandle *dec_handle_ptr) {
+    EbErrorType     return_error = EB_ErrorNone;
+    DecMtFrameData *dec_mt_frame_data =
+        &dec_handle_ptr->main_frame_buf.cur_frame_bufs[0].dec_mt_frame_data;
+
+    if (dec_mt_frame_data->thread_mod_ctxt_src == dec_handle_ptr->pv_dec_mod_ctxt)
+        return EB_ErrorNone;
+
+    uint32_t num_lib_threads = dec_handle_ptr->dec_config.threads - 1;
+    for (uint32_t i = 0; i < num_lib_threads; i++) {
+        return_error |= init_dec_mod_ctxt(dec_handle_ptr,
+                                          &dec_handle_ptr->thread_ctxt_pa[i].dec_mod_ctxt);
+    }
+    dec_mt_frame_data->thread_mod_ctxt_src = dec_handle_ptr->pv_dec_mod_ctxt;
+    return return_error;
+}
+
 /************************************
 * System Resource Managers & Fifos
 ************************************/
@@ -132,11 +373,8 @@ EbErrorType dec_system_resource_init(EbDecHandle *dec_handle_ptr, TilesInfo *til
     DecMtFrameData *dec_mt_frame_data =
         &dec_handle_ptr->main_frame_buf.cur_frame_bufs[0].dec_mt_frame_data;
 
-    memory_map_start_address = svt_dec_memory_map;
     memset(&dec_mt_frame_data->prev_frame_info, 0, sizeof(PrevFrameMtCheck));
 
-    int32_t num_tiles = tiles_info->tile_cols * tiles_info->tile_rows;
-
     assert(dec_handle_ptr->dec_config.threads > 1);
 #if MT_WAIT_PROFILE
     dec_mt_frame_data->fp = fopen("profile.txt", "w"); // stdout;
@@ -146,200 +384,49 @@ EbErrorType dec_system_resource_init(EbDecHandle *dec_handle_ptr, TilesInfo *til
     ************************************/
 
     /* Motion Filed Projection*/
-    dec_mt_frame_data->motion_proj_info.num_motion_proj_rows = -1;
     EB_CREATE_MUTEX(dec_mt_frame_data->motion_proj_info.motion_proj_mutex);
 
-    int32_t  sb_size_h            = block_size_high[dec_handle_ptr->seq_header.sb_size];
-    uint32_t picture_height_in_sb = (dec_handle_ptr->frame_header.frame_size.frame_height +
-                                     sb_size_h - 1) /
-        sb_size_h;
-
     /************************************
     * Contexts
     ************************************/
     /* Parse */
-    DecMtRowInfo *parse_tile_info = &dec_mt_frame_data->parse_tile_info;
-
-    EB_CREATE_MUTEX(parse_tile_info->sbrow_mutex);
-    parse_tile_info->num_sb_rows       = num_tiles;
-    parse_tile_info->sb_row_to_process = 0;
+    EB_CREATE_MUTEX(dec_mt_frame_data->parse_tile_info.sbrow_mutex);
 
     /* Recon */
-    EB_MALLOC_DEC(uint32_t *,
-                  dec_mt_frame_data->sb_recon_row_map,
-                  picture_height_in_sb * tiles_info->tile_cols * sizeof(uint32_t),
-                  EB_N_PTR);
-
-    DecMtRowInfo *recon_tile_info = &dec_mt_frame_data->recon_tile_info;
-    EB_CREATE_MUTEX(recon_tile_info->sbrow_mutex);
-
-    recon_tile_info->num_sb_rows       = num_tiles;
-    recon_tile_info->sb_row_to_process = 0;
-    /* recon top right sync */
-    {
-        int32_t tiles_ctr;
-
-        EB_CREATE_MUTEX(dec_mt_frame_data->tile_switch_mutex);
-
-        EB_MALLOC_DEC(DecMtParseReconTileInfo *,
-                      dec_mt_frame_data->parse_recon_tile_info_array,
-                      num_tiles * sizeof(DecMtParseReconTileInfo),
-                      EB_N_PTR);
-
-        for (tiles_ctr = 0; tiles_ctr < num_tiles; tiles_ctr++) {
-            int32_t   tile_row = tiles_ctr / tiles_info->tile_cols;
-            int32_t   tile_col = tiles_ctr % tiles_info->tile_cols;
-            int32_t   tile_num_sb_rows;
-            TileInfo *tile_info;
-
-            tile_info = &dec_mt_frame_data->parse_recon_tile_info_array[tiles_ctr].tile_info;
-
-            /* init tile info */
-            svt_tile_init(tile_info, &dec_handle_ptr->frame_header, tile_row, tile_col);
-
-            tile_num_sb_rows = ((((tile_info->mi_row_end - 1) << MI_SIZE_LOG2) >>
-                                 dec_handle_ptr->seq_header.sb_size_log2) -
-                                ((tile_info->mi_row_start << MI_SIZE_LOG2) >>
-                                 dec_handle_ptr->seq_header.sb_size_log2) +
-                                1);
-
-            dec_mt_frame_data->parse_recon_tile_info_array[tiles_ctr].tile_num_sb_rows =
-                tile_num_sb_rows;
-
-            EB_MALLOC_DEC(
-                uint32_t *,
-                dec_mt_frame_data->parse_recon_tile_info_array[tiles_ctr].sb_recon_row_parsed,
-                tile_num_sb_rows * sizeof(uint32_t),
-                EB_N_PTR);
-
-            EB_MALLOC_DEC(
-                uint32_t *,
-                dec_mt_frame_data->parse_recon_tile_info_array[tiles_ctr].sb_recon_completed_in_row,
-                tile_num_sb_rows * sizeof(uint32_t),
-                EB_N_PTR);
-
-            EB_MALLOC_DEC(
-                uint32_t *,
-                dec_mt_frame_data->parse_recon_tile_info_array[tiles_ctr].sb_recon_row_started,
-                tile_num_sb_rows * sizeof(uint32_t),
-                EB_N_PTR);
-
-            EB_CREATE_MUTEX(
-                dec_mt_frame_data->parse_recon_tile_info_array[tiles_ctr].tile_sbrow_mutex);
-
-            /* SB row queue */
-            //EB_NEW(dec_mt_frame_data->parse_recon_tile_info_array[tiles_ctr].recon_tile_sbrow_resource_ptr,
-            //    svt_system_resource_ctor,
-            //    tile_num_sb_rows, /* object_total_count */
-            //    1, /* producer procs cnt : 1 Q per cnt is created inside, so kept 1*/
-            //    1, /* consumer prcos cnt : 1 Q per cnt is created inside, so kept 1*/
-            //    &dec_mt_frame_data->parse_recon_tile_info_array[tiles_ctr].recon_tile_sbrow_producer_fifo_ptr, /* producer_fifo */
-            //    &dec_mt_frame_data->parse_recon_tile_info_array[tiles_ctr].recon_tile_sbrow_consumer_fifo_ptr, /* consumer_fifo */
-            //    TRUE, /* Full Queue*/
-            //    dec_dummy_creator, // Removed in "dec_dummy_creator: unusedFunction"
-            //    &node_idx,
-            //    NULL);
-        }
-    }
+    EB_CREATE_MUTEX(dec_mt_frame_data->recon_tile_info.sbrow_mutex);
+    EB_CREATE_MUTEX(dec_mt_frame_data->tile_switch_mutex);
 
     /* LF */
-    EB_MALLOC_DEC(int32_t *,
-                  dec_mt_frame_data->lf_frame_info.sb_lf_completed_in_row,
-                  picture_height_in_sb * sizeof(int32_t),
-                  EB_N_PTR);
-
-    EB_MALLOC_DEC(uint32_t *,
-                  dec_mt_frame_data->lf_row_map,
-                  picture_height_in_sb * sizeof(uint32_t),
-                  EB_N_PTR);
-
-    DecMtRowInfo *lf_sb_row_info = &dec_mt_frame_data->lf_frame_info.lf_sb_row_info;
-
-    EB_CREATE_MUTEX(lf_sb_row_info->sbrow_mutex);
-    lf_sb_row_info->num_sb_rows       = picture_height_in_sb;
-    lf_sb_row_info->sb_row_to_process = 0;
+    EB_CREATE_MUTEX(dec_mt_frame_data->lf_frame_info.lf_sb_row_info.sbrow_mutex);
 
     /* CDEF */
-    const int32_t num_planes = av1_num_planes(&dec_handle_ptr->seq_header.color_config);
-    uint32_t      mi_cols    = 2 * ((dec_handle_ptr->seq_header.max_frame_width + 7) >> 3);
+    EB_CREATE_MUTEX(dec_mt_frame_data->cdef_sb_row_info.sbrow_mutex);
 
-    const int32_t nhfb = (mi_cols + MI_SIZE_64X64 - 1) / MI_SIZE_64X64;
-    const int32_t nvfb = (dec_handle_ptr->seq_header.max_frame_height +
-                          (MI_SIZE_64X64 << MI_SIZE_LOG2) - 1) /
-        (MI_SIZE_64X64 << MI_SIZE_LOG2);
-
-    const int32_t stride                   = (mi_cols << MI_SIZE_LOG2) + 2 * CDEF_HBORDER;
-    dec_mt_frame_data->cdef_linebuf_stride = stride;
-
-    /*ToDo: Linebuff memory we can allocate min(sb_rows , threads)*/
-    /*Currently we r allocating for every (64x64 +1 )rows*/
-    EB_MALLOC_DEC(
-        uint16_t ***, dec_mt_frame_data->cdef_linebuf, (nvfb + 1) * sizeof(uint16_t **), EB_N_PTR);
-    for (int32_t sb_row = 0; sb_row < (nvfb + 1); sb_row++) {
-        uint16_t **p_linebuf;
-        EB_MALLOC_DEC(uint16_t **,
-                      dec_mt_frame_data->cdef_linebuf[sb_row],
-                      num_planes * sizeof(uint16_t **),
-                      EB_N_PTR);
-        p_linebuf = dec_mt_frame_data->cdef_linebuf[sb_row];
-        for (int32_t pli = 0; pli < num_planes; pli++) {
-            EB_MALLOC_DEC(
-                uint16_t *, p_linebuf[pli], sizeof(uint16_t) * CDEF_VBORDER * stride, EB_N_PTR);
-        }
-    }
-
-    dec_mt_frame_data->cdef_map_stride = nhfb + 2;
-    /*For fbr=0, previous row cdef points some junk memory, if we allocate memory only for nvfb 64x64 blocks,
-    to avoid to pointing junck memory, we allocate nvfb+1 64x64 blocks*/
-    EB_MALLOC_DEC(uint8_t *,
-                  dec_mt_frame_data->row_cdef_map,
-                  (nvfb + 1) * dec_mt_frame_data->cdef_map_stride * sizeof(uint8_t),
-                  EB_N_PTR);
-    memset(dec_mt_frame_data->row_cdef_map,
-           1,
-           (nvfb + 1) * dec_mt_frame_data->cdef_map_stride * sizeof(uint8_t));
-
-    EB_MALLOC_DEC(uint32_t *,
-                  dec_mt_frame_data->cdef_completed_in_row,
-                  (nvfb + 2) * sizeof(uint32_t),
-                  EB_N_PTR);
-
-    memset(dec_mt_frame_data->cdef_completed_in_row,
-           0,
-           (nvfb + 2) * //Rem here nhbf+2 u replaced with nvfb + 2
-               sizeof(uint32_t));
-
-    EB_MALLOC_DEC(uint32_t *,
-                  dec_mt_frame_data->cdef_completed_for_row_map,
-                  picture_height_in_sb * sizeof(uint32_t),
-                  EB_N_PTR);
-
-    DecMtRowInfo *cdef_sb_row_info = &dec_mt_frame_data->cdef_sb_row_info;
-
-    EB_CREATE_MUTEX(cdef_sb_row_info->sbrow_mutex);
-
-    cdef_sb_row_info->num_sb_rows       = picture_height_in_sb;
-    cdef_sb_row_info->sb_row_to_process = 0;
     /* LR */
-    EB_MALLOC_DEC(int32_t *,
-                  dec_mt_frame_data->sb_lr_completed_in_row,
-                  picture_height_in_sb * sizeof(int32_t),
-                  EB_N_PTR);
-
-    EB_MALLOC_DEC(uint32_t *,
-                  dec_mt_frame_data->lr_row_map,
-                  picture_height_in_sb * sizeof(uint32_t),
-                  EB_N_PTR);
-
-    DecMtRowInfo *lr_sb_row_info = &dec_mt_frame_data->lr_sb_row_info;
-
-    EB_CREATE_MUTEX(lr_sb_row_info->sbrow_mutex);
-
-    lr_sb_row_info->num_sb_rows       = picture_height_in_sb;
-    lr_sb_row_info->sb_row_to_process = 0;
+    EB_CREATE_MUTEX(dec_mt_frame_data->lr_sb_row_info.sbrow_mutex);
 
     dec_mt_frame_data->temp_mutex = svt_create_mutex();
 
+    /* Film Grain */
+    EB_CREATE_MUTEX(dec_mt_frame_data->film_grain_stripe_info.sbrow_mutex);
+    dec_mt_frame_data->film_grain_stripe_info.num_sb_rows       = 0;
+    dec_mt_frame_data->film_grain_stripe_info.sb_row_to_process = 0;
+    svt_create_cond_var(&dec_mt_frame_data->film_grain_stripes_done);
+    svt_create_cond_var(&dec_mt_frame_data->lib_threads_wake);
+
+    dec_mt_frame_data->alloc_sb_rows       = 0;
+    dec_mt_frame_data->alloc_tile_cols     = 0;
+    dec_mt_frame_data->alloc_num_tiles     = 0;
+    dec_mt_frame_data->alloc_cdef_rows     = 0;
+    dec_mt_frame_data->alloc_num_planes    = 0;
+    dec_mt_frame_data->cdef_linebuf_stride = 0;
+    dec_mt_frame_data->thread_mod_ctxt_src = NULL;
+
+    return_error = dec_mt_frame_data_alloc(dec_handle_ptr, tiles_info);
+    if (return_error != EB_ErrorNone)
+        return return_error;
+    dec_mt_frame_data_setup(dec_handle_ptr, tiles_info);
+
     dec_mt_frame_data->start_motion_proj  = FALSE;
     dec_mt_frame_data->start_parse_frame  = FALSE;
     dec_mt_frame_data->start_decode_frame = FALSE;
@@ -356,57 +443,53 @@ EbErrorType dec_system_resource_init(EbDecHandle *dec_handle_ptr, TilesInfo *til
     /* Decode Library Threads */
     uint32_t num_lib_threads = (int32_t)dec_handle_ptr->dec_config.threads - 1;
 
-    /* Use a scratch memory so that the memory allocated within
-       init_dec_mod_ctxt reallocated when required */
-
-    DecModCtxt **dec_mod_ctxt_arr;
-    EB_MALLOC_DEC(
-        DecModCtxt **, dec_mod_ctxt_arr, num_lib_threads * sizeof(DecModCtxt *), EB_N_PTR);
+    dec_mt_frame_data->end_flag           = FALSE;
+    dec_mt_frame_data->num_threads_exited = 0;
 
-    for (uint32_t i = 0; i < num_lib_threads; i++) {
-        init_dec_mod_ctxt(dec_handle_ptr, (void **)&dec_mod_ctxt_arr[i]);
-    }
+    if (num_lib_threads > 0) {
+        DecThreadCtxt *thread_ctxt_pa;
+        EB_MALLOC_DEC(dec_handle_ptr->mem_map,
+                      DecThreadCtxt *,
+                      thread_ctxt_pa,
+                      num_lib_threads * sizeof(DecThreadCtxt),
+                      EB_N_PTR);
+        dec_handle_ptr->thread_ctxt_pa = thread_ctxt_pa;
+        EB_CREATE_SEMAPHORE(dec_handle_ptr->thread_semaphore, 0, 100000);
 
-    memory_map_end_address = svt_dec_memory_map;
-
-    if (FALSE == dec_handle_ptr->start_thread_process) {
-        dec_mt_frame_data->end_flag           = FALSE;
-        dec_mt_frame_data->num_threads_exited = 0;
-
-        if (num_lib_threads > 0) {
-            DecThreadCtxt *thread_ctxt_pa;
-            EB_MALLOC_DEC(
-                DecThreadCtxt *, thread_ctxt_pa, num_lib_threads * sizeof(DecThreadCtxt), EB_N_PTR);
-            dec_handle_ptr->thread_ctxt_pa = thread_ctxt_pa;
-            EB_CREATE_SEMAPHORE(dec_handle_ptr->thread_semaphore, 0, 100000);
-
-            for (uint32_t i = 0; i < num_lib_threads; i++) {
-                thread_ctxt_pa[i].thread_cnt     = i + 1;
-                thread_ctxt_pa[i].dec_handle_ptr = dec_handle_ptr;
-                thread_ctxt_pa[i].dec_mod_ctxt   = dec_mod_ctxt_arr[i];
-                EB_CREATE_SEMAPHORE(thread_ctxt_pa[i].thread_semaphore, 0, 100000);
-                int use_highbd = (dec_handle_ptr->seq_header.color_config.bit_depth > EB_8BIT ||
-                                  dec_handle_ptr->is_16bit_pipeline);
-                EB_MALLOC_DEC(uint8_t *,
-                              thread_ctxt_pa[i].dst,
-                              (MAX_SB_SIZE + 8) * RESTORATION_PROC_UNIT_SIZE * sizeof(uint8_t)
-                                  << use_highbd,
-                              EB_N_PTR);
-            }
-            EB_CREATE_THREAD_ARRAY(dec_handle_ptr->decode_thread_handle_array,
-                                   num_lib_threads,
-                                   dec_all_stage_kernel,
-                                   (void **)&thread_ctxt_pa);
-        }
-    } else {
         for (uint32_t i = 0; i < num_lib_threads; i++) {
-            dec_handle_ptr->thread_ctxt_pa[i].dec_mod_ctxt = dec_mod_ctxt_arr[i];
+            thread_ctxt_pa[i].thread_cnt     = i + 1;
+            thread_ctxt_pa[i].dec_handle_ptr = dec_handle_ptr;
+            EB_CREATE_SEMAPHORE(thread_ctxt_pa[i].thread_semaphore, 0, 100000);
+            int use_highbd = (dec_handle_ptr->seq_header.color_config.bit_depth > EB_8BIT ||
+                              dec_handle_ptr->is_16bit_pipeline);
+            EB_MALLOC_DEC(dec_handle_ptr->mem_map,
+                          uint8_t *,
+                          thread_ctxt_pa[i].dst,
+                          (MAX_SB_SIZE + 8) * RESTORATION_PROC_UNIT_SIZE * sizeof(uint8_t)
+                              << use_highbd,
+                          EB_N_PTR);
         }
+        return_error = dec_thread_mod_ctxt_init(dec_handle_ptr);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+        EB_CREATE_THREAD_ARRAY(dec_handle_ptr->decode_thread_handle_array,
+                               num_lib_threads,
+                               dec_all_stage_kernel,
+                               (void **)&thread_ctxt_pa);
     }
-    free(dec_mod_ctxt_arr);
     return return_error;
 }
 
+/* Reconfigures the MT resources for a new frame size or tile layout, the
+   threads and the large enough buffers are kept */
+EbErrorType dec_system_resource_update(EbDecHandle *dec_handle_ptr, TilesInfo *tiles_info) {
+    EbErrorType return_error = dec_mt_frame_data_alloc(dec_handle_ptr, tiles_info);
+    if (return_error != EB_ErrorNone)
+        return return_error;
+    dec_mt_frame_data_setup(dec_handle_ptr, tiles_info);
+    return dec_thread_mod_ctxt_init(dec_handle_ptr);
+}
+
 /* Scan through the Tiles to find Bitstream offsets */
 void svt_av1_scan_tiles(EbDecHandle *dec_handle_ptr, TilesInfo *tiles_info, ObuHeader *obu_header,
                         Bitstrm *bs, uint32_t tg_start, uint32_t tg_end) {
@@ -447,6 +530,7 @@ void svt_av1_queue_parse_jobs(EbDecHandle *dec_handle_ptr, TilesInfo *tiles_info
 
     dec_mt_frame_data->parse_tile_info.sb_row_to_process = 0;
     dec_mt_frame_data->recon_tile_info.sb_row_to_process = 0;
+    dec_mt_frame_data->num_tiles_parsed                  = 0;
     //dec_handle_ptr->start_thread_process = TRUE;
 }
 
@@ -496,6 +580,13 @@ void parse_frame_tiles(EbDecHandle *dec_handle_ptr, DecThreadCtxt *thread_ctxt)
                 SVT_LOG("\nParse Issue for Tile %d", tile_num);
                 break;
             }
+            /* Symbols of the frame are final once all its tiles are parsed */
+            svt_block_on_mutex(dec_mt_frame_data->parse_tile_info.sbrow_mutex);
+            if (++dec_mt_frame_data->num_tiles_parsed ==
+                dec_handle_ptr->frame_header.tiles_info.tile_cols *
+                    dec_handle_ptr->frame_header.tiles_info.tile_rows)
+                svt_set_cond_var(&dec_handle_ptr->cur_pic_buf[0]->parse_done, 1);
+            svt_release_mutex(dec_mt_frame_data->parse_tile_info.sbrow_mutex);
             svt_post_semaphore(dec_handle_ptr->thread_semaphore);
             for (uint32_t lib_thrd = 0; lib_thrd < dec_handle_ptr->dec_config.threads - 1;
                  lib_thrd++) {
@@ -1146,6 +1237,27 @@ void pad_post_lr(EbPictureBufferDesc *recon_picture_buf, int32_t sb_row, int32_t
     }
 }
 
+/* Publish the luma rows of the current picture which are final for
+   reference. LR and padding of an SB row also touch the bottom lines of
+   the row above, so a row is final once the row below it is LR'd too. */
+static void dec_update_rows_done(EbDecHandle *dec_handle, DecMtFrameData *dec_mt_frame_data,
+                                 int32_t num_rows, int32_t sb_size_log2) {
+    EbDecPicBuf *cur_pic_buf = dec_handle->cur_pic_buf[0];
+    if (svt_get_cond_var(&cur_pic_buf->rows_done) == INT32_MAX)
+        return;
+
+    svt_block_on_mutex(dec_mt_frame_data->lr_sb_row_info.sbrow_mutex);
+    const int32_t rows_done = svt_get_cond_var(&cur_pic_buf->rows_done);
+    int32_t       sb_row    = rows_done >> sb_size_log2;
+    while (sb_row < num_rows && dec_mt_frame_data->lr_row_map[sb_row] &&
+           (sb_row == num_rows - 1 || dec_mt_frame_data->lr_row_map[sb_row + 1]))
+        sb_row++;
+    if (sb_row != rows_done >> sb_size_log2)
+        svt_set_cond_var(&cur_pic_buf->rows_done,
+                         sb_row == num_rows ? INT32_MAX : sb_row << sb_size_log2);
+    svt_release_mutex(dec_mt_frame_data->lr_sb_row_info.sbrow_mutex);
+}
+
 void dec_av1_loop_restoration_filter_frame_mt(EbDecHandle *dec_handle, DecThreadCtxt *thread_ctxt) {
     uint8_t *curr_blk_recon_buf[MAX_MB_PLANE];
     int32_t  curr_recon_stride[MAX_MB_PLANE];
@@ -1283,6 +1395,7 @@ void dec_av1_loop_restoration_filter_frame_mt(EbDecHandle *dec_handle, DecThread
 
             /* Update LR done map */
             dec_mt_frame_data->lr_row_map[sb_row] = 1;
+            dec_update_rows_done(dec_handle, dec_mt_frame_data, num_rows, sb_size_log2);
         } else
             break;
     }
@@ -1305,6 +1418,26 @@ void dec_av1_loop_restoration_filter_frame_mt(EbDecHandle *dec_handle, DecThread
         ;
 }
 
+/* Film grain of the output picture, one stripe at a time. The stripes are
+   queued by dec_add_film_grain, which waits till they are all done */
+void dec_film_grain_stripes(EbDecHandle *dec_handle_ptr) {
+    DecMtFrameData *dec_mt_frame_data =
+        &dec_handle_ptr->main_frame_buf.cur_frame_bufs[0].dec_mt_frame_data;
+    DecMtRowInfo *stripe_info = &dec_mt_frame_data->film_grain_stripe_info;
+
+    while (1) {
+        int32_t stripe = get_sb_row_to_process(stripe_info);
+        if (-1 == stripe)
+            break;
+        svt_av1_film_grain_add_stripes(&dec_handle_ptr->film_grain, stripe, stripe + 1);
+
+        svt_block_on_mutex(stripe_info->sbrow_mutex);
+        svt_set_cond_var(&dec_mt_frame_data->film_grain_stripes_done,
+                         svt_get_cond_var(&dec_mt_frame_data->film_grain_stripes_done) + 1);
+        svt_release_mutex(stripe_info->sbrow_mutex);
+    }
+}
+
 void *dec_all_stage_kernel(void *input_ptr) {
     // Context
     DecThreadCtxt  *thread_ctxt    = (DecThreadCtxt *)input_ptr;
@@ -1315,7 +1448,16 @@ void *dec_all_stage_kernel(void *input_ptr) {
     while (*start_thread == FALSE)
         ;
 
+    volatile Bool *start_motion_proj = &dec_mt_frame_data->start_motion_proj;
     while (1) {
+        /* Film grain of the output pictures till the next frame starts */
+        while (*start_motion_proj != TRUE) {
+            int32_t wake = svt_get_cond_var(&dec_mt_frame_data->lib_threads_wake);
+            if (*start_motion_proj == TRUE)
+                break;
+            dec_film_grain_stripes(dec_handle_ptr);
+            svt_wait_cond_var(&dec_mt_frame_data->lib_threads_wake, wake);
+        }
         /* Motion Field Projection */
         svt_setup_motion_field(dec_handle_ptr, thread_ctxt);
         /* Parse Tiles */
@@ -1367,6 +1509,28 @@ void dec_sync_all_threads(EbDecHandle *dec_handle_ptr) {
     dec_mt_frame_data->num_threads_header          = 1;
     dec_handle_ptr->frame_header.use_ref_frame_mvs = 0;
     dec_mt_frame_data->start_motion_proj           = TRUE;
+    svt_set_cond_var(&dec_mt_frame_data->lib_threads_wake,
+                     svt_get_cond_var(&dec_mt_frame_data->lib_threads_wake) + 1);
+
+    /* No jobs left : a frame slot whose frame failed before its
+       decode has the job queues of dec_mt_frame_data_setup */
+    int32_t num_tiles = dec_handle_ptr->frame_header.tiles_info.tile_cols *
+        dec_handle_ptr->frame_header.tiles_info.tile_rows;
+    for (int32_t tile_idx = 0; tile_idx < num_tiles; tile_idx++) {
+        DecMtParseReconTileInfo *tile_info =
+            &dec_mt_frame_data->parse_recon_tile_info_array[tile_idx];
+        tile_info->sb_row_to_process = tile_info->tile_num_sb_rows;
+    }
+    dec_mt_frame_data->parse_tile_info.sb_row_to_process =
+        dec_mt_frame_data->parse_tile_info.num_sb_rows;
+    dec_mt_frame_data->recon_tile_info.sb_row_to_process =
+        dec_mt_frame_data->recon_tile_info.num_sb_rows;
+    dec_mt_frame_data->lf_frame_info.lf_sb_row_info.sb_row_to_process =
+        dec_mt_frame_data->lf_frame_info.lf_sb_row_info.num_sb_rows;
+    dec_mt_frame_data->cdef_sb_row_info.sb_row_to_process =
+        dec_mt_frame_data->cdef_sb_row_info.num_sb_rows;
+    dec_mt_frame_data->lr_sb_row_info.sb_row_to_process =
+        dec_mt_frame_data->lr_sb_row_info.num_sb_rows;
 
     dec_mt_frame_data->start_parse_frame = TRUE;
     svt_post_semaphore(dec_handle_ptr->thread_semaphore);
@@ -1396,3 +1560,207 @@ void dec_sync_all_threads(EbDecHandle *dec_handle_ptr) {
     EB_DESTROY_THREAD_ARRAY(dec_handle_ptr->decode_thread_handle_array,
                             dec_handle_ptr->dec_config.threads - 1);
 }
+
+/* Wait till the frame in flight in the frame slot is decoded and
+   release the pictures it holds. An error is kept in the main handle
+   till it is returned to the application */
+void dec_wait_frame_slot(EbDecHandle *frame_slot) {
+    if (FALSE == frame_slot->frame_slot_busy)
+        return;
+    svt_block_on_semaphore(frame_slot->frame_done_semaphore);
+    frame_slot->frame_slot_busy = FALSE;
+
+    /* cur_pic_buf[0] is kept, the idle MT threads of the slot refer to it */
+    dec_pic_mgr_release_pic(frame_slot->cur_pic_buf[0]);
+    for (int32_t i = 0; i < REF_FRAMES; i++) {
+        dec_pic_mgr_release_pic(frame_slot->ref_frame_map[i]);
+        frame_slot->ref_frame_map[i] = NULL;
+    }
+    if (frame_slot->main_dec_handle->frame_error == EB_ErrorNone)
+        frame_slot->main_dec_handle->frame_error = frame_slot->frame_error;
+}
+
+/* Wait for all the frames in flight */
+void dec_retire_frame_slots(EbDecHandle *dec_handle_ptr) {
+    for (int32_t i = 0; i < DEC_MAX_NUM_FRM_PRLL; i++) {
+        if (dec_handle_ptr->frame_slots[i] != NULL)
+            dec_wait_frame_slot(dec_handle_ptr->frame_slots[i]);
+    }
+}
+
+/* Frame thread of a frame slot : decodes one frame at a time with the
+   MT resources of the slot */
+static void *dec_frame_slot_kernel(void *input_ptr) {
+    EbDecHandle   *frame_slot      = (EbDecHandle *)input_ptr;
+    MainParseCtxt *main_parse_ctxt = (MainParseCtxt *)frame_slot->pv_main_parse_ctxt;
+
+    while (1) {
+        svt_block_on_semaphore(frame_slot->frame_start_semaphore);
+        if (TRUE == frame_slot->frame_slot_exit)
+            break;
+        main_parse_ctxt = (MainParseCtxt *)frame_slot->pv_main_parse_ctxt;
+
+        /* Motion field projection, segment ids and CDFs of the frame
+           come from the symbols of the reference frames */
+        Bool refs_ok = TRUE;
+        for (MvReferenceFrame ref_frame = LAST_FRAME; ref_frame <= ALTREF_FRAME; ++ref_frame) {
+            EbDecPicBuf *ref_buf = get_ref_frame_buf(frame_slot, ref_frame);
+            if (ref_buf != NULL && !dec_pic_wait_parse(ref_buf))
+                refs_ok = FALSE;
+        }
+        if (frame_slot->frame_header.primary_ref_frame != PRIMARY_REF_NONE) {
+            if (dec_pic_wait_parse(frame_slot->prev_frame))
+                /* Load CDF */
+                main_parse_ctxt->init_frm_ctx = frame_slot->prev_frame->final_frm_ctx;
+            else
+                refs_ok = FALSE;
+        }
+
+        /* A frame predicted from a failed frame fails too */
+        if (refs_ok)
+            decode_frame_mt(frame_slot);
+        for (MvReferenceFrame ref_frame = LAST_FRAME; ref_frame <= ALTREF_FRAME; ++ref_frame) {
+            EbDecPicBuf *ref_buf = get_ref_frame_buf(frame_slot, ref_frame);
+            if (ref_buf != NULL && svt_get_cond_var(&ref_buf->rows_done) == DEC_PIC_FAILED)
+                refs_ok = FALSE;
+        }
+
+        if (refs_ok) {
+            frame_slot->frame_error = EB_ErrorNone;
+            svt_set_cond_var(&frame_slot->cur_pic_buf[0]->parse_done, 1);
+            svt_set_cond_var(&frame_slot->cur_pic_buf[0]->rows_done, INT32_MAX);
+        } else {
+            frame_slot->frame_error = EB_Corrupt_Frame;
+            dec_pic_set_failed(frame_slot->cur_pic_buf[0]);
+        }
+        svt_post_semaphore(frame_slot->frame_done_semaphore);
+    }
+    return NULL;
+}
+
+/* Copy the frame level state of the current frame to the frame slot.
+   The pictures are only held once the slot is started. */
+static EbErrorType dec_setup_frame_slot(EbDecHandle *dec_handle_ptr, EbDecHandle *frame_slot) {
+    EbErrorType return_error = EB_ErrorNone;
+
+    MainParseCtxt *main_parse_ctxt = (MainParseCtxt *)dec_handle_ptr->pv_main_parse_ctxt;
+    TilesInfo     *tiles_info      = &dec_handle_ptr->frame_header.tiles_info;
+    int32_t        num_tiles       = tiles_info->tile_cols * tiles_info->tile_rows;
+    ParseTileData *tile_data       = main_parse_ctxt->parse_tile_data;
+    /* The tile parse of the MT path can not report an error */
+    for (int32_t i = 0; i < num_tiles; i++) {
+        if (!read_is_valid(tile_data[i].data, tile_data[i].tile_size, tile_data[i].data_end))
+            return EB_Corrupt_Frame;
+    }
+
+    frame_slot->seq_header    = dec_handle_ptr->seq_header;
+    frame_slot->frame_header  = dec_handle_ptr->frame_header;
+    frame_slot->cm            = dec_handle_ptr->cm;
+    frame_slot->is_lf_enabled = dec_handle_ptr->is_lf_enabled;
+    frame_slot->sf_identity   = dec_handle_ptr->sf_identity;
+    frame_slot->prev_frame    = dec_handle_ptr->prev_frame;
+    svt_memcpy(frame_slot->remapped_ref_idx,
+               dec_handle_ptr->remapped_ref_idx,
+               sizeof(dec_handle_ptr->remapped_ref_idx));
+    svt_memcpy(frame_slot->ref_scale_factors,
+               dec_handle_ptr->ref_scale_factors,
+               sizeof(dec_handle_ptr->ref_scale_factors));
+    svt_memcpy(frame_slot->main_frame_buf.cur_frame_bufs[0].global_motion_warp,
+               dec_handle_ptr->main_frame_buf.cur_frame_bufs[0].global_motion_warp,
+               sizeof(dec_handle_ptr->main_frame_buf.cur_frame_bufs[0].global_motion_warp));
+
+    frame_slot->cur_pic_buf[0] = dec_handle_ptr->cur_pic_buf[0];
+    for (int32_t i = 0; i < REF_FRAMES; i++)
+        frame_slot->ref_frame_map[i] = dec_handle_ptr->ref_frame_map[i];
+
+    MainParseCtxt *slot_parse_ctxt = (MainParseCtxt *)frame_slot->pv_main_parse_ctxt;
+    if (dec_handle_ptr->frame_header.primary_ref_frame == PRIMARY_REF_NONE)
+        slot_parse_ctxt->init_frm_ctx = main_parse_ctxt->init_frm_ctx;
+
+    setup_segmentation_dequant((DecModCtxt *)frame_slot->pv_dec_mod_ctxt);
+    /*Temporal MVs allocation */
+    return_error = check_add_tplmv_buf(frame_slot);
+    if (return_error != EB_ErrorNone)
+        return return_error;
+    dec_setup_frame_ctxt(frame_slot);
+    slot_parse_ctxt = (MainParseCtxt *)frame_slot->pv_main_parse_ctxt;
+
+    /* The bitstream is owned by the application,
+       keep a copy of the tile data of the frame */
+    uint8_t *data_start = tile_data[0].data;
+    uint8_t *data_end   = tile_data[0].data_end;
+    for (int32_t i = 1; i < num_tiles; i++) {
+        data_start = MIN(data_start, tile_data[i].data);
+        data_end   = MAX(data_end, tile_data[i].data_end);
+    }
+    size_t data_size = data_end - data_start;
+    if (data_size > frame_slot->tile_data_buf_size) {
+        EB_MALLOC_DEC(frame_slot->mem_map, uint8_t *, frame_slot->tile_data_buf, data_size, EB_N_PTR);
+        frame_slot->tile_data_buf_size = data_size;
+    }
+    svt_memcpy(frame_slot->tile_data_buf, data_start, data_size);
+    for (int32_t i = 0; i < num_tiles; i++) {
+        slot_parse_ctxt->parse_tile_data[i].data = frame_slot->tile_data_buf +
+            (tile_data[i].data - data_start);
+        slot_parse_ctxt->parse_tile_data[i].data_end = frame_slot->tile_data_buf +
+            (tile_data[i].data_end - data_start);
+        slot_parse_ctxt->parse_tile_data[i].tile_size = tile_data[i].tile_size;
+    }
+
+    if (NULL == frame_slot->frame_thread_handle) {
+        EB_CREATE_SEMAPHORE(frame_slot->frame_start_semaphore, 0, 1);
+        EB_CREATE_SEMAPHORE(frame_slot->frame_done_semaphore, 0, 1);
+        EB_CREATE_THREAD(frame_slot->frame_thread_handle, dec_frame_slot_kernel, frame_slot);
+    }
+    return return_error;
+}
+
+/* Hand the current frame over to the next frame slot. The frame
+   level state is copied, so that the headers of the following
+   frames can be parsed while the frame is decoded. */
+EbErrorType dec_submit_frame(EbDecHandle *dec_handle_ptr) {
+    EbDecHandle *frame_slot = dec_handle_ptr->frame_slots[dec_handle_ptr->next_frame_slot];
+    dec_handle_ptr->next_frame_slot = (dec_handle_ptr->next_frame_slot + 1) %
+        dec_handle_ptr->num_frms_prll;
+
+    dec_wait_frame_slot(frame_slot);
+    EbErrorType return_error = dec_setup_frame_slot(dec_handle_ptr, frame_slot);
+    if (return_error != EB_ErrorNone) {
+        /* The frame still refreshes the references: the frames
+           predicted from it fail instead of waiting for it */
+        dec_pic_set_failed(dec_handle_ptr->cur_pic_buf[0]);
+        if (dec_handle_ptr->frame_error == EB_ErrorNone)
+            dec_handle_ptr->frame_error = return_error;
+        return EB_ErrorNone;
+    }
+
+    /* The current and the reference pictures are held till the frame is decoded */
+    ++frame_slot->cur_pic_buf[0]->ref_count;
+    for (int32_t i = 0; i < REF_FRAMES; i++) {
+        if (frame_slot->ref_frame_map[i] != NULL)
+            ++frame_slot->ref_frame_map[i]->ref_count;
+    }
+    frame_slot->frame_slot_busy = TRUE;
+    svt_post_semaphore(frame_slot->frame_start_semaphore);
+
+    return return_error;
+}
+
+/* Stop the frame threads and the MT resources of the frame slots */
+void dec_close_frame_slots(EbDecHandle *dec_handle_ptr) {
+    for (int32_t i = 0; i < DEC_MAX_NUM_FRM_PRLL; i++) {
+        EbDecHandle *frame_slot = dec_handle_ptr->frame_slots[i];
+        if (frame_slot == NULL)
+            continue;
+        dec_wait_frame_slot(frame_slot);
+        if (frame_slot->frame_thread_handle != NULL) {
+            frame_slot->frame_slot_exit = TRUE;
+            svt_post_semaphore(frame_slot->frame_start_semaphore);
+            EB_DESTROY_THREAD(frame_slot->frame_thread_handle);
+            EB_DESTROY_SEMAPHORE(frame_slot->frame_start_semaphore);
+            EB_DESTROY_SEMAPHORE(frame_slot->frame_done_semaphore);
+        }
+        if (frame_slot->start_thread_process)
+            dec_sync_all_threads(frame_slot);
+    }
+}
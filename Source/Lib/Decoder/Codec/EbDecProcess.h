@@ -17,6 +17,7 @@ extern "C" {
 #endif
 #include "EbDefinitions.h"
 #include "EbSystemResourceManager.h"
+#include "EbThreads.h"
 
 #define MT_WAIT_PROFILE 0
 
@@ -190,6 +191,8 @@ typedef struct DecMTFrameData {
 
     DecMtRowInfo parse_tile_info;
     DecMtRowInfo recon_tile_info;
+    /* Number of tiles parsed, protected by parse_tile_info.sbrow_mutex */
+    int32_t num_tiles_parsed;
 
     /* To prevent more than 1 thread from mod. recon_row_started simult. */
     EbHandle recon_mutex;
@@ -236,8 +239,34 @@ typedef struct DecMTFrameData {
     /* LR SB row level map for rows finished LR */
     uint32_t *lr_row_map;
 
+    /* Film grain of the output picture : one job per stripe, taken by the
+       application thread and the library threads waiting for a frame */
+    DecMtRowInfo film_grain_stripe_info;
+    /* Number of stripes done, updated under film_grain_stripe_info.sbrow_mutex */
+    CondVar film_grain_stripes_done;
+    /* Bumped to wake the library threads waiting for the next frame : for
+       the film grain stripes and at the frame start. Kept apart from the
+       thread semaphores of the frame stages */
+    CondVar lib_threads_wake;
+
     PrevFrameMtCheck prev_frame_info;
 
+    /* Allocated sizes of the buffers above, they only grow. The row buffers
+       are counted in 64x64 SB rows of the maximum frame height */
+    int32_t alloc_sb_rows;
+    int32_t alloc_tile_cols;
+    int32_t alloc_num_tiles;
+    int32_t alloc_cdef_rows;
+    int32_t alloc_num_planes;
+
+    /* Row state of all the tiles, shared out between the
+       parse_recon_tile_info_array entries */
+    uint32_t *tile_sb_row_buf;
+
+    /* Module context of the handle when the module contexts of the
+       library threads were created */
+    void *thread_mod_ctxt_src;
+
     int32_t sb_cols;
     int32_t sb_rows;
 
@@ -48,8 +48,12 @@ static void av1_upscale_normative_and_extend_frame(struct Av1Common *cm, FrameHe
     }
 }
 
-EbErrorType copy_recon(SeqHeader *seq_hdr, EbPictureBufferDesc *recon_picture_src,
-                       EbPictureBufferDesc *recon_picture_dst, int num_planes) {
+/* Copies the frame before the upscaling to the superres buffer of the handle,
+   which only grows with the frame size and is reused by the next frames */
+static EbErrorType copy_recon(EbDecHandle *dec_handle_ptr, EbPictureBufferDesc *recon_picture_src,
+                              EbPictureBufferDesc *recon_picture_dst, int num_planes) {
+    SeqHeader *seq_hdr = &dec_handle_ptr->seq_header;
+
     recon_picture_dst->origin_x     = recon_picture_src->origin_x;
     recon_picture_dst->origin_y     = recon_picture_src->origin_y;
     recon_picture_dst->width        = recon_picture_src->width;
@@ -81,31 +85,27 @@ EbErrorType copy_recon(SeqHeader *seq_hdr, EbPictureBufferDesc *recon_picture_sr
                     ? 2
                     : 1;
 
-    // Allocate the Picture Buffers (luma & chroma)
-    if (recon_picture_dst->buffer_enable_mask & PICTURE_BUFFER_DESC_Y_FLAG) {
-        EB_ALLIGN_MALLOC_DEC(EbByte,
-                             recon_picture_dst->buffer_y,
-                             recon_picture_dst->luma_size * bytes_per_pixel,
-                             EB_A_PTR);
-        memset(recon_picture_dst->buffer_y, 0, recon_picture_dst->luma_size * bytes_per_pixel);
-    } else
-        recon_picture_dst->buffer_y = 0;
-    if (recon_picture_dst->buffer_enable_mask & PICTURE_BUFFER_DESC_Cb_FLAG) {
-        EB_ALLIGN_MALLOC_DEC(EbByte,
-                             recon_picture_dst->buffer_cb,
-                             recon_picture_dst->chroma_size * bytes_per_pixel,
-                             EB_A_PTR);
-        memset(recon_picture_dst->buffer_cb, 0, recon_picture_dst->chroma_size * bytes_per_pixel);
-    } else
-        recon_picture_dst->buffer_cb = 0;
-    if (recon_picture_dst->buffer_enable_mask & PICTURE_BUFFER_DESC_Cr_FLAG) {
-        EB_ALLIGN_MALLOC_DEC(EbByte,
-                             recon_picture_dst->buffer_cr,
-                             recon_picture_dst->chroma_size * bytes_per_pixel,
-                             EB_A_PTR);
-        memset(recon_picture_dst->buffer_cr, 0, recon_picture_dst->chroma_size * bytes_per_pixel);
-    } else
-        recon_picture_dst->buffer_cr = 0;
+    const size_t luma_bytes = (recon_picture_dst->buffer_enable_mask & PICTURE_BUFFER_DESC_Y_FLAG)
+        ? ALIGN_POWER_OF_TWO((size_t)recon_picture_dst->luma_size * bytes_per_pixel, 6)
+        : 0;
+    const size_t chroma_bytes = (recon_picture_dst->buffer_enable_mask &
+                                 PICTURE_BUFFER_DESC_Cb_FLAG)
+        ? ALIGN_POWER_OF_TWO((size_t)recon_picture_dst->chroma_size * bytes_per_pixel, 6)
+        : 0;
+    const size_t total_bytes = luma_bytes + 2 * chroma_bytes;
+
+    // The old buffer stays in the memory map, it is released with the decoder
+    if (total_bytes > dec_handle_ptr->superres_buf_size) {
+        EB_ALLIGN_MALLOC_DEC(
+            dec_handle_ptr->mem_map, EbByte, dec_handle_ptr->superres_buf, total_bytes, EB_A_PTR);
+        dec_handle_ptr->superres_buf_size = total_bytes;
+    }
+
+    EbByte buf = dec_handle_ptr->superres_buf;
+    memset(buf, 0, total_bytes);
+    recon_picture_dst->buffer_y  = luma_bytes ? buf : NULL;
+    recon_picture_dst->buffer_cb = chroma_bytes ? buf + luma_bytes : NULL;
+    recon_picture_dst->buffer_cr = chroma_bytes ? buf + luma_bytes + chroma_bytes : NULL;
 
     int use_highbd = (seq_hdr->color_config.bit_depth > EB_8BIT ||
                       recon_picture_src->is_16bit_pipeline);
@@ -134,11 +134,14 @@ EbErrorType copy_recon(SeqHeader *seq_hdr, EbPictureBufferDesc *recon_picture_sr
     return EB_ErrorNone;
 }
 
-void svt_av1_superres_upscale(Av1Common *cm, FrameHeader *frm_hdr, SeqHeader *seq_hdr,
+void svt_av1_superres_upscale(EbDecHandle *dec_handle_ptr, FrameHeader *frm_hdr,
                               EbPictureBufferDesc *recon_picture_src, int enable_flag) {
     if (!enable_flag)
         return;
 
+    Av1Common *cm      = &dec_handle_ptr->cm;
+    SeqHeader *seq_hdr = &dec_handle_ptr->seq_header;
+
     const int num_planes = seq_hdr->color_config.mono_chrome ? 1 : MAX_MB_PLANE;
     if (av1_superres_unscaled(&frm_hdr->frame_size))
         return;
@@ -148,7 +151,7 @@ void svt_av1_superres_upscale(Av1Common *cm, FrameHeader *frm_hdr, SeqHeader *se
     ps_recon_pic_temp = &recon_pic_temp;
 
     EbErrorType return_error = copy_recon(
-        seq_hdr, recon_picture_src, ps_recon_pic_temp, num_planes);
+        dec_handle_ptr, recon_picture_src, ps_recon_pic_temp, num_planes);
 
     if (return_error != EB_ErrorNone) {
         ps_recon_pic_temp = NULL;
@@ -32,7 +32,8 @@ EbErrorType check_add_tplmv_buf(EbDecHandle *dec_handle_ptr) {
 
     if (realloc) {
         /*TODO: Add free now itself */
-        EB_MALLOC_DEC(TemporalMvRef *,
+        EB_MALLOC_DEC(dec_handle_ptr->mem_map,
+                      TemporalMvRef *,
                       dec_handle_ptr->main_frame_buf.tpl_mvs,
                       tpl_size * sizeof(*dec_handle_ptr->main_frame_buf.tpl_mvs),
                       EB_N_PTR);
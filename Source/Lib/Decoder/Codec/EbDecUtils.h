@@ -59,7 +59,7 @@ void pad_row(EbPictureBufferDesc *recon_picture_buf, EbByte buf_y, EbByte buf_cb
 
 int inverse_recenter(int r, int v);
 
-void svt_av1_superres_upscale(Av1Common *cm, FrameHeader *frm_hdr, SeqHeader *seq_hdr,
+void svt_av1_superres_upscale(EbDecHandle *dec_handle_ptr, FrameHeader *frm_hdr,
                               EbPictureBufferDesc *recon_picture_src, int enable_flag);
 
 static INLINE int is_interintra_allowed_bsize(const BlockSize bsize) {
@@ -4551,6 +4551,118 @@ void svt_aom_sad128x128x4d_avx2(const uint8_t *src, int src_stride, const uint8_
     res[3] = sum0[3] + sum1[3];
 }
 
+/* SADs of the 8x8 and 16x16 blocks of one 16x16 block at 8 horizontal positions, updates the
+ * best 8x8 and 16x16 results and returns the eight 16x16 SADs */
+static INLINE __m128i eight_sad_calculation_8x8_16x16_avx2(
+    const uint8_t *s, uint32_t src_stride, const uint8_t *r, uint32_t ref_stride, uint32_t mv,
+    uint8_t out_8x8, uint32_t start_16x16_pos, uint32_t *p_best_sad_8x8,
+    uint32_t *p_best_sad_16x16, uint32_t *p_best_mv8x8, uint32_t *p_best_mv16x16, Bool sub_sad) {
+    const uint32_t start_8x8_pos = 4 * start_16x16_pos;
+    __m256i        sad02         = _mm256_setzero_si256();
+    __m256i        sad13         = _mm256_setzero_si256();
+
+    if (sub_sad) {
+        for (int i = 0; i < 4; i++) {
+            const __m128i src01   = _mm_loadu_si128((__m128i *)(s + 0 * src_stride));
+            const __m128i src23   = _mm_loadu_si128((__m128i *)(s + 8 * src_stride));
+            const __m128i ref0    = _mm_loadu_si128((__m128i *)(r + 0 * ref_stride + 0));
+            const __m128i ref1    = _mm_loadu_si128((__m128i *)(r + 0 * ref_stride + 8));
+            const __m128i ref2    = _mm_loadu_si128((__m128i *)(r + 8 * ref_stride + 0));
+            const __m128i ref3    = _mm_loadu_si128((__m128i *)(r + 8 * ref_stride + 8));
+            const __m256i src0123 = _mm256_insertf128_si256(
+                _mm256_castsi128_si256(src01), src23, 1);
+            const __m256i ref02 = _mm256_insertf128_si256(
+                _mm256_castsi128_si256(ref0), ref2, 1);
+            const __m256i ref13 = _mm256_insertf128_si256(
+                _mm256_castsi128_si256(ref1), ref3, 1);
+            sad02 = _mm256_adds_epu16(sad02,
+                                      _mm256_mpsadbw_epu8(ref02, src0123, 0)); // 000 000
+            sad02 = _mm256_adds_epu16(sad02,
+                                      _mm256_mpsadbw_epu8(ref02, src0123, 45)); // 101 101
+            sad13 = _mm256_adds_epu16(sad13,
+                                      _mm256_mpsadbw_epu8(ref13, src0123, 18)); // 010 010
+            sad13 = _mm256_adds_epu16(sad13,
+                                      _mm256_mpsadbw_epu8(ref13, src0123, 63)); // 111 111
+            s += 2 * src_stride;
+            r += 2 * ref_stride;
+        }
+
+        sad02 = _mm256_slli_epi16(sad02, 1);
+        sad13 = _mm256_slli_epi16(sad13, 1);
+    } else {
+        for (int i = 0; i < 8; i++) {
+            const __m128i src01   = _mm_loadu_si128((__m128i *)(s + 0 * src_stride));
+            const __m128i src23   = _mm_loadu_si128((__m128i *)(s + 8 * src_stride));
+            const __m128i ref0    = _mm_loadu_si128((__m128i *)(r + 0 * ref_stride + 0));
+            const __m128i ref1    = _mm_loadu_si128((__m128i *)(r + 0 * ref_stride + 8));
+            const __m128i ref2    = _mm_loadu_si128((__m128i *)(r + 8 * ref_stride + 0));
+            const __m128i ref3    = _mm_loadu_si128((__m128i *)(r + 8 * ref_stride + 8));
+            const __m256i src0123 = _mm256_insertf128_si256(
+                _mm256_castsi128_si256(src01), src23, 1);
+            const __m256i ref02 = _mm256_insertf128_si256(
+                _mm256_castsi128_si256(ref0), ref2, 1);
+            const __m256i ref13 = _mm256_insertf128_si256(
+                _mm256_castsi128_si256(ref1), ref3, 1);
+            sad02 = _mm256_adds_epu16(sad02,
+                                      _mm256_mpsadbw_epu8(ref02, src0123, 0)); // 000 000
+            sad02 = _mm256_adds_epu16(sad02,
+                                      _mm256_mpsadbw_epu8(ref02, src0123, 45)); // 101 101
+            sad13 = _mm256_adds_epu16(sad13,
+                                      _mm256_mpsadbw_epu8(ref13, src0123, 18)); // 010 010
+            sad13 = _mm256_adds_epu16(sad13,
+                                      _mm256_mpsadbw_epu8(ref13, src0123, 63)); // 111 111
+            s += src_stride;
+            r += ref_stride;
+        }
+    }
+
+    const __m128i sad0 = _mm256_castsi256_si128(sad02);
+    const __m128i sad1 = _mm256_castsi256_si128(sad13);
+    const __m128i sad2 = _mm256_extracti128_si256(sad02, 1);
+    const __m128i sad3 = _mm256_extracti128_si256(sad13, 1);
+
+    const __m128i minpos0 = _mm_minpos_epu16(sad0);
+    const __m128i minpos1 = _mm_minpos_epu16(sad1);
+    const __m128i minpos2 = _mm_minpos_epu16(sad2);
+    const __m128i minpos3 = _mm_minpos_epu16(sad3);
+
+    const __m128i minpos01   = _mm_unpacklo_epi16(minpos0, minpos1);
+    const __m128i minpos23   = _mm_unpacklo_epi16(minpos2, minpos3);
+    const __m128i minpos0123 = _mm_unpacklo_epi32(minpos01, minpos23);
+    const __m128i sad8x8     = _mm_unpacklo_epi16(minpos0123, _mm_setzero_si128());
+    const __m128i pos0123    = _mm_unpackhi_epi16(minpos0123, _mm_setzero_si128());
+    const __m128i pos8x8     = _mm_slli_epi32(pos0123, 2);
+
+    __m128i best_sad8x8 = _mm_loadu_si128((__m128i *)(p_best_sad_8x8 + start_8x8_pos));
+    const __m128i mask  = _mm_cmplt_epi32(sad8x8, best_sad8x8);
+    best_sad8x8         = _mm_min_epi32(best_sad8x8, sad8x8);
+    _mm_storeu_si128((__m128i *)(p_best_sad_8x8 + start_8x8_pos), best_sad8x8);
+
+    const __m128i mvs = _mm_set1_epi32(mv);
+    if (out_8x8) {
+        __m128i best_mv8x8  = _mm_loadu_si128((__m128i *)(p_best_mv8x8 + start_8x8_pos));
+        const __m128i mv8x8 = _mm_add_epi16(mvs, pos8x8);
+        best_mv8x8          = _mm_blendv_epi8(best_mv8x8, mv8x8, mask);
+        _mm_storeu_si128((__m128i *)(p_best_mv8x8 + start_8x8_pos), best_mv8x8);
+    }
+    const __m128i sum01       = _mm_add_epi16(sad0, sad1);
+    const __m128i sum23       = _mm_add_epi16(sad2, sad3);
+    const __m128i sad16x16_16 = _mm_add_epi16(sum01, sum23);
+
+    const __m128i  minpos16x16 = _mm_minpos_epu16(sad16x16_16);
+    const uint32_t min16x16    = _mm_extract_epi16(minpos16x16, 0);
+
+    if (min16x16 < p_best_sad_16x16[start_16x16_pos]) {
+        p_best_sad_16x16[start_16x16_pos] = min16x16;
+
+        const __m128i pos               = _mm_srli_si128(minpos16x16, 2);
+        const __m128i pos16x16          = _mm_slli_epi32(pos, 2);
+        const __m128i mv16x16           = _mm_add_epi16(mvs, pos16x16);
+        p_best_mv16x16[start_16x16_pos] = _mm_extract_epi32(mv16x16, 0);
+    }
+    return sad16x16_16;
+}
+
 void svt_ext_all_sad_calculation_8x8_16x16_avx2(uint8_t *src, uint32_t src_stride, uint8_t *ref,
                                                 uint32_t ref_stride, uint32_t mv, uint8_t out_8x8,
                                                 uint32_t *p_best_sad_8x8,
@@ -4559,119 +4671,27 @@ void svt_ext_all_sad_calculation_8x8_16x16_avx2(uint8_t *src, uint32_t src_strid
                                                 uint32_t  p_eight_sad16x16[16][8],
                                                 uint32_t p_eight_sad8x8[64][8], Bool sub_sad) {
     static const char offsets[16] = {0, 1, 4, 5, 2, 3, 6, 7, 8, 9, 12, 13, 10, 11, 14, 15};
+    (void)p_eight_sad8x8;
 
     //---- 16x16 : 0, 1, 4, 5, 2, 3, 6, 7, 8, 9, 12, 13, 10, 11, 14, 15
     for (int y = 0; y < 4; y++) {
         for (int x = 0; x < 4; x++) {
             const uint32_t start_16x16_pos = offsets[4 * y + x];
-            const uint32_t start_8x8_pos   = 4 * start_16x16_pos;
-            const uint8_t *s               = src + 16 * y * src_stride + 16 * x;
-            const uint8_t *r               = ref + 16 * y * ref_stride + 16 * x;
-            __m256i        sad02           = _mm256_setzero_si256();
-            __m256i        sad13           = _mm256_setzero_si256();
-
-            if (sub_sad) {
-                for (int i = 0; i < 4; i++) {
-                    const __m128i src01   = _mm_loadu_si128((__m128i *)(s + 0 * src_stride));
-                    const __m128i src23   = _mm_loadu_si128((__m128i *)(s + 8 * src_stride));
-                    const __m128i ref0    = _mm_loadu_si128((__m128i *)(r + 0 * ref_stride + 0));
-                    const __m128i ref1    = _mm_loadu_si128((__m128i *)(r + 0 * ref_stride + 8));
-                    const __m128i ref2    = _mm_loadu_si128((__m128i *)(r + 8 * ref_stride + 0));
-                    const __m128i ref3    = _mm_loadu_si128((__m128i *)(r + 8 * ref_stride + 8));
-                    const __m256i src0123 = _mm256_insertf128_si256(
-                        _mm256_castsi128_si256(src01), src23, 1);
-                    const __m256i ref02 = _mm256_insertf128_si256(
-                        _mm256_castsi128_si256(ref0), ref2, 1);
-                    const __m256i ref13 = _mm256_insertf128_si256(
-                        _mm256_castsi128_si256(ref1), ref3, 1);
-                    sad02 = _mm256_adds_epu16(sad02,
-                                              _mm256_mpsadbw_epu8(ref02, src0123, 0)); // 000 000
-                    sad02 = _mm256_adds_epu16(sad02,
-                                              _mm256_mpsadbw_epu8(ref02, src0123, 45)); // 101 101
-                    sad13 = _mm256_adds_epu16(sad13,
-                                              _mm256_mpsadbw_epu8(ref13, src0123, 18)); // 010 010
-                    sad13 = _mm256_adds_epu16(sad13,
-                                              _mm256_mpsadbw_epu8(ref13, src0123, 63)); // 111 111
-                    s += 2 * src_stride;
-                    r += 2 * ref_stride;
-                }
-
-                sad02 = _mm256_slli_epi16(sad02, 1);
-                sad13 = _mm256_slli_epi16(sad13, 1);
-            } else {
-                for (int i = 0; i < 8; i++) {
-                    const __m128i src01   = _mm_loadu_si128((__m128i *)(s + 0 * src_stride));
-                    const __m128i src23   = _mm_loadu_si128((__m128i *)(s + 8 * src_stride));
-                    const __m128i ref0    = _mm_loadu_si128((__m128i *)(r + 0 * ref_stride + 0));
-                    const __m128i ref1    = _mm_loadu_si128((__m128i *)(r + 0 * ref_stride + 8));
-                    const __m128i ref2    = _mm_loadu_si128((__m128i *)(r + 8 * ref_stride + 0));
-                    const __m128i ref3    = _mm_loadu_si128((__m128i *)(r + 8 * ref_stride + 8));
-                    const __m256i src0123 = _mm256_insertf128_si256(
-                        _mm256_castsi128_si256(src01), src23, 1);
-                    const __m256i ref02 = _mm256_insertf128_si256(
-                        _mm256_castsi128_si256(ref0), ref2, 1);
-                    const __m256i ref13 = _mm256_insertf128_si256(
-                        _mm256_castsi128_si256(ref1), ref3, 1);
-                    sad02 = _mm256_adds_epu16(sad02,
-                                              _mm256_mpsadbw_epu8(ref02, src0123, 0)); // 000 000
-                    sad02 = _mm256_adds_epu16(sad02,
-                                              _mm256_mpsadbw_epu8(ref02, src0123, 45)); // 101 101
-                    sad13 = _mm256_adds_epu16(sad13,
-                                              _mm256_mpsadbw_epu8(ref13, src0123, 18)); // 010 010
-                    sad13 = _mm256_adds_epu16(sad13,
-                                              _mm256_mpsadbw_epu8(ref13, src0123, 63)); // 111 111
-                    s += src_stride;
-                    r += ref_stride;
-                }
-            }
-
-            (void)p_eight_sad8x8;
-            const __m128i sad0 = _mm256_castsi256_si128(sad02);
-            const __m128i sad1 = _mm256_castsi256_si128(sad13);
-            const __m128i sad2 = _mm256_extracti128_si256(sad02, 1);
-            const __m128i sad3 = _mm256_extracti128_si256(sad13, 1);
-
-            const __m128i minpos0 = _mm_minpos_epu16(sad0);
-            const __m128i minpos1 = _mm_minpos_epu16(sad1);
-            const __m128i minpos2 = _mm_minpos_epu16(sad2);
-            const __m128i minpos3 = _mm_minpos_epu16(sad3);
-
-            const __m128i minpos01   = _mm_unpacklo_epi16(minpos0, minpos1);
-            const __m128i minpos23   = _mm_unpacklo_epi16(minpos2, minpos3);
-            const __m128i minpos0123 = _mm_unpacklo_epi32(minpos01, minpos23);
-            const __m128i sad8x8     = _mm_unpacklo_epi16(minpos0123, _mm_setzero_si128());
-            const __m128i pos0123    = _mm_unpackhi_epi16(minpos0123, _mm_setzero_si128());
-            const __m128i pos8x8     = _mm_slli_epi32(pos0123, 2);
-
-            __m128i best_sad8x8 = _mm_loadu_si128((__m128i *)(p_best_sad_8x8 + start_8x8_pos));
-            const __m128i mask  = _mm_cmplt_epi32(sad8x8, best_sad8x8);
-            best_sad8x8         = _mm_min_epi32(best_sad8x8, sad8x8);
-            _mm_storeu_si128((__m128i *)(p_best_sad_8x8 + start_8x8_pos), best_sad8x8);
-
-            const __m128i mvs = _mm_set1_epi32(mv);
-            if (out_8x8) {
-                __m128i best_mv8x8  = _mm_loadu_si128((__m128i *)(p_best_mv8x8 + start_8x8_pos));
-                const __m128i mv8x8 = _mm_add_epi16(mvs, pos8x8);
-                best_mv8x8          = _mm_blendv_epi8(best_mv8x8, mv8x8, mask);
-                _mm_storeu_si128((__m128i *)(p_best_mv8x8 + start_8x8_pos), best_mv8x8);
-            }
-            const __m128i sum01       = _mm_add_epi16(sad0, sad1);
-            const __m128i sum23       = _mm_add_epi16(sad2, sad3);
-            const __m128i sad16x16_16 = _mm_add_epi16(sum01, sum23);
-            const __m256i sad16x16_32 = _mm256_cvtepu16_epi32(sad16x16_16);
-            _mm256_storeu_si256((__m256i *)(p_eight_sad16x16[start_16x16_pos]), sad16x16_32);
-
-            const __m128i  minpos16x16 = _mm_minpos_epu16(sad16x16_16);
-            const uint32_t min16x16    = _mm_extract_epi16(minpos16x16, 0);
-
-            if (min16x16 < p_best_sad_16x16[start_16x16_pos]) {
-                p_best_sad_16x16[start_16x16_pos] = min16x16;
-
-                const __m128i pos               = _mm_srli_si128(minpos16x16, 2);
-                const __m128i pos16x16          = _mm_slli_epi32(pos, 2);
-                const __m128i mv16x16           = _mm_add_epi16(mvs, pos16x16);
-                p_best_mv16x16[start_16x16_pos] = _mm_extract_epi32(mv16x16, 0);
-            }
+            const __m128i  sad16x16_16     = eight_sad_calculation_8x8_16x16_avx2(
+                src + 16 * y * src_stride + 16 * x,
+                src_stride,
+                ref + 16 * y * ref_stride + 16 * x,
+                ref_stride,
+                mv,
+                out_8x8,
+                start_16x16_pos,
+                p_best_sad_8x8,
+                p_best_sad_16x16,
+                p_best_mv8x8,
+                p_best_mv16x16,
+                sub_sad);
+            _mm256_storeu_si256((__m256i *)(p_eight_sad16x16[start_16x16_pos]),
+                                _mm256_cvtepu16_epi32(sad16x16_16));
         }
     }
 }
@@ -4785,6 +4805,64 @@ void svt_ext_eight_sad_calculation_32x32_64x64_avx2(
     }
 }
 
+/* Keep the first of the eight positions with the minimum SAD if it improves the best result.
+   The SADs are below 1 << 29. */
+static INLINE void eight_sad_update_best_avx2(const __m256i sad, uint32_t mv, uint32_t *p_best_sad,
+                                              uint32_t *p_best_mv) {
+    // sad << 3 | position, so that the minimum also gives the position
+    __m256i x = _mm256_or_si256(_mm256_slli_epi32(sad, 3),
+                                _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    x         = _mm256_min_epu32(x, _mm256_permute2x128_si256(x, x, 1));
+    x         = _mm256_min_epu32(x, _mm256_shuffle_epi32(x, 0x4E));
+    x         = _mm256_min_epu32(x, _mm256_shuffle_epi32(x, 0xB1));
+    const uint32_t min = (uint32_t)_mm256_cvtsi256_si32(x);
+
+    if ((min >> 3) < *p_best_sad) {
+        *p_best_sad = min >> 3;
+        *p_best_mv  = (mv & 0xFFFF0000) | ((mv + ((min & 7) << 2)) & 0xFFFF);
+    }
+}
+
+void svt_ext_fullpel_search_row_avx2(uint8_t *src, uint32_t src_stride, uint8_t *ref,
+                                     uint32_t ref_stride, uint32_t mv, uint32_t search_area_width,
+                                     uint8_t out_8x8, Bool sub_sad, uint32_t *p_best_sad_8x8,
+                                     uint32_t *p_best_sad_16x16, uint32_t *p_best_sad_32x32,
+                                     uint32_t *p_best_sad_64x64, uint32_t *p_best_mv8x8,
+                                     uint32_t *p_best_mv16x16, uint32_t *p_best_mv32x32,
+                                     uint32_t *p_best_mv64x64) {
+    for (uint32_t x_search_index = 0; x_search_index < search_area_width; x_search_index += 8) {
+        const uint32_t curr_mv = (mv & 0xFFFF0000) | ((mv + (x_search_index << 2)) & 0xFFFF);
+        __m256i        sad64   = _mm256_setzero_si256();
+
+        // the 16x16 SADs of each 32x32 block are summed in registers
+        for (uint32_t blk_32x32 = 0; blk_32x32 < 4; blk_32x32++) {
+            __m256i sad32 = _mm256_setzero_si256();
+            for (uint32_t blk_16x16 = 0; blk_16x16 < 4; blk_16x16++) {
+                const uint32_t x = 32 * (blk_32x32 & 1) + 16 * (blk_16x16 & 1);
+                const uint32_t y = 32 * (blk_32x32 >> 1) + 16 * (blk_16x16 >> 1);
+                const __m128i  sad16 = eight_sad_calculation_8x8_16x16_avx2(
+                    src + y * src_stride + x,
+                    src_stride,
+                    ref + y * ref_stride + x + x_search_index,
+                    ref_stride,
+                    curr_mv,
+                    out_8x8,
+                    4 * blk_32x32 + blk_16x16,
+                    p_best_sad_8x8,
+                    p_best_sad_16x16,
+                    p_best_mv8x8,
+                    p_best_mv16x16,
+                    sub_sad);
+                sad32 = _mm256_add_epi32(sad32, _mm256_cvtepu16_epi32(sad16));
+            }
+            eight_sad_update_best_avx2(
+                sad32, curr_mv, &p_best_sad_32x32[blk_32x32], &p_best_mv32x32[blk_32x32]);
+            sad64 = _mm256_add_epi32(sad64, sad32);
+        }
+        eight_sad_update_best_avx2(sad64, curr_mv, p_best_sad_64x64, p_best_mv64x64);
+    }
+}
+
 uint32_t svt_nxm_sad_kernel_sub_sampled_helper_avx2(const uint8_t *src, uint32_t src_stride,
                                                     const uint8_t *ref, uint32_t ref_stride,
                                                     uint32_t height, uint32_t width) {
@@ -0,0 +1,159 @@
+/*
+* Copyright(c) 2022 Intel Corporation
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include <immintrin.h>
+#include "EbDefinitions.h"
+#include "aom_dsp_rtcd.h"
+
+static INLINE int64_t hadd64_avx2(const __m256i sum) {
+    const __m128i sum_2 = _mm_add_epi64(_mm256_castsi256_si128(sum),
+                                        _mm256_extracti128_si256(sum, 1));
+    return _mm_cvtsi128_si64(_mm_add_epi64(sum_2, _mm_srli_si128(sum_2, 8)));
+}
+
+// Adds the 8 signed 32-bit lanes of v to the 4 64-bit lanes of sum
+static INLINE __m256i add_epi32_to_epi64_avx2(const __m256i sum, const __m256i v) {
+    const __m256i v_lo = _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v));
+    const __m256i v_hi = _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1));
+    return _mm256_add_epi64(sum, _mm256_add_epi64(v_lo, v_hi));
+}
+
+/* The sums are exact in integers, so the means and the variances are the same
+   as the ones of the C versions which accumulate them in doubles. */
+double svt_av1_get_block_mean_avx2(const uint8_t *data, int32_t w, int32_t h, int32_t stride,
+                                   int32_t x_o, int32_t y_o, int32_t block_size,
+                                   int32_t use_highbd) {
+    const int32_t max_h = AOMMIN(h - y_o, block_size);
+    const int32_t max_w = AOMMIN(w - x_o, block_size);
+    __m256i       sum   = _mm256_setzero_si256();
+    int64_t       tail  = 0;
+
+    if (use_highbd) {
+        const uint16_t *src = (const uint16_t *)data + y_o * stride + x_o;
+        for (int32_t y = 0; y < max_h; ++y, src += stride) {
+            __m256i row_sum = _mm256_setzero_si256();
+            int32_t x       = 0;
+            for (; x + 8 <= max_w; x += 8) {
+                const __m128i s = _mm_loadu_si128((const __m128i *)(src + x));
+                row_sum         = _mm256_add_epi32(row_sum, _mm256_cvtepu16_epi32(s));
+            }
+            for (; x < max_w; ++x) tail += src[x];
+            sum = add_epi32_to_epi64_avx2(sum, row_sum);
+        }
+    } else {
+        const __m256i  zero = _mm256_setzero_si256();
+        const uint8_t *src  = data + y_o * stride + x_o;
+        for (int32_t y = 0; y < max_h; ++y, src += stride) {
+            int32_t x = 0;
+            for (; x + 32 <= max_w; x += 32) {
+                const __m256i s = _mm256_loadu_si256((const __m256i *)(src + x));
+                sum             = _mm256_add_epi64(sum, _mm256_sad_epu8(s, zero));
+            }
+            for (; x + 16 <= max_w; x += 16) {
+                const __m128i s = _mm_loadu_si128((const __m128i *)(src + x));
+                sum             = _mm256_add_epi64(
+                    sum, _mm256_castsi128_si256(_mm_sad_epu8(s, _mm_setzero_si128())));
+            }
+            for (; x < max_w; ++x) tail += src[x];
+        }
+    }
+    const double block_mean = (double)(hadd64_avx2(sum) + tail);
+    return block_mean / (max_w * max_h);
+}
+
+double svt_av1_get_noise_var_avx2(const uint8_t *data, const uint8_t *denoised, int32_t stride,
+                                  int32_t w, int32_t h, int32_t x_o, int32_t y_o,
+                                  int32_t block_size_x, int32_t block_size_y,
+                                  int32_t use_highbd) {
+    const int32_t max_h    = AOMMIN(h - y_o, block_size_y);
+    const int32_t max_w    = AOMMIN(w - x_o, block_size_x);
+    const __m256i ones     = _mm256_set1_epi16(1);
+    __m256i       sum      = _mm256_setzero_si256();
+    __m256i       sum_sq   = _mm256_setzero_si256();
+    int64_t       tail     = 0;
+    int64_t       tail_sq  = 0;
+    const int32_t offset   = y_o * stride + x_o;
+
+    for (int32_t y = 0; y < max_h; ++y) {
+        __m256i row_sum    = _mm256_setzero_si256();
+        __m256i row_sum_sq = _mm256_setzero_si256();
+        int32_t x          = 0;
+        if (use_highbd) {
+            const uint16_t *src = (const uint16_t *)data + offset + y * stride;
+            const uint16_t *den = (const uint16_t *)denoised + offset + y * stride;
+            for (; x + 16 <= max_w; x += 16) {
+                const __m256i noise = _mm256_sub_epi16(
+                    _mm256_loadu_si256((const __m256i *)(src + x)),
+                    _mm256_loadu_si256((const __m256i *)(den + x)));
+                row_sum    = _mm256_add_epi32(row_sum, _mm256_madd_epi16(noise, ones));
+                row_sum_sq = _mm256_add_epi32(row_sum_sq, _mm256_madd_epi16(noise, noise));
+            }
+            for (; x < max_w; ++x) {
+                const int32_t noise = src[x] - den[x];
+                tail += noise;
+                tail_sq += noise * noise;
+            }
+        } else {
+            const uint8_t *src = data + offset + y * stride;
+            const uint8_t *den = denoised + offset + y * stride;
+            for (; x + 16 <= max_w; x += 16) {
+                const __m256i noise = _mm256_sub_epi16(
+                    _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(src + x))),
+                    _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(den + x))));
+                row_sum    = _mm256_add_epi32(row_sum, _mm256_madd_epi16(noise, ones));
+                row_sum_sq = _mm256_add_epi32(row_sum_sq, _mm256_madd_epi16(noise, noise));
+            }
+            for (; x < max_w; ++x) {
+                const int32_t noise = src[x] - den[x];
+                tail += noise;
+                tail_sq += noise * noise;
+            }
+        }
+        sum    = add_epi32_to_epi64_avx2(sum, row_sum);
+        sum_sq = add_epi32_to_epi64_avx2(sum_sq, row_sum_sq);
+    }
+    double       noise_mean = (double)(hadd64_avx2(sum) + tail);
+    const double noise_var  = (double)(hadd64_avx2(sum_sq) + tail_sq);
+    noise_mean /= (max_w * max_h);
+    return noise_var / (max_w * max_h) - noise_mean * noise_mean;
+}
+
+/* Every element of b and A gets the same product and sum as in the C version,
+   there is no reordering of the floating point operations. */
+void svt_av1_add_block_observations_internal_avx2(uint32_t n, const double val,
+                                                  const double recp_sqr_norm, double *buffer,
+                                                  double *buffer_norm, double *b, double *A) {
+    const __m256d recp_sqr_norm_pd = _mm256_set1_pd(recp_sqr_norm);
+    const __m256d val_pd           = _mm256_set1_pd(val);
+    uint32_t      i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        const __m256d norm = _mm256_mul_pd(_mm256_loadu_pd(buffer + i), recp_sqr_norm_pd);
+        _mm256_storeu_pd(buffer_norm + i, norm);
+        _mm256_storeu_pd(b + i,
+                         _mm256_add_pd(_mm256_loadu_pd(b + i), _mm256_mul_pd(norm, val_pd)));
+    }
+    for (; i < n; ++i) {
+        buffer_norm[i] = buffer[i] * recp_sqr_norm;
+        b[i] += buffer_norm[i] * val;
+    }
+
+    for (i = 0; i < n; ++i) {
+        const __m256d norm_i = _mm256_set1_pd(buffer_norm[i]);
+        double       *a_row  = A + i * n;
+        uint32_t      j;
+        for (j = 0; j + 4 <= n; j += 4) {
+            const __m256d prod = _mm256_mul_pd(norm_i, _mm256_loadu_pd(buffer + j));
+            _mm256_storeu_pd(a_row + j, _mm256_add_pd(_mm256_loadu_pd(a_row + j), prod));
+        }
+        for (; j < n; ++j) a_row[j] += buffer_norm[i] * buffer[j];
+    }
+}
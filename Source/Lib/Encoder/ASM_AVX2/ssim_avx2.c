@@ -0,0 +1,86 @@
+/*
+* Copyright(c) 2022 Intel Corporation
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include <immintrin.h>
+#include "EbDefinitions.h"
+#include "aom_dsp_rtcd.h"
+
+static INLINE uint32_t hadd32_avx2(const __m256i sum) {
+    const __m128i sum_4 = _mm_add_epi32(_mm256_castsi256_si128(sum),
+                                        _mm256_extracti128_si256(sum, 1));
+    const __m128i sum_2 = _mm_add_epi32(sum_4, _mm_srli_si128(sum_4, 8));
+    const __m128i sum_1 = _mm_add_epi32(sum_2, _mm_srli_si128(sum_2, 4));
+    return (uint32_t)_mm_cvtsi128_si32(sum_1);
+}
+
+// Two rows of 8 pixels widened to 16 bits
+static INLINE __m256i load_2x8_u8_avx2(const uint8_t *p, int stride) {
+    const __m128i rows = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)p),
+                                            _mm_loadl_epi64((const __m128i *)(p + stride)));
+    return _mm256_cvtepu8_epi16(rows);
+}
+
+static INLINE void ssim_accumulate_avx2(const __m256i s, const __m256i r, __m256i *sum_s,
+                                        __m256i *sum_r, __m256i *sum_sq_s, __m256i *sum_sq_r,
+                                        __m256i *sum_sxr) {
+    const __m256i one = _mm256_set1_epi16(1);
+    *sum_s            = _mm256_add_epi32(*sum_s, _mm256_madd_epi16(s, one));
+    *sum_r            = _mm256_add_epi32(*sum_r, _mm256_madd_epi16(r, one));
+    *sum_sq_s         = _mm256_add_epi32(*sum_sq_s, _mm256_madd_epi16(s, s));
+    *sum_sq_r         = _mm256_add_epi32(*sum_sq_r, _mm256_madd_epi16(r, r));
+    *sum_sxr          = _mm256_add_epi32(*sum_sxr, _mm256_madd_epi16(s, r));
+}
+
+void svt_aom_ssim_parms_8x8_avx2(const uint8_t *s, int sp, const uint8_t *r, int rp,
+                                 uint32_t *sum_s, uint32_t *sum_r, uint32_t *sum_sq_s,
+                                 uint32_t *sum_sq_r, uint32_t *sum_sxr) {
+    __m256i s_sum = _mm256_setzero_si256(), r_sum = _mm256_setzero_si256();
+    __m256i s_sq = _mm256_setzero_si256(), r_sq = _mm256_setzero_si256();
+    __m256i sxr = _mm256_setzero_si256();
+
+    for (int i = 0; i < 8; i += 2, s += 2 * sp, r += 2 * rp) {
+        const __m256i s16 = load_2x8_u8_avx2(s, sp);
+        const __m256i r16 = load_2x8_u8_avx2(r, rp);
+        ssim_accumulate_avx2(s16, r16, &s_sum, &r_sum, &s_sq, &r_sq, &sxr);
+    }
+
+    *sum_s += hadd32_avx2(s_sum);
+    *sum_r += hadd32_avx2(r_sum);
+    *sum_sq_s += hadd32_avx2(s_sq);
+    *sum_sq_r += hadd32_avx2(r_sq);
+    *sum_sxr += hadd32_avx2(sxr);
+}
+
+void svt_aom_highbd_ssim_parms_8x8_avx2(const uint8_t *s, int sp, const uint8_t *sinc, int spinc,
+                                        const uint16_t *r, int rp, uint32_t *sum_s,
+                                        uint32_t *sum_r, uint32_t *sum_sq_s, uint32_t *sum_sq_r,
+                                        uint32_t *sum_sxr) {
+    __m256i s_sum = _mm256_setzero_si256(), r_sum = _mm256_setzero_si256();
+    __m256i s_sq = _mm256_setzero_si256(), r_sq = _mm256_setzero_si256();
+    __m256i sxr = _mm256_setzero_si256();
+
+    for (int i = 0; i < 8; i += 2, s += 2 * sp, sinc += 2 * spinc, r += 2 * rp) {
+        // source sample is (s << 2) + the 2 msb of the bit-increment byte
+        const __m256i s16 = _mm256_add_epi16(_mm256_slli_epi16(load_2x8_u8_avx2(s, sp), 2),
+                                             _mm256_srli_epi16(load_2x8_u8_avx2(sinc, spinc), 6));
+        const __m256i r16 = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)r)),
+            _mm_loadu_si128((const __m128i *)(r + rp)),
+            1);
+        ssim_accumulate_avx2(s16, r16, &s_sum, &r_sum, &s_sq, &r_sq, &sxr);
+    }
+
+    *sum_s += hadd32_avx2(s_sum);
+    *sum_r += hadd32_avx2(r_sum);
+    *sum_sq_s += hadd32_avx2(s_sq);
+    *sum_sq_r += hadd32_avx2(r_sq);
+    *sum_sxr += hadd32_avx2(sxr);
+}
@@ -4948,4 +4948,182 @@ void svt_sad_loop_kernel_avx512_intrin(
     *x_search_center = (int16_t)best_x;
     *y_search_center = (int16_t)best_y;
 }
+
+/*******************************************
+ * fullpel_sad8x8_32pos_avx512
+ *   SADs of an 8x8 block at 32 consecutive search positions. The lanes hold
+ *   the positions 0-7, 16-23, 8-15 and 24-31, lo_mask and hi_mask keep the
+ *   loads inside the pixels of the valid positions.
+ *******************************************/
+static INLINE __m512i fullpel_sad8x8_32pos_avx512(const uint8_t *src, uint32_t src_stride,
+                                                  const uint8_t *ref, uint32_t ref_stride,
+                                                  __mmask32 lo_mask, __mmask32 hi_mask,
+                                                  uint32_t row_step) {
+    __m512i sum = _mm512_setzero_si512();
+
+    for (uint32_t y = 0; y < 8; y += row_step) {
+        const __m256i lo = _mm256_maskz_loadu_epi8(lo_mask, ref);
+        const __m256i hi = _mm256_maskz_loadu_epi8(hi_mask, ref + 8);
+        const __m512i r  = _mm512_inserti64x4(_mm512_castsi256_si512(lo), hi, 1);
+        const __m512i s0 = _mm512_set1_epi32(*(const int32_t *)src);
+        const __m512i s1 = _mm512_set1_epi32(*(const int32_t *)(src + 4));
+
+        sum = _mm512_add_epi16(sum, _mm512_dbsad_epu8(s0, r, 0x94));
+        sum = _mm512_add_epi16(sum, _mm512_dbsad_epu8(s1, r, 0xE9));
+        src += row_step * src_stride;
+        ref += row_step * ref_stride;
+    }
+    return sum;
+}
+
+// keys of 16-bit SADs: sad << 16 | position
+static INLINE void fullpel_update_key16_avx512(__m512i key[2], const __m512i sad,
+                                               const __m512i pos) {
+    key[0] = _mm512_min_epu32(key[0], _mm512_unpacklo_epi16(pos, sad));
+    key[1] = _mm512_min_epu32(key[1], _mm512_unpackhi_epi16(pos, sad));
+}
+
+// keys of 32-bit SADs: sad << 32 | position
+static INLINE void fullpel_update_key32_avx512(__m512i key[4], const __m512i sad[2],
+                                               const __m512i pos[2]) {
+    key[0] = _mm512_min_epu64(key[0], _mm512_unpacklo_epi32(pos[0], sad[0]));
+    key[1] = _mm512_min_epu64(key[1], _mm512_unpackhi_epi32(pos[0], sad[0]));
+    key[2] = _mm512_min_epu64(key[2], _mm512_unpacklo_epi32(pos[1], sad[1]));
+    key[3] = _mm512_min_epu64(key[3], _mm512_unpackhi_epi32(pos[1], sad[1]));
+}
+
+static INLINE void fullpel_update_best_avx512(uint64_t key, uint32_t sad_shift, uint32_t mv,
+                                              uint32_t *best_sad, uint32_t *best_mv) {
+    const uint32_t sad = (uint32_t)(key >> sad_shift);
+    const uint32_t pos = (uint32_t)key & 0xFFFF;
+
+    if (sad < *best_sad) {
+        *best_sad = sad;
+        if (best_mv)
+            *best_mv = (mv & 0xFFFF0000) | ((mv + (pos << 2)) & 0xFFFF);
+    }
+}
+
+/*******************************************
+ * svt_ext_fullpel_search_row_avx512
+ *   The search positions are processed 32 at a time with _mm512_dbsad_epu8.
+ *   Each block keeps, per position slot, the minimum of sad << n | position,
+ *   the smallest key of the row is then the first position with the best
+ *   SAD, as in the C version.
+ *******************************************/
+void svt_ext_fullpel_search_row_avx512(uint8_t *src, uint32_t src_stride, uint8_t *ref,
+                                       uint32_t ref_stride, uint32_t mv,
+                                       uint32_t search_area_width, uint8_t out_8x8, Bool sub_sad,
+                                       uint32_t *p_best_sad_8x8, uint32_t *p_best_sad_16x16,
+                                       uint32_t *p_best_sad_32x32, uint32_t *p_best_sad_64x64,
+                                       uint32_t *p_best_mv8x8, uint32_t *p_best_mv16x16,
+                                       uint32_t *p_best_mv32x32, uint32_t *p_best_mv64x64) {
+    static const uint8_t  offsets[16] = {0, 1, 4, 5, 2, 3, 6, 7, 8, 9, 12, 13, 10, 11, 14, 15};
+    static const uint16_t lane_pos[32] = {0,  1,  2,  3,  4,  5,  6,  7,  16, 17, 18,
+                                          19, 20, 21, 22, 23, 8,  9,  10, 11, 12, 13,
+                                          14, 15, 24, 25, 26, 27, 28, 29, 30, 31};
+    const uint32_t        row_step     = sub_sad ? 2 : 1;
+    const __m512i         lane_pos_512 = _mm512_loadu_si512((const __m512i *)lane_pos);
+    const __m512i         zero         = _mm512_setzero_si512();
+    const __m512i         max          = _mm512_set1_epi32(-1);
+    __m512i key8x8[64][2], key16x16[16][2], key32x32[4][4], key64x64[4];
+
+    // blocks in raster order
+    for (uint32_t i = 0; i < 64; i++) key8x8[i][0] = key8x8[i][1] = max;
+    for (uint32_t i = 0; i < 16; i++) key16x16[i][0] = key16x16[i][1] = max;
+    for (uint32_t i = 0; i < 4; i++)
+        key32x32[i][0] = key32x32[i][1] = key32x32[i][2] = key32x32[i][3] = max;
+    key64x64[0] = key64x64[1] = key64x64[2] = key64x64[3] = max;
+
+    for (uint32_t x = 0; x < search_area_width; x += 32) {
+        const uint32_t num_pos = AOMMIN(search_area_width - x, 32);
+        // position p reads the reference pixels p to p + 7 of the block row
+        const __mmask32 lo_mask = num_pos > 24 ? 0xFFFFFFFF : (1u << (num_pos + 7)) - 1;
+        const __mmask32 hi_mask = (__mmask32)((1ull << (num_pos - 1)) - 1);
+        const __mmask32 valid   = _mm512_cmplt_epu16_mask(lane_pos_512,
+                                                        _mm512_set1_epi16((int16_t)num_pos));
+        const __m512i   pos     = _mm512_add_epi16(lane_pos_512, _mm512_set1_epi16((int16_t)x));
+        const __m512i   pos32[2] = {_mm512_unpacklo_epi16(pos, zero),
+                                    _mm512_unpackhi_epi16(pos, zero)};
+        __m512i         sad8x8[2][8], sad16x16[2][4];
+        __m512i         sad64x64[2] = {zero, zero};
+
+        for (uint32_t blk_y = 0; blk_y < 8; blk_y++) {
+            for (uint32_t blk_x = 0; blk_x < 8; blk_x++) {
+                __m512i sad = fullpel_sad8x8_32pos_avx512(
+                    src + 8 * (blk_y * src_stride + blk_x),
+                    src_stride,
+                    ref + 8 * (blk_y * ref_stride + blk_x) + x,
+                    ref_stride,
+                    lo_mask,
+                    hi_mask,
+                    row_step);
+                if (sub_sad)
+                    sad = _mm512_slli_epi16(sad, 1);
+                // the largest 16x16 SAD is 65280, the invalid positions never win
+                sad = _mm512_mask_mov_epi16(max, valid, sad);
+                fullpel_update_key16_avx512(key8x8[8 * blk_y + blk_x], sad, pos);
+                sad8x8[blk_y & 1][blk_x] = sad;
+            }
+            if (!(blk_y & 1))
+                continue;
+
+            const uint32_t blk16_y = blk_y >> 1;
+            for (uint32_t blk_x = 0; blk_x < 4; blk_x++) {
+                const __m512i sad = _mm512_adds_epu16(
+                    _mm512_adds_epu16(sad8x8[0][2 * blk_x], sad8x8[0][2 * blk_x + 1]),
+                    _mm512_adds_epu16(sad8x8[1][2 * blk_x], sad8x8[1][2 * blk_x + 1]));
+                fullpel_update_key16_avx512(key16x16[4 * blk16_y + blk_x], sad, pos);
+                sad16x16[blk16_y & 1][blk_x] = sad;
+            }
+            if (!(blk16_y & 1))
+                continue;
+
+            for (uint32_t blk_x = 0; blk_x < 2; blk_x++) {
+                __m512i sad[2] = {zero, zero};
+                for (uint32_t i = 0; i < 4; i++) {
+                    const __m512i s = sad16x16[i >> 1][2 * blk_x + (i & 1)];
+                    sad[0]          = _mm512_add_epi32(sad[0], _mm512_unpacklo_epi16(s, zero));
+                    sad[1]          = _mm512_add_epi32(sad[1], _mm512_unpackhi_epi16(s, zero));
+                }
+                fullpel_update_key32_avx512(key32x32[2 * (blk16_y >> 1) + blk_x], sad, pos32);
+                sad64x64[0] = _mm512_add_epi32(sad64x64[0], sad[0]);
+                sad64x64[1] = _mm512_add_epi32(sad64x64[1], sad[1]);
+            }
+        }
+        fullpel_update_key32_avx512(key64x64, sad64x64, pos32);
+    }
+
+    for (uint32_t blk_y = 0; blk_y < 8; blk_y++) {
+        for (uint32_t blk_x = 0; blk_x < 8; blk_x++) {
+            const __m512i *key = key8x8[8 * blk_y + blk_x];
+            const uint32_t i   = 4 * offsets[4 * (blk_y >> 1) + (blk_x >> 1)] + 2 * (blk_y & 1) +
+                (blk_x & 1);
+            fullpel_update_best_avx512(_mm512_reduce_min_epu32(_mm512_min_epu32(key[0], key[1])),
+                                       16,
+                                       mv,
+                                       &p_best_sad_8x8[i],
+                                       out_8x8 ? &p_best_mv8x8[i] : NULL);
+        }
+    }
+    for (uint32_t i = 0; i < 16; i++) {
+        const __m512i *key = key16x16[i];
+        fullpel_update_best_avx512(_mm512_reduce_min_epu32(_mm512_min_epu32(key[0], key[1])),
+                                   16,
+                                   mv,
+                                   &p_best_sad_16x16[offsets[i]],
+                                   &p_best_mv16x16[offsets[i]]);
+    }
+    for (uint32_t i = 0; i < 5; i++) {
+        const __m512i *key = i < 4 ? key32x32[i] : key64x64;
+        fullpel_update_best_avx512(
+            _mm512_reduce_min_epu64(_mm512_min_epu64(_mm512_min_epu64(key[0], key[1]),
+                                                     _mm512_min_epu64(key[2], key[3]))),
+            32,
+            mv,
+            i < 4 ? &p_best_sad_32x32[i] : p_best_sad_64x64,
+            i < 4 ? &p_best_mv32x32[i] : p_best_mv64x64);
+    }
+}
+
 #endif // EN_AVX512_SUPPORT
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2018, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+ */
+
+#include "EbDefinitions.h"
+
+#if EN_AVX512_SUPPORT
+
+#include <immintrin.h>
+#include "corner_match.h"
+
+DECLARE_ALIGNED(16, static const uint8_t, byte_mask[16]) = {
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 0, 0, 0};
+#if MATCH_SZ != 13
+#error "Need to change byte_mask in corner_match_avx512.c if MATCH_SZ != 13"
+#endif
+
+// Accumulates two rows of each window, the row sums of im1 land in the lower
+// four 64-bit lanes of sum_vec and the ones of im2 in the upper four
+static INLINE void accumulate_2_rows(const __m256i v1, const __m256i v2, __m512i *sum_vec,
+                                     __m512i *sumsq2_vec, __m512i *cross_vec) {
+    const __m512i v1_w = _mm512_cvtepu8_epi16(v1);
+    const __m512i v2_w = _mm512_cvtepu8_epi16(v2);
+    const __m512i v    = _mm512_inserti64x4(_mm512_castsi256_si512(v1), v2, 1);
+
+    *sum_vec    = _mm512_add_epi64(*sum_vec, _mm512_sad_epu8(v, _mm512_setzero_si512()));
+    *sumsq2_vec = _mm512_add_epi32(*sumsq2_vec, _mm512_madd_epi16(v2_w, v2_w));
+    *cross_vec  = _mm512_add_epi32(*cross_vec, _mm512_madd_epi16(v1_w, v2_w));
+}
+
+static INLINE __m256i load_2_rows(const unsigned char *p, int stride, const __m128i mask) {
+    const __m128i r0 = _mm_and_si128(_mm_loadu_si128((const __m128i *)p), mask);
+    const __m128i r1 = _mm_and_si128(_mm_loadu_si128((const __m128i *)(p + stride)), mask);
+    return _mm256_inserti128_si256(_mm256_castsi128_si256(r0), r1, 1);
+}
+
+/* Compute quad of corr(im1, im2) * MATCH_SZ * stddev(im1), where the
+correlation/standard deviation are taken over MATCH_SZ by MATCH_SZ windows
+of each image, centered at (x1, y1) and (x2, y2) respectively.
+*/
+double svt_av1_compute_cross_correlation_avx512(unsigned char *im1, int stride1, int x1, int y1,
+                                                unsigned char *im2, int stride2, int x2, int y2) {
+    const __m128i mask       = _mm_loadu_si128((const __m128i *)byte_mask);
+    __m512i       sum_vec    = _mm512_setzero_si512();
+    __m512i       sumsq2_vec = _mm512_setzero_si512();
+    __m512i       cross_vec  = _mm512_setzero_si512();
+    int           i;
+
+    im1 += (y1 - MATCH_SZ_BY2) * stride1 + (x1 - MATCH_SZ_BY2);
+    im2 += (y2 - MATCH_SZ_BY2) * stride2 + (x2 - MATCH_SZ_BY2);
+
+    for (i = 0; i < MATCH_SZ - 1; i += 2) {
+        accumulate_2_rows(load_2_rows(im1, stride1, mask),
+                          load_2_rows(im2, stride2, mask),
+                          &sum_vec,
+                          &sumsq2_vec,
+                          &cross_vec);
+        im1 += 2 * stride1;
+        im2 += 2 * stride2;
+    }
+    // Last row, MATCH_SZ is odd: the upper lanes must be zero, the cast leaves them undefined
+    const __m128i r1 = _mm_and_si128(_mm_loadu_si128((const __m128i *)im1), mask);
+    const __m128i r2 = _mm_and_si128(_mm_loadu_si128((const __m128i *)im2), mask);
+    accumulate_2_rows(_mm256_inserti128_si256(_mm256_setzero_si256(), r1, 0),
+                      _mm256_inserti128_si256(_mm256_setzero_si256(), r2, 0),
+                      &sum_vec,
+                      &sumsq2_vec,
+                      &cross_vec);
+
+    const int sum1_acc   = (int)_mm512_mask_reduce_add_epi64(0x0F, sum_vec);
+    const int sum2_acc   = (int)_mm512_mask_reduce_add_epi64(0xF0, sum_vec);
+    const int sumsq2_acc = _mm512_reduce_add_epi32(sumsq2_vec);
+    const int cross_acc  = _mm512_reduce_add_epi32(cross_vec);
+
+    const int var2 = sumsq2_acc * MATCH_SZ_SQ - sum2_acc * sum2_acc;
+    const int cov  = cross_acc * MATCH_SZ_SQ - sum1_acc * sum2_acc;
+    if (cov < 0) {
+        return 0;
+    }
+    return ((double)cov * cov) / ((double)var2);
+}
+
+#endif // EN_AVX512_SUPPORT
@@ -0,0 +1,97 @@
+/*
+* Copyright(c) 2022 Intel Corporation
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include "EbDefinitions.h"
+
+#if EN_AVX512_SUPPORT
+
+#include <immintrin.h>
+#include "aom_dsp_rtcd.h"
+
+// Four rows of 8 pixels widened to 16 bits
+static INLINE __m512i load_4x8_u8_avx512(const uint8_t *p, int stride) {
+    const __m128i rows01 = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)p),
+                                              _mm_loadl_epi64((const __m128i *)(p + stride)));
+    const __m128i rows23 = _mm_unpacklo_epi64(
+        _mm_loadl_epi64((const __m128i *)(p + 2 * stride)),
+        _mm_loadl_epi64((const __m128i *)(p + 3 * stride)));
+    return _mm512_cvtepu8_epi16(
+        _mm256_inserti128_si256(_mm256_castsi128_si256(rows01), rows23, 1));
+}
+
+static INLINE __m512i load_4x8_u16_avx512(const uint16_t *p, int stride) {
+    const __m256i rows01 = _mm256_inserti128_si256(
+        _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)p)),
+        _mm_loadu_si128((const __m128i *)(p + stride)),
+        1);
+    const __m256i rows23 = _mm256_inserti128_si256(
+        _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)(p + 2 * stride))),
+        _mm_loadu_si128((const __m128i *)(p + 3 * stride)),
+        1);
+    return _mm512_inserti64x4(_mm512_castsi256_si512(rows01), rows23, 1);
+}
+
+static INLINE void ssim_accumulate_avx512(const __m512i s, const __m512i r, __m512i *sum_s,
+                                          __m512i *sum_r, __m512i *sum_sq_s, __m512i *sum_sq_r,
+                                          __m512i *sum_sxr) {
+    const __m512i one = _mm512_set1_epi16(1);
+    *sum_s            = _mm512_add_epi32(*sum_s, _mm512_madd_epi16(s, one));
+    *sum_r            = _mm512_add_epi32(*sum_r, _mm512_madd_epi16(r, one));
+    *sum_sq_s         = _mm512_add_epi32(*sum_sq_s, _mm512_madd_epi16(s, s));
+    *sum_sq_r         = _mm512_add_epi32(*sum_sq_r, _mm512_madd_epi16(r, r));
+    *sum_sxr          = _mm512_add_epi32(*sum_sxr, _mm512_madd_epi16(s, r));
+}
+
+void svt_aom_ssim_parms_8x8_avx512(const uint8_t *s, int sp, const uint8_t *r, int rp,
+                                   uint32_t *sum_s, uint32_t *sum_r, uint32_t *sum_sq_s,
+                                   uint32_t *sum_sq_r, uint32_t *sum_sxr) {
+    __m512i s_sum = _mm512_setzero_si512(), r_sum = _mm512_setzero_si512();
+    __m512i s_sq = _mm512_setzero_si512(), r_sq = _mm512_setzero_si512();
+    __m512i sxr = _mm512_setzero_si512();
+
+    for (int i = 0; i < 8; i += 4, s += 4 * sp, r += 4 * rp) {
+        const __m512i s16 = load_4x8_u8_avx512(s, sp);
+        const __m512i r16 = load_4x8_u8_avx512(r, rp);
+        ssim_accumulate_avx512(s16, r16, &s_sum, &r_sum, &s_sq, &r_sq, &sxr);
+    }
+
+    *sum_s += (uint32_t)_mm512_reduce_add_epi32(s_sum);
+    *sum_r += (uint32_t)_mm512_reduce_add_epi32(r_sum);
+    *sum_sq_s += (uint32_t)_mm512_reduce_add_epi32(s_sq);
+    *sum_sq_r += (uint32_t)_mm512_reduce_add_epi32(r_sq);
+    *sum_sxr += (uint32_t)_mm512_reduce_add_epi32(sxr);
+}
+
+void svt_aom_highbd_ssim_parms_8x8_avx512(const uint8_t *s, int sp, const uint8_t *sinc,
+                                          int spinc, const uint16_t *r, int rp, uint32_t *sum_s,
+                                          uint32_t *sum_r, uint32_t *sum_sq_s, uint32_t *sum_sq_r,
+                                          uint32_t *sum_sxr) {
+    __m512i s_sum = _mm512_setzero_si512(), r_sum = _mm512_setzero_si512();
+    __m512i s_sq = _mm512_setzero_si512(), r_sq = _mm512_setzero_si512();
+    __m512i sxr = _mm512_setzero_si512();
+
+    for (int i = 0; i < 8; i += 4, s += 4 * sp, sinc += 4 * spinc, r += 4 * rp) {
+        // source sample is (s << 2) + the 2 msb of the bit-increment byte
+        const __m512i s16 = _mm512_add_epi16(
+            _mm512_slli_epi16(load_4x8_u8_avx512(s, sp), 2),
+            _mm512_srli_epi16(load_4x8_u8_avx512(sinc, spinc), 6));
+        const __m512i r16 = load_4x8_u16_avx512(r, rp);
+        ssim_accumulate_avx512(s16, r16, &s_sum, &r_sum, &s_sq, &r_sq, &sxr);
+    }
+
+    *sum_s += (uint32_t)_mm512_reduce_add_epi32(s_sum);
+    *sum_r += (uint32_t)_mm512_reduce_add_epi32(r_sum);
+    *sum_sq_s += (uint32_t)_mm512_reduce_add_epi32(s_sq);
+    *sum_sq_r += (uint32_t)_mm512_reduce_add_epi32(r_sq);
+    *sum_sxr += (uint32_t)_mm512_reduce_add_epi32(sxr);
+}
+
+#endif // EN_AVX512_SUPPORT
@@ -613,17 +613,17 @@ void cdef_seg_search16bit(PictureControlSet *pcs_ptr, SequenceControlSet *scs_pt
 }
 
 /******************************************************
- * CDEF Kernel
+ * Cdef Task
+ *   Searches and applies CDEF on one DLF result segment
  ******************************************************/
-void *cdef_kernel(void *input_ptr) {
+void cdef_process_task(EbThreadContext *thread_context_ptr,
+                       EbObjectWrapper *dlf_results_wrapper_ptr) {
     // Context & SCS & PCS
-    EbThreadContext    *thread_context_ptr = (EbThreadContext *)input_ptr;
     CdefContext        *context_ptr        = (CdefContext *)thread_context_ptr->priv;
     PictureControlSet  *pcs_ptr;
     SequenceControlSet *scs_ptr;
 
     //// Input
-    EbObjectWrapper *dlf_results_wrapper_ptr;
     DlfResults      *dlf_results_ptr;
 
     //// Output
@@ -632,99 +632,110 @@ void *cdef_kernel(void *input_ptr) {
 
     // SB Loop variables
 
-    for (;;) {
-        FrameHeader *frm_hdr;
+    FrameHeader *frm_hdr;
 
-        // Get DLF Results
-        EB_GET_FULL_OBJECT(context_ptr->cdef_input_fifo_ptr, &dlf_results_wrapper_ptr);
 
-        dlf_results_ptr = (DlfResults *)dlf_results_wrapper_ptr->object_ptr;
-        pcs_ptr         = (PictureControlSet *)dlf_results_ptr->pcs_wrapper_ptr->object_ptr;
-        scs_ptr         = (SequenceControlSet *)pcs_ptr->scs_wrapper_ptr->object_ptr;
-
-        Bool     is_16bit      = scs_ptr->is_16bit_pipeline;
-        Av1Common *cm            = pcs_ptr->parent_pcs_ptr->av1_cm;
-        frm_hdr                  = &pcs_ptr->parent_pcs_ptr->frm_hdr;
-        CdefControls *cdef_ctrls = &pcs_ptr->parent_pcs_ptr->cdef_ctrls;
-        if (!cdef_ctrls->use_reference_cdef_fs) {
-            if (scs_ptr->seq_header.cdef_level && pcs_ptr->parent_pcs_ptr->cdef_level) {
-                if (is_16bit)
-                    cdef_seg_search16bit(pcs_ptr, scs_ptr, dlf_results_ptr->segment_index);
-                else
-                    cdef_seg_search(pcs_ptr, scs_ptr, dlf_results_ptr->segment_index);
-            }
+    dlf_results_ptr = (DlfResults *)dlf_results_wrapper_ptr->object_ptr;
+    pcs_ptr         = (PictureControlSet *)dlf_results_ptr->pcs_wrapper_ptr->object_ptr;
+    scs_ptr         = (SequenceControlSet *)pcs_ptr->scs_wrapper_ptr->object_ptr;
+
+    Bool     is_16bit      = scs_ptr->is_16bit_pipeline;
+    Av1Common *cm            = pcs_ptr->parent_pcs_ptr->av1_cm;
+    frm_hdr                  = &pcs_ptr->parent_pcs_ptr->frm_hdr;
+    CdefControls *cdef_ctrls = &pcs_ptr->parent_pcs_ptr->cdef_ctrls;
+    if (!cdef_ctrls->use_reference_cdef_fs) {
+        if (scs_ptr->seq_header.cdef_level && pcs_ptr->parent_pcs_ptr->cdef_level) {
+            if (is_16bit)
+                cdef_seg_search16bit(pcs_ptr, scs_ptr, dlf_results_ptr->segment_index);
+            else
+                cdef_seg_search(pcs_ptr, scs_ptr, dlf_results_ptr->segment_index);
         }
-        //all seg based search is done. update total processed segments. if all done, finish the search and perfrom application.
-        svt_block_on_mutex(pcs_ptr->cdef_search_mutex);
-
-        pcs_ptr->tot_seg_searched_cdef++;
-        if (pcs_ptr->tot_seg_searched_cdef == pcs_ptr->cdef_segments_total_count) {
-            // SVT_LOG("    CDEF all seg here  %i\n", pcs_ptr->picture_number);
-            if (scs_ptr->seq_header.cdef_level && pcs_ptr->parent_pcs_ptr->cdef_level) {
-                finish_cdef_search(pcs_ptr);
-
-                if (scs_ptr->seq_header.enable_restoration != 0 ||
-                    pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag ||
-                    scs_ptr->static_config.recon_enabled) {
-                    // Do application iff there are non-zero filters
-                    if (frm_hdr->cdef_params.cdef_y_strength[0] != 0 ||
-                        frm_hdr->cdef_params.cdef_uv_strength[0] != 0 ||
-                        pcs_ptr->parent_pcs_ptr->nb_cdef_strengths != 1) {
-                        if (is_16bit)
-                            av1_cdef_frame16bit(0, scs_ptr, pcs_ptr);
-                        else
-                            svt_av1_cdef_frame(0, scs_ptr, pcs_ptr);
-                    }
+    }
+    //all seg based search is done. update total processed segments. if all done, finish the search and perfrom application.
+    svt_block_on_mutex(pcs_ptr->cdef_search_mutex);
+
+    pcs_ptr->tot_seg_searched_cdef++;
+    if (pcs_ptr->tot_seg_searched_cdef == pcs_ptr->cdef_segments_total_count) {
+        // SVT_LOG("    CDEF all seg here  %i\n", pcs_ptr->picture_number);
+        if (scs_ptr->seq_header.cdef_level && pcs_ptr->parent_pcs_ptr->cdef_level) {
+            finish_cdef_search(pcs_ptr);
+
+            if (scs_ptr->seq_header.enable_restoration != 0 ||
+                pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag ||
+                scs_ptr->static_config.recon_enabled) {
+                // Do application iff there are non-zero filters
+                if (frm_hdr->cdef_params.cdef_y_strength[0] != 0 ||
+                    frm_hdr->cdef_params.cdef_uv_strength[0] != 0 ||
+                    pcs_ptr->parent_pcs_ptr->nb_cdef_strengths != 1) {
+                    if (is_16bit)
+                        av1_cdef_frame16bit(0, scs_ptr, pcs_ptr);
+                    else
+                        svt_av1_cdef_frame(0, scs_ptr, pcs_ptr);
                 }
-            } else {
-                frm_hdr->cdef_params.cdef_bits             = 0;
-                frm_hdr->cdef_params.cdef_y_strength[0]    = 0;
-                pcs_ptr->parent_pcs_ptr->nb_cdef_strengths = 1;
-                frm_hdr->cdef_params.cdef_uv_strength[0]   = 0;
             }
+        } else {
+            frm_hdr->cdef_params.cdef_bits             = 0;
+            frm_hdr->cdef_params.cdef_y_strength[0]    = 0;
+            pcs_ptr->parent_pcs_ptr->nb_cdef_strengths = 1;
+            frm_hdr->cdef_params.cdef_uv_strength[0]   = 0;
+        }
 
-            //restoration prep
-            if (scs_ptr->seq_header.enable_restoration) {
-                svt_av1_loop_restoration_save_boundary_lines(cm->frame_to_show, cm, 1);
-            }
+        //restoration prep
+        if (scs_ptr->seq_header.enable_restoration) {
+            svt_av1_loop_restoration_save_boundary_lines(cm->frame_to_show, cm, 1);
+        }
 
-            // ------- start: Normative upscaling - super-resolution tool
-            if (frm_hdr->allow_intrabc == 0 && !av1_superres_unscaled(&cm->frm_size)) {
-                svt_av1_superres_upscale_frame(cm, pcs_ptr, scs_ptr);
+        // ------- start: Normative upscaling - super-resolution tool
+        if (frm_hdr->allow_intrabc == 0 && !av1_superres_unscaled(&cm->frm_size)) {
+            svt_av1_superres_upscale_frame(cm, pcs_ptr, scs_ptr);
 
-                if (is_16bit) {
-                    set_unscaled_input_16bit(pcs_ptr);
-                }
-            }
-            // ------- end: Normative upscaling - super-resolution tool
-
-            pcs_ptr->rest_segments_column_count = scs_ptr->rest_segment_column_count;
-            pcs_ptr->rest_segments_row_count    = scs_ptr->rest_segment_row_count;
-            pcs_ptr->rest_segments_total_count  = (uint16_t)(pcs_ptr->rest_segments_column_count *
-                                                            pcs_ptr->rest_segments_row_count);
-            pcs_ptr->tot_seg_searched_rest      = 0;
-            pcs_ptr->parent_pcs_ptr->av1_cm->use_boundaries_in_rest_search =
-                scs_ptr->use_boundaries_in_rest_search;
-            pcs_ptr->rest_extend_flag[0] = FALSE;
-            pcs_ptr->rest_extend_flag[1] = FALSE;
-            pcs_ptr->rest_extend_flag[2] = FALSE;
-
-            uint32_t segment_index;
-            for (segment_index = 0; segment_index < pcs_ptr->rest_segments_total_count;
-                 ++segment_index) {
-                // Get Empty Cdef Results to Rest
-                svt_get_empty_object(context_ptr->cdef_output_fifo_ptr, &cdef_results_wrapper_ptr);
-                cdef_results_ptr = (struct CdefResults *)cdef_results_wrapper_ptr->object_ptr;
-                cdef_results_ptr->pcs_wrapper_ptr = dlf_results_ptr->pcs_wrapper_ptr;
-                cdef_results_ptr->segment_index   = segment_index;
-                // Post Cdef Results
-                svt_post_full_object(cdef_results_wrapper_ptr);
+            if (is_16bit) {
+                set_unscaled_input_16bit(pcs_ptr);
             }
         }
-        svt_release_mutex(pcs_ptr->cdef_search_mutex);
+        // ------- end: Normative upscaling - super-resolution tool
+
+        pcs_ptr->rest_segments_column_count = scs_ptr->rest_segment_column_count;
+        pcs_ptr->rest_segments_row_count    = scs_ptr->rest_segment_row_count;
+        pcs_ptr->rest_segments_total_count  = (uint16_t)(pcs_ptr->rest_segments_column_count *
+                                                        pcs_ptr->rest_segments_row_count);
+        pcs_ptr->tot_seg_searched_rest      = 0;
+        pcs_ptr->parent_pcs_ptr->av1_cm->use_boundaries_in_rest_search =
+            scs_ptr->use_boundaries_in_rest_search;
+        pcs_ptr->rest_extend_flag[0] = FALSE;
+        pcs_ptr->rest_extend_flag[1] = FALSE;
+        pcs_ptr->rest_extend_flag[2] = FALSE;
+
+        uint32_t segment_index;
+        for (segment_index = 0; segment_index < pcs_ptr->rest_segments_total_count;
+             ++segment_index) {
+            // Get Empty Cdef Results to Rest
+            svt_get_empty_object(context_ptr->cdef_output_fifo_ptr, &cdef_results_wrapper_ptr);
+            cdef_results_ptr = (struct CdefResults *)cdef_results_wrapper_ptr->object_ptr;
+            cdef_results_ptr->pcs_wrapper_ptr = dlf_results_ptr->pcs_wrapper_ptr;
+            cdef_results_ptr->segment_index   = segment_index;
+            // Post Cdef Results
+            svt_post_full_object(cdef_results_wrapper_ptr);
+        }
+    }
+    svt_release_mutex(pcs_ptr->cdef_search_mutex);
+
+    // Release Dlf Results
+    svt_release_object(dlf_results_wrapper_ptr);
+}
+
+/******************************************************
+ * CDEF Kernel
+ ******************************************************/
+void *cdef_kernel(void *input_ptr) {
+    EbThreadContext *thread_context_ptr = (EbThreadContext *)input_ptr;
+    CdefContext     *context_ptr        = (CdefContext *)thread_context_ptr->priv;
+    EbObjectWrapper *dlf_results_wrapper_ptr;
 
-        // Release Dlf Results
-        svt_release_object(dlf_results_wrapper_ptr);
+    for (;;) {
+        // Get DLF Results
+        EB_GET_FULL_OBJECT(context_ptr->cdef_input_fifo_ptr, &dlf_results_wrapper_ptr);
+        cdef_process_task(thread_context_ptr, dlf_results_wrapper_ptr);
     }
 
     return NULL;
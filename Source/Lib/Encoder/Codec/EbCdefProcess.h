@@ -22,5 +22,7 @@ extern EbErrorType cdef_context_ctor(EbThreadContext   *thread_context_ptr,
                                      const EbEncHandle *enc_handle_ptr, int index);
 
 extern void *cdef_kernel(void *input_ptr);
+extern void cdef_process_task(EbThreadContext *thread_context_ptr,
+                              EbObjectWrapper *dlf_results_wrapper_ptr);
 
 #endif
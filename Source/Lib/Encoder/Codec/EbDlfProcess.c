@@ -19,6 +19,8 @@
 #include "EbDefinitions.h"
 #include "EbSequenceControlSet.h"
 #include "EbPictureControlSet.h"
+#include "EbEncDecSegments.h"
+#include "EbUtility.h"
 #include "aom_dsp_rtcd.h"
 void get_recon_pic(PictureControlSet *pcs_ptr, EbPictureBufferDesc **recon_ptr, Bool is_highbd);
 void svt_av1_loop_restoration_save_boundary_lines(const Yv12BufferConfig *frame, Av1Common *cm,
@@ -38,7 +40,7 @@ static void dlf_context_dctor(EbPtr p) {
  * Dlf Context Constructor
  ******************************************************/
 EbErrorType dlf_context_ctor(EbThreadContext *thread_context_ptr, const EbEncHandle *enc_handle_ptr,
-                             int index) {
+                             int index, int tasks_index) {
     DlfContext *context_ptr;
     EB_CALLOC_ARRAY(context_ptr, 1);
     thread_context_ptr->priv  = context_ptr;
@@ -49,37 +51,224 @@ EbErrorType dlf_context_ctor(EbThreadContext *thread_context_ptr, const EbEncHan
         enc_handle_ptr->enc_dec_results_resource_ptr, index);
     context_ptr->dlf_output_fifo_ptr = svt_system_resource_get_producer_fifo(
         enc_handle_ptr->dlf_results_resource_ptr, index);
+    context_ptr->dlf_feedback_fifo_ptr = svt_system_resource_get_producer_fifo(
+        enc_handle_ptr->enc_dec_results_resource_ptr, tasks_index);
     return EB_ErrorNone;
 }
 
 /******************************************************
- * Dlf Kernel
+ * Assign DLF segments
+ * Same wavefront as the EncDec segments: a segment is released once its
+ * left and top-right neighbours are filtered. This guarantees that the
+ * SB above and the SB on the left are filtered before the current SB, which
+ * is what loop_filter_sb() expects when filtering in raster order.
  ******************************************************/
-void *dlf_kernel(void *input_ptr) {
+static Bool assign_dlf_segments(EncDecSegments *segment_ptr, uint16_t *segment_in_out_index,
+                                EncDecResults *task_ptr, EbFifo *srm_fifo_ptr) {
+    Bool     continue_processing_flag = FALSE;
+    uint32_t row_segment_index        = 0;
+    uint32_t segment_index;
+    uint32_t right_segment_index;
+    uint32_t bottom_left_segment_index;
+    int16_t  feedback_row_index = -1;
+    Bool     self_assigned      = FALSE;
+
+    switch (task_ptr->input_type) {
+    case DLF_TASKS_ENCDEC_INPUT:
+        // The entire picture is provided by the EncDec process, so
+        //   no logic is necessary to clear input dependencies.
+        for (uint32_t row_index = 0; row_index < segment_ptr->segment_row_count; ++row_index) {
+            segment_ptr->row_array[row_index].current_seg_index =
+                segment_ptr->row_array[row_index].starting_seg_index;
+        }
+        // Start on Segment 0 immediately
+        *segment_in_out_index = segment_ptr->row_array[0].current_seg_index;
+        task_ptr->input_type  = DLF_TASKS_CONTINUE;
+        ++segment_ptr->row_array[0].current_seg_index;
+        continue_processing_flag = TRUE;
+        break;
+
+    case DLF_TASKS_DLF_INPUT:
+        // Start on the assigned row immediately
+        *segment_in_out_index =
+            segment_ptr->row_array[task_ptr->dlf_segment_row].current_seg_index;
+        task_ptr->input_type = DLF_TASKS_CONTINUE;
+        ++segment_ptr->row_array[task_ptr->dlf_segment_row].current_seg_index;
+        continue_processing_flag = TRUE;
+        break;
+
+    case DLF_TASKS_CONTINUE:
+        // Update the Dependency List for Right and Bottom Neighbors
+        segment_index     = *segment_in_out_index;
+        row_segment_index = segment_index / segment_ptr->segment_band_count;
+
+        right_segment_index       = segment_index + 1;
+        bottom_left_segment_index = segment_index + segment_ptr->segment_band_count;
+
+        // Right Neighbor
+        if (segment_index < segment_ptr->row_array[row_segment_index].ending_seg_index) {
+            svt_block_on_mutex(segment_ptr->row_array[row_segment_index].assignment_mutex);
+
+            --segment_ptr->dep_map.dependency_map[right_segment_index];
+
+            if (segment_ptr->dep_map.dependency_map[right_segment_index] == 0) {
+                *segment_in_out_index = segment_ptr->row_array[row_segment_index].current_seg_index;
+                ++segment_ptr->row_array[row_segment_index].current_seg_index;
+                self_assigned            = TRUE;
+                continue_processing_flag = TRUE;
+            }
+
+            svt_release_mutex(segment_ptr->row_array[row_segment_index].assignment_mutex);
+        }
+
+        // Bottom-left Neighbor
+        if (row_segment_index < segment_ptr->segment_row_count - 1 &&
+            bottom_left_segment_index >=
+                segment_ptr->row_array[row_segment_index + 1].starting_seg_index) {
+            svt_block_on_mutex(segment_ptr->row_array[row_segment_index + 1].assignment_mutex);
+
+            --segment_ptr->dep_map.dependency_map[bottom_left_segment_index];
+
+            if (segment_ptr->dep_map.dependency_map[bottom_left_segment_index] == 0) {
+                if (self_assigned == TRUE)
+                    feedback_row_index = (int16_t)row_segment_index + 1;
+                else {
+                    *segment_in_out_index =
+                        segment_ptr->row_array[row_segment_index + 1].current_seg_index;
+                    ++segment_ptr->row_array[row_segment_index + 1].current_seg_index;
+                    continue_processing_flag = TRUE;
+                }
+            }
+            svt_release_mutex(segment_ptr->row_array[row_segment_index + 1].assignment_mutex);
+        }
+
+        if (feedback_row_index > 0) {
+            EbObjectWrapper *feedback_wrapper_ptr;
+            svt_get_empty_object(srm_fifo_ptr, &feedback_wrapper_ptr);
+            EncDecResults *feedback_ptr   = (EncDecResults *)feedback_wrapper_ptr->object_ptr;
+            feedback_ptr->pcs_wrapper_ptr = task_ptr->pcs_wrapper_ptr;
+            feedback_ptr->input_type      = DLF_TASKS_DLF_INPUT;
+            feedback_ptr->dlf_segment_row = feedback_row_index;
+            svt_post_full_object(feedback_wrapper_ptr);
+        }
+        break;
+
+    default: break;
+    }
+
+    return continue_processing_flag;
+}
+
+/******************************************************
+ * Post the CDEF segments of the segment rows [start_row, end_row)
+ ******************************************************/
+static void post_cdef_segment_rows(DlfContext *context_ptr, EbObjectWrapper *pcs_wrapper_ptr,
+                                   PictureControlSet *pcs_ptr, uint32_t start_row,
+                                   uint32_t end_row) {
+    for (uint32_t segment_index = start_row * pcs_ptr->cdef_segments_column_count;
+         segment_index < end_row * pcs_ptr->cdef_segments_column_count;
+         ++segment_index) {
+        EbObjectWrapper *dlf_results_wrapper_ptr;
+        // Get Empty DLF Results to Cdef
+        svt_get_empty_object(context_ptr->dlf_output_fifo_ptr, &dlf_results_wrapper_ptr);
+        DlfResults *dlf_results_ptr      = (DlfResults *)dlf_results_wrapper_ptr->object_ptr;
+        dlf_results_ptr->pcs_wrapper_ptr = pcs_wrapper_ptr;
+        dlf_results_ptr->segment_index   = segment_index;
+        // Post DLF Results
+        svt_post_full_object(dlf_results_wrapper_ptr);
+    }
+}
+
+/******************************************************
+ * Post the CDEF segments once the whole picture is filtered.
+ * The restoration boundary lines are saved from the deblocked frame, so
+ * they have to be saved before the last CDEF segment can trigger the CDEF
+ * application.
+ ******************************************************/
+static void dlf_picture_done(DlfContext *context_ptr, EbObjectWrapper *pcs_wrapper_ptr,
+                             PictureControlSet *pcs_ptr, uint32_t start_row) {
+    SequenceControlSet *scs_ptr = pcs_ptr->parent_pcs_ptr->scs_ptr;
+    if (scs_ptr->seq_header.enable_restoration)
+        svt_av1_loop_restoration_save_boundary_lines(
+            pcs_ptr->parent_pcs_ptr->av1_cm->frame_to_show, pcs_ptr->parent_pcs_ptr->av1_cm, 0);
+    post_cdef_segment_rows(
+        context_ptr, pcs_wrapper_ptr, pcs_ptr, start_row, pcs_ptr->cdef_segments_row_count);
+}
+
+/******************************************************
+ * Update the filtered SB rows after filtering sb_count SBs of the SB row
+ * y_sb_index, and release the CDEF segment rows that only depend on fully
+ * filtered SB rows. A CDEF segment row also reads (and is modified by the
+ * horizontal edges of) the first 64x64 row below it, so that row must be
+ * filtered too.
+ ******************************************************/
+static void dlf_sb_row_update(DlfContext *context_ptr, EbObjectWrapper *pcs_wrapper_ptr,
+                              PictureControlSet *pcs_ptr, uint32_t y_sb_index, uint32_t sb_count,
+                              uint32_t pic_width_in_sb, uint32_t pic_height_in_sb,
+                              uint32_t sb_size) {
+    uint32_t picture_height_in_b64 = (pcs_ptr->parent_pcs_ptr->aligned_height + 64 - 1) / 64;
+    uint32_t start_row, end_row;
+    Bool     last_row_flag;
+
+    svt_block_on_mutex(pcs_ptr->dlf_mutex);
+    pcs_ptr->dlf_sb_row_filtered_count[y_sb_index] += (uint16_t)sb_count;
+    while (pcs_ptr->dlf_sb_rows_done < pic_height_in_sb &&
+           pcs_ptr->dlf_sb_row_filtered_count[pcs_ptr->dlf_sb_rows_done] == pic_width_in_sb)
+        pcs_ptr->dlf_sb_rows_done++;
+    last_row_flag = pcs_ptr->dlf_sb_rows_done == pic_height_in_sb;
+
+    start_row = end_row = pcs_ptr->cdef_segments_row_posted;
+    if (!last_row_flag) {
+        while (end_row < pcs_ptr->cdef_segments_row_count) {
+            uint32_t y_b64_end_idx = SEGMENT_END_IDX(
+                end_row, picture_height_in_b64, pcs_ptr->cdef_segments_row_count);
+            if ((y_b64_end_idx << 6) / sb_size + 1 > pcs_ptr->dlf_sb_rows_done)
+                break;
+            end_row++;
+        }
+    } else
+        end_row = pcs_ptr->cdef_segments_row_count;
+    pcs_ptr->cdef_segments_row_posted = (uint8_t)end_row;
+    svt_release_mutex(pcs_ptr->dlf_mutex);
+
+    if (last_row_flag)
+        dlf_picture_done(context_ptr, pcs_wrapper_ptr, pcs_ptr, start_row);
+    else if (end_row > start_row)
+        post_cdef_segment_rows(context_ptr, pcs_wrapper_ptr, pcs_ptr, start_row, end_row);
+}
+
+/******************************************************
+ * Dlf Task
+ *   Filters the segments of one EncDec result
+ ******************************************************/
+void dlf_process_task(EbThreadContext *thread_context_ptr,
+                      EbObjectWrapper *enc_dec_results_wrapper_ptr) {
     // Context & SCS & PCS
-    EbThreadContext    *thread_context_ptr = (EbThreadContext *)input_ptr;
     DlfContext         *context_ptr        = (DlfContext *)thread_context_ptr->priv;
     PictureControlSet  *pcs_ptr;
     SequenceControlSet *scs_ptr;
 
     //// Input
-    EbObjectWrapper *enc_dec_results_wrapper_ptr;
     EncDecResults   *enc_dec_results_ptr;
 
-    //// Output
-    EbObjectWrapper   *dlf_results_wrapper_ptr;
-    struct DlfResults *dlf_results_ptr;
-
     // SB Loop variables
-    for (;;) {
-        // Get EncDec Results
-        EB_GET_FULL_OBJECT(context_ptr->dlf_input_fifo_ptr, &enc_dec_results_wrapper_ptr);
 
-        enc_dec_results_ptr = (EncDecResults *)enc_dec_results_wrapper_ptr->object_ptr;
-        pcs_ptr             = (PictureControlSet *)enc_dec_results_ptr->pcs_wrapper_ptr->object_ptr;
-        scs_ptr             = (SequenceControlSet *)pcs_ptr->scs_wrapper_ptr->object_ptr;
+    enc_dec_results_ptr = (EncDecResults *)enc_dec_results_wrapper_ptr->object_ptr;
+    pcs_ptr             = (PictureControlSet *)enc_dec_results_ptr->pcs_wrapper_ptr->object_ptr;
+    scs_ptr             = (SequenceControlSet *)pcs_ptr->scs_wrapper_ptr->object_ptr;
 
-        Bool is_16bit = scs_ptr->is_16bit_pipeline;
+    Bool     is_16bit         = scs_ptr->is_16bit_pipeline;
+    uint8_t  sb_size_log2     = (uint8_t)svt_log2f(scs_ptr->sb_size_pix);
+    uint32_t pic_width_in_sb  = (pcs_ptr->parent_pcs_ptr->aligned_width +
+                                scs_ptr->sb_size_pix - 1) >>
+        sb_size_log2;
+    uint32_t pic_height_in_sb = (pcs_ptr->parent_pcs_ptr->aligned_height +
+                                 scs_ptr->sb_size_pix - 1) >>
+        sb_size_log2;
+    EbPictureBufferDesc *recon_buffer;
+    get_recon_pic(pcs_ptr, &recon_buffer, is_16bit);
+
+    if (enc_dec_results_ptr->input_type == DLF_TASKS_ENCDEC_INPUT) {
         if (is_16bit && scs_ptr->static_config.encoder_bit_depth == EB_8BIT) {
             svt_convert_pic_8bit_to_16bit(pcs_ptr->parent_pcs_ptr->enhanced_picture_ptr,
                                           pcs_ptr->input_frame16bit,
@@ -97,21 +286,22 @@ void *dlf_kernel(void *input_ptr) {
                                               pcs_ptr->parent_pcs_ptr->scs_ptr->subsampling_y);
             }
         }
-        Bool         dlf_enable_flag = (Bool)pcs_ptr->parent_pcs_ptr->dlf_ctrls.enabled;
+        Bool           dlf_enable_flag = (Bool)pcs_ptr->parent_pcs_ptr->dlf_ctrls.enabled;
         const uint16_t tg_count        = pcs_ptr->parent_pcs_ptr->tile_group_cols *
             pcs_ptr->parent_pcs_ptr->tile_group_rows;
         // Move sb level lf to here if tile_parallel
-        if ((dlf_enable_flag && !pcs_ptr->parent_pcs_ptr->dlf_ctrls.sb_based_dlf) ||
-            (dlf_enable_flag && pcs_ptr->parent_pcs_ptr->dlf_ctrls.sb_based_dlf && tg_count > 1)) {
-            EbPictureBufferDesc *recon_buffer;
-            get_recon_pic(pcs_ptr, &recon_buffer, is_16bit);
+        Bool frame_dlf_flag = (dlf_enable_flag &&
+                               !pcs_ptr->parent_pcs_ptr->dlf_ctrls.sb_based_dlf) ||
+            (dlf_enable_flag && pcs_ptr->parent_pcs_ptr->dlf_ctrls.sb_based_dlf &&
+             tg_count > 1);
+        if (frame_dlf_flag) {
             svt_av1_loop_filter_init(pcs_ptr);
             svt_av1_pick_filter_level(
                 (EbPictureBufferDesc *)pcs_ptr->parent_pcs_ptr->enhanced_picture_ptr,
                 pcs_ptr,
                 LPF_PICK_FROM_FULL_IMAGE);
-
-            svt_av1_loop_filter_frame(recon_buffer, pcs_ptr, 0, 3);
+            svt_av1_loop_filter_frame_init(
+                &pcs_ptr->parent_pcs_ptr->frm_hdr, &pcs_ptr->parent_pcs_ptr->lf_info, 0, 3);
         }
 
         //pre-cdef prep
@@ -124,8 +314,6 @@ void *dlf_kernel(void *input_ptr) {
                                        scs_ptr->max_input_pad_right,
                                        scs_ptr->max_input_pad_bottom,
                                        is_16bit);
-            if (scs_ptr->seq_header.enable_restoration)
-                svt_av1_loop_restoration_save_boundary_lines(cm->frame_to_show, cm, 0);
             if (scs_ptr->seq_header.cdef_level && pcs_ptr->parent_pcs_ptr->cdef_level) {
                 if (is_16bit) {
                     pcs_ptr->src[0] = (uint16_t *)recon_picture_ptr->buffer_y +
@@ -188,26 +376,101 @@ void *dlf_kernel(void *input_ptr) {
             }
         }
 
+
         pcs_ptr->cdef_segments_column_count = scs_ptr->cdef_segment_column_count;
         pcs_ptr->cdef_segments_row_count    = scs_ptr->cdef_segment_row_count;
         pcs_ptr->cdef_segments_total_count  = (uint16_t)(pcs_ptr->cdef_segments_column_count *
                                                         pcs_ptr->cdef_segments_row_count);
         pcs_ptr->tot_seg_searched_cdef      = 0;
-        uint32_t segment_index;
-
-        for (segment_index = 0; segment_index < pcs_ptr->cdef_segments_total_count;
-             ++segment_index) {
-            // Get Empty DLF Results to Cdef
-            svt_get_empty_object(context_ptr->dlf_output_fifo_ptr, &dlf_results_wrapper_ptr);
-            dlf_results_ptr = (struct DlfResults *)dlf_results_wrapper_ptr->object_ptr;
-            dlf_results_ptr->pcs_wrapper_ptr = enc_dec_results_ptr->pcs_wrapper_ptr;
-            dlf_results_ptr->segment_index   = segment_index;
-            // Post DLF Results
-            svt_post_full_object(dlf_results_wrapper_ptr);
+        pcs_ptr->cdef_segments_row_posted   = 0;
+
+        if (!frame_dlf_flag) {
+            // Nothing to filter: the whole picture is available to CDEF
+            dlf_picture_done(context_ptr, enc_dec_results_ptr->pcs_wrapper_ptr, pcs_ptr, 0);
+            // Release EncDec Results
+            svt_release_object(enc_dec_results_wrapper_ptr);
+            return;
         }
+        // Init the DLF segments, the filtering is spread over the DLF threads
+        enc_dec_segments_init(pcs_ptr->dlf_segment_ctrl,
+                              scs_ptr->dlf_segment_column_count,
+                              scs_ptr->dlf_segment_row_count,
+                              pic_width_in_sb,
+                              pic_height_in_sb);
+        memset(pcs_ptr->dlf_sb_row_filtered_count,
+               0,
+               sizeof(*pcs_ptr->dlf_sb_row_filtered_count) * pic_height_in_sb);
+        pcs_ptr->dlf_sb_rows_done = 0;
+    }
+
+    EncDecSegments *segments_ptr = pcs_ptr->dlf_segment_ctrl;
+    uint16_t        segment_index = 0;
+    // Segment-loop
+    while (assign_dlf_segments(segments_ptr,
+                               &segment_index,
+                               enc_dec_results_ptr,
+                               context_ptr->dlf_feedback_fifo_ptr) == TRUE) {
+        uint32_t x_sb_start_index = segments_ptr->x_start_array[segment_index];
+        uint32_t y_sb_start_index = segments_ptr->y_start_array[segment_index];
+        uint32_t sb_start_index   = y_sb_start_index * pic_width_in_sb + x_sb_start_index;
+        uint32_t sb_segment_count = segments_ptr->valid_sb_count_array[segment_index];
+
+        uint32_t segment_row_index  = segment_index / segments_ptr->segment_band_count;
+        uint32_t segment_band_index = segment_index -
+            segment_row_index * segments_ptr->segment_band_count;
+        uint32_t segment_band_size = (segments_ptr->sb_band_count * (segment_band_index + 1) +
+                                      segments_ptr->segment_band_count - 1) /
+            segments_ptr->segment_band_count;
+        uint32_t sb_segment_index;
+        uint32_t x_sb_index;
+        uint32_t y_sb_index;
+
+        for (y_sb_index = y_sb_start_index, sb_segment_index = sb_start_index;
+             sb_segment_index < sb_start_index + sb_segment_count;
+             ++y_sb_index) {
+            uint32_t row_sb_count = 0;
+            for (x_sb_index = x_sb_start_index; x_sb_index < pic_width_in_sb &&
+                 (x_sb_index + y_sb_index < segment_band_size) &&
+                 sb_segment_index < sb_start_index + sb_segment_count;
+                 ++x_sb_index, ++sb_segment_index) {
+                loop_filter_sb(recon_buffer,
+                               pcs_ptr,
+                               (y_sb_index << sb_size_log2) >> 2,
+                               (x_sb_index << sb_size_log2) >> 2,
+                               0,
+                               3,
+                               x_sb_index == pic_width_in_sb - 1);
+                row_sb_count++;
+            }
+            if (row_sb_count)
+                dlf_sb_row_update(context_ptr,
+                                  enc_dec_results_ptr->pcs_wrapper_ptr,
+                                  pcs_ptr,
+                                  y_sb_index,
+                                  row_sb_count,
+                                  pic_width_in_sb,
+                                  pic_height_in_sb,
+                                  scs_ptr->sb_size_pix);
+            x_sb_start_index = (x_sb_start_index > 0) ? x_sb_start_index - 1 : 0;
+        }
+    }
+
+    // Release EncDec Results
+    svt_release_object(enc_dec_results_wrapper_ptr);
+}
 
-        // Release EncDec Results
-        svt_release_object(enc_dec_results_wrapper_ptr);
+/******************************************************
+ * Dlf Kernel
+ ******************************************************/
+void *dlf_kernel(void *input_ptr) {
+    EbThreadContext *thread_context_ptr = (EbThreadContext *)input_ptr;
+    DlfContext      *context_ptr        = (DlfContext *)thread_context_ptr->priv;
+    EbObjectWrapper *enc_dec_results_wrapper_ptr;
+
+    for (;;) {
+        // Get EncDec Results
+        EB_GET_FULL_OBJECT(context_ptr->dlf_input_fifo_ptr, &enc_dec_results_wrapper_ptr);
+        dlf_process_task(thread_context_ptr, enc_dec_results_wrapper_ptr);
     }
 
     return NULL;
@@ -23,14 +23,18 @@
 typedef struct DlfContext {
     EbFifo *dlf_input_fifo_ptr;
     EbFifo *dlf_output_fifo_ptr;
+    EbFifo *dlf_feedback_fifo_ptr;
 } DlfContext;
 
 /**************************************
  * Extern Function Declarations
  **************************************/
 extern EbErrorType dlf_context_ctor(EbThreadContext   *thread_context_ptr,
-                                    const EbEncHandle *enc_handle_ptr, int index);
+                                    const EbEncHandle *enc_handle_ptr, int index,
+                                    int tasks_index);
 
 extern void *dlf_kernel(void *input_ptr);
+extern void dlf_process_task(EbThreadContext *thread_context_ptr,
+                             EbObjectWrapper *enc_dec_results_wrapper_ptr);
 
 #endif // EbEntropyCodingProcess_h
@@ -21,15 +21,19 @@
 #include "grainSynthesis.h"
 //To fix warning C4013: 'svt_convert_16bit_to_8bit' undefined; assuming extern returning int
 #include "common_dsp_rtcd.h"
+#include "aom_dsp_rtcd.h"
 #include "EbRateDistortionCost.h"
 #include "EbPictureDecisionProcess.h"
 #include "firstpass.h"
 #include "EbPictureAnalysisProcess.h"
+#include "EbEntropyCodingProcess.h"
+#include "EbTime.h"
 void get_recon_pic(PictureControlSet *pcs_ptr, EbPictureBufferDesc **recon_ptr, Bool is_highbd);
 int  svt_av1_allow_palette(int allow_palette, BlockSize sb_type);
 #define FC_SKIP_TX_SR_TH025 125 // Fast cost skip tx search threshold.
 #define FC_SKIP_TX_SR_TH010 110 // Fast cost skip tx search threshold.
-void copy_mv_rate(PictureControlSet *pcs, MdRateEstimationContext *dst_rate);
+void copy_mv_rate(PictureControlSet *pcs, MdRateEstimationContext *dst_rate,
+                  MdRateEstimationCache *dst_cache);
 void svt_av1_cdef_search(EncDecContext *context_ptr, SequenceControlSet *scs_ptr,
                          PictureControlSet *pcs_ptr);
 
@@ -102,6 +106,7 @@ EbErrorType enc_dec_context_ctor(EbThreadContext   *thread_context_ptr,
 
     context_ptr->is_16bit     = enc_handle_ptr->scs_instance_array[0]->scs_ptr->is_16bit_pipeline;
     context_ptr->color_format = color_format;
+    svt_av1_crc_calculator_init(&context_ptr->crc_calculator, 24, 0x5D6DCB);
 
     // Input/Output System Resource Manager FIFOs
     context_ptr->mode_decision_input_fifo_ptr = svt_system_resource_get_consumer_fifo(
@@ -622,9 +627,9 @@ void recon_output(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr) {
 // Calculate Frame SSIM
 /************************************/
 
-static void svt_aom_ssim_parms_8x8_c(const uint8_t *s, int sp, const uint8_t *r, int rp,
-                                     uint32_t *sum_s, uint32_t *sum_r, uint32_t *sum_sq_s,
-                                     uint32_t *sum_sq_r, uint32_t *sum_sxr) {
+void svt_aom_ssim_parms_8x8_c(const uint8_t *s, int sp, const uint8_t *r, int rp, uint32_t *sum_s,
+                              uint32_t *sum_r, uint32_t *sum_sq_s, uint32_t *sum_sq_r,
+                              uint32_t *sum_sxr) {
     int i, j;
     for (i = 0; i < 8; i++, s += sp, r += rp) {
         for (j = 0; j < 8; j++) {
@@ -637,10 +642,9 @@ static void svt_aom_ssim_parms_8x8_c(const uint8_t *s, int sp, const uint8_t *r,
     }
 }
 
-static void svt_aom_highbd_ssim_parms_8x8_c(const uint8_t *s, int sp, const uint8_t *sinc,
-                                            int spinc, const uint16_t *r, int rp, uint32_t *sum_s,
-                                            uint32_t *sum_r, uint32_t *sum_sq_s, uint32_t *sum_sq_r,
-                                            uint32_t *sum_sxr) {
+void svt_aom_highbd_ssim_parms_8x8_c(const uint8_t *s, int sp, const uint8_t *sinc, int spinc,
+                                     const uint16_t *r, int rp, uint32_t *sum_s, uint32_t *sum_r,
+                                     uint32_t *sum_sq_s, uint32_t *sum_sq_r, uint32_t *sum_sxr) {
     int      i, j;
     uint32_t ss;
     for (i = 0; i < 8; i++, s += sp, sinc += spinc, r += rp) {
@@ -693,14 +697,14 @@ static double similarity(uint32_t sum_s, uint32_t sum_r, uint32_t sum_sq_s, uint
 
 static double ssim_8x8(const uint8_t *s, int sp, const uint8_t *r, int rp) {
     uint32_t sum_s = 0, sum_r = 0, sum_sq_s = 0, sum_sq_r = 0, sum_sxr = 0;
-    svt_aom_ssim_parms_8x8_c(s, sp, r, rp, &sum_s, &sum_r, &sum_sq_s, &sum_sq_r, &sum_sxr);
+    svt_aom_ssim_parms_8x8(s, sp, r, rp, &sum_s, &sum_r, &sum_sq_s, &sum_sq_r, &sum_sxr);
     return similarity(sum_s, sum_r, sum_sq_s, sum_sq_r, sum_sxr, 64, 8);
 }
 
 static double highbd_ssim_8x8(const uint8_t *s, int sp, const uint8_t *sinc, int spinc,
                               const uint16_t *r, int rp, uint32_t bd, uint32_t shift) {
     uint32_t sum_s = 0, sum_r = 0, sum_sq_s = 0, sum_sq_r = 0, sum_sxr = 0;
-    svt_aom_highbd_ssim_parms_8x8_c(
+    svt_aom_highbd_ssim_parms_8x8(
         s, sp, sinc, spinc, r, rp, &sum_s, &sum_r, &sum_sq_s, &sum_sq_r, &sum_sxr);
     return similarity(sum_s >> shift,
                       sum_r >> shift,
@@ -1876,6 +1880,8 @@ void copy_statistics_to_ref_obj_ect(PictureControlSet *pcs_ptr, SequenceControlS
             ->sb_skip[sb_index] = pcs_ptr->sb_skip[sb_index];
         ((EbReferenceObject *)pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)
             ->sb_64x64_mvp[sb_index] = pcs_ptr->sb_64x64_mvp[sb_index];
+        ((EbReferenceObject *)pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)
+            ->sb_src_hash[sb_index] = pcs_ptr->sb_src_hash[sb_index];
         ((EbReferenceObject *)pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)
             ->sb_me_64x64_dist[sb_index] = pcs_ptr->parent_pcs_ptr->me_64x64_distortion[sb_index];
         ((EbReferenceObject *)pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)
@@ -4710,6 +4716,19 @@ that use 8x8 blocks will lose significant BD-Rate as the parent 16x16 me data wi
             ctx->depth_removal_ctrls.disallow_below_16x16 = FALSE;
     }
 
+    // Static SB of the ROI map, only test the 64x64 blocks
+    if (pcs_ptr->parent_pcs_ptr->roi_skip_present && pcs_ptr->slice_type != I_SLICE &&
+        pcs_ptr->parent_pcs_ptr->roi_skip_map[ctx->sb_index] && sb_params->width % 64 == 0 &&
+        sb_params->height % 64 == 0) {
+        ctx->depth_removal_ctrls.enabled              = 1;
+        ctx->depth_removal_ctrls.disallow_below_64x64 = 1;
+    }
+    // Static SB, only test the 64x64 block as the reference did
+    if (ctx->static_sb) {
+        ctx->depth_removal_ctrls.enabled              = 1;
+        ctx->depth_removal_ctrls.disallow_below_64x64 = 1;
+    }
+
     set_lpd1_ctrls(ctx, pcs_ptr->pic_lpd1_lvl);
     return return_error;
 }
@@ -5847,7 +5866,7 @@ EbErrorType signal_derivation_enc_dec_kernel_oq(SequenceControlSet *scs, Picture
         context_ptr->md_disallow_nsq = enc_mode <= ENC_M0 ? ppcs->disallow_nsq : 1;
     else {
         // Update nsq settings based on the sb_class
-        context_ptr->md_disallow_nsq = ppcs->disallow_nsq;
+        context_ptr->md_disallow_nsq = ppcs->disallow_nsq || context_ptr->static_sb;
     }
 
     if (pd_pass == PD_PASS_0)
@@ -6795,13 +6814,15 @@ EbErrorType build_starting_cand_block_array(SequenceControlSet *scs_ptr, Picture
 void recode_loop_update_q(PictureParentControlSet *ppcs_ptr, int *const loop, int *const q,
                           int *const q_low, int *const q_high, const int top_index,
                           const int bottom_index, int *const undershoot_seen,
-                          int *const overshoot_seen, int *const low_cr_seen, const int loop_count);
+                          int *const overshoot_seen, int *const low_cr_seen, const int loop_count,
+                          const uint32_t coded_sb_count);
 void sb_qp_derivation_tpl_la(PictureControlSet *pcs_ptr);
+void roi_map_setup_segmentation(PictureControlSet *pcs_ptr);
 void mode_decision_configuration_init_qp_update(PictureControlSet *pcs_ptr);
 void init_enc_dec_segement(PictureParentControlSet *parentpicture_control_set_ptr);
 
 static void recode_loop_decision_maker(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr,
-                                       Bool *do_recode) {
+                                       Bool *do_recode, uint32_t coded_sb_count) {
     PictureParentControlSet *ppcs_ptr           = pcs_ptr->parent_pcs_ptr;
     EncodeContext *const     encode_context_ptr = ppcs_ptr->scs_ptr->encode_context_ptr;
     RATE_CONTROL *const      rc                 = &(encode_context_ptr->rc);
@@ -6824,7 +6845,8 @@ static void recode_loop_decision_maker(PictureControlSet *pcs_ptr, SequenceContr
                          &ppcs_ptr->undershoot_seen,
                          &ppcs_ptr->overshoot_seen,
                          &ppcs_ptr->low_cr_seen,
-                         ppcs_ptr->loop_count);
+                         ppcs_ptr->loop_count,
+                         coded_sb_count);
 
     // Special case for overlay frame.
 #if FRFCTR_RC_P2
@@ -6852,7 +6874,7 @@ static void recode_loop_decision_maker(PictureControlSet *pcs_ptr, SequenceContr
 
         // 2pass QPM with tpl_la
         if (scs_ptr->static_config.enable_adaptive_quantization == 2 &&
-            ppcs_ptr->tpl_ctrls.enable && ppcs_ptr->r0 != 0)
+            ppcs_ptr->tpl_ctrls.enable && ppcs_ptr->r0 != 0 && !ppcs_ptr->roi_map_present)
             sb_qp_derivation_tpl_la(pcs_ptr);
         else {
             ppcs_ptr->frm_hdr.delta_q_params.delta_q_present = 0;
@@ -6861,11 +6883,186 @@ static void recode_loop_decision_maker(PictureControlSet *pcs_ptr, SequenceContr
                 sb_ptr->qindex     = quantizer_to_qindex[pcs_ptr->picture_qp];
             }
         }
+        // The segment offsets follow the new frame qindex
+        if (scs_ptr->static_config.enable_roi_map)
+            roi_map_setup_segmentation(pcs_ptr);
     } else {
         ppcs_ptr->loop_count = 0;
     }
 }
 
+// Segment row held until the recode decision of the SB row recode
+static uint32_t sb_row_recode_segment_row(const EncDecSegments *segments_ptr) {
+    return segments_ptr->segment_row_count >> 1;
+}
+
+/******************************************************
+ * sb_row_recode_init
+ *   Called before the EncDec tasks of a picture are posted.
+ *   For the pictures with sb_row_recode, holds the segment row
+ *   in the middle of the picture (one more dependency on its
+ *   first segment) until the SB rows above it are coded.
+ ******************************************************/
+void sb_row_recode_init(PictureControlSet *pcs_ptr) {
+    pcs_ptr->sb_row_recode_sb_count = 0;
+    if (!pcs_ptr->parent_pcs_ptr->sb_row_recode)
+        return;
+
+    EncDecSegments *segments_ptr    = pcs_ptr->enc_dec_segment_ctrl[0];
+    const uint32_t  row_index       = sb_row_recode_segment_row(segments_ptr);
+    const uint32_t  pic_width_in_sb = pcs_ptr->sb_total_count_pix / segments_ptr->sb_row_count;
+    // First SB row of the segment row, see enc_dec_segments_init
+    const uint32_t sb_row = ((row_index * segments_ptr->sb_row_count) +
+                             (segments_ptr->segment_row_count - 1)) /
+        segments_ptr->segment_row_count;
+
+    ++segments_ptr->dep_map.dependency_map[segments_ptr->row_array[row_index].starting_seg_index];
+    pcs_ptr->sb_row_recode_sb_count = (uint16_t)(sb_row * pic_width_in_sb);
+}
+
+/******************************************************
+ * post_enc_dec_recode_tasks
+ *   Restarts the EncDec of the picture from the first SB.
+ ******************************************************/
+static void post_enc_dec_recode_tasks(PictureControlSet *pcs_ptr, EbObjectWrapper *pcs_wrapper_ptr,
+                                      EbFifo *enc_dec_feedback_fifo_ptr) {
+    pcs_ptr->enc_dec_coded_sb_count = 0;
+    // re-init mode decision configuration for qp update for re-encode frame
+    mode_decision_configuration_init_qp_update(pcs_ptr);
+    // init segment for re-encode frame
+    init_enc_dec_segement(pcs_ptr->parent_pcs_ptr);
+    EbObjectWrapper *enc_dec_re_encode_tasks_wrapper_ptr;
+    uint16_t         tg_count = pcs_ptr->parent_pcs_ptr->tile_group_cols *
+        pcs_ptr->parent_pcs_ptr->tile_group_rows;
+    for (uint16_t tile_group_idx = 0; tile_group_idx < tg_count; tile_group_idx++) {
+        svt_get_empty_object(enc_dec_feedback_fifo_ptr, &enc_dec_re_encode_tasks_wrapper_ptr);
+
+        EncDecTasks *enc_dec_re_encode_tasks_ptr =
+            (EncDecTasks *)enc_dec_re_encode_tasks_wrapper_ptr->object_ptr;
+        enc_dec_re_encode_tasks_ptr->pcs_wrapper_ptr  = pcs_wrapper_ptr;
+        enc_dec_re_encode_tasks_ptr->input_type       = ENCDEC_TASKS_MDC_INPUT;
+        enc_dec_re_encode_tasks_ptr->tile_group_index = tile_group_idx;
+
+        // Post the Full Results Object
+        svt_post_full_object(enc_dec_re_encode_tasks_wrapper_ptr);
+    }
+}
+
+/******************************************************
+ * sb_row_recode_decision_maker
+ *   Recode decision of the pictures with sb_row_recode, taken
+ *   once the SB rows above the held segment row are coded.
+ *   The q change is applied as a delta q offset to the SBs
+ *   that are not coded yet, base_q_idx and the coded SBs are
+ *   kept.  When the coded SBs already used the bits of the
+ *   picture, the recode of the whole picture is decided as at
+ *   the end of the picture, and TRUE is returned if it is to
+ *   be restarted.
+ ******************************************************/
+static Bool sb_row_recode_decision_maker(PictureControlSet  *pcs_ptr,
+                                         SequenceControlSet *scs_ptr, uint32_t coded_sb_count) {
+    PictureParentControlSet    *ppcs_ptr           = pcs_ptr->parent_pcs_ptr;
+    EncodeContext *const        encode_context_ptr = scs_ptr->encode_context_ptr;
+    RATE_CONTROL *const         rc                 = &(encode_context_ptr->rc);
+    const RateControlCfg *const rc_cfg             = &encode_context_ptr->rc_cfg;
+    FrameHeader                *frm_hdr            = &ppcs_ptr->frm_hdr;
+    const int                   this_frame_target  = ppcs_ptr->this_frame_target;
+    const int                   max_frame_size     = ppcs_ptr->max_frame_size;
+    const uint32_t              sb_count           = pcs_ptr->sb_total_count_pix;
+    int32_t                     loop               = 0;
+    int32_t                     q = frm_hdr->quantization_params.base_q_idx;
+
+    svt_block_on_mutex(ppcs_ptr->pcs_total_rate_mutex);
+    const int64_t coded_bits = (int64_t)((ppcs_ptr->pcs_total_rate +
+                                          (1 << (AV1_PROB_COST_SHIFT - 1))) >>
+                                         AV1_PROB_COST_SHIFT);
+    svt_release_mutex(ppcs_ptr->pcs_total_rate_mutex);
+    if (coded_bits >= ((rc_cfg->mode == AOM_Q) ? max_frame_size : this_frame_target)) {
+        Bool do_recode = FALSE;
+        recode_loop_decision_maker(pcs_ptr, scs_ptr, &do_recode, coded_sb_count);
+        // The following passes are regular picture recodes
+        if (do_recode)
+            ppcs_ptr->sb_row_recode = FALSE;
+        return do_recode;
+    }
+
+    // The remaining SBs get the bits left by the coded SBs.  The decision is
+    // taken on the size of a picture coded at the q of the remaining SBs, so
+    // the targets are scaled to the picture.
+    ppcs_ptr->q_low             = ppcs_ptr->bottom_index;
+    ppcs_ptr->q_high            = ppcs_ptr->top_index;
+    ppcs_ptr->this_frame_target = (int)(AOMMAX(this_frame_target - coded_bits, 0) * sb_count /
+                                        (sb_count - coded_sb_count));
+    ppcs_ptr->max_frame_size    = (int)(AOMMAX(max_frame_size - coded_bits, 0) * sb_count /
+                                     (sb_count - coded_sb_count));
+    recode_loop_update_q(ppcs_ptr,
+                         &loop,
+                         &q,
+                         &ppcs_ptr->q_low,
+                         &ppcs_ptr->q_high,
+                         ppcs_ptr->top_index,
+                         ppcs_ptr->bottom_index,
+                         &ppcs_ptr->undershoot_seen,
+                         &ppcs_ptr->overshoot_seen,
+                         &ppcs_ptr->low_cr_seen,
+                         0,
+                         coded_sb_count);
+    ppcs_ptr->this_frame_target = this_frame_target;
+    ppcs_ptr->max_frame_size    = max_frame_size;
+
+    // Special case for overlay frame.
+#if FRFCTR_RC_P2
+    if (loop && ppcs_ptr->is_overlay &&
+#else
+    if (loop && ppcs_ptr->is_src_frame_alt_ref &&
+#endif
+        ppcs_ptr->projected_frame_size < rc->max_frame_bandwidth) {
+        loop = 0;
+    }
+    if (loop) {
+        const int32_t offset     = q - frm_hdr->quantization_params.base_q_idx;
+        const int32_t min_qindex = AOMMAX(
+            frm_hdr->delta_q_params.delta_q_res,
+            (int32_t)quantizer_to_qindex[scs_ptr->static_config.min_qp_allowed]);
+        const int32_t max_qindex =
+            (int32_t)quantizer_to_qindex[scs_ptr->static_config.max_qp_allowed];
+        for (uint32_t sb_addr = coded_sb_count; sb_addr < sb_count; ++sb_addr) {
+            SuperBlock *sb_ptr = pcs_ptr->sb_ptr_array[sb_addr];
+            sb_ptr->qindex     = (uint8_t)CLIP3(
+                min_qindex, max_qindex, (int32_t)sb_ptr->qindex + offset);
+        }
+    }
+    return FALSE;
+}
+
+/******************************************************
+ * sb_row_recode_release
+ *   Removes the dependency added by sb_row_recode_init and
+ *   starts the held segment row.
+ ******************************************************/
+static void sb_row_recode_release(PictureControlSet *pcs_ptr, EbObjectWrapper *pcs_wrapper_ptr,
+                                  EbFifo *enc_dec_feedback_fifo_ptr) {
+    EncDecSegments      *segments_ptr = pcs_ptr->enc_dec_segment_ctrl[0];
+    const uint32_t       row_index    = sb_row_recode_segment_row(segments_ptr);
+    EncDecSegSegmentRow *row_ptr      = &segments_ptr->row_array[row_index];
+    Bool                 start_row;
+
+    svt_block_on_mutex(row_ptr->assignment_mutex);
+    start_row = --segments_ptr->dep_map.dependency_map[row_ptr->starting_seg_index] == 0;
+    svt_release_mutex(row_ptr->assignment_mutex);
+
+    if (start_row) {
+        EbObjectWrapper *wrapper_ptr;
+        svt_get_empty_object(enc_dec_feedback_fifo_ptr, &wrapper_ptr);
+        EncDecTasks *feedback_task_ptr         = (EncDecTasks *)wrapper_ptr->object_ptr;
+        feedback_task_ptr->input_type          = ENCDEC_TASKS_ENCDEC_INPUT;
+        feedback_task_ptr->enc_dec_segment_row = (int16_t)row_index;
+        feedback_task_ptr->pcs_wrapper_ptr     = pcs_wrapper_ptr;
+        feedback_task_ptr->tile_group_index    = 0;
+        svt_post_full_object(wrapper_ptr);
+    }
+}
+
 /* for debug/documentation purposes: list all features assumed off for light pd1*/
 void exaustive_light_pd1_features(ModeDecisionContext *md_ctx, PictureParentControlSet *ppcs,
                                   uint8_t use_light_pd1, uint8_t debug_lpd1_features) {
@@ -7136,51 +7333,87 @@ uint8_t is_vlpd0_safe(PictureControlSet *pcs_ptr, ModeDecisionContext *md_ctx) {
 
     return is_vlpd0_safe;
 }
+/*
+* Hash of the (8-bit) source samples of a complete 64x64 SB: CRC of each luma/chroma row, then
+* CRC of the row values.  Returns 0 (no hash) for the incomplete SBs.
+*/
+static uint32_t get_sb_src_hash(EncDecContext *ctx, EbPictureBufferDesc *input_pic,
+                                const SbParams *sb_params) {
+    if (sb_params->width != 64 || sb_params->height != 64)
+        return 0;
+    const uint8_t ss_x     = ctx->color_format == EB_YUV444 ? 0 : 1;
+    const uint8_t ss_y     = ctx->color_format >= EB_YUV422 ? 0 : 1;
+    uint32_t      row_hash[3 * 64];
+    uint32_t      row_cnt = 0;
+    const uint8_t *src    = input_pic->buffer_y +
+        (input_pic->origin_y + sb_params->origin_y) * input_pic->stride_y + input_pic->origin_x +
+        sb_params->origin_x;
+    for (int i = 0; i < 64; i++)
+        row_hash[row_cnt++] = svt_av1_get_crc_value(
+            &ctx->crc_calculator, (uint8_t *)src + i * input_pic->stride_y, 64);
+    if (ctx->color_format != EB_YUV400) {
+        const uint32_t uv_x = (input_pic->origin_x + sb_params->origin_x) >> ss_x;
+        const uint32_t uv_y = (input_pic->origin_y + sb_params->origin_y) >> ss_y;
+        const uint8_t *src_cb = input_pic->buffer_cb + uv_y * input_pic->stride_cb + uv_x;
+        const uint8_t *src_cr = input_pic->buffer_cr + uv_y * input_pic->stride_cr + uv_x;
+        for (int i = 0; i < (64 >> ss_y); i++) {
+            row_hash[row_cnt++] = svt_av1_get_crc_value(
+                &ctx->crc_calculator, (uint8_t *)src_cb + i * input_pic->stride_cb, 64 >> ss_x);
+            row_hash[row_cnt++] = svt_av1_get_crc_value(
+                &ctx->crc_calculator, (uint8_t *)src_cr + i * input_pic->stride_cr, 64 >> ss_x);
+        }
+    }
+    const uint32_t hash = svt_av1_get_crc_value(
+        &ctx->crc_calculator, (uint8_t *)row_hash, row_cnt * sizeof(row_hash[0]));
+    // 0 is kept for the SBs without hash
+    return hash ? hash : 1;
+}
+/*
+* Check whether the SB is static: same source as the co-located SB of the closest reference(s),
+* which was coded as a 64x64 skip block (no coeff, MVP mode).  The hash is only computed for the
+* SBs of zero ME distortion, which also guards against hash collisions.
+*/
+static uint8_t is_static_sb(PictureControlSet *pcs_ptr, uint32_t sb_index) {
+    const uint32_t hash = pcs_ptr->sb_src_hash[sb_index];
+    if (!hash)
+        return FALSE;
+    const uint8_t list_cnt = pcs_ptr->slice_type == B_SLICE ? 2 : 1;
+    for (uint8_t list_idx = REF_LIST_0; list_idx < list_cnt; list_idx++) {
+        EbReferenceObject *ref_obj =
+            (EbReferenceObject *)pcs_ptr->ref_pic_ptr_array[list_idx][0]->object_ptr;
+        if (ref_obj->sb_src_hash[sb_index] == hash && ref_obj->sb_skip[sb_index] &&
+            ref_obj->sb_64x64_mvp[sb_index])
+            return TRUE;
+    }
+    return FALSE;
+}
+/******************************************************
+ * Post EncDec Results
+ ******************************************************/
+static void post_enc_dec_results(EncDecContext *context_ptr, EbObjectWrapper *pcs_wrapper_ptr) {
+    EbObjectWrapper *enc_dec_results_wrapper_ptr;
+    EncDecResults   *enc_dec_results_ptr;
+
+    // Get Empty EncDec Results
+    svt_get_empty_object(context_ptr->enc_dec_output_fifo_ptr, &enc_dec_results_wrapper_ptr);
+    enc_dec_results_ptr = (EncDecResults *)enc_dec_results_wrapper_ptr->object_ptr;
+    enc_dec_results_ptr->pcs_wrapper_ptr = pcs_wrapper_ptr;
+    enc_dec_results_ptr->input_type      = DLF_TASKS_ENCDEC_INPUT;
+
+    // Post EncDec Results
+    svt_post_full_object(enc_dec_results_wrapper_ptr);
+}
 /* EncDec (Encode Decode) Kernel */
-/*********************************************************************************
-*
-* @brief
-*  The EncDec process contains both the mode decision and the encode pass engines
-*  of the encoder. The mode decision encapsulates multiple partitioning decision (PD) stages
-*  and multiple mode decision (MD) stages. At the end of the last mode decision stage,
-*  the winning partition and modes combinations per block get reconstructed in the encode pass
-*  operation which is part of the common section between the encoder and the decoder
-*  Common encoder and decoder tasks such as Intra Prediction, Motion Compensated Prediction,
-*  Transform, Quantization are performed in this process.
-*
-* @par Description:
-*  The EncDec process operates on an SB basis.
-*  The EncDec process takes as input the Motion Vector XY pairs candidates
-*  and corresponding distortion estimates from the Motion Estimation process,
-*  and the picture-level QP from the Rate Control process. All inputs are passed
-*  through the picture structures: PictureControlSet and SequenceControlSet.
-*  local structures of type EncDecContext and ModeDecisionContext contain all parameters
-*  and results corresponding to the SuperBlock being processed.
-*  each of the context structures is local to on thread and thus there's no risk of
-*  affecting (changing) other SBs data in the process.
-*
-* @param[in] Vector
-*  Motion Vector XY pairs from Motion Estimation process
-*
-* @param[in] Distortion Estimates
-*  Distortion estimates from Motion Estimation process
-*
-* @param[in] Picture QP
-*  Picture Quantization Parameter from Rate Control process
-*
-* @param[out] Blocks
-*  The encode pass takes the selected partitioning and coding modes as input from mode decision for each
-*  superblock and produces quantized transfrom coefficients for the residuals and the appropriate syntax
-*  elements to be sent to the entropy coding engine
-*
-********************************************************************************/
-void *mode_decision_kernel(void *input_ptr) {
+/******************************************************
+ * Mode Decision Task
+ *   Encodes the segments made available by one EncDec task
+ ******************************************************/
+void mode_decision_process_task(EbThreadContext *thread_context_ptr,
+                                EbObjectWrapper *enc_dec_tasks_wrapper_ptr) {
     // Context & SCS & PCS
-    EbThreadContext *thread_context_ptr = (EbThreadContext *)input_ptr;
     EncDecContext   *context_ptr        = (EncDecContext *)thread_context_ptr->priv;
 
     // Input
-    EbObjectWrapper *enc_dec_tasks_wrapper_ptr;
 
     // Output
     EbObjectWrapper *enc_dec_results_wrapper_ptr;
@@ -7208,425 +7441,341 @@ void *mode_decision_kernel(void *input_ptr) {
 
     segment_index = 0;
 
-    for (;;) {
-        // Get Mode Decision Results
-        EB_GET_FULL_OBJECT(context_ptr->mode_decision_input_fifo_ptr, &enc_dec_tasks_wrapper_ptr);
-
-        EncDecTasks       *enc_dec_tasks_ptr = (EncDecTasks *)enc_dec_tasks_wrapper_ptr->object_ptr;
-        PictureControlSet *pcs_ptr           = (PictureControlSet *)
-                                         enc_dec_tasks_ptr->pcs_wrapper_ptr->object_ptr;
-        SequenceControlSet  *scs_ptr = (SequenceControlSet *)pcs_ptr->scs_wrapper_ptr->object_ptr;
-        ModeDecisionContext *md_ctx  = context_ptr->md_context;
-        struct PictureParentControlSet *ppcs = pcs_ptr->parent_pcs_ptr;
-        md_ctx->encoder_bit_depth            = (uint8_t)scs_ptr->static_config.encoder_bit_depth;
-        md_ctx->corrupted_mv_check           = (pcs_ptr->parent_pcs_ptr->aligned_width >=
-                                      (1 << (MV_IN_USE_BITS - 3))) ||
-            (pcs_ptr->parent_pcs_ptr->aligned_height >= (1 << (MV_IN_USE_BITS - 3)));
-        context_ptr->tile_group_index = enc_dec_tasks_ptr->tile_group_index;
-        context_ptr->coded_sb_count   = 0;
-        segments_ptr = pcs_ptr->enc_dec_segment_ctrl[context_ptr->tile_group_index];
-        // SB Constants
-        uint8_t sb_sz            = (uint8_t)scs_ptr->sb_size_pix;
-        uint8_t sb_size_log2     = (uint8_t)svt_log2f(sb_sz);
-        context_ptr->sb_sz       = sb_sz;
-        uint32_t pic_width_in_sb = (pcs_ptr->parent_pcs_ptr->aligned_width + sb_sz - 1) >>
-            sb_size_log2;
-        uint16_t tile_group_width_in_sb = pcs_ptr->parent_pcs_ptr
-                                              ->tile_group_info[context_ptr->tile_group_index]
-                                              .tile_group_width_in_sb;
-        context_ptr->tot_intra_coded_area = 0;
-        context_ptr->tot_skip_coded_area  = 0;
-        // Bypass encdec for the first pass
-        if (scs_ptr->static_config.pass == ENC_FIRST_PASS ||
-            (!pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag &&
-             scs_ptr->rc_stat_gen_pass_mode && !pcs_ptr->parent_pcs_ptr->first_frame_in_minigop)) {
-            svt_release_object(pcs_ptr->parent_pcs_ptr->me_data_wrapper_ptr);
-            pcs_ptr->parent_pcs_ptr->me_data_wrapper_ptr = (EbObjectWrapper *)NULL;
-            pcs_ptr->parent_pcs_ptr->pa_me_data          = NULL;
-            // Get Empty EncDec Results
-            svt_get_empty_object(context_ptr->enc_dec_output_fifo_ptr,
-                                 &enc_dec_results_wrapper_ptr);
-            enc_dec_results_ptr = (EncDecResults *)enc_dec_results_wrapper_ptr->object_ptr;
-            enc_dec_results_ptr->pcs_wrapper_ptr = enc_dec_tasks_ptr->pcs_wrapper_ptr;
-
-            // Post EncDec Results
-            svt_post_full_object(enc_dec_results_wrapper_ptr);
-        } else {
-            if (enc_dec_tasks_ptr->input_type == ENCDEC_TASKS_SUPERRES_INPUT) {
-                // do as dorecode do
-                pcs_ptr->enc_dec_coded_sb_count = 0;
-                // re-init mode decision configuration for qp update for re-encode frame
-                mode_decision_configuration_init_qp_update(pcs_ptr);
-                // init segment for re-encode frame
-                init_enc_dec_segement(pcs_ptr->parent_pcs_ptr);
-
-                // post tile based encdec task
-                EbObjectWrapper *enc_dec_re_encode_tasks_wrapper_ptr;
-                uint16_t         tg_count = pcs_ptr->parent_pcs_ptr->tile_group_cols *
-                    pcs_ptr->parent_pcs_ptr->tile_group_rows;
-                for (uint16_t tile_group_idx = 0; tile_group_idx < tg_count; tile_group_idx++) {
-                    svt_get_empty_object(context_ptr->enc_dec_feedback_fifo_ptr,
-                                         &enc_dec_re_encode_tasks_wrapper_ptr);
-
-                    EncDecTasks *enc_dec_re_encode_tasks_ptr =
-                        (EncDecTasks *)enc_dec_re_encode_tasks_wrapper_ptr->object_ptr;
-                    enc_dec_re_encode_tasks_ptr->pcs_wrapper_ptr =
-                        enc_dec_tasks_ptr->pcs_wrapper_ptr;
-                    enc_dec_re_encode_tasks_ptr->input_type       = ENCDEC_TASKS_MDC_INPUT;
-                    enc_dec_re_encode_tasks_ptr->tile_group_index = tile_group_idx;
-
-                    // Post the Full Results Object
-                    svt_post_full_object(enc_dec_re_encode_tasks_wrapper_ptr);
-                }
-
-                svt_release_object(enc_dec_tasks_wrapper_ptr);
-                continue;
+    EncDecTasks       *enc_dec_tasks_ptr = (EncDecTasks *)enc_dec_tasks_wrapper_ptr->object_ptr;
+    PictureControlSet *pcs_ptr           = (PictureControlSet *)
+                                     enc_dec_tasks_ptr->pcs_wrapper_ptr->object_ptr;
+    SequenceControlSet  *scs_ptr = (SequenceControlSet *)pcs_ptr->scs_wrapper_ptr->object_ptr;
+    ModeDecisionContext *md_ctx  = context_ptr->md_context;
+    struct PictureParentControlSet *ppcs = pcs_ptr->parent_pcs_ptr;
+    md_ctx->encoder_bit_depth            = (uint8_t)scs_ptr->static_config.encoder_bit_depth;
+    md_ctx->corrupted_mv_check           = (pcs_ptr->parent_pcs_ptr->aligned_width >=
+                                  (1 << (MV_IN_USE_BITS - 3))) ||
+        (pcs_ptr->parent_pcs_ptr->aligned_height >= (1 << (MV_IN_USE_BITS - 3)));
+    context_ptr->tile_group_index = enc_dec_tasks_ptr->tile_group_index;
+    context_ptr->coded_sb_count   = 0;
+    segments_ptr = pcs_ptr->enc_dec_segment_ctrl[context_ptr->tile_group_index];
+    // SB Constants
+    uint8_t sb_sz            = (uint8_t)scs_ptr->sb_size_pix;
+    uint8_t sb_size_log2     = (uint8_t)svt_log2f(sb_sz);
+    context_ptr->sb_sz       = sb_sz;
+    uint32_t pic_width_in_sb = (pcs_ptr->parent_pcs_ptr->aligned_width + sb_sz - 1) >>
+        sb_size_log2;
+    uint16_t tile_group_width_in_sb = pcs_ptr->parent_pcs_ptr
+                                          ->tile_group_info[context_ptr->tile_group_index]
+                                          .tile_group_width_in_sb;
+    context_ptr->tot_intra_coded_area = 0;
+    context_ptr->tot_skip_coded_area  = 0;
+    // Bypass encdec for the first pass and lookahead_only
+    if (scs_ptr->static_config.pass == ENC_FIRST_PASS || scs_ptr->static_config.lookahead_only ||
+        (!pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag &&
+         scs_ptr->rc_stat_gen_pass_mode && !pcs_ptr->parent_pcs_ptr->first_frame_in_minigop)) {
+        svt_release_object(pcs_ptr->parent_pcs_ptr->me_data_wrapper_ptr);
+        pcs_ptr->parent_pcs_ptr->me_data_wrapper_ptr = (EbObjectWrapper *)NULL;
+        pcs_ptr->parent_pcs_ptr->pa_me_data          = NULL;
+        // Get Empty EncDec Results
+        svt_get_empty_object(context_ptr->enc_dec_output_fifo_ptr,
+                             &enc_dec_results_wrapper_ptr);
+        enc_dec_results_ptr = (EncDecResults *)enc_dec_results_wrapper_ptr->object_ptr;
+        enc_dec_results_ptr->pcs_wrapper_ptr = enc_dec_tasks_ptr->pcs_wrapper_ptr;
+        enc_dec_results_ptr->input_type      = DLF_TASKS_ENCDEC_INPUT;
+
+        // Post EncDec Results
+        svt_post_full_object(enc_dec_results_wrapper_ptr);
+    } else {
+        if (enc_dec_tasks_ptr->input_type == ENCDEC_TASKS_SUPERRES_INPUT) {
+            // do as dorecode do
+            pcs_ptr->enc_dec_coded_sb_count = 0;
+            // re-init mode decision configuration for qp update for re-encode frame
+            mode_decision_configuration_init_qp_update(pcs_ptr);
+            // init segment for re-encode frame
+            init_enc_dec_segement(pcs_ptr->parent_pcs_ptr);
+
+            // post tile based encdec task
+            EbObjectWrapper *enc_dec_re_encode_tasks_wrapper_ptr;
+            uint16_t         tg_count = pcs_ptr->parent_pcs_ptr->tile_group_cols *
+                pcs_ptr->parent_pcs_ptr->tile_group_rows;
+            for (uint16_t tile_group_idx = 0; tile_group_idx < tg_count; tile_group_idx++) {
+                svt_get_empty_object(context_ptr->enc_dec_feedback_fifo_ptr,
+                                     &enc_dec_re_encode_tasks_wrapper_ptr);
+
+                EncDecTasks *enc_dec_re_encode_tasks_ptr =
+                    (EncDecTasks *)enc_dec_re_encode_tasks_wrapper_ptr->object_ptr;
+                enc_dec_re_encode_tasks_ptr->pcs_wrapper_ptr =
+                    enc_dec_tasks_ptr->pcs_wrapper_ptr;
+                enc_dec_re_encode_tasks_ptr->input_type       = ENCDEC_TASKS_MDC_INPUT;
+                enc_dec_re_encode_tasks_ptr->tile_group_index = tile_group_idx;
+
+                // Post the Full Results Object
+                svt_post_full_object(enc_dec_re_encode_tasks_wrapper_ptr);
             }
 
-            if (pcs_ptr->cdf_ctrl.enabled) {
-                if (!pcs_ptr->cdf_ctrl.update_mv)
+            svt_release_object(enc_dec_tasks_wrapper_ptr);
+            return;
+        }
+
+        if (pcs_ptr->cdf_ctrl.enabled) {
+            if (!pcs_ptr->cdf_ctrl.update_mv)
 #if OPT_UPDATE_CDF_MEM
-                    copy_mv_rate(pcs_ptr, context_ptr->md_context->rate_est_table);
+                copy_mv_rate(pcs_ptr,
+                             context_ptr->md_context->rate_est_table,
+                             context_ptr->md_context->rate_est_cache);
 #else
-                    copy_mv_rate(pcs_ptr, &context_ptr->md_context->rate_est_table);
+                copy_mv_rate(pcs_ptr, &context_ptr->md_context->rate_est_table, NULL);
 #endif
-                if (!pcs_ptr->cdf_ctrl.update_se)
+            if (!pcs_ptr->cdf_ctrl.update_se)
 
-                    av1_estimate_syntax_rate(
+                av1_estimate_syntax_rate(
 #if OPT_UPDATE_CDF_MEM
-                        context_ptr->md_context->rate_est_table,
+                    context_ptr->md_context->rate_est_table,
+                    context_ptr->md_context->rate_est_cache,
 #else
-                        &context_ptr->md_context->rate_est_table,
+                    &context_ptr->md_context->rate_est_table,
+                    NULL,
 #endif
-                        pcs_ptr->slice_type == I_SLICE ? TRUE : FALSE,
-                        pcs_ptr->pic_filter_intra_level,
-                        pcs_ptr->parent_pcs_ptr->frm_hdr.allow_screen_content_tools,
-                        scs_ptr->seq_header.enable_restoration,
-                        pcs_ptr->parent_pcs_ptr->frm_hdr.allow_intrabc,
-                        pcs_ptr->parent_pcs_ptr->partition_contexts,
-                        &pcs_ptr->md_frame_context);
-                if (!pcs_ptr->cdf_ctrl.update_coef)
+                    pcs_ptr->slice_type == I_SLICE ? TRUE : FALSE,
+                    pcs_ptr->pic_filter_intra_level,
+                    pcs_ptr->parent_pcs_ptr->frm_hdr.allow_screen_content_tools,
+                    scs_ptr->seq_header.enable_restoration,
+                    pcs_ptr->parent_pcs_ptr->frm_hdr.allow_intrabc,
+                    pcs_ptr->parent_pcs_ptr->partition_contexts,
+                    &pcs_ptr->md_frame_context);
+            if (!pcs_ptr->cdf_ctrl.update_coef)
 #if OPT_UPDATE_CDF_MEM
-                    av1_estimate_coefficients_rate(context_ptr->md_context->rate_est_table,
-                        &pcs_ptr->md_frame_context);
+                av1_estimate_coefficients_rate(context_ptr->md_context->rate_est_table,
+                                               context_ptr->md_context->rate_est_cache,
+                                               &pcs_ptr->md_frame_context);
 #else
-                    av1_estimate_coefficients_rate(&context_ptr->md_context->rate_est_table,
-                                                   &pcs_ptr->md_frame_context);
+                av1_estimate_coefficients_rate(&context_ptr->md_context->rate_est_table,
+                                               NULL,
+                                               &pcs_ptr->md_frame_context);
 #endif
-            }
-            // Segment-loop
-            while (assign_enc_dec_segments(segments_ptr,
-                                           &segment_index,
-                                           enc_dec_tasks_ptr,
-                                           context_ptr->enc_dec_feedback_fifo_ptr) == TRUE) {
-                x_sb_start_index = segments_ptr->x_start_array[segment_index];
-                y_sb_start_index = segments_ptr->y_start_array[segment_index];
-                sb_start_index   = y_sb_start_index * tile_group_width_in_sb + x_sb_start_index;
-                sb_segment_count = segments_ptr->valid_sb_count_array[segment_index];
-
-                segment_row_index  = segment_index / segments_ptr->segment_band_count;
-                segment_band_index = segment_index -
-                    segment_row_index * segments_ptr->segment_band_count;
-                segment_band_size = (segments_ptr->sb_band_count * (segment_band_index + 1) +
-                                     segments_ptr->segment_band_count - 1) /
-                    segments_ptr->segment_band_count;
-
-                // Reset Coding Loop State
-                reset_mode_decision(scs_ptr,
-                                    context_ptr->md_context,
-                                    pcs_ptr,
-                                    context_ptr->tile_group_index,
-                                    segment_index);
-
-                // Reset EncDec Coding State
-                reset_enc_dec( // HT done
-                    context_ptr,
-                    pcs_ptr,
-                    scs_ptr,
-                    segment_index);
-                for (y_sb_index = y_sb_start_index, sb_segment_index = sb_start_index;
+        }
+        // Segment-loop
+        while (assign_enc_dec_segments(segments_ptr,
+                                       &segment_index,
+                                       enc_dec_tasks_ptr,
+                                       context_ptr->enc_dec_feedback_fifo_ptr) == TRUE) {
+            x_sb_start_index = segments_ptr->x_start_array[segment_index];
+            y_sb_start_index = segments_ptr->y_start_array[segment_index];
+            sb_start_index   = y_sb_start_index * tile_group_width_in_sb + x_sb_start_index;
+            sb_segment_count = segments_ptr->valid_sb_count_array[segment_index];
+
+            segment_row_index  = segment_index / segments_ptr->segment_band_count;
+            segment_band_index = segment_index -
+                segment_row_index * segments_ptr->segment_band_count;
+            segment_band_size = (segments_ptr->sb_band_count * (segment_band_index + 1) +
+                                 segments_ptr->segment_band_count - 1) /
+                segments_ptr->segment_band_count;
+
+            // Reset Coding Loop State
+            reset_mode_decision(scs_ptr,
+                                context_ptr->md_context,
+                                pcs_ptr,
+                                context_ptr->tile_group_index,
+                                segment_index);
+
+            // Reset EncDec Coding State
+            reset_enc_dec( // HT done
+                context_ptr,
+                pcs_ptr,
+                scs_ptr,
+                segment_index);
+            for (y_sb_index = y_sb_start_index, sb_segment_index = sb_start_index;
+                 sb_segment_index < sb_start_index + sb_segment_count;
+                 ++y_sb_index) {
+                for (x_sb_index = x_sb_start_index; x_sb_index < tile_group_width_in_sb &&
+                     (x_sb_index + y_sb_index < segment_band_size) &&
                      sb_segment_index < sb_start_index + sb_segment_count;
-                     ++y_sb_index) {
-                    for (x_sb_index = x_sb_start_index; x_sb_index < tile_group_width_in_sb &&
-                         (x_sb_index + y_sb_index < segment_band_size) &&
-                         sb_segment_index < sb_start_index + sb_segment_count;
-                         ++x_sb_index, ++sb_segment_index) {
-                        uint16_t tile_group_y_sb_start =
-                            pcs_ptr->parent_pcs_ptr->tile_group_info[context_ptr->tile_group_index]
-                                .tile_group_sb_start_y;
-                        uint16_t tile_group_x_sb_start =
-                            pcs_ptr->parent_pcs_ptr->tile_group_info[context_ptr->tile_group_index]
-                                .tile_group_sb_start_x;
-                        sb_index = context_ptr->md_context->sb_index =
-                            (uint16_t)((y_sb_index + tile_group_y_sb_start) * pic_width_in_sb +
-                                       x_sb_index + tile_group_x_sb_start);
-                        sb_ptr = context_ptr->md_context->sb_ptr = pcs_ptr->sb_ptr_array[sb_index];
-                        sb_origin_x = (x_sb_index + tile_group_x_sb_start) << sb_size_log2;
-                        sb_origin_y = (y_sb_index + tile_group_y_sb_start) << sb_size_log2;
-                        //printf("[%ld]:ED sb index %d, (%d, %d), encoded total sb count %d, ctx coded sb count %d\n",
-                        //        pcs_ptr->picture_number,
-                        //        sb_index, sb_origin_x, sb_origin_y,
-                        //        pcs_ptr->enc_dec_coded_sb_count,
-                        //        context_ptr->coded_sb_count);
-                        context_ptr->tile_index              = sb_ptr->tile_info.tile_rs_index;
-                        context_ptr->md_context->tile_index  = sb_ptr->tile_info.tile_rs_index;
-                        context_ptr->md_context->sb_origin_x = sb_origin_x;
-                        context_ptr->md_context->sb_origin_y = sb_origin_y;
-                        mdc_ptr               = context_ptr->md_context->mdc_sb_array;
-                        context_ptr->sb_index = sb_index;
-                        if (pcs_ptr->cdf_ctrl.enabled) {
-                            if (scs_ptr->seq_header.pic_based_rate_est &&
-                                scs_ptr->enc_dec_segment_row_count_array
-                                        [pcs_ptr->temporal_layer_index] == 1 &&
-                                scs_ptr->enc_dec_segment_col_count_array
-                                        [pcs_ptr->temporal_layer_index] == 1) {
-                                if (sb_index == 0)
-                                    pcs_ptr->ec_ctx_array[sb_index] = pcs_ptr->md_frame_context;
-                                else
-                                    pcs_ptr->ec_ctx_array[sb_index] =
-                                        pcs_ptr->ec_ctx_array[sb_index - 1];
-                            } else {
-                                // Use the latest available CDF for the current SB
-                                // Use the weighted average of left (3x) and top right (1x) if available.
-                                int8_t top_right_available = ((int32_t)(sb_origin_y >>
-                                                                        MI_SIZE_LOG2) >
-                                                              sb_ptr->tile_info.mi_row_start) &&
-                                    ((int32_t)((sb_origin_x + (1 << sb_size_log2)) >>
-                                               MI_SIZE_LOG2) < sb_ptr->tile_info.mi_col_end);
-
-                                int8_t left_available = ((int32_t)(sb_origin_x >> MI_SIZE_LOG2) >
-                                                         sb_ptr->tile_info.mi_col_start);
-
-                                if (!left_available && !top_right_available)
-                                    pcs_ptr->ec_ctx_array[sb_index] = pcs_ptr->md_frame_context;
-                                else if (!left_available)
-                                    pcs_ptr->ec_ctx_array[sb_index] =
-                                        pcs_ptr->ec_ctx_array[sb_index - pic_width_in_sb + 1];
-                                else if (!top_right_available)
-                                    pcs_ptr->ec_ctx_array[sb_index] =
-                                        pcs_ptr->ec_ctx_array[sb_index - 1];
-                                else {
-                                    pcs_ptr->ec_ctx_array[sb_index] =
-                                        pcs_ptr->ec_ctx_array[sb_index - 1];
-                                    avg_cdf_symbols(
-                                        &pcs_ptr->ec_ctx_array[sb_index],
-                                        &pcs_ptr->ec_ctx_array[sb_index - pic_width_in_sb + 1],
-                                        AVG_CDF_WEIGHT_LEFT,
-                                        AVG_CDF_WEIGHT_TOP);
-                                }
+                     ++x_sb_index, ++sb_segment_index) {
+                    uint16_t tile_group_y_sb_start =
+                        pcs_ptr->parent_pcs_ptr->tile_group_info[context_ptr->tile_group_index]
+                            .tile_group_sb_start_y;
+                    uint16_t tile_group_x_sb_start =
+                        pcs_ptr->parent_pcs_ptr->tile_group_info[context_ptr->tile_group_index]
+                            .tile_group_sb_start_x;
+                    sb_index = context_ptr->md_context->sb_index =
+                        (uint16_t)((y_sb_index + tile_group_y_sb_start) * pic_width_in_sb +
+                                   x_sb_index + tile_group_x_sb_start);
+                    sb_ptr = context_ptr->md_context->sb_ptr = pcs_ptr->sb_ptr_array[sb_index];
+                    sb_origin_x = (x_sb_index + tile_group_x_sb_start) << sb_size_log2;
+                    sb_origin_y = (y_sb_index + tile_group_y_sb_start) << sb_size_log2;
+                    //printf("[%ld]:ED sb index %d, (%d, %d), encoded total sb count %d, ctx coded sb count %d\n",
+                    //        pcs_ptr->picture_number,
+                    //        sb_index, sb_origin_x, sb_origin_y,
+                    //        pcs_ptr->enc_dec_coded_sb_count,
+                    //        context_ptr->coded_sb_count);
+                    context_ptr->tile_index              = sb_ptr->tile_info.tile_rs_index;
+                    context_ptr->md_context->tile_index  = sb_ptr->tile_info.tile_rs_index;
+                    context_ptr->md_context->sb_origin_x = sb_origin_x;
+                    context_ptr->md_context->sb_origin_y = sb_origin_y;
+                    mdc_ptr               = context_ptr->md_context->mdc_sb_array;
+                    context_ptr->sb_index = sb_index;
+                    if (pcs_ptr->cdf_ctrl.enabled) {
+                        if (scs_ptr->seq_header.pic_based_rate_est &&
+                            scs_ptr->enc_dec_segment_row_count_array
+                                    [pcs_ptr->temporal_layer_index] == 1 &&
+                            scs_ptr->enc_dec_segment_col_count_array
+                                    [pcs_ptr->temporal_layer_index] == 1) {
+                            if (sb_index == 0)
+                                pcs_ptr->ec_ctx_array[sb_index] = pcs_ptr->md_frame_context;
+                            else
+                                pcs_ptr->ec_ctx_array[sb_index] =
+                                    pcs_ptr->ec_ctx_array[sb_index - 1];
+                        } else {
+                            // Use the latest available CDF for the current SB
+                            // Use the weighted average of left (3x) and top right (1x) if available.
+                            int8_t top_right_available = ((int32_t)(sb_origin_y >>
+                                                                    MI_SIZE_LOG2) >
+                                                          sb_ptr->tile_info.mi_row_start) &&
+                                ((int32_t)((sb_origin_x + (1 << sb_size_log2)) >>
+                                           MI_SIZE_LOG2) < sb_ptr->tile_info.mi_col_end);
+
+                            int8_t left_available = ((int32_t)(sb_origin_x >> MI_SIZE_LOG2) >
+                                                     sb_ptr->tile_info.mi_col_start);
+
+                            if (!left_available && !top_right_available)
+                                pcs_ptr->ec_ctx_array[sb_index] = pcs_ptr->md_frame_context;
+                            else if (!left_available)
+                                pcs_ptr->ec_ctx_array[sb_index] =
+                                    pcs_ptr->ec_ctx_array[sb_index - pic_width_in_sb + 1];
+                            else if (!top_right_available)
+                                pcs_ptr->ec_ctx_array[sb_index] =
+                                    pcs_ptr->ec_ctx_array[sb_index - 1];
+                            else {
+                                pcs_ptr->ec_ctx_array[sb_index] =
+                                    pcs_ptr->ec_ctx_array[sb_index - 1];
+                                avg_cdf_symbols(
+                                    &pcs_ptr->ec_ctx_array[sb_index],
+                                    &pcs_ptr->ec_ctx_array[sb_index - pic_width_in_sb + 1],
+                                    AVG_CDF_WEIGHT_LEFT,
+                                    AVG_CDF_WEIGHT_TOP);
                             }
-                            // Initial Rate Estimation of the syntax elements
-                            if (pcs_ptr->cdf_ctrl.update_se)
-                                av1_estimate_syntax_rate(
+                        }
+                        // Initial Rate Estimation of the syntax elements
+                        if (pcs_ptr->cdf_ctrl.update_se)
+                            av1_estimate_syntax_rate(
 #if OPT_UPDATE_CDF_MEM
-                                    context_ptr->md_context->rate_est_table,
+                                context_ptr->md_context->rate_est_table,
+                                context_ptr->md_context->rate_est_cache,
 #else
-                                    &context_ptr->md_context->rate_est_table,
+                                &context_ptr->md_context->rate_est_table,
+                                NULL,
 #endif
-                                    pcs_ptr->slice_type == I_SLICE,
-                                    pcs_ptr->pic_filter_intra_level,
-                                    pcs_ptr->parent_pcs_ptr->frm_hdr.allow_screen_content_tools,
-                                    scs_ptr->seq_header.enable_restoration,
-                                    pcs_ptr->parent_pcs_ptr->frm_hdr.allow_intrabc,
-                                    pcs_ptr->parent_pcs_ptr->partition_contexts,
-                                    &pcs_ptr->ec_ctx_array[sb_index]);
-                            // Initial Rate Estimation of the Motion vectors
-                            if (pcs_ptr->cdf_ctrl.update_mv)
-                                av1_estimate_mv_rate(pcs_ptr,
+                                pcs_ptr->slice_type == I_SLICE,
+                                pcs_ptr->pic_filter_intra_level,
+                                pcs_ptr->parent_pcs_ptr->frm_hdr.allow_screen_content_tools,
+                                scs_ptr->seq_header.enable_restoration,
+                                pcs_ptr->parent_pcs_ptr->frm_hdr.allow_intrabc,
+                                pcs_ptr->parent_pcs_ptr->partition_contexts,
+                                &pcs_ptr->ec_ctx_array[sb_index]);
+                        // Initial Rate Estimation of the Motion vectors
+                        if (pcs_ptr->cdf_ctrl.update_mv)
+                            av1_estimate_mv_rate(pcs_ptr,
 #if OPT_UPDATE_CDF_MEM
-                                                     context_ptr->md_context->rate_est_table,
+                                                 context_ptr->md_context->rate_est_table,
+                                                 context_ptr->md_context->rate_est_cache,
 #else
-                                                     &context_ptr->md_context->rate_est_table,
+                                                 &context_ptr->md_context->rate_est_table,
+                                                 NULL,
 #endif
-                                                     &pcs_ptr->ec_ctx_array[sb_index]);
+                                                 &pcs_ptr->ec_ctx_array[sb_index]);
 
-                            if (pcs_ptr->cdf_ctrl.update_coef)
-                                av1_estimate_coefficients_rate(
+                        if (pcs_ptr->cdf_ctrl.update_coef)
+                            av1_estimate_coefficients_rate(
 #if OPT_UPDATE_CDF_MEM
-                                    context_ptr->md_context->rate_est_table,
+                                context_ptr->md_context->rate_est_table,
+                                context_ptr->md_context->rate_est_cache,
 #else
-                                    &context_ptr->md_context->rate_est_table,
+                                &context_ptr->md_context->rate_est_table,
+                                NULL,
 #endif
-                                    &pcs_ptr->ec_ctx_array[sb_index]);
+                                &pcs_ptr->ec_ctx_array[sb_index]);
 #if OPT_UPDATE_CDF_MEM
-                            context_ptr->md_context->md_rate_estimation_ptr =
-                                context_ptr->md_context->rate_est_table;
+                        context_ptr->md_context->md_rate_estimation_ptr =
+                            context_ptr->md_context->rate_est_table;
 #else
-                            context_ptr->md_context->md_rate_estimation_ptr =
-                                &context_ptr->md_context->rate_est_table;
+                        context_ptr->md_context->md_rate_estimation_ptr =
+                            &context_ptr->md_context->rate_est_table;
 #endif
-                        }
-                        // Configure the SB
-                        mode_decision_configure_sb(
-                            context_ptr->md_context, pcs_ptr, (uint8_t)sb_ptr->qindex);
-                        // signals set once per SB (i.e. not per PD)
-                        signal_derivation_enc_dec_kernel_common(
-                            scs_ptr, pcs_ptr, context_ptr->md_context);
+                    }
+                    // Configure the SB
+                    mode_decision_configure_sb(
+                        context_ptr->md_context, pcs_ptr, (uint8_t)sb_ptr->qindex);
+                    // All the blocks of the SB are in the segment of its ROI map offset
+                    if (ppcs->roi_map_present)
+                        for (int i = 0; i < scs_ptr->max_block_cnt; ++i)
+                            md_ctx->md_blk_arr_nsq[i].segment_id = ppcs->roi_seg_map[sb_index];
+                    // Static SB: the decision of the co-located SB of the reference is reused.
+                    // Only the SBs with a zero ME distortion can be static, the others are not
+                    // hashed
+                    md_ctx->static_sb              = 0;
+                    pcs_ptr->sb_src_hash[sb_index] = 0;
+                    if (scs_ptr->super_block_size == 64 &&
+                        scs_ptr->static_config.encoder_bit_depth == EB_8BIT &&
+                        pcs_ptr->slice_type != I_SLICE && !ppcs->me_64x64_distortion[sb_index]) {
+                        pcs_ptr->sb_src_hash[sb_index] =
+                            get_sb_src_hash(context_ptr,
+                                            ppcs->enhanced_picture_ptr,
+                                            &ppcs->sb_params_array[sb_index]);
+                        md_ctx->static_sb = is_static_sb(pcs_ptr, sb_index);
+                    }
+                    // signals set once per SB (i.e. not per PD)
+                    signal_derivation_enc_dec_kernel_common(
+                        scs_ptr, pcs_ptr, context_ptr->md_context);
+
+                    if (pcs_ptr->parent_pcs_ptr->palette_level)
+                        // Status of palette info alloc
+                        for (int i = 0; i < scs_ptr->max_block_cnt; ++i)
+                            context_ptr->md_context->md_blk_arr_nsq[i].palette_mem = 0;
+
+                    // Initialize is_subres_safe
+                    context_ptr->md_context->is_subres_safe = (uint8_t)~0;
+                    // Signal initialized here; if needed, will be set in md_encode_block before MDS3
+                    md_ctx->need_hbd_comp_mds3 = 0;
+                    uint8_t skip_pd_pass_0 =
+                        (scs_ptr->super_block_size == 64 &&
+                         context_ptr->md_context->depth_removal_ctrls.disallow_below_64x64)
+                        ? 1
+                        : 0;
+                    if (context_ptr->md_context->skip_pd0)
+                        if (context_ptr->md_context->depth_removal_ctrls.disallow_below_32x32)
+                            skip_pd_pass_0 = 1;
+                    if (context_ptr->md_context->pd0_level == VERY_LIGHT_PD0) {
+                        // Use the next conservative level if not safe to use VLPD0
+                        if (!is_vlpd0_safe(pcs_ptr, md_ctx))
+                            context_ptr->md_context->pd0_level = VERY_LIGHT_PD0 - 1;
+                    }
+                    // PD0 is only skipped if there is a single depth to test
+                    if (skip_pd_pass_0)
+                        md_ctx->pred_depth_only = 1;
+                    // Multi-Pass PD
+                    if (!skip_pd_pass_0 &&
+                        pcs_ptr->parent_pcs_ptr->multi_pass_pd_level == MULTI_PASS_PD_ON) {
+                        // [PD_PASS_0]
+                        // Input : mdc_blk_ptr built @ mdc process (up to 4421)
+                        // Output: md_blk_arr_nsq reduced set of block(s)
+                        context_ptr->md_context->pd_pass = PD_PASS_0;
+                        // skip_intra much be TRUE for non-I_SLICE pictures to use light_pd0 path
+                        if (context_ptr->md_context->pd0_level != REGULAR_PD0) {
+                            // [PD_PASS_0] Signal(s) derivation
+                            signal_derivation_enc_dec_kernel_oq_light_pd0(
+                                scs_ptr, pcs_ptr, context_ptr->md_context);
 
-                        if (pcs_ptr->parent_pcs_ptr->palette_level)
-                            // Status of palette info alloc
-                            for (int i = 0; i < scs_ptr->max_block_cnt; ++i)
-                                context_ptr->md_context->md_blk_arr_nsq[i].palette_mem = 0;
-
-                        // Initialize is_subres_safe
-                        context_ptr->md_context->is_subres_safe = (uint8_t)~0;
-                        // Signal initialized here; if needed, will be set in md_encode_block before MDS3
-                        md_ctx->need_hbd_comp_mds3 = 0;
-                        uint8_t skip_pd_pass_0 =
-                            (scs_ptr->super_block_size == 64 &&
-                             context_ptr->md_context->depth_removal_ctrls.disallow_below_64x64)
-                            ? 1
-                            : 0;
-                        if (context_ptr->md_context->skip_pd0)
-                            if (context_ptr->md_context->depth_removal_ctrls.disallow_below_32x32)
-                                skip_pd_pass_0 = 1;
-                        if (context_ptr->md_context->pd0_level == VERY_LIGHT_PD0) {
-                            // Use the next conservative level if not safe to use VLPD0
-                            if (!is_vlpd0_safe(pcs_ptr, md_ctx))
-                                context_ptr->md_context->pd0_level = VERY_LIGHT_PD0 - 1;
-                        }
-                        // PD0 is only skipped if there is a single depth to test
-                        if (skip_pd_pass_0)
-                            md_ctx->pred_depth_only = 1;
-                        // Multi-Pass PD
-                        if (!skip_pd_pass_0 &&
-                            pcs_ptr->parent_pcs_ptr->multi_pass_pd_level == MULTI_PASS_PD_ON) {
-                            // [PD_PASS_0]
-                            // Input : mdc_blk_ptr built @ mdc process (up to 4421)
-                            // Output: md_blk_arr_nsq reduced set of block(s)
-                            context_ptr->md_context->pd_pass = PD_PASS_0;
-                            // skip_intra much be TRUE for non-I_SLICE pictures to use light_pd0 path
-                            if (context_ptr->md_context->pd0_level != REGULAR_PD0) {
-                                // [PD_PASS_0] Signal(s) derivation
-                                signal_derivation_enc_dec_kernel_oq_light_pd0(
-                                    scs_ptr, pcs_ptr, context_ptr->md_context);
-
-                                // Save a clean copy of the neighbor arrays
-                                if (!context_ptr->md_context->skip_intra)
-                                    copy_neighbour_arrays_light_pd0(
-                                        pcs_ptr,
-                                        context_ptr->md_context,
-                                        MD_NEIGHBOR_ARRAY_INDEX,
-                                        MULTI_STAGE_PD_NEIGHBOR_ARRAY_INDEX,
-                                        0,
-                                        sb_origin_x,
-                                        sb_origin_y);
-
-                                // Build the t=0 cand_block_array
-                                build_starting_cand_block_array(
-                                    scs_ptr, pcs_ptr, context_ptr->md_context, sb_index);
-                                mode_decision_sb_light_pd0(scs_ptr,
-                                                           pcs_ptr,
-                                                           mdc_ptr,
-                                                           sb_ptr,
-                                                           sb_origin_x,
-                                                           sb_origin_y,
-                                                           sb_index,
-                                                           context_ptr->md_context);
-                                // Re-build mdc_blk_ptr for the 2nd PD Pass [PD_PASS_1]
-                                // Reset neighnor information to current SB @ position (0,0)
-                                if (!context_ptr->md_context->skip_intra)
-                                    copy_neighbour_arrays_light_pd0(
-                                        pcs_ptr,
-                                        context_ptr->md_context,
-                                        MULTI_STAGE_PD_NEIGHBOR_ARRAY_INDEX,
-                                        MD_NEIGHBOR_ARRAY_INDEX,
-                                        0,
-                                        sb_origin_x,
-                                        sb_origin_y);
-                            } else {
-                                // [PD_PASS_0] Signal(s) derivation
-                                signal_derivation_enc_dec_kernel_oq(
-                                    scs_ptr, pcs_ptr, context_ptr->md_context);
-
-                                // Save a clean copy of the neighbor arrays
-                                copy_neighbour_arrays(pcs_ptr,
-                                                      context_ptr->md_context,
-                                                      MD_NEIGHBOR_ARRAY_INDEX,
-                                                      MULTI_STAGE_PD_NEIGHBOR_ARRAY_INDEX,
-                                                      0,
-                                                      sb_origin_x,
-                                                      sb_origin_y);
-
-                                // Build the t=0 cand_block_array
-                                build_starting_cand_block_array(
-                                    scs_ptr, pcs_ptr, context_ptr->md_context, sb_index);
-                                // PD0 MD Tool(s) : ME_MV(s) as INTER candidate(s), DC as INTRA candidate, luma only, Frequency domain SSE,
-                                // no fast rate (no MVP table generation), MDS0 then MDS3, reduced NIC(s), 1 ref per list,..
-                                mode_decision_sb(scs_ptr,
-                                                 pcs_ptr,
-                                                 mdc_ptr,
-                                                 sb_ptr,
-                                                 sb_origin_x,
-                                                 sb_origin_y,
-                                                 sb_index,
-                                                 context_ptr->md_context);
-                                // Re-build mdc_blk_ptr for the 2nd PD Pass [PD_PASS_1]
-                                // Reset neighnor information to current SB @ position (0,0)
-                                copy_neighbour_arrays(pcs_ptr,
-                                                      context_ptr->md_context,
-                                                      MULTI_STAGE_PD_NEIGHBOR_ARRAY_INDEX,
-                                                      MD_NEIGHBOR_ARRAY_INDEX,
-                                                      0,
-                                                      sb_origin_x,
-                                                      sb_origin_y);
-                            }
-                            // This classifier is used for only pd0_level 0 and pd0_level 1
-                            // where the count_non_zero_coeffs is derived @ PD0
-                            if (context_ptr->md_context->pd0_level != VERY_LIGHT_PD0)
-                                lpd1_detector_post_pd0(pcs_ptr, md_ctx);
-                            // Force pred depth only for modes where that is not the default
-                            if (md_ctx->lpd1_ctrls.pd1_level > REGULAR_PD1) {
-                                set_depth_ctrls(md_ctx, 0);
-                                md_ctx->pred_depth_only = 1;
-                            }
-                            // Perform Pred_0 depth refinement - add depth(s) to be considered in the next stage(s)
-                            perform_pred_depth_refinement(
-                                scs_ptr, pcs_ptr, context_ptr->md_context, sb_index);
-                        }
-                        // [PD_PASS_1] Signal(s) derivation
-                        context_ptr->md_context->pd_pass = PD_PASS_1;
-                        // This classifier is used for the case PD0 is bypassed and for pd0_level 2
-                        // where the count_non_zero_coeffs is not derived @ PD0
-                        if (skip_pd_pass_0 ||
-                            context_ptr->md_context->pd0_level == VERY_LIGHT_PD0) {
-                            lpd1_detector_skip_pd0(pcs_ptr, md_ctx, pic_width_in_sb);
-                        }
+                            // Save a clean copy of the neighbor arrays
+                            if (!context_ptr->md_context->skip_intra)
+                                copy_neighbour_arrays_light_pd0(
+                                    pcs_ptr,
+                                    context_ptr->md_context,
+                                    MD_NEIGHBOR_ARRAY_INDEX,
+                                    MULTI_STAGE_PD_NEIGHBOR_ARRAY_INDEX,
+                                    0,
+                                    sb_origin_x,
+                                    sb_origin_y);
 
-                        // Can only use light-PD1 under the following conditions
-                        if (!(md_ctx->hbd_mode_decision == 0 && md_ctx->pred_depth_only &&
-                              ppcs->disallow_nsq == TRUE && md_ctx->disallow_4x4 == TRUE &&
-                              scs_ptr->super_block_size == 64)) {
-                            md_ctx->lpd1_ctrls.pd1_level = REGULAR_PD1;
-                        }
-                        exaustive_light_pd1_features(
-                            md_ctx, ppcs, md_ctx->lpd1_ctrls.pd1_level > REGULAR_PD1, 0);
-                        if (md_ctx->lpd1_ctrls.pd1_level > REGULAR_PD1)
-                            signal_derivation_enc_dec_kernel_oq_light_pd1(pcs_ptr,
-                                                                          context_ptr->md_context);
-                        else
-                            signal_derivation_enc_dec_kernel_oq(
-                                scs_ptr, pcs_ptr, context_ptr->md_context);
-                        if (!skip_pd_pass_0 &&
-                            pcs_ptr->parent_pcs_ptr->multi_pass_pd_level != MULTI_PASS_PD_OFF)
-                            build_cand_block_array(
-                                scs_ptr,
-                                pcs_ptr,
-                                context_ptr->md_context,
-                                sb_index,
-                                pcs_ptr->parent_pcs_ptr->sb_params_array[sb_index].is_complete_sb);
-                        else
                             // Build the t=0 cand_block_array
                             build_starting_cand_block_array(
                                 scs_ptr, pcs_ptr, context_ptr->md_context, sb_index);
-                        // [PD_PASS_1] Mode Decision - Obtain the final partitioning decision using more accurate info
-                        // than previous stages.  Reduce the total number of partitions to 1.
-                        // Input : mdc_blk_ptr built @ PD0 refinement
-                        // Output: md_blk_arr_nsq reduced set of block(s)
-
-                        // PD1 MD Tool(s): default MD Tool(s)
-                        if (md_ctx->lpd1_ctrls.pd1_level > REGULAR_PD1)
-                            mode_decision_sb_light_pd1(scs_ptr,
+                            mode_decision_sb_light_pd0(scs_ptr,
                                                        pcs_ptr,
                                                        mdc_ptr,
                                                        sb_ptr,
@@ -7634,7 +7783,36 @@ void *mode_decision_kernel(void *input_ptr) {
                                                        sb_origin_y,
                                                        sb_index,
                                                        context_ptr->md_context);
-                        else
+                            // Re-build mdc_blk_ptr for the 2nd PD Pass [PD_PASS_1]
+                            // Reset neighnor information to current SB @ position (0,0)
+                            if (!context_ptr->md_context->skip_intra)
+                                copy_neighbour_arrays_light_pd0(
+                                    pcs_ptr,
+                                    context_ptr->md_context,
+                                    MULTI_STAGE_PD_NEIGHBOR_ARRAY_INDEX,
+                                    MD_NEIGHBOR_ARRAY_INDEX,
+                                    0,
+                                    sb_origin_x,
+                                    sb_origin_y);
+                        } else {
+                            // [PD_PASS_0] Signal(s) derivation
+                            signal_derivation_enc_dec_kernel_oq(
+                                scs_ptr, pcs_ptr, context_ptr->md_context);
+
+                            // Save a clean copy of the neighbor arrays
+                            copy_neighbour_arrays(pcs_ptr,
+                                                  context_ptr->md_context,
+                                                  MD_NEIGHBOR_ARRAY_INDEX,
+                                                  MULTI_STAGE_PD_NEIGHBOR_ARRAY_INDEX,
+                                                  0,
+                                                  sb_origin_x,
+                                                  sb_origin_y);
+
+                            // Build the t=0 cand_block_array
+                            build_starting_cand_block_array(
+                                scs_ptr, pcs_ptr, context_ptr->md_context, sb_index);
+                            // PD0 MD Tool(s) : ME_MV(s) as INTER candidate(s), DC as INTRA candidate, luma only, Frequency domain SSE,
+                            // no fast rate (no MVP table generation), MDS0 then MDS3, reduced NIC(s), 1 ref per list,..
                             mode_decision_sb(scs_ptr,
                                              pcs_ptr,
                                              mdc_ptr,
@@ -7643,132 +7821,262 @@ void *mode_decision_kernel(void *input_ptr) {
                                              sb_origin_y,
                                              sb_index,
                                              context_ptr->md_context);
-                        //if (/*ppcs->is_used_as_reference_flag &&*/ md_ctx->hbd_mode_decision == 0 && scs_ptr->static_config.encoder_bit_depth > EB_8BIT)
-                        //    md_ctx->bypass_encdec = 0;
-                        // Encode Pass
-                        if (!context_ptr->md_context->bypass_encdec) {
-                            av1_encode_decode(scs_ptr,
-                                              pcs_ptr,
-                                              sb_ptr,
-                                              sb_index,
-                                              sb_origin_x,
-                                              sb_origin_y,
-                                              context_ptr);
+                            // Re-build mdc_blk_ptr for the 2nd PD Pass [PD_PASS_1]
+                            // Reset neighnor information to current SB @ position (0,0)
+                            copy_neighbour_arrays(pcs_ptr,
+                                                  context_ptr->md_context,
+                                                  MULTI_STAGE_PD_NEIGHBOR_ARRAY_INDEX,
+                                                  MD_NEIGHBOR_ARRAY_INDEX,
+                                                  0,
+                                                  sb_origin_x,
+                                                  sb_origin_y);
+                        }
+                        // This classifier is used for only pd0_level 0 and pd0_level 1
+                        // where the count_non_zero_coeffs is derived @ PD0
+                        if (context_ptr->md_context->pd0_level != VERY_LIGHT_PD0)
+                            lpd1_detector_post_pd0(pcs_ptr, md_ctx);
+                        // Force pred depth only for modes where that is not the default
+                        if (md_ctx->lpd1_ctrls.pd1_level > REGULAR_PD1) {
+                            set_depth_ctrls(md_ctx, 0);
+                            md_ctx->pred_depth_only = 1;
                         }
-                        av1_encdec_update(scs_ptr,
+                        // Perform Pred_0 depth refinement - add depth(s) to be considered in the next stage(s)
+                        perform_pred_depth_refinement(
+                            scs_ptr, pcs_ptr, context_ptr->md_context, sb_index);
+                    }
+                    // [PD_PASS_1] Signal(s) derivation
+                    context_ptr->md_context->pd_pass = PD_PASS_1;
+                    // This classifier is used for the case PD0 is bypassed and for pd0_level 2
+                    // where the count_non_zero_coeffs is not derived @ PD0
+                    // The light-PD1 level is kept for the static SBs
+                    if (!md_ctx->static_sb &&
+                        (skip_pd_pass_0 || context_ptr->md_context->pd0_level == VERY_LIGHT_PD0)) {
+                        lpd1_detector_skip_pd0(pcs_ptr, md_ctx, pic_width_in_sb);
+                    }
+
+                    // Can only use light-PD1 under the following conditions
+                    if (!(md_ctx->hbd_mode_decision == 0 && md_ctx->pred_depth_only &&
+                          ppcs->disallow_nsq == TRUE && md_ctx->disallow_4x4 == TRUE &&
+                          scs_ptr->super_block_size == 64)) {
+                        md_ctx->lpd1_ctrls.pd1_level = REGULAR_PD1;
+                    }
+                    exaustive_light_pd1_features(
+                        md_ctx, ppcs, md_ctx->lpd1_ctrls.pd1_level > REGULAR_PD1, 0);
+                    if (md_ctx->lpd1_ctrls.pd1_level > REGULAR_PD1)
+                        signal_derivation_enc_dec_kernel_oq_light_pd1(pcs_ptr,
+                                                                      context_ptr->md_context);
+                    else
+                        signal_derivation_enc_dec_kernel_oq(
+                            scs_ptr, pcs_ptr, context_ptr->md_context);
+                    if (!skip_pd_pass_0 &&
+                        pcs_ptr->parent_pcs_ptr->multi_pass_pd_level != MULTI_PASS_PD_OFF)
+                        build_cand_block_array(
+                            scs_ptr,
+                            pcs_ptr,
+                            context_ptr->md_context,
+                            sb_index,
+                            pcs_ptr->parent_pcs_ptr->sb_params_array[sb_index].is_complete_sb);
+                    else
+                        // Build the t=0 cand_block_array
+                        build_starting_cand_block_array(
+                            scs_ptr, pcs_ptr, context_ptr->md_context, sb_index);
+                    // [PD_PASS_1] Mode Decision - Obtain the final partitioning decision using more accurate info
+                    // than previous stages.  Reduce the total number of partitions to 1.
+                    // Input : mdc_blk_ptr built @ PD0 refinement
+                    // Output: md_blk_arr_nsq reduced set of block(s)
+
+                    // PD1 MD Tool(s): default MD Tool(s)
+                    if (md_ctx->lpd1_ctrls.pd1_level > REGULAR_PD1)
+                        mode_decision_sb_light_pd1(scs_ptr,
+                                                   pcs_ptr,
+                                                   mdc_ptr,
+                                                   sb_ptr,
+                                                   sb_origin_x,
+                                                   sb_origin_y,
+                                                   sb_index,
+                                                   context_ptr->md_context);
+                    else
+                        mode_decision_sb(scs_ptr,
+                                         pcs_ptr,
+                                         mdc_ptr,
+                                         sb_ptr,
+                                         sb_origin_x,
+                                         sb_origin_y,
+                                         sb_index,
+                                         context_ptr->md_context);
+                    //if (/*ppcs->is_used_as_reference_flag &&*/ md_ctx->hbd_mode_decision == 0 && scs_ptr->static_config.encoder_bit_depth > EB_8BIT)
+                    //    md_ctx->bypass_encdec = 0;
+                    // Encode Pass
+                    if (!context_ptr->md_context->bypass_encdec) {
+                        av1_encode_decode(scs_ptr,
                                           pcs_ptr,
                                           sb_ptr,
                                           sb_index,
                                           sb_origin_x,
                                           sb_origin_y,
                                           context_ptr);
-
-                        context_ptr->coded_sb_count++;
                     }
-                    x_sb_start_index = (x_sb_start_index > 0) ? x_sb_start_index - 1 : 0;
+                    av1_encdec_update(scs_ptr,
+                                      pcs_ptr,
+                                      sb_ptr,
+                                      sb_index,
+                                      sb_origin_x,
+                                      sb_origin_y,
+                                      context_ptr);
+
+                    context_ptr->coded_sb_count++;
+                    if (pcs_ptr->ec_sb_row_pipeline &&
+                        entropy_coding_sb_row_update(pcs_ptr, sb_index))
+                        post_enc_dec_results(context_ptr, enc_dec_tasks_ptr->pcs_wrapper_ptr);
                 }
+                x_sb_start_index = (x_sb_start_index > 0) ? x_sb_start_index - 1 : 0;
             }
+        }
 
-            svt_block_on_mutex(pcs_ptr->intra_mutex);
-            pcs_ptr->intra_coded_area += (uint32_t)context_ptr->tot_intra_coded_area;
-            pcs_ptr->skip_coded_area += (uint32_t)context_ptr->tot_skip_coded_area;
-            // Accumulate block selection
-            pcs_ptr->enc_dec_coded_sb_count += (uint32_t)context_ptr->coded_sb_count;
-            Bool last_sb_flag = (pcs_ptr->sb_total_count_pix == pcs_ptr->enc_dec_coded_sb_count);
-            svt_release_mutex(pcs_ptr->intra_mutex);
+        svt_block_on_mutex(pcs_ptr->intra_mutex);
+        pcs_ptr->intra_coded_area += (uint32_t)context_ptr->tot_intra_coded_area;
+        pcs_ptr->skip_coded_area += (uint32_t)context_ptr->tot_skip_coded_area;
+        // Accumulate block selection
+        pcs_ptr->enc_dec_coded_sb_count += (uint32_t)context_ptr->coded_sb_count;
+        Bool last_sb_flag = (pcs_ptr->sb_total_count_pix == pcs_ptr->enc_dec_coded_sb_count);
+        // The SB rows above the segment row held by sb_row_recode_init are coded
+        const uint32_t sb_row_recode_sb_count = pcs_ptr->sb_row_recode_sb_count;
+        const Bool     sb_row_recode_flag     = sb_row_recode_sb_count &&
+            sb_row_recode_sb_count == pcs_ptr->enc_dec_coded_sb_count;
+        if (sb_row_recode_flag)
+            pcs_ptr->sb_row_recode_sb_count = 0;
+        svt_release_mutex(pcs_ptr->intra_mutex);
+
+        if (sb_row_recode_flag) {
+            if (sb_row_recode_decision_maker(pcs_ptr, scs_ptr, sb_row_recode_sb_count))
+                post_enc_dec_recode_tasks(pcs_ptr,
+                                          enc_dec_tasks_ptr->pcs_wrapper_ptr,
+                                          context_ptr->enc_dec_feedback_fifo_ptr);
+            else
+                sb_row_recode_release(pcs_ptr,
+                                      enc_dec_tasks_ptr->pcs_wrapper_ptr,
+                                      context_ptr->enc_dec_feedback_fifo_ptr);
+        }
 
-            if (last_sb_flag) {
-                Bool do_recode = FALSE;
+        if (last_sb_flag) {
+            Bool do_recode = FALSE;
 #if FRFCTR_RC_P9
-                if ((scs_ptr->static_config.rate_control_mode == 1 ||
-                    scs_ptr->static_config.max_bit_rate != 0) &&
+            if ((scs_ptr->static_config.rate_control_mode == 1 ||
+                scs_ptr->static_config.max_bit_rate != 0) &&
 #else
-                if ((scs_ptr->static_config.pass == ENC_MIDDLE_PASS ||
-                     scs_ptr->static_config.pass == ENC_LAST_PASS || scs_ptr->lap_rc ||
-                     scs_ptr->static_config.max_bit_rate != 0) &&
+            if ((scs_ptr->static_config.pass == ENC_MIDDLE_PASS ||
+                 scs_ptr->static_config.pass == ENC_LAST_PASS || scs_ptr->lap_rc ||
+                 scs_ptr->static_config.max_bit_rate != 0) &&
 #endif
-                    scs_ptr->encode_context_ptr->recode_loop != DISALLOW_RECODE) {
-                    recode_loop_decision_maker(pcs_ptr, scs_ptr, &do_recode);
-                }
-
-                if (do_recode) {
-                    pcs_ptr->enc_dec_coded_sb_count = 0;
-                    // re-init mode decision configuration for qp update for re-encode frame
-                    mode_decision_configuration_init_qp_update(pcs_ptr);
-                    // init segment for re-encode frame
-                    init_enc_dec_segement(pcs_ptr->parent_pcs_ptr);
-                    EbObjectWrapper *enc_dec_re_encode_tasks_wrapper_ptr;
-                    uint16_t         tg_count = pcs_ptr->parent_pcs_ptr->tile_group_cols *
-                        pcs_ptr->parent_pcs_ptr->tile_group_rows;
-                    for (uint16_t tile_group_idx = 0; tile_group_idx < tg_count; tile_group_idx++) {
-                        svt_get_empty_object(context_ptr->enc_dec_feedback_fifo_ptr,
-                                             &enc_dec_re_encode_tasks_wrapper_ptr);
-
-                        EncDecTasks *enc_dec_re_encode_tasks_ptr =
-                            (EncDecTasks *)enc_dec_re_encode_tasks_wrapper_ptr->object_ptr;
-                        enc_dec_re_encode_tasks_ptr->pcs_wrapper_ptr =
-                            enc_dec_tasks_ptr->pcs_wrapper_ptr;
-                        enc_dec_re_encode_tasks_ptr->input_type       = ENCDEC_TASKS_MDC_INPUT;
-                        enc_dec_re_encode_tasks_ptr->tile_group_index = tile_group_idx;
-
-                        // Post the Full Results Object
-                        svt_post_full_object(enc_dec_re_encode_tasks_wrapper_ptr);
-                    }
+                scs_ptr->encode_context_ptr->recode_loop != DISALLOW_RECODE &&
+                !pcs_ptr->parent_pcs_ptr->sb_row_recode) {
+                recode_loop_decision_maker(pcs_ptr, scs_ptr, &do_recode, 0);
+            }
 
-                } else {
-                    EB_FREE_ARRAY(pcs_ptr->ec_ctx_array);
-                    // Copy film grain data from parent picture set to the reference object for further reference
-                    if (scs_ptr->seq_header.film_grain_params_present) {
-                        if (pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag == TRUE &&
-                            pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr) {
-                            ((EbReferenceObject *)
-                                 pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)
-                                ->film_grain_params =
-                                pcs_ptr->parent_pcs_ptr->frm_hdr.film_grain_params;
-                        }
-                    }
-                    // Force each frame to update their data so future frames can use it,
-                    // even if the current frame did not use it.  This enables REF frames to
-                    // have the feature off, while NREF frames can have it on.  Used for multi-threading.
+            if (do_recode) {
+                post_enc_dec_recode_tasks(pcs_ptr,
+                                          enc_dec_tasks_ptr->pcs_wrapper_ptr,
+                                          context_ptr->enc_dec_feedback_fifo_ptr);
+            } else {
+                if (scs_ptr->static_config.enable_frame_stats)
+                    pcs_ptr->parent_pcs_ptr->enc_dec_done_time = svt_av1_get_time_us();
+                EB_FREE_ARRAY(pcs_ptr->ec_ctx_array);
+                // Copy film grain data from parent picture set to the reference object for further reference
+                if (scs_ptr->seq_header.film_grain_params_present) {
                     if (pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag == TRUE &&
-                        pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr)
-                        for (int frame = LAST_FRAME; frame <= ALTREF_FRAME; ++frame)
-                            ((EbReferenceObject *)
-                                 pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)
-                                ->global_motion[frame] =
-                                pcs_ptr->parent_pcs_ptr->global_motion[frame];
-                    svt_memcpy(pcs_ptr->parent_pcs_ptr->av1x->sgrproj_restore_cost,
-                               pcs_ptr->md_rate_estimation_array->sgrproj_restore_fac_bits,
-                               2 * sizeof(int32_t));
-                    svt_memcpy(pcs_ptr->parent_pcs_ptr->av1x->switchable_restore_cost,
-                               pcs_ptr->md_rate_estimation_array->switchable_restore_fac_bits,
-                               3 * sizeof(int32_t));
-                    svt_memcpy(pcs_ptr->parent_pcs_ptr->av1x->wiener_restore_cost,
-                               pcs_ptr->md_rate_estimation_array->wiener_restore_fac_bits,
-                               2 * sizeof(int32_t));
-                    pcs_ptr->parent_pcs_ptr->av1x->rdmult =
-                        context_ptr
-                            ->pic_full_lambda[(context_ptr->bit_depth == EB_10BIT) ? EB_10_BIT_MD
-                                                                                   : EB_8_BIT_MD];
-                    if (pcs_ptr->parent_pcs_ptr->superres_total_recode_loop == 0) {
-                        svt_release_object(pcs_ptr->parent_pcs_ptr->me_data_wrapper_ptr);
-                        pcs_ptr->parent_pcs_ptr->me_data_wrapper_ptr = (EbObjectWrapper *)NULL;
-                        pcs_ptr->parent_pcs_ptr->pa_me_data          = NULL;
+                        pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr) {
+                        ((EbReferenceObject *)
+                             pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)
+                            ->film_grain_params =
+                            pcs_ptr->parent_pcs_ptr->frm_hdr.film_grain_params;
                     }
-                    // Get Empty EncDec Results
-                    svt_get_empty_object(context_ptr->enc_dec_output_fifo_ptr,
-                                         &enc_dec_results_wrapper_ptr);
-                    enc_dec_results_ptr = (EncDecResults *)enc_dec_results_wrapper_ptr->object_ptr;
-                    enc_dec_results_ptr->pcs_wrapper_ptr = enc_dec_tasks_ptr->pcs_wrapper_ptr;
-
-                    // Post EncDec Results
-                    svt_post_full_object(enc_dec_results_wrapper_ptr);
                 }
+                // Force each frame to update their data so future frames can use it,
+                // even if the current frame did not use it.  This enables REF frames to
+                // have the feature off, while NREF frames can have it on.  Used for multi-threading.
+                if (pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag == TRUE &&
+                    pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr)
+                    for (int frame = LAST_FRAME; frame <= ALTREF_FRAME; ++frame)
+                        ((EbReferenceObject *)
+                             pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)
+                            ->global_motion[frame] =
+                            pcs_ptr->parent_pcs_ptr->global_motion[frame];
+                svt_memcpy(pcs_ptr->parent_pcs_ptr->av1x->sgrproj_restore_cost,
+                           pcs_ptr->md_rate_estimation_array->sgrproj_restore_fac_bits,
+                           2 * sizeof(int32_t));
+                svt_memcpy(pcs_ptr->parent_pcs_ptr->av1x->switchable_restore_cost,
+                           pcs_ptr->md_rate_estimation_array->switchable_restore_fac_bits,
+                           3 * sizeof(int32_t));
+                svt_memcpy(pcs_ptr->parent_pcs_ptr->av1x->wiener_restore_cost,
+                           pcs_ptr->md_rate_estimation_array->wiener_restore_fac_bits,
+                           2 * sizeof(int32_t));
+                pcs_ptr->parent_pcs_ptr->av1x->rdmult =
+                    context_ptr
+                        ->pic_full_lambda[(context_ptr->bit_depth == EB_10BIT) ? EB_10_BIT_MD
+                                                                               : EB_8_BIT_MD];
+                if (pcs_ptr->parent_pcs_ptr->superres_total_recode_loop == 0) {
+                    svt_release_object(pcs_ptr->parent_pcs_ptr->me_data_wrapper_ptr);
+                    pcs_ptr->parent_pcs_ptr->me_data_wrapper_ptr = (EbObjectWrapper *)NULL;
+                    pcs_ptr->parent_pcs_ptr->pa_me_data          = NULL;
+                }
+                // With the SB row pipeline, the results wait for the last entropy coded SB row
+                if (!pcs_ptr->ec_sb_row_pipeline || entropy_coding_enc_dec_done(pcs_ptr))
+                    post_enc_dec_results(context_ptr, enc_dec_tasks_ptr->pcs_wrapper_ptr);
             }
         }
-        // Release Mode Decision Results
-        svt_release_object(enc_dec_tasks_wrapper_ptr);
     }
+    // Release Mode Decision Results
+    svt_release_object(enc_dec_tasks_wrapper_ptr);
+}
+
+/*********************************************************************************
+*
+* @brief
+*  The EncDec process contains both the mode decision and the encode pass engines
+*  of the encoder. The mode decision encapsulates multiple partitioning decision (PD) stages
+*  and multiple mode decision (MD) stages. At the end of the last mode decision stage,
+*  the winning partition and modes combinations per block get reconstructed in the encode pass
+*  operation which is part of the common section between the encoder and the decoder
+*  Common encoder and decoder tasks such as Intra Prediction, Motion Compensated Prediction,
+*  Transform, Quantization are performed in this process.
+*
+* @par Description:
+*  The EncDec process operates on an SB basis.
+*  The EncDec process takes as input the Motion Vector XY pairs candidates
+*  and corresponding distortion estimates from the Motion Estimation process,
+*  and the picture-level QP from the Rate Control process. All inputs are passed
+*  through the picture structures: PictureControlSet and SequenceControlSet.
+*  local structures of type EncDecContext and ModeDecisionContext contain all parameters
+*  and results corresponding to the SuperBlock being processed.
+*  each of the context structures is local to on thread and thus there's no risk of
+*  affecting (changing) other SBs data in the process.
+*
+* @param[in] Vector
+*  Motion Vector XY pairs from Motion Estimation process
+*
+* @param[in] Distortion Estimates
+*  Distortion estimates from Motion Estimation process
+*
+* @param[in] Picture QP
+*  Picture Quantization Parameter from Rate Control process
+*
+* @param[out] Blocks
+*  The encode pass takes the selected partitioning and coding modes as input from mode decision for each
+*  superblock and produces quantized transfrom coefficients for the residuals and the appropriate syntax
+*  elements to be sent to the entropy coding engine
+*
+********************************************************************************/
+void *mode_decision_kernel(void *input_ptr) {
+    EbThreadContext *thread_context_ptr = (EbThreadContext *)input_ptr;
+    EncDecContext   *context_ptr        = (EncDecContext *)thread_context_ptr->priv;
+    EbObjectWrapper *enc_dec_tasks_wrapper_ptr;
+
+    for (;;) {
+        // Get Mode Decision Results
+        EB_GET_FULL_OBJECT(context_ptr->mode_decision_input_fifo_ptr, &enc_dec_tasks_wrapper_ptr);
+        mode_decision_process_task(thread_context_ptr, enc_dec_tasks_wrapper_ptr);
+    }
+
     return NULL;
 }
 
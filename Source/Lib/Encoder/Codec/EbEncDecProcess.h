@@ -86,6 +86,8 @@ typedef struct EncDecContext {
     uint16_t tile_group_index;
     uint16_t tile_index;
     uint32_t coded_sb_count;
+    // crc_calculator - hash of the SB source, see get_sb_src_hash
+    CRC_CALCULATOR crc_calculator;
 } EncDecContext;
 
 /**************************************
@@ -96,6 +98,8 @@ extern EbErrorType enc_dec_context_ctor(EbThreadContext   *thread_context_ptr,
                                         int tasks_index);
 
 extern void *mode_decision_kernel(void *input_ptr);
+extern void mode_decision_process_task(EbThreadContext *thread_context_ptr,
+                                       EbObjectWrapper *enc_dec_tasks_wrapper_ptr);
 
 #ifdef __cplusplus
 }
@@ -18,12 +18,18 @@
 #ifdef __cplusplus
 extern "C" {
 #endif
+#define DLF_TASKS_ENCDEC_INPUT 0
+#define DLF_TASKS_DLF_INPUT 1
+#define DLF_TASKS_CONTINUE 2
+
 /**************************************
      * Process Results
      **************************************/
 typedef struct EncDecResults {
     EbDctor          dctor;
     EbObjectWrapper *pcs_wrapper_ptr;
+    uint32_t         input_type;
+    int16_t          dlf_segment_row;
 } EncDecResults;
 
 typedef struct DlfResults {
@@ -1573,6 +1573,9 @@ EbErrorType entropy_tile_info_ctor(EntropyTileInfo *eti, uint32_t buf_size) {
     eti->dctor               = entropy_tile_info_dctor;
     EB_NEW(eti->entropy_coder_ptr, entropy_coder_ctor, buf_size);
     eti->entropy_coding_tile_done = FALSE;
+    eti->sb_rows_coded            = 0;
+    eti->sb_row_coding            = FALSE;
+    eti->tok                      = NULL;
     return return_error;
 }
 
@@ -1605,6 +1608,7 @@ static void entropy_coder_dctor(EbPtr p) {
     EntropyCoder        *obj                  = (EntropyCoder *)p;
     OutputBitstreamUnit *output_bitstream_ptr = (OutputBitstreamUnit *)obj->ec_output_bitstream_ptr;
     EB_DELETE(output_bitstream_ptr);
+    svt_od_ec_enc_clear(&obj->ec_writer.ec);
 
     EB_FREE(obj->fc);
 }
@@ -37,6 +37,11 @@ typedef struct EntropyTileInfo {
     EbDctor       dctor;
     EntropyCoder* entropy_coder_ptr;
     Bool        entropy_coding_tile_done;
+    // SB row pipeline (PictureControlSet::ec_sb_row_pipeline), protected by
+    // entropy_coding_pic_mutex
+    uint16_t    sb_rows_coded;
+    Bool        sb_row_coding; // a thread is coding the rows of the tile
+    TOKENEXTRA* tok; // palette tokens position between two rows
 } EntropyTileInfo;
 
 extern EbErrorType entropy_tile_info_ctor(EntropyTileInfo* entropy_tile_info_ptr,
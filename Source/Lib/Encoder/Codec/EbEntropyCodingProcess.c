@@ -21,6 +21,7 @@
 #include "EbLog.h"
 #include "common_dsp_rtcd.h"
 #define AV1_MIN_TILE_SIZE_BYTES 1
+#define EC_MIN_BUFFER_SIZE 62025
 void svt_av1_reset_loop_restoration(PictureControlSet *piCSetPtr, uint16_t tile_idx);
 
 static void rest_context_dctor(EbPtr p) {
@@ -160,15 +161,42 @@ void svt_av1_build_nmv_cost_table(int32_t *mvjoint, int32_t *mvcost[2], const Nm
     build_nmv_component_cost_table(mvcost[1], &ctx->comps[1], precision);
 }
 
+/**************************************************
+ * Entropy Coding Buffer Size
+ *   Size of the coder buffers of one tile, from the MD rate
+ *   of the sb_count SBs of the picture coded so far.  The MD
+ *   rate misses part of the side information, hence the 2x
+ *   margin.  The buffers are kept across the pictures, so the
+ *   coder does not need to grow them while coding.
+ **************************************************/
+static uint32_t entropy_coding_buffer_size(PictureControlSet *pcs_ptr, uint32_t sb_count,
+                                           uint16_t tile_cnt) {
+    PictureParentControlSet *ppcs_ptr = pcs_ptr->parent_pcs_ptr;
+    OutputBitstreamUnit     *output_bitstream_ptr =
+        (OutputBitstreamUnit *)pcs_ptr->entropy_coding_info[0]
+            ->entropy_coder_ptr->ec_output_bitstream_ptr;
+
+    svt_block_on_mutex(ppcs_ptr->pcs_total_rate_mutex);
+    uint64_t size = ppcs_ptr->pcs_total_rate >> (AV1_PROB_COST_SHIFT + 3);
+    svt_release_mutex(ppcs_ptr->pcs_total_rate_mutex);
+    size = 2 * size * pcs_ptr->sb_total_count_pix / (MAX(sb_count, 1) * tile_cnt);
+
+    return (uint32_t)CLIP3(EC_MIN_BUFFER_SIZE,
+                           MAX(EC_MIN_BUFFER_SIZE, output_bitstream_ptr->size),
+                           size);
+}
+
 /**************************************************
  * Reset Entropy Coding Picture
  **************************************************/
 static void reset_entropy_coding_picture(EntropyCodingContext *context_ptr,
-                                         PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr) {
+                                         PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr,
+                                         uint32_t sb_count) {
     uint16_t tile_cnt = pcs_ptr->parent_pcs_ptr->av1_cm->tiles_info.tile_rows *
         pcs_ptr->parent_pcs_ptr->av1_cm->tiles_info.tile_cols;
     uint16_t tile_idx = 0;
     uint32_t entropy_coding_qp;
+    uint32_t buffer_size = entropy_coding_buffer_size(pcs_ptr, sb_count, tile_cnt);
 
     context_ptr->is_16bit = (Bool)(scs_ptr->static_config.encoder_bit_depth > EB_8BIT);
     FrameHeader *frm_hdr  = &pcs_ptr->parent_pcs_ptr->frm_hdr;
@@ -202,7 +230,8 @@ static void reset_entropy_coding_picture(EntropyCodingContext *context_ptr,
             pcs_ptr->entropy_coding_info[tile_idx]->entropy_coder_ptr->ec_writer.allow_update_cdf &&
             !frm_hdr->disable_cdf_update;
         aom_start_encode(&pcs_ptr->entropy_coding_info[tile_idx]->entropy_coder_ptr->ec_writer,
-                         output_bitstream_ptr);
+                         output_bitstream_ptr,
+                         buffer_size);
         // ADD Reset here
         if (pcs_ptr->parent_pcs_ptr->frm_hdr.primary_ref_frame != PRIMARY_REF_NONE)
             svt_memcpy(
@@ -220,164 +249,336 @@ static void reset_entropy_coding_picture(EntropyCodingContext *context_ptr,
     return;
 }
 
+/******************************************************
+ * Entropy Coding SB Row
+ *   Codes the SBs of the SB row y_sb_index of the tile
+ ******************************************************/
+static void entropy_coding_sb_row(EntropyCodingContext *context_ptr, PictureControlSet *pcs_ptr,
+                                  SequenceControlSet *scs_ptr, uint16_t tile_idx,
+                                  uint32_t y_sb_index) {
+    uint8_t sb_sz = (uint8_t)scs_ptr->sb_size_pix;
+
+    uint8_t          sb_size_log2    = (uint8_t)svt_log2f(sb_sz);
+    uint32_t         pic_width_in_sb = (pcs_ptr->parent_pcs_ptr->aligned_width + sb_sz - 1) >>
+        sb_size_log2;
+    Av1Common *const cm              = pcs_ptr->parent_pcs_ptr->av1_cm;
+    const uint16_t   tile_col        = tile_idx % cm->tiles_info.tile_cols;
+    const uint16_t   tile_row        = tile_idx / cm->tiles_info.tile_cols;
+    const uint16_t   tile_sb_start_x = cm->tiles_info.tile_col_start_mi[tile_col] >>
+        scs_ptr->seq_header.sb_size_log2;
+    const uint16_t tile_sb_start_y = cm->tiles_info.tile_row_start_mi[tile_row] >>
+        scs_ptr->seq_header.sb_size_log2;
+
+    uint16_t tile_width_in_sb = (cm->tiles_info.tile_col_start_mi[tile_col + 1] -
+                                 cm->tiles_info.tile_col_start_mi[tile_col]) >>
+        scs_ptr->seq_header.sb_size_log2;
+
+    for (uint32_t x_sb_index = 0; x_sb_index < tile_width_in_sb; ++x_sb_index) {
+        uint16_t    sb_index = (uint16_t)((x_sb_index + tile_sb_start_x) +
+                                       (y_sb_index + tile_sb_start_y) * pic_width_in_sb);
+        SuperBlock *sb_ptr   = pcs_ptr->sb_ptr_array[sb_index];
+
+        context_ptr->sb_origin_x = (x_sb_index + tile_sb_start_x) << sb_size_log2;
+        context_ptr->sb_origin_y = (y_sb_index + tile_sb_start_y) << sb_size_log2;
+        if (x_sb_index == 0 && y_sb_index == 0) {
+            svt_av1_reset_loop_restoration(pcs_ptr, tile_idx);
+            context_ptr->tok = pcs_ptr->tile_tok[tile_row][tile_col];
+        }
+
+        EbPictureBufferDesc *coeff_picture_ptr =
+            pcs_ptr->parent_pcs_ptr->enc_dec_ptr->quantized_coeff[sb_index];
+        write_sb(context_ptr,
+                 sb_ptr,
+                 pcs_ptr,
+                 tile_idx,
+                 pcs_ptr->entropy_coding_info[tile_idx]->entropy_coder_ptr,
+                 coeff_picture_ptr);
+    }
+}
+
+/******************************************************
+ * entropy_coding_sb_row_init
+ *   Decides if the SB rows of the picture are entropy coded by
+ *   the EncDec threads, and resets the row pipeline.  Inside a
+ *   tile the SBs are coded in order, so a SB row can only be
+ *   coded early when nothing decided after EncDec is coded in
+ *   the tile data (CDEF strengths, restoration coefficients) and
+ *   when the picture cannot be re-encoded.
+ ******************************************************/
+void entropy_coding_sb_row_init(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr,
+                                Bool superres_recode) {
+    PictureParentControlSet *ppcs_ptr = pcs_ptr->parent_pcs_ptr;
+    Av1Common *const         cm       = ppcs_ptr->av1_cm;
+    const uint16_t           tile_cnt = cm->tiles_info.tile_rows * cm->tiles_info.tile_cols;
+    const uint16_t pic_height_in_sb   = (ppcs_ptr->aligned_height + scs_ptr->sb_size_pix - 1) /
+        scs_ptr->sb_size_pix;
+
+    const Bool enc_dec_bypass = scs_ptr->static_config.pass == ENC_FIRST_PASS ||
+        scs_ptr->static_config.lookahead_only ||
+        (!ppcs_ptr->is_used_as_reference_flag && scs_ptr->rc_stat_gen_pass_mode &&
+         !ppcs_ptr->first_frame_in_minigop);
+    // Same test as the recode decision at the end of EncDec
+#if FRFCTR_RC_P9
+    const Bool recode = (scs_ptr->static_config.rate_control_mode == 1 ||
+                         scs_ptr->static_config.max_bit_rate != 0) &&
+#else
+    const Bool recode = (scs_ptr->static_config.pass == ENC_MIDDLE_PASS ||
+                         scs_ptr->static_config.pass == ENC_LAST_PASS || scs_ptr->lap_rc ||
+                         scs_ptr->static_config.max_bit_rate != 0) &&
+#endif
+        scs_ptr->encode_context_ptr->recode_loop != DISALLOW_RECODE;
+
+    pcs_ptr->ec_sb_row_pipeline = !enc_dec_bypass && !recode && !superres_recode &&
+        ppcs_ptr->superres_total_recode_loop == 0 && !ppcs_ptr->frm_hdr.allow_intrabc &&
+        !(scs_ptr->seq_header.cdef_level && ppcs_ptr->cdef_level) &&
+        !scs_ptr->seq_header.enable_restoration;
+    if (!pcs_ptr->ec_sb_row_pipeline)
+        return;
+
+    memset(pcs_ptr->ec_sb_row_ready_count,
+           0,
+           sizeof(*pcs_ptr->ec_sb_row_ready_count) * pic_height_in_sb * cm->tiles_info.tile_cols);
+    pcs_ptr->ec_sb_rows_left = pic_height_in_sb * cm->tiles_info.tile_cols;
+    pcs_ptr->ec_enc_dec_done = FALSE;
+    for (uint16_t tile_idx = 0; tile_idx < tile_cnt; tile_idx++) {
+        pcs_ptr->entropy_coding_info[tile_idx]->sb_rows_coded = 0;
+        pcs_ptr->entropy_coding_info[tile_idx]->sb_row_coding = FALSE;
+    }
+}
+
+/******************************************************
+ * entropy_coding_sb_row_update
+ *   Called by EncDec for each final SB when ec_sb_row_pipeline
+ *   is set.  Codes the SB rows of the tile that are complete,
+ *   unless another thread is coding the tile, in which case
+ *   that thread goes on with the new rows.
+ *   Returns TRUE when the caller must post the EncDec results
+ *   of the picture (EncDec already done and no SB row left).
+ ******************************************************/
+Bool entropy_coding_sb_row_update(PictureControlSet *pcs_ptr, uint16_t sb_index) {
+    SequenceControlSet *scs_ptr = (SequenceControlSet *)pcs_ptr->scs_wrapper_ptr->object_ptr;
+    Av1Common *const    cm      = pcs_ptr->parent_pcs_ptr->av1_cm;
+    const uint16_t      sb_sz   = (uint16_t)scs_ptr->sb_size_pix;
+    const uint16_t pic_width_in_sb  = (pcs_ptr->parent_pcs_ptr->aligned_width + sb_sz - 1) /
+        sb_sz;
+    const uint16_t pic_height_in_sb = (pcs_ptr->parent_pcs_ptr->aligned_height + sb_sz - 1) /
+        sb_sz;
+    const uint16_t tile_cols        = cm->tiles_info.tile_cols;
+    const uint16_t tile_idx         = pcs_ptr->sb_ptr_array[sb_index]->tile_info.tile_rs_index;
+    const uint16_t tile_col         = tile_idx % tile_cols;
+    const uint16_t tile_row         = tile_idx / tile_cols;
+    const uint16_t tile_sb_start_y  = cm->tiles_info.tile_row_start_mi[tile_row] >>
+        scs_ptr->seq_header.sb_size_log2;
+    const uint16_t tile_width_in_sb = (cm->tiles_info.tile_col_start_mi[tile_col + 1] -
+                                       cm->tiles_info.tile_col_start_mi[tile_col]) >>
+        scs_ptr->seq_header.sb_size_log2;
+    const uint16_t tile_height_in_sb = (cm->tiles_info.tile_row_start_mi[tile_row + 1] -
+                                        cm->tiles_info.tile_row_start_mi[tile_row]) >>
+        scs_ptr->seq_header.sb_size_log2;
+    EntropyTileInfo *tile_info_ptr   = pcs_ptr->entropy_coding_info[tile_idx];
+    uint16_t        *ready_count     = pcs_ptr->ec_sb_row_ready_count + tile_col;
+    Bool             code_row        = FALSE;
+    Bool             post_results    = FALSE;
+
+    svt_block_on_mutex(pcs_ptr->entropy_coding_pic_mutex);
+    ready_count[(sb_index / pic_width_in_sb) * tile_cols]++;
+    if (!tile_info_ptr->sb_row_coding && tile_info_ptr->sb_rows_coded < tile_height_in_sb &&
+        ready_count[(tile_sb_start_y + tile_info_ptr->sb_rows_coded) * tile_cols] ==
+            tile_width_in_sb) {
+        tile_info_ptr->sb_row_coding = code_row = TRUE;
+    }
+    svt_release_mutex(pcs_ptr->entropy_coding_pic_mutex);
+    if (!code_row)
+        return FALSE;
+
+    EntropyCodingContext context;
+    memset(&context, 0, sizeof(context));
+    context.is_16bit = (Bool)(scs_ptr->static_config.encoder_bit_depth > EB_8BIT);
+    context.sb_sz    = sb_sz;
+    context.tok      = tile_info_ptr->tok;
+    while (code_row) {
+        svt_block_on_mutex(pcs_ptr->entropy_coding_pic_mutex);
+        if (pcs_ptr->entropy_coding_pic_reset_flag) {
+            uint32_t sb_count = 0;
+            for (uint32_t i = 0; i < (uint32_t)pic_height_in_sb * tile_cols; i++)
+                sb_count += pcs_ptr->ec_sb_row_ready_count[i];
+            pcs_ptr->entropy_coding_pic_reset_flag = FALSE;
+            reset_entropy_coding_picture(&context, pcs_ptr, scs_ptr, sb_count);
+        }
+        svt_release_mutex(pcs_ptr->entropy_coding_pic_mutex);
+
+        entropy_coding_sb_row(
+            &context, pcs_ptr, scs_ptr, tile_idx, tile_info_ptr->sb_rows_coded);
+
+        svt_block_on_mutex(pcs_ptr->entropy_coding_pic_mutex);
+        tile_info_ptr->sb_rows_coded++;
+        pcs_ptr->ec_sb_rows_left--;
+        code_row = tile_info_ptr->sb_rows_coded < tile_height_in_sb &&
+            ready_count[(tile_sb_start_y + tile_info_ptr->sb_rows_coded) * tile_cols] ==
+                tile_width_in_sb;
+        if (!code_row) {
+            tile_info_ptr->tok           = context.tok;
+            tile_info_ptr->sb_row_coding = FALSE;
+            post_results = pcs_ptr->ec_enc_dec_done && pcs_ptr->ec_sb_rows_left == 0;
+        }
+        svt_release_mutex(pcs_ptr->entropy_coding_pic_mutex);
+    }
+    return post_results;
+}
+
+/******************************************************
+ * entropy_coding_enc_dec_done
+ *   Called by EncDec once all the SBs of the picture are
+ *   final when ec_sb_row_pipeline is set.  Returns TRUE when
+ *   the caller must post the EncDec results (no SB row left),
+ *   otherwise the thread coding the last SB row posts them.
+ ******************************************************/
+Bool entropy_coding_enc_dec_done(PictureControlSet *pcs_ptr) {
+    svt_block_on_mutex(pcs_ptr->entropy_coding_pic_mutex);
+    pcs_ptr->ec_enc_dec_done = TRUE;
+    Bool post_results        = pcs_ptr->ec_sb_rows_left == 0;
+    svt_release_mutex(pcs_ptr->entropy_coding_pic_mutex);
+    return post_results;
+}
+
 /* Entropy Coding */
 
-/*********************************************************************************
-*
-* @brief
-*  The Entropy Coding process is responsible for producing an AV1 conformant bitstream for each frame.
-*
-* @par Description:
-*  The entropy coder is a frame-based process and is based on multi-symbol arithmetic range coding.
-*  It takes as input the coding decisions and information for each block and produces as output the bitstream
-*  for each frame.
-*
-* @param[in] Coding Decisions
-*  Coding decisions and information for each block.
-*
-* @param[out] bitstream
-*  Bitstream for each block
-*
-********************************************************************************/
-void *entropy_coding_kernel(void *input_ptr) {
+/******************************************************
+ * Entropy Coding Task
+ *   Codes the tile referred to by one Rest result, the
+ *   SB rows are already coded with ec_sb_row_pipeline
+ ******************************************************/
+void entropy_coding_process_task(EbThreadContext *thread_context_ptr,
+                                 EbObjectWrapper *rest_results_wrapper_ptr) {
     // Context & SCS & PCS
-    EbThreadContext      *thread_context_ptr = (EbThreadContext *)input_ptr;
     EntropyCodingContext *context_ptr        = (EntropyCodingContext *)thread_context_ptr->priv;
 
     // Input
-    EbObjectWrapper *rest_results_wrapper_ptr;
 
     // Output
     EbObjectWrapper      *entropy_coding_results_wrapper_ptr;
     EntropyCodingResults *entropy_coding_results_ptr;
 
-    for (;;) {
-        // Get Mode Decision Results
-        EB_GET_FULL_OBJECT(context_ptr->enc_dec_input_fifo_ptr, &rest_results_wrapper_ptr);
+    RestResults       *rest_results_ptr = (RestResults *)rest_results_wrapper_ptr->object_ptr;
+    PictureControlSet *pcs_ptr          = (PictureControlSet *)
+                                     rest_results_ptr->pcs_wrapper_ptr->object_ptr;
+    SequenceControlSet *scs_ptr = (SequenceControlSet *)pcs_ptr->scs_wrapper_ptr->object_ptr;
+    // SB Constants
 
-        RestResults       *rest_results_ptr = (RestResults *)rest_results_wrapper_ptr->object_ptr;
-        PictureControlSet *pcs_ptr          = (PictureControlSet *)
-                                         rest_results_ptr->pcs_wrapper_ptr->object_ptr;
-        SequenceControlSet *scs_ptr = (SequenceControlSet *)pcs_ptr->scs_wrapper_ptr->object_ptr;
-        // SB Constants
-
-        uint8_t sb_sz = (uint8_t)scs_ptr->sb_size_pix;
-
-        uint8_t sb_size_log2     = (uint8_t)svt_log2f(sb_sz);
-        context_ptr->sb_sz       = sb_sz;
-        uint32_t pic_width_in_sb = (pcs_ptr->parent_pcs_ptr->aligned_width + sb_sz - 1) >>
-            sb_size_log2;
-        uint16_t         tile_idx        = rest_results_ptr->tile_index;
-        Av1Common *const cm              = pcs_ptr->parent_pcs_ptr->av1_cm;
-        const uint16_t   tile_cnt        = cm->tiles_info.tile_rows * cm->tiles_info.tile_cols;
-        const uint16_t   tile_col        = tile_idx % cm->tiles_info.tile_cols;
-        const uint16_t   tile_row        = tile_idx / cm->tiles_info.tile_cols;
-        const uint16_t   tile_sb_start_x = cm->tiles_info.tile_col_start_mi[tile_col] >>
-            scs_ptr->seq_header.sb_size_log2;
-        const uint16_t tile_sb_start_y = cm->tiles_info.tile_row_start_mi[tile_row] >>
-            scs_ptr->seq_header.sb_size_log2;
-
-        uint16_t tile_width_in_sb = (cm->tiles_info.tile_col_start_mi[tile_col + 1] -
-                                     cm->tiles_info.tile_col_start_mi[tile_col]) >>
-            scs_ptr->seq_header.sb_size_log2;
-        uint16_t tile_height_in_sb = (cm->tiles_info.tile_row_start_mi[tile_row + 1] -
-                                      cm->tiles_info.tile_row_start_mi[tile_row]) >>
-            scs_ptr->seq_header.sb_size_log2;
-
-        Bool frame_entropy_done = FALSE;
+    uint8_t sb_sz = (uint8_t)scs_ptr->sb_size_pix;
 
-        svt_block_on_mutex(pcs_ptr->entropy_coding_pic_mutex);
-        if (pcs_ptr->entropy_coding_pic_reset_flag) {
-            pcs_ptr->entropy_coding_pic_reset_flag = FALSE;
+    context_ptr->sb_sz               = sb_sz;
+    uint16_t         tile_idx        = rest_results_ptr->tile_index;
+    Av1Common *const cm              = pcs_ptr->parent_pcs_ptr->av1_cm;
+    const uint16_t   tile_cnt        = cm->tiles_info.tile_rows * cm->tiles_info.tile_cols;
+    const uint16_t   tile_row        = tile_idx / cm->tiles_info.tile_cols;
 
-            reset_entropy_coding_picture(context_ptr, pcs_ptr, scs_ptr);
-        }
-        svt_release_mutex(pcs_ptr->entropy_coding_pic_mutex);
+    uint16_t tile_height_in_sb = (cm->tiles_info.tile_row_start_mi[tile_row + 1] -
+                                  cm->tiles_info.tile_row_start_mi[tile_row]) >>
+        scs_ptr->seq_header.sb_size_log2;
+
+    Bool frame_entropy_done = FALSE;
+
+    svt_block_on_mutex(pcs_ptr->entropy_coding_pic_mutex);
+    if (pcs_ptr->entropy_coding_pic_reset_flag) {
+        pcs_ptr->entropy_coding_pic_reset_flag = FALSE;
+
+        reset_entropy_coding_picture(context_ptr, pcs_ptr, scs_ptr, pcs_ptr->sb_total_count_pix);
+    }
+    svt_release_mutex(pcs_ptr->entropy_coding_pic_mutex);
 
 #if TURN_OFF_EC_FIRST_PASS
-        if (scs_ptr->static_config.pass != ENC_FIRST_PASS &&
-            !(!pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag &&
-              scs_ptr->rc_stat_gen_pass_mode && !pcs_ptr->parent_pcs_ptr->first_frame_in_minigop)) {
+    if (scs_ptr->static_config.pass != ENC_FIRST_PASS && !scs_ptr->static_config.lookahead_only &&
+        !(!pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag &&
+          scs_ptr->rc_stat_gen_pass_mode && !pcs_ptr->parent_pcs_ptr->first_frame_in_minigop)) {
 #endif
-            for (uint32_t y_sb_index = 0; y_sb_index < tile_height_in_sb; ++y_sb_index) {
-                for (uint32_t x_sb_index = 0; x_sb_index < tile_width_in_sb; ++x_sb_index) {
-                    uint16_t    sb_index = (uint16_t)((x_sb_index + tile_sb_start_x) +
-                                                   (y_sb_index + tile_sb_start_y) *
-                                                       pic_width_in_sb);
-                    SuperBlock *sb_ptr   = pcs_ptr->sb_ptr_array[sb_index];
-
-                    context_ptr->sb_origin_x = (x_sb_index + tile_sb_start_x) << sb_size_log2;
-                    context_ptr->sb_origin_y = (y_sb_index + tile_sb_start_y) << sb_size_log2;
-                    if (x_sb_index == 0 && y_sb_index == 0) {
-                        svt_av1_reset_loop_restoration(pcs_ptr, tile_idx);
-                        context_ptr->tok = pcs_ptr->tile_tok[tile_row][tile_col];
-                    }
-
-                    EbPictureBufferDesc *coeff_picture_ptr =
-                        pcs_ptr->parent_pcs_ptr->enc_dec_ptr->quantized_coeff[sb_index];
-                    write_sb(context_ptr,
-                             sb_ptr,
-                             pcs_ptr,
-                             tile_idx,
-                             pcs_ptr->entropy_coding_info[tile_idx]->entropy_coder_ptr,
-                             coeff_picture_ptr);
-                }
-            }
-#if TURN_OFF_EC_FIRST_PASS
+        if (!pcs_ptr->ec_sb_row_pipeline) {
+            for (uint32_t y_sb_index = 0; y_sb_index < tile_height_in_sb; ++y_sb_index)
+                entropy_coding_sb_row(context_ptr, pcs_ptr, scs_ptr, tile_idx, y_sb_index);
         }
+#if TURN_OFF_EC_FIRST_PASS
+    }
 #endif
-        Bool pic_ready = TRUE;
+    Bool pic_ready = TRUE;
 
-        // Current tile ready
-        encode_slice_finish(pcs_ptr->entropy_coding_info[tile_idx]->entropy_coder_ptr);
+    // Current tile ready
+    encode_slice_finish(pcs_ptr->entropy_coding_info[tile_idx]->entropy_coder_ptr);
 
-        svt_block_on_mutex(pcs_ptr->entropy_coding_pic_mutex);
-        pcs_ptr->entropy_coding_info[tile_idx]->entropy_coding_tile_done = TRUE;
-        for (uint16_t i = 0; i < tile_cnt; i++) {
-            if (pcs_ptr->entropy_coding_info[i]->entropy_coding_tile_done == FALSE) {
-                pic_ready = FALSE;
-                break;
-            }
+    svt_block_on_mutex(pcs_ptr->entropy_coding_pic_mutex);
+    pcs_ptr->entropy_coding_info[tile_idx]->entropy_coding_tile_done = TRUE;
+    for (uint16_t i = 0; i < tile_cnt; i++) {
+        if (pcs_ptr->entropy_coding_info[i]->entropy_coding_tile_done == FALSE) {
+            pic_ready = FALSE;
+            break;
         }
-        svt_release_mutex(pcs_ptr->entropy_coding_pic_mutex);
-        if (pic_ready) {
-            if (pcs_ptr->parent_pcs_ptr->superres_total_recode_loop == 0) {
-                // Release the List 0 Reference Pictures
-                for (uint32_t ref_idx = 0; ref_idx < pcs_ptr->parent_pcs_ptr->ref_list0_count;
-                     ++ref_idx) {
-                    if (pcs_ptr->ref_pic_ptr_array[0][ref_idx] != NULL) {
-                        svt_release_object(pcs_ptr->ref_pic_ptr_array[0][ref_idx]);
-                    }
+    }
+    svt_release_mutex(pcs_ptr->entropy_coding_pic_mutex);
+    if (pic_ready) {
+        if (pcs_ptr->parent_pcs_ptr->superres_total_recode_loop == 0) {
+            // Release the List 0 Reference Pictures
+            for (uint32_t ref_idx = 0; ref_idx < pcs_ptr->parent_pcs_ptr->ref_list0_count;
+                 ++ref_idx) {
+                if (pcs_ptr->ref_pic_ptr_array[0][ref_idx] != NULL) {
+                    svt_release_object(pcs_ptr->ref_pic_ptr_array[0][ref_idx]);
                 }
-                // Release the List 1 Reference Pictures
-                for (uint32_t ref_idx = 0; ref_idx < pcs_ptr->parent_pcs_ptr->ref_list1_count;
-                     ++ref_idx) {
-                    if (pcs_ptr->ref_pic_ptr_array[1][ref_idx] != NULL) {
-                        svt_release_object(pcs_ptr->ref_pic_ptr_array[1][ref_idx]);
-                    }
+            }
+            // Release the List 1 Reference Pictures
+            for (uint32_t ref_idx = 0; ref_idx < pcs_ptr->parent_pcs_ptr->ref_list1_count;
+                 ++ref_idx) {
+                if (pcs_ptr->ref_pic_ptr_array[1][ref_idx] != NULL) {
+                    svt_release_object(pcs_ptr->ref_pic_ptr_array[1][ref_idx]);
                 }
-
-                //free palette data
-                if (pcs_ptr->tile_tok[0][0])
-                    EB_FREE_ARRAY(pcs_ptr->tile_tok[0][0]);
             }
-            frame_entropy_done = TRUE;
+
+            //free palette data
+            if (pcs_ptr->tile_tok[0][0])
+                EB_FREE_ARRAY(pcs_ptr->tile_tok[0][0]);
         }
+        frame_entropy_done = TRUE;
+    }
 
-        if (frame_entropy_done) {
-            // Get Empty Entropy Coding Results
-            svt_get_empty_object(context_ptr->entropy_coding_output_fifo_ptr,
-                                 &entropy_coding_results_wrapper_ptr);
-            entropy_coding_results_ptr = (EntropyCodingResults *)
-                                             entropy_coding_results_wrapper_ptr->object_ptr;
-            entropy_coding_results_ptr->pcs_wrapper_ptr = rest_results_ptr->pcs_wrapper_ptr;
+    if (frame_entropy_done) {
+        // Get Empty Entropy Coding Results
+        svt_get_empty_object(context_ptr->entropy_coding_output_fifo_ptr,
+                             &entropy_coding_results_wrapper_ptr);
+        entropy_coding_results_ptr = (EntropyCodingResults *)
+                                         entropy_coding_results_wrapper_ptr->object_ptr;
+        entropy_coding_results_ptr->pcs_wrapper_ptr = rest_results_ptr->pcs_wrapper_ptr;
 
-            // Post EntropyCoding Results
-            svt_post_full_object(entropy_coding_results_wrapper_ptr);
-        }
+        // Post EntropyCoding Results
+        svt_post_full_object(entropy_coding_results_wrapper_ptr);
+    }
+
+    // Release Mode Decision Results
+    svt_release_object(rest_results_wrapper_ptr);
+}
 
-        // Release Mode Decision Results
-        svt_release_object(rest_results_wrapper_ptr);
+/*********************************************************************************
+*
+* @brief
+*  The Entropy Coding process is responsible for producing an AV1 conformant bitstream for each frame.
+*
+* @par Description:
+*  The entropy coder is a frame-based process and is based on multi-symbol arithmetic range coding.
+*  It takes as input the coding decisions and information for each block and produces as output the bitstream
+*  for each frame.
+*
+* @param[in] Coding Decisions
+*  Coding decisions and information for each block.
+*
+* @param[out] bitstream
+*  Bitstream for each block
+*
+********************************************************************************/
+void *entropy_coding_kernel(void *input_ptr) {
+    EbThreadContext      *thread_context_ptr = (EbThreadContext *)input_ptr;
+    EntropyCodingContext *context_ptr        = (EntropyCodingContext *)thread_context_ptr->priv;
+    EbObjectWrapper      *rest_results_wrapper_ptr;
+
+    for (;;) {
+        // Get Mode Decision Results
+        EB_GET_FULL_OBJECT(context_ptr->enc_dec_input_fifo_ptr, &rest_results_wrapper_ptr);
+        entropy_coding_process_task(thread_context_ptr, rest_results_wrapper_ptr);
     }
 
     return NULL;
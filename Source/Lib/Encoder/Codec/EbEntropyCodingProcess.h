@@ -76,5 +76,11 @@ extern EbErrorType entropy_coding_context_ctor(EbThreadContext   *thread_context
                                                int rate_control_index);
 
 extern void *entropy_coding_kernel(void *input_ptr);
+extern void entropy_coding_process_task(EbThreadContext *thread_context_ptr,
+                                        EbObjectWrapper *rest_results_wrapper_ptr);
+extern void entropy_coding_sb_row_init(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr,
+                                       Bool superres_recode);
+extern Bool entropy_coding_sb_row_update(PictureControlSet *pcs_ptr, uint16_t sb_index);
+extern Bool entropy_coding_enc_dec_done(PictureControlSet *pcs_ptr);
 
 #endif // EbEntropyCodingProcess_h
@@ -14,6 +14,7 @@
 
 #include "EbGlobalMotionEstimation.h"
 #include "EbGlobalMotionEstimationCost.h"
+#include "EbEncHandle.h"
 #include "EbReferenceObject.h"
 #include "EbMotionEstimationProcess.h"
 #include "EbEncWarpedMotion.h"
@@ -24,13 +25,143 @@
 #define GMV_ME_SAD_TH_0 0
 #define GMV_ME_SAD_TH_1 5
 #define GMV_ME_SAD_TH_2 10
+// Returns the FAST corners of pic over width x height. The corners of the pictures of a PA
+// reference object are detected once and kept in the object, the other ones go to scratch.
+static int *get_gm_corners(EbPaReferenceObject *pa_ref_obj, uint8_t downsample_level,
+                           EbPictureBufferDesc *pic, int width, int height, int *scratch,
+                           int *num_corners) {
+    EbPictureBufferDesc *level_pic = downsample_level == GM_DOWN16
+        ? pa_ref_obj->sixteenth_downsampled_picture_ptr
+        : downsample_level == GM_DOWN ? pa_ref_obj->quarter_downsampled_picture_ptr
+                                      : pa_ref_obj->input_padded_picture_ptr;
+    unsigned char *buffer = pic->buffer_y + pic->origin_x + pic->origin_y * pic->stride_y;
+    int           *corners = NULL;
+
+    // e.g. the superres downscaled source is not the picture of the object
+    if (buffer == level_pic->buffer_y + level_pic->origin_x +
+                level_pic->origin_y * level_pic->stride_y &&
+        pic->stride_y == level_pic->stride_y && width == level_pic->width &&
+        height == level_pic->height) {
+        svt_block_on_mutex(pa_ref_obj->gm_corners_mutex);
+        if (pa_ref_obj->gm_corners_picture_number[downsample_level] !=
+            pa_ref_obj->picture_number) {
+            if (!pa_ref_obj->gm_corners[downsample_level])
+                EB_NO_THROW_MALLOC(pa_ref_obj->gm_corners[downsample_level],
+                                   sizeof(int) * 2 * MAX_CORNERS);
+            if (pa_ref_obj->gm_corners[downsample_level]) {
+                pa_ref_obj->gm_num_corners[downsample_level] = svt_av1_fast_corner_detect(
+                    buffer,
+                    width,
+                    height,
+                    pic->stride_y,
+                    pa_ref_obj->gm_corners[downsample_level],
+                    MAX_CORNERS);
+                pa_ref_obj->gm_corners_picture_number[downsample_level] =
+                    pa_ref_obj->picture_number;
+            }
+        }
+        if (pa_ref_obj->gm_corners_picture_number[downsample_level] ==
+            pa_ref_obj->picture_number) {
+            corners      = pa_ref_obj->gm_corners[downsample_level];
+            *num_corners = pa_ref_obj->gm_num_corners[downsample_level];
+        }
+        svt_release_mutex(pa_ref_obj->gm_corners_mutex);
+    }
+    if (!corners) {
+        corners      = scratch;
+        *num_corners = svt_av1_fast_corner_detect(
+            buffer, width, height, pic->stride_y, scratch, MAX_CORNERS);
+    }
+    return corners;
+}
+
+static void gm_ref_search(PictureParentControlSet *pcs_ptr, const GmRefSearch *search) {
+    int  ref_corners_scratch[2 * MAX_CORNERS];
+    int  num_ref_corners;
+    int *ref_corners = get_gm_corners(search->ref_object,
+                                      pcs_ptr->gm_ctrls.downsample_level,
+                                      search->ref_pic,
+                                      search->input_pic->width,
+                                      search->input_pic->height,
+                                      ref_corners_scratch,
+                                      &num_ref_corners);
+
+    compute_global_motion(pcs_ptr,
+                          search->input_pic,
+                          search->ref_pic,
+                          search->frm_corners,
+                          search->num_frm_corners,
+                          ref_corners,
+                          num_ref_corners,
+                          search->wm,
+                          pcs_ptr->frm_hdr.allow_high_precision_mv);
+}
+
+// Searches the references of one list. The references after the first one are posted to the
+// GM search threads, if any, and searched concurrently with the first one.
+static void gm_search_refs(PictureParentControlSet *pcs_ptr, const GmRefSearch *searches,
+                           uint32_t search_count, EbFifo *gm_search_task_fifo_ptr) {
+    uint32_t posted_count = 0;
+    if (gm_search_task_fifo_ptr) {
+        for (uint32_t i = 1; i < search_count; ++i) {
+            EbObjectWrapper *task_wrapper_ptr;
+            svt_get_empty_object(gm_search_task_fifo_ptr, &task_wrapper_ptr);
+            GmSearchTask *task_ptr = (GmSearchTask *)task_wrapper_ptr->object_ptr;
+            task_ptr->pcs_ptr      = pcs_ptr;
+            task_ptr->search       = searches[i];
+            svt_post_full_object(task_wrapper_ptr);
+            posted_count++;
+        }
+    }
+    for (uint32_t i = 0; i < search_count - posted_count; ++i) gm_ref_search(pcs_ptr, &searches[i]);
+    for (uint32_t i = 0; i < posted_count; ++i)
+        svt_block_on_semaphore(pcs_ptr->gm_search_done_semaphore);
+}
+
+static void gm_search_context_dctor(EbPtr p) {
+    EbThreadContext *thread_context_ptr = (EbThreadContext *)p;
+    GmSearchContext *obj                = (GmSearchContext *)thread_context_ptr->priv;
+    EB_FREE_ARRAY(obj);
+}
+
+EbErrorType gm_search_context_ctor(EbThreadContext   *thread_context_ptr,
+                                   const EbEncHandle *enc_handle_ptr, int index) {
+    GmSearchContext *context_ptr;
+    EB_CALLOC_ARRAY(context_ptr, 1);
+
+    thread_context_ptr->priv  = context_ptr;
+    thread_context_ptr->dctor = gm_search_context_dctor;
+
+    context_ptr->gm_search_task_input_fifo_ptr = svt_system_resource_get_consumer_fifo(
+        enc_handle_ptr->gm_search_task_resource_ptr, index);
+
+    return EB_ErrorNone;
+}
+
+void *gm_search_kernel(void *input_ptr) {
+    EbThreadContext *thread_context_ptr = (EbThreadContext *)input_ptr;
+    GmSearchContext *context_ptr        = (GmSearchContext *)thread_context_ptr->priv;
+    EbObjectWrapper *task_wrapper_ptr;
+
+    for (;;) {
+        EB_GET_FULL_OBJECT(context_ptr->gm_search_task_input_fifo_ptr, &task_wrapper_ptr);
+
+        GmSearchTask            *task_ptr = (GmSearchTask *)task_wrapper_ptr->object_ptr;
+        PictureParentControlSet *pcs_ptr  = task_ptr->pcs_ptr;
+        gm_ref_search(pcs_ptr, &task_ptr->search);
+
+        svt_release_object(task_wrapper_ptr);
+        svt_post_semaphore(pcs_ptr->gm_search_done_semaphore);
+    }
+    return NULL;
+}
+
 void global_motion_estimation(PictureParentControlSet *pcs_ptr,
-                              EbPictureBufferDesc     *input_picture_ptr) {
+                              EbPictureBufferDesc     *input_picture_ptr,
+                              EbFifo                  *gm_search_task_fifo_ptr) {
     // Get downsampled pictures with a downsampling factor of 2 in each dimension
     EbPaReferenceObject *pa_reference_object;
-    EbPictureBufferDesc *quarter_ref_pic_ptr;
     EbPictureBufferDesc *quarter_picture_ptr;
-    EbPictureBufferDesc *sixteenth_ref_pic_ptr;
     EbPictureBufferDesc *sixteenth_picture_ptr;
     pa_reference_object = (EbPaReferenceObject *)
                               pcs_ptr->pa_reference_picture_wrapper_ptr->object_ptr;
@@ -85,7 +216,23 @@ void global_motion_estimation(PictureParentControlSet *pcs_ptr,
                          100)))) // if more than 5% of SB(s) have stationary block(s) then shut gm
             global_motion_estimation_level = 0;
     }
-    if (global_motion_estimation_level)
+    if (global_motion_estimation_level) {
+        // Set the source picture to be used by the global motion search based on the input
+        // search mode, its corners are detected once for all the references
+        if (pcs_ptr->gm_ctrls.downsample_level == GM_DOWN16)
+            input_picture_ptr = sixteenth_picture_ptr;
+        else if (pcs_ptr->gm_ctrls.downsample_level == GM_DOWN)
+            input_picture_ptr = quarter_picture_ptr;
+        int  frm_corners_scratch[2 * MAX_CORNERS];
+        int  num_frm_corners;
+        int *frm_corners = get_gm_corners(pa_reference_object,
+                                          pcs_ptr->gm_ctrls.downsample_level,
+                                          input_picture_ptr,
+                                          input_picture_ptr->width,
+                                          input_picture_ptr->height,
+                                          frm_corners_scratch,
+                                          &num_frm_corners);
+
         for (uint32_t list_index = REF_LIST_0; list_index < num_of_list_to_search; ++list_index) {
             uint32_t num_of_ref_pic_to_search;
             num_of_ref_pic_to_search = pcs_ptr->slice_type == P_SLICE ? pcs_ptr->ref_list0_count_try
@@ -95,6 +242,7 @@ void global_motion_estimation(PictureParentControlSet *pcs_ptr,
                 num_of_ref_pic_to_search = MIN(num_of_ref_pic_to_search, 1);
             else if (global_motion_estimation_level == 2)
                 num_of_ref_pic_to_search = MIN(num_of_ref_pic_to_search, 2);
+            GmRefSearch searches[REF_LIST_MAX_DEPTH];
             // Ref Picture Loop
             for (uint32_t ref_pic_index = 0; ref_pic_index < num_of_ref_pic_to_search;
                  ++ref_pic_index) {
@@ -104,29 +252,27 @@ void global_motion_estimation(PictureParentControlSet *pcs_ptr,
                                        ->ref_pa_pic_ptr_array[list_index][ref_pic_index]
                                        ->object_ptr;
 
-                // Set the source and the reference picture to be used by the global motion search
-                // based on the input search mode
-                if (pcs_ptr->gm_ctrls.downsample_level == GM_DOWN16) {
-                    sixteenth_ref_pic_ptr = (EbPictureBufferDesc *)
-                                                reference_object->sixteenth_downsampled_picture_ptr;
-                    ref_picture_ptr   = sixteenth_ref_pic_ptr;
-                    input_picture_ptr = sixteenth_picture_ptr;
-                } else if (pcs_ptr->gm_ctrls.downsample_level == GM_DOWN) {
-                    quarter_ref_pic_ptr = (EbPictureBufferDesc *)
-                                              reference_object->quarter_downsampled_picture_ptr;
-                    ref_picture_ptr   = quarter_ref_pic_ptr;
-                    input_picture_ptr = quarter_picture_ptr;
-                } else {
+                // Set the reference picture to be used by the global motion search based on the
+                // input search mode
+                if (pcs_ptr->gm_ctrls.downsample_level == GM_DOWN16)
+                    ref_picture_ptr = (EbPictureBufferDesc *)
+                                          reference_object->sixteenth_downsampled_picture_ptr;
+                else if (pcs_ptr->gm_ctrls.downsample_level == GM_DOWN)
+                    ref_picture_ptr = (EbPictureBufferDesc *)
+                                          reference_object->quarter_downsampled_picture_ptr;
+                else
                     ref_picture_ptr = (EbPictureBufferDesc *)
                                           reference_object->input_padded_picture_ptr;
-                }
 
-                compute_global_motion(pcs_ptr,
-                                      input_picture_ptr,
-                                      ref_picture_ptr,
-                                      &pcs_ptr->global_motion_estimation[list_index][ref_pic_index],
-                                      pcs_ptr->frm_hdr.allow_high_precision_mv);
+                searches[ref_pic_index].input_pic       = input_picture_ptr;
+                searches[ref_pic_index].ref_pic         = ref_picture_ptr;
+                searches[ref_pic_index].ref_object      = reference_object;
+                searches[ref_pic_index].frm_corners     = frm_corners;
+                searches[ref_pic_index].num_frm_corners = num_frm_corners;
+                searches[ref_pic_index].wm =
+                    &pcs_ptr->global_motion_estimation[list_index][ref_pic_index];
             }
+            gm_search_refs(pcs_ptr, searches, num_of_ref_pic_to_search, gm_search_task_fifo_ptr);
 
             if (pcs_ptr->gm_ctrls.identiy_exit) {
                 if (list_index == 0) {
@@ -136,6 +282,7 @@ void global_motion_estimation(PictureParentControlSet *pcs_ptr,
                 }
             }
         }
+    }
     for (uint32_t list_index = REF_LIST_0; list_index < num_of_list_to_search; ++list_index) {
         uint32_t num_of_ref_pic_to_search = pcs_ptr->slice_type == P_SLICE
             ? pcs_ptr->ref_list0_count
@@ -153,8 +300,9 @@ void global_motion_estimation(PictureParentControlSet *pcs_ptr,
 }
 
 void compute_global_motion(PictureParentControlSet *pcs_ptr, EbPictureBufferDesc *input_pic,
-                           EbPictureBufferDesc *ref_pic, EbWarpedMotionParams *bestWarpedMotion,
-                           int allow_high_precision_mv) {
+                           EbPictureBufferDesc *ref_pic, int *frm_corners, int num_frm_corners,
+                           int *ref_corners, int num_ref_corners,
+                           EbWarpedMotionParams *bestWarpedMotion, int allow_high_precision_mv) {
     MotionModel params_by_motion[RANSAC_NUM_MOTIONS];
     for (int m = 0; m < RANSAC_NUM_MOTIONS; m++) {
         memset(&params_by_motion[m], 0, sizeof(params_by_motion[m]));
@@ -181,14 +329,7 @@ void compute_global_motion(PictureParentControlSet *pcs_ptr, EbPictureBufferDesc
     const EbWarpedMotionParams *ref_params = &default_warp_params;
 
     {
-        int frm_corners[2 * MAX_CORNERS], inliers_by_motion[RANSAC_NUM_MOTIONS];
-        // compute interest points using FAST features
-        int num_frm_corners = svt_av1_fast_corner_detect(frm_buffer,
-                                                         input_pic->width,
-                                                         input_pic->height,
-                                                         input_pic->stride_y,
-                                                         frm_corners,
-                                                         MAX_CORNERS);
+        int inliers_by_motion[RANSAC_NUM_MOTIONS];
 
         TransformationType   model;
         EbWarpedMotionParams tmp_wm_params;
@@ -216,6 +357,8 @@ void compute_global_motion(PictureParentControlSet *pcs_ptr, EbPictureBufferDesc
                                           num_frm_corners,
                                           ref_buffer,
                                           ref_pic->stride_y,
+                                          ref_corners,
+                                          num_ref_corners,
                                           EB_8BIT,
                                           gm_estimation_type,
                                           inliers_by_motion,
@@ -15,11 +15,47 @@
 
 #include "EbPictureBufferDesc.h"
 #include "EbMotionEstimationContext.h"
+#include "EbReferenceObject.h"
 
+/**************************************
+ * Global motion search of one reference
+ **************************************/
+typedef struct GmRefSearch {
+    EbPictureBufferDesc  *input_pic;
+    EbPictureBufferDesc  *ref_pic;
+    EbPaReferenceObject  *ref_object;
+    int                  *frm_corners;
+    int                   num_frm_corners;
+    EbWarpedMotionParams *wm;
+} GmRefSearch;
+
+/**************************************
+ * GM search task: a reference search of a picture, run by a GM search
+ * thread while the ME thread of the picture searches another reference.
+ * The thread posts gm_search_done_semaphore of the picture when done.
+ **************************************/
+typedef struct GmSearchTask {
+    EbDctor                  dctor;
+    PictureParentControlSet *pcs_ptr;
+    GmRefSearch              search;
+} GmSearchTask;
+
+typedef struct GmSearchContext {
+    EbFifo *gm_search_task_input_fifo_ptr;
+} GmSearchContext;
+
+EbErrorType gm_search_context_ctor(EbThreadContext *thread_context_ptr,
+                                   const EbEncHandle *enc_handle_ptr, int index);
+extern void *gm_search_kernel(void *input_ptr);
+
+// gm_search_task_fifo_ptr: producer fifo of the GM search tasks, NULL to search all the
+// references in the calling thread
 void global_motion_estimation(PictureParentControlSet *pcs_ptr,
-                              EbPictureBufferDesc     *input_picture_ptr);
+                              EbPictureBufferDesc     *input_picture_ptr,
+                              EbFifo                  *gm_search_task_fifo_ptr);
 void compute_global_motion(PictureParentControlSet *pcs_ptr, EbPictureBufferDesc *input_pic,
-                           EbPictureBufferDesc *ref_pic, EbWarpedMotionParams *bestWarpedMotion,
-                           int allow_high_precision_mv);
+                           EbPictureBufferDesc *ref_pic, int *frm_corners, int num_frm_corners,
+                           int *ref_corners, int num_ref_corners,
+                           EbWarpedMotionParams *bestWarpedMotion, int allow_high_precision_mv);
 
 #endif // EbGlobalMotionEstimation_h
@@ -23,6 +23,7 @@
 #include "EbLog.h"
 #include "EbPictureDecisionProcess.h"
 #include "firstpass.h"
+#include "EbTime.h"
 /**************************************
  * Context
  **************************************/
@@ -489,6 +490,8 @@ void *initial_rate_control_kernel(void *input_ptr) {
         if (pcs_ptr->me_segments_completion_count == pcs_ptr->me_segments_total_count) {
             SequenceControlSet *scs_ptr = (SequenceControlSet *)
                                               pcs_ptr->scs_wrapper_ptr->object_ptr;
+            if (scs_ptr->static_config.enable_frame_stats)
+                pcs_ptr->me_done_time = svt_av1_get_time_us();
 
             if (in_results_ptr->task_type == TASK_SUPERRES_RE_ME) {
                 // do necessary steps as normal routine
@@ -11,6 +11,7 @@
 */
 
 #include <stdlib.h>
+#include <stddef.h>
 
 #include "EbMdRateEstimation.h"
 #include "EbCommonUtils.h"
@@ -65,45 +66,180 @@ void av1_get_syntax_rate_from_cdf(int32_t *costs, const AomCdfProb *cdf, const i
 }
 int av1_filter_intra_allowed_bsize(uint8_t enable_filter_intra, BlockSize bs);
 
+/*************************************************************
+* MD rate groups
+* Tables built from the same set of CDFs, each group owns one
+* bit of MdRateEstimationCache::valid
+**************************************************************/
+typedef enum MdRateGroup {
+    MD_RATE_PARTITION,
+    MD_RATE_SKIP,
+    MD_RATE_Y_MODE,
+    MD_RATE_UV_MODE,
+    MD_RATE_FILTER_INTRA,
+    MD_RATE_INTERP,
+    MD_RATE_PALETTE,
+    MD_RATE_CFL,
+    MD_RATE_TX_SIZE,
+    MD_RATE_TX_TYPE,
+    MD_RATE_ANGLE_DELTA,
+    MD_RATE_RESTORATION,
+    MD_RATE_INTRABC,
+    MD_RATE_REF,
+    MD_RATE_INTER_MODE,
+    MD_RATE_COMPOUND,
+    MD_RATE_INTER_INTRA,
+    MD_RATE_MOTION_MODE,
+    MD_RATE_MV,
+    MD_RATE_DV,
+    MD_RATE_EOB,
+    MD_RATE_COEFF, // one group per tx size
+    MD_RATE_GROUPS = MD_RATE_COEFF + TX_SIZES
+} MdRateGroup;
+
+typedef struct CdfField {
+    uint32_t offset;
+    uint32_t size;
+} CdfField;
+
+#define CDF_FIELD(f) \
+    { offsetof(FRAME_CONTEXT, f), sizeof(((FRAME_CONTEXT *)0)->f) }
+#define MAX_GROUP_CDF_FIELDS 8
+
+// CDFs of each group (up to MD_RATE_EOB), terminated by a 0 size
+static const CdfField md_rate_group_cdfs[MD_RATE_COEFF][MAX_GROUP_CDF_FIELDS] = {
+    [MD_RATE_PARTITION]    = {CDF_FIELD(partition_cdf)},
+    [MD_RATE_SKIP]         = {CDF_FIELD(skip_mode_cdfs), CDF_FIELD(skip_cdfs)},
+    [MD_RATE_Y_MODE]       = {CDF_FIELD(kf_y_cdf), CDF_FIELD(y_mode_cdf)},
+    [MD_RATE_UV_MODE]      = {CDF_FIELD(uv_mode_cdf)},
+    [MD_RATE_FILTER_INTRA] = {CDF_FIELD(filter_intra_mode_cdf), CDF_FIELD(filter_intra_cdfs)},
+    [MD_RATE_INTERP]       = {CDF_FIELD(switchable_interp_cdf)},
+    [MD_RATE_PALETTE]      = {CDF_FIELD(palette_y_size_cdf),
+                              CDF_FIELD(palette_uv_size_cdf),
+                              CDF_FIELD(palette_y_mode_cdf),
+                              CDF_FIELD(palette_uv_mode_cdf),
+                              CDF_FIELD(palette_y_color_index_cdf),
+                              CDF_FIELD(palette_uv_color_index_cdf)},
+    [MD_RATE_CFL]          = {CDF_FIELD(cfl_sign_cdf), CDF_FIELD(cfl_alpha_cdf)},
+    [MD_RATE_TX_SIZE]      = {CDF_FIELD(tx_size_cdf), CDF_FIELD(txfm_partition_cdf)},
+    [MD_RATE_TX_TYPE]      = {CDF_FIELD(inter_ext_tx_cdf), CDF_FIELD(intra_ext_tx_cdf)},
+    [MD_RATE_ANGLE_DELTA]  = {CDF_FIELD(angle_delta_cdf)},
+    [MD_RATE_RESTORATION]  = {CDF_FIELD(switchable_restore_cdf),
+                              CDF_FIELD(wiener_restore_cdf),
+                              CDF_FIELD(sgrproj_restore_cdf)},
+    [MD_RATE_INTRABC]      = {CDF_FIELD(intrabc_cdf)},
+    [MD_RATE_REF]          = {CDF_FIELD(comp_inter_cdf),
+                              CDF_FIELD(single_ref_cdf),
+                              CDF_FIELD(comp_ref_type_cdf),
+                              CDF_FIELD(uni_comp_ref_cdf),
+                              CDF_FIELD(comp_ref_cdf),
+                              CDF_FIELD(comp_bwdref_cdf),
+                              CDF_FIELD(intra_inter_cdf)},
+    [MD_RATE_INTER_MODE]   = {CDF_FIELD(newmv_cdf),
+                              CDF_FIELD(zeromv_cdf),
+                              CDF_FIELD(refmv_cdf),
+                              CDF_FIELD(drl_cdf),
+                              CDF_FIELD(inter_compound_mode_cdf)},
+    [MD_RATE_COMPOUND]     = {CDF_FIELD(compound_type_cdf),
+                              CDF_FIELD(wedge_idx_cdf),
+                              CDF_FIELD(compound_index_cdf),
+                              CDF_FIELD(comp_group_idx_cdf)},
+    [MD_RATE_INTER_INTRA]  = {CDF_FIELD(interintra_cdf),
+                              CDF_FIELD(interintra_mode_cdf),
+                              CDF_FIELD(wedge_interintra_cdf)},
+    [MD_RATE_MOTION_MODE]  = {CDF_FIELD(motion_mode_cdf), CDF_FIELD(obmc_cdf)},
+    [MD_RATE_MV]           = {CDF_FIELD(nmvc)},
+    [MD_RATE_DV]           = {CDF_FIELD(ndvc)},
+    [MD_RATE_EOB]          = {CDF_FIELD(eob_flag_cdf16),
+                              CDF_FIELD(eob_flag_cdf32),
+                              CDF_FIELD(eob_flag_cdf64),
+                              CDF_FIELD(eob_flag_cdf128),
+                              CDF_FIELD(eob_flag_cdf256),
+                              CDF_FIELD(eob_flag_cdf512),
+                              CDF_FIELD(eob_flag_cdf1024)},
+};
+
+/*************************************************************
+* md_rate_group_refresh()
+* Returns TRUE when the tables of the group have to be built
+* from fc, i.e. always without cache, otherwise when the group
+* CDFs differ from the ones of the last build.  The CDFs are
+* then recorded as the ones of the group tables.
+**************************************************************/
+static Bool md_rate_group_refresh(MdRateEstimationCache *cache, MdRateGroup group,
+                                  const FRAME_CONTEXT *fc) {
+    if (!cache)
+        return TRUE;
+    const CdfField *field;
+    if (cache->valid & (1u << group)) {
+        for (field = md_rate_group_cdfs[group]; field->size; field++)
+            if (memcmp((const uint8_t *)&cache->fc + field->offset,
+                       (const uint8_t *)fc + field->offset,
+                       field->size))
+                break;
+        if (!field->size)
+            return FALSE;
+    }
+    for (field = md_rate_group_cdfs[group]; field->size; field++)
+        memcpy((uint8_t *)&cache->fc + field->offset,
+               (const uint8_t *)fc + field->offset,
+               field->size);
+    cache->valid |= 1u << group;
+    return TRUE;
+}
+
 /*************************************************************
 * av1_estimate_syntax_rate()
 * Estimate the rate for each syntax elements and for
 * all scenarios based on the frame CDF
 **************************************************************/
-void av1_estimate_syntax_rate(MdRateEstimationContext *md_rate_estimation_array, Bool is_i_slice,
+void av1_estimate_syntax_rate(MdRateEstimationContext *md_rate_estimation_array,
+                              MdRateEstimationCache *cache, Bool is_i_slice,
                               uint8_t pic_filter_intra_level, uint8_t allow_screen_content_tools,
                               uint8_t enable_restoration, uint8_t allow_intrabc,
                               uint8_t partition_contexts, FRAME_CONTEXT *fc) {
     int32_t i, j;
 
     md_rate_estimation_array->initialized = 1;
-    for (i = 0; i < partition_contexts; ++i)
-        av1_get_syntax_rate_from_cdf(
-            md_rate_estimation_array->partition_fac_bits[i], fc->partition_cdf[i], NULL);
+    if (cache && cache->partition_contexts != partition_contexts) {
+        cache->valid &= ~(1u << MD_RATE_PARTITION);
+        cache->partition_contexts = partition_contexts;
+    }
+    if (md_rate_group_refresh(cache, MD_RATE_PARTITION, fc))
+        for (i = 0; i < partition_contexts; ++i)
+            av1_get_syntax_rate_from_cdf(
+                md_rate_estimation_array->partition_fac_bits[i], fc->partition_cdf[i], NULL);
 
-    for (i = 0; i < SKIP_CONTEXTS; ++i)
-        av1_get_syntax_rate_from_cdf(
-            md_rate_estimation_array->skip_mode_fac_bits[i], fc->skip_mode_cdfs[i], NULL);
+    if (md_rate_group_refresh(cache, MD_RATE_SKIP, fc)) {
+        for (i = 0; i < SKIP_CONTEXTS; ++i)
+            av1_get_syntax_rate_from_cdf(
+                md_rate_estimation_array->skip_mode_fac_bits[i], fc->skip_mode_cdfs[i], NULL);
 
-    for (i = 0; i < SKIP_CONTEXTS; ++i)
-        av1_get_syntax_rate_from_cdf(
-            md_rate_estimation_array->skip_fac_bits[i], fc->skip_cdfs[i], NULL);
-    for (i = 0; i < KF_MODE_CONTEXTS; ++i)
-        for (j = 0; j < KF_MODE_CONTEXTS; ++j)
+        for (i = 0; i < SKIP_CONTEXTS; ++i)
             av1_get_syntax_rate_from_cdf(
-                md_rate_estimation_array->y_mode_fac_bits[i][j], fc->kf_y_cdf[i][j], NULL);
+                md_rate_estimation_array->skip_fac_bits[i], fc->skip_cdfs[i], NULL);
+    }
+    if (md_rate_group_refresh(cache, MD_RATE_Y_MODE, fc)) {
+        for (i = 0; i < KF_MODE_CONTEXTS; ++i)
+            for (j = 0; j < KF_MODE_CONTEXTS; ++j)
+                av1_get_syntax_rate_from_cdf(
+                    md_rate_estimation_array->y_mode_fac_bits[i][j], fc->kf_y_cdf[i][j], NULL);
 
-    for (i = 0; i < BlockSize_GROUPS; ++i)
-        av1_get_syntax_rate_from_cdf(
-            md_rate_estimation_array->mb_mode_fac_bits[i], fc->y_mode_cdf[i], NULL);
+        for (i = 0; i < BlockSize_GROUPS; ++i)
+            av1_get_syntax_rate_from_cdf(
+                md_rate_estimation_array->mb_mode_fac_bits[i], fc->y_mode_cdf[i], NULL);
+    }
 
-    for (i = 0; i < CFL_ALLOWED_TYPES; ++i) {
-        for (j = 0; j < INTRA_MODES; ++j)
-            av1_get_syntax_rate_from_cdf(md_rate_estimation_array->intra_uv_mode_fac_bits[i][j],
-                                         fc->uv_mode_cdf[i][j],
-                                         NULL);
+    if (md_rate_group_refresh(cache, MD_RATE_UV_MODE, fc)) {
+        for (i = 0; i < CFL_ALLOWED_TYPES; ++i) {
+            for (j = 0; j < INTRA_MODES; ++j)
+                av1_get_syntax_rate_from_cdf(
+                    md_rate_estimation_array->intra_uv_mode_fac_bits[i][j],
+                    fc->uv_mode_cdf[i][j],
+                    NULL);
+        }
     }
-    if (pic_filter_intra_level) {
+    if (pic_filter_intra_level && md_rate_group_refresh(cache, MD_RATE_FILTER_INTRA, fc)) {
         av1_get_syntax_rate_from_cdf(
             md_rate_estimation_array->filter_intra_mode_fac_bits, fc->filter_intra_mode_cdf, NULL);
         for (i = 0; i < BlockSizeS_ALL; ++i) {
@@ -113,11 +249,12 @@ void av1_estimate_syntax_rate(MdRateEstimationContext *md_rate_estimation_array,
                                              NULL);
         }
     }
-    for (i = 0; i < SWITCHABLE_FILTER_CONTEXTS; ++i)
-        av1_get_syntax_rate_from_cdf(md_rate_estimation_array->switchable_interp_fac_bitss[i],
-                                     fc->switchable_interp_cdf[i],
-                                     NULL);
-    if (allow_screen_content_tools) {
+    if (md_rate_group_refresh(cache, MD_RATE_INTERP, fc))
+        for (i = 0; i < SWITCHABLE_FILTER_CONTEXTS; ++i)
+            av1_get_syntax_rate_from_cdf(md_rate_estimation_array->switchable_interp_fac_bitss[i],
+                                         fc->switchable_interp_cdf[i],
+                                         NULL);
+    if (allow_screen_content_tools && md_rate_group_refresh(cache, MD_RATE_PALETTE, fc)) {
         for (i = 0; i < PALATTE_BSIZE_CTXS; ++i) {
             av1_get_syntax_rate_from_cdf(md_rate_estimation_array->palette_ysize_fac_bits[i],
                                          fc->palette_y_size_cdf[i],
@@ -148,61 +285,73 @@ void av1_estimate_syntax_rate(MdRateEstimationContext *md_rate_estimation_array,
             }
         }
     }
-    int32_t sign_fac_bits[CFL_JOINT_SIGNS];
-    av1_get_syntax_rate_from_cdf(sign_fac_bits, fc->cfl_sign_cdf, NULL);
-    for (int32_t joint_sign = 0; joint_sign < CFL_JOINT_SIGNS; joint_sign++) {
-        int32_t *fac_bits_u = md_rate_estimation_array->cfl_alpha_fac_bits[joint_sign][CFL_PRED_U];
-        int32_t *fac_bits_v = md_rate_estimation_array->cfl_alpha_fac_bits[joint_sign][CFL_PRED_V];
-        if (CFL_SIGN_U(joint_sign) == CFL_SIGN_ZERO)
-            memset(fac_bits_u, 0, CFL_ALPHABET_SIZE * sizeof(*fac_bits_u));
-        else {
-            const AomCdfProb *cdf_u = fc->cfl_alpha_cdf[CFL_CONTEXT_U(joint_sign)];
-            av1_get_syntax_rate_from_cdf(fac_bits_u, cdf_u, NULL);
-        }
-        if (CFL_SIGN_V(joint_sign) == CFL_SIGN_ZERO)
-            memset(fac_bits_v, 0, CFL_ALPHABET_SIZE * sizeof(*fac_bits_v));
-        else {
-            int32_t cdf_index = CFL_CONTEXT_V(joint_sign);
-            if ((cdf_index < CFL_ALPHA_CONTEXTS) && (cdf_index >= 0)) {
-                const AomCdfProb *cdf_v = fc->cfl_alpha_cdf[cdf_index];
-                av1_get_syntax_rate_from_cdf(fac_bits_v, cdf_v, NULL);
+    if (md_rate_group_refresh(cache, MD_RATE_CFL, fc)) {
+        int32_t sign_fac_bits[CFL_JOINT_SIGNS];
+        av1_get_syntax_rate_from_cdf(sign_fac_bits, fc->cfl_sign_cdf, NULL);
+        for (int32_t joint_sign = 0; joint_sign < CFL_JOINT_SIGNS; joint_sign++) {
+            int32_t *fac_bits_u =
+                md_rate_estimation_array->cfl_alpha_fac_bits[joint_sign][CFL_PRED_U];
+            int32_t *fac_bits_v =
+                md_rate_estimation_array->cfl_alpha_fac_bits[joint_sign][CFL_PRED_V];
+            if (CFL_SIGN_U(joint_sign) == CFL_SIGN_ZERO)
+                memset(fac_bits_u, 0, CFL_ALPHABET_SIZE * sizeof(*fac_bits_u));
+            else {
+                const AomCdfProb *cdf_u = fc->cfl_alpha_cdf[CFL_CONTEXT_U(joint_sign)];
+                av1_get_syntax_rate_from_cdf(fac_bits_u, cdf_u, NULL);
+            }
+            if (CFL_SIGN_V(joint_sign) == CFL_SIGN_ZERO)
+                memset(fac_bits_v, 0, CFL_ALPHABET_SIZE * sizeof(*fac_bits_v));
+            else {
+                int32_t cdf_index = CFL_CONTEXT_V(joint_sign);
+                if ((cdf_index < CFL_ALPHA_CONTEXTS) && (cdf_index >= 0)) {
+                    const AomCdfProb *cdf_v = fc->cfl_alpha_cdf[cdf_index];
+                    av1_get_syntax_rate_from_cdf(fac_bits_v, cdf_v, NULL);
+                }
             }
+            for (int32_t u = 0; u < CFL_ALPHABET_SIZE; u++)
+                fac_bits_u[u] += sign_fac_bits[joint_sign];
         }
-        for (int32_t u = 0; u < CFL_ALPHABET_SIZE; u++) fac_bits_u[u] += sign_fac_bits[joint_sign];
     }
 
-    for (i = 0; i < MAX_TX_CATS; ++i)
-        for (j = 0; j < TX_SIZE_CONTEXTS; ++j)
-            av1_get_syntax_rate_from_cdf(
-                md_rate_estimation_array->tx_size_fac_bits[i][j], fc->tx_size_cdf[i][j], NULL);
+    if (md_rate_group_refresh(cache, MD_RATE_TX_SIZE, fc)) {
+        for (i = 0; i < MAX_TX_CATS; ++i)
+            for (j = 0; j < TX_SIZE_CONTEXTS; ++j)
+                av1_get_syntax_rate_from_cdf(
+                    md_rate_estimation_array->tx_size_fac_bits[i][j], fc->tx_size_cdf[i][j], NULL);
 
-    for (i = 0; i < TXFM_PARTITION_CONTEXTS; ++i) {
-        av1_get_syntax_rate_from_cdf(
-            md_rate_estimation_array->txfm_partition_fac_bits[i], fc->txfm_partition_cdf[i], NULL);
+        for (i = 0; i < TXFM_PARTITION_CONTEXTS; ++i) {
+            av1_get_syntax_rate_from_cdf(md_rate_estimation_array->txfm_partition_fac_bits[i],
+                                         fc->txfm_partition_cdf[i],
+                                         NULL);
+        }
     }
 
-    for (i = TX_4X4; i < EXT_TX_SIZES; ++i) {
-        int32_t s;
-        for (s = 1; s < EXT_TX_SETS_INTER; ++s) {
-            if (use_inter_ext_tx_for_txsize[s][i])
-                av1_get_syntax_rate_from_cdf(md_rate_estimation_array->inter_tx_type_fac_bits[s][i],
-                                             fc->inter_ext_tx_cdf[s][i],
-                                             av1_ext_tx_inv[av1_ext_tx_set_idx_to_type[1][s]]);
-        }
-        for (s = 1; s < EXT_TX_SETS_INTRA; ++s) {
-            if (use_intra_ext_tx_for_txsize[s][i]) {
-                for (j = 0; j < INTRA_MODES; ++j)
+    if (md_rate_group_refresh(cache, MD_RATE_TX_TYPE, fc)) {
+        for (i = TX_4X4; i < EXT_TX_SIZES; ++i) {
+            int32_t s;
+            for (s = 1; s < EXT_TX_SETS_INTER; ++s) {
+                if (use_inter_ext_tx_for_txsize[s][i])
                     av1_get_syntax_rate_from_cdf(
-                        md_rate_estimation_array->intra_tx_type_fac_bits[s][i][j],
-                        fc->intra_ext_tx_cdf[s][i][j],
-                        av1_ext_tx_inv[av1_ext_tx_set_idx_to_type[0][s]]);
+                        md_rate_estimation_array->inter_tx_type_fac_bits[s][i],
+                        fc->inter_ext_tx_cdf[s][i],
+                        av1_ext_tx_inv[av1_ext_tx_set_idx_to_type[1][s]]);
+            }
+            for (s = 1; s < EXT_TX_SETS_INTRA; ++s) {
+                if (use_intra_ext_tx_for_txsize[s][i]) {
+                    for (j = 0; j < INTRA_MODES; ++j)
+                        av1_get_syntax_rate_from_cdf(
+                            md_rate_estimation_array->intra_tx_type_fac_bits[s][i][j],
+                            fc->intra_ext_tx_cdf[s][i][j],
+                            av1_ext_tx_inv[av1_ext_tx_set_idx_to_type[0][s]]);
+                }
             }
         }
     }
-    for (i = 0; i < DIRECTIONAL_MODES; ++i)
-        av1_get_syntax_rate_from_cdf(
-            md_rate_estimation_array->angle_delta_fac_bits[i], fc->angle_delta_cdf[i], NULL);
-    if (enable_restoration) {
+    if (md_rate_group_refresh(cache, MD_RATE_ANGLE_DELTA, fc))
+        for (i = 0; i < DIRECTIONAL_MODES; ++i)
+            av1_get_syntax_rate_from_cdf(
+                md_rate_estimation_array->angle_delta_fac_bits[i], fc->angle_delta_cdf[i], NULL);
+    if (enable_restoration && md_rate_group_refresh(cache, MD_RATE_RESTORATION, fc)) {
         av1_get_syntax_rate_from_cdf(md_rate_estimation_array->switchable_restore_fac_bits,
                                      fc->switchable_restore_cdf,
                                      NULL);
@@ -211,99 +360,121 @@ void av1_estimate_syntax_rate(MdRateEstimationContext *md_rate_estimation_array,
         av1_get_syntax_rate_from_cdf(
             md_rate_estimation_array->sgrproj_restore_fac_bits, fc->sgrproj_restore_cdf, NULL);
     }
-    if (allow_intrabc) {
+    if (allow_intrabc && md_rate_group_refresh(cache, MD_RATE_INTRABC, fc)) {
         av1_get_syntax_rate_from_cdf(
             md_rate_estimation_array->intrabc_fac_bits, fc->intrabc_cdf, NULL);
     }
 
     if (!is_i_slice) { // NM - Hardcoded to true
-        for (i = 0; i < COMP_INTER_CONTEXTS; ++i)
-            av1_get_syntax_rate_from_cdf(
-                md_rate_estimation_array->comp_inter_fac_bits[i], fc->comp_inter_cdf[i], NULL);
-        for (i = 0; i < REF_CONTEXTS; ++i) {
-            for (j = 0; j < SINGLE_REFS - 1; ++j)
-                av1_get_syntax_rate_from_cdf(md_rate_estimation_array->single_ref_fac_bits[i][j],
-                                             fc->single_ref_cdf[i][j],
-                                             NULL);
-        }
+        if (md_rate_group_refresh(cache, MD_RATE_REF, fc)) {
+            for (i = 0; i < COMP_INTER_CONTEXTS; ++i)
+                av1_get_syntax_rate_from_cdf(
+                    md_rate_estimation_array->comp_inter_fac_bits[i], fc->comp_inter_cdf[i], NULL);
+            for (i = 0; i < REF_CONTEXTS; ++i) {
+                for (j = 0; j < SINGLE_REFS - 1; ++j)
+                    av1_get_syntax_rate_from_cdf(
+                        md_rate_estimation_array->single_ref_fac_bits[i][j],
+                        fc->single_ref_cdf[i][j],
+                        NULL);
+            }
 
-        for (i = 0; i < COMP_REF_TYPE_CONTEXTS; ++i)
-            av1_get_syntax_rate_from_cdf(md_rate_estimation_array->comp_ref_type_fac_bits[i],
-                                         fc->comp_ref_type_cdf[i],
-                                         NULL);
-        for (i = 0; i < UNI_COMP_REF_CONTEXTS; ++i) {
-            for (j = 0; j < UNIDIR_COMP_REFS - 1; ++j)
-                av1_get_syntax_rate_from_cdf(md_rate_estimation_array->uni_comp_ref_fac_bits[i][j],
-                                             fc->uni_comp_ref_cdf[i][j],
+            for (i = 0; i < COMP_REF_TYPE_CONTEXTS; ++i)
+                av1_get_syntax_rate_from_cdf(md_rate_estimation_array->comp_ref_type_fac_bits[i],
+                                             fc->comp_ref_type_cdf[i],
                                              NULL);
-        }
+            for (i = 0; i < UNI_COMP_REF_CONTEXTS; ++i) {
+                for (j = 0; j < UNIDIR_COMP_REFS - 1; ++j)
+                    av1_get_syntax_rate_from_cdf(
+                        md_rate_estimation_array->uni_comp_ref_fac_bits[i][j],
+                        fc->uni_comp_ref_cdf[i][j],
+                        NULL);
+            }
 
-        for (i = 0; i < REF_CONTEXTS; ++i) {
-            for (j = 0; j < FWD_REFS - 1; ++j)
-                av1_get_syntax_rate_from_cdf(md_rate_estimation_array->comp_ref_fac_bits[i][j],
-                                             fc->comp_ref_cdf[i][j],
+            for (i = 0; i < REF_CONTEXTS; ++i) {
+                for (j = 0; j < FWD_REFS - 1; ++j)
+                    av1_get_syntax_rate_from_cdf(
+                        md_rate_estimation_array->comp_ref_fac_bits[i][j],
+                        fc->comp_ref_cdf[i][j],
+                        NULL);
+            }
+
+            for (i = 0; i < REF_CONTEXTS; ++i) {
+                for (j = 0; j < BWD_REFS - 1; ++j)
+                    av1_get_syntax_rate_from_cdf(
+                        md_rate_estimation_array->comp_bwd_ref_fac_bits[i][j],
+                        fc->comp_bwdref_cdf[i][j],
+                        NULL);
+            }
+
+            for (i = 0; i < INTRA_INTER_CONTEXTS; ++i)
+                av1_get_syntax_rate_from_cdf(md_rate_estimation_array->intra_inter_fac_bits[i],
+                                             fc->intra_inter_cdf[i],
                                              NULL);
         }
-
-        for (i = 0; i < REF_CONTEXTS; ++i) {
-            for (j = 0; j < BWD_REFS - 1; ++j)
-                av1_get_syntax_rate_from_cdf(md_rate_estimation_array->comp_bwd_ref_fac_bits[i][j],
-                                             fc->comp_bwdref_cdf[i][j],
+        if (md_rate_group_refresh(cache, MD_RATE_INTER_MODE, fc)) {
+            for (i = 0; i < NEWMV_MODE_CONTEXTS; ++i)
+                av1_get_syntax_rate_from_cdf(
+                    md_rate_estimation_array->new_mv_mode_fac_bits[i], fc->newmv_cdf[i], NULL);
+            for (i = 0; i < GLOBALMV_MODE_CONTEXTS; ++i)
+                av1_get_syntax_rate_from_cdf(
+                    md_rate_estimation_array->zero_mv_mode_fac_bits[i], fc->zeromv_cdf[i], NULL);
+            for (i = 0; i < REFMV_MODE_CONTEXTS; ++i)
+                av1_get_syntax_rate_from_cdf(
+                    md_rate_estimation_array->ref_mv_mode_fac_bits[i], fc->refmv_cdf[i], NULL);
+            for (i = 0; i < DRL_MODE_CONTEXTS; ++i)
+                av1_get_syntax_rate_from_cdf(
+                    md_rate_estimation_array->drl_mode_fac_bits[i], fc->drl_cdf[i], NULL);
+            for (i = 0; i < INTER_MODE_CONTEXTS; ++i)
+                av1_get_syntax_rate_from_cdf(
+                    md_rate_estimation_array->inter_compound_mode_fac_bits[i],
+                    fc->inter_compound_mode_cdf[i],
+                    NULL);
+        }
+        if (md_rate_group_refresh(cache, MD_RATE_COMPOUND, fc)) {
+            for (i = 0; i < BlockSizeS_ALL; ++i)
+                av1_get_syntax_rate_from_cdf(md_rate_estimation_array->compound_type_fac_bits[i],
+                                             fc->compound_type_cdf[i],
+                                             NULL);
+            for (i = 0; i < BlockSizeS_ALL; ++i) {
+                if (get_interinter_wedge_bits((BlockSize)i))
+                    av1_get_syntax_rate_from_cdf(md_rate_estimation_array->wedge_idx_fac_bits[i],
+                                                 fc->wedge_idx_cdf[i],
+                                                 NULL);
+            }
+            for (i = 0; i < COMP_INDEX_CONTEXTS; ++i)
+                av1_get_syntax_rate_from_cdf(md_rate_estimation_array->comp_idx_fac_bits[i],
+                                             fc->compound_index_cdf[i],
+                                             NULL);
+            for (i = 0; i < COMP_GROUP_IDX_CONTEXTS; ++i)
+                av1_get_syntax_rate_from_cdf(md_rate_estimation_array->comp_group_idx_fac_bits[i],
+                                             fc->comp_group_idx_cdf[i],
                                              NULL);
         }
-
-        for (i = 0; i < INTRA_INTER_CONTEXTS; ++i)
-            av1_get_syntax_rate_from_cdf(
-                md_rate_estimation_array->intra_inter_fac_bits[i], fc->intra_inter_cdf[i], NULL);
-        for (i = 0; i < NEWMV_MODE_CONTEXTS; ++i)
-            av1_get_syntax_rate_from_cdf(
-                md_rate_estimation_array->new_mv_mode_fac_bits[i], fc->newmv_cdf[i], NULL);
-        for (i = 0; i < GLOBALMV_MODE_CONTEXTS; ++i)
-            av1_get_syntax_rate_from_cdf(
-                md_rate_estimation_array->zero_mv_mode_fac_bits[i], fc->zeromv_cdf[i], NULL);
-        for (i = 0; i < REFMV_MODE_CONTEXTS; ++i)
-            av1_get_syntax_rate_from_cdf(
-                md_rate_estimation_array->ref_mv_mode_fac_bits[i], fc->refmv_cdf[i], NULL);
-        for (i = 0; i < DRL_MODE_CONTEXTS; ++i)
-            av1_get_syntax_rate_from_cdf(
-                md_rate_estimation_array->drl_mode_fac_bits[i], fc->drl_cdf[i], NULL);
-        for (i = 0; i < INTER_MODE_CONTEXTS; ++i)
-            av1_get_syntax_rate_from_cdf(md_rate_estimation_array->inter_compound_mode_fac_bits[i],
-                                         fc->inter_compound_mode_cdf[i],
-                                         NULL);
-        for (i = 0; i < BlockSizeS_ALL; ++i)
-            av1_get_syntax_rate_from_cdf(md_rate_estimation_array->compound_type_fac_bits[i],
-                                         fc->compound_type_cdf[i],
-                                         NULL);
-        for (i = 0; i < BlockSizeS_ALL; ++i) {
-            if (get_interinter_wedge_bits((BlockSize)i))
+        if (md_rate_group_refresh(cache, MD_RATE_INTER_INTRA, fc)) {
+            for (i = 0; i < BlockSize_GROUPS; ++i) {
+                av1_get_syntax_rate_from_cdf(md_rate_estimation_array->inter_intra_fac_bits[i],
+                                             fc->interintra_cdf[i],
+                                             NULL);
+                av1_get_syntax_rate_from_cdf(
+                    md_rate_estimation_array->inter_intra_mode_fac_bits[i],
+                    fc->interintra_mode_cdf[i],
+                    NULL);
+            }
+            for (i = 0; i < BlockSizeS_ALL; ++i)
                 av1_get_syntax_rate_from_cdf(
-                    md_rate_estimation_array->wedge_idx_fac_bits[i], fc->wedge_idx_cdf[i], NULL);
+                    md_rate_estimation_array->wedge_inter_intra_fac_bits[i],
+                    fc->wedge_interintra_cdf[i],
+                    NULL);
         }
-        for (i = 0; i < BlockSize_GROUPS; ++i) {
-            av1_get_syntax_rate_from_cdf(
-                md_rate_estimation_array->inter_intra_fac_bits[i], fc->interintra_cdf[i], NULL);
-            av1_get_syntax_rate_from_cdf(md_rate_estimation_array->inter_intra_mode_fac_bits[i],
-                                         fc->interintra_mode_cdf[i],
-                                         NULL);
+        if (md_rate_group_refresh(cache, MD_RATE_MOTION_MODE, fc)) {
+            for (i = BLOCK_8X8; i < BlockSizeS_ALL; i++)
+                av1_get_syntax_rate_from_cdf(md_rate_estimation_array->motion_mode_fac_bits[i],
+                                             fc->motion_mode_cdf[i],
+                                             NULL);
+            for (i = BLOCK_8X8; i < BlockSizeS_ALL; i++)
+                av1_get_syntax_rate_from_cdf(
+                    md_rate_estimation_array->motion_mode_fac_bits1[i], fc->obmc_cdf[i], NULL);
         }
-        for (i = 0; i < BlockSizeS_ALL; ++i)
-            av1_get_syntax_rate_from_cdf(md_rate_estimation_array->wedge_inter_intra_fac_bits[i],
-                                         fc->wedge_interintra_cdf[i],
-                                         NULL);
-        for (i = BLOCK_8X8; i < BlockSizeS_ALL; i++)
-            av1_get_syntax_rate_from_cdf(
-                md_rate_estimation_array->motion_mode_fac_bits[i], fc->motion_mode_cdf[i], NULL);
-        for (i = BLOCK_8X8; i < BlockSizeS_ALL; i++)
-            av1_get_syntax_rate_from_cdf(
-                md_rate_estimation_array->motion_mode_fac_bits1[i], fc->obmc_cdf[i], NULL);
-        for (i = 0; i < COMP_INDEX_CONTEXTS; ++i)
-            av1_get_syntax_rate_from_cdf(
-                md_rate_estimation_array->comp_idx_fac_bits[i], fc->compound_index_cdf[i], NULL);
-        for (i = 0; i < COMP_GROUP_IDX_CONTEXTS; ++i)
-            av1_get_syntax_rate_from_cdf(md_rate_estimation_array->comp_group_idx_fac_bits[i],
-                                         fc->comp_group_idx_cdf[i],
-                                         NULL);
     }
 }
 
@@ -365,9 +536,13 @@ void svt_av1_build_nmv_cost_table(int32_t *mvjoint, int32_t *mvcost[2], const Nm
 * based on the frame CDF
 ***************************************************************************/
 void av1_estimate_mv_rate(PictureControlSet       *pcs_ptr,
-                          MdRateEstimationContext *md_rate_estimation_array, FRAME_CONTEXT *fc)
+                          MdRateEstimationContext *md_rate_estimation_array,
+                          MdRateEstimationCache *cache, FRAME_CONTEXT *fc)
 
 {
+    // The MV costs below do not come from fc
+    if (cache && (pcs_ptr->approx_inter_rate || pcs_ptr->parent_pcs_ptr->bypass_cost_table_gen))
+        cache->valid &= ~(1u << MD_RATE_MV);
     if (pcs_ptr->approx_inter_rate) {
         memset(md_rate_estimation_array->nmv_vec_cost, 0, sizeof(int32_t) * MV_JOINTS);
         memset(pcs_ptr->parent_pcs_ptr->scs_ptr->nmv_vec_cost, 0, sizeof(int32_t) * MV_JOINTS);
@@ -390,10 +565,15 @@ void av1_estimate_mv_rate(PictureControlSet       *pcs_ptr,
         ? 0
         : frm_hdr->allow_high_precision_mv;
     if (!pcs_ptr->parent_pcs_ptr->bypass_cost_table_gen) {
-        svt_av1_build_nmv_cost_table(md_rate_estimation_array->nmv_vec_cost, //out
-                                     allow_high_precision_mv ? nmvcost_hp : nmvcost, //out
-                                     &fc->nmvc,
-                                     allow_high_precision_mv);
+        if (cache && cache->allow_high_precision_mv != allow_high_precision_mv) {
+            cache->valid &= ~(1u << MD_RATE_MV);
+            cache->allow_high_precision_mv = allow_high_precision_mv;
+        }
+        if (md_rate_group_refresh(cache, MD_RATE_MV, fc))
+            svt_av1_build_nmv_cost_table(md_rate_estimation_array->nmv_vec_cost, //out
+                                         allow_high_precision_mv ? nmvcost_hp : nmvcost, //out
+                                         &fc->nmvc,
+                                         allow_high_precision_mv);
         md_rate_estimation_array->nmvcoststack[0] = allow_high_precision_mv
             ? &md_rate_estimation_array->nmv_costs_hp[0][MV_MAX]
             : &md_rate_estimation_array->nmv_costs[0][MV_MAX];
@@ -420,16 +600,20 @@ void av1_estimate_mv_rate(PictureControlSet       *pcs_ptr,
         md_rate_estimation_array->nmvcoststack[0] = &md_rate_estimation_array->nmv_costs[0][MV_MAX];
         md_rate_estimation_array->nmvcoststack[1] = &md_rate_estimation_array->nmv_costs[1][MV_MAX];
     }
-    if (frm_hdr->allow_intrabc) {
+    if (frm_hdr->allow_intrabc && md_rate_group_refresh(cache, MD_RATE_DV, fc)) {
         int32_t *dvcost[2] = {&md_rate_estimation_array->dv_cost[0][MV_MAX],
                               &md_rate_estimation_array->dv_cost[1][MV_MAX]};
         svt_av1_build_nmv_cost_table(
             md_rate_estimation_array->dv_joint_cost, dvcost, &fc->ndvc, MV_SUBPEL_NONE);
     }
 }
-void copy_mv_rate(PictureControlSet *pcs, MdRateEstimationContext *dst_rate) {
+void copy_mv_rate(PictureControlSet *pcs, MdRateEstimationContext *dst_rate,
+                  MdRateEstimationCache *dst_cache) {
     FrameHeader *frm_hdr = &pcs->parent_pcs_ptr->frm_hdr;
 
+    if (dst_cache)
+        dst_cache->valid &= ~((1u << MD_RATE_MV) | (1u << MD_RATE_DV));
+
     memcpy(dst_rate->nmv_vec_cost,
            pcs->md_rate_estimation_array->nmv_vec_cost,
            MV_JOINTS * sizeof(int32_t));
@@ -460,36 +644,94 @@ void copy_mv_rate(PictureControlSet *pcs, MdRateEstimationContext *dst_rate) {
                MV_JOINTS * sizeof(int32_t));
     }
 }
+static Bool coeff_group_changed(const MdRateEstimationCache *cache, const FRAME_CONTEXT *fc,
+                                int tx_size) {
+    const int br_tx_size = AOMMIN(tx_size, TX_32X32);
+    if (!cache || !(cache->valid & (1u << (MD_RATE_COEFF + tx_size))))
+        return TRUE;
+    return memcmp(cache->fc.txb_skip_cdf[tx_size],
+                  fc->txb_skip_cdf[tx_size],
+                  sizeof(fc->txb_skip_cdf[tx_size])) ||
+        memcmp(cache->fc.coeff_base_eob_cdf[tx_size],
+               fc->coeff_base_eob_cdf[tx_size],
+               sizeof(fc->coeff_base_eob_cdf[tx_size])) ||
+        memcmp(cache->fc.coeff_base_cdf[tx_size],
+               fc->coeff_base_cdf[tx_size],
+               sizeof(fc->coeff_base_cdf[tx_size])) ||
+        memcmp(cache->fc.eob_extra_cdf[tx_size],
+               fc->eob_extra_cdf[tx_size],
+               sizeof(fc->eob_extra_cdf[tx_size])) ||
+        memcmp(cache->fc.coeff_br_cdf[br_tx_size],
+               fc->coeff_br_cdf[br_tx_size],
+               sizeof(fc->coeff_br_cdf[br_tx_size])) ||
+        memcmp(cache->fc.dc_sign_cdf, fc->dc_sign_cdf, sizeof(fc->dc_sign_cdf));
+}
+
+static void coeff_group_record(MdRateEstimationCache *cache, const FRAME_CONTEXT *fc,
+                               int tx_size) {
+    const int br_tx_size = AOMMIN(tx_size, TX_32X32);
+    memcpy(cache->fc.txb_skip_cdf[tx_size],
+           fc->txb_skip_cdf[tx_size],
+           sizeof(fc->txb_skip_cdf[tx_size]));
+    memcpy(cache->fc.coeff_base_eob_cdf[tx_size],
+           fc->coeff_base_eob_cdf[tx_size],
+           sizeof(fc->coeff_base_eob_cdf[tx_size]));
+    memcpy(cache->fc.coeff_base_cdf[tx_size],
+           fc->coeff_base_cdf[tx_size],
+           sizeof(fc->coeff_base_cdf[tx_size]));
+    memcpy(cache->fc.eob_extra_cdf[tx_size],
+           fc->eob_extra_cdf[tx_size],
+           sizeof(fc->eob_extra_cdf[tx_size]));
+    memcpy(cache->fc.coeff_br_cdf[br_tx_size],
+           fc->coeff_br_cdf[br_tx_size],
+           sizeof(fc->coeff_br_cdf[br_tx_size]));
+    memcpy(cache->fc.dc_sign_cdf, fc->dc_sign_cdf, sizeof(fc->dc_sign_cdf));
+    cache->valid |= 1u << (MD_RATE_COEFF + tx_size);
+}
 /**************************************************************************
 * av1_estimate_coefficients_rate()
 * Estimate the rate of the quantised coefficient
 * based on the frame CDF
 ***************************************************************************/
 void av1_estimate_coefficients_rate(MdRateEstimationContext *md_rate_estimation_array,
-                                    FRAME_CONTEXT           *fc) {
+                                    MdRateEstimationCache *cache, FRAME_CONTEXT *fc) {
     const int32_t num_planes = 3; // NM - Hardcoded to 3
     const int32_t nplanes    = AOMMIN(num_planes, PLANE_TYPES);
-
-    for (int eob_multi_size = 0; eob_multi_size < 7; ++eob_multi_size) {
-        for (int plane = 0; plane < nplanes; ++plane) {
-            LvMapEobCost *pcost = &md_rate_estimation_array->eob_frac_bits[eob_multi_size][plane];
-            for (int ctx = 0; ctx < 2; ++ctx) {
-                AomCdfProb *pcdf;
-                switch (eob_multi_size) {
-                case 0: pcdf = fc->eob_flag_cdf16[plane][ctx]; break;
-                case 1: pcdf = fc->eob_flag_cdf32[plane][ctx]; break;
-                case 2: pcdf = fc->eob_flag_cdf64[plane][ctx]; break;
-                case 3: pcdf = fc->eob_flag_cdf128[plane][ctx]; break;
-                case 4: pcdf = fc->eob_flag_cdf256[plane][ctx]; break;
-                case 5: pcdf = fc->eob_flag_cdf512[plane][ctx]; break;
-                case 6:
-                default: pcdf = fc->eob_flag_cdf1024[plane][ctx]; break;
+    // dc_sign and br CDFs are shared by several tx sizes, so all the changed
+    // tx sizes are found before any of their CDFs is recorded
+    uint32_t refresh_mask = 0;
+    for (int tx_size = 0; tx_size < TX_SIZES; ++tx_size)
+        if (coeff_group_changed(cache, fc, tx_size))
+            refresh_mask |= 1 << tx_size;
+    for (int tx_size = 0; tx_size < TX_SIZES; ++tx_size)
+        if (cache && (refresh_mask & (1 << tx_size)))
+            coeff_group_record(cache, fc, tx_size);
+
+    if (md_rate_group_refresh(cache, MD_RATE_EOB, fc)) {
+        for (int eob_multi_size = 0; eob_multi_size < 7; ++eob_multi_size) {
+            for (int plane = 0; plane < nplanes; ++plane) {
+                LvMapEobCost *pcost =
+                    &md_rate_estimation_array->eob_frac_bits[eob_multi_size][plane];
+                for (int ctx = 0; ctx < 2; ++ctx) {
+                    AomCdfProb *pcdf;
+                    switch (eob_multi_size) {
+                    case 0: pcdf = fc->eob_flag_cdf16[plane][ctx]; break;
+                    case 1: pcdf = fc->eob_flag_cdf32[plane][ctx]; break;
+                    case 2: pcdf = fc->eob_flag_cdf64[plane][ctx]; break;
+                    case 3: pcdf = fc->eob_flag_cdf128[plane][ctx]; break;
+                    case 4: pcdf = fc->eob_flag_cdf256[plane][ctx]; break;
+                    case 5: pcdf = fc->eob_flag_cdf512[plane][ctx]; break;
+                    case 6:
+                    default: pcdf = fc->eob_flag_cdf1024[plane][ctx]; break;
+                    }
+                    av1_get_syntax_rate_from_cdf(pcost->eob_cost[ctx], pcdf, NULL);
                 }
-                av1_get_syntax_rate_from_cdf(pcost->eob_cost[ctx], pcdf, NULL);
             }
         }
     }
     for (int tx_size = 0; tx_size < TX_SIZES; ++tx_size) {
+        if (!(refresh_mask & (1 << tx_size)))
+            continue;
         for (int plane = 0; plane < nplanes; ++plane) {
             LvMapCoeffCost *pcost = &md_rate_estimation_array->coeff_fac_bits[tx_size][plane];
 
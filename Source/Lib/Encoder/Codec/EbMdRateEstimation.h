@@ -130,6 +130,21 @@ extern "C" {
         int32_t switchable_interp_fac_bitss[SWITCHABLE_FILTER_CONTEXTS][SWITCHABLE_FILTERS];
         int32_t initialized;
     } MdRateEstimationContext;
+
+    /**************************************
+     * MD Rate Estimation Cache
+     *   CDFs the tables of a MdRateEstimationContext were last built
+     *   from.  The tables are split in groups (one bit of valid per
+     *   group); the av1_estimate_*() functions only rebuild the groups
+     *   whose CDFs changed, so it must stay with the same table.
+     **************************************/
+    typedef struct MdRateEstimationCache
+    {
+        FRAME_CONTEXT fc;
+        uint32_t      valid;
+        uint8_t       partition_contexts;
+        uint8_t       allow_high_precision_mv;
+    } MdRateEstimationCache;
     /***************************************************************************
     * AV1 Probability table
     * // round(-log2(i/256.) * (1 << AV1_PROB_COST_SHIFT)); i = 128~255.
@@ -185,9 +200,11 @@ extern "C" {
     /**************************************************************************
     * Estimate the rate for each syntax elements and for
     * all scenarios based on the frame CDF
+    * cache (optional): only the tables whose CDFs changed are rebuilt
     ***************************************************************************/
     extern void av1_estimate_syntax_rate(
         MdRateEstimationContext      *md_rate_estimation_array,
+        MdRateEstimationCache        *cache,
         Bool                          is_i_slice,
         uint8_t pic_filter_intra_level,
         uint8_t allow_screen_content_tools,
@@ -201,6 +218,7 @@ extern "C" {
     ***************************************************************************/
     extern void av1_estimate_coefficients_rate(
         MdRateEstimationContext  *md_rate_estimation_array,
+        MdRateEstimationCache    *cache,
         FRAME_CONTEXT              *fc);
     /**************************************************************************
     * av1_estimate_mv_rate()
@@ -210,6 +228,7 @@ extern "C" {
 extern void av1_estimate_mv_rate(
         struct PictureControlSet *pcs_ptr,
         MdRateEstimationContext  *md_rate_estimation_array,
+        MdRateEstimationCache    *cache,
         FRAME_CONTEXT            *fc);
 #define AVG_CDF_WEIGHT_LEFT      3
 #define AVG_CDF_WEIGHT_TOP       1
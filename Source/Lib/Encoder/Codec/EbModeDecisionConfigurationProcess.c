@@ -26,6 +26,7 @@
 #include "EbCoefficients.h"
 #include "EbCommonUtils.h"
 #include "EbResize.h"
+#include "EbEntropyCodingProcess.h"
 
 int32_t get_qzbin_factor(int32_t q, AomBitDepth bit_depth);
 void    invert_quant(int16_t *quant, int16_t *shift, int32_t d);
@@ -34,6 +35,7 @@ int16_t svt_av1_ac_quant_q3(int32_t qindex, int32_t delta, AomBitDepth bit_depth
 int16_t svt_av1_dc_quant_qtx(int32_t qindex, int32_t delta, AomBitDepth bit_depth);
 uint8_t get_disallow_4x4(EncMode enc_mode, SliceType slice_type);
 uint8_t get_bypass_encdec(EncMode enc_mode, uint8_t hbd_mode_decision, uint8_t encoder_bit_depth);
+void    sb_row_recode_init(PictureControlSet *pcs_ptr);
 uint8_t get_disallow_below_16x16_picture_level(EncMode enc_mode, EbInputResolution resolution,
                                                SliceType slice_type, uint8_t sc_class1,
                                                uint8_t is_used_as_reference_flag,
@@ -330,6 +332,7 @@ void mode_decision_configuration_init_qp_update(PictureControlSet *pcs_ptr) {
     }
     // Initial Rate Estimation of the syntax elements
     av1_estimate_syntax_rate(md_rate_estimation_array,
+                             pcs_ptr->md_rate_estimation_cache,
                              pcs_ptr->slice_type == I_SLICE ? TRUE : FALSE,
                              pcs_ptr->pic_filter_intra_level,
                              pcs_ptr->parent_pcs_ptr->frm_hdr.allow_screen_content_tools,
@@ -338,9 +341,14 @@ void mode_decision_configuration_init_qp_update(PictureControlSet *pcs_ptr) {
                              pcs_ptr->parent_pcs_ptr->partition_contexts,
                              &pcs_ptr->md_frame_context);
     // Initial Rate Estimation of the Motion vectors
-    av1_estimate_mv_rate(pcs_ptr, md_rate_estimation_array, &pcs_ptr->md_frame_context);
+    av1_estimate_mv_rate(pcs_ptr,
+                         md_rate_estimation_array,
+                         pcs_ptr->md_rate_estimation_cache,
+                         &pcs_ptr->md_frame_context);
     // Initial Rate Estimation of the quantized coefficients
-    av1_estimate_coefficients_rate(md_rate_estimation_array, &pcs_ptr->md_frame_context);
+    av1_estimate_coefficients_rate(md_rate_estimation_array,
+                                   pcs_ptr->md_rate_estimation_cache,
+                                   &pcs_ptr->md_frame_context);
 }
 
 /******************************************************
@@ -1779,355 +1787,379 @@ void get_ref_skip_percentage(PictureControlSet *pcs_ptr, uint8_t *skip_area) {
 void *rtime_alloc_block_hash_block_is_same(size_t size) { return malloc(size); }
 /* Mode Decision Configuration Kernel */
 
-/*********************************************************************************
-*
-* @brief
-*  The Mode Decision Configuration Process involves a number of initialization steps,
-*  setting flags for a number of features, and determining the blocks to be considered
-*  in subsequent MD stages.
-*
-* @par Description:
-*  The Mode Decision Configuration Process involves a number of initialization steps,
-*  setting flags for a number of features, and determining the blocks to be considered
-*  in subsequent MD stages. Examples of flags that are set are the flags for filter intra,
-*  eighth-pel, OBMC and warped motion and flags for updating the cumulative density functions
-*  Examples of initializations include initializations for picture chroma QP offsets,
-*  CDEF strength, self-guided restoration filter parameters, quantization parameters,
-*  lambda arrays, mv and coefficient rate estimation arrays.
-*
-*  The set of blocks to be processed in subsequent MD stages is decided in this process as a
-*  function of the picture depth mode (pic_depth_mode).
-*
-* @param[in] Configurations
-*  Configuration flags that are to be set
-*
-* @param[out] Initializations
-*  Initializations for various flags and variables
-*
-********************************************************************************/
-void *mode_decision_configuration_kernel(void *input_ptr) {
+/******************************************************
+ * Mode Decision Configuration Task
+ *   Configures one picture coming out of Rate Control
+ ******************************************************/
+void mode_decision_configuration_process_task(EbThreadContext *thread_context_ptr,
+                                              EbObjectWrapper *rate_control_results_wrapper_ptr) {
     // Context & SCS & PCS
-    EbThreadContext                  *thread_context_ptr = (EbThreadContext *)input_ptr;
     ModeDecisionConfigurationContext *context_ptr        = (ModeDecisionConfigurationContext *)
                                                         thread_context_ptr->priv;
     // Input
-    EbObjectWrapper *rate_control_results_wrapper_ptr;
 
     // Output
     EbObjectWrapper *enc_dec_tasks_wrapper_ptr;
 
-    for (;;) {
-        // Get RateControl Results
-        EB_GET_FULL_OBJECT(context_ptr->rate_control_input_fifo_ptr,
-                           &rate_control_results_wrapper_ptr);
-
-        RateControlResults *rate_control_results_ptr =
-            (RateControlResults *)rate_control_results_wrapper_ptr->object_ptr;
-        PictureControlSet *pcs_ptr = (PictureControlSet *)
-                                         rate_control_results_ptr->pcs_wrapper_ptr->object_ptr;
-        SequenceControlSet *scs_ptr = (SequenceControlSet *)pcs_ptr->scs_wrapper_ptr->object_ptr;
-
-        // -------
-        // Scale references if resolution of the reference is different than the input
-        // -------
-        if (pcs_ptr->parent_pcs_ptr->frame_superres_enabled == 1 &&
-            pcs_ptr->slice_type != I_SLICE) {
-            if (pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag == TRUE &&
-                pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr != NULL) {
-                // update mi_rows and mi_cols for the reference pic wrapper (used in mfmv for other pictures)
-                EbReferenceObject *reference_object =
-                    pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr;
-                reference_object->mi_rows = pcs_ptr->parent_pcs_ptr->aligned_height >> MI_SIZE_LOG2;
-                reference_object->mi_cols = pcs_ptr->parent_pcs_ptr->aligned_width >> MI_SIZE_LOG2;
-            }
-
-            scale_rec_references(
-                pcs_ptr, pcs_ptr->parent_pcs_ptr->enhanced_picture_ptr, pcs_ptr->hbd_mode_decision);
+    RateControlResults *rate_control_results_ptr =
+        (RateControlResults *)rate_control_results_wrapper_ptr->object_ptr;
+    PictureControlSet *pcs_ptr = (PictureControlSet *)
+                                     rate_control_results_ptr->pcs_wrapper_ptr->object_ptr;
+    SequenceControlSet *scs_ptr = (SequenceControlSet *)pcs_ptr->scs_wrapper_ptr->object_ptr;
+
+    // -------
+    // Scale references if resolution of the reference is different than the input
+    // -------
+    if (pcs_ptr->parent_pcs_ptr->frame_superres_enabled == 1 &&
+        pcs_ptr->slice_type != I_SLICE) {
+        if (pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag == TRUE &&
+            pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr != NULL) {
+            // update mi_rows and mi_cols for the reference pic wrapper (used in mfmv for other pictures)
+            EbReferenceObject *reference_object =
+                pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr;
+            reference_object->mi_rows = pcs_ptr->parent_pcs_ptr->aligned_height >> MI_SIZE_LOG2;
+            reference_object->mi_cols = pcs_ptr->parent_pcs_ptr->aligned_width >> MI_SIZE_LOG2;
         }
 
-        FrameHeader *frm_hdr = &pcs_ptr->parent_pcs_ptr->frm_hdr;
-        // Get intra % in ref frame
-        get_ref_intra_percentage(pcs_ptr, &pcs_ptr->ref_intra_percentage);
+        scale_rec_references(
+            pcs_ptr, pcs_ptr->parent_pcs_ptr->enhanced_picture_ptr, pcs_ptr->hbd_mode_decision);
+    }
 
-        // Get skip % in ref frame
-        get_ref_skip_percentage(pcs_ptr, &pcs_ptr->ref_skip_percentage);
-        // Mode Decision Configuration Kernel Signal(s) derivation
-        if (scs_ptr->static_config.pass == ENC_FIRST_PASS)
-            first_pass_signal_derivation_mode_decision_config_kernel(pcs_ptr);
-        else
-            signal_derivation_mode_decision_config_kernel_oq(scs_ptr, pcs_ptr);
+    FrameHeader *frm_hdr = &pcs_ptr->parent_pcs_ptr->frm_hdr;
+    // Get intra % in ref frame
+    get_ref_intra_percentage(pcs_ptr, &pcs_ptr->ref_intra_percentage);
+
+    // Get skip % in ref frame
+    get_ref_skip_percentage(pcs_ptr, &pcs_ptr->ref_skip_percentage);
+    // Mode Decision Configuration Kernel Signal(s) derivation, lookahead_only bypasses EncDec as
+    // the first pass does
+    const Bool first_pass_config = scs_ptr->static_config.pass == ENC_FIRST_PASS ||
+        scs_ptr->static_config.lookahead_only;
+    if (first_pass_config)
+        first_pass_signal_derivation_mode_decision_config_kernel(pcs_ptr);
+    else
+        signal_derivation_mode_decision_config_kernel_oq(scs_ptr, pcs_ptr);
 
-        if (pcs_ptr->slice_type != I_SLICE && scs_ptr->mfmv_enabled)
-            av1_setup_motion_field(pcs_ptr->parent_pcs_ptr->av1_cm, pcs_ptr);
+    if (pcs_ptr->slice_type != I_SLICE && scs_ptr->mfmv_enabled &&
+        !scs_ptr->static_config.lookahead_only)
+        av1_setup_motion_field(pcs_ptr->parent_pcs_ptr->av1_cm, pcs_ptr);
 
-        pcs_ptr->intra_coded_area = 0;
-        pcs_ptr->skip_coded_area  = 0;
-        // Init block selection
-        // Set reference sg ep
-        set_reference_sg_ep(pcs_ptr);
-        set_global_motion_field(pcs_ptr);
+    pcs_ptr->intra_coded_area = 0;
+    pcs_ptr->skip_coded_area  = 0;
+    // Init block selection
+    // Set reference sg ep
+    set_reference_sg_ep(pcs_ptr);
+    set_global_motion_field(pcs_ptr);
 
-        svt_av1_qm_init(pcs_ptr->parent_pcs_ptr);
-        MdRateEstimationContext *md_rate_estimation_array;
+    svt_av1_qm_init(pcs_ptr->parent_pcs_ptr);
+    MdRateEstimationContext *md_rate_estimation_array;
 
-        // QP
-        context_ptr->qp = pcs_ptr->picture_qp;
+    // QP
+    context_ptr->qp = pcs_ptr->picture_qp;
 
-        // QP Index
-        context_ptr->qp_index = (uint8_t)frm_hdr->quantization_params.base_q_idx;
+    // QP Index
+    context_ptr->qp_index = (uint8_t)frm_hdr->quantization_params.base_q_idx;
 
-        md_rate_estimation_array = pcs_ptr->md_rate_estimation_array;
-        if (pcs_ptr->parent_pcs_ptr->frm_hdr.primary_ref_frame != PRIMARY_REF_NONE)
-            memcpy(&pcs_ptr->md_frame_context,
-                   &pcs_ptr->ref_frame_context[pcs_ptr->parent_pcs_ptr->frm_hdr.primary_ref_frame],
-                   sizeof(FRAME_CONTEXT));
-        else {
-            svt_av1_default_coef_probs(&pcs_ptr->md_frame_context,
-                                       frm_hdr->quantization_params.base_q_idx);
-            init_mode_probs(&pcs_ptr->md_frame_context);
-        }
-        // Initial Rate Estimation of the syntax elements
-        av1_estimate_syntax_rate(md_rate_estimation_array,
-                                 pcs_ptr->slice_type == I_SLICE ? TRUE : FALSE,
-                                 pcs_ptr->pic_filter_intra_level,
-                                 pcs_ptr->parent_pcs_ptr->frm_hdr.allow_screen_content_tools,
-                                 scs_ptr->seq_header.enable_restoration,
-                                 pcs_ptr->parent_pcs_ptr->frm_hdr.allow_intrabc,
-                                 pcs_ptr->parent_pcs_ptr->partition_contexts,
-                                 &pcs_ptr->md_frame_context);
-        // Initial Rate Estimation of the Motion vectors
-        if (scs_ptr->static_config.pass != ENC_FIRST_PASS) {
-            av1_estimate_mv_rate(pcs_ptr, md_rate_estimation_array, &pcs_ptr->md_frame_context);
-            // Initial Rate Estimation of the quantized coefficients
-            av1_estimate_coefficients_rate(md_rate_estimation_array, &pcs_ptr->md_frame_context);
+    md_rate_estimation_array = pcs_ptr->md_rate_estimation_array;
+    if (pcs_ptr->parent_pcs_ptr->frm_hdr.primary_ref_frame != PRIMARY_REF_NONE)
+        memcpy(&pcs_ptr->md_frame_context,
+               &pcs_ptr->ref_frame_context[pcs_ptr->parent_pcs_ptr->frm_hdr.primary_ref_frame],
+               sizeof(FRAME_CONTEXT));
+    else {
+        svt_av1_default_coef_probs(&pcs_ptr->md_frame_context,
+                                   frm_hdr->quantization_params.base_q_idx);
+        init_mode_probs(&pcs_ptr->md_frame_context);
+    }
+    // Initial Rate Estimation of the syntax elements
+    av1_estimate_syntax_rate(md_rate_estimation_array,
+                             pcs_ptr->md_rate_estimation_cache,
+                             pcs_ptr->slice_type == I_SLICE ? TRUE : FALSE,
+                             pcs_ptr->pic_filter_intra_level,
+                             pcs_ptr->parent_pcs_ptr->frm_hdr.allow_screen_content_tools,
+                             scs_ptr->seq_header.enable_restoration,
+                             pcs_ptr->parent_pcs_ptr->frm_hdr.allow_intrabc,
+                             pcs_ptr->parent_pcs_ptr->partition_contexts,
+                             &pcs_ptr->md_frame_context);
+    // Initial Rate Estimation of the Motion vectors
+    if (!first_pass_config) {
+        av1_estimate_mv_rate(pcs_ptr,
+                             md_rate_estimation_array,
+                             pcs_ptr->md_rate_estimation_cache,
+                             &pcs_ptr->md_frame_context);
+        // Initial Rate Estimation of the quantized coefficients
+        av1_estimate_coefficients_rate(md_rate_estimation_array,
+                                   pcs_ptr->md_rate_estimation_cache,
+                                   &pcs_ptr->md_frame_context);
+    }
+    if (frm_hdr->allow_intrabc) {
+        int            i;
+        int            speed          = 1;
+        SpeedFeatures *sf             = &pcs_ptr->sf;
+        sf->allow_exhaustive_searches = 1;
+
+        const int mesh_speed           = AOMMIN(speed, MAX_MESH_SPEED);
+        sf->exhaustive_searches_thresh = (1 << 25);
+
+        sf->max_exaustive_pct = good_quality_max_mesh_pct[mesh_speed];
+        if (mesh_speed > 0)
+            sf->exhaustive_searches_thresh = sf->exhaustive_searches_thresh << 1;
+
+        for (i = 0; i < MAX_MESH_STEP; ++i) {
+            sf->mesh_patterns[i].range    = good_quality_mesh_patterns[mesh_speed][i].range;
+            sf->mesh_patterns[i].interval = good_quality_mesh_patterns[mesh_speed][i].interval;
         }
-        if (frm_hdr->allow_intrabc) {
-            int            i;
-            int            speed          = 1;
-            SpeedFeatures *sf             = &pcs_ptr->sf;
-            sf->allow_exhaustive_searches = 1;
-
-            const int mesh_speed           = AOMMIN(speed, MAX_MESH_SPEED);
-            sf->exhaustive_searches_thresh = (1 << 25);
-
-            sf->max_exaustive_pct = good_quality_max_mesh_pct[mesh_speed];
-            if (mesh_speed > 0)
-                sf->exhaustive_searches_thresh = sf->exhaustive_searches_thresh << 1;
 
+        if (pcs_ptr->slice_type == I_SLICE) {
             for (i = 0; i < MAX_MESH_STEP; ++i) {
-                sf->mesh_patterns[i].range    = good_quality_mesh_patterns[mesh_speed][i].range;
-                sf->mesh_patterns[i].interval = good_quality_mesh_patterns[mesh_speed][i].interval;
+                sf->mesh_patterns[i].range    = intrabc_mesh_patterns[mesh_speed][i].range;
+                sf->mesh_patterns[i].interval = intrabc_mesh_patterns[mesh_speed][i].interval;
             }
+            sf->max_exaustive_pct = intrabc_max_mesh_pct[mesh_speed];
+        }
 
-            if (pcs_ptr->slice_type == I_SLICE) {
-                for (i = 0; i < MAX_MESH_STEP; ++i) {
-                    sf->mesh_patterns[i].range    = intrabc_mesh_patterns[mesh_speed][i].range;
-                    sf->mesh_patterns[i].interval = intrabc_mesh_patterns[mesh_speed][i].interval;
-                }
-                sf->max_exaustive_pct = intrabc_max_mesh_pct[mesh_speed];
+        {
+            // add to hash table
+            const int pic_width  = pcs_ptr->parent_pcs_ptr->aligned_width;
+            const int pic_height = pcs_ptr->parent_pcs_ptr->aligned_height;
+
+            uint32_t *block_hash_values[2][2];
+            int8_t   *is_block_same[2][3];
+            int       k, j;
+
+            for (k = 0; k < 2; k++) {
+                for (j = 0; j < 2; j++)
+                    block_hash_values[k][j] = rtime_alloc_block_hash_block_is_same(
+                        sizeof(uint32_t) * pic_width * pic_height);
+                for (j = 0; j < 3; j++)
+                    is_block_same[k][j] = rtime_alloc_block_hash_block_is_same(
+                        sizeof(int8_t) * pic_width * pic_height);
+            }
+            pcs_ptr->hash_table.p_lookup_table = NULL;
+            rtime_alloc_svt_av1_hash_table_create(&pcs_ptr->hash_table);
+            Yv12BufferConfig cpi_source;
+            link_eb_to_aom_buffer_desc_8bit(pcs_ptr->parent_pcs_ptr->enhanced_picture_ptr,
+                                            &cpi_source);
+
+            svt_av1_crc_calculator_init(&pcs_ptr->crc_calculator1, 24, 0x5D6DCB);
+            svt_av1_crc_calculator_init(&pcs_ptr->crc_calculator2, 24, 0x864CFB);
+
+            svt_av1_generate_block_2x2_hash_value(
+                &cpi_source, block_hash_values[0], is_block_same[0], pcs_ptr);
+            uint8_t       src_idx = 0;
+            const uint8_t max_sb_size =
+                pcs_ptr->parent_pcs_ptr->intraBC_ctrls.max_block_size_hash;
+            for (int size = 4; size <= max_sb_size; size <<= 1, src_idx = !src_idx) {
+                const uint8_t dst_idx = !src_idx;
+                svt_av1_generate_block_hash_value(&cpi_source,
+                                                  size,
+                                                  block_hash_values[src_idx],
+                                                  block_hash_values[dst_idx],
+                                                  is_block_same[src_idx],
+                                                  is_block_same[dst_idx],
+                                                  pcs_ptr);
+                if (size != 4 || pcs_ptr->parent_pcs_ptr->intraBC_ctrls.hash_4x4_blocks)
+                    rtime_alloc_svt_av1_add_to_hash_map_by_row_with_precal_data(
+                        &pcs_ptr->hash_table,
+                        block_hash_values[dst_idx],
+                        is_block_same[dst_idx][2],
+                        pic_width,
+                        pic_height,
+                        size);
             }
+            for (k = 0; k < 2; k++) {
+                for (j = 0; j < 2; j++) free(block_hash_values[k][j]);
+                for (j = 0; j < 3; j++) free(is_block_same[k][j]);
+            }
+        }
 
-            {
-                // add to hash table
-                const int pic_width  = pcs_ptr->parent_pcs_ptr->aligned_width;
-                const int pic_height = pcs_ptr->parent_pcs_ptr->aligned_height;
-
-                uint32_t *block_hash_values[2][2];
-                int8_t   *is_block_same[2][3];
-                int       k, j;
-
-                for (k = 0; k < 2; k++) {
-                    for (j = 0; j < 2; j++)
-                        block_hash_values[k][j] = rtime_alloc_block_hash_block_is_same(
-                            sizeof(uint32_t) * pic_width * pic_height);
-                    for (j = 0; j < 3; j++)
-                        is_block_same[k][j] = rtime_alloc_block_hash_block_is_same(
-                            sizeof(int8_t) * pic_width * pic_height);
-                }
-                pcs_ptr->hash_table.p_lookup_table = NULL;
-                rtime_alloc_svt_av1_hash_table_create(&pcs_ptr->hash_table);
-                Yv12BufferConfig cpi_source;
-                link_eb_to_aom_buffer_desc_8bit(pcs_ptr->parent_pcs_ptr->enhanced_picture_ptr,
-                                                &cpi_source);
-
-                svt_av1_crc_calculator_init(&pcs_ptr->crc_calculator1, 24, 0x5D6DCB);
-                svt_av1_crc_calculator_init(&pcs_ptr->crc_calculator2, 24, 0x864CFB);
-
-                svt_av1_generate_block_2x2_hash_value(
-                    &cpi_source, block_hash_values[0], is_block_same[0], pcs_ptr);
-                uint8_t       src_idx = 0;
-                const uint8_t max_sb_size =
-                    pcs_ptr->parent_pcs_ptr->intraBC_ctrls.max_block_size_hash;
-                for (int size = 4; size <= max_sb_size; size <<= 1, src_idx = !src_idx) {
-                    const uint8_t dst_idx = !src_idx;
-                    svt_av1_generate_block_hash_value(&cpi_source,
-                                                      size,
-                                                      block_hash_values[src_idx],
-                                                      block_hash_values[dst_idx],
-                                                      is_block_same[src_idx],
-                                                      is_block_same[dst_idx],
-                                                      pcs_ptr);
-                    if (size != 4 || pcs_ptr->parent_pcs_ptr->intraBC_ctrls.hash_4x4_blocks)
-                        rtime_alloc_svt_av1_add_to_hash_map_by_row_with_precal_data(
-                            &pcs_ptr->hash_table,
-                            block_hash_values[dst_idx],
-                            is_block_same[dst_idx][2],
-                            pic_width,
-                            pic_height,
-                            size);
+        svt_av1_init3smotion_compensation(
+            &pcs_ptr->ss_cfg, pcs_ptr->parent_pcs_ptr->enhanced_picture_ptr->stride_y);
+    }
+    CdefControls *cdef_ctrls = &pcs_ptr->parent_pcs_ptr->cdef_ctrls;
+    uint8_t       skip_perc  = pcs_ptr->ref_skip_percentage;
+    if ((skip_perc > 75 && cdef_ctrls->use_skip_detector) ||
+        (scs_ptr->vq_ctrls.sharpness_ctrls.cdef && pcs_ptr->parent_pcs_ptr->is_noise_level))
+        pcs_ptr->parent_pcs_ptr->cdef_level = 0;
+    else {
+        if (cdef_ctrls->use_reference_cdef_fs) {
+            if (pcs_ptr->slice_type != I_SLICE) {
+                uint8_t lowest_sg  = TOTAL_STRENGTHS - 1;
+                uint8_t highest_sg = 0;
+                // Determine luma pred filter
+                // Add filter from list0
+                EbReferenceObject *ref_obj_l0 =
+                    (EbReferenceObject *)pcs_ptr->ref_pic_ptr_array[REF_LIST_0][0]->object_ptr;
+                for (uint8_t fs = 0; fs < ref_obj_l0->ref_cdef_strengths_num; fs++) {
+                    if (ref_obj_l0->ref_cdef_strengths[0][fs] < lowest_sg)
+                        lowest_sg = ref_obj_l0->ref_cdef_strengths[0][fs];
+                    if (ref_obj_l0->ref_cdef_strengths[0][fs] > highest_sg)
+                        highest_sg = ref_obj_l0->ref_cdef_strengths[0][fs];
                 }
-                for (k = 0; k < 2; k++) {
-                    for (j = 0; j < 2; j++) free(block_hash_values[k][j]);
-                    for (j = 0; j < 3; j++) free(is_block_same[k][j]);
+                if (pcs_ptr->slice_type == B_SLICE) {
+                    // Add filter from list1
+                    EbReferenceObject *ref_obj_l1 = (EbReferenceObject *)pcs_ptr
+                                                        ->ref_pic_ptr_array[REF_LIST_1][0]
+                                                        ->object_ptr;
+                    for (uint8_t fs = 0; fs < ref_obj_l1->ref_cdef_strengths_num; fs++) {
+                        if (ref_obj_l1->ref_cdef_strengths[0][fs] < lowest_sg)
+                            lowest_sg = ref_obj_l1->ref_cdef_strengths[0][fs];
+                        if (ref_obj_l1->ref_cdef_strengths[0][fs] > highest_sg)
+                            highest_sg = ref_obj_l1->ref_cdef_strengths[0][fs];
+                    }
                 }
+                int8_t mid_filter             = MIN(63, MAX(0, (lowest_sg + highest_sg) / 2));
+                cdef_ctrls->pred_y_f          = mid_filter;
+                cdef_ctrls->pred_uv_f         = 0;
+                cdef_ctrls->first_pass_fs_num = 0;
+                cdef_ctrls->default_second_pass_fs_num = 0;
+                // Set cdef to off if pred is.
+                if ((cdef_ctrls->pred_y_f == 0) && (cdef_ctrls->pred_uv_f == 0))
+                    pcs_ptr->parent_pcs_ptr->cdef_level = 0;
             }
-
-            svt_av1_init3smotion_compensation(
-                &pcs_ptr->ss_cfg, pcs_ptr->parent_pcs_ptr->enhanced_picture_ptr->stride_y);
-        }
-        CdefControls *cdef_ctrls = &pcs_ptr->parent_pcs_ptr->cdef_ctrls;
-        uint8_t       skip_perc  = pcs_ptr->ref_skip_percentage;
-        if ((skip_perc > 75 && cdef_ctrls->use_skip_detector) ||
-            (scs_ptr->vq_ctrls.sharpness_ctrls.cdef && pcs_ptr->parent_pcs_ptr->is_noise_level))
-            pcs_ptr->parent_pcs_ptr->cdef_level = 0;
-        else {
-            if (cdef_ctrls->use_reference_cdef_fs) {
-                if (pcs_ptr->slice_type != I_SLICE) {
-                    uint8_t lowest_sg  = TOTAL_STRENGTHS - 1;
-                    uint8_t highest_sg = 0;
-                    // Determine luma pred filter
-                    // Add filter from list0
-                    EbReferenceObject *ref_obj_l0 =
-                        (EbReferenceObject *)pcs_ptr->ref_pic_ptr_array[REF_LIST_0][0]->object_ptr;
-                    for (uint8_t fs = 0; fs < ref_obj_l0->ref_cdef_strengths_num; fs++) {
-                        if (ref_obj_l0->ref_cdef_strengths[0][fs] < lowest_sg)
-                            lowest_sg = ref_obj_l0->ref_cdef_strengths[0][fs];
-                        if (ref_obj_l0->ref_cdef_strengths[0][fs] > highest_sg)
-                            highest_sg = ref_obj_l0->ref_cdef_strengths[0][fs];
-                    }
-                    if (pcs_ptr->slice_type == B_SLICE) {
-                        // Add filter from list1
-                        EbReferenceObject *ref_obj_l1 = (EbReferenceObject *)pcs_ptr
-                                                            ->ref_pic_ptr_array[REF_LIST_1][0]
-                                                            ->object_ptr;
-                        for (uint8_t fs = 0; fs < ref_obj_l1->ref_cdef_strengths_num; fs++) {
-                            if (ref_obj_l1->ref_cdef_strengths[0][fs] < lowest_sg)
-                                lowest_sg = ref_obj_l1->ref_cdef_strengths[0][fs];
-                            if (ref_obj_l1->ref_cdef_strengths[0][fs] > highest_sg)
-                                highest_sg = ref_obj_l1->ref_cdef_strengths[0][fs];
-                        }
-                    }
-                    int8_t mid_filter             = MIN(63, MAX(0, (lowest_sg + highest_sg) / 2));
-                    cdef_ctrls->pred_y_f          = mid_filter;
-                    cdef_ctrls->pred_uv_f         = 0;
-                    cdef_ctrls->first_pass_fs_num = 0;
-                    cdef_ctrls->default_second_pass_fs_num = 0;
-                    // Set cdef to off if pred is.
-                    if ((cdef_ctrls->pred_y_f == 0) && (cdef_ctrls->pred_uv_f == 0))
-                        pcs_ptr->parent_pcs_ptr->cdef_level = 0;
+        } else if (cdef_ctrls->search_best_ref_fs) {
+            if (pcs_ptr->slice_type != I_SLICE) {
+                cdef_ctrls->first_pass_fs_num          = 1;
+                cdef_ctrls->default_second_pass_fs_num = 0;
+
+                // Add filter from list0, if not the same as the default
+                EbReferenceObject *ref_obj_l0 =
+                    (EbReferenceObject *)pcs_ptr->ref_pic_ptr_array[REF_LIST_0][0]->object_ptr;
+                if (ref_obj_l0->ref_cdef_strengths[0][0] !=
+                    cdef_ctrls->default_first_pass_fs[0]) {
+                    cdef_ctrls->default_first_pass_fs[1] = ref_obj_l0->ref_cdef_strengths[0][0];
+                    (cdef_ctrls->first_pass_fs_num)++;
                 }
-            } else if (cdef_ctrls->search_best_ref_fs) {
-                if (pcs_ptr->slice_type != I_SLICE) {
-                    cdef_ctrls->first_pass_fs_num          = 1;
-                    cdef_ctrls->default_second_pass_fs_num = 0;
-
-                    // Add filter from list0, if not the same as the default
-                    EbReferenceObject *ref_obj_l0 =
-                        (EbReferenceObject *)pcs_ptr->ref_pic_ptr_array[REF_LIST_0][0]->object_ptr;
-                    if (ref_obj_l0->ref_cdef_strengths[0][0] !=
-                        cdef_ctrls->default_first_pass_fs[0]) {
-                        cdef_ctrls->default_first_pass_fs[1] = ref_obj_l0->ref_cdef_strengths[0][0];
+
+                if (pcs_ptr->slice_type == B_SLICE) {
+                    EbReferenceObject *ref_obj_l1 = (EbReferenceObject *)pcs_ptr
+                                                        ->ref_pic_ptr_array[REF_LIST_1][0]
+                                                        ->object_ptr;
+                    // Add filter from list1, if different from default filter and list0 filter
+                    if (ref_obj_l1->ref_cdef_strengths[0][0] !=
+                            cdef_ctrls->default_first_pass_fs[0] &&
+                        ref_obj_l1->ref_cdef_strengths[0][0] !=
+                            cdef_ctrls
+                                ->default_first_pass_fs[cdef_ctrls->first_pass_fs_num - 1]) {
+                        cdef_ctrls->default_first_pass_fs[cdef_ctrls->first_pass_fs_num] =
+                            ref_obj_l1->ref_cdef_strengths[0][0];
                         (cdef_ctrls->first_pass_fs_num)++;
-                    }
 
-                    if (pcs_ptr->slice_type == B_SLICE) {
-                        EbReferenceObject *ref_obj_l1 = (EbReferenceObject *)pcs_ptr
-                                                            ->ref_pic_ptr_array[REF_LIST_1][0]
-                                                            ->object_ptr;
-                        // Add filter from list1, if different from default filter and list0 filter
-                        if (ref_obj_l1->ref_cdef_strengths[0][0] !=
-                                cdef_ctrls->default_first_pass_fs[0] &&
-                            ref_obj_l1->ref_cdef_strengths[0][0] !=
-                                cdef_ctrls
-                                    ->default_first_pass_fs[cdef_ctrls->first_pass_fs_num - 1]) {
-                            cdef_ctrls->default_first_pass_fs[cdef_ctrls->first_pass_fs_num] =
-                                ref_obj_l1->ref_cdef_strengths[0][0];
-                            (cdef_ctrls->first_pass_fs_num)++;
-
-                            // Chroma
-                            if (ref_obj_l0->ref_cdef_strengths[1][0] ==
-                                    cdef_ctrls->default_first_pass_fs_uv[0] &&
-                                ref_obj_l1->ref_cdef_strengths[1][0] ==
-                                    cdef_ctrls->default_first_pass_fs_uv[0]) {
-                                cdef_ctrls->default_first_pass_fs_uv[0] = -1;
-                                cdef_ctrls->default_first_pass_fs_uv[1] = -1;
-                            }
-                        }
-                        // if list0/list1 filters are the same, skip CDEF search, and use the filter selected by the ref frames
-                        else if (cdef_ctrls->first_pass_fs_num == 2 &&
-                                 ref_obj_l0->ref_cdef_strengths[0][0] ==
-                                     ref_obj_l1->ref_cdef_strengths[0][0]) {
-                            cdef_ctrls->use_reference_cdef_fs = 1;
-
-                            cdef_ctrls->pred_y_f          = ref_obj_l0->ref_cdef_strengths[0][0];
-                            cdef_ctrls->pred_uv_f         = MIN(63,
-                                                        MAX(0,
-                                                            (ref_obj_l0->ref_cdef_strengths[1][0] +
-                                                             ref_obj_l1->ref_cdef_strengths[1][0]) /
-                                                                2));
-                            cdef_ctrls->first_pass_fs_num = 0;
-                            cdef_ctrls->default_second_pass_fs_num = 0;
+                        // Chroma
+                        if (ref_obj_l0->ref_cdef_strengths[1][0] ==
+                                cdef_ctrls->default_first_pass_fs_uv[0] &&
+                            ref_obj_l1->ref_cdef_strengths[1][0] ==
+                                cdef_ctrls->default_first_pass_fs_uv[0]) {
+                            cdef_ctrls->default_first_pass_fs_uv[0] = -1;
+                            cdef_ctrls->default_first_pass_fs_uv[1] = -1;
                         }
                     }
-                    // Chroma
-                    else if (ref_obj_l0->ref_cdef_strengths[1][0] ==
-                             cdef_ctrls->default_first_pass_fs_uv[0]) {
-                        cdef_ctrls->default_first_pass_fs_uv[0] = -1;
-                        cdef_ctrls->default_first_pass_fs_uv[1] = -1;
+                    // if list0/list1 filters are the same, skip CDEF search, and use the filter selected by the ref frames
+                    else if (cdef_ctrls->first_pass_fs_num == 2 &&
+                             ref_obj_l0->ref_cdef_strengths[0][0] ==
+                                 ref_obj_l1->ref_cdef_strengths[0][0]) {
+                        cdef_ctrls->use_reference_cdef_fs = 1;
+
+                        cdef_ctrls->pred_y_f          = ref_obj_l0->ref_cdef_strengths[0][0];
+                        cdef_ctrls->pred_uv_f         = MIN(63,
+                                                    MAX(0,
+                                                        (ref_obj_l0->ref_cdef_strengths[1][0] +
+                                                         ref_obj_l1->ref_cdef_strengths[1][0]) /
+                                                            2));
+                        cdef_ctrls->first_pass_fs_num = 0;
+                        cdef_ctrls->default_second_pass_fs_num = 0;
                     }
-
-                    // Set cdef to off if pred luma is.
-                    if (cdef_ctrls->first_pass_fs_num == 1)
-                        pcs_ptr->parent_pcs_ptr->cdef_level = 0;
                 }
+                // Chroma
+                else if (ref_obj_l0->ref_cdef_strengths[1][0] ==
+                         cdef_ctrls->default_first_pass_fs_uv[0]) {
+                    cdef_ctrls->default_first_pass_fs_uv[0] = -1;
+                    cdef_ctrls->default_first_pass_fs_uv[1] = -1;
+                }
+
+                // Set cdef to off if pred luma is.
+                if (cdef_ctrls->first_pass_fs_num == 1)
+                    pcs_ptr->parent_pcs_ptr->cdef_level = 0;
             }
         }
+    }
 
-        Av1Common     *cm       = pcs_ptr->parent_pcs_ptr->av1_cm;
-        WnFilterCtrls *wn_ctrls = &cm->wn_filter_ctrls;
+    Av1Common     *cm       = pcs_ptr->parent_pcs_ptr->av1_cm;
+    WnFilterCtrls *wn_ctrls = &cm->wn_filter_ctrls;
 
-        if (scs_ptr->vq_ctrls.sharpness_ctrls.restoration &&
-            pcs_ptr->parent_pcs_ptr->is_noise_level) {
-            wn_ctrls->enabled  = 0;
-            cm->sg_filter_mode = 0;
-        }
+    if (scs_ptr->vq_ctrls.sharpness_ctrls.restoration &&
+        pcs_ptr->parent_pcs_ptr->is_noise_level) {
+        wn_ctrls->enabled  = 0;
+        cm->sg_filter_mode = 0;
+    }
 
-        // Post the results to the MD processes
+    entropy_coding_sb_row_init(pcs_ptr, scs_ptr, rate_control_results_ptr->superres_recode);
+    sb_row_recode_init(pcs_ptr);
 
-        uint16_t tg_count = pcs_ptr->parent_pcs_ptr->tile_group_cols *
-            pcs_ptr->parent_pcs_ptr->tile_group_rows;
-        for (uint16_t tile_group_idx = 0; tile_group_idx < tg_count; tile_group_idx++) {
-            svt_get_empty_object(context_ptr->mode_decision_configuration_output_fifo_ptr,
-                                 &enc_dec_tasks_wrapper_ptr);
+    // Post the results to the MD processes
 
-            EncDecTasks *enc_dec_tasks_ptr = (EncDecTasks *)enc_dec_tasks_wrapper_ptr->object_ptr;
-            enc_dec_tasks_ptr->pcs_wrapper_ptr  = rate_control_results_ptr->pcs_wrapper_ptr;
-            enc_dec_tasks_ptr->input_type       = rate_control_results_ptr->superres_recode
-                      ? ENCDEC_TASKS_SUPERRES_INPUT
-                      : ENCDEC_TASKS_MDC_INPUT;
-            enc_dec_tasks_ptr->tile_group_index = tile_group_idx;
+    uint16_t tg_count = pcs_ptr->parent_pcs_ptr->tile_group_cols *
+        pcs_ptr->parent_pcs_ptr->tile_group_rows;
+    for (uint16_t tile_group_idx = 0; tile_group_idx < tg_count; tile_group_idx++) {
+        svt_get_empty_object(context_ptr->mode_decision_configuration_output_fifo_ptr,
+                             &enc_dec_tasks_wrapper_ptr);
 
-            // Post the Full Results Object
-            svt_post_full_object(enc_dec_tasks_wrapper_ptr);
+        EncDecTasks *enc_dec_tasks_ptr = (EncDecTasks *)enc_dec_tasks_wrapper_ptr->object_ptr;
+        enc_dec_tasks_ptr->pcs_wrapper_ptr  = rate_control_results_ptr->pcs_wrapper_ptr;
+        enc_dec_tasks_ptr->input_type       = rate_control_results_ptr->superres_recode
+                  ? ENCDEC_TASKS_SUPERRES_INPUT
+                  : ENCDEC_TASKS_MDC_INPUT;
+        enc_dec_tasks_ptr->tile_group_index = tile_group_idx;
 
-            if (rate_control_results_ptr->superres_recode) {
-                // for superres input, only send one task
-                break;
-            }
+        // Post the Full Results Object
+        svt_post_full_object(enc_dec_tasks_wrapper_ptr);
+
+        if (rate_control_results_ptr->superres_recode) {
+            // for superres input, only send one task
+            break;
         }
+    }
+
+    // Release Rate Control Results
+    svt_release_object(rate_control_results_wrapper_ptr);
+}
+
+/*********************************************************************************
+*
+* @brief
+*  The Mode Decision Configuration Process involves a number of initialization steps,
+*  setting flags for a number of features, and determining the blocks to be considered
+*  in subsequent MD stages.
+*
+* @par Description:
+*  The Mode Decision Configuration Process involves a number of initialization steps,
+*  setting flags for a number of features, and determining the blocks to be considered
+*  in subsequent MD stages. Examples of flags that are set are the flags for filter intra,
+*  eighth-pel, OBMC and warped motion and flags for updating the cumulative density functions
+*  Examples of initializations include initializations for picture chroma QP offsets,
+*  CDEF strength, self-guided restoration filter parameters, quantization parameters,
+*  lambda arrays, mv and coefficient rate estimation arrays.
+*
+*  The set of blocks to be processed in subsequent MD stages is decided in this process as a
+*  function of the picture depth mode (pic_depth_mode).
+*
+* @param[in] Configurations
+*  Configuration flags that are to be set
+*
+* @param[out] Initializations
+*  Initializations for various flags and variables
+*
+********************************************************************************/
+void *mode_decision_configuration_kernel(void *input_ptr) {
+    EbThreadContext *thread_context_ptr = (EbThreadContext *)input_ptr;
+    ModeDecisionConfigurationContext *context_ptr        = (ModeDecisionConfigurationContext *)
+                                                        thread_context_ptr->priv;
+    EbObjectWrapper *rate_control_results_wrapper_ptr;
 
-        // Release Rate Control Results
-        svt_release_object(rate_control_results_wrapper_ptr);
+    for (;;) {
+        // Get RateControl Results
+        EB_GET_FULL_OBJECT(context_ptr->rate_control_input_fifo_ptr,
+                           &rate_control_results_wrapper_ptr);
+        mode_decision_configuration_process_task(thread_context_ptr, rate_control_results_wrapper_ptr);
     }
 
     return NULL;
@@ -55,6 +55,8 @@ EbErrorType mode_decision_configuration_context_ctor(EbThreadContext   *thread_c
                                                      int input_index, int output_index);
 
 extern void *mode_decision_configuration_kernel(void *input_ptr);
+extern void mode_decision_configuration_process_task(EbThreadContext *thread_context_ptr,
+                                                     EbObjectWrapper *rate_control_results_wrapper_ptr);
 #ifdef __cplusplus
 }
 #endif
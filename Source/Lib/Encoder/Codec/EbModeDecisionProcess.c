@@ -89,6 +89,8 @@ static void mode_decision_context_dctor(EbPtr p) {
 #if OPT_UPDATE_CDF_MEM
     if (obj->rate_est_table)
         EB_FREE_ARRAY(obj->rate_est_table);
+    if (obj->rate_est_cache)
+        EB_FREE_ARRAY(obj->rate_est_cache);
 #endif
     EB_FREE_ARRAY(obj->mdc_sb_array);
     for (uint32_t txt_itr = 0; txt_itr < TX_TYPES; ++txt_itr) {
@@ -249,10 +251,13 @@ EbErrorType mode_decision_context_ctor(ModeDecisionContext *context_ptr, EbColor
             use_update_cdf |= get_update_cdf_level(enc_mode, is_islice, is_base);
         }
     }
-    if (use_update_cdf)
+    if (use_update_cdf) {
         EB_CALLOC_ARRAY(context_ptr->rate_est_table, 1);
-    else
+        EB_CALLOC_ARRAY(context_ptr->rate_est_cache, 1);
+    } else {
         context_ptr->rate_est_table = NULL;
+        context_ptr->rate_est_cache = NULL;
+    }
 #endif
     EB_MALLOC_ARRAY(context_ptr->md_local_blk_unit, block_max_count_sb);
     EB_MALLOC_ARRAY(context_ptr->md_blk_arr_nsq, block_max_count_sb);
@@ -678,7 +683,8 @@ void mode_decision_configure_sb(ModeDecisionContext *context_ptr, PictureControl
     /* Note(CHKN) : when Qp modulation varies QP on a sub-SB(CU) basis,  Lamda has to change based on Cu->QP , and then this code has to move inside the CU loop in MD */
 
     // Lambda Assignement
-    context_ptr->qp_index = pcs_ptr->parent_pcs_ptr->frm_hdr.delta_q_params.delta_q_present
+    context_ptr->qp_index = pcs_ptr->parent_pcs_ptr->frm_hdr.delta_q_params.delta_q_present ||
+            pcs_ptr->parent_pcs_ptr->roi_map_present
         ? sb_qp
         : (uint8_t)pcs_ptr->parent_pcs_ptr->frm_hdr.quantization_params.base_q_idx;
 
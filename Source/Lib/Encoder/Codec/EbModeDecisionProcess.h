@@ -548,6 +548,7 @@ typedef struct ModeDecisionContext {
 #endif
 #if OPT_UPDATE_CDF_MEM
     MdRateEstimationContext *      rate_est_table;
+    MdRateEstimationCache         *rate_est_cache;
 #else
     struct MdRateEstimationContext rate_est_table;
     InterPredictionContext        *inter_prediction_context;
@@ -907,6 +908,9 @@ typedef struct ModeDecisionContext {
     COMPONENT_TYPE lpd1_chroma_comp; // chroma components to compensate at MDS3 of LPD1
     uint8_t        corrupted_mv_check;
     uint8_t        skip_pd0;
+    // static_sb - SB source identical to the co-located SB of a reference coded as a single
+    // 64x64 skip block: the reference partition is reused (64x64 depth only, no NSQ)
+    uint8_t static_sb;
     uint8_t
         scale_palette; //   when MD is done on 8bit, scale  palette colors to 10bit (valid when bypass is 1)
 
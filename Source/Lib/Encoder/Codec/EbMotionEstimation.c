@@ -449,53 +449,46 @@ void svt_ext_eight_sad_calculation_32x32_64x64_c(uint32_t  p_sad16x16[16][8],
         }
     }
 }
+
 /*******************************************
- * open_loop_me_get_search_point_results_block
+ * svt_ext_fullpel_search_row_c
+ *   full-pel search of a 64x64 block over search_area_width (multiple of 8)
+ *   positions of one search area row, mv is the mv of the first position
  *******************************************/
-static void open_loop_me_get_eight_search_point_results_block(
-    MeContext *context_ptr, // input parameter, ME context Ptr, used to get SB Ptr
-    uint32_t   list_index, // input parameter, reference list index
-    uint32_t   ref_pic_index,
-    uint32_t   search_region_index, // input parameter, search area origin, used to
-    // point to reference samples
-    int32_t x_search_index, // input parameter, search region position in the
-    // horizontal direction, used to derive xMV
-    int32_t y_search_index // input parameter, search region position in the
-    // vertical direction, used to derive yMV
-) {
-    // uint32_t ref_luma_stride = ref_pic_ptr->stride_y; // NADER
-    // uint8_t  *ref_ptr = ref_pic_ptr->buffer_y; // NADER
-    const Bool sub_sad         = (context_ptr->me_search_method == SUB_SAD_SEARCH);
-    uint32_t     ref_luma_stride = context_ptr->interpolated_full_stride[list_index][ref_pic_index];
-    uint8_t *    ref_ptr         = context_ptr->integer_buffer_ptr[list_index][ref_pic_index] +
-        ((ME_FILTER_TAP >> 1) * context_ptr->interpolated_full_stride[list_index][ref_pic_index]) +
-        (ME_FILTER_TAP >> 1) + search_region_index;
-
-    uint32_t curr_mv_1 = (((uint16_t)y_search_index) << 18);
-    uint16_t curr_mv_2 = (((uint16_t)x_search_index << 2));
-    uint32_t curr_mv   = curr_mv_1 | curr_mv_2;
-
-    svt_ext_all_sad_calculation_8x8_16x16(context_ptr->b64_src_ptr,
-                                          context_ptr->b64_src_stride,
-                                          ref_ptr,
-                                          ref_luma_stride,
-                                          curr_mv,
-                                          context_ptr->me_type != ME_MCTF,
-                                          context_ptr->p_best_sad_8x8,
-                                          context_ptr->p_best_sad_16x16,
-                                          context_ptr->p_best_mv8x8,
-                                          context_ptr->p_best_mv16x16,
-                                          context_ptr->p_eight_sad16x16,
-                                          context_ptr->p_eight_sad8x8,
-                                          sub_sad);
-
-    svt_ext_eight_sad_calculation_32x32_64x64(context_ptr->p_eight_sad16x16,
-                                              context_ptr->p_best_sad_32x32,
-                                              context_ptr->p_best_sad_64x64,
-                                              context_ptr->p_best_mv32x32,
-                                              context_ptr->p_best_mv64x64,
-                                              curr_mv,
-                                              context_ptr->p_eight_sad32x32);
+void svt_ext_fullpel_search_row_c(uint8_t *src, uint32_t src_stride, uint8_t *ref,
+                                  uint32_t ref_stride, uint32_t mv, uint32_t search_area_width,
+                                  uint8_t out_8x8, Bool sub_sad, uint32_t *p_best_sad_8x8,
+                                  uint32_t *p_best_sad_16x16, uint32_t *p_best_sad_32x32,
+                                  uint32_t *p_best_sad_64x64, uint32_t *p_best_mv8x8,
+                                  uint32_t *p_best_mv16x16, uint32_t *p_best_mv32x32,
+                                  uint32_t *p_best_mv64x64) {
+    uint32_t p_eight_sad16x16[16][8];
+    uint32_t p_eight_sad32x32[4][8];
+
+    for (uint32_t x_search_index = 0; x_search_index < search_area_width; x_search_index += 8) {
+        // only the x component moves along the row
+        const uint32_t curr_mv = (mv & 0xFFFF0000) | ((mv + (x_search_index << 2)) & 0xFFFF);
+        svt_ext_all_sad_calculation_8x8_16x16_c(src,
+                                                src_stride,
+                                                ref + x_search_index,
+                                                ref_stride,
+                                                curr_mv,
+                                                out_8x8,
+                                                p_best_sad_8x8,
+                                                p_best_sad_16x16,
+                                                p_best_mv8x8,
+                                                p_best_mv16x16,
+                                                p_eight_sad16x16,
+                                                NULL,
+                                                sub_sad);
+        svt_ext_eight_sad_calculation_32x32_64x64_c(p_eight_sad16x16,
+                                                    p_best_sad_32x32,
+                                                    p_best_sad_64x64,
+                                                    p_best_mv32x32,
+                                                    p_best_mv64x64,
+                                                    curr_mv,
+                                                    p_eight_sad32x32);
+    }
 }
 /*******************************************
  * open_loop_me_get_search_point_results_block
@@ -813,19 +806,34 @@ static void open_loop_me_fullpel_search_sblock(MeContext *context_ptr, uint32_t
     uint32_t x_search_index, y_search_index;
     uint32_t search_area_width_rest_8 = search_area_width & 7;
     uint32_t search_area_width_mult_8 = search_area_width - search_area_width_rest_8;
+    const Bool     sub_sad         = (context_ptr->me_search_method == SUB_SAD_SEARCH);
+    const uint32_t ref_luma_stride =
+        context_ptr->interpolated_full_stride[list_index][ref_pic_index];
+    uint8_t       *ref_ptr         = context_ptr->integer_buffer_ptr[list_index][ref_pic_index] +
+        ((ME_FILTER_TAP >> 1) * ref_luma_stride) + (ME_FILTER_TAP >> 1);
 
     for (y_search_index = 0; y_search_index < search_area_height; y_search_index++) {
-        for (x_search_index = 0; x_search_index < search_area_width_mult_8; x_search_index += 8) {
-            // this function will do:  x_search_index, +1, +2, ..., +7
-            open_loop_me_get_eight_search_point_results_block(
-                context_ptr,
-                list_index,
-                ref_pic_index,
-                x_search_index +
-                    y_search_index *
-                        context_ptr->interpolated_full_stride[list_index][ref_pic_index],
-                (int32_t)x_search_index + x_search_area_origin,
-                (int32_t)y_search_index + y_search_area_origin);
+        // the positions x_search_index, +1, +2, ..., +search_area_width_mult_8 - 1 of the row
+        if (search_area_width_mult_8) {
+            const uint32_t curr_mv =
+                ((uint32_t)(uint16_t)((int32_t)y_search_index + y_search_area_origin) << 18) |
+                (uint16_t)(((uint16_t)x_search_area_origin) << 2);
+            svt_ext_fullpel_search_row(context_ptr->b64_src_ptr,
+                                       context_ptr->b64_src_stride,
+                                       ref_ptr + y_search_index * ref_luma_stride,
+                                       ref_luma_stride,
+                                       curr_mv,
+                                       search_area_width_mult_8,
+                                       context_ptr->me_type != ME_MCTF,
+                                       sub_sad,
+                                       context_ptr->p_best_sad_8x8,
+                                       context_ptr->p_best_sad_16x16,
+                                       context_ptr->p_best_sad_32x32,
+                                       context_ptr->p_best_sad_64x64,
+                                       context_ptr->p_best_mv8x8,
+                                       context_ptr->p_best_mv16x16,
+                                       context_ptr->p_best_mv32x32,
+                                       context_ptr->p_best_mv64x64);
         }
 
         for (x_search_index = search_area_width_mult_8; x_search_index < search_area_width;
@@ -1793,6 +1801,12 @@ static void prehme_b64(PictureParentControlSet *pcs, uint32_t origin_x, uint32_t
 
                     SearchInfo *prehme_data = &ctx->prehme_data[list_i][ref_i][sr_i];
 
+                    // Same picture already searched in list 0, the search area only depends on the distance
+                    if (list_i == REF_LIST_1 && ctx->hme_cache_ref[ref_i] >= 0) {
+                        *prehme_data = ctx->prehme_data[REF_LIST_0][ctx->hme_cache_ref[ref_i]][sr_i];
+                        continue;
+                    }
+
                     prehme_data->sa.width = MIN(
                         (ctx->prehme_ctrl.prehme_sa_cfg[sr_i].sa_min.width * hme_sr_factor),
                         ctx->prehme_ctrl.prehme_sa_cfg[sr_i].sa_max.width);
@@ -1937,8 +1951,25 @@ static void hme_level0_b64(PictureParentControlSet *pcs, uint32_t origin_x, uint
                 // Get the HME L0 search dimensions for the current frame
                 int16_t sa_width = 0, sa_height = 0;
                 get_hme_l0_search_area(ctx, list_index, ref_pic_index, dist, &sa_width, &sa_height);
+                const HmeL0Result *cached = list_index == REF_LIST_1 &&
+                        ctx->hme_cache_ref[ref_pic_index] >= 0
+                    ? &ctx->hme_l0_cache[ctx->hme_cache_ref[ref_pic_index]]
+                    : NULL;
+                if (cached && (cached->sa_width != sa_width || cached->sa_height != sa_height))
+                    cached = NULL;
                 for (uint8_t sr_h = 0; sr_h < ctx->num_hme_sa_h; sr_h++) {
                     for (uint8_t sr_w = 0; sr_w < ctx->num_hme_sa_w; sr_w++) {
+                        if (cached) {
+                            ctx->hme_level0_sad[list_index][ref_pic_index][sr_w][sr_h] =
+                                cached->sad[sr_w][sr_h];
+                            ctx->x_hme_level0_search_center[list_index][ref_pic_index][sr_w]
+                                                           [sr_h] = cached->x_search_center[sr_w]
+                                                                                           [sr_h];
+                            ctx->y_hme_level0_search_center[list_index][ref_pic_index][sr_w]
+                                                           [sr_h] = cached->y_search_center[sr_w]
+                                                                                           [sr_h];
+                            continue;
+                        }
                         hme_level_0(ctx,
                                     ((int16_t)origin_x) >> 2,
                                     ((int16_t)origin_y) >> 2,
@@ -1956,6 +1987,21 @@ static void hme_level0_b64(PictureParentControlSet *pcs, uint32_t origin_x, uint
                                                                      [sr_w][sr_h]));
                     }
                 }
+                // keep the list 0 results before the pre-HME merge for the list 1 duplicates
+                if (list_index == REF_LIST_0) {
+                    HmeL0Result *cache = &ctx->hme_l0_cache[ref_pic_index];
+                    cache->sa_width    = sa_width;
+                    cache->sa_height   = sa_height;
+                    memcpy(cache->sad,
+                           ctx->hme_level0_sad[list_index][ref_pic_index],
+                           sizeof(cache->sad));
+                    memcpy(cache->x_search_center,
+                           ctx->x_hme_level0_search_center[list_index][ref_pic_index],
+                           sizeof(cache->x_search_center));
+                    memcpy(cache->y_search_center,
+                           ctx->y_hme_level0_search_center[list_index][ref_pic_index],
+                           sizeof(cache->y_search_center));
+                }
 
                 // reset base HME area
                 if (ctx->me_sr_adjustment_ctrls.enable_me_sr_adjustment &&
@@ -2038,8 +2084,33 @@ void hme_level1_b64(PictureParentControlSet *pcs, uint32_t origin_x, uint32_t or
                         continue;
                     }
                 }
+                const int8_t cache_ref = list_index == REF_LIST_1
+                    ? ctx->hme_cache_ref[ref_pic_index]
+                    : -1;
                 for (uint8_t sr_h = 0; sr_h < ctx->num_hme_sa_h; sr_h++) {
                     for (uint8_t sr_w = 0; sr_w < ctx->num_hme_sa_w; sr_w++) {
+                        // Same picture and same level 0 centre as a list 0 reference
+                        if (cache_ref >= 0 &&
+                            ctx->x_hme_level0_search_center[list_index][ref_pic_index][sr_w]
+                                                           [sr_h] ==
+                                ctx->x_hme_level0_search_center[REF_LIST_0][cache_ref][sr_w]
+                                                               [sr_h] &&
+                            ctx->y_hme_level0_search_center[list_index][ref_pic_index][sr_w]
+                                                           [sr_h] ==
+                                ctx->y_hme_level0_search_center[REF_LIST_0][cache_ref][sr_w]
+                                                               [sr_h]) {
+                            ctx->hme_level1_sad[list_index][ref_pic_index][sr_w][sr_h] =
+                                ctx->hme_level1_sad[REF_LIST_0][cache_ref][sr_w][sr_h];
+                            ctx->x_hme_level1_search_center[list_index][ref_pic_index][sr_w]
+                                                           [sr_h] =
+                                ctx->x_hme_level1_search_center[REF_LIST_0][cache_ref][sr_w]
+                                                               [sr_h];
+                            ctx->y_hme_level1_search_center[list_index][ref_pic_index][sr_w]
+                                                           [sr_h] =
+                                ctx->y_hme_level1_search_center[REF_LIST_0][cache_ref][sr_w]
+                                                               [sr_h];
+                            continue;
+                        }
 
                         hme_level_1(ctx,
                                     ((int16_t)origin_x) >> 1,
@@ -2085,8 +2156,33 @@ static void hme_level2_b64(PictureParentControlSet *pcs, uint32_t origin_x, uint
                 pcs, ctx, list_index, ref_pic_index, 2, &dist, input_ptr->width, input_ptr->height);
 
             if (ctx->temporal_layer_index > 0 || list_index == 0) {
+                const int8_t cache_ref = list_index == REF_LIST_1
+                    ? ctx->hme_cache_ref[ref_pic_index]
+                    : -1;
                 for (uint8_t sr_h = 0; sr_h < ctx->num_hme_sa_h; sr_h++) {
                     for (uint8_t sr_w = 0; sr_w < ctx->num_hme_sa_w; sr_w++) {
+                        // Same picture and same level 1 centre as a list 0 reference
+                        if (cache_ref >= 0 &&
+                            ctx->x_hme_level1_search_center[list_index][ref_pic_index][sr_w]
+                                                           [sr_h] ==
+                                ctx->x_hme_level1_search_center[REF_LIST_0][cache_ref][sr_w]
+                                                               [sr_h] &&
+                            ctx->y_hme_level1_search_center[list_index][ref_pic_index][sr_w]
+                                                           [sr_h] ==
+                                ctx->y_hme_level1_search_center[REF_LIST_0][cache_ref][sr_w]
+                                                               [sr_h]) {
+                            ctx->hme_level2_sad[list_index][ref_pic_index][sr_w][sr_h] =
+                                ctx->hme_level2_sad[REF_LIST_0][cache_ref][sr_w][sr_h];
+                            ctx->x_hme_level2_search_center[list_index][ref_pic_index][sr_w]
+                                                           [sr_h] =
+                                ctx->x_hme_level2_search_center[REF_LIST_0][cache_ref][sr_w]
+                                                               [sr_h];
+                            ctx->y_hme_level2_search_center[list_index][ref_pic_index][sr_w]
+                                                           [sr_h] =
+                                ctx->y_hme_level2_search_center[REF_LIST_0][cache_ref][sr_w]
+                                                               [sr_h];
+                            continue;
+                        }
 
                         hme_level_2(
                             ctx,
@@ -2322,6 +2418,10 @@ void init_zz_sad(MeContext *ctx, uint32_t origin_x, uint32_t origin_y) {
     for (int list_i = REF_LIST_0; list_i < ctx->num_of_list_to_search; ++list_i) {
         // Ref Picture Loop
         for (uint8_t ref_i = 0; ref_i < ctx->num_of_ref_pic_to_search[list_i]; ++ref_i) {
+            if (list_i == REF_LIST_1 && ctx->hme_cache_ref[ref_i] >= 0) {
+                ctx->zz_sad[list_i][ref_i] = ctx->zz_sad[REF_LIST_0][ctx->hme_cache_ref[ref_i]];
+                continue;
+            }
             if (ctx->temporal_layer_index > 0 || list_i == 0) {
                 EbPictureBufferDesc *ref_pic = ctx->me_ds_ref_array[list_i][ref_i].picture_ptr;
                 uint32_t             zz_sad  = get_zz_sad(
@@ -2331,11 +2431,37 @@ void init_zz_sad(MeContext *ctx, uint32_t origin_x, uint32_t origin_y) {
         }
     }
 }
+/* Find the list 1 references searching the same picture as a list 0 reference (e.g. the
+ * low delay pictures use the same references in both lists), their coarse searches are taken
+ * from the list 0 results when the search parameters match. */
+static void init_hme_cache(MeContext *ctx) {
+    for (uint8_t ref_i = 0; ref_i < REF_LIST_MAX_DEPTH; ++ref_i) {
+        ctx->hme_cache_ref[ref_i]          = -1;
+        ctx->hme_l0_cache[ref_i].sa_width  = 0;
+        ctx->hme_l0_cache[ref_i].sa_height = 0;
+    }
+    // list 1 is not searched in the base layer
+    if (ctx->num_of_list_to_search <= REF_LIST_1 || ctx->temporal_layer_index == 0)
+        return;
+    for (uint8_t ref_i = 0; ref_i < ctx->num_of_ref_pic_to_search[REF_LIST_1]; ++ref_i) {
+        const EbDownScaledBufDescPtrArray *l1_ref = &ctx->me_ds_ref_array[REF_LIST_1][ref_i];
+        for (uint8_t ref_j = 0; ref_j < ctx->num_of_ref_pic_to_search[REF_LIST_0]; ++ref_j) {
+            const EbDownScaledBufDescPtrArray *l0_ref = &ctx->me_ds_ref_array[REF_LIST_0][ref_j];
+            if (l1_ref->picture_ptr == l0_ref->picture_ptr &&
+                l1_ref->quarter_picture_ptr == l0_ref->quarter_picture_ptr &&
+                l1_ref->sixteenth_picture_ptr == l0_ref->sixteenth_picture_ptr) {
+                ctx->hme_cache_ref[ref_i] = (int8_t)ref_j;
+                break;
+            }
+        }
+    }
+}
 /*******************************************
  * performs hierarchical ME for a 64x64 block for every ref frame
  *******************************************/
 void hme_b64(PictureParentControlSet *pcs_ptr, uint32_t origin_x, uint32_t origin_y,
              MeContext *context_ptr, EbPictureBufferDesc *input_ptr) {
+    init_hme_cache(context_ptr);
     // If needed, initialize the zz sad array
     if (context_ptr->me_early_exit_th)
         init_zz_sad(context_ptr, origin_x, origin_y);
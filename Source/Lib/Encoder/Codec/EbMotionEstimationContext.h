@@ -335,6 +335,14 @@ typedef struct SearchResults {
     uint64_t hme_sad; // hme sad
     uint8_t  do_ref; // to process this ref in ME or not
 } SearchResults;
+// HME level 0 results of one reference before the pre-HME merge
+typedef struct HmeL0Result {
+    int16_t  sa_width; // search area width used by the search
+    int16_t  sa_height; // search area height used by the search
+    int16_t  x_search_center[EB_HME_SEARCH_AREA_COLUMN_MAX_COUNT][EB_HME_SEARCH_AREA_ROW_MAX_COUNT];
+    int16_t  y_search_center[EB_HME_SEARCH_AREA_COLUMN_MAX_COUNT][EB_HME_SEARCH_AREA_ROW_MAX_COUNT];
+    uint64_t sad[EB_HME_SEARCH_AREA_COLUMN_MAX_COUNT][EB_HME_SEARCH_AREA_ROW_MAX_COUNT];
+} HmeL0Result;
 typedef struct MeContext {
     EbDctor dctor;
     // Search region stride
@@ -372,9 +380,6 @@ typedef struct MeContext {
     uint32_t *p_best_full_pel_mv64x64;
     uint8_t   full_quarter_pel_refinement;
     uint16_t *p_eight_pos_sad16x16;
-    EB_ALIGN(64) uint32_t p_eight_sad32x32[4][8];
-    EB_ALIGN(64) uint32_t p_eight_sad16x16[16][8];
-    EB_ALIGN(64) uint32_t p_eight_sad8x8[64][8];
     EbBitFraction     *mvd_bits_array;
     uint8_t            hme_search_method;
     uint8_t            me_search_method;
@@ -425,6 +430,11 @@ typedef struct MeContext {
                                       [EB_HME_SEARCH_AREA_ROW_MAX_COUNT];
     uint64_t hme_level2_sad[MAX_NUM_OF_REF_PIC_LIST][MAX_REF_IDX]
                            [EB_HME_SEARCH_AREA_COLUMN_MAX_COUNT][EB_HME_SEARCH_AREA_ROW_MAX_COUNT];
+    // Coarse search cache of the current 64x64 block: hme_cache_ref[ref] is the list 0 index of
+    // the picture of list 1 reference ref (-1 if none), the pre-HME / HME results of that pair
+    // are reused when the search parameters match instead of searching the picture again
+    int8_t      hme_cache_ref[REF_LIST_MAX_DEPTH];
+    HmeL0Result hme_l0_cache[REF_LIST_MAX_DEPTH];
     int16_t adjust_hme_l1_factor[MAX_NUM_OF_REF_PIC_LIST][REF_LIST_MAX_DEPTH];
     int16_t adjust_hme_l2_factor[MAX_NUM_OF_REF_PIC_LIST][REF_LIST_MAX_DEPTH];
     int16_t hme_factor;
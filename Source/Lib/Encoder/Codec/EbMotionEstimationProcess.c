@@ -783,256 +783,273 @@ EbErrorType motion_estimation_context_ctor(EbThreadContext *  thread_context_ptr
         enc_handle_ptr->picture_decision_results_resource_ptr, index);
     context_ptr->motion_estimation_results_output_fifo_ptr = svt_system_resource_get_producer_fifo(
         enc_handle_ptr->motion_estimation_results_resource_ptr, index);
+    if (enc_handle_ptr->gm_search_task_resource_ptr)
+        context_ptr->gm_search_task_output_fifo_ptr = svt_system_resource_get_producer_fifo(
+            enc_handle_ptr->gm_search_task_resource_ptr, index);
     EB_NEW(context_ptr->me_context_ptr, me_context_ctor);
     return EB_ErrorNone;
 }
-/************************************************
- * Motion Analysis Kernel
- * The Motion Analysis performs  Motion Estimation
- * This process has access to the current input picture as well as
- * the input pictures, which the current picture references according
- * to the prediction structure pattern.  The Motion Analysis process is multithreaded,
- * so pictures can be processed out of order as long as all inputs are available.
- ************************************************/
-void *motion_estimation_kernel(void *input_ptr) {
-    EbThreadContext *          thread_context_ptr = (EbThreadContext *)input_ptr;
+/******************************************************
+ * Motion Estimation Task
+ *   Motion estimation of the segment of one Picture Decision result
+ ******************************************************/
+void motion_estimation_process_task(EbThreadContext *thread_context_ptr,
+                                    EbObjectWrapper *in_results_wrapper_ptr) {
     MotionEstimationContext_t *context_ptr = (MotionEstimationContext_t *)thread_context_ptr->priv;
-    EbObjectWrapper *          in_results_wrapper_ptr;
     EbObjectWrapper *          out_results_wrapper_ptr;
-    for (;;) {
-        // Get Input Full Object
-        EB_GET_FULL_OBJECT(context_ptr->picture_decision_results_input_fifo_ptr,
-                           &in_results_wrapper_ptr);
-        PictureDecisionResults *in_results_ptr = (PictureDecisionResults *)
-                                                     in_results_wrapper_ptr->object_ptr;
-        PictureParentControlSet *pcs_ptr = (PictureParentControlSet *)
-                                               in_results_ptr->pcs_wrapper_ptr->object_ptr;
-        SequenceControlSet *scs_ptr = (SequenceControlSet *)pcs_ptr->scs_wrapper_ptr->object_ptr;
-        if (in_results_ptr->task_type == TASK_TFME)
-            context_ptr->me_context_ptr->me_type = ME_MCTF;
-        else if (in_results_ptr->task_type == TASK_FIRST_PASS_ME)
-            context_ptr->me_context_ptr->me_type = ME_FIRST_PASS;
-        else // TASK_PAME or TASK_SUPERRES_RE_ME
-            context_ptr->me_context_ptr->me_type = ME_OPEN_LOOP;
-
-        // ME Kernel Signal(s) derivation
-        if ((in_results_ptr->task_type == TASK_PAME) ||
-            (in_results_ptr->task_type == TASK_SUPERRES_RE_ME))
-            if (scs_ptr->static_config.pass == ENC_FIRST_PASS)
-                first_pass_signal_derivation_me_kernel(scs_ptr, pcs_ptr, context_ptr);
-            else
-                signal_derivation_me_kernel_oq(scs_ptr, pcs_ptr, context_ptr);
 
-        else if (in_results_ptr->task_type == TASK_TFME)
-            tf_signal_derivation_me_kernel_oq(pcs_ptr, context_ptr);
-        else // TASK_FIRST_PASS_ME
+    PictureDecisionResults *in_results_ptr = (PictureDecisionResults *)
+                                                 in_results_wrapper_ptr->object_ptr;
+    PictureParentControlSet *pcs_ptr = (PictureParentControlSet *)
+                                           in_results_ptr->pcs_wrapper_ptr->object_ptr;
+    SequenceControlSet *scs_ptr = (SequenceControlSet *)pcs_ptr->scs_wrapper_ptr->object_ptr;
+    if (in_results_ptr->task_type == TASK_TFME)
+        context_ptr->me_context_ptr->me_type = ME_MCTF;
+    else if (in_results_ptr->task_type == TASK_FIRST_PASS_ME)
+        context_ptr->me_context_ptr->me_type = ME_FIRST_PASS;
+    else // TASK_PAME or TASK_SUPERRES_RE_ME
+        context_ptr->me_context_ptr->me_type = ME_OPEN_LOOP;
+
+    // ME Kernel Signal(s) derivation
+    if ((in_results_ptr->task_type == TASK_PAME) ||
+        (in_results_ptr->task_type == TASK_SUPERRES_RE_ME))
+        if (scs_ptr->static_config.pass == ENC_FIRST_PASS)
             first_pass_signal_derivation_me_kernel(scs_ptr, pcs_ptr, context_ptr);
-
-        if ((in_results_ptr->task_type == TASK_PAME) ||
-            (in_results_ptr->task_type == TASK_SUPERRES_RE_ME)) {
-            EbPictureBufferDesc *sixteenth_picture_ptr;
-            EbPictureBufferDesc *quarter_picture_ptr;
-            EbPictureBufferDesc *input_padded_picture_ptr;
-            EbPictureBufferDesc *input_picture_ptr;
-            EbPaReferenceObject *pa_ref_obj_;
-
-            //assert((int)pcs_ptr->pa_reference_picture_wrapper_ptr->live_count > 0);
-            pa_ref_obj_ = (EbPaReferenceObject *)
-                              pcs_ptr->pa_reference_picture_wrapper_ptr->object_ptr;
-            // Set 1/4 and 1/16 ME input buffer(s); filtered or decimated
-            quarter_picture_ptr = (EbPictureBufferDesc *)
-                                      pa_ref_obj_->quarter_downsampled_picture_ptr;
-            sixteenth_picture_ptr = (EbPictureBufferDesc *)
-                                        pa_ref_obj_->sixteenth_downsampled_picture_ptr;
-            input_padded_picture_ptr = (EbPictureBufferDesc *)pa_ref_obj_->input_padded_picture_ptr;
-
-            if (pcs_ptr->frame_superres_enabled)
-                input_picture_ptr = pcs_ptr->enhanced_downscaled_picture_ptr;
-            else
-                input_picture_ptr = pcs_ptr->enhanced_unscaled_picture_ptr;
-            // Segments
-            uint32_t segment_index   = in_results_ptr->segment_index;
-            uint32_t pic_width_in_b64 = (pcs_ptr->aligned_width + scs_ptr->sb_sz - 1) / scs_ptr->sb_sz;
-            uint32_t picture_height_in_b64 = (pcs_ptr->aligned_height + scs_ptr->sb_sz - 1) / scs_ptr->sb_sz;
-            uint32_t y_segment_index;
-            uint32_t x_segment_index;
-
-            SEGMENT_CONVERT_IDX_TO_XY(segment_index, x_segment_index, y_segment_index, pcs_ptr->me_segments_column_count);
-            uint32_t x_b64_start_index = SEGMENT_START_IDX(x_segment_index, pic_width_in_b64, pcs_ptr->me_segments_column_count);
-            uint32_t x_b64_end_index = SEGMENT_END_IDX(x_segment_index, pic_width_in_b64, pcs_ptr->me_segments_column_count);
-            uint32_t y_b64_start_index = SEGMENT_START_IDX(y_segment_index, picture_height_in_b64, pcs_ptr->me_segments_row_count);
-            uint32_t y_b64_end_index = SEGMENT_END_IDX(y_segment_index, picture_height_in_b64, pcs_ptr->me_segments_row_count);
-
-            Bool skip_me = FALSE;
-            if (scs_ptr->static_config.pass == ENC_FIRST_PASS ||
-                (!pcs_ptr->is_used_as_reference_flag && scs_ptr->rc_stat_gen_pass_mode &&
-                 !pcs_ptr->first_frame_in_minigop))
-                skip_me = TRUE;
-            // skip me for the first pass. ME is already performed
-            if (!skip_me) {
-                if (pcs_ptr->slice_type != I_SLICE) {
-                    // Use scaled source references if resolution of the reference is different that of the input
-                    use_scaled_source_refs_if_needed(pcs_ptr,
-                                                     input_picture_ptr,
-                                                     pa_ref_obj_,
-                                                     &input_padded_picture_ptr,
-                                                     &quarter_picture_ptr,
-                                                     &sixteenth_picture_ptr);
-
-                    // 64x64 Block Loop
-                    for (uint32_t y_b64_index = y_b64_start_index; y_b64_index < y_b64_end_index; ++y_b64_index) {
-                        for (uint32_t x_b64_index = x_b64_start_index; x_b64_index < x_b64_end_index; ++x_b64_index) {
-
-                            uint32_t b64_index    = (uint16_t)(x_b64_index + y_b64_index * pic_width_in_b64);
-
-                            uint32_t b64_origin_x = x_b64_index * scs_ptr->sb_sz;
-                            uint32_t b64_origin_y = y_b64_index * scs_ptr->sb_sz;
-
-                            // Load the 64x64 Block from the input to the intermediate block buffer
-                            uint32_t buffer_index = (input_picture_ptr->origin_y + b64_origin_y) * input_picture_ptr->stride_y +
-                                input_picture_ptr->origin_x + b64_origin_x;
+        else
+            signal_derivation_me_kernel_oq(scs_ptr, pcs_ptr, context_ptr);
+
+    else if (in_results_ptr->task_type == TASK_TFME)
+        tf_signal_derivation_me_kernel_oq(pcs_ptr, context_ptr);
+    else // TASK_FIRST_PASS_ME
+        first_pass_signal_derivation_me_kernel(scs_ptr, pcs_ptr, context_ptr);
+
+    if ((in_results_ptr->task_type == TASK_PAME) ||
+        (in_results_ptr->task_type == TASK_SUPERRES_RE_ME)) {
+        EbPictureBufferDesc *sixteenth_picture_ptr;
+        EbPictureBufferDesc *quarter_picture_ptr;
+        EbPictureBufferDesc *input_padded_picture_ptr;
+        EbPictureBufferDesc *input_picture_ptr;
+        EbPaReferenceObject *pa_ref_obj_;
+
+        //assert((int)pcs_ptr->pa_reference_picture_wrapper_ptr->live_count > 0);
+        pa_ref_obj_ = (EbPaReferenceObject *)
+                          pcs_ptr->pa_reference_picture_wrapper_ptr->object_ptr;
+        // Set 1/4 and 1/16 ME input buffer(s); filtered or decimated
+        quarter_picture_ptr = (EbPictureBufferDesc *)
+                                  pa_ref_obj_->quarter_downsampled_picture_ptr;
+        sixteenth_picture_ptr = (EbPictureBufferDesc *)
+                                    pa_ref_obj_->sixteenth_downsampled_picture_ptr;
+        input_padded_picture_ptr = (EbPictureBufferDesc *)pa_ref_obj_->input_padded_picture_ptr;
+
+        if (pcs_ptr->frame_superres_enabled)
+            input_picture_ptr = pcs_ptr->enhanced_downscaled_picture_ptr;
+        else
+            input_picture_ptr = pcs_ptr->enhanced_unscaled_picture_ptr;
+        // Segments
+        uint32_t segment_index   = in_results_ptr->segment_index;
+        uint32_t pic_width_in_b64 = (pcs_ptr->aligned_width + scs_ptr->sb_sz - 1) / scs_ptr->sb_sz;
+        uint32_t picture_height_in_b64 = (pcs_ptr->aligned_height + scs_ptr->sb_sz - 1) / scs_ptr->sb_sz;
+        uint32_t y_segment_index;
+        uint32_t x_segment_index;
+
+        SEGMENT_CONVERT_IDX_TO_XY(segment_index, x_segment_index, y_segment_index, pcs_ptr->me_segments_column_count);
+        uint32_t x_b64_start_index = SEGMENT_START_IDX(x_segment_index, pic_width_in_b64, pcs_ptr->me_segments_column_count);
+        uint32_t x_b64_end_index = SEGMENT_END_IDX(x_segment_index, pic_width_in_b64, pcs_ptr->me_segments_column_count);
+        uint32_t y_b64_start_index = SEGMENT_START_IDX(y_segment_index, picture_height_in_b64, pcs_ptr->me_segments_row_count);
+        uint32_t y_b64_end_index = SEGMENT_END_IDX(y_segment_index, picture_height_in_b64, pcs_ptr->me_segments_row_count);
+
+        Bool skip_me = FALSE;
+        if (scs_ptr->static_config.pass == ENC_FIRST_PASS ||
+            (!pcs_ptr->is_used_as_reference_flag && scs_ptr->rc_stat_gen_pass_mode &&
+             !pcs_ptr->first_frame_in_minigop))
+            skip_me = TRUE;
+        // skip me for the first pass. ME is already performed
+        if (!skip_me) {
+            if (pcs_ptr->slice_type != I_SLICE) {
+                // Use scaled source references if resolution of the reference is different that of the input
+                use_scaled_source_refs_if_needed(pcs_ptr,
+                                                 input_picture_ptr,
+                                                 pa_ref_obj_,
+                                                 &input_padded_picture_ptr,
+                                                 &quarter_picture_ptr,
+                                                 &sixteenth_picture_ptr);
+
+                // 64x64 Block Loop
+                for (uint32_t y_b64_index = y_b64_start_index; y_b64_index < y_b64_end_index; ++y_b64_index) {
+                    for (uint32_t x_b64_index = x_b64_start_index; x_b64_index < x_b64_end_index; ++x_b64_index) {
+
+                        uint32_t b64_index    = (uint16_t)(x_b64_index + y_b64_index * pic_width_in_b64);
+
+                        uint32_t b64_origin_x = x_b64_index * scs_ptr->sb_sz;
+                        uint32_t b64_origin_y = y_b64_index * scs_ptr->sb_sz;
+
+                        // Load the 64x64 Block from the input to the intermediate block buffer
+                        uint32_t buffer_index = (input_picture_ptr->origin_y + b64_origin_y) * input_picture_ptr->stride_y +
+                            input_picture_ptr->origin_x + b64_origin_x;
 #ifdef ARCH_X86_64
-                            uint8_t *src_ptr   = &input_padded_picture_ptr->buffer_y[buffer_index];
-                            uint32_t b64_height = (pcs_ptr->aligned_height - b64_origin_y) < BLOCK_SIZE_64
-                                ? pcs_ptr->aligned_height - b64_origin_y : BLOCK_SIZE_64;
-                            //_MM_HINT_T0     //_MM_HINT_T1    //_MM_HINT_T2//_MM_HINT_NTA
-                            for (uint32_t i = 0; i < b64_height; i++) {
-                                char const *p = (char const *)(src_ptr + i * input_padded_picture_ptr->stride_y);
-                                _mm_prefetch(p, _MM_HINT_T2);
-                            }
+                        uint8_t *src_ptr   = &input_padded_picture_ptr->buffer_y[buffer_index];
+                        uint32_t b64_height = (pcs_ptr->aligned_height - b64_origin_y) < BLOCK_SIZE_64
+                            ? pcs_ptr->aligned_height - b64_origin_y : BLOCK_SIZE_64;
+                        //_MM_HINT_T0     //_MM_HINT_T1    //_MM_HINT_T2//_MM_HINT_NTA
+                        for (uint32_t i = 0; i < b64_height; i++) {
+                            char const *p = (char const *)(src_ptr + i * input_padded_picture_ptr->stride_y);
+                            _mm_prefetch(p, _MM_HINT_T2);
+                        }
 #endif
-                            context_ptr->me_context_ptr->b64_src_ptr = &input_padded_picture_ptr->buffer_y[buffer_index];
-                            context_ptr->me_context_ptr->b64_src_stride = input_padded_picture_ptr->stride_y;
+                        context_ptr->me_context_ptr->b64_src_ptr = &input_padded_picture_ptr->buffer_y[buffer_index];
+                        context_ptr->me_context_ptr->b64_src_stride = input_padded_picture_ptr->stride_y;
 
-                            // Load the 1/4 decimated SB from the 1/4 decimated input to the 1/4 intermediate SB buffer
-                            if (context_ptr->me_context_ptr->enable_hme_level1_flag) {
-                                buffer_index = (quarter_picture_ptr->origin_y + (b64_origin_y >> 1)) * quarter_picture_ptr->stride_y +
-                                    quarter_picture_ptr->origin_x + (b64_origin_x >> 1);
+                        // Load the 1/4 decimated SB from the 1/4 decimated input to the 1/4 intermediate SB buffer
+                        if (context_ptr->me_context_ptr->enable_hme_level1_flag) {
+                            buffer_index = (quarter_picture_ptr->origin_y + (b64_origin_y >> 1)) * quarter_picture_ptr->stride_y +
+                                quarter_picture_ptr->origin_x + (b64_origin_x >> 1);
 
-                                context_ptr->me_context_ptr->quarter_b64_buffer = &quarter_picture_ptr->buffer_y[buffer_index];
-                                context_ptr->me_context_ptr->quarter_b64_buffer_stride = quarter_picture_ptr->stride_y;
-                            }
+                            context_ptr->me_context_ptr->quarter_b64_buffer = &quarter_picture_ptr->buffer_y[buffer_index];
+                            context_ptr->me_context_ptr->quarter_b64_buffer_stride = quarter_picture_ptr->stride_y;
+                        }
 
-                            // Load the 1/16 decimated SB from the 1/16 decimated input to the 1/16 intermediate SB buffer
-                            if (context_ptr->me_context_ptr->enable_hme_level0_flag) {
-                                buffer_index = (sixteenth_picture_ptr->origin_y + (b64_origin_y >> 2)) * sixteenth_picture_ptr->stride_y +
-                                    sixteenth_picture_ptr->origin_x + (b64_origin_x >> 2);
+                        // Load the 1/16 decimated SB from the 1/16 decimated input to the 1/16 intermediate SB buffer
+                        if (context_ptr->me_context_ptr->enable_hme_level0_flag) {
+                            buffer_index = (sixteenth_picture_ptr->origin_y + (b64_origin_y >> 2)) * sixteenth_picture_ptr->stride_y +
+                                sixteenth_picture_ptr->origin_x + (b64_origin_x >> 2);
 
-                                context_ptr->me_context_ptr->sixteenth_b64_buffer = &sixteenth_picture_ptr->buffer_y[buffer_index];
-                                context_ptr->me_context_ptr->sixteenth_b64_buffer_stride = sixteenth_picture_ptr->stride_y;
-                            }
+                            context_ptr->me_context_ptr->sixteenth_b64_buffer = &sixteenth_picture_ptr->buffer_y[buffer_index];
+                            context_ptr->me_context_ptr->sixteenth_b64_buffer_stride = sixteenth_picture_ptr->stride_y;
+                        }
 
-                            context_ptr->me_context_ptr->me_type = ME_OPEN_LOOP;
-
-                            if ((in_results_ptr->task_type == TASK_PAME) || (in_results_ptr->task_type == TASK_SUPERRES_RE_ME)) {
-                                context_ptr->me_context_ptr->num_of_list_to_search =
-                                    (pcs_ptr->slice_type == P_SLICE) ? 1 /*List 0 only*/
-                                    : 2 /*List 0 + 1*/;
-
-                                context_ptr->me_context_ptr->num_of_ref_pic_to_search[0] = pcs_ptr->ref_list0_count_try;
-                                if (pcs_ptr->slice_type == B_SLICE)
-                                    context_ptr->me_context_ptr->num_of_ref_pic_to_search[1] = pcs_ptr->ref_list1_count_try;
-                                context_ptr->me_context_ptr->temporal_layer_index = pcs_ptr->temporal_layer_index;
-                                context_ptr->me_context_ptr->is_used_as_reference_flag = pcs_ptr->is_used_as_reference_flag;
-
-                                if (pcs_ptr->frame_superres_enabled) {
-                                    for (int i = 0;  i < context_ptr->me_context_ptr->num_of_list_to_search; i++) {
-                                        for (int j = 0; j < context_ptr->me_context_ptr->num_of_ref_pic_to_search[i]; j++) {
-                                            //assert((int)pcs_ptr->ref_pa_pic_ptr_array[i][j]->live_count > 0);
-                                            uint8_t denom_idx = (uint8_t)(pcs_ptr->superres_denom - SCALE_NUMERATOR - 1);
-                                            EbPaReferenceObject *reference_object =
-                                                (EbPaReferenceObject *)pcs_ptr->ref_pa_pic_ptr_array[i][j]->object_ptr;
-                                            context_ptr->me_context_ptr->me_ds_ref_array[i][j].picture_ptr =
-                                                reference_object->downscaled_input_padded_picture_ptr[denom_idx];
-                                            context_ptr->me_context_ptr->me_ds_ref_array[i][j].quarter_picture_ptr =
-                                                reference_object->downscaled_quarter_downsampled_picture_ptr[denom_idx];
-                                            context_ptr->me_context_ptr->me_ds_ref_array[i][j].sixteenth_picture_ptr =
-                                                reference_object->downscaled_sixteenth_downsampled_picture_ptr[denom_idx];
-                                            context_ptr->me_context_ptr->me_ds_ref_array[i][j].picture_number =
-                                                reference_object->picture_number;
-                                        }
+                        context_ptr->me_context_ptr->me_type = ME_OPEN_LOOP;
+
+                        if ((in_results_ptr->task_type == TASK_PAME) || (in_results_ptr->task_type == TASK_SUPERRES_RE_ME)) {
+                            context_ptr->me_context_ptr->num_of_list_to_search =
+                                (pcs_ptr->slice_type == P_SLICE) ? 1 /*List 0 only*/
+                                : 2 /*List 0 + 1*/;
+
+                            context_ptr->me_context_ptr->num_of_ref_pic_to_search[0] = pcs_ptr->ref_list0_count_try;
+                            if (pcs_ptr->slice_type == B_SLICE)
+                                context_ptr->me_context_ptr->num_of_ref_pic_to_search[1] = pcs_ptr->ref_list1_count_try;
+                            context_ptr->me_context_ptr->temporal_layer_index = pcs_ptr->temporal_layer_index;
+                            context_ptr->me_context_ptr->is_used_as_reference_flag = pcs_ptr->is_used_as_reference_flag;
+
+                            if (pcs_ptr->frame_superres_enabled) {
+                                for (int i = 0;  i < context_ptr->me_context_ptr->num_of_list_to_search; i++) {
+                                    for (int j = 0; j < context_ptr->me_context_ptr->num_of_ref_pic_to_search[i]; j++) {
+                                        //assert((int)pcs_ptr->ref_pa_pic_ptr_array[i][j]->live_count > 0);
+                                        uint8_t denom_idx = (uint8_t)(pcs_ptr->superres_denom - SCALE_NUMERATOR - 1);
+                                        EbPaReferenceObject *reference_object =
+                                            (EbPaReferenceObject *)pcs_ptr->ref_pa_pic_ptr_array[i][j]->object_ptr;
+                                        context_ptr->me_context_ptr->me_ds_ref_array[i][j].picture_ptr =
+                                            reference_object->downscaled_input_padded_picture_ptr[denom_idx];
+                                        context_ptr->me_context_ptr->me_ds_ref_array[i][j].quarter_picture_ptr =
+                                            reference_object->downscaled_quarter_downsampled_picture_ptr[denom_idx];
+                                        context_ptr->me_context_ptr->me_ds_ref_array[i][j].sixteenth_picture_ptr =
+                                            reference_object->downscaled_sixteenth_downsampled_picture_ptr[denom_idx];
+                                        context_ptr->me_context_ptr->me_ds_ref_array[i][j].picture_number =
+                                            reference_object->picture_number;
                                     }
-                                } else {
-                                    for (int i = 0; i < context_ptr->me_context_ptr->num_of_list_to_search; i++) {
-                                        for (int j = 0; j < context_ptr->me_context_ptr->num_of_ref_pic_to_search[i]; j++) {
-                                            //assert((int)pcs_ptr->ref_pa_pic_ptr_array[i][j]->live_count > 0);
-                                            EbPaReferenceObject *reference_object =
-                                                (EbPaReferenceObject *)pcs_ptr->ref_pa_pic_ptr_array[i][j]->object_ptr;
-                                            context_ptr->me_context_ptr->me_ds_ref_array[i][j].picture_ptr =
-                                                reference_object->input_padded_picture_ptr;
-                                            context_ptr->me_context_ptr->me_ds_ref_array[i][j].quarter_picture_ptr =
-                                                reference_object->quarter_downsampled_picture_ptr;
-                                            context_ptr->me_context_ptr->me_ds_ref_array[i][j].sixteenth_picture_ptr =
-                                                reference_object->sixteenth_downsampled_picture_ptr;
-                                            context_ptr->me_context_ptr->me_ds_ref_array[i][j].picture_number =
-                                                reference_object->picture_number;
-                                        }
+                                }
+                            } else {
+                                for (int i = 0; i < context_ptr->me_context_ptr->num_of_list_to_search; i++) {
+                                    for (int j = 0; j < context_ptr->me_context_ptr->num_of_ref_pic_to_search[i]; j++) {
+                                        //assert((int)pcs_ptr->ref_pa_pic_ptr_array[i][j]->live_count > 0);
+                                        EbPaReferenceObject *reference_object =
+                                            (EbPaReferenceObject *)pcs_ptr->ref_pa_pic_ptr_array[i][j]->object_ptr;
+                                        context_ptr->me_context_ptr->me_ds_ref_array[i][j].picture_ptr =
+                                            reference_object->input_padded_picture_ptr;
+                                        context_ptr->me_context_ptr->me_ds_ref_array[i][j].quarter_picture_ptr =
+                                            reference_object->quarter_downsampled_picture_ptr;
+                                        context_ptr->me_context_ptr->me_ds_ref_array[i][j].sixteenth_picture_ptr =
+                                            reference_object->sixteenth_downsampled_picture_ptr;
+                                        context_ptr->me_context_ptr->me_ds_ref_array[i][j].picture_number =
+                                            reference_object->picture_number;
                                     }
                                 }
                             }
+                        }
 
-                            motion_estimation_b64(pcs_ptr,
-                                b64_index,
-                                b64_origin_x,
-                                b64_origin_y,
-                                context_ptr->me_context_ptr,
-                                input_picture_ptr);
-
-                            if ((in_results_ptr->task_type == TASK_PAME) || (in_results_ptr->task_type == TASK_SUPERRES_RE_ME)) {
-                                svt_block_on_mutex(pcs_ptr->me_processed_b64_mutex);
-                                pcs_ptr->me_processed_b64_count++;
-                                // We need to finish ME for all SBs to do GM
-                                if (pcs_ptr->me_processed_b64_count == pcs_ptr->sb_total_count) {
-                                    if (pcs_ptr->gm_ctrls.enabled)
-                                        global_motion_estimation(pcs_ptr, input_picture_ptr);
-                                    else
-                                        // Initilize global motion to be OFF when GM is OFF
-                                        memset(pcs_ptr->is_global_motion, FALSE, MAX_NUM_OF_REF_PIC_LIST * REF_LIST_MAX_DEPTH);
-                                }
-
-                                svt_release_mutex(pcs_ptr->me_processed_b64_mutex);
+                        motion_estimation_b64(pcs_ptr,
+                            b64_index,
+                            b64_origin_x,
+                            b64_origin_y,
+                            context_ptr->me_context_ptr,
+                            input_picture_ptr);
+
+                        if ((in_results_ptr->task_type == TASK_PAME) || (in_results_ptr->task_type == TASK_SUPERRES_RE_ME)) {
+                            svt_block_on_mutex(pcs_ptr->me_processed_b64_mutex);
+                            pcs_ptr->me_processed_b64_count++;
+                            // We need to finish ME for all SBs to do GM
+                            if (pcs_ptr->me_processed_b64_count == pcs_ptr->sb_total_count) {
+                                if (pcs_ptr->gm_ctrls.enabled)
+                                    global_motion_estimation(pcs_ptr,
+                                                             input_picture_ptr,
+                                                             context_ptr->gm_search_task_output_fifo_ptr);
+                                else
+                                    // Initilize global motion to be OFF when GM is OFF
+                                    memset(pcs_ptr->is_global_motion, FALSE, MAX_NUM_OF_REF_PIC_LIST * REF_LIST_MAX_DEPTH);
                             }
+
+                            svt_release_mutex(pcs_ptr->me_processed_b64_mutex);
                         }
                     }
                 }
-
-                if (scs_ptr->in_loop_ois == 0 && pcs_ptr->tpl_ctrls.enable)
-                    for (uint32_t y_b64_index = y_b64_start_index; y_b64_index < y_b64_end_index; ++y_b64_index)
-                        for (uint32_t x_b64_index = x_b64_start_index; x_b64_index < x_b64_end_index; ++x_b64_index) {
-                            uint32_t b64_index = (uint16_t)(x_b64_index + y_b64_index * pic_width_in_b64);
-                            open_loop_intra_search_mb(pcs_ptr, b64_index, input_picture_ptr);
-                        }
             }
-            // Get Empty Results Object
-            svt_get_empty_object(context_ptr->motion_estimation_results_output_fifo_ptr,
-                                 &out_results_wrapper_ptr);
-
-            MotionEstimationResults *out_results_ptr = (MotionEstimationResults *)
-                                                           out_results_wrapper_ptr->object_ptr;
-            out_results_ptr->pcs_wrapper_ptr = in_results_ptr->pcs_wrapper_ptr;
-            out_results_ptr->segment_index   = segment_index;
-            out_results_ptr->task_type       = in_results_ptr->task_type;
-            // Release the Input Results
-            svt_release_object(in_results_wrapper_ptr);
-
-            // Post the Full Results Object
-            svt_post_full_object(out_results_wrapper_ptr);
-        } else if (in_results_ptr->task_type == TASK_TFME) {
-            // temporal filtering start
-            context_ptr->me_context_ptr->me_type = ME_MCTF;
-            svt_av1_init_temporal_filtering(
-                pcs_ptr->temp_filt_pcs_list, pcs_ptr, context_ptr, in_results_ptr->segment_index);
-
-            // Release the Input Results
-            svt_release_object(in_results_wrapper_ptr);
-        } else {
-            // first pass start
-            context_ptr->me_context_ptr->me_type = ME_FIRST_PASS;
-            open_loop_first_pass(pcs_ptr, context_ptr, in_results_ptr->segment_index);
 
-            // Release the Input Results
-            svt_release_object(in_results_wrapper_ptr);
+            if (scs_ptr->in_loop_ois == 0 && pcs_ptr->tpl_ctrls.enable)
+                for (uint32_t y_b64_index = y_b64_start_index; y_b64_index < y_b64_end_index; ++y_b64_index)
+                    for (uint32_t x_b64_index = x_b64_start_index; x_b64_index < x_b64_end_index; ++x_b64_index) {
+                        uint32_t b64_index = (uint16_t)(x_b64_index + y_b64_index * pic_width_in_b64);
+                        open_loop_intra_search_mb(pcs_ptr, b64_index, input_picture_ptr);
+                    }
         }
+        // Get Empty Results Object
+        svt_get_empty_object(context_ptr->motion_estimation_results_output_fifo_ptr,
+                             &out_results_wrapper_ptr);
+
+        MotionEstimationResults *out_results_ptr = (MotionEstimationResults *)
+                                                       out_results_wrapper_ptr->object_ptr;
+        out_results_ptr->pcs_wrapper_ptr = in_results_ptr->pcs_wrapper_ptr;
+        out_results_ptr->segment_index   = segment_index;
+        out_results_ptr->task_type       = in_results_ptr->task_type;
+        // Release the Input Results
+        svt_release_object(in_results_wrapper_ptr);
+
+        // Post the Full Results Object
+        svt_post_full_object(out_results_wrapper_ptr);
+    } else if (in_results_ptr->task_type == TASK_TFME) {
+        // temporal filtering start
+        context_ptr->me_context_ptr->me_type = ME_MCTF;
+        svt_av1_init_temporal_filtering(
+            pcs_ptr->temp_filt_pcs_list, pcs_ptr, context_ptr, in_results_ptr->segment_index);
+
+        // Release the Input Results
+        svt_release_object(in_results_wrapper_ptr);
+    } else {
+        // first pass start
+        context_ptr->me_context_ptr->me_type = ME_FIRST_PASS;
+        open_loop_first_pass(pcs_ptr, context_ptr, in_results_ptr->segment_index);
+
+        // Release the Input Results
+        svt_release_object(in_results_wrapper_ptr);
+    }
+}
+
+/************************************************
+ * Motion Analysis Kernel
+ * The Motion Analysis performs  Motion Estimation
+ * This process has access to the current input picture as well as
+ * the input pictures, which the current picture references according
+ * to the prediction structure pattern.  The Motion Analysis process is multithreaded,
+ * so pictures can be processed out of order as long as all inputs are available.
+ ************************************************/
+void *motion_estimation_kernel(void *input_ptr) {
+    EbThreadContext *thread_context_ptr = (EbThreadContext *)input_ptr;
+    MotionEstimationContext_t *context_ptr = (MotionEstimationContext_t *)thread_context_ptr->priv;
+    EbObjectWrapper *in_results_wrapper_ptr;
+
+    for (;;) {
+        // Get Input Full Object
+        EB_GET_FULL_OBJECT(context_ptr->picture_decision_results_input_fifo_ptr,
+                           &in_results_wrapper_ptr);
+        motion_estimation_process_task(thread_context_ptr, in_results_wrapper_ptr);
     }
 
     return NULL;
@@ -22,6 +22,8 @@
 typedef struct MotionEstimationContext {
     EbFifo    *picture_decision_results_input_fifo_ptr;
     EbFifo    *motion_estimation_results_output_fifo_ptr;
+    // NULL when there is no GM search thread
+    EbFifo    *gm_search_task_output_fifo_ptr;
     MeContext *me_context_ptr;
 
     uint8_t *index_table0;
@@ -44,6 +46,8 @@ EbErrorType motion_estimation_context_ctor(EbThreadContext   *thread_context_ptr
                                            const EbEncHandle *enc_handle_ptr, int index);
 
 extern void *motion_estimation_kernel(void *input_ptr);
+extern void motion_estimation_process_task(EbThreadContext *thread_context_ptr,
+                                           EbObjectWrapper *in_results_wrapper_ptr);
 
 EbErrorType signal_derivation_me_kernel_oq(SequenceControlSet        *scs_ptr,
                                            PictureParentControlSet   *pcs_ptr,
@@ -9,6 +9,7 @@
 * PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
 */
 #include <stdlib.h>
+#include <math.h>
 
 #include "EbEncHandle.h"
 #include "EbPacketizationProcess.h"
@@ -424,6 +425,125 @@ static EbErrorType realloc_output_bitstream(Bitstream *bitstream_ptr, uint32_t s
     }
     return EB_ErrorNone;
 }
+static double get_psnr(uint64_t sse, double max_sse) {
+    return 10 * log10(max_sse / (sse ? (double)sse : 0.1));
+}
+
+/* Per 4x4 block statistics of the coded picture, from the final mode info */
+static void get_block_stats(PictureControlSet *pcs_ptr, SvtAv1FrameStats *frame_stats) {
+    const Av1Common *const cm          = pcs_ptr->parent_pcs_ptr->av1_cm;
+    uint64_t               intra_count = 0, inter_count = 0, skip_count = 0;
+    double                 mv_sum      = 0;
+
+    for (int32_t mi_row = 0; mi_row < cm->mi_rows; mi_row++) {
+        ModeInfo **mi_row_ptr = pcs_ptr->mi_grid_base + mi_row * pcs_ptr->mi_stride;
+        for (int32_t mi_col = 0; mi_col < cm->mi_cols; mi_col++) {
+            const BlockModeInfoEnc *block_mi = &mi_row_ptr[mi_col]->mbmi.block_mi;
+            skip_count += block_mi->skip;
+            if (block_mi->ref_frame[0] <= INTRA_FRAME || block_mi->use_intrabc) {
+                intra_count++;
+                continue;
+            }
+            inter_count++;
+            const MV *mv     = &block_mi->mv[0].as_mv;
+            double    length = sqrt((double)mv->row * mv->row + (double)mv->col * mv->col);
+            if (block_mi->ref_frame[1] > INTRA_FRAME) {
+                mv = &block_mi->mv[1].as_mv;
+                length += sqrt((double)mv->row * mv->row + (double)mv->col * mv->col);
+                length /= 2;
+            }
+            mv_sum += length;
+        }
+    }
+    const double area             = (double)cm->mi_rows * cm->mi_cols;
+    frame_stats->intra_ratio      = intra_count / area;
+    frame_stats->inter_ratio      = inter_count / area;
+    frame_stats->skip_ratio       = skip_count / area;
+    frame_stats->avg_mv_magnitude = inter_count ? mv_sum / inter_count / 8 : 0;
+}
+
+/* Wall-clock time between the hand-offs of the picture, a hand-off that was
+ * not reached (superres recode) counts as a zero length stage */
+static void get_stage_times(PictureParentControlSet *ppcs_ptr, SvtAv1FrameStats *frame_stats) {
+    const uint64_t stage_end[5] = {ppcs_ptr->me_done_time,
+                                   ppcs_ptr->rc_done_time,
+                                   ppcs_ptr->enc_dec_done_time,
+                                   ppcs_ptr->rest_done_time,
+                                   svt_av1_get_time_us()};
+    uint64_t       stage_time[5];
+    uint64_t       prev_time = ppcs_ptr->start_time_seconds * 1000000 +
+        ppcs_ptr->start_time_u_seconds;
+    for (int i = 0; i < 5; i++) {
+        const uint64_t end_time = MAX(stage_end[i], prev_time);
+        stage_time[i]           = end_time - prev_time;
+        prev_time               = end_time;
+    }
+    frame_stats->analysis_time_us  = stage_time[0];
+    frame_stats->lookahead_time_us = stage_time[1];
+    frame_stats->encode_time_us    = stage_time[2];
+    frame_stats->filter_time_us    = stage_time[3];
+    frame_stats->entropy_time_us   = stage_time[4];
+}
+
+/* Lookahead analysis of the source picture, the statistics of lookahead_only */
+static void get_lookahead_stats(PictureParentControlSet *ppcs_ptr, SvtAv1FrameStats *frame_stats) {
+    uint64_t me_sad = 0;
+    if (ppcs_ptr->slice_type != I_SLICE)
+        for (uint32_t sb_index = 0; sb_index < ppcs_ptr->sb_total_count; sb_index++)
+            me_sad += ppcs_ptr->rc_me_distortion[sb_index];
+    frame_stats->scene_change = ppcs_ptr->scene_change_flag || ppcs_ptr->scene_transition_detected;
+    frame_stats->variance     = ppcs_ptr->pic_avg_variance;
+    frame_stats->me_sad       = me_sad;
+    frame_stats->tpl_r0       = ppcs_ptr->tpl_ctrls.enable ? ppcs_ptr->r0 : 0;
+    frame_stats->tpl_beta     = ppcs_ptr->tpl_ctrls.enable ? ppcs_ptr->tpl_avg_beta : 1;
+}
+
+/*********************************************************************
+ * fill_frame_stats
+ *   Statistics of the coded picture for enable_frame_stats, frame_size
+ *   is the size of the frame OBUs.  With lookahead_only nothing was
+ *   coded, only the lookahead statistics are set.
+ *********************************************************************/
+static void fill_frame_stats(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr,
+                             SvtAv1FrameStats *frame_stats, uint32_t frame_size) {
+    PictureParentControlSet *ppcs_ptr = pcs_ptr->parent_pcs_ptr;
+    Av1Common *const         cm       = ppcs_ptr->av1_cm;
+
+    frame_stats->picture_number       = ppcs_ptr->picture_number;
+    frame_stats->temporal_layer_index = ppcs_ptr->temporal_layer_index;
+    frame_stats->qindex               = ppcs_ptr->frm_hdr.quantization_params.base_q_idx;
+    get_lookahead_stats(ppcs_ptr, frame_stats);
+    get_stage_times(ppcs_ptr, frame_stats);
+    if (scs_ptr->static_config.lookahead_only) {
+        frame_stats->tile_count = 0;
+        return;
+    }
+    frame_stats->frame_size = frame_size;
+    if (scs_ptr->static_config.stat_report) {
+        // Same area as the sse of psnr_calculations
+        const uint32_t width  = scs_ptr->max_input_luma_width - scs_ptr->max_input_pad_right;
+        const uint32_t height = scs_ptr->max_input_luma_height - scs_ptr->max_input_pad_bottom;
+        const double   max_value = (double)((1 << scs_ptr->static_config.encoder_bit_depth) - 1);
+        const double   max_sse   = max_value * max_value * width * height;
+        const double   max_chroma_sse = max_value * max_value * (width >> scs_ptr->subsampling_x) *
+            (height >> scs_ptr->subsampling_y);
+        frame_stats->psnr[0] = get_psnr(ppcs_ptr->luma_sse, max_sse);
+        frame_stats->psnr[1] = get_psnr(ppcs_ptr->cb_sse, max_chroma_sse);
+        frame_stats->psnr[2] = get_psnr(ppcs_ptr->cr_sse, max_chroma_sse);
+        frame_stats->ssim[0] = ppcs_ptr->luma_ssim;
+        frame_stats->ssim[1] = ppcs_ptr->cb_ssim;
+        frame_stats->ssim[2] = ppcs_ptr->cr_ssim;
+    } else {
+        memset(frame_stats->psnr, 0, sizeof(frame_stats->psnr));
+        memset(frame_stats->ssim, 0, sizeof(frame_stats->ssim));
+    }
+    frame_stats->tile_count = cm->tiles_info.tile_rows * cm->tiles_info.tile_cols;
+    for (uint32_t tile_idx = 0; tile_idx < frame_stats->tile_count; tile_idx++)
+        frame_stats->tile_size[tile_idx] =
+            pcs_ptr->entropy_coding_info[tile_idx]->entropy_coder_ptr->ec_writer.pos;
+    get_block_stats(pcs_ptr, frame_stats);
+}
+
 void *packetization_kernel(void *input_ptr) {
     // Context
     EbThreadContext      *thread_context_ptr = (EbThreadContext *)input_ptr;
@@ -812,6 +932,9 @@ void *packetization_kernel(void *input_ptr) {
         assert(output_stream_ptr->p_buffer != NULL && "bit-stream memory allocation failure");
 
         copy_data_from_bitstream(encode_context_ptr, pcs_ptr->bitstream_ptr, output_stream_ptr);
+        if (output_stream_ptr->frame_stats)
+            fill_frame_stats(
+                pcs_ptr, scs_ptr, output_stream_ptr->frame_stats, output_stream_ptr->n_filled_len);
 
         if (pcs_ptr->parent_pcs_ptr->has_show_existing) {
             uint64_t                   next_picture_number = pcs_ptr->picture_number + 1;
@@ -62,11 +62,14 @@ typedef struct PictureAnalysisContext {
     EB_ALIGN(64) uint8_t local_cache[64];
     EbFifo *resource_coordination_results_input_fifo_ptr;
     EbFifo *picture_analysis_results_output_fifo_ptr;
+    // Film grain denoiser, allocated on first use and kept until the picture size changes
+    AomDenoiseAndModel *denoise_and_model;
 } PictureAnalysisContext;
 
 static void picture_analysis_context_dctor(EbPtr p) {
     EbThreadContext        *thread_context_ptr = (EbThreadContext *)p;
     PictureAnalysisContext *obj                = (PictureAnalysisContext *)thread_context_ptr->priv;
+    EB_DELETE(obj->denoise_and_model);
     EB_FREE_ARRAY(obj);
 }
 /************************************************
@@ -1920,31 +1923,39 @@ EbErrorType compute_block_mean_compute_variance(
 }
 
 static int32_t apply_denoise_2d(SequenceControlSet *scs_ptr, PictureParentControlSet *pcs_ptr,
-                                EbPictureBufferDesc *inputPicturePointer) {
-    AomDenoiseAndModel     *denoise_and_model;
-    DenoiseAndModelInitData fg_init_data;
-    fg_init_data.encoder_bit_depth    = pcs_ptr->enhanced_picture_ptr->bit_depth;
-    fg_init_data.encoder_color_format = pcs_ptr->enhanced_picture_ptr->color_format;
-    fg_init_data.noise_level          = scs_ptr->static_config.film_grain_denoise_strength;
-    fg_init_data.width                = pcs_ptr->enhanced_picture_ptr->width;
-    fg_init_data.height               = pcs_ptr->enhanced_picture_ptr->height;
-    fg_init_data.stride_y             = pcs_ptr->enhanced_picture_ptr->stride_y;
-    fg_init_data.stride_cb            = pcs_ptr->enhanced_picture_ptr->stride_cb;
-    fg_init_data.stride_cr            = pcs_ptr->enhanced_picture_ptr->stride_cr;
-    EB_NEW(denoise_and_model, denoise_and_model_ctor, (EbPtr)&fg_init_data);
-
-    if (svt_aom_denoise_and_model_run(denoise_and_model,
+                                EbPictureBufferDesc *inputPicturePointer,
+                                AomDenoiseAndModel **denoise_and_model) {
+    EbPictureBufferDesc *enhanced_picture_ptr = pcs_ptr->enhanced_picture_ptr;
+    if (*denoise_and_model &&
+        ((*denoise_and_model)->width != enhanced_picture_ptr->width ||
+         (*denoise_and_model)->height != enhanced_picture_ptr->height ||
+         (*denoise_and_model)->y_stride != enhanced_picture_ptr->stride_y ||
+         (*denoise_and_model)->uv_stride != enhanced_picture_ptr->stride_cb))
+        EB_DELETE(*denoise_and_model);
+    if (!*denoise_and_model) {
+        DenoiseAndModelInitData fg_init_data;
+        fg_init_data.encoder_bit_depth    = enhanced_picture_ptr->bit_depth;
+        fg_init_data.encoder_color_format = enhanced_picture_ptr->color_format;
+        fg_init_data.noise_level          = scs_ptr->static_config.film_grain_denoise_strength;
+        fg_init_data.width                = enhanced_picture_ptr->width;
+        fg_init_data.height               = enhanced_picture_ptr->height;
+        fg_init_data.stride_y             = enhanced_picture_ptr->stride_y;
+        fg_init_data.stride_cb            = enhanced_picture_ptr->stride_cb;
+        fg_init_data.stride_cr            = enhanced_picture_ptr->stride_cr;
+        EB_NEW(*denoise_and_model, denoise_and_model_ctor, (EbPtr)&fg_init_data);
+    }
+
+    if (svt_aom_denoise_and_model_run(*denoise_and_model,
                                       inputPicturePointer,
                                       &pcs_ptr->frm_hdr.film_grain_params,
                                       scs_ptr->static_config.encoder_bit_depth > EB_8BIT)) {}
 
-    EB_DELETE(denoise_and_model);
-
     return 0;
 }
 
 EbErrorType denoise_estimate_film_grain(SequenceControlSet      *scs_ptr,
-                                        PictureParentControlSet *pcs_ptr) {
+                                        PictureParentControlSet *pcs_ptr,
+                                        AomDenoiseAndModel     **denoise_and_model) {
     EbErrorType return_error = EB_ErrorNone;
 
     FrameHeader *frm_hdr = &pcs_ptr->frm_hdr;
@@ -1953,7 +1964,7 @@ EbErrorType denoise_estimate_film_grain(SequenceControlSet      *scs_ptr,
     frm_hdr->film_grain_params.apply_grain = 0;
 
     if (scs_ptr->static_config.film_grain_denoise_strength) {
-        if (apply_denoise_2d(scs_ptr, pcs_ptr, input_picture_ptr) < 0)
+        if (apply_denoise_2d(scs_ptr, pcs_ptr, input_picture_ptr, denoise_and_model) < 0)
             return 1;
     }
 
@@ -1971,9 +1982,10 @@ EbErrorType denoise_estimate_film_grain(SequenceControlSet      *scs_ptr,
  ***** Denoising
  ************************************************/
 void picture_pre_processing_operations(PictureParentControlSet *pcs_ptr,
-                                       SequenceControlSet      *scs_ptr) {
+                                       SequenceControlSet      *scs_ptr,
+                                       AomDenoiseAndModel     **denoise_and_model) {
     if (scs_ptr->static_config.film_grain_denoise_strength)
-        denoise_estimate_film_grain(scs_ptr, pcs_ptr);
+        denoise_estimate_film_grain(scs_ptr, pcs_ptr, denoise_and_model);
     return;
 }
 
@@ -2897,6 +2909,137 @@ void pad_input_pictures(SequenceControlSet *scs_ptr, EbPictureBufferDesc *input_
 
 /* Picture Analysis Kernel */
 
+/******************************************************
+ * Picture Analysis Task
+ *   Analyses one Resource Coordination result
+ ******************************************************/
+void picture_analysis_process_task(EbThreadContext *thread_context_ptr,
+                                   EbObjectWrapper *in_results_wrapper_ptr) {
+    PictureAnalysisContext  *context_ptr = (PictureAnalysisContext *)thread_context_ptr->priv;
+    PictureParentControlSet *pcs_ptr;
+    SequenceControlSet      *scs_ptr;
+
+    ResourceCoordinationResults *in_results_ptr;
+    EbObjectWrapper             *out_results_wrapper_ptr;
+    EbPaReferenceObject         *pa_ref_obj_;
+
+    EbPictureBufferDesc *input_padded_picture_ptr;
+    EbPictureBufferDesc *input_picture_ptr;
+
+    in_results_ptr = (ResourceCoordinationResults *)in_results_wrapper_ptr->object_ptr;
+    pcs_ptr        = (PictureParentControlSet *)in_results_ptr->pcs_wrapper_ptr->object_ptr;
+    scs_ptr        = (SequenceControlSet *)pcs_ptr->scs_wrapper_ptr->object_ptr;
+
+    // Mariana : save enhanced picture ptr, move this from here
+    pcs_ptr->enhanced_unscaled_picture_ptr                    = pcs_ptr->enhanced_picture_ptr;
+    pcs_ptr->enhanced_unscaled_picture_ptr->is_16bit_pipeline = scs_ptr->is_16bit_pipeline;
+
+    // There is no need to do processing for overlay picture. Overlay and AltRef share the same results.
+    if (!pcs_ptr->is_overlay) {
+        input_picture_ptr = pcs_ptr->enhanced_picture_ptr;
+        int copy_frame    = 1;
+        if (pcs_ptr->scs_ptr->ipp_pass_ctrls.skip_frame_first_pass == 1)
+            copy_frame = (((pcs_ptr->picture_number % 8) == 0) ||
+                          ((pcs_ptr->picture_number % 8) == 6) ||
+                          ((pcs_ptr->picture_number % 8) == 7));
+        else if (pcs_ptr->scs_ptr->ipp_pass_ctrls.skip_frame_first_pass == 2)
+            copy_frame = ((pcs_ptr->picture_number < 7) ||
+                          ((pcs_ptr->picture_number % 8) == 0) ||
+                          ((pcs_ptr->picture_number % 8) == 6) ||
+                          ((pcs_ptr->picture_number % 8) == 7));
+        // Bypass copy for the unecessary picture in IPPP pass
+        if (scs_ptr->static_config.pass != ENC_FIRST_PASS || copy_frame) {
+            // Padding for input pictures
+            pad_input_pictures(scs_ptr, input_picture_ptr);
+
+            // Pre processing operations performed on the input picture
+            picture_pre_processing_operations(pcs_ptr, scs_ptr, &context_ptr->denoise_and_model);
+
+            if (input_picture_ptr->color_format >= EB_YUV422) {
+                // Jing: Do the conversion of 422/444=>420 here since it's multi-threaded kernel
+                //       Reuse the Y, only add cb/cr in the newly created buffer desc
+                //       NOTE: since denoise may change the src, so this part is after picture_pre_processing_operations()
+                pcs_ptr->chroma_downsampled_picture_ptr->buffer_y = input_picture_ptr->buffer_y;
+                down_sample_chroma(input_picture_ptr, pcs_ptr->chroma_downsampled_picture_ptr);
+            } else
+                pcs_ptr->chroma_downsampled_picture_ptr = input_picture_ptr;
+
+            //not passing through the DS pool, so 1/4 and 1/16 are not used
+            pcs_ptr->ds_pics.picture_ptr           = input_picture_ptr;
+            pcs_ptr->ds_pics.quarter_picture_ptr   = NULL;
+            pcs_ptr->ds_pics.sixteenth_picture_ptr = NULL;
+            pcs_ptr->ds_pics.picture_number        = pcs_ptr->picture_number;
+
+            // Original path
+            // Get PA ref, copy 8bit luma to pa_ref->input_padded_picture_ptr
+            pa_ref_obj_ = (EbPaReferenceObject *)
+                              pcs_ptr->pa_reference_picture_wrapper_ptr->object_ptr;
+            pa_ref_obj_->picture_number = pcs_ptr->picture_number;
+            input_padded_picture_ptr    = (EbPictureBufferDesc *)
+                                           pa_ref_obj_->input_padded_picture_ptr;
+
+            // 1/4 & 1/16 input picture downsampling through filtering
+            if (scs_ptr->down_sampling_method_me_search == ME_FILTERED_DOWNSAMPLED) {
+                downsample_filtering_input_picture(
+                    pcs_ptr,
+                    input_padded_picture_ptr,
+                    (EbPictureBufferDesc *)pa_ref_obj_->quarter_downsampled_picture_ptr,
+                    (EbPictureBufferDesc *)pa_ref_obj_->sixteenth_downsampled_picture_ptr);
+            } else {
+                downsample_decimation_input_picture(
+                    pcs_ptr,
+                    input_padded_picture_ptr,
+                    (EbPictureBufferDesc *)pa_ref_obj_->quarter_downsampled_picture_ptr,
+                    (EbPictureBufferDesc *)pa_ref_obj_->sixteenth_downsampled_picture_ptr);
+            }
+
+            pcs_ptr->ds_pics.quarter_picture_ptr = pa_ref_obj_->quarter_downsampled_picture_ptr;
+            pcs_ptr->ds_pics.sixteenth_picture_ptr =
+                pa_ref_obj_->sixteenth_downsampled_picture_ptr;
+        }
+        // Gathering statistics of input picture, including Variance Calculation, Histogram Bins
+        if (scs_ptr->static_config.pass != ENC_FIRST_PASS)
+            gathering_picture_statistics(
+                scs_ptr,
+                pcs_ptr,
+#if !FIX_SCD
+                pcs_ptr->chroma_downsampled_picture_ptr, //420 input_picture_ptr
+#endif
+                input_padded_picture_ptr,
+                (EbPictureBufferDesc *)pa_ref_obj_->sixteenth_downsampled_picture_ptr,
+                pcs_ptr->sb_total_count);
+
+        // If running multi-threaded mode, perform SC detection in picture_analysis_kernel, else in picture_decision_kernel
+        if (scs_ptr->static_config.logical_processors != 1) {
+            if ((scs_ptr->static_config.pass != ENC_FIRST_PASS || copy_frame) == 0) {
+                pcs_ptr->sc_class0 = pcs_ptr->sc_class1 = pcs_ptr->sc_class2 = 0;
+            } else if (scs_ptr->static_config.screen_content_mode == 2) { // auto detect
+                // SC Detection is OFF for 4K and higher
+                if (scs_ptr->input_resolution <= INPUT_SIZE_1080p_RANGE)
+                    is_screen_content(pcs_ptr);
+                else
+                    pcs_ptr->sc_class0 = pcs_ptr->sc_class1 = pcs_ptr->sc_class2 = 0;
+
+            } else // off / on
+                pcs_ptr->sc_class0 = pcs_ptr->sc_class1 = pcs_ptr->sc_class2 =
+                    scs_ptr->static_config.screen_content_mode;
+        }
+    }
+    // Get Empty Results Object
+    svt_get_empty_object(context_ptr->picture_analysis_results_output_fifo_ptr,
+                         &out_results_wrapper_ptr);
+
+    PictureAnalysisResults *out_results_ptr = (PictureAnalysisResults *)
+                                                  out_results_wrapper_ptr->object_ptr;
+    out_results_ptr->pcs_wrapper_ptr = in_results_ptr->pcs_wrapper_ptr;
+
+    // Release the Input Results
+    svt_release_object(in_results_wrapper_ptr);
+
+    // Post the Full Results Object
+    svt_post_full_object(out_results_wrapper_ptr);
+}
+
 /*********************************************************************************
 *
 * @brief
@@ -2919,136 +3062,16 @@ void pad_input_pictures(SequenceControlSet *scs_ptr, EbPictureBufferDesc *input_
 *
 ********************************************************************************/
 void *picture_analysis_kernel(void *input_ptr) {
-    EbThreadContext         *thread_context_ptr = (EbThreadContext *)input_ptr;
-    PictureAnalysisContext  *context_ptr = (PictureAnalysisContext *)thread_context_ptr->priv;
-    PictureParentControlSet *pcs_ptr;
-    SequenceControlSet      *scs_ptr;
-
-    EbObjectWrapper             *in_results_wrapper_ptr;
-    ResourceCoordinationResults *in_results_ptr;
-    EbObjectWrapper             *out_results_wrapper_ptr;
-    EbPaReferenceObject         *pa_ref_obj_;
-
-    EbPictureBufferDesc *input_padded_picture_ptr;
-    EbPictureBufferDesc *input_picture_ptr;
+    EbThreadContext        *thread_context_ptr = (EbThreadContext *)input_ptr;
+    PictureAnalysisContext *context_ptr        = (PictureAnalysisContext *)thread_context_ptr->priv;
+    EbObjectWrapper        *in_results_wrapper_ptr;
 
     for (;;) {
         // Get Input Full Object
         EB_GET_FULL_OBJECT(context_ptr->resource_coordination_results_input_fifo_ptr,
                            &in_results_wrapper_ptr);
-
-        in_results_ptr = (ResourceCoordinationResults *)in_results_wrapper_ptr->object_ptr;
-        pcs_ptr        = (PictureParentControlSet *)in_results_ptr->pcs_wrapper_ptr->object_ptr;
-        scs_ptr        = (SequenceControlSet *)pcs_ptr->scs_wrapper_ptr->object_ptr;
-
-        // Mariana : save enhanced picture ptr, move this from here
-        pcs_ptr->enhanced_unscaled_picture_ptr                    = pcs_ptr->enhanced_picture_ptr;
-        pcs_ptr->enhanced_unscaled_picture_ptr->is_16bit_pipeline = scs_ptr->is_16bit_pipeline;
-
-        // There is no need to do processing for overlay picture. Overlay and AltRef share the same results.
-        if (!pcs_ptr->is_overlay) {
-            input_picture_ptr = pcs_ptr->enhanced_picture_ptr;
-            int copy_frame    = 1;
-            if (pcs_ptr->scs_ptr->ipp_pass_ctrls.skip_frame_first_pass == 1)
-                copy_frame = (((pcs_ptr->picture_number % 8) == 0) ||
-                              ((pcs_ptr->picture_number % 8) == 6) ||
-                              ((pcs_ptr->picture_number % 8) == 7));
-            else if (pcs_ptr->scs_ptr->ipp_pass_ctrls.skip_frame_first_pass == 2)
-                copy_frame = ((pcs_ptr->picture_number < 7) ||
-                              ((pcs_ptr->picture_number % 8) == 0) ||
-                              ((pcs_ptr->picture_number % 8) == 6) ||
-                              ((pcs_ptr->picture_number % 8) == 7));
-            // Bypass copy for the unecessary picture in IPPP pass
-            if (scs_ptr->static_config.pass != ENC_FIRST_PASS || copy_frame) {
-                // Padding for input pictures
-                pad_input_pictures(scs_ptr, input_picture_ptr);
-
-                // Pre processing operations performed on the input picture
-                picture_pre_processing_operations(pcs_ptr, scs_ptr);
-
-                if (input_picture_ptr->color_format >= EB_YUV422) {
-                    // Jing: Do the conversion of 422/444=>420 here since it's multi-threaded kernel
-                    //       Reuse the Y, only add cb/cr in the newly created buffer desc
-                    //       NOTE: since denoise may change the src, so this part is after picture_pre_processing_operations()
-                    pcs_ptr->chroma_downsampled_picture_ptr->buffer_y = input_picture_ptr->buffer_y;
-                    down_sample_chroma(input_picture_ptr, pcs_ptr->chroma_downsampled_picture_ptr);
-                } else
-                    pcs_ptr->chroma_downsampled_picture_ptr = input_picture_ptr;
-
-                //not passing through the DS pool, so 1/4 and 1/16 are not used
-                pcs_ptr->ds_pics.picture_ptr           = input_picture_ptr;
-                pcs_ptr->ds_pics.quarter_picture_ptr   = NULL;
-                pcs_ptr->ds_pics.sixteenth_picture_ptr = NULL;
-                pcs_ptr->ds_pics.picture_number        = pcs_ptr->picture_number;
-
-                // Original path
-                // Get PA ref, copy 8bit luma to pa_ref->input_padded_picture_ptr
-                pa_ref_obj_ = (EbPaReferenceObject *)
-                                  pcs_ptr->pa_reference_picture_wrapper_ptr->object_ptr;
-                pa_ref_obj_->picture_number = pcs_ptr->picture_number;
-                input_padded_picture_ptr    = (EbPictureBufferDesc *)
-                                               pa_ref_obj_->input_padded_picture_ptr;
-
-                // 1/4 & 1/16 input picture downsampling through filtering
-                if (scs_ptr->down_sampling_method_me_search == ME_FILTERED_DOWNSAMPLED) {
-                    downsample_filtering_input_picture(
-                        pcs_ptr,
-                        input_padded_picture_ptr,
-                        (EbPictureBufferDesc *)pa_ref_obj_->quarter_downsampled_picture_ptr,
-                        (EbPictureBufferDesc *)pa_ref_obj_->sixteenth_downsampled_picture_ptr);
-                } else {
-                    downsample_decimation_input_picture(
-                        pcs_ptr,
-                        input_padded_picture_ptr,
-                        (EbPictureBufferDesc *)pa_ref_obj_->quarter_downsampled_picture_ptr,
-                        (EbPictureBufferDesc *)pa_ref_obj_->sixteenth_downsampled_picture_ptr);
-                }
-
-                pcs_ptr->ds_pics.quarter_picture_ptr = pa_ref_obj_->quarter_downsampled_picture_ptr;
-                pcs_ptr->ds_pics.sixteenth_picture_ptr =
-                    pa_ref_obj_->sixteenth_downsampled_picture_ptr;
-            }
-            // Gathering statistics of input picture, including Variance Calculation, Histogram Bins
-            if (scs_ptr->static_config.pass != ENC_FIRST_PASS)
-                gathering_picture_statistics(
-                    scs_ptr,
-                    pcs_ptr,
-#if !FIX_SCD
-                    pcs_ptr->chroma_downsampled_picture_ptr, //420 input_picture_ptr
-#endif
-                    input_padded_picture_ptr,
-                    (EbPictureBufferDesc *)pa_ref_obj_->sixteenth_downsampled_picture_ptr,
-                    pcs_ptr->sb_total_count);
-
-            // If running multi-threaded mode, perform SC detection in picture_analysis_kernel, else in picture_decision_kernel
-            if (scs_ptr->static_config.logical_processors != 1) {
-                if ((scs_ptr->static_config.pass != ENC_FIRST_PASS || copy_frame) == 0) {
-                    pcs_ptr->sc_class0 = pcs_ptr->sc_class1 = pcs_ptr->sc_class2 = 0;
-                } else if (scs_ptr->static_config.screen_content_mode == 2) { // auto detect
-                    // SC Detection is OFF for 4K and higher
-                    if (scs_ptr->input_resolution <= INPUT_SIZE_1080p_RANGE)
-                        is_screen_content(pcs_ptr);
-                    else
-                        pcs_ptr->sc_class0 = pcs_ptr->sc_class1 = pcs_ptr->sc_class2 = 0;
-
-                } else // off / on
-                    pcs_ptr->sc_class0 = pcs_ptr->sc_class1 = pcs_ptr->sc_class2 =
-                        scs_ptr->static_config.screen_content_mode;
-            }
-        }
-        // Get Empty Results Object
-        svt_get_empty_object(context_ptr->picture_analysis_results_output_fifo_ptr,
-                             &out_results_wrapper_ptr);
-
-        PictureAnalysisResults *out_results_ptr = (PictureAnalysisResults *)
-                                                      out_results_wrapper_ptr->object_ptr;
-        out_results_ptr->pcs_wrapper_ptr = in_results_ptr->pcs_wrapper_ptr;
-
-        // Release the Input Results
-        svt_release_object(in_results_wrapper_ptr);
-
-        // Post the Full Results Object
-        svt_post_full_object(out_results_wrapper_ptr);
+        picture_analysis_process_task(thread_context_ptr, in_results_wrapper_ptr);
     }
+
     return NULL;
 }
@@ -24,6 +24,8 @@ EbErrorType picture_analysis_context_ctor(EbThreadContext   *thread_context_ptr,
                                           const EbEncHandle *enc_handle_ptr, int index);
 
 extern void *picture_analysis_kernel(void *input_ptr);
+extern void picture_analysis_process_task(EbThreadContext *thread_context_ptr,
+                                          EbObjectWrapper *in_results_wrapper_ptr);
 
 void downsample_filtering_input_picture(PictureParentControlSet *pcs_ptr,
                                         EbPictureBufferDesc     *input_padded_picture_ptr,
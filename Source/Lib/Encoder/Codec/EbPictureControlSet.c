@@ -141,6 +141,7 @@ void picture_control_set_dctor(EbPtr p) {
     EB_FREE_ALIGNED_ARRAY(obj->tpl_mvs);
     EB_FREE_ALIGNED(obj->rst_tmpbuf);
     EB_DELETE_PTR_ARRAY(obj->enc_dec_segment_ctrl, tile_cnt);
+    EB_DELETE(obj->dlf_segment_ctrl);
     EB_DELETE_PTR_ARRAY(obj->ep_intra_luma_mode_neighbor_array, tile_cnt);
     EB_DELETE_PTR_ARRAY(obj->ep_intra_chroma_mode_neighbor_array, tile_cnt);
     EB_DELETE_PTR_ARRAY(obj->ep_mv_neighbor_array, tile_cnt);
@@ -207,6 +208,7 @@ void picture_control_set_dctor(EbPtr p) {
     EB_FREE_ARRAY(obj->sb_intra);
     EB_FREE_ARRAY(obj->sb_skip);
     EB_FREE_ARRAY(obj->sb_64x64_mvp);
+    EB_FREE_ARRAY(obj->sb_src_hash);
     EB_FREE_ARRAY(obj->sb_count_nz_coeffs);
     EB_DELETE(obj->bitstream_ptr);
     EB_DELETE_PTR_ARRAY(obj->entropy_coding_info, tile_cnt);
@@ -228,12 +230,16 @@ void picture_control_set_dctor(EbPtr p) {
     EB_FREE_ARRAY(obj->mse_seg[1]);
     EB_FREE_ARRAY(obj->skip_cdef_seg);
     EB_FREE_ARRAY(obj->cdef_dir_data);
+    EB_FREE_ARRAY(obj->dlf_sb_row_filtered_count);
+    EB_FREE_ARRAY(obj->ec_sb_row_ready_count);
     EB_FREE_ARRAY(obj->mi_grid_base);
     EB_FREE_ARRAY(obj->mip);
     EB_FREE_ARRAY(obj->md_rate_estimation_array);
+    EB_FREE_ARRAY(obj->md_rate_estimation_cache);
     EB_DESTROY_MUTEX(obj->entropy_coding_pic_mutex);
     EB_DESTROY_MUTEX(obj->intra_mutex);
     EB_DESTROY_MUTEX(obj->cdef_search_mutex);
+    EB_DESTROY_MUTEX(obj->dlf_mutex);
     EB_DESTROY_MUTEX(obj->rest_search_mutex);
 }
 // Token buffer is only used for palette tokens.
@@ -543,6 +549,7 @@ EbErrorType picture_control_set_ctor(PictureControlSet *object_ptr, EbPtr object
     EB_MALLOC_ARRAY(object_ptr->sb_intra, object_ptr->sb_total_count);
     EB_MALLOC_ARRAY(object_ptr->sb_skip, object_ptr->sb_total_count);
     EB_MALLOC_ARRAY(object_ptr->sb_64x64_mvp, object_ptr->sb_total_count);
+    EB_CALLOC_ARRAY(object_ptr->sb_src_hash, object_ptr->sb_total_count);
 
     sb_origin_x = 0;
     sb_origin_y = 0;
@@ -576,6 +583,7 @@ EbErrorType picture_control_set_ctor(PictureControlSet *object_ptr, EbPtr object
     // MD Rate Estimation Array
     EB_MALLOC_ARRAY(object_ptr->md_rate_estimation_array, 1);
     memset(object_ptr->md_rate_estimation_array, 0, sizeof(MdRateEstimationContext));
+    EB_CALLOC_ARRAY(object_ptr->md_rate_estimation_cache, 1);
     if (init_data_ptr->hbd_mode_decision == DEFAULT)
         object_ptr->hbd_mode_decision = init_data_ptr->hbd_mode_decision = 2;
     else
@@ -1192,6 +1200,7 @@ EbErrorType picture_control_set_ctor(PictureControlSet *object_ptr, EbPtr object
            init_data_ptr->picture_height);
     // Segments
     object_ptr->enc_dec_coded_sb_count = 0;
+    object_ptr->sb_row_recode_sb_count = 0;
 
     EB_MALLOC_ARRAY(object_ptr->enc_dec_segment_ctrl, total_tile_cnt);
 
@@ -1201,9 +1210,19 @@ EbErrorType picture_control_set_ctor(PictureControlSet *object_ptr, EbPtr object
                init_data_ptr->enc_dec_segment_col,
                init_data_ptr->enc_dec_segment_row);
     }
+    // DLF segments cover the whole picture, regardless of the tile groups
+    EB_NEW(object_ptr->dlf_segment_ctrl,
+           enc_dec_segments_ctor,
+           init_data_ptr->enc_dec_segment_col,
+           init_data_ptr->enc_dec_segment_row);
+    EB_MALLOC_ARRAY(object_ptr->dlf_sb_row_filtered_count, picture_sb_height);
+    EB_CREATE_MUTEX(object_ptr->dlf_mutex);
 
     // Entropy Rows
     EB_CREATE_MUTEX(object_ptr->entropy_coding_pic_mutex);
+    EB_MALLOC_ARRAY(object_ptr->ec_sb_row_ready_count,
+                    picture_sb_height * init_data_ptr->tile_column_count);
+    object_ptr->ec_sb_row_pipeline = FALSE;
 
     EB_CREATE_MUTEX(object_ptr->intra_mutex);
 
@@ -1297,6 +1316,8 @@ static void picture_parent_control_set_dctor(EbPtr ptr) {
 
     if (obj->variance)
         EB_FREE_2D(obj->variance);
+    EB_FREE_ARRAY(obj->roi_seg_map);
+    EB_FREE_ARRAY(obj->roi_skip_map);
 
     if (obj->picture_histogram) {
         for (int region_in_picture_width_index = 0;
@@ -1353,6 +1374,7 @@ static void picture_parent_control_set_dctor(EbPtr ptr) {
 
     EB_FREE_ARRAY(obj->av1x);
     EB_DESTROY_MUTEX(obj->me_processed_b64_mutex);
+    EB_DESTROY_SEMAPHORE(obj->gm_search_done_semaphore);
     EB_DESTROY_SEMAPHORE(obj->temp_filt_done_semaphore);
     EB_DESTROY_MUTEX(obj->temp_filt_mutex);
     EB_DESTROY_MUTEX(obj->debug_mutex);
@@ -1435,6 +1457,11 @@ EbErrorType picture_parent_control_set_ctor(PictureParentControlSet *object_ptr,
             block_count = 1;
         EB_MALLOC_2D(object_ptr->variance, object_ptr->sb_total_count, block_count);
     }
+    object_ptr->roi_map_present = FALSE;
+    if (init_data_ptr->enable_roi_map) {
+        EB_MALLOC_ARRAY(object_ptr->roi_seg_map, object_ptr->sb_total_count);
+        EB_MALLOC_ARRAY(object_ptr->roi_skip_map, object_ptr->sb_total_count);
+    }
 
 
 #if FIX_SCD
@@ -1482,7 +1509,8 @@ EbErrorType picture_parent_control_set_ctor(PictureParentControlSet *object_ptr,
         EB_MALLOC_ARRAY(object_ptr->firstpass_data.raw_motion_err_list,
                         (uint32_t)(picture_width_in_mb * picture_height_in_mb));
     }
-    object_ptr->r0 = 0;
+    object_ptr->r0           = 0;
+    object_ptr->tpl_avg_beta = 1;
 
     EB_MALLOC_ARRAY(object_ptr->rc_me_distortion, object_ptr->sb_total_count);
     EB_MALLOC_ARRAY(object_ptr->stationary_block_present_sb, object_ptr->sb_total_count);
@@ -1495,6 +1523,7 @@ EbErrorType picture_parent_control_set_ctor(PictureParentControlSet *object_ptr,
     EB_MALLOC_ARRAY(object_ptr->me_8x8_cost_variance, object_ptr->sb_total_count);
     // SB noise variance array
     EB_CREATE_MUTEX(object_ptr->me_processed_b64_mutex);
+    EB_CREATE_SEMAPHORE(object_ptr->gm_search_done_semaphore, 0, REF_LIST_MAX_DEPTH);
 #if !CLN_MD_CTX
     EB_MALLOC_ARRAY(object_ptr->sb_depth_mode_array, object_ptr->sb_total_count);
 #endif
@@ -1573,6 +1602,7 @@ EbErrorType picture_parent_control_set_ctor(PictureParentControlSet *object_ptr,
     memset(&object_ptr->superres_denom_array, 0, sizeof(object_ptr->superres_denom_array));
     // Loop variables
     object_ptr->loop_count      = 0;
+    object_ptr->sb_row_recode   = FALSE;
     object_ptr->overshoot_seen  = 0;
     object_ptr->undershoot_seen = 0;
     object_ptr->low_cr_seen     = 0;
@@ -272,11 +272,20 @@ typedef struct PictureControlSet {
     EbColorFormat    color_format;
     EncDecSegments **enc_dec_segment_ctrl;
     uint16_t         enc_dec_coded_sb_count;
+    // SB count coded when the remaining SB rows are held for the recode
+    // decision, 0 when there is no pending decision, see sb_row_recode_init
+    uint16_t         sb_row_recode_sb_count;
 
     // Entropy Process Rows
     EntropyTileInfo **entropy_coding_info;
     EbHandle          entropy_coding_pic_mutex;
     Bool            entropy_coding_pic_reset_flag;
+    // SB row pipeline: the SB rows of each tile are entropy coded by the EncDec
+    // threads as soon as they are final, see entropy_coding_sb_row_update
+    Bool              ec_sb_row_pipeline;
+    uint16_t         *ec_sb_row_ready_count; // coded SBs per SB row and tile column
+    uint32_t          ec_sb_rows_left; // SB rows of all the tile columns left to code
+    Bool              ec_enc_dec_done; // EncDec results wait for the last SB rows
     uint8_t           tile_size_bytes_minus_1;
     EbHandle          intra_mutex;
     uint32_t          intra_coded_area;
@@ -287,6 +296,13 @@ typedef struct PictureControlSet {
     uint16_t cdef_segments_total_count;
     uint8_t  cdef_segments_column_count;
     uint8_t  cdef_segments_row_count;
+    uint8_t  cdef_segments_row_posted; // cdef segment rows released to the cdef stage
+
+    // DLF segments
+    EncDecSegments *dlf_segment_ctrl;
+    EbHandle        dlf_mutex;
+    uint16_t       *dlf_sb_row_filtered_count; // filtered SBs per SB row
+    uint16_t        dlf_sb_rows_done; // number of fully filtered SB rows, from the top
 
     uint64_t (*mse_seg[2])[TOTAL_STRENGTHS];
     uint8_t     *skip_cdef_seg;
@@ -314,6 +330,7 @@ typedef struct PictureControlSet {
     uint8_t     *sb_intra;
     uint8_t     *sb_skip;
     uint8_t     *sb_64x64_mvp;
+    uint32_t    *sb_src_hash;
     uint32_t    *sb_count_nz_coeffs;
 
     // Mode Decision Neighbor Arrays
@@ -440,6 +457,8 @@ typedef struct PictureControlSet {
     FRAME_CONTEXT                   ref_frame_context[REF_FRAMES];
     EbWarpedMotionParams            ref_global_motion[TOTAL_REFS_PER_FRAME];
     struct MdRateEstimationContext *md_rate_estimation_array;
+    // CDFs md_rate_estimation_array was built from
+    struct MdRateEstimationCache *md_rate_estimation_cache;
     int8_t                          ref_frame_side[REF_FRAMES];
     TPL_MV_REF                     *tpl_mvs;
     uint8_t                         pic_filter_intra_level;
@@ -707,6 +726,8 @@ typedef struct PictureParentControlSet {
     Bool   idr_flag;
     Bool   cra_flag;
     Bool   scene_change_flag;
+    // The scene transition detector fired on this picture (vq scene_transition)
+    Bool   scene_transition_detected;
     Bool   transition_present;
     Bool   end_of_sequence_flag;
     uint8_t  picture_qp;
@@ -737,6 +758,12 @@ typedef struct PictureParentControlSet {
     uint64_t                                last_idr_picture;
     uint64_t                                start_time_seconds;
     uint64_t                                start_time_u_seconds;
+    // Time (in us) the picture leaves ME, RC, EncDec and restoration, only set
+    // with enable_frame_stats
+    uint64_t                                me_done_time;
+    uint64_t                                rc_done_time;
+    uint64_t                                enc_dec_done_time;
+    uint64_t                                rest_done_time;
     uint64_t                                luma_sse;
     uint64_t                                cr_sse;
     uint64_t                                cb_sse;
@@ -790,10 +817,14 @@ typedef struct PictureParentControlSet {
     EbWarpedMotionParams  global_motion_estimation[MAX_NUM_OF_REF_PIC_LIST][REF_LIST_MAX_DEPTH];
     uint16_t              me_processed_b64_count;
     EbHandle              me_processed_b64_mutex;
+    // posted by the GM search threads for each reference they searched
+    EbHandle              gm_search_done_semaphore;
     FirstPassData         firstpass_data;
     RefreshFrameFlagsInfo refresh_frame;
     double                ts_duration;
     double                r0;
+    // Average of the SB tpl_beta, kept once pa_me_data is released
+    double                tpl_avg_beta;
     uint8_t tpl_src_data_ready; //track pictures that are processd in two different TPL groups
     Bool  blk_lambda_tuning;
     // Dynamic GOP
@@ -989,6 +1020,19 @@ typedef struct PictureParentControlSet {
     uint8_t
            superres_denom_array[SCALE_NUMERATOR + 1]; // denom candidate array used in auto supreres
     double superres_rdcost[SCALE_NUMERATOR + 1]; // 9 slots, for denom 8 ~ 16
+    // SUPERRES_FIXED denominator set by svt_av1_enc_reconfigure(), 0 for the configured ones
+    uint8_t fixed_superres_denom;
+    // svt_av1_enc_reconfigure() changes starting with this picture, applied by the rate control
+    Bool              reconfig_present;
+    SvtAv1EncReconfig reconfig;
+    // ROI map of the picture as segments: roi_seg_map holds the segment of each 64x64 block and
+    // roi_seg_qp the qindex offset of each segment, roi_skip_map the static blocks
+    Bool     roi_map_present;
+    Bool     roi_skip_present;
+    uint8_t  roi_seg_count;
+    int16_t  roi_seg_qp[MAX_SEGMENTS];
+    uint8_t *roi_seg_map;
+    uint8_t *roi_skip_map;
 
     EbObjectWrapper      *me_data_wrapper_ptr;
     MotionEstimationData *pa_me_data;
@@ -1020,6 +1064,9 @@ typedef struct PictureParentControlSet {
     int                             q_low;
     int                             q_high;
     int                             loop_count;
+    // The recode loop adjusts the q of the remaining SB rows instead of
+    // recoding the picture
+    Bool                            sb_row_recode;
     int                             overshoot_seen;
     int                             undershoot_seen;
     int                             low_cr_seen;
@@ -1161,6 +1208,7 @@ typedef struct PictureControlSetInitData {
     uint8_t    ref_count_used_list1;
 
     uint8_t enable_adaptive_quantization;
+    Bool    enable_roi_map;
 
     uint8_t scene_change_detection;
     uint8_t tpl_lad_mg;
@@ -254,6 +254,7 @@ static void picture_decision_context_dctor(EbPtr p)
     EB_FREE_2D(obj->ahd_running_avg);
     EB_FREE_2D(obj->ahd_running_avg_cr);
     EB_FREE_2D(obj->ahd_running_avg_cb);
+    EB_DELETE(obj->denoise_and_model);
     EB_FREE_ARRAY(obj);
 }
 
@@ -2688,6 +2689,14 @@ EbErrorType signal_derivation_multi_processes_oq(
     if (scs_ptr->passes == 1 && scs_ptr->static_config.rate_control_mode == 1)
         pcs_ptr->adjust_under_shoot_gf = pcs_ptr->enc_mode <= ENC_M11 ? 1 : 2;
 #endif
+    // lookahead_only has no reconstruction to filter, and no mode decision to use IntraBC
+    if (scs_ptr->static_config.lookahead_only) {
+        frm_hdr->allow_intrabc = 0;
+        set_dlf_controls(pcs_ptr, 0, scs_ptr->static_config.encoder_bit_depth);
+        pcs_ptr->cdef_level = 0;
+        cm->sg_filter_mode  = 0;
+        set_wn_filter_ctrls(cm, 0);
+    }
     return return_error;
 }
 
@@ -5267,7 +5276,8 @@ static void av1_generate_rps_ref_poc_from_user_config(
 /***************************************************************************************************
 // Perform Required Picture Analysis Processing for the Overlay frame
 ***************************************************************************************************/
-void perform_simple_picture_analysis_for_overlay(PictureParentControlSet     *pcs_ptr) {
+void perform_simple_picture_analysis_for_overlay(PictureDecisionContext      *context_ptr,
+                                                 PictureParentControlSet     *pcs_ptr) {
     EbPictureBufferDesc           *input_padded_picture_ptr;
     EbPictureBufferDesc           *input_picture_ptr;
     EbPaReferenceObject           *pa_ref_obj_;
@@ -5291,7 +5301,8 @@ void perform_simple_picture_analysis_for_overlay(PictureParentControlSet     *pc
     // Pre processing operations performed on the input picture
     picture_pre_processing_operations(
         pcs_ptr,
-        scs_ptr);
+        scs_ptr,
+        &context_ptr->denoise_and_model);
 
     if (input_picture_ptr->color_format >= EB_YUV422) {
         // Jing: Do the conversion of 422/444=>420 here since it's multi-threaded kernel
@@ -5349,7 +5360,8 @@ void perform_simple_picture_analysis_for_overlay(PictureParentControlSet     *pc
 /***************************************************************************************************
  * Initialize the overlay frame
 ***************************************************************************************************/
-void initialize_overlay_frame(PictureParentControlSet     *pcs_ptr) {
+void initialize_overlay_frame(PictureDecisionContext      *context_ptr,
+                              PictureParentControlSet     *pcs_ptr) {
     pcs_ptr->scene_change_flag = FALSE;
     pcs_ptr->cra_flag = FALSE;
     pcs_ptr->idr_flag = FALSE;
@@ -5361,7 +5373,7 @@ void initialize_overlay_frame(PictureParentControlSet     *pcs_ptr) {
     pcs_ptr->init_pred_struct_position_flag = FALSE;
     pcs_ptr->pre_assignment_buffer_count = pcs_ptr->alt_ref_ppcs_ptr->pre_assignment_buffer_count;
 
-    perform_simple_picture_analysis_for_overlay(pcs_ptr);
+    perform_simple_picture_analysis_for_overlay(context_ptr, pcs_ptr);
  }
 
 /*
@@ -6566,11 +6578,14 @@ void* picture_decision_kernel(void *input_ptr)
 
                 }
 #if FIX_SCD
-                else if (scs_ptr->vq_ctrls.sharpness_ctrls.scene_transition && context_ptr->is_next_base_sc == 0) {
-                    context_ptr->is_next_base_sc = scene_transition_detector(
+                else if (scs_ptr->vq_ctrls.sharpness_ctrls.scene_transition &&
+                    (context_ptr->is_next_base_sc == 0 || scs_ptr->static_config.lookahead_only)) {
+                    // lookahead_only reports the transitions of every picture
+                    pcs_ptr->scene_transition_detected = scene_transition_detector(
                         context_ptr,
                         scs_ptr,
                         (PictureParentControlSet**)pcs_ptr->pd_window);
+                    context_ptr->is_next_base_sc |= pcs_ptr->scene_transition_detected;
 #else
                 else if (scs_ptr->vq_ctrls.sharpness_ctrls.scene_transition && context_ptr->transition_present == 0) {
                     context_ptr->transition_present = scene_transition_detector(
@@ -6888,7 +6903,7 @@ void* picture_decision_kernel(void *input_ptr)
                                 // Set missing parts in the overlay  pictures
                                 if (loop_index == 1) {
                                     pcs_ptr = pcs_ptr->overlay_ppcs_ptr;
-                                    initialize_overlay_frame(pcs_ptr);
+                                    initialize_overlay_frame(context_ptr, pcs_ptr);
                                     picture_type = P_SLICE;
                                 }
                                 // Set the Slice type
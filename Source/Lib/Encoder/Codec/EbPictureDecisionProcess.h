@@ -41,7 +41,8 @@ void pad_picture_to_multiple_of_min_blk_size_dimensions(SequenceControlSet  *scs
 void pad_picture_to_multiple_of_min_blk_size_dimensions_16bit(
     SequenceControlSet *scs_ptr, EbPictureBufferDesc *input_picture_ptr);
 void picture_pre_processing_operations(PictureParentControlSet *pcs_ptr,
-                                       SequenceControlSet      *scs_ptr);
+                                       SequenceControlSet      *scs_ptr,
+                                       AomDenoiseAndModel     **denoise_and_model);
 void pad_picture_to_multiple_of_sb_dimensions(EbPictureBufferDesc *input_padded_picture_ptr);
 
 void gathering_picture_statistics(SequenceControlSet *scs_ptr, PictureParentControlSet *pcs_ptr,
@@ -126,6 +127,8 @@ typedef struct PictureDecisionContext {
 
     int32_t last_i_noise_levels_log1p_fp16[MAX_MB_PLANE];
     double  last_i_noise_levels[MAX_MB_PLANE];
+    // Film grain denoiser of the overlay pictures, reused across pictures
+    AomDenoiseAndModel *denoise_and_model;
 } PictureDecisionContext;
 
 #endif // EbPictureDecision_h
@@ -37,6 +37,7 @@
 
 #include "EbPictureDecisionResults.h"
 #include "EbResize.h"
+#include "EbTime.h"
 
 static const double tpl_hl_islice_div_factor[EB_MAX_TEMPORAL_LAYERS]     = {1, 1, 1, 2, 1, 0.7};
 static const double tpl_hl_base_frame_div_factor[EB_MAX_TEMPORAL_LAYERS] = {1, 1, 1, 3, 1, 0.9};
@@ -1293,6 +1294,50 @@ void sb_qp_derivation_tpl_la(PictureControlSet *pcs_ptr) {
     }
 }
 
+/******************************************************
+ * sb_row_recode_setup
+ *   Decides if the recode loop of the picture only adjusts the
+ *   q of the remaining SB rows, see sb_row_recode_init.  The
+ *   adjustment is signalled through delta q, so delta q is
+ *   enabled with all the SBs starting at base_q_idx when QPM
+ *   left it off.
+ ******************************************************/
+static void sb_row_recode_setup(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr) {
+    PictureParentControlSet    *ppcs_ptr           = pcs_ptr->parent_pcs_ptr;
+    EncodeContext *const        encode_context_ptr = scs_ptr->encode_context_ptr;
+    const RateControlCfg *const rc_cfg             = &encode_context_ptr->rc_cfg;
+    FrameHeader                *frm_hdr            = &ppcs_ptr->frm_hdr;
+    // Same test as the recode decision at the end of EncDec
+#if FRFCTR_RC_P9
+    const Bool recode = (scs_ptr->static_config.rate_control_mode == 1 ||
+                         scs_ptr->static_config.max_bit_rate != 0) &&
+#else
+    const Bool recode = (scs_ptr->static_config.pass == ENC_MIDDLE_PASS ||
+                         scs_ptr->static_config.pass == ENC_LAST_PASS || scs_ptr->lap_rc ||
+                         scs_ptr->static_config.max_bit_rate != 0) &&
+#endif
+        encode_context_ptr->recode_loop != DISALLOW_RECODE;
+
+    // Pictures recode_loop_update_q never recodes, segmentation owns the SB qindex
+    ppcs_ptr->sb_row_recode = scs_ptr->static_config.sb_row_recode && recode &&
+        !(encode_context_ptr->recode_loop == ALLOW_RECODE_KFMAXBW &&
+          frm_hdr->frame_type != KEY_FRAME) &&
+        !(rc_cfg->mode == AOM_Q && scs_ptr->static_config.max_bit_rate &&
+          ppcs_ptr->temporal_layer_index > 0) &&
+        frm_hdr->quantization_params.base_q_idx > 0 &&
+        scs_ptr->static_config.superres_mode == SUPERRES_NONE &&
+        scs_ptr->static_config.enable_adaptive_quantization != 1 &&
+        !frm_hdr->segmentation_params.segmentation_enabled &&
+        ppcs_ptr->tile_group_cols * ppcs_ptr->tile_group_rows == 1 &&
+        pcs_ptr->enc_dec_segment_ctrl[0]->segment_row_count > 1;
+
+    if (ppcs_ptr->sb_row_recode && !frm_hdr->delta_q_params.delta_q_present) {
+        frm_hdr->delta_q_params.delta_q_present = 1;
+        for (int sb_addr = 0; sb_addr < pcs_ptr->sb_total_count_pix; ++sb_addr)
+            pcs_ptr->sb_ptr_array[sb_addr]->qindex = frm_hdr->quantization_params.base_q_idx;
+    }
+}
+
 static int av1_find_qindex(double desired_q, aom_bit_depth_t bit_depth, int best_qindex,
                            int worst_qindex) {
     assert(best_qindex <= worst_qindex);
@@ -1353,6 +1398,54 @@ int svt_av1_rc_get_default_max_gf_interval(double framerate, int min_gf_interval
     return AOMMAX(interval, min_gf_interval);
 }
 
+/******************************************************
+ * rescale_vbr_budgets
+ *   Scales the bits left to the sequence, the key frame and GF group
+ *   budgets and the frame allocations not yet used by the ratio of the
+ *   new and the old target bitrate.
+ ******************************************************/
+static void rescale_vbr_budgets(SequenceControlSet *scs_ptr, double ratio) {
+    EncodeContext *encode_context_ptr = scs_ptr->encode_context_ptr;
+    RATE_CONTROL  *rc                 = &encode_context_ptr->rc;
+    TWO_PASS      *twopass            = &scs_ptr->twopass;
+    GF_GROUP      *gf_group           = &encode_context_ptr->gf_group;
+
+    twopass->bits_left     = (int64_t)(twopass->bits_left * ratio);
+    twopass->kf_group_bits = (int64_t)(twopass->kf_group_bits * ratio);
+    rc->gf_group_bits      = (int64_t)(rc->gf_group_bits * ratio);
+    for (int i = gf_group->index; i < gf_group->size; i++)
+        gf_group->bit_allocation[i] = (int)(gf_group->bit_allocation[i] * ratio);
+}
+
+/******************************************************
+ * apply_reconfig
+ *   Applies the svt_av1_enc_reconfigure() changes carried by a picture and
+ *   derives the frame and buffer targets from the new rate.
+ ******************************************************/
+static void apply_reconfig(SequenceControlSet *scs_ptr, const SvtAv1EncReconfig *reconfig) {
+    EbSvtAv1EncConfiguration *config              = &scs_ptr->static_config;
+    EncodeContext            *encode_context_ptr  = scs_ptr->encode_context_ptr;
+    RATE_CONTROL             *rc                  = &encode_context_ptr->rc;
+    const uint32_t            old_target_bit_rate = config->target_bit_rate;
+
+    if (reconfig->target_bit_rate)
+        config->target_bit_rate = reconfig->target_bit_rate;
+    if (reconfig->max_bit_rate)
+        config->max_bit_rate = reconfig->max_bit_rate;
+    if (reconfig->maximum_buffer_size_ms) {
+        config->maximum_buffer_size_ms                    = reconfig->maximum_buffer_size_ms;
+        encode_context_ptr->rc_cfg.maximum_buffer_size_ms = reconfig->maximum_buffer_size_ms;
+    }
+    if (!config->rate_control_mode)
+        return;
+    set_rc_buffer_sizes(scs_ptr);
+    rc->bits_off_target = AOMMIN(rc->bits_off_target, rc->maximum_buffer_size);
+    rc->buffer_level    = AOMMIN(rc->buffer_level, rc->maximum_buffer_size);
+    svt_av1_new_framerate(scs_ptr, scs_ptr->double_frame_rate);
+    if (config->rate_control_mode == 1 && config->target_bit_rate != old_target_bit_rate)
+        rescale_vbr_budgets(scs_ptr, (double)config->target_bit_rate / old_target_bit_rate);
+}
+
 //#define INT_MAX 0x7fffffff
 #define BPER_MB_NORMBITS 9
 #define FRAME_OVERHEAD_BITS 200
@@ -2886,10 +2979,13 @@ static AOM_INLINE int get_regulated_q_undershoot(PictureParentControlSet *ppcs_p
 // This function works out whether we under- or over-shot
 // our bitrate target and adjusts q as appropriate.  Also decides whether
 // or not we should do another recode loop, indicated by *loop
+// coded_sb_count is the number of SBs the rate was collected on when the
+// decision is taken before the end of the picture (SB row recode), 0 otherwise
 void recode_loop_update_q(PictureParentControlSet *ppcs_ptr, int *const loop, int *const q,
                           int *const q_low, int *const q_high, const int top_index,
                           const int bottom_index, int *const undershoot_seen,
-                          int *const overshoot_seen, int *const low_cr_seen, const int loop_count) {
+                          int *const overshoot_seen, int *const low_cr_seen, const int loop_count,
+                          const uint32_t coded_sb_count) {
     SequenceControlSet *const   scs_ptr            = ppcs_ptr->scs_ptr;
     EncodeContext *const        encode_context_ptr = scs_ptr->encode_context_ptr;
     RATE_CONTROL *const         rc                 = &(encode_context_ptr->rc);
@@ -2900,11 +2996,14 @@ void recode_loop_update_q(PictureParentControlSet *ppcs_ptr, int *const loop, in
         rc_cfg->min_cr > 0;
     if (do_dummy_pack) {
         svt_block_on_mutex(ppcs_ptr->pcs_total_rate_mutex);
+        uint64_t total_rate = ppcs_ptr->pcs_total_rate;
+        svt_release_mutex(ppcs_ptr->pcs_total_rate_mutex);
+        // Project the rate of the coded SBs to the whole picture
+        if (coded_sb_count)
+            total_rate = total_rate * ppcs_ptr->sb_total_count_pix / coded_sb_count;
         ppcs_ptr->projected_frame_size =
-            (int)(((ppcs_ptr->pcs_total_rate + (1 << (AV1_PROB_COST_SHIFT - 1))) >>
-                   AV1_PROB_COST_SHIFT) +
+            (int)(((total_rate + (1 << (AV1_PROB_COST_SHIFT - 1))) >> AV1_PROB_COST_SHIFT) +
                   ((ppcs_ptr->frm_hdr.frame_type == KEY_FRAME) ? 13 : 0));
-        svt_release_mutex(ppcs_ptr->pcs_total_rate_mutex);
     } else {
         ppcs_ptr->projected_frame_size = 0;
     }
@@ -3511,6 +3610,9 @@ void *rate_control_kernel(void *input_ptr) {
                 rate_control_param_ptr = context_ptr->rate_control_param_queue[interval_index_temp];
             }
             pcs_ptr->parent_pcs_ptr->rate_control_param_ptr = rate_control_param_ptr;
+            // The changes apply from the first picture carrying them in coding order
+            if (!is_superres_recode_task && pcs_ptr->parent_pcs_ptr->reconfig_present)
+                apply_reconfig(scs_ptr, &pcs_ptr->parent_pcs_ptr->reconfig);
             if (!is_superres_recode_task) {
                 if (scs_ptr->static_config.rate_control_mode) {
                     if (pcs_ptr->picture_number == 0) {
@@ -3780,9 +3882,10 @@ void *rate_control_kernel(void *input_ptr) {
                 }
             }
 
-            // QPM with tpl_la
+            // QPM with tpl_la, the segments of a ROI map replace the SB delta q
             if (scs_ptr->static_config.enable_adaptive_quantization == 2 &&
-                pcs_ptr->parent_pcs_ptr->tpl_ctrls.enable && pcs_ptr->parent_pcs_ptr->r0 != 0) {
+                pcs_ptr->parent_pcs_ptr->tpl_ctrls.enable && pcs_ptr->parent_pcs_ptr->r0 != 0 &&
+                !pcs_ptr->parent_pcs_ptr->roi_map_present) {
                 sb_qp_derivation_tpl_la(pcs_ptr);
             } else {
                 pcs_ptr->parent_pcs_ptr->frm_hdr.delta_q_params.delta_q_present = 0;
@@ -3791,9 +3894,14 @@ void *rate_control_kernel(void *input_ptr) {
                     sb_ptr->qindex     = quantizer_to_qindex[pcs_ptr->picture_qp];
                 }
             }
+            if (scs_ptr->static_config.enable_roi_map)
+                roi_map_setup_segmentation(pcs_ptr);
+            sb_row_recode_setup(pcs_ptr, scs_ptr);
             if (scs_ptr->static_config.rate_control_mode && !is_superres_recode_task) {
                 update_rc_counts(pcs_ptr->parent_pcs_ptr);
             }
+            if (scs_ptr->static_config.enable_frame_stats)
+                pcs_ptr->parent_pcs_ptr->rc_done_time = svt_av1_get_time_us();
             // Get Empty Rate Control Results Buffer
             svt_get_empty_object(context_ptr->rate_control_output_results_fifo_ptr,
                                  &rate_control_results_wrapper_ptr);
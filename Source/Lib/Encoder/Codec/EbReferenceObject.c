@@ -116,6 +116,7 @@ static void svt_reference_object_dctor(EbPtr p) {
     EB_FREE_ARRAY(obj->sb_intra);
     EB_FREE_ARRAY(obj->sb_skip);
     EB_FREE_ARRAY(obj->sb_64x64_mvp);
+    EB_FREE_ARRAY(obj->sb_src_hash);
     EB_FREE_ARRAY(obj->sb_me_64x64_dist);
     EB_FREE_ARRAY(obj->sb_me_8x8_cost_var);
     for (uint8_t denom_idx = 0; denom_idx < NUM_SCALES; denom_idx++) {
@@ -202,6 +203,8 @@ EbErrorType svt_reference_object_ctor(EbReferenceObject *reference_object,
     EB_MALLOC_ARRAY(reference_object->sb_skip, picture_buffer_desc_init_data_ptr->sb_total_count);
     EB_MALLOC_ARRAY(reference_object->sb_64x64_mvp,
                     picture_buffer_desc_init_data_ptr->sb_total_count);
+    EB_CALLOC_ARRAY(reference_object->sb_src_hash,
+                    picture_buffer_desc_init_data_ptr->sb_total_count);
     EB_MALLOC_ARRAY(reference_object->sb_me_64x64_dist,
                     picture_buffer_desc_init_data_ptr->sb_total_count);
     EB_MALLOC_ARRAY(reference_object->sb_me_8x8_cost_var,
@@ -242,6 +245,8 @@ static void svt_pa_reference_object_dctor(EbPtr p) {
         }
         EB_DESTROY_MUTEX(obj->resize_mutex[denom_idx]);
     }
+    for (uint8_t level = 0; level <= GM_DOWN16; level++) EB_FREE_ARRAY(obj->gm_corners[level]);
+    EB_DESTROY_MUTEX(obj->gm_corners_mutex);
 }
 
 /*****************************************
@@ -276,6 +281,13 @@ EbErrorType svt_pa_reference_object_ctor(EbPaReferenceObject *pa_ref_obj_,
         pa_ref_obj_->downscaled_picture_number[down_idx]                    = (uint64_t)~0;
         EB_CREATE_MUTEX(pa_ref_obj_->resize_mutex[down_idx]);
     }
+    // the GM corners are allocated on first use
+    for (uint8_t level = 0; level <= GM_DOWN16; level++) {
+        pa_ref_obj_->gm_corners[level]                = NULL;
+        pa_ref_obj_->gm_num_corners[level]            = 0;
+        pa_ref_obj_->gm_corners_picture_number[level] = (uint64_t)~0;
+    }
+    EB_CREATE_MUTEX(pa_ref_obj_->gm_corners_mutex);
 
     return EB_ErrorNone;
 }
@@ -53,6 +53,7 @@ typedef struct EbReferenceObject {
     uint8_t             *sb_intra;
     uint8_t             *sb_skip;
     uint8_t             *sb_64x64_mvp;
+    uint32_t            *sb_src_hash; // hash of the SB source, 0 when not computed
     uint32_t            *sb_me_64x64_dist;
     uint32_t            *sb_me_8x8_cost_var;
     int32_t              mi_cols;
@@ -79,6 +80,13 @@ typedef struct EbPaReferenceObject {
     EbHandle resize_mutex[NUM_SCALES];
     uint64_t picture_number;
     uint8_t  dummy_obj;
+    // FAST corners of the picture at each GM downsample level, detected by the
+    // first global motion search using them and shared by all the pictures
+    // referencing this one
+    int     *gm_corners[GM_DOWN16 + 1];
+    int      gm_num_corners[GM_DOWN16 + 1];
+    uint64_t gm_corners_picture_number[GM_DOWN16 + 1]; // save the picture_number for each level
+    EbHandle gm_corners_mutex;
 } EbPaReferenceObject;
 
 typedef struct EbPaReferenceObjectDescInitData {
@@ -1274,7 +1274,9 @@ static void calc_superres_params(superres_params_type *spr_params, SequenceContr
     switch (superres_mode) {
     case SUPERRES_NONE: spr_params->superres_denom = SCALE_NUMERATOR; break;
     case SUPERRES_FIXED:
-        if (frm_hdr->frame_type == KEY_FRAME)
+        if (pcs_ptr->fixed_superres_denom)
+            spr_params->superres_denom = pcs_ptr->fixed_superres_denom;
+        else if (frm_hdr->frame_type == KEY_FRAME)
             spr_params->superres_denom = cfg_kf_denom;
         else
             spr_params->superres_denom = cfg_denom;
@@ -63,6 +63,8 @@ typedef struct ResourceCoordinationContext {
     uint64_t first_in_pic_arrived_time_seconds;
     uint64_t first_in_pic_arrived_timeu_seconds;
     Bool   start_flag;
+    // superres_denom - last svt_av1_enc_reconfigure() coded width, 0 if none
+    uint8_t superres_denom;
 } ResourceCoordinationContext;
 
 static void resource_coordination_context_dctor(EbPtr p) {
@@ -704,7 +706,7 @@ static EbErrorType reset_pcs_av1(PictureParentControlSet *pcs_ptr) {
         pcs_ptr->frame_offset = pcs_ptr->picture_number %
             (pcs_ptr->scs_ptr->static_config.intra_period_length + 1);
     } else
-        pcs_ptr->frame_offset = pcs_ptr->picture_number;
+        pcs_ptr->frame_offset = pcs_ptr->picture_number + pcs_ptr->scs_ptr->chunk_start_frame;
     frm_hdr->error_resilient_mode            = 0;
     cm->tiles_info.uniform_tile_spacing_flag = 1;
     pcs_ptr->large_scale_tile                = 0;
@@ -886,6 +888,12 @@ void read_stat(SequenceControlSet *scs_ptr) {
     EncodeContext *encode_context_ptr = scs_ptr->encode_context_ptr;
 
     encode_context_ptr->rc_stats_buffer = scs_ptr->static_config.rc_stats_buffer;
+    // A stats file loaded as is, skip its header
+    const SvtAv1StatsHeader *header = encode_context_ptr->rc_stats_buffer.buf;
+    if (header && svt_av1_check_stats_header(header, encode_context_ptr->rc_stats_buffer.sz)) {
+        encode_context_ptr->rc_stats_buffer.buf = (uint8_t *)header + header->header_size;
+        encode_context_ptr->rc_stats_buffer.sz  = (header->frame_count + 1) * header->record_size;
+    }
 }
 void setup_two_pass(SequenceControlSet *scs_ptr) {
     EncodeContext *encode_context_ptr = scs_ptr->encode_context_ptr;
@@ -907,6 +915,8 @@ void setup_two_pass(SequenceControlSet *scs_ptr) {
                 &scs_ptr->twopass.stats_buf_ctx->stats_in_start[packets - 1];
             scs_ptr->twopass.stats_buf_ctx->stats_in_end =
                 &scs_ptr->twopass.stats_buf_ctx->stats_in_start[packets - 1];
+            if (scs_ptr->static_config.chunk_start_frame >= 0)
+                svt_av1_setup_chunk_stats(scs_ptr);
             svt_av1_init_second_pass(scs_ptr);
             scs_ptr->is_short_clip = scs_ptr->twopass.stats_buf_ctx->total_stats->count < 200
                 ? 1
@@ -1212,6 +1222,10 @@ void *resource_coordination_kernel(void *input_ptr) {
             pcs_ptr->superres_total_recode_loop = 0;
             pcs_ptr->superres_recode_loop       = 0;
             svt_av1_get_time(&pcs_ptr->start_time_seconds, &pcs_ptr->start_time_u_seconds);
+            pcs_ptr->me_done_time      = 0;
+            pcs_ptr->rc_done_time      = 0;
+            pcs_ptr->enc_dec_done_time = 0;
+            pcs_ptr->rest_done_time    = 0;
 
             pcs_ptr->scs_wrapper_ptr =
                 context_ptr->sequence_control_set_active_array[instance_index];
@@ -1221,6 +1235,29 @@ void *resource_coordination_kernel(void *input_ptr) {
             pcs_ptr->eb_y8b_wrapper_ptr   = eb_y8b_wrapper_ptr;
             pcs_ptr->end_of_sequence_flag = end_of_sequence_flag;
             pcs_ptr->is_superres_none     = (scs_ptr->static_config.superres_mode == SUPERRES_NONE);
+            // The changes start with the picture, its overlay follows them
+            pcs_ptr->reconfig_present = loop_index == 0 && input_cmd_obj->reconfig_present;
+            if (pcs_ptr->reconfig_present) {
+                pcs_ptr->reconfig = input_cmd_obj->reconfig;
+                if (pcs_ptr->reconfig.superres_denom)
+                    context_ptr->superres_denom = pcs_ptr->reconfig.superres_denom;
+            }
+            pcs_ptr->fixed_superres_denom = context_ptr->superres_denom;
+            // The overlay is the same picture, it keeps the ROI map
+            pcs_ptr->roi_map_present = input_cmd_obj->roi_map_present;
+            if (pcs_ptr->roi_map_present) {
+                pcs_ptr->roi_skip_present = input_cmd_obj->roi_skip_present;
+                pcs_ptr->roi_seg_count    = input_cmd_obj->roi_seg_count;
+                svt_memcpy(pcs_ptr->roi_seg_qp,
+                           input_cmd_obj->roi_seg_qp,
+                           sizeof(pcs_ptr->roi_seg_qp));
+                svt_memcpy(
+                    pcs_ptr->roi_seg_map, input_cmd_obj->roi_seg_map, pcs_ptr->sb_total_count);
+                if (pcs_ptr->roi_skip_present)
+                    svt_memcpy(pcs_ptr->roi_skip_map,
+                               input_cmd_obj->roi_skip_map,
+                               pcs_ptr->sb_total_count);
+            }
             if (loop_index == 1) {
                 // Get a new input picture for overlay.
                 EbObjectWrapper *input_pic_wrapper_ptr;
@@ -1254,6 +1291,7 @@ void *resource_coordination_kernel(void *input_ptr) {
             pcs_ptr->scene_change_flag = FALSE;
             pcs_ptr->qp_on_the_fly     = FALSE;
             pcs_ptr->sb_total_count    = scs_ptr->sb_total_count;
+            pcs_ptr->scene_transition_detected = FALSE;
             if (scs_ptr->speed_control_flag) {
                 speed_buffer_control(context_ptr, pcs_ptr, scs_ptr);
             } else
@@ -1297,7 +1335,8 @@ void *resource_coordination_kernel(void *input_ptr) {
                 pcs_ptr->stat_struct = (scs_ptr->twopass.stats_buf_ctx->stats_in_start +
                                         pcs_ptr->picture_number)
                                            ->stat_struct;
-                if (pcs_ptr->stat_struct.poc != pcs_ptr->picture_number)
+                if (pcs_ptr->stat_struct.poc !=
+                    pcs_ptr->picture_number + scs_ptr->chunk_start_frame)
                     SVT_LOG("Error reading data in multi pass encoding\n");
             }
             if (scs_ptr->static_config.use_qp_file == 1) {
@@ -1326,6 +1365,9 @@ void *resource_coordination_kernel(void *input_ptr) {
             EbPictureBufferDesc *input_padded_picture_ptr =
                 (EbPictureBufferDesc *)pa_ref_obj->input_padded_picture_ptr;
             input_padded_picture_ptr->buffer_y = buff_y8b;
+            // the GM corners cached by the previous picture of the object are stale
+            for (uint8_t level = 0; level <= GM_DOWN16; level++)
+                pa_ref_obj->gm_corners_picture_number[level] = (uint64_t)~0;
             // Since overlay pictures are not added to PA_Reference queue in PD and not released there, the life count is only set to 1
             if (pcs_ptr->is_overlay)
                 // Give the new Reference a nominal live_count of 1
@@ -23,6 +23,16 @@ typedef struct InputCommand {
     EbDctor          dctor;
     EbObjectWrapper *eb_input_wrapper_ptr;
     EbObjectWrapper *eb_y8b_wrapper_ptr;
+    // reconfig - svt_av1_enc_reconfigure() changes starting with this picture
+    Bool              reconfig_present;
+    SvtAv1EncReconfig reconfig;
+    // roi_* - ROI map of the picture as segments, see PictureParentControlSet
+    Bool     roi_map_present;
+    Bool     roi_skip_present;
+    uint8_t  roi_seg_count;
+    int16_t  roi_seg_qp[MAX_SEGMENTS];
+    uint8_t *roi_seg_map;
+    uint8_t *roi_skip_map;
 } InputCommand;
 
 /**************************************
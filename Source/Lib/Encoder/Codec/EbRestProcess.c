@@ -19,6 +19,7 @@
 #include "EbPictureDemuxResults.h"
 #include "EbReferenceObject.h"
 #include "EbPictureControlSet.h"
+#include "EbTime.h"
 
 /**************************************
  * Rest Context
@@ -518,17 +519,18 @@ void svt_av1_superres_upscale_frame(struct Av1Common *cm, PictureControlSet *pcs
 }
 
 /******************************************************
- * Rest Kernel
+ * Rest Task
+ *   Restoration search of one CDEF result segment, the last segment
+ *   of a picture also filters the frame
  ******************************************************/
-void *rest_kernel(void *input_ptr) {
+void rest_process_task(EbThreadContext *thread_context_ptr,
+                       EbObjectWrapper *cdef_results_wrapper_ptr) {
     // Context & SCS & PCS
-    EbThreadContext    *thread_context_ptr = (EbThreadContext *)input_ptr;
     RestContext        *context_ptr        = (RestContext *)thread_context_ptr->priv;
     PictureControlSet  *pcs_ptr;
     SequenceControlSet *scs_ptr;
 
     //// Input
-    EbObjectWrapper *cdef_results_wrapper_ptr;
     CdefResults     *cdef_results_ptr;
 
     //// Output
@@ -542,226 +544,238 @@ void *rest_kernel(void *input_ptr) {
 
     Bool superres_recode = FALSE;
 
-    for (;;) {
-        // Get Cdef Results
-        EB_GET_FULL_OBJECT(context_ptr->rest_input_fifo_ptr, &cdef_results_wrapper_ptr);
-
-        cdef_results_ptr      = (CdefResults *)cdef_results_wrapper_ptr->object_ptr;
-        pcs_ptr               = (PictureControlSet *)cdef_results_ptr->pcs_wrapper_ptr->object_ptr;
-        scs_ptr               = (SequenceControlSet *)pcs_ptr->scs_wrapper_ptr->object_ptr;
-        FrameHeader *frm_hdr  = &pcs_ptr->parent_pcs_ptr->frm_hdr;
-        Bool       is_16bit = scs_ptr->is_16bit_pipeline;
-        Av1Common   *cm       = pcs_ptr->parent_pcs_ptr->av1_cm;
-
-        if (scs_ptr->seq_header.enable_restoration && frm_hdr->allow_intrabc == 0) {
-            Yv12BufferConfig cpi_source;
-            link_eb_to_aom_buffer_desc(is_16bit
-                                           ? pcs_ptr->input_frame16bit
-                                           : pcs_ptr->parent_pcs_ptr->enhanced_unscaled_picture_ptr,
-                                       &cpi_source,
-                                       scs_ptr->max_input_pad_right,
-                                       scs_ptr->max_input_pad_bottom,
-                                       is_16bit);
+    cdef_results_ptr      = (CdefResults *)cdef_results_wrapper_ptr->object_ptr;
+    pcs_ptr               = (PictureControlSet *)cdef_results_ptr->pcs_wrapper_ptr->object_ptr;
+    scs_ptr               = (SequenceControlSet *)pcs_ptr->scs_wrapper_ptr->object_ptr;
+    FrameHeader *frm_hdr  = &pcs_ptr->parent_pcs_ptr->frm_hdr;
+    Bool       is_16bit = scs_ptr->is_16bit_pipeline;
+    Av1Common   *cm       = pcs_ptr->parent_pcs_ptr->av1_cm;
+
+    if (scs_ptr->seq_header.enable_restoration && frm_hdr->allow_intrabc == 0) {
+        Yv12BufferConfig cpi_source;
+        link_eb_to_aom_buffer_desc(is_16bit
+                                       ? pcs_ptr->input_frame16bit
+                                       : pcs_ptr->parent_pcs_ptr->enhanced_unscaled_picture_ptr,
+                                   &cpi_source,
+                                   scs_ptr->max_input_pad_right,
+                                   scs_ptr->max_input_pad_bottom,
+                                   is_16bit);
 
-            Yv12BufferConfig trial_frame_rst;
-            link_eb_to_aom_buffer_desc(context_ptr->trial_frame_rst,
-                                       &trial_frame_rst,
-                                       scs_ptr->max_input_pad_right,
-                                       scs_ptr->max_input_pad_bottom,
-                                       is_16bit);
-            // If using boundaries during the filter search, copy the recon pic to a new buffer (to
-            // avoid race conidition from many threads modifying the same recon pic).
-            //
-            // If not using boundaries during the filter search, copy the input recon picture location
-            // to be used in restoration search (save cycles/memory of copying pic to a new buffer).
-            // The recon pic should not be modified during the search, otherwise there will be a race
-            // condition between threads.
-            EbPictureBufferDesc *recon_picture_ptr = get_own_recon(
-                scs_ptr, pcs_ptr, context_ptr, is_16bit);
-            Yv12BufferConfig org_fts;
-            link_eb_to_aom_buffer_desc(recon_picture_ptr,
-                                       &org_fts,
-                                       scs_ptr->max_input_pad_right,
-                                       scs_ptr->max_input_pad_bottom,
-                                       is_16bit);
-            if (pcs_ptr->parent_pcs_ptr->slice_type != I_SLICE && cm->wn_filter_ctrls.enabled &&
-                cm->wn_filter_ctrls.use_prev_frame_coeffs) {
-                EbReferenceObject *ref_obj_l0 =
-                    (EbReferenceObject *)pcs_ptr->ref_pic_ptr_array[REF_LIST_0][0]->object_ptr;
-                for (int32_t plane = 0; plane < MAX_MB_PLANE; ++plane) {
-                    int32_t ntiles = pcs_ptr->rst_info[plane].units_per_tile;
-                    for (int32_t u = 0; u < ntiles; ++u) {
-                        pcs_ptr->rst_info[plane].unit_info[u].restoration_type =
-                            ref_obj_l0->unit_info[plane][u].restoration_type;
-                        if (ref_obj_l0->unit_info[plane][u].restoration_type == RESTORE_WIENER)
-                            pcs_ptr->rst_info[plane].unit_info[u].wiener_info =
-                                ref_obj_l0->unit_info[plane][u].wiener_info;
-                    }
+        Yv12BufferConfig trial_frame_rst;
+        link_eb_to_aom_buffer_desc(context_ptr->trial_frame_rst,
+                                   &trial_frame_rst,
+                                   scs_ptr->max_input_pad_right,
+                                   scs_ptr->max_input_pad_bottom,
+                                   is_16bit);
+        // If using boundaries during the filter search, copy the recon pic to a new buffer (to
+        // avoid race conidition from many threads modifying the same recon pic).
+        //
+        // If not using boundaries during the filter search, copy the input recon picture location
+        // to be used in restoration search (save cycles/memory of copying pic to a new buffer).
+        // The recon pic should not be modified during the search, otherwise there will be a race
+        // condition between threads.
+        EbPictureBufferDesc *recon_picture_ptr = get_own_recon(
+            scs_ptr, pcs_ptr, context_ptr, is_16bit);
+        Yv12BufferConfig org_fts;
+        link_eb_to_aom_buffer_desc(recon_picture_ptr,
+                                   &org_fts,
+                                   scs_ptr->max_input_pad_right,
+                                   scs_ptr->max_input_pad_bottom,
+                                   is_16bit);
+        if (pcs_ptr->parent_pcs_ptr->slice_type != I_SLICE && cm->wn_filter_ctrls.enabled &&
+            cm->wn_filter_ctrls.use_prev_frame_coeffs) {
+            EbReferenceObject *ref_obj_l0 =
+                (EbReferenceObject *)pcs_ptr->ref_pic_ptr_array[REF_LIST_0][0]->object_ptr;
+            for (int32_t plane = 0; plane < MAX_MB_PLANE; ++plane) {
+                int32_t ntiles = pcs_ptr->rst_info[plane].units_per_tile;
+                for (int32_t u = 0; u < ntiles; ++u) {
+                    pcs_ptr->rst_info[plane].unit_info[u].restoration_type =
+                        ref_obj_l0->unit_info[plane][u].restoration_type;
+                    if (ref_obj_l0->unit_info[plane][u].restoration_type == RESTORE_WIENER)
+                        pcs_ptr->rst_info[plane].unit_info[u].wiener_info =
+                            ref_obj_l0->unit_info[plane][u].wiener_info;
                 }
             }
-            restoration_seg_search(context_ptr->rst_tmpbuf,
-                                   &org_fts,
-                                   &cpi_source,
-                                   &trial_frame_rst,
-                                   pcs_ptr,
-                                   cdef_results_ptr->segment_index);
         }
+        restoration_seg_search(context_ptr->rst_tmpbuf,
+                               &org_fts,
+                               &cpi_source,
+                               &trial_frame_rst,
+                               pcs_ptr,
+                               cdef_results_ptr->segment_index);
+    }
 
-        //all seg based search is done. update total processed segments. if all done, finish the search and perfrom application.
-        svt_block_on_mutex(pcs_ptr->rest_search_mutex);
-
-        pcs_ptr->tot_seg_searched_rest++;
-        if (pcs_ptr->tot_seg_searched_rest == pcs_ptr->rest_segments_total_count) {
-            if (scs_ptr->seq_header.enable_restoration && frm_hdr->allow_intrabc == 0) {
-                rest_finish_search(pcs_ptr);
-                if (pcs_ptr->rst_info[0].frame_restoration_type != RESTORE_NONE ||
-                    pcs_ptr->rst_info[1].frame_restoration_type != RESTORE_NONE ||
-                    pcs_ptr->rst_info[2].frame_restoration_type != RESTORE_NONE) {
-                    svt_av1_loop_restoration_filter_frame(cm->frame_to_show, cm, 0);
-                }
-            } else {
-                pcs_ptr->rst_info[0].frame_restoration_type = RESTORE_NONE;
-                pcs_ptr->rst_info[1].frame_restoration_type = RESTORE_NONE;
-                pcs_ptr->rst_info[2].frame_restoration_type = RESTORE_NONE;
-            }
+    //all seg based search is done. update total processed segments. if all done, finish the search and perfrom application.
+    svt_block_on_mutex(pcs_ptr->rest_search_mutex);
 
-            uint8_t best_ep_cnt = 0;
-            uint8_t best_ep     = 0;
-            for (uint8_t i = 0; i < SGRPROJ_PARAMS; i++) {
-                if (cm->sg_frame_ep_cnt[i] > best_ep_cnt) {
-                    best_ep     = i;
-                    best_ep_cnt = cm->sg_frame_ep_cnt[i];
-                }
+    pcs_ptr->tot_seg_searched_rest++;
+    if (pcs_ptr->tot_seg_searched_rest == pcs_ptr->rest_segments_total_count) {
+        if (scs_ptr->seq_header.enable_restoration && frm_hdr->allow_intrabc == 0) {
+            rest_finish_search(pcs_ptr);
+            if (pcs_ptr->rst_info[0].frame_restoration_type != RESTORE_NONE ||
+                pcs_ptr->rst_info[1].frame_restoration_type != RESTORE_NONE ||
+                pcs_ptr->rst_info[2].frame_restoration_type != RESTORE_NONE) {
+                svt_av1_loop_restoration_filter_frame(cm->frame_to_show, cm, 0);
             }
-            cm->sg_frame_ep = best_ep;
+        } else {
+            pcs_ptr->rst_info[0].frame_restoration_type = RESTORE_NONE;
+            pcs_ptr->rst_info[1].frame_restoration_type = RESTORE_NONE;
+            pcs_ptr->rst_info[2].frame_restoration_type = RESTORE_NONE;
+        }
 
-            if (pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr != NULL) {
-                // copy stat to ref object (intra_coded_area, Luminance, Scene change detection flags)
-                copy_statistics_to_ref_obj_ect(pcs_ptr, scs_ptr);
+        uint8_t best_ep_cnt = 0;
+        uint8_t best_ep     = 0;
+        for (uint8_t i = 0; i < SGRPROJ_PARAMS; i++) {
+            if (cm->sg_frame_ep_cnt[i] > best_ep_cnt) {
+                best_ep     = i;
+                best_ep_cnt = cm->sg_frame_ep_cnt[i];
             }
+        }
+        cm->sg_frame_ep = best_ep;
 
-            superres_recode = pcs_ptr->parent_pcs_ptr->superres_total_recode_loop > 0 ? TRUE
-                                                                                      : FALSE;
-
-            // Pad the reference picture and set ref POC
-            if (scs_ptr->static_config.pass != ENC_FIRST_PASS) {
-                if (pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag == TRUE)
-                    pad_ref_and_set_flags(pcs_ptr, scs_ptr);
-                else {
-                    // convert non-reference frame buffer from 16-bit to 8-bit, to export recon and psnr/ssim calculation
-                    if (is_16bit && scs_ptr->static_config.encoder_bit_depth == EB_8BIT) {
-                        EbPictureBufferDesc *ref_pic_ptr =
-                            pcs_ptr->parent_pcs_ptr->enc_dec_ptr->recon_picture_ptr;
-                        EbPictureBufferDesc *ref_pic_16bit_ptr =
-                            pcs_ptr->parent_pcs_ptr->enc_dec_ptr->recon_picture16bit_ptr;
-                        //Y
-                        uint16_t *buf_16bit = (uint16_t *)(ref_pic_16bit_ptr->buffer_y);
-                        uint8_t  *buf_8bit  = ref_pic_ptr->buffer_y;
-                        svt_convert_16bit_to_8bit(
-                            buf_16bit,
-                            ref_pic_16bit_ptr->stride_y,
-                            buf_8bit,
-                            ref_pic_ptr->stride_y,
-                            ref_pic_16bit_ptr->width + (ref_pic_ptr->origin_x << 1),
-                            ref_pic_16bit_ptr->height + (ref_pic_ptr->origin_y << 1));
-
-                        //CB
-                        buf_16bit = (uint16_t *)(ref_pic_16bit_ptr->buffer_cb);
-                        buf_8bit  = ref_pic_ptr->buffer_cb;
-                        svt_convert_16bit_to_8bit(
-                            buf_16bit,
-                            ref_pic_16bit_ptr->stride_cb,
-                            buf_8bit,
-                            ref_pic_ptr->stride_cb,
-                            (ref_pic_16bit_ptr->width + (ref_pic_ptr->origin_x << 1)) >>
-                                scs_ptr->subsampling_x,
-                            (ref_pic_16bit_ptr->height + (ref_pic_ptr->origin_y << 1)) >>
-                                scs_ptr->subsampling_y);
-
-                        //CR
-                        buf_16bit = (uint16_t *)(ref_pic_16bit_ptr->buffer_cr);
-                        buf_8bit  = ref_pic_ptr->buffer_cr;
-                        svt_convert_16bit_to_8bit(
-                            buf_16bit,
-                            ref_pic_16bit_ptr->stride_cr,
-                            buf_8bit,
-                            ref_pic_ptr->stride_cr,
-                            (ref_pic_16bit_ptr->width + (ref_pic_ptr->origin_x << 1)) >>
-                                scs_ptr->subsampling_x,
-                            (ref_pic_16bit_ptr->height + (ref_pic_ptr->origin_y << 1)) >>
-                                scs_ptr->subsampling_y);
-                    }
+        if (pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr != NULL) {
+            // copy stat to ref object (intra_coded_area, Luminance, Scene change detection flags)
+            copy_statistics_to_ref_obj_ect(pcs_ptr, scs_ptr);
+        }
+
+        superres_recode = pcs_ptr->parent_pcs_ptr->superres_total_recode_loop > 0 ? TRUE
+                                                                                  : FALSE;
+
+        // Pad the reference picture and set ref POC
+        if (scs_ptr->static_config.pass != ENC_FIRST_PASS) {
+            if (pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag == TRUE)
+                pad_ref_and_set_flags(pcs_ptr, scs_ptr);
+            else {
+                // convert non-reference frame buffer from 16-bit to 8-bit, to export recon and psnr/ssim calculation
+                if (is_16bit && scs_ptr->static_config.encoder_bit_depth == EB_8BIT) {
+                    EbPictureBufferDesc *ref_pic_ptr =
+                        pcs_ptr->parent_pcs_ptr->enc_dec_ptr->recon_picture_ptr;
+                    EbPictureBufferDesc *ref_pic_16bit_ptr =
+                        pcs_ptr->parent_pcs_ptr->enc_dec_ptr->recon_picture16bit_ptr;
+                    //Y
+                    uint16_t *buf_16bit = (uint16_t *)(ref_pic_16bit_ptr->buffer_y);
+                    uint8_t  *buf_8bit  = ref_pic_ptr->buffer_y;
+                    svt_convert_16bit_to_8bit(
+                        buf_16bit,
+                        ref_pic_16bit_ptr->stride_y,
+                        buf_8bit,
+                        ref_pic_ptr->stride_y,
+                        ref_pic_16bit_ptr->width + (ref_pic_ptr->origin_x << 1),
+                        ref_pic_16bit_ptr->height + (ref_pic_ptr->origin_y << 1));
+
+                    //CB
+                    buf_16bit = (uint16_t *)(ref_pic_16bit_ptr->buffer_cb);
+                    buf_8bit  = ref_pic_ptr->buffer_cb;
+                    svt_convert_16bit_to_8bit(
+                        buf_16bit,
+                        ref_pic_16bit_ptr->stride_cb,
+                        buf_8bit,
+                        ref_pic_ptr->stride_cb,
+                        (ref_pic_16bit_ptr->width + (ref_pic_ptr->origin_x << 1)) >>
+                            scs_ptr->subsampling_x,
+                        (ref_pic_16bit_ptr->height + (ref_pic_ptr->origin_y << 1)) >>
+                            scs_ptr->subsampling_y);
+
+                    //CR
+                    buf_16bit = (uint16_t *)(ref_pic_16bit_ptr->buffer_cr);
+                    buf_8bit  = ref_pic_ptr->buffer_cr;
+                    svt_convert_16bit_to_8bit(
+                        buf_16bit,
+                        ref_pic_16bit_ptr->stride_cr,
+                        buf_8bit,
+                        ref_pic_ptr->stride_cr,
+                        (ref_pic_16bit_ptr->width + (ref_pic_ptr->origin_x << 1)) >>
+                            scs_ptr->subsampling_x,
+                        (ref_pic_16bit_ptr->height + (ref_pic_ptr->origin_y << 1)) >>
+                            scs_ptr->subsampling_y);
                 }
             }
+        }
 
-            // PSNR and SSIM Calculation.
-            if (superres_recode) { // superres needs psnr to compute rdcost
-                // Note: if superres recode is actived, memory needs to be freed in packetization process by calling free_temporal_filtering_buffer()
-                EbErrorType return_error = psnr_calculations(pcs_ptr, scs_ptr, FALSE);
-                if (return_error != EB_ErrorNone) {
-                    assert_err(0,
-                               "Couldn't allocate memory for uncompressed 10bit buffers for PSNR "
-                               "calculations");
-                }
-            } else if (scs_ptr->static_config.stat_report) {
-                // Note: if temporal_filtering is used, memory needs to be freed in the last of these calls
-                EbErrorType return_error = psnr_calculations(pcs_ptr, scs_ptr, FALSE);
-                if (return_error != EB_ErrorNone) {
-                    assert_err(0,
-                               "Couldn't allocate memory for uncompressed 10bit buffers for PSNR "
-                               "calculations");
-                }
-                return_error = ssim_calculations(pcs_ptr, scs_ptr, TRUE /* free memory here */);
-                if (return_error != EB_ErrorNone) {
-                    assert_err(0,
-                               "Couldn't allocate memory for uncompressed 10bit buffers for SSIM "
-                               "calculations");
-                }
+        // PSNR and SSIM Calculation.
+        if (superres_recode) { // superres needs psnr to compute rdcost
+            // Note: if superres recode is actived, memory needs to be freed in packetization process by calling free_temporal_filtering_buffer()
+            EbErrorType return_error = psnr_calculations(pcs_ptr, scs_ptr, FALSE);
+            if (return_error != EB_ErrorNone) {
+                assert_err(0,
+                           "Couldn't allocate memory for uncompressed 10bit buffers for PSNR "
+                           "calculations");
+            }
+        } else if (scs_ptr->static_config.stat_report) {
+            // Note: if temporal_filtering is used, memory needs to be freed in the last of these calls
+            EbErrorType return_error = psnr_calculations(pcs_ptr, scs_ptr, FALSE);
+            if (return_error != EB_ErrorNone) {
+                assert_err(0,
+                           "Couldn't allocate memory for uncompressed 10bit buffers for PSNR "
+                           "calculations");
+            }
+            return_error = ssim_calculations(pcs_ptr, scs_ptr, TRUE /* free memory here */);
+            if (return_error != EB_ErrorNone) {
+                assert_err(0,
+                           "Couldn't allocate memory for uncompressed 10bit buffers for SSIM "
+                           "calculations");
             }
+        }
 
-            if (!superres_recode) {
-                if (scs_ptr->static_config.recon_enabled) {
-                    recon_output(pcs_ptr, scs_ptr);
-                }
-                // post reference picture task in packetization process if it's superres_recode
-                if (pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag) {
-                    // Get Empty PicMgr Results
-                    svt_get_empty_object(context_ptr->picture_demux_fifo_ptr,
-                                         &picture_demux_results_wrapper_ptr);
-
-                    picture_demux_results_rtr = (PictureDemuxResults *)
-                                                    picture_demux_results_wrapper_ptr->object_ptr;
-                    picture_demux_results_rtr->reference_picture_wrapper_ptr =
-                        pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr;
-                    picture_demux_results_rtr->scs_wrapper_ptr = pcs_ptr->scs_wrapper_ptr;
-                    picture_demux_results_rtr->picture_number  = pcs_ptr->picture_number;
-                    picture_demux_results_rtr->picture_type    = EB_PIC_REFERENCE;
-
-                    // Post Reference Picture
-                    svt_post_full_object(picture_demux_results_wrapper_ptr);
-                }
+        if (!superres_recode) {
+            if (scs_ptr->static_config.recon_enabled) {
+                recon_output(pcs_ptr, scs_ptr);
             }
+            // post reference picture task in packetization process if it's superres_recode
+            if (pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag) {
+                // Get Empty PicMgr Results
+                svt_get_empty_object(context_ptr->picture_demux_fifo_ptr,
+                                     &picture_demux_results_wrapper_ptr);
+
+                picture_demux_results_rtr = (PictureDemuxResults *)
+                                                picture_demux_results_wrapper_ptr->object_ptr;
+                picture_demux_results_rtr->reference_picture_wrapper_ptr =
+                    pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr;
+                picture_demux_results_rtr->scs_wrapper_ptr = pcs_ptr->scs_wrapper_ptr;
+                picture_demux_results_rtr->picture_number  = pcs_ptr->picture_number;
+                picture_demux_results_rtr->picture_type    = EB_PIC_REFERENCE;
+
+                // Post Reference Picture
+                svt_post_full_object(picture_demux_results_wrapper_ptr);
+            }
+        }
 
-            tile_cols = pcs_ptr->parent_pcs_ptr->av1_cm->tiles_info.tile_cols;
-            tile_rows = pcs_ptr->parent_pcs_ptr->av1_cm->tiles_info.tile_rows;
-
-            for (int tile_row_idx = 0; tile_row_idx < tile_rows; tile_row_idx++) {
-                for (int tile_col_idx = 0; tile_col_idx < tile_cols; tile_col_idx++) {
-                    const int tile_idx = tile_row_idx * tile_cols + tile_col_idx;
-                    svt_get_empty_object(context_ptr->rest_output_fifo_ptr,
-                                         &rest_results_wrapper_ptr);
-                    rest_results_ptr = (struct RestResults *)rest_results_wrapper_ptr->object_ptr;
-                    rest_results_ptr->pcs_wrapper_ptr = cdef_results_ptr->pcs_wrapper_ptr;
-                    rest_results_ptr->tile_index      = tile_idx;
-                    // Post Rest Results
-                    svt_post_full_object(rest_results_wrapper_ptr);
-                }
+        if (scs_ptr->static_config.enable_frame_stats)
+            pcs_ptr->parent_pcs_ptr->rest_done_time = svt_av1_get_time_us();
+        tile_cols = pcs_ptr->parent_pcs_ptr->av1_cm->tiles_info.tile_cols;
+        tile_rows = pcs_ptr->parent_pcs_ptr->av1_cm->tiles_info.tile_rows;
+
+        for (int tile_row_idx = 0; tile_row_idx < tile_rows; tile_row_idx++) {
+            for (int tile_col_idx = 0; tile_col_idx < tile_cols; tile_col_idx++) {
+                const int tile_idx = tile_row_idx * tile_cols + tile_col_idx;
+                svt_get_empty_object(context_ptr->rest_output_fifo_ptr,
+                                     &rest_results_wrapper_ptr);
+                rest_results_ptr = (struct RestResults *)rest_results_wrapper_ptr->object_ptr;
+                rest_results_ptr->pcs_wrapper_ptr = cdef_results_ptr->pcs_wrapper_ptr;
+                rest_results_ptr->tile_index      = tile_idx;
+                // Post Rest Results
+                svt_post_full_object(rest_results_wrapper_ptr);
             }
         }
-        svt_release_mutex(pcs_ptr->rest_search_mutex);
+    }
+    svt_release_mutex(pcs_ptr->rest_search_mutex);
+
+    // Release input Results
+    svt_release_object(cdef_results_wrapper_ptr);
+}
+
+/******************************************************
+ * Rest Kernel
+ ******************************************************/
+void *rest_kernel(void *input_ptr) {
+    EbThreadContext *thread_context_ptr = (EbThreadContext *)input_ptr;
+    RestContext     *context_ptr        = (RestContext *)thread_context_ptr->priv;
+    EbObjectWrapper *cdef_results_wrapper_ptr;
 
-        // Release input Results
-        svt_release_object(cdef_results_wrapper_ptr);
+    for (;;) {
+        // Get Cdef Results
+        EB_GET_FULL_OBJECT(context_ptr->rest_input_fifo_ptr, &cdef_results_wrapper_ptr);
+        rest_process_task(thread_context_ptr, cdef_results_wrapper_ptr);
     }
 
     return NULL;
@@ -22,5 +22,7 @@ extern EbErrorType rest_context_ctor(EbThreadContext   *thread_context_ptr,
                                      int index, int demux_index);
 
 extern void *rest_kernel(void *input_ptr);
+extern void rest_process_task(EbThreadContext *thread_context_ptr,
+                              EbObjectWrapper *cdef_results_wrapper_ptr);
 
 #endif
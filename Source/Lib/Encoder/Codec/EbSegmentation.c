@@ -80,13 +80,17 @@ uint16_t get_variance_for_cu(const BlockGeom *blk_geom, uint16_t *variance_ptr)
 
 void apply_segmentation_based_quantization(const BlockGeom *blk_geom, PictureControlSet *pcs_ptr,
                                            SuperBlock *sb_ptr, BlkStruct *blk_ptr) {
-    uint16_t           *variance_ptr        = pcs_ptr->parent_pcs_ptr->variance[sb_ptr->index];
     SegmentationParams *segmentation_params = &pcs_ptr->parent_pcs_ptr->frm_hdr.segmentation_params;
-    uint16_t            variance            = get_variance_for_cu(blk_geom, variance_ptr);
-    for (int i = 0; i < MAX_SEGMENTS; i++) {
-        if (variance <= segmentation_params->variance_bin_edge[i]) {
-            blk_ptr->segment_id = i;
-            break;
+    if (pcs_ptr->parent_pcs_ptr->roi_map_present)
+        blk_ptr->segment_id = pcs_ptr->parent_pcs_ptr->roi_seg_map[sb_ptr->index];
+    else {
+        uint16_t *variance_ptr = pcs_ptr->parent_pcs_ptr->variance[sb_ptr->index];
+        uint16_t  variance     = get_variance_for_cu(blk_geom, variance_ptr);
+        for (int i = 0; i < MAX_SEGMENTS; i++) {
+            if (variance <= segmentation_params->variance_bin_edge[i]) {
+                blk_ptr->segment_id = i;
+                break;
+            }
         }
     }
     int32_t q_index = pcs_ptr->parent_pcs_ptr->frm_hdr.quantization_params.base_q_idx +
@@ -113,6 +117,53 @@ void setup_segmentation(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr)
     }
 }
 
+EbErrorType roi_map_to_segments(const SvtAv1RoiMap *roi_map, uint8_t *seg_map, int16_t *seg_qp,
+                                uint8_t *seg_count) {
+    *seg_count = 0;
+    for (uint32_t b64_idx = 0; b64_idx < roi_map->b64_count; ++b64_idx) {
+        const int16_t qp_offset = roi_map->qp_offset[b64_idx];
+        if (qp_offset < -MAXQ || qp_offset > MAXQ)
+            return EB_ErrorBadParameter;
+        uint8_t seg = 0;
+        while (seg < *seg_count && seg_qp[seg] != qp_offset) seg++;
+        if (seg == *seg_count) {
+            if (*seg_count == MAX_SEGMENTS)
+                return EB_ErrorBadParameter;
+            seg_qp[(*seg_count)++] = qp_offset;
+        }
+        if (seg_map)
+            seg_map[b64_idx] = seg;
+    }
+    return EB_ErrorNone;
+}
+
+void roi_map_setup_segmentation(PictureControlSet *pcs_ptr) {
+    PictureParentControlSet *ppcs_ptr            = pcs_ptr->parent_pcs_ptr;
+    SegmentationParams      *segmentation_params = &ppcs_ptr->frm_hdr.segmentation_params;
+    segmentation_params->segmentation_enabled    = ppcs_ptr->roi_map_present;
+    if (!segmentation_params->segmentation_enabled)
+        return;
+    const int32_t base_q_idx = ppcs_ptr->frm_hdr.quantization_params.base_q_idx;
+    segmentation_params->segmentation_update_data     = 1;
+    segmentation_params->segmentation_update_map      = 1;
+    segmentation_params->segmentation_temporal_update = FALSE;
+    segmentation_params->last_active_seg_id           = 0;
+    segmentation_params->seg_id_pre_skip              = 0;
+    memset(segmentation_params->feature_enabled, 0, sizeof(segmentation_params->feature_enabled));
+    memset(segmentation_params->feature_data, 0, sizeof(segmentation_params->feature_data));
+    for (int i = 0; i < ppcs_ptr->roi_seg_count; i++) {
+        // A segment at qindex 0 would be lossless, which the encoder does not support
+        segmentation_params->feature_data[i][SEG_LVL_ALT_Q] = (int16_t)CLIP3(
+            1 - base_q_idx, MAXQ - base_q_idx, ppcs_ptr->roi_seg_qp[i]);
+        segmentation_params->feature_enabled[i][SEG_LVL_ALT_Q] = 1;
+    }
+    calculate_segmentation_data(segmentation_params);
+    // The MD lambda of an SB follows the qindex of its segment
+    for (int sb_addr = 0; sb_addr < pcs_ptr->sb_total_count_pix; ++sb_addr)
+        pcs_ptr->sb_ptr_array[sb_addr]->qindex = (uint8_t)(base_q_idx +
+            segmentation_params->feature_data[ppcs_ptr->roi_seg_map[sb_addr]][SEG_LVL_ALT_Q]);
+}
+
 void calculate_segmentation_data(SegmentationParams *segmentation_params) {
     for (int i = 0; i < MAX_SEGMENTS; i++) {
         for (int j = 0; j < SEG_LVL_MAX; j++) {
@@ -31,4 +31,15 @@ void temporally_update_qps(int32_t *segment_qp_ptr, int32_t *prev_segment_qp_ptr
 
 void calculate_segmentation_data(SegmentationParams *segmentation_params);
 
+/* Maps the qindex offsets of an application ROI map to segments: seg_map gets the segment of
+ * each 64x64 block and seg_qp the offset of each of the seg_count segments.  Fails when an
+ * offset is out of range or the map uses more than MAX_SEGMENTS distinct offsets, seg_map can be
+ * NULL to only check the map. */
+EbErrorType roi_map_to_segments(const SvtAv1RoiMap *roi_map, uint8_t *seg_map, int16_t *seg_qp,
+                                uint8_t *seg_count);
+
+/* Enables the segmentation of a picture with a ROI map (disables it otherwise), once the rate
+ * control picked the frame qindex. */
+void roi_map_setup_segmentation(PictureControlSet *pcs_ptr);
+
 #endif //SVT_AV1_EBSEGMENTATIONS_H
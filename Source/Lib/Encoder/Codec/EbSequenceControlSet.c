@@ -302,7 +302,9 @@ EbErrorType copy_sequence_control_set(SequenceControlSet *dst, SequenceControlSe
         src->mode_decision_configuration_process_init_count;
     dst->enc_dec_process_init_count        = src->enc_dec_process_init_count;
     dst->entropy_coding_process_init_count = src->entropy_coding_process_init_count;
+    dst->gm_search_process_init_count      = src->gm_search_process_init_count;
     dst->total_process_init_count          = src->total_process_init_count;
+    dst->worker_pool_size                  = src->worker_pool_size;
     dst->left_padding                      = src->left_padding;
     dst->right_padding                     = src->right_padding;
     dst->top_padding                       = src->top_padding;
@@ -320,6 +322,9 @@ EbErrorType copy_sequence_control_set(SequenceControlSet *dst, SequenceControlSe
     dst->tpl_segment_col_count_array = src->tpl_segment_col_count_array;
     dst->tpl_segment_row_count_array = src->tpl_segment_row_count_array;
 
+    dst->dlf_segment_column_count = src->dlf_segment_column_count;
+    dst->dlf_segment_row_count    = src->dlf_segment_row_count;
+
     dst->cdef_segment_column_count = src->cdef_segment_column_count;
     dst->cdef_segment_row_count    = src->cdef_segment_row_count;
 
@@ -353,6 +358,7 @@ EbErrorType copy_sequence_control_set(SequenceControlSet *dst, SequenceControlSe
     dst->vq_ctrls                      = src->vq_ctrls;
     dst->mrp_ctrls                     = src->mrp_ctrls;
     dst->passes                        = src->passes;
+    dst->chunk_start_frame             = src->chunk_start_frame;
     dst->ipp_pass_ctrls                = src->ipp_pass_ctrls;
     dst->mid_pass_ctrls                = src->mid_pass_ctrls;
     dst->ipp_was_ds                    = src->ipp_was_ds;
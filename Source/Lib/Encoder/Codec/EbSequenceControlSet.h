@@ -188,6 +188,8 @@ typedef struct SequenceControlSet {
     uint32_t enc_dec_segment_row_count_array[MAX_TEMPORAL_LAYERS];
     uint32_t tpl_segment_col_count_array;
     uint32_t tpl_segment_row_count_array;
+    uint32_t dlf_segment_column_count;
+    uint32_t dlf_segment_row_count;
     uint32_t cdef_segment_column_count;
     uint32_t cdef_segment_row_count;
     uint32_t rest_segment_column_count;
@@ -203,6 +205,8 @@ typedef struct SequenceControlSet {
     uint32_t pa_reference_picture_buffer_init_count;
     uint32_t reference_picture_buffer_init_count;
     uint32_t input_buffer_fifo_init_count;
+    /*!< Input pictures reference the application planes (see release_input_picture) */
+    Bool zero_copy_input;
     uint32_t overlay_input_picture_buffer_init_count;
     uint32_t output_stream_buffer_fifo_init_count;
     uint32_t output_recon_buffer_fifo_init_count;
@@ -235,7 +239,10 @@ typedef struct SequenceControlSet {
     uint32_t         cdef_process_init_count;
     uint32_t         rest_process_init_count;
     uint32_t         tpl_disp_process_init_count;
+    uint32_t         gm_search_process_init_count;
     uint32_t         total_process_init_count;
+    /*!< Number of shared worker threads, 0: one thread per process context */
+    uint32_t         worker_pool_size;
     int32_t          lap_rc;
     TWO_PASS         twopass;
     double           double_frame_rate;
@@ -257,6 +264,8 @@ typedef struct SequenceControlSet {
     int             cqp_base_q;
     uint8_t         is_short_clip; //less than 200 frames, used in VBR and set in multipass encode
     uint8_t         passes;
+    /*!< First frame of the chunk in the full sequence, 0 when the whole sequence is encoded */
+    uint64_t        chunk_start_frame;
     IppPassControls ipp_pass_ctrls;
     MidPassControls mid_pass_ctrls;
     uint8_t         ipp_was_ds;
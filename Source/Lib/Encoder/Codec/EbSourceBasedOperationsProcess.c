@@ -1664,6 +1664,7 @@ static void generate_r0beta(PictureParentControlSet *pcs_ptr) {
         (uint32_t)((pcs_ptr->aligned_height + scs_ptr->sb_size_pix - 1) / scs_ptr->sb_size_pix);
     const int32_t mi_high = sb_mi_sz; // sb size in 4x4 units
     const int32_t mi_wide = sb_mi_sz;
+    double        beta_sum = 0;
     for (uint32_t sb_y = 0; sb_y < picture_sb_height; ++sb_y) {
         for (uint32_t sb_x = 0; sb_x < picture_sb_width; ++sb_x) {
             uint16_t  mi_row = pcs_ptr->sb_geom[sb_y * picture_sb_width + sb_x].origin_y >> 2;
@@ -1699,8 +1700,10 @@ static void generate_r0beta(PictureParentControlSet *pcs_ptr) {
                 assert(beta > 0.0);
             }
             pcs_ptr->pa_me_data->tpl_beta[sb_y * picture_sb_width + sb_x] = beta;
+            beta_sum += beta;
         }
     }
+    pcs_ptr->tpl_avg_beta = beta_sum / (picture_sb_width * picture_sb_height);
     return;
 }
 
@@ -1984,136 +1987,148 @@ EbErrorType tpl_mc_flow(EncodeContext *encode_context_ptr, SequenceControlSet *s
    process one picture of TPL group
 */
 
-void *tpl_disp_kernel(void *input_ptr) {
-    EbThreadContext     *thread_context_ptr = (EbThreadContext *)input_ptr;
+/******************************************************
+ * TPL Dispenser Task
+ *   Runs the TPL dispenser on one TPL dispenser result
+ ******************************************************/
+void tpl_disp_process_task(EbThreadContext *thread_context_ptr,
+                           EbObjectWrapper *in_results_wrapper_ptr) {
     TplDispenserContext *context_ptr        = (TplDispenserContext *)thread_context_ptr->priv;
-    EbObjectWrapper     *in_results_wrapper_ptr;
     TplDispResults      *in_results_ptr;
-    for (;;) {
-        // Get Input Full Object
-        EB_GET_FULL_OBJECT(context_ptr->tpl_disp_input_fifo_ptr, &in_results_wrapper_ptr);
-
-        in_results_ptr = (TplDispResults *)in_results_wrapper_ptr->object_ptr;
-
-        PictureParentControlSet *pcs_ptr = in_results_ptr->pcs_ptr;
-
-        SequenceControlSet *scs_ptr = (SequenceControlSet *)pcs_ptr->scs_ptr;
 
-        int32_t frame_idx           = in_results_ptr->frame_index;
-        context_ptr->coded_sb_count = 0;
-
-        uint16_t tile_group_width_in_sb =
-            pcs_ptr
-                ->tile_group_info[0 /*context_ptr->tile_group_index*/] //  1 tile
-                .tile_group_width_in_sb;
-        EncDecSegments *segments_ptr;
-
-        segments_ptr =
-            pcs_ptr->tpl_disp_segment_ctrl[0 /*context_ptr->tile_group_index*/]; //  1 tile
-        // Segments
-        uint16_t segment_index;
-
-        uint8_t  sb_sz           = (uint8_t)scs_ptr->sb_sz;
-        uint8_t  sb_size_log2    = (uint8_t)svt_log2f(sb_sz);
-        uint32_t pic_width_in_sb = (pcs_ptr->aligned_width + sb_sz - 1) >> sb_size_log2;
-
-        segment_index = 0;
-        // no Tiles path
-        if (scs_ptr->static_config.tile_rows == 0 && scs_ptr->static_config.tile_columns == 0) {
-            // segments loop
-            while (assign_tpl_segments(segments_ptr,
-                                       &segment_index,
-                                       in_results_ptr,
-                                       frame_idx,
-                                       context_ptr->tpl_disp_fb_fifo_ptr) == TRUE) {
-                uint32_t x_sb_start_index;
-                uint32_t y_sb_start_index;
-                uint32_t sb_start_index;
-                uint32_t sb_segment_count;
-                uint32_t sb_segment_index;
-                uint32_t segment_row_index;
-                uint32_t segment_band_index;
-                uint32_t segment_band_size;
-                // SB Loop variables
-                uint32_t x_sb_index;
-                uint32_t y_sb_index;
-
-                x_sb_start_index = segments_ptr->x_start_array[segment_index];
-                y_sb_start_index = segments_ptr->y_start_array[segment_index];
-                sb_start_index   = y_sb_start_index * tile_group_width_in_sb + x_sb_start_index;
-                sb_segment_count = segments_ptr->valid_sb_count_array[segment_index];
-
-                segment_row_index  = segment_index / segments_ptr->segment_band_count;
-                segment_band_index = segment_index -
-                    segment_row_index * segments_ptr->segment_band_count;
-                segment_band_size = (segments_ptr->sb_band_count * (segment_band_index + 1) +
-                                     segments_ptr->segment_band_count - 1) /
-                    segments_ptr->segment_band_count;
-
-                for (y_sb_index = y_sb_start_index, sb_segment_index = sb_start_index;
+    in_results_ptr = (TplDispResults *)in_results_wrapper_ptr->object_ptr;
+
+    PictureParentControlSet *pcs_ptr = in_results_ptr->pcs_ptr;
+
+    SequenceControlSet *scs_ptr = (SequenceControlSet *)pcs_ptr->scs_ptr;
+
+    int32_t frame_idx           = in_results_ptr->frame_index;
+    context_ptr->coded_sb_count = 0;
+
+    uint16_t tile_group_width_in_sb =
+        pcs_ptr
+            ->tile_group_info[0 /*context_ptr->tile_group_index*/] //  1 tile
+            .tile_group_width_in_sb;
+    EncDecSegments *segments_ptr;
+
+    segments_ptr =
+        pcs_ptr->tpl_disp_segment_ctrl[0 /*context_ptr->tile_group_index*/]; //  1 tile
+    // Segments
+    uint16_t segment_index;
+
+    uint8_t  sb_sz           = (uint8_t)scs_ptr->sb_sz;
+    uint8_t  sb_size_log2    = (uint8_t)svt_log2f(sb_sz);
+    uint32_t pic_width_in_sb = (pcs_ptr->aligned_width + sb_sz - 1) >> sb_size_log2;
+
+    segment_index = 0;
+    // no Tiles path
+    if (scs_ptr->static_config.tile_rows == 0 && scs_ptr->static_config.tile_columns == 0) {
+        // segments loop
+        while (assign_tpl_segments(segments_ptr,
+                                   &segment_index,
+                                   in_results_ptr,
+                                   frame_idx,
+                                   context_ptr->tpl_disp_fb_fifo_ptr) == TRUE) {
+            uint32_t x_sb_start_index;
+            uint32_t y_sb_start_index;
+            uint32_t sb_start_index;
+            uint32_t sb_segment_count;
+            uint32_t sb_segment_index;
+            uint32_t segment_row_index;
+            uint32_t segment_band_index;
+            uint32_t segment_band_size;
+            // SB Loop variables
+            uint32_t x_sb_index;
+            uint32_t y_sb_index;
+
+            x_sb_start_index = segments_ptr->x_start_array[segment_index];
+            y_sb_start_index = segments_ptr->y_start_array[segment_index];
+            sb_start_index   = y_sb_start_index * tile_group_width_in_sb + x_sb_start_index;
+            sb_segment_count = segments_ptr->valid_sb_count_array[segment_index];
+
+            segment_row_index  = segment_index / segments_ptr->segment_band_count;
+            segment_band_index = segment_index -
+                segment_row_index * segments_ptr->segment_band_count;
+            segment_band_size = (segments_ptr->sb_band_count * (segment_band_index + 1) +
+                                 segments_ptr->segment_band_count - 1) /
+                segments_ptr->segment_band_count;
+
+            for (y_sb_index = y_sb_start_index, sb_segment_index = sb_start_index;
+                 sb_segment_index < sb_start_index + sb_segment_count;
+                 ++y_sb_index) {
+                for (x_sb_index = x_sb_start_index; x_sb_index < tile_group_width_in_sb &&
+                     (x_sb_index + y_sb_index < segment_band_size) &&
                      sb_segment_index < sb_start_index + sb_segment_count;
-                     ++y_sb_index) {
-                    for (x_sb_index = x_sb_start_index; x_sb_index < tile_group_width_in_sb &&
-                         (x_sb_index + y_sb_index < segment_band_size) &&
-                         sb_segment_index < sb_start_index + sb_segment_count;
-                         ++x_sb_index, ++sb_segment_index) {
-                        uint16_t tile_group_y_sb_start =
-                            pcs_ptr
-                                ->tile_group_info[0 /*context_ptr->tile_group_index*/] //  1 tile
-                                .tile_group_sb_start_y;
-                        uint16_t tile_group_x_sb_start =
-                            pcs_ptr
-                                ->tile_group_info[0 /*context_ptr->tile_group_index*/] //  1 tile
-                                .tile_group_sb_start_x;
-
-                        context_ptr->sb_index = (uint16_t)((y_sb_index + tile_group_y_sb_start) *
-                                                               pic_width_in_sb +
-                                                           x_sb_index + tile_group_x_sb_start);
-
-                        // TPL dispenser per SB (64)
-                        SbParams *sb_params = &scs_ptr->sb_params_array[context_ptr->sb_index];
-                        tpl_mc_flow_dispenser_sb_generic(
-                            pcs_ptr->scs_ptr->encode_context_ptr,
-                            scs_ptr,
-                            pcs_ptr,
-                            frame_idx,
-                            context_ptr->sb_index,
-                            in_results_ptr->qIndex,
-                            (sb_params->width == 64 && sb_params->height == 64)
-                                ? pcs_ptr->tpl_ctrls.dispenser_search_level
-                                : 0);
-                        context_ptr->coded_sb_count++;
-                    }
-
-                    x_sb_start_index = (x_sb_start_index > 0) ? x_sb_start_index - 1 : 0;
+                     ++x_sb_index, ++sb_segment_index) {
+                    uint16_t tile_group_y_sb_start =
+                        pcs_ptr
+                            ->tile_group_info[0 /*context_ptr->tile_group_index*/] //  1 tile
+                            .tile_group_sb_start_y;
+                    uint16_t tile_group_x_sb_start =
+                        pcs_ptr
+                            ->tile_group_info[0 /*context_ptr->tile_group_index*/] //  1 tile
+                            .tile_group_sb_start_x;
+
+                    context_ptr->sb_index = (uint16_t)((y_sb_index + tile_group_y_sb_start) *
+                                                           pic_width_in_sb +
+                                                       x_sb_index + tile_group_x_sb_start);
+
+                    // TPL dispenser per SB (64)
+                    SbParams *sb_params = &scs_ptr->sb_params_array[context_ptr->sb_index];
+                    tpl_mc_flow_dispenser_sb_generic(
+                        pcs_ptr->scs_ptr->encode_context_ptr,
+                        scs_ptr,
+                        pcs_ptr,
+                        frame_idx,
+                        context_ptr->sb_index,
+                        in_results_ptr->qIndex,
+                        (sb_params->width == 64 && sb_params->height == 64)
+                            ? pcs_ptr->tpl_ctrls.dispenser_search_level
+                            : 0);
+                    context_ptr->coded_sb_count++;
                 }
+
+                x_sb_start_index = (x_sb_start_index > 0) ? x_sb_start_index - 1 : 0;
             }
+        }
 
-            svt_block_on_mutex(pcs_ptr->tpl_disp_mutex);
-            pcs_ptr->tpl_disp_coded_sb_count += (uint32_t)context_ptr->coded_sb_count;
-            Bool last_sb_flag = (pcs_ptr->sb_total_count == pcs_ptr->tpl_disp_coded_sb_count);
+        svt_block_on_mutex(pcs_ptr->tpl_disp_mutex);
+        pcs_ptr->tpl_disp_coded_sb_count += (uint32_t)context_ptr->coded_sb_count;
+        Bool last_sb_flag = (pcs_ptr->sb_total_count == pcs_ptr->tpl_disp_coded_sb_count);
 
-            svt_release_mutex(pcs_ptr->tpl_disp_mutex);
-            if (last_sb_flag)
-                svt_post_semaphore(pcs_ptr->tpl_disp_done_semaphore);
-        } else {
-            // Tiles path does not suupport segments
-            for (uint32_t sb_index = 0; sb_index < pcs_ptr->sb_total_count; ++sb_index) {
-                SbParams *sb_params = &scs_ptr->sb_params_array[sb_index];
-                tpl_mc_flow_dispenser_sb_generic(pcs_ptr->scs_ptr->encode_context_ptr,
-                                                 scs_ptr,
-                                                 pcs_ptr,
-                                                 frame_idx,
-                                                 sb_index,
-                                                 in_results_ptr->qIndex,
-                                                 (sb_params->width == 64 && sb_params->height == 64)
-                                                     ? pcs_ptr->tpl_ctrls.dispenser_search_level
-                                                     : 0);
-            }
+        svt_release_mutex(pcs_ptr->tpl_disp_mutex);
+        if (last_sb_flag)
             svt_post_semaphore(pcs_ptr->tpl_disp_done_semaphore);
+    } else {
+        // Tiles path does not suupport segments
+        for (uint32_t sb_index = 0; sb_index < pcs_ptr->sb_total_count; ++sb_index) {
+            SbParams *sb_params = &scs_ptr->sb_params_array[sb_index];
+            tpl_mc_flow_dispenser_sb_generic(pcs_ptr->scs_ptr->encode_context_ptr,
+                                             scs_ptr,
+                                             pcs_ptr,
+                                             frame_idx,
+                                             sb_index,
+                                             in_results_ptr->qIndex,
+                                             (sb_params->width == 64 && sb_params->height == 64)
+                                                 ? pcs_ptr->tpl_ctrls.dispenser_search_level
+                                                 : 0);
         }
-        svt_release_object(in_results_wrapper_ptr);
+        svt_post_semaphore(pcs_ptr->tpl_disp_done_semaphore);
     }
+    svt_release_object(in_results_wrapper_ptr);
+}
+
+void *tpl_disp_kernel(void *input_ptr) {
+    EbThreadContext     *thread_context_ptr = (EbThreadContext *)input_ptr;
+    TplDispenserContext *context_ptr        = (TplDispenserContext *)thread_context_ptr->priv;
+    EbObjectWrapper     *in_results_wrapper_ptr;
+
+    for (;;) {
+        // Get Input Full Object
+        EB_GET_FULL_OBJECT(context_ptr->tpl_disp_input_fifo_ptr, &in_results_wrapper_ptr);
+        tpl_disp_process_task(thread_context_ptr, in_results_wrapper_ptr);
+    }
+
     return NULL;
 }
 
@@ -21,6 +21,8 @@
 EbErrorType  tpl_disp_context_ctor(EbThreadContext   *thread_context_ptr,
                                    const EbEncHandle *enc_handle_ptr, int index, int tasks_index);
 extern void *tpl_disp_kernel(void *input_ptr);
+extern void tpl_disp_process_task(EbThreadContext *thread_context_ptr,
+                                  EbObjectWrapper *in_results_wrapper_ptr);
 EbErrorType  source_based_operations_context_ctor(EbThreadContext   *thread_context_ptr,
                                                   const EbEncHandle *enc_handle_ptr, int tpl_index,
                                                   int index);
@@ -5253,6 +5253,9 @@ void pad_and_decimate_filtered_pic(PictureParentControlSet *picture_control_set_
                                             src_object->quarter_downsampled_picture_ptr,
                                             src_object->sixteenth_downsampled_picture_ptr);
     }
+    // GM corners have to be detected on the filtered picture
+    for (uint8_t level = 0; level <= GM_DOWN16; level++)
+        src_object->gm_corners_picture_number[level] = (uint64_t)~0;
 }
 
 // save original enchanced_picture_ptr buffer in a separate buffer (to be replaced by the temporally filtered pic)
@@ -60,6 +60,10 @@ extern "C" {
     RTCD_EXTERN int64_t(*svt_aom_sse)(const uint8_t *a, int a_stride, const uint8_t *b, int b_stride, int width, int height);
     int64_t svt_aom_highbd_sse_c(const uint8_t *a8, int a_stride, const uint8_t *b8, int b_stride, int width, int height);
     RTCD_EXTERN int64_t(*svt_aom_highbd_sse)(const uint8_t *a8, int a_stride, const uint8_t *b8, int b_stride, int width, int height);
+    void svt_aom_ssim_parms_8x8_c(const uint8_t *s, int sp, const uint8_t *r, int rp, uint32_t *sum_s, uint32_t *sum_r, uint32_t *sum_sq_s, uint32_t *sum_sq_r, uint32_t *sum_sxr);
+    RTCD_EXTERN void(*svt_aom_ssim_parms_8x8)(const uint8_t *s, int sp, const uint8_t *r, int rp, uint32_t *sum_s, uint32_t *sum_r, uint32_t *sum_sq_s, uint32_t *sum_sq_r, uint32_t *sum_sxr);
+    void svt_aom_highbd_ssim_parms_8x8_c(const uint8_t *s, int sp, const uint8_t *sinc, int spinc, const uint16_t *r, int rp, uint32_t *sum_s, uint32_t *sum_r, uint32_t *sum_sq_s, uint32_t *sum_sq_r, uint32_t *sum_sxr);
+    RTCD_EXTERN void(*svt_aom_highbd_ssim_parms_8x8)(const uint8_t *s, int sp, const uint8_t *sinc, int spinc, const uint16_t *r, int rp, uint32_t *sum_s, uint32_t *sum_r, uint32_t *sum_sq_s, uint32_t *sum_sq_r, uint32_t *sum_sxr);
     void svt_av1_wedge_compute_delta_squares_c(int16_t *d, const int16_t *a, const int16_t *b, int N);
     RTCD_EXTERN void(*svt_av1_wedge_compute_delta_squares)(int16_t *d, const int16_t *a, const int16_t *b, int N);
     int8_t svt_av1_wedge_sign_from_residuals_c(const int16_t *ds, const uint8_t *m, int N, int64_t limit);
@@ -775,6 +779,12 @@ extern "C" {
     RTCD_EXTERN void(*svt_av1_get_gradient_hist)(const uint8_t *src, int src_stride, int rows, int cols, uint64_t *hist);
     double svt_av1_compute_cross_correlation_c(unsigned char *im1, int stride1, int x1, int y1, unsigned char *im2, int stride2, int x2, int y2);
     RTCD_EXTERN double(*svt_av1_compute_cross_correlation)(unsigned char *im1, int stride1, int x1, int y1, unsigned char *im2, int stride2, int x2, int y2);
+    double svt_av1_get_block_mean_c(const uint8_t *data, int32_t w, int32_t h, int32_t stride, int32_t x_o, int32_t y_o, int32_t block_size, int32_t use_highbd);
+    RTCD_EXTERN double(*svt_av1_get_block_mean)(const uint8_t *data, int32_t w, int32_t h, int32_t stride, int32_t x_o, int32_t y_o, int32_t block_size, int32_t use_highbd);
+    double svt_av1_get_noise_var_c(const uint8_t *data, const uint8_t *denoised, int32_t stride, int32_t w, int32_t h, int32_t x_o, int32_t y_o, int32_t block_size_x, int32_t block_size_y, int32_t use_highbd);
+    RTCD_EXTERN double(*svt_av1_get_noise_var)(const uint8_t *data, const uint8_t *denoised, int32_t stride, int32_t w, int32_t h, int32_t x_o, int32_t y_o, int32_t block_size_x, int32_t block_size_y, int32_t use_highbd);
+    void svt_av1_add_block_observations_internal_c(uint32_t n, const double val, const double recp_sqr_norm, double *buffer, double *buffer_norm, double *b, double *A);
+    RTCD_EXTERN void(*svt_av1_add_block_observations_internal)(uint32_t n, const double val, const double recp_sqr_norm, double *buffer, double *buffer_norm, double *b, double *A);
     void svt_av1_k_means_dim1_c(const int* data, int* centroids, uint8_t* indices, int n, int k, int max_itr);
     RTCD_EXTERN void(*svt_av1_k_means_dim1)(const int* data, int* centroids, uint8_t* indices, int n, int k, int max_itr);
     void svt_av1_k_means_dim2_c(const int* data, int* centroids, uint8_t* indices, int n, int k, int max_itr);
@@ -856,6 +866,8 @@ extern "C" {
 
     RTCD_EXTERN void(*svt_ext_all_sad_calculation_8x8_16x16)(uint8_t *src, uint32_t src_stride, uint8_t *ref, uint32_t ref_stride, uint32_t mv, uint8_t out_8x8, uint32_t *p_best_sad_8x8, uint32_t *p_best_sad_16x16, uint32_t *p_best_mv8x8, uint32_t *p_best_mv16x16, uint32_t p_eight_sad16x16[16][8], uint32_t p_eight_sad8x8[64][8], Bool sub_sad);
     RTCD_EXTERN void(*svt_ext_eight_sad_calculation_32x32_64x64)(uint32_t p_sad16x16[16][8], uint32_t *p_best_sad_32x32, uint32_t *p_best_sad_64x64, uint32_t *p_best_mv32x32, uint32_t *p_best_mv64x64, uint32_t mv, uint32_t p_sad32x32[4][8]);
+    void svt_ext_fullpel_search_row_c(uint8_t *src, uint32_t src_stride, uint8_t *ref, uint32_t ref_stride, uint32_t mv, uint32_t search_area_width, uint8_t out_8x8, Bool sub_sad, uint32_t *p_best_sad_8x8, uint32_t *p_best_sad_16x16, uint32_t *p_best_sad_32x32, uint32_t *p_best_sad_64x64, uint32_t *p_best_mv8x8, uint32_t *p_best_mv16x16, uint32_t *p_best_mv32x32, uint32_t *p_best_mv64x64);
+    RTCD_EXTERN void(*svt_ext_fullpel_search_row)(uint8_t *src, uint32_t src_stride, uint8_t *ref, uint32_t ref_stride, uint32_t mv, uint32_t search_area_width, uint8_t out_8x8, Bool sub_sad, uint32_t *p_best_sad_8x8, uint32_t *p_best_sad_16x16, uint32_t *p_best_sad_32x32, uint32_t *p_best_sad_64x64, uint32_t *p_best_mv8x8, uint32_t *p_best_mv16x16, uint32_t *p_best_mv32x32, uint32_t *p_best_mv64x64);
     RTCD_EXTERN void(*svt_initialize_buffer_32bits)(uint32_t* pointer, uint32_t count128, uint32_t count32, uint32_t value);
     RTCD_EXTERN uint32_t(*svt_nxm_sad_kernel_sub_sampled)(const uint8_t *src, uint32_t src_stride, const uint8_t *ref, uint32_t ref_stride, uint32_t height, uint32_t width);
     RTCD_EXTERN uint32_t(*svt_nxm_sad_kernel)(const uint8_t *src, uint32_t src_stride, const uint8_t *ref, uint32_t ref_stride, uint32_t height, uint32_t width);
@@ -881,6 +893,10 @@ extern "C" {
 #ifdef ARCH_X86_64
     int64_t svt_aom_sse_avx2(const uint8_t *a, int a_stride, const uint8_t *b, int b_stride, int width, int height);
     int64_t svt_aom_highbd_sse_avx2(const uint8_t *a8, int a_stride, const uint8_t *b8, int b_stride, int width, int height);
+    void svt_aom_ssim_parms_8x8_avx2(const uint8_t *s, int sp, const uint8_t *r, int rp, uint32_t *sum_s, uint32_t *sum_r, uint32_t *sum_sq_s, uint32_t *sum_sq_r, uint32_t *sum_sxr);
+    void svt_aom_ssim_parms_8x8_avx512(const uint8_t *s, int sp, const uint8_t *r, int rp, uint32_t *sum_s, uint32_t *sum_r, uint32_t *sum_sq_s, uint32_t *sum_sq_r, uint32_t *sum_sxr);
+    void svt_aom_highbd_ssim_parms_8x8_avx2(const uint8_t *s, int sp, const uint8_t *sinc, int spinc, const uint16_t *r, int rp, uint32_t *sum_s, uint32_t *sum_r, uint32_t *sum_sq_s, uint32_t *sum_sq_r, uint32_t *sum_sxr);
+    void svt_aom_highbd_ssim_parms_8x8_avx512(const uint8_t *s, int sp, const uint8_t *sinc, int spinc, const uint16_t *r, int rp, uint32_t *sum_s, uint32_t *sum_r, uint32_t *sum_sq_s, uint32_t *sum_sq_r, uint32_t *sum_sxr);
 
     void svt_av1_wedge_compute_delta_squares_avx2(int16_t *d, const int16_t *a, const int16_t *b, int N);
 
@@ -1530,6 +1546,11 @@ extern "C" {
 
     double svt_av1_compute_cross_correlation_sse4_1(unsigned char *im1, int stride1, int x1, int y1, unsigned char *im2, int stride2, int x2, int y2);
     double svt_av1_compute_cross_correlation_avx2(unsigned char *im1, int stride1, int x1, int y1, unsigned char *im2, int stride2, int x2, int y2);
+    double svt_av1_compute_cross_correlation_avx512(unsigned char *im1, int stride1, int x1, int y1, unsigned char *im2, int stride2, int x2, int y2);
+
+    double svt_av1_get_block_mean_avx2(const uint8_t *data, int32_t w, int32_t h, int32_t stride, int32_t x_o, int32_t y_o, int32_t block_size, int32_t use_highbd);
+    double svt_av1_get_noise_var_avx2(const uint8_t *data, const uint8_t *denoised, int32_t stride, int32_t w, int32_t h, int32_t x_o, int32_t y_o, int32_t block_size_x, int32_t block_size_y, int32_t use_highbd);
+    void svt_av1_add_block_observations_internal_avx2(uint32_t n, const double val, const double recp_sqr_norm, double *buffer, double *buffer_norm, double *b, double *A);
 
     void svt_av1_k_means_dim1_avx2(const int* data, int* centroids, uint8_t* indices, int n, int k, int max_itr);
 
@@ -1581,6 +1602,16 @@ extern "C" {
         uint32_t *p_best_sad_64x64,
         uint32_t *p_best_mv32x32, uint32_t *p_best_mv64x64,
         uint32_t mv, uint32_t p_sad32x32[4][8]);
+    void svt_ext_fullpel_search_row_avx2(uint8_t *src, uint32_t src_stride, uint8_t *ref,
+        uint32_t ref_stride, uint32_t mv, uint32_t search_area_width, uint8_t out_8x8,
+        Bool sub_sad, uint32_t *p_best_sad_8x8, uint32_t *p_best_sad_16x16,
+        uint32_t *p_best_sad_32x32, uint32_t *p_best_sad_64x64, uint32_t *p_best_mv8x8,
+        uint32_t *p_best_mv16x16, uint32_t *p_best_mv32x32, uint32_t *p_best_mv64x64);
+    void svt_ext_fullpel_search_row_avx512(uint8_t *src, uint32_t src_stride, uint8_t *ref,
+        uint32_t ref_stride, uint32_t mv, uint32_t search_area_width, uint8_t out_8x8,
+        Bool sub_sad, uint32_t *p_best_sad_8x8, uint32_t *p_best_sad_16x16,
+        uint32_t *p_best_sad_32x32, uint32_t *p_best_sad_64x64, uint32_t *p_best_mv8x8,
+        uint32_t *p_best_mv16x16, uint32_t *p_best_mv32x32, uint32_t *p_best_mv64x64);
     uint32_t svt_compute4x_m_sad_avx2_intrin(
         const uint8_t *src, // input parameter, source samples Ptr
         uint32_t       src_stride, // input parameter, source stride
@@ -13,6 +13,13 @@
 #include <limits.h>
 #include <math.h>
 #include <stdio.h>
+#ifdef _WIN32
+#define fseeko _fseeki64
+#define ftello _ftelli64
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
 #include "aom_dsp_rtcd.h"
 #include "EbDefinitions.h"
@@ -181,6 +188,130 @@ void svt_av1_end_first_pass(PictureParentControlSet *pcs_ptr) {
         output_stats(scs_ptr, &total_stats, pcs_ptr->picture_number + 1);
     }
 }
+/******************************************************
+ * svt_av1_range_total_stats
+ *   Writes the totals of stats[0, count) to total_stats
+ ******************************************************/
+void svt_av1_range_total_stats(const FIRSTPASS_STATS *stats, uint64_t count,
+                               FIRSTPASS_STATS *total_stats) {
+    uint64_t total_num_bits = 0;
+    svt_av1_twopass_zero_stats(total_stats);
+    for (uint64_t i = 0; i < count; i++) {
+        svt_av1_accumulate_stats(total_stats, stats + i);
+        total_num_bits += stats[i].stat_struct.total_num_bits;
+    }
+    total_stats->stat_struct.total_num_bits = total_num_bits;
+}
+/******************************************************
+ * svt_av1_init_stats_header
+ *   Header of the stats file holding stats_sz bytes of
+ *   records, the last one being the totals
+ ******************************************************/
+void svt_av1_init_stats_header(SvtAv1StatsHeader *header, uint64_t stats_sz) {
+    const uint64_t records = stats_sz / sizeof(FIRSTPASS_STATS);
+    memset(header, 0, sizeof(*header));
+    header->magic       = SVT_AV1_STATS_MAGIC;
+    header->version     = SVT_AV1_STATS_VERSION;
+    header->header_size = (uint16_t)sizeof(SvtAv1StatsHeader);
+    header->record_size = (uint32_t)sizeof(FIRSTPASS_STATS);
+    header->frame_count = records ? records - 1 : 0;
+}
+/******************************************************
+ * svt_av1_check_stats_header
+ *   Returns TRUE when the sz bytes of a stats file (or of
+ *   an in-memory copy) start with a header this library
+ *   can read, and hold all the records it announces
+ ******************************************************/
+Bool svt_av1_check_stats_header(const SvtAv1StatsHeader *header, uint64_t sz) {
+    if (sz < sizeof(SvtAv1StatsHeader) || header->magic != SVT_AV1_STATS_MAGIC ||
+        header->version != SVT_AV1_STATS_VERSION ||
+        header->header_size < sizeof(SvtAv1StatsHeader) ||
+        header->record_size != sizeof(FIRSTPASS_STATS))
+        return FALSE;
+    return (sz - header->header_size) / header->record_size > header->frame_count;
+}
+/******************************************************
+ * svt_av1_map_stats
+ *   Maps the records [first_frame, first_frame + frame_count)
+ *   of a stats file followed by one totals record.  The
+ *   record following the range is reused for the totals of
+ *   the range, the mapping is private so the file is not
+ *   modified.  Without mmap the range is read to memory.
+ ******************************************************/
+EbErrorType svt_av1_map_stats(const char *path, uint64_t first_frame, uint64_t frame_count,
+                              SvtAv1FixedBuf *rc_stats_buffer) {
+    SvtAv1StatsHeader header;
+    FILE             *file;
+    uint64_t          file_size;
+    EbErrorType       return_error = EB_ErrorBadParameter;
+
+    rc_stats_buffer->buf = NULL;
+    rc_stats_buffer->sz  = 0;
+    FOPEN(file, path, "rb");
+    if (!file)
+        return EB_ErrorBadParameter;
+    fseeko(file, 0, SEEK_END);
+    file_size = (uint64_t)ftello(file);
+    fseeko(file, 0, SEEK_SET);
+    if (fread(&header, 1, sizeof(header), file) != sizeof(header) ||
+        !svt_av1_check_stats_header(&header, file_size) || first_frame >= header.frame_count)
+        goto done;
+    if (!frame_count)
+        frame_count = header.frame_count - first_frame;
+    if (frame_count > header.frame_count - first_frame)
+        goto done;
+
+    const uint64_t offset = header.header_size + first_frame * header.record_size;
+    const uint64_t size   = (frame_count + 1) * header.record_size;
+    FIRSTPASS_STATS *stats;
+#ifndef _WIN32
+    const uint64_t align_mask = (uint64_t)sysconf(_SC_PAGESIZE) - 1;
+    const uint64_t align      = offset & align_mask;
+    uint8_t       *base       = mmap(NULL,
+                          size + align,
+                          PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE,
+                          fileno(file),
+                          (off_t)(offset - align));
+    if (base == MAP_FAILED) {
+        return_error = EB_ErrorInsufficientResources;
+        goto done;
+    }
+    stats = (FIRSTPASS_STATS *)(base + align);
+#else
+    stats = (FIRSTPASS_STATS *)malloc(size);
+    if (!stats) {
+        return_error = EB_ErrorInsufficientResources;
+        goto done;
+    }
+    fseeko(file, offset, SEEK_SET);
+    if (fread(stats, 1, size, file) != size) {
+        free(stats);
+        goto done;
+    }
+#endif
+    if (frame_count != header.frame_count)
+        svt_av1_range_total_stats(stats, frame_count, stats + frame_count);
+    rc_stats_buffer->buf = stats;
+    rc_stats_buffer->sz  = size;
+    return_error         = EB_ErrorNone;
+done:
+    fclose(file);
+    return return_error;
+}
+void svt_av1_unmap_stats(SvtAv1FixedBuf *rc_stats_buffer) {
+    if (rc_stats_buffer->buf) {
+#ifndef _WIN32
+        const uintptr_t align_mask = (uintptr_t)sysconf(_SC_PAGESIZE) - 1;
+        uint8_t        *base       = (uint8_t *)((uintptr_t)rc_stats_buffer->buf & ~align_mask);
+        munmap(base, (uint8_t *)rc_stats_buffer->buf - base + rc_stats_buffer->sz);
+#else
+        free(rc_stats_buffer->buf);
+#endif
+    }
+    rc_stats_buffer->buf = NULL;
+    rc_stats_buffer->sz  = 0;
+}
 #define UL_INTRA_THRESH 50
 #define INVALID_ROW -1
 // Accumulates motion vector stats.
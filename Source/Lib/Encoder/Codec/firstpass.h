@@ -169,6 +169,9 @@ typedef struct {
     FIRSTPASS_STATS *total_stats;
     FIRSTPASS_STATS *total_left_stats;
     int64_t          last_frame_accumulated;
+    // Chunked encoding: budget of the chunk relative to its duration, computed once
+    // as the totals of the last chunk replace the totals of the sequence
+    double chunk_bits_factor;
 } STATS_BUFFER_CTX;
 
 /*!\endcond */
@@ -270,6 +273,13 @@ struct TileDataEnc;
 
 void svt_av1_twopass_zero_stats(FIRSTPASS_STATS *section);
 void svt_av1_accumulate_stats(FIRSTPASS_STATS *section, const FIRSTPASS_STATS *frame);
+void svt_av1_range_total_stats(const FIRSTPASS_STATS *stats, uint64_t count,
+                               FIRSTPASS_STATS *total_stats);
+void svt_av1_init_stats_header(SvtAv1StatsHeader *header, uint64_t stats_sz);
+Bool svt_av1_check_stats_header(const SvtAv1StatsHeader *header, uint64_t sz);
+EbErrorType svt_av1_map_stats(const char *path, uint64_t first_frame, uint64_t frame_count,
+                              SvtAv1FixedBuf *rc_stats_buffer);
+void        svt_av1_unmap_stats(SvtAv1FixedBuf *rc_stats_buffer);
 /*!\endcond */
 
 #ifdef __cplusplus
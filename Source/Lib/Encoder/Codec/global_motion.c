@@ -15,7 +15,6 @@
 
 #include "global_motion.h"
 #include "EbUtility.h"
-#include "corner_detect.h"
 #include "corner_match.h"
 #include "ransac.h"
 
@@ -278,22 +277,18 @@ static void get_inliers_from_indices(MotionModel *params, int *correspondences)
 static int compute_global_motion_feature_based(TransformationType type, unsigned char *frm_buffer,
                                                int frm_width, int frm_height, int frm_stride,
                                                int *frm_corners, int num_frm_corners, uint8_t *ref,
-                                               int ref_stride, int bit_depth,
+                                               int ref_stride, int *ref_corners,
+                                               int num_ref_corners, int bit_depth,
                                                int         *num_inliers_by_motion,
                                                MotionModel *params_by_motion, int num_motions) {
     (void)bit_depth;
     assert(bit_depth == EB_8BIT);
     int            i;
-    int            num_ref_corners;
     int            num_correspondences;
     int           *correspondences;
-    int            ref_corners[2 * MAX_CORNERS];
     unsigned char *ref_buffer = ref;
     RansacFunc     ransac     = svt_av1_get_ransac_type(type);
 
-    num_ref_corners = svt_av1_fast_corner_detect(
-        ref_buffer, frm_width, frm_height, ref_stride, ref_corners, MAX_CORNERS);
-
     // find correspondences between the two images
     correspondences     = (int *)malloc(num_frm_corners * 4 * sizeof(*correspondences));
     num_correspondences = svt_av1_determine_correspondence(frm_buffer,
@@ -333,7 +328,8 @@ static int compute_global_motion_feature_based(TransformationType type, unsigned
 
 int svt_av1_compute_global_motion(TransformationType type, unsigned char *frm_buffer, int frm_width,
                                   int frm_height, int frm_stride, int *frm_corners,
-                                  int num_frm_corners, uint8_t *ref, int ref_stride, int bit_depth,
+                                  int num_frm_corners, uint8_t *ref, int ref_stride,
+                                  int *ref_corners, int num_ref_corners, int bit_depth,
                                   GlobalMotionEstimationType gm_estimation_type,
                                   int *num_inliers_by_motion, MotionModel *params_by_motion,
                                   int num_motions) {
@@ -348,6 +344,8 @@ int svt_av1_compute_global_motion(TransformationType type, unsigned char *frm_bu
                                                    num_frm_corners,
                                                    ref,
                                                    ref_stride,
+                                                   ref_corners,
+                                                   num_ref_corners,
                                                    bit_depth,
                                                    num_inliers_by_motion,
                                                    params_by_motion,
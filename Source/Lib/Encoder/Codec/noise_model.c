@@ -59,9 +59,9 @@ void compressed_pack_sb(uint8_t *in8_bit_buffer, uint32_t in8_stride, uint8_t *i
 GET_BLOCK_MEAN(uint8_t, lowbd);
 GET_BLOCK_MEAN(uint16_t, highbd);
 
-static INLINE double get_block_mean(const uint8_t *data, int32_t w, int32_t h, int32_t stride,
-                                    int32_t x_o, int32_t y_o, int32_t block_size,
-                                    int32_t use_highbd) {
+double svt_av1_get_block_mean_c(const uint8_t *data, int32_t w, int32_t h, int32_t stride,
+                                int32_t x_o, int32_t y_o, int32_t block_size,
+                                int32_t use_highbd) {
     if (use_highbd)
         return get_block_mean_highbd((const uint16_t *)data, w, h, stride, x_o, y_o, block_size);
     return get_block_mean_lowbd(data, w, h, stride, x_o, y_o, block_size);
@@ -98,20 +98,20 @@ static INLINE double get_block_mean(const uint8_t *data, int32_t w, int32_t h, i
 GET_NOISE_VAR(uint8_t, lowbd);
 GET_NOISE_VAR(uint16_t, highbd);
 
-static INLINE double get_noise_var(const uint8_t *data, const uint8_t *denoised, int32_t w,
-                                   int32_t h, int32_t stride, int32_t x_o, int32_t y_o,
-                                   int32_t block_size_x, int32_t block_size_y, int32_t use_highbd) {
+double svt_av1_get_noise_var_c(const uint8_t *data, const uint8_t *denoised, int32_t stride,
+                               int32_t w, int32_t h, int32_t x_o, int32_t y_o,
+                               int32_t block_size_x, int32_t block_size_y, int32_t use_highbd) {
     if (use_highbd)
         return get_noise_var_highbd((const uint16_t *)data,
                                     (const uint16_t *)denoised,
+                                    stride,
                                     w,
                                     h,
-                                    stride,
                                     x_o,
                                     y_o,
                                     block_size_x,
                                     block_size_y);
-    return get_noise_var_lowbd(data, denoised, w, h, stride, x_o, y_o, block_size_x, block_size_y);
+    return get_noise_var_lowbd(data, denoised, stride, w, h, x_o, y_o, block_size_x, block_size_y);
 }
 
 static void equation_system_free(AomEquationSystem *eqns) {
@@ -783,6 +783,19 @@ void svt_aom_noise_model_free(AomNoiseModel *model) {
     memset(model, 0, sizeof(*model));
 }
 
+// Brings the model back to its state after svt_aom_noise_model_init without reallocating it
+static void noise_model_reset(AomNoiseModel *model) {
+    for (int32_t c = 0; c < 3; ++c) {
+        AomNoiseState *states[2] = {&model->combined_state[c], &model->latest_state[c]};
+        for (int32_t i = 0; i < 2; ++i) {
+            equation_system_clear(&states[i]->eqns);
+            noise_strength_solver_clear(&states[i]->strength_solver);
+            states[i]->ar_gain          = 1.0;
+            states[i]->num_observations = 0;
+        }
+    }
+}
+
 // Extracts the neighborhood defined by coords around point (x, y) from
 // the difference between the data and denoised images. Also extracts the
 // entry (possibly downsampled) for (x, y) in the alt_data (e.g., luma).
@@ -826,6 +839,53 @@ void svt_aom_noise_model_free(AomNoiseModel *model) {
 EXTRACT_AR_ROW(uint8_t, lowbd);
 EXTRACT_AR_ROW(uint16_t, highbd);
 
+// Adds the normal equations of one observation to the equation system, buffer holds the n
+// samples of the neighborhood and val the sample they predict
+void svt_av1_add_block_observations_internal_c(uint32_t n, const double val,
+                                               const double recp_sqr_norm, double *buffer,
+                                               double *buffer_norm, double *b, double *A) {
+    uint32_t i;
+    for (i = 0; i + 8 - 1 < n; i += 8) {
+        buffer_norm[i + 0] = buffer[i + 0] * recp_sqr_norm;
+        buffer_norm[i + 1] = buffer[i + 1] * recp_sqr_norm;
+        buffer_norm[i + 2] = buffer[i + 2] * recp_sqr_norm;
+        buffer_norm[i + 3] = buffer[i + 3] * recp_sqr_norm;
+        buffer_norm[i + 4] = buffer[i + 4] * recp_sqr_norm;
+        buffer_norm[i + 5] = buffer[i + 5] * recp_sqr_norm;
+        buffer_norm[i + 6] = buffer[i + 6] * recp_sqr_norm;
+        buffer_norm[i + 7] = buffer[i + 7] * recp_sqr_norm;
+        b[i + 0] += buffer_norm[i + 0] * val;
+        b[i + 1] += buffer_norm[i + 1] * val;
+        b[i + 2] += buffer_norm[i + 2] * val;
+        b[i + 3] += buffer_norm[i + 3] * val;
+        b[i + 4] += buffer_norm[i + 4] * val;
+        b[i + 5] += buffer_norm[i + 5] * val;
+        b[i + 6] += buffer_norm[i + 6] * val;
+        b[i + 7] += buffer_norm[i + 7] * val;
+    }
+    for (; i < n; ++i) {
+        buffer_norm[i] = buffer[i] * recp_sqr_norm;
+        b[i] += buffer_norm[i] * val;
+    }
+
+    for (i = 0; i < n; ++i) {
+        uint32_t     j             = 0;
+        const double buffer_norm_i = buffer_norm[i];
+
+        for (j = 0; j + 8 - 1 < n; j += 8) {
+            A[i * n + j + 0] += (buffer_norm_i * buffer[j + 0]);
+            A[i * n + j + 1] += (buffer_norm_i * buffer[j + 1]);
+            A[i * n + j + 2] += (buffer_norm_i * buffer[j + 2]);
+            A[i * n + j + 3] += (buffer_norm_i * buffer[j + 3]);
+            A[i * n + j + 4] += (buffer_norm_i * buffer[j + 4]);
+            A[i * n + j + 5] += (buffer_norm_i * buffer[j + 5]);
+            A[i * n + j + 6] += (buffer_norm_i * buffer[j + 6]);
+            A[i * n + j + 7] += (buffer_norm_i * buffer[j + 7]);
+        }
+        for (; j < n; ++j) { A[i * n + j] += (buffer_norm_i * buffer[j]); }
+    }
+}
+
 static int32_t add_block_observations(AomNoiseModel *noise_model, int32_t c,
                                       const uint8_t *const data, const uint8_t *const denoised,
                                       int32_t w, int32_t h, int32_t stride, int32_t sub_log2[2],
@@ -875,7 +935,6 @@ static int32_t add_block_observations(AomNoiseModel *noise_model, int32_t c,
                       : ((block_size >> sub_log2[0]) - lag));
             for (int32_t y = y_start; y < y_end; ++y) {
                 for (int32_t x = x_start; x < x_end; ++x) {
-                    int32_t      i   = 0;
                     const double val = noise_model->params.use_highbd
                         ? extract_ar_row_highbd(noise_model->coords,
                                                 num_coords,
@@ -902,46 +961,8 @@ static int32_t add_block_observations(AomNoiseModel *noise_model, int32_t c,
                                                y + y_o,
                                                buffer);
 
-                    for (i = 0; i + 8 - 1 < n; i += 8) {
-                        buffer_norm[i + 0] = buffer[i + 0] * recp_sqr_norm;
-                        buffer_norm[i + 1] = buffer[i + 1] * recp_sqr_norm;
-                        buffer_norm[i + 2] = buffer[i + 2] * recp_sqr_norm;
-                        buffer_norm[i + 3] = buffer[i + 3] * recp_sqr_norm;
-                        buffer_norm[i + 4] = buffer[i + 4] * recp_sqr_norm;
-                        buffer_norm[i + 5] = buffer[i + 5] * recp_sqr_norm;
-                        buffer_norm[i + 6] = buffer[i + 6] * recp_sqr_norm;
-                        buffer_norm[i + 7] = buffer[i + 7] * recp_sqr_norm;
-                        b[i + 0] += buffer_norm[i + 0] * val;
-                        b[i + 1] += buffer_norm[i + 1] * val;
-                        b[i + 2] += buffer_norm[i + 2] * val;
-                        b[i + 3] += buffer_norm[i + 3] * val;
-                        b[i + 4] += buffer_norm[i + 4] * val;
-                        b[i + 5] += buffer_norm[i + 5] * val;
-                        b[i + 6] += buffer_norm[i + 6] * val;
-                        b[i + 7] += buffer_norm[i + 7] * val;
-                    }
-                    for (; i < n; ++i) {
-                        buffer_norm[i] = buffer[i] * recp_sqr_norm;
-                        b[i] += buffer_norm[i] * val;
-                    }
-
-                    for (i = 0; i < n; ++i) {
-                        int32_t      j             = 0;
-                        const double buffer_norm_i = buffer_norm[i];
-
-                        for (j = 0; j + 8 - 1 < n; j += 8) {
-                            A[i * n + j + 0] += (buffer_norm_i * buffer[j + 0]);
-                            A[i * n + j + 1] += (buffer_norm_i * buffer[j + 1]);
-                            A[i * n + j + 2] += (buffer_norm_i * buffer[j + 2]);
-                            A[i * n + j + 3] += (buffer_norm_i * buffer[j + 3]);
-                            A[i * n + j + 4] += (buffer_norm_i * buffer[j + 4]);
-                            A[i * n + j + 5] += (buffer_norm_i * buffer[j + 5]);
-                            A[i * n + j + 6] += (buffer_norm_i * buffer[j + 6]);
-                            A[i * n + j + 7] += (buffer_norm_i * buffer[j + 7]);
-                        }
-                        for (; j < n; ++j) { A[i * n + j] += (buffer_norm_i * buffer[j]); }
-                    }
-
+                    svt_av1_add_block_observations_internal(
+                        n, val, recp_sqr_norm, buffer, buffer_norm, b, A);
                     noise_model->latest_state[c].num_observations++;
                 }
             }
@@ -978,24 +999,24 @@ static void add_noise_std_observations(AomNoiseModel *noise_model, int32_t c, co
             // Make sure that we have a reasonable amount of samples to consider the
             // block
             if (num_samples_w * num_samples_h > block_size) {
-                const double block_mean = get_block_mean(alt_data ? alt_data : data,
-                                                         w,
-                                                         h,
-                                                         alt_data ? alt_stride : stride,
-                                                         x_o << sub_log2[0],
-                                                         y_o << sub_log2[1],
-                                                         block_size,
-                                                         noise_model->params.use_highbd);
-                const double noise_var = get_noise_var(data,
-                                                       denoised,
-                                                       stride,
-                                                       w >> sub_log2[0],
-                                                       h >> sub_log2[1],
-                                                       x_o,
-                                                       y_o,
-                                                       block_size >> sub_log2[0],
-                                                       block_size >> sub_log2[1],
-                                                       noise_model->params.use_highbd);
+                const double block_mean = svt_av1_get_block_mean(alt_data ? alt_data : data,
+                                                                 w,
+                                                                 h,
+                                                                 alt_data ? alt_stride : stride,
+                                                                 x_o << sub_log2[0],
+                                                                 y_o << sub_log2[1],
+                                                                 block_size,
+                                                                 noise_model->params.use_highbd);
+                const double noise_var = svt_av1_get_noise_var(data,
+                                                               denoised,
+                                                               stride,
+                                                               w >> sub_log2[0],
+                                                               h >> sub_log2[1],
+                                                               x_o,
+                                                               y_o,
+                                                               block_size >> sub_log2[0],
+                                                               block_size >> sub_log2[1],
+                                                               noise_model->params.use_highbd);
                 // We want to remove the part of the noise that came from being
                 // correlated with luma. Note that the noise solver for luma must
                 // have already been run.
@@ -1220,6 +1241,7 @@ int32_t svt_aom_noise_model_get_grain_parameters(AomNoiseModel *const noise_mode
 
     // Convert the scaling functions to 8 bit values
     AomNoiseStrengthLut scaling_points[3];
+    memset(scaling_points, 0, sizeof(scaling_points));
     svt_aom_noise_strength_solver_fit_piecewise(
         &noise_model->combined_state[0].strength_solver, 14, scaling_points + 0);
     svt_aom_noise_strength_solver_fit_piecewise(
@@ -2222,65 +2244,96 @@ static const float *get_half_cos_window(int32_t block_size) {
 DITHER_AND_QUANTIZE(uint8_t, lowbd);
 DITHER_AND_QUANTIZE(uint16_t, highbd);
 
-int32_t svt_aom_wiener_denoise_2d(const uint8_t *const data[3], uint8_t *denoised[3], int32_t w,
-                                  int32_t h, int32_t stride[3], int32_t chroma_sub[2],
-                                  float noise_psd[3], int32_t block_size, int32_t bit_depth,
-                                  int32_t use_highbd) {
-    const float *window_full = NULL, *window_chroma = NULL;
-    float       *plane = NULL;
-    DECLARE_ALIGNED(32, float, *block);
-    block                          = NULL;
-    double                *block_d = NULL, *plane_d = NULL;
-    struct aom_noise_tx_t *tx_full       = NULL;
-    struct aom_noise_tx_t *tx_chroma     = NULL;
+static void wiener_denoise_buffers_free(AomWienerDenoiseBuffers *buffers) {
+    free(buffers->result);
+    free(buffers->plane);
+    svt_aom_free(buffers->block);
+    free(buffers->plane_d);
+    free(buffers->block_d);
+
+    svt_aom_noise_tx_free(buffers->tx_full);
+    svt_aom_flat_block_finder_free(&buffers->block_finder_full);
+    if (buffers->chroma_sub != 0) {
+        svt_aom_noise_tx_free(buffers->tx_chroma);
+        svt_aom_flat_block_finder_free(&buffers->block_finder_chroma);
+    }
+    memset(buffers, 0, sizeof(*buffers));
+}
+
+static int32_t wiener_denoise_buffers_alloc(AomWienerDenoiseBuffers *buffers, int32_t w,
+                                            int32_t h, int32_t chroma_sub, int32_t block_size,
+                                            int32_t bit_depth, int32_t use_highbd) {
+    const int32_t num_blocks_w  = (w + block_size - 1) / block_size;
+    const int32_t num_blocks_h  = (h + block_size - 1) / block_size;
+    const int32_t result_stride = (num_blocks_w + 2) * block_size;
+    int32_t       init_success  = 1;
+
+    memset(buffers, 0, sizeof(*buffers));
+    buffers->block_size   = block_size;
+    buffers->chroma_sub   = chroma_sub;
+    buffers->num_blocks_w = num_blocks_w;
+    buffers->num_blocks_h = num_blocks_h;
+
+    init_success &= svt_aom_flat_block_finder_init(
+        &buffers->block_finder_full, block_size, bit_depth, use_highbd);
+    buffers->result = (float *)malloc((num_blocks_h + 2) * block_size * result_stride *
+                                      sizeof(*buffers->result));
+    buffers->plane  = (float *)malloc(block_size * block_size * sizeof(*buffers->plane));
+    buffers->block  = (float *)svt_aom_memalign(
+        32, 2 * block_size * block_size * sizeof(*buffers->block));
+    buffers->block_d = (double *)malloc(block_size * block_size * sizeof(*buffers->block_d));
+    buffers->plane_d = (double *)malloc(block_size * block_size * sizeof(*buffers->plane_d));
+    buffers->tx_full = svt_aom_noise_tx_malloc(block_size);
+
+    if (chroma_sub != 0) {
+        init_success &= svt_aom_flat_block_finder_init(
+            &buffers->block_finder_chroma, block_size >> chroma_sub, bit_depth, use_highbd);
+        buffers->tx_chroma = svt_aom_noise_tx_malloc(block_size >> chroma_sub);
+    } else
+        buffers->tx_chroma = buffers->tx_full;
+
+    init_success &= (int32_t)((buffers->tx_full != NULL) && (buffers->tx_chroma != NULL) &&
+                              (buffers->plane != NULL) && (buffers->plane_d != NULL) &&
+                              (buffers->block != NULL) && (buffers->block_d != NULL) &&
+                              (buffers->result != NULL));
+    return init_success;
+}
+
+// Denoises the frame with buffers allocated by wiener_denoise_buffers_alloc for a frame of at
+// least w x h
+static int32_t wiener_denoise_2d_run(AomWienerDenoiseBuffers *buffers,
+                                     const uint8_t *const data[3], uint8_t *denoised[3], int32_t w,
+                                     int32_t h, int32_t stride[3], int32_t chroma_sub[2],
+                                     float noise_psd[3], int32_t bit_depth, int32_t use_highbd) {
+    const int32_t          block_size    = buffers->block_size;
+    const float           *window_full   = get_half_cos_window(block_size);
+    const float           *window_chroma = get_half_cos_window(block_size >> chroma_sub[0]);
+    float                 *plane         = buffers->plane;
+    float                 *block         = buffers->block;
+    double                *block_d       = buffers->block_d;
+    double                *plane_d       = buffers->plane_d;
+    struct aom_noise_tx_t *tx_full       = buffers->tx_full;
+    struct aom_noise_tx_t *tx_chroma     = buffers->tx_chroma;
     const int32_t          num_blocks_w  = (w + block_size - 1) / block_size;
     const int32_t          num_blocks_h  = (h + block_size - 1) / block_size;
     const int32_t          result_stride = (num_blocks_w + 2) * block_size;
     const int32_t          result_height = (num_blocks_h + 2) * block_size;
-    float                 *result        = NULL;
-    int32_t                init_success  = 1;
-    AomFlatBlockFinder     block_finder_full;
-    AomFlatBlockFinder     block_finder_chroma;
+    float                 *result        = buffers->result;
     const float            k_block_normalization = (float)((1 << bit_depth) - 1);
-    if (chroma_sub[0] != chroma_sub[1]) {
-        SVT_ERROR(
-            "svt_aom_wiener_denoise_2d doesn't handle different chroma "
-            "subsampling");
+    assert(chroma_sub[0] == buffers->chroma_sub);
+    assert(num_blocks_w <= buffers->num_blocks_w && num_blocks_h <= buffers->num_blocks_h);
+    if (window_full == NULL || window_chroma == NULL)
         return 0;
-    }
-    init_success &= svt_aom_flat_block_finder_init(
-        &block_finder_full, block_size, bit_depth, use_highbd);
-    result  = (float *)malloc((num_blocks_h + 2) * block_size * result_stride * sizeof(*result));
-    plane   = (float *)malloc(block_size * block_size * sizeof(*plane));
-    block   = (float *)svt_aom_memalign(32, 2 * block_size * block_size * sizeof(*block));
-    block_d = (double *)malloc(block_size * block_size * sizeof(*block_d));
-    plane_d = (double *)malloc(block_size * block_size * sizeof(*plane_d));
-    window_full = get_half_cos_window(block_size);
-    tx_full     = svt_aom_noise_tx_malloc(block_size);
-
-    if (chroma_sub[0] != 0) {
-        init_success &= svt_aom_flat_block_finder_init(
-            &block_finder_chroma, block_size >> chroma_sub[0], bit_depth, use_highbd);
-        window_chroma = get_half_cos_window(block_size >> chroma_sub[0]);
-        tx_chroma     = svt_aom_noise_tx_malloc(block_size >> chroma_sub[0]);
-    } else {
-        window_chroma = window_full;
-        tx_chroma     = tx_full;
-    }
-
-    init_success &= (int32_t)((tx_full != NULL) && (tx_chroma != NULL) && (plane != NULL) &&
-                              (plane_d != NULL) && (block != NULL) && (block_d != NULL) &&
-                              (window_full != NULL) && (window_chroma != NULL) && (result != NULL));
-    for (int32_t c = init_success ? 0 : 3; c < 3; ++c) {
+    for (int32_t c = 0; c < 3; ++c) {
         const float           *window_function = c == 0 ? window_full : window_chroma;
-        AomFlatBlockFinder    *block_finder    = &block_finder_full;
+        AomFlatBlockFinder    *block_finder    = &buffers->block_finder_full;
         const int32_t          chroma_sub_h    = c > 0 ? chroma_sub[1] : 0;
         const int32_t          chroma_sub_w    = c > 0 ? chroma_sub[0] : 0;
         struct aom_noise_tx_t *tx              = (c > 0 && chroma_sub[0] > 0) ? tx_chroma : tx_full;
         if (!data[c] || !denoised[c])
             continue;
         if (c > 0 && chroma_sub[0] != 0)
-            block_finder = &block_finder_chroma;
+            block_finder = &buffers->block_finder_chroma;
         memset(result, 0, sizeof(*result) * result_stride * result_height);
         // Do overlapped block processing (half overlapped). The block rows can
         // easily be done in parallel
@@ -2356,19 +2409,27 @@ int32_t svt_aom_wiener_denoise_2d(const uint8_t *const data[3], uint8_t *denoise
                                       k_block_normalization);
         }
     }
-    free(result);
-    free(plane);
-    svt_aom_free(block);
-    free(plane_d);
-    free(block_d);
-
-    svt_aom_noise_tx_free(tx_full);
+    return 1;
+}
 
-    svt_aom_flat_block_finder_free(&block_finder_full);
-    if (chroma_sub[0] != 0) {
-        svt_aom_flat_block_finder_free(&block_finder_chroma);
-        svt_aom_noise_tx_free(tx_chroma);
+int32_t svt_aom_wiener_denoise_2d(const uint8_t *const data[3], uint8_t *denoised[3], int32_t w,
+                                  int32_t h, int32_t stride[3], int32_t chroma_sub[2],
+                                  float noise_psd[3], int32_t block_size, int32_t bit_depth,
+                                  int32_t use_highbd) {
+    AomWienerDenoiseBuffers buffers;
+    int32_t                 init_success;
+    if (chroma_sub[0] != chroma_sub[1]) {
+        SVT_ERROR(
+            "svt_aom_wiener_denoise_2d doesn't handle different chroma "
+            "subsampling");
+        return 0;
     }
+    init_success = wiener_denoise_buffers_alloc(
+        &buffers, w, h, chroma_sub[0], block_size, bit_depth, use_highbd);
+    if (init_success)
+        init_success = wiener_denoise_2d_run(
+            &buffers, data, denoised, w, h, stride, chroma_sub, noise_psd, bit_depth, use_highbd);
+    wiener_denoise_buffers_free(&buffers);
     return init_success;
 }
 
@@ -2391,6 +2452,7 @@ static void denoise_and_model_dctor(EbPtr p) {
     }
     svt_aom_noise_model_free(&obj->noise_model);
     svt_aom_flat_block_finder_free(&obj->flat_block_finder);
+    wiener_denoise_buffers_free(&obj->wiener_buffers);
 }
 
 EbErrorType denoise_and_model_ctor(AomDenoiseAndModel *object_ptr, EbPtr object_init_data_ptr) {
@@ -2438,16 +2500,30 @@ EbErrorType denoise_and_model_ctor(AomDenoiseAndModel *object_ptr, EbPtr object_
     return return_error;
 }
 
+// The buffers only depend on the frame size, a context used for frames of the same size keeps
+// them and only starts a new noise estimate
 static int32_t denoise_and_model_realloc_if_necessary(struct AomDenoiseAndModel *ctx,
                                                       EbPictureBufferDesc *sd, int32_t use_highbd) {
-    int32_t chroma_sub_log2[2] = {1, 1}; //todo: send chroma subsampling
+    int32_t       chroma_sub_log2[2] = {1, 1}; //todo: send chroma subsampling
+    const int32_t num_blocks_w       = (sd->width + ctx->block_size - 1) / ctx->block_size;
+    const int32_t num_blocks_h       = (sd->height + ctx->block_size - 1) / ctx->block_size;
+
+    if (ctx->flat_blocks && ctx->num_blocks_w == num_blocks_w &&
+        ctx->num_blocks_h == num_blocks_h) {
+        noise_model_reset(&ctx->noise_model);
+        return 1;
+    }
 
     free(ctx->flat_blocks);
     ctx->flat_blocks = NULL;
 
-    ctx->num_blocks_w = (sd->width + ctx->block_size - 1) / ctx->block_size;
-    ctx->num_blocks_h = (sd->height + ctx->block_size - 1) / ctx->block_size;
+    ctx->num_blocks_w = num_blocks_w;
+    ctx->num_blocks_h = num_blocks_h;
     ctx->flat_blocks  = malloc(ctx->num_blocks_w * ctx->num_blocks_h);
+    if (!ctx->flat_blocks) {
+        SVT_ERROR("Unable to allocate flat blocks\n");
+        return 0;
+    }
 
     svt_aom_flat_block_finder_free(&ctx->flat_block_finder);
     if (!svt_aom_flat_block_finder_init(
@@ -2457,12 +2533,24 @@ static int32_t denoise_and_model_realloc_if_necessary(struct AomDenoiseAndModel
     }
 
     const AomNoiseModelParams params = {AOM_NOISE_SHAPE_SQUARE, 3, ctx->bit_depth, use_highbd};
-    //  svt_aom_noise_model_free(&ctx->noise_model);
+    svt_aom_noise_model_free(&ctx->noise_model);
     if (!svt_aom_noise_model_init(&ctx->noise_model, params)) {
         SVT_ERROR("Unable to init noise model\n");
         return 0;
     }
 
+    wiener_denoise_buffers_free(&ctx->wiener_buffers);
+    if (!wiener_denoise_buffers_alloc(&ctx->wiener_buffers,
+                                      sd->width,
+                                      sd->height,
+                                      chroma_sub_log2[0],
+                                      ctx->block_size,
+                                      ctx->bit_depth,
+                                      use_highbd)) {
+        SVT_ERROR("Unable to allocate denoise buffers\n");
+        return 0;
+    }
+
     // Simply use a flat PSD (although we could use the flat blocks to estimate
     // PSD) those to estimate an actual noise PSD)
     const float y_noise_level  = svt_aom_noise_psd_get_default_value(ctx->block_size,
@@ -2600,16 +2688,16 @@ int32_t svt_aom_denoise_and_model_run(struct AomDenoiseAndModel *ctx, EbPictureB
     svt_aom_flat_block_finder_run(
         &ctx->flat_block_finder, data[0], sd->width, sd->height, strides[0], ctx->flat_blocks);
 
-    if (!svt_aom_wiener_denoise_2d(data,
-                                   ctx->denoised,
-                                   sd->width,
-                                   sd->height,
-                                   strides,
-                                   chroma_sub_log2,
-                                   ctx->noise_psd,
-                                   block_size,
-                                   ctx->bit_depth,
-                                   use_highbd)) {
+    if (!wiener_denoise_2d_run(&ctx->wiener_buffers,
+                               data,
+                               ctx->denoised,
+                               sd->width,
+                               sd->height,
+                               strides,
+                               chroma_sub_log2,
+                               ctx->noise_psd,
+                               ctx->bit_depth,
+                               use_highbd)) {
         SVT_ERROR("Unable to denoise image\n");
         return 0;
     }
@@ -2660,10 +2748,6 @@ int32_t svt_aom_denoise_and_model_run(struct AomDenoiseAndModel *ctx, EbPictureB
         } else
             unpack_2d_pic(ctx->denoised, sd);
     }
-    svt_aom_flat_block_finder_free(&ctx->flat_block_finder);
-    svt_aom_noise_model_free(&ctx->noise_model);
-    free(ctx->flat_blocks);
-    ctx->flat_blocks = NULL;
 
     return 1;
 }
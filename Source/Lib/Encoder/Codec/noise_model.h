@@ -215,6 +215,27 @@ typedef struct DenoiseAndModelInitData {
     uint16_t stride_cr;
 } DenoiseAndModelInitData;
 
+/*!\brief Scratch buffers of the 2D Wiener denoising.
+     *
+     * They are sized for the frame they were allocated for and can be reused
+     * for any frame that is not larger.
+     */
+typedef struct {
+    int32_t                block_size;
+    int32_t                chroma_sub;
+    int32_t                num_blocks_w;
+    int32_t                num_blocks_h;
+    float                 *result;
+    float                 *plane;
+    float                 *block;
+    double                *block_d;
+    double                *plane_d;
+    struct aom_noise_tx_t *tx_full;
+    struct aom_noise_tx_t *tx_chroma;
+    AomFlatBlockFinder     block_finder_full;
+    AomFlatBlockFinder     block_finder_chroma;
+} AomWienerDenoiseBuffers;
+
 typedef struct AomDenoiseAndModel {
     EbDctor dctor;
     int32_t block_size;
@@ -237,8 +258,9 @@ typedef struct AomDenoiseAndModel {
     EbPictureBufferDesc *denoised_pic;
     EbPictureBufferDesc *packed_pic;
 
-    AomFlatBlockFinder flat_block_finder;
-    AomNoiseModel      noise_model;
+    AomFlatBlockFinder      flat_block_finder;
+    AomNoiseModel           noise_model;
+    AomWienerDenoiseBuffers wiener_buffers;
 } AomDenoiseAndModel;
 
 /************************************
@@ -24,6 +24,7 @@
 #include "firstpass.h"
 #include "EbSequenceControlSet.h"
 #include "EbEntropyCoding.h"
+#include "EbLog.h"
 //#define INT_MAX 0x7fffffff
 
 #define DEFAULT_KF_BOOST 2300
@@ -2592,6 +2593,50 @@ void svt_av1_init_single_pass_lap(SequenceControlSet *scs_ptr) {
     // Static sequence monitor variables.
     twopass->kf_zeromotion_pct           = 100;
 }
+/*********************************************************************************************
+* Chunked encoding: restricts the stats of the full sequence to the frames of the chunk,
+* their totals go to total_stats as the stats buffer belongs to the application. The
+* budget of the chunk follows the modified error of the chunk as a whole relative to the
+* full sequence, within the vbr section limits.
+***********************************************************************************************/
+void svt_av1_setup_chunk_stats(SequenceControlSet *scs_ptr) {
+    TWO_PASS *const                 twopass        = &scs_ptr->twopass;
+    STATS_BUFFER_CTX *const         stats_buf_ctx  = twopass->stats_buf_ctx;
+    const EbSvtAv1EncConfiguration *config         = &scs_ptr->static_config;
+    const FIRSTPASS_STATS           sequence_stats = *stats_buf_ctx->stats_in_end;
+    const uint64_t frame_count = stats_buf_ctx->stats_in_end - stats_buf_ctx->stats_in_start;
+    uint64_t       chunk_count = config->chunk_frame_count;
+
+    if (scs_ptr->chunk_start_frame >= frame_count) {
+        SVT_ERROR("The chunk starts after the %llu frames of the stats\n",
+                  (unsigned long long)frame_count);
+        stats_buf_ctx->chunk_bits_factor = 1.0;
+        *stats_buf_ctx->total_stats      = sequence_stats;
+        return;
+    }
+    if (!chunk_count || scs_ptr->chunk_start_frame + chunk_count > frame_count)
+        chunk_count = frame_count - scs_ptr->chunk_start_frame;
+
+    stats_buf_ctx->stats_in_start += scs_ptr->chunk_start_frame;
+    stats_buf_ctx->stats_in_end       = stats_buf_ctx->stats_in_start + chunk_count;
+    stats_buf_ctx->stats_in_end_write = stats_buf_ctx->stats_in_end;
+    twopass->stats_in                 = stats_buf_ctx->stats_in_start;
+    svt_av1_range_total_stats(
+        stats_buf_ctx->stats_in_start, chunk_count, stats_buf_ctx->total_stats);
+    if (stats_buf_ctx->chunk_bits_factor > 0)
+        return;
+
+    // Average modified error (see calculate_modified_err) of the chunk and of the sequence
+    const FIRSTPASS_STATS *chunk_stats  = stats_buf_ctx->total_stats;
+    const double           sequence_err = sequence_stats.coded_error * sequence_stats.weight /
+        DOUBLE_DIVIDE_CHECK(sequence_stats.count * sequence_stats.count);
+    const double chunk_err = chunk_stats->coded_error * chunk_stats->weight /
+        DOUBLE_DIVIDE_CHECK(chunk_stats->count * chunk_stats->count);
+    stats_buf_ctx->chunk_bits_factor = fclamp(
+        pow(chunk_err / DOUBLE_DIVIDE_CHECK(sequence_err), config->vbr_bias_pct / 100.0),
+        config->vbr_min_section_pct / 100.0,
+        config->vbr_max_section_pct / 100.0);
+}
 void svt_av1_init_second_pass(SequenceControlSet *scs_ptr) {
     TWO_PASS *const twopass            = &scs_ptr->twopass;
     EncodeContext  *encode_context_ptr = scs_ptr->encode_context_ptr;
@@ -2603,7 +2648,9 @@ void svt_av1_init_second_pass(SequenceControlSet *scs_ptr) {
     if (!twopass->stats_buf_ctx->stats_in_end)
         return;
 
-    if (twopass->passes == 3 && scs_ptr->static_config.pass != ENC_MIDDLE_PASS) {
+    // Chunked encoding: the totals of the chunk are in total_stats already
+    const Bool chunk = scs_ptr->static_config.chunk_start_frame >= 0;
+    if (twopass->passes == 3 && scs_ptr->static_config.pass != ENC_MIDDLE_PASS && !chunk) {
         svt_av1_twopass_zero_stats(twopass->stats_buf_ctx->stats_in_end);
         FIRSTPASS_STATS *this_frame     = (FIRSTPASS_STATS *)scs_ptr->twopass.stats_in;
         uint64_t         total_num_bits = 0;
@@ -2620,7 +2667,8 @@ void svt_av1_init_second_pass(SequenceControlSet *scs_ptr) {
     set_rc_param(scs_ptr);
     stats = twopass->stats_buf_ctx->total_stats;
 
-    *stats                                    = *twopass->stats_buf_ctx->stats_in_end;
+    if (!chunk)
+        *stats = *twopass->stats_buf_ctx->stats_in_end;
     *twopass->stats_buf_ctx->total_left_stats = *stats;
 
     frame_rate = 10000000.0 * stats->count / stats->duration;
@@ -2632,6 +2680,9 @@ void svt_av1_init_second_pass(SequenceControlSet *scs_ptr) {
     svt_av1_new_framerate(scs_ptr, frame_rate);
     twopass->bits_left = (int64_t)(stats->duration *
                                    (int64_t)scs_ptr->static_config.target_bit_rate / 10000000.0);
+    if (chunk)
+        twopass->bits_left = (int64_t)(twopass->bits_left *
+                                       twopass->stats_buf_ctx->chunk_bits_factor);
 
     if (twopass->passes == 3 && scs_ptr->static_config.pass != ENC_MIDDLE_PASS)
         read_stat_from_file(scs_ptr);
@@ -41,6 +41,7 @@ typedef struct {
     double this_frame_mv_in_out;
 } GF_GROUP_STATS;
 
+void svt_av1_setup_chunk_stats(struct SequenceControlSet *scs_ptr);
 void svt_av1_init_second_pass(struct SequenceControlSet *scs_ptr);
 void svt_av1_init_single_pass_lap(struct SequenceControlSet *scs_ptr);
 void svt_av1_new_framerate(struct SequenceControlSet *scs_ptr, double framerate);
@@ -31,6 +31,7 @@
 #include "EbPictureAnalysisProcess.h"
 #include "EbPictureDecisionProcess.h"
 #include "EbMotionEstimationProcess.h"
+#include "EbGlobalMotionEstimation.h"
 #include "EbInitialRateControlProcess.h"
 #include "EbSourceBasedOperationsProcess.h"
 #include "EbPictureManagerProcess.h"
@@ -54,6 +55,7 @@
 #include "EbCdefProcess.h"
 #include "EbDlfProcess.h"
 #include "EbRateControlResults.h"
+#include "EbSegmentation.h"
 #include "EbDefinitions.h"
 
 #include"EbPackUnPack_C.h"
@@ -62,6 +64,7 @@
 #include <immintrin.h>
 #endif
 #include "EbLog.h"
+#include "EbTime.h"
 
 #ifdef _WIN32
 #include <windows.h>
@@ -106,6 +109,9 @@
 #define ENCDEC_INPUT_PORT_MDC                                0
 #define ENCDEC_INPUT_PORT_ENCDEC                             1
 #define ENCDEC_INPUT_PORT_INVALID                           -1
+#define DLF_INPUT_PORT_ENCDEC                                0
+#define DLF_INPUT_PORT_DLF                                   1
+#define DLF_INPUT_PORT_INVALID                              -1
 /**************************************
  * Globals
  **************************************/
@@ -428,7 +434,8 @@ EbErrorType load_default_buffer_configuration_settings(
     if (return_ppcs == -1)
         return EB_ErrorInsufficientResources;
 
-    uint32_t enc_dec_seg_h = (core_count == SINGLE_CORE_COUNT || is_pic_width_single_sb(scs_ptr->super_block_size, scs_ptr->max_input_luma_width)) ? 1 :
+    // The SB row recode holds a segment row, which needs at least two of them
+    uint32_t enc_dec_seg_h = ((core_count == SINGLE_CORE_COUNT && !scs_ptr->static_config.sb_row_recode) || is_pic_width_single_sb(scs_ptr->super_block_size, scs_ptr->max_input_luma_width)) ? 1 :
         (scs_ptr->super_block_size == 128) ?
         ((scs_ptr->max_input_luma_height + 64) / 128) :
         ((scs_ptr->max_input_luma_height + 32) / 64);
@@ -512,6 +519,10 @@ EbErrorType load_default_buffer_configuration_settings(
     scs_ptr->tpl_segment_row_count_array = tpl_seg_h;
     scs_ptr->tpl_segment_col_count_array = tpl_seg_w;
 
+    // DLF segments follow the EncDec wavefront (SB based)
+    scs_ptr->dlf_segment_column_count = enc_dec_seg_w;
+    scs_ptr->dlf_segment_row_count    = enc_dec_seg_h;
+
     scs_ptr->cdef_segment_column_count = me_seg_w;
     scs_ptr->cdef_segment_row_count    = me_seg_h;
 
@@ -861,10 +872,37 @@ EbErrorType load_default_buffer_configuration_settings(
         }
     }
 
+    scs_ptr->worker_pool_size = 0;
+    if (scs_ptr->static_config.enable_worker_pool && core_count != SINGLE_CORE_COUNT) {
+        // One dedicated thread per parallel process plus one context per pool worker
+        const uint32_t pool_process_count = 1 + core_count;
+        scs_ptr->worker_pool_size = core_count;
+        scs_ptr->total_process_init_count = 0;
+        scs_ptr->total_process_init_count += (scs_ptr->source_based_operations_process_init_count     = 1);
+        scs_ptr->total_process_init_count += (scs_ptr->picture_analysis_process_init_count            = pool_process_count);
+        scs_ptr->total_process_init_count += (scs_ptr->motion_estimation_process_init_count           = pool_process_count);
+        scs_ptr->total_process_init_count += (scs_ptr->tpl_disp_process_init_count                    = pool_process_count);
+        scs_ptr->total_process_init_count += (scs_ptr->mode_decision_configuration_process_init_count = pool_process_count);
+        // As without the pool, at least one EncDec context per child picture control set
+        scs_ptr->total_process_init_count += (scs_ptr->enc_dec_process_init_count                     =
+            MAX(pool_process_count, scs_ptr->picture_control_set_pool_init_count_child));
+        scs_ptr->total_process_init_count += (scs_ptr->entropy_coding_process_init_count              = pool_process_count);
+        scs_ptr->total_process_init_count += (scs_ptr->dlf_process_init_count                         = pool_process_count);
+        scs_ptr->total_process_init_count += (scs_ptr->cdef_process_init_count                        = pool_process_count);
+        scs_ptr->total_process_init_count += (scs_ptr->rest_process_init_count                        = pool_process_count);
+    }
+
+    // The ME thread finishing a picture searches one GM reference per list, the GM search threads
+    // the other ones
+    scs_ptr->total_process_init_count += (scs_ptr->gm_search_process_init_count =
+        MIN(scs_ptr->motion_estimation_process_init_count, REF_LIST_MAX_DEPTH) - 1);
+
     scs_ptr->total_process_init_count += 6; // single processes count
     if (scs_ptr->static_config.pass == 0 || scs_ptr->static_config.pass == 3){
         SVT_INFO("Number of logical cores available: %u\n", core_count);
         SVT_INFO("Number of PPCS %u\n", scs_ptr->picture_control_set_pool_init_count);
+        if (scs_ptr->worker_pool_size)
+            SVT_INFO("Number of pool workers %u\n", scs_ptr->worker_pool_size);
 
         /******************************************************************
         * Platform detection, limit cpu flags to hardware available CPU
@@ -997,6 +1035,31 @@ static uint32_t enc_dec_port_total_count(void){
         total_count += enc_dec_ports[port_index++].count;
     return total_count;
 }
+// DLF
+static EncDecPorts_t dlf_ports[] = {
+    {DLF_INPUT_PORT_ENCDEC,  0},
+    {DLF_INPUT_PORT_DLF,     0},
+    {DLF_INPUT_PORT_INVALID, 0}
+};
+static uint32_t dlf_port_lookup(
+    int32_t  type,
+    uint32_t  port_type_index)
+{
+    uint32_t port_index = 0;
+    uint32_t port_count = 0;
+
+    while ((type != dlf_ports[port_index].type) && (type != DLF_INPUT_PORT_INVALID))
+        port_count += dlf_ports[port_index++].count;
+    return (port_count + port_type_index);
+}
+static uint32_t dlf_port_total_count(void){
+    uint32_t port_index = 0;
+    uint32_t total_count = 0;
+
+    while (dlf_ports[port_index].type != DLF_INPUT_PORT_INVALID)
+        total_count += dlf_ports[port_index++].count;
+    return total_count;
+}
 /*****************************************
  * Input Port Total Count
  *****************************************/
@@ -1005,18 +1068,29 @@ void lib_svt_encoder_send_error_exit(
     EbPtr                    hComponent,
     uint32_t                 error_code);
 
+/*****************************************
+ * Dedicated threads of a parallel process,
+ * the other contexts run on the worker pool
+ *****************************************/
+static uint32_t process_thread_count(const SequenceControlSet *scs_ptr, uint32_t process_init_count) {
+    return scs_ptr->worker_pool_size ? 1 : process_init_count;
+}
+
 static void svt_enc_handle_stop_threads(EbEncHandle *enc_handle_ptr)
 {
     SequenceControlSet*  control_set_ptr = enc_handle_ptr->scs_instance_array[0]->scs_ptr;
+    // Worker Pool
+    EB_DELETE(enc_handle_ptr->worker_pool);
+
     // Resource Coordination
     EB_DESTROY_THREAD(enc_handle_ptr->resource_coordination_thread_handle);
-    EB_DESTROY_THREAD_ARRAY(enc_handle_ptr->picture_analysis_thread_handle_array,control_set_ptr->picture_analysis_process_init_count);
+    EB_DESTROY_THREAD_ARRAY(enc_handle_ptr->picture_analysis_thread_handle_array,process_thread_count(control_set_ptr, control_set_ptr->picture_analysis_process_init_count));
 
     // Picture Decision
     EB_DESTROY_THREAD(enc_handle_ptr->picture_decision_thread_handle);
 
     // Motion Estimation
-    EB_DESTROY_THREAD_ARRAY(enc_handle_ptr->motion_estimation_thread_handle_array, control_set_ptr->motion_estimation_process_init_count);
+    EB_DESTROY_THREAD_ARRAY(enc_handle_ptr->motion_estimation_thread_handle_array, process_thread_count(control_set_ptr, control_set_ptr->motion_estimation_process_init_count));
 
     // Initial Rate Control
     EB_DESTROY_THREAD(enc_handle_ptr->initial_rate_control_thread_handle);
@@ -1025,7 +1099,10 @@ static void svt_enc_handle_stop_threads(EbEncHandle *enc_handle_ptr)
     EB_DESTROY_THREAD_ARRAY(enc_handle_ptr->source_based_operations_thread_handle_array, control_set_ptr->source_based_operations_process_init_count);
 
     // TPL dispenser ME
-    EB_DESTROY_THREAD_ARRAY(enc_handle_ptr->tpl_disp_thread_handle_array, control_set_ptr->tpl_disp_process_init_count);
+    EB_DESTROY_THREAD_ARRAY(enc_handle_ptr->tpl_disp_thread_handle_array, process_thread_count(control_set_ptr, control_set_ptr->tpl_disp_process_init_count));
+
+    // GM search
+    EB_DESTROY_THREAD_ARRAY(enc_handle_ptr->gm_search_thread_handle_array, control_set_ptr->gm_search_process_init_count);
 
     // Picture Manager
     EB_DESTROY_THREAD(enc_handle_ptr->picture_manager_thread_handle);
@@ -1034,22 +1111,22 @@ static void svt_enc_handle_stop_threads(EbEncHandle *enc_handle_ptr)
     EB_DESTROY_THREAD(enc_handle_ptr->rate_control_thread_handle);
 
     // Mode Decision Configuration Process
-    EB_DESTROY_THREAD_ARRAY(enc_handle_ptr->mode_decision_configuration_thread_handle_array, control_set_ptr->mode_decision_configuration_process_init_count);
+    EB_DESTROY_THREAD_ARRAY(enc_handle_ptr->mode_decision_configuration_thread_handle_array, process_thread_count(control_set_ptr, control_set_ptr->mode_decision_configuration_process_init_count));
 
     // EncDec Process
-    EB_DESTROY_THREAD_ARRAY(enc_handle_ptr->enc_dec_thread_handle_array, control_set_ptr->enc_dec_process_init_count);
+    EB_DESTROY_THREAD_ARRAY(enc_handle_ptr->enc_dec_thread_handle_array, process_thread_count(control_set_ptr, control_set_ptr->enc_dec_process_init_count));
 
     // Dlf Process
-    EB_DESTROY_THREAD_ARRAY(enc_handle_ptr->dlf_thread_handle_array, control_set_ptr->dlf_process_init_count);
+    EB_DESTROY_THREAD_ARRAY(enc_handle_ptr->dlf_thread_handle_array, process_thread_count(control_set_ptr, control_set_ptr->dlf_process_init_count));
 
     // Cdef Process
-    EB_DESTROY_THREAD_ARRAY(enc_handle_ptr->cdef_thread_handle_array, control_set_ptr->cdef_process_init_count);
+    EB_DESTROY_THREAD_ARRAY(enc_handle_ptr->cdef_thread_handle_array, process_thread_count(control_set_ptr, control_set_ptr->cdef_process_init_count));
 
     // Rest Process
-    EB_DESTROY_THREAD_ARRAY(enc_handle_ptr->rest_thread_handle_array, control_set_ptr->rest_process_init_count);
+    EB_DESTROY_THREAD_ARRAY(enc_handle_ptr->rest_thread_handle_array, process_thread_count(control_set_ptr, control_set_ptr->rest_process_init_count));
 
     // Entropy Coding Process
-    EB_DESTROY_THREAD_ARRAY(enc_handle_ptr->entropy_coding_thread_handle_array, control_set_ptr->entropy_coding_process_init_count);
+    EB_DESTROY_THREAD_ARRAY(enc_handle_ptr->entropy_coding_thread_handle_array, process_thread_count(control_set_ptr, control_set_ptr->entropy_coding_process_init_count));
 
     // Packetization
     EB_DESTROY_THREAD(enc_handle_ptr->packetization_thread_handle);
@@ -1073,6 +1150,14 @@ static void svt_enc_handle_dctor(EbPtr p)
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->pa_reference_picture_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->overlay_input_picture_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
     EB_DELETE(enc_handle_ptr->input_cmd_resource_ptr);
+    //hand back zero-copy input pictures still referenced by the pipeline (e.g. pa references)
+    if (enc_handle_ptr->input_y8b_buffer_resource_ptr &&
+        enc_handle_ptr->input_y8b_buffer_resource_ptr->release_callback) {
+        EbSystemResource *y8b_resource = enc_handle_ptr->input_y8b_buffer_resource_ptr;
+        for (uint32_t w_i = 0; w_i < y8b_resource->object_total_count; ++w_i)
+            y8b_resource->release_callback(y8b_resource->wrapper_ptr_pool[w_i]->object_ptr,
+                                           y8b_resource->release_callback_ctx);
+    }
     EB_DELETE(enc_handle_ptr->input_y8b_buffer_resource_ptr);
 
     //all buffer_y have been redirected to y8b location that just got released.
@@ -1095,6 +1180,7 @@ static void svt_enc_handle_dctor(EbPtr p)
     EB_DELETE(enc_handle_ptr->initial_rate_control_results_resource_ptr);
     EB_DELETE(enc_handle_ptr->picture_demux_results_resource_ptr);
     EB_DELETE(enc_handle_ptr->tpl_disp_res_srm);
+    EB_DELETE(enc_handle_ptr->gm_search_task_resource_ptr);
     EB_DELETE(enc_handle_ptr->rate_control_tasks_resource_ptr);
     EB_DELETE(enc_handle_ptr->rate_control_results_resource_ptr);
     EB_DELETE(enc_handle_ptr->enc_dec_tasks_resource_ptr);
@@ -1108,6 +1194,7 @@ static void svt_enc_handle_dctor(EbPtr p)
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->picture_analysis_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs_ptr->picture_analysis_process_init_count);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->motion_estimation_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs_ptr->motion_estimation_process_init_count);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->tpl_disp_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs_ptr->tpl_disp_process_init_count);
+    EB_DELETE_PTR_ARRAY(enc_handle_ptr->gm_search_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs_ptr->gm_search_process_init_count);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->source_based_operations_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs_ptr->source_based_operations_process_init_count);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->mode_decision_configuration_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs_ptr->mode_decision_configuration_process_init_count);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->enc_dec_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs_ptr->enc_dec_process_init_count);
@@ -1174,15 +1261,27 @@ void svt_output_recon_buffer_header_destroyer(    EbPtr p);
 void svt_output_buffer_header_destroyer(    EbPtr p);
 
 EbErrorType svt_input_y8b_creator(EbPtr *object_dbl_ptr, EbPtr  object_init_data_ptr);
+void svt_release_input_y8b(EbPtr object_ptr, EbPtr context_ptr);
 void svt_input_y8b_destroyer(EbPtr p);
 
+static void in_cmd_dctor(EbPtr p)
+{
+    InputCommand *obj = (InputCommand*)p;
+    EB_FREE_ARRAY(obj->roi_seg_map);
+    EB_FREE_ARRAY(obj->roi_skip_map);
+}
+
 EbErrorType in_cmd_ctor(
     InputCommand *context_ptr,
     EbPtr object_init_data_ptr)
 {
-    (void)context_ptr;
-    (void)object_init_data_ptr;
+    SequenceControlSet *scs_ptr = (SequenceControlSet*)object_init_data_ptr;
 
+    context_ptr->dctor = in_cmd_dctor;
+    if (scs_ptr->static_config.enable_roi_map) {
+        EB_MALLOC_ARRAY(context_ptr->roi_seg_map, scs_ptr->sb_total_count);
+        EB_MALLOC_ARRAY(context_ptr->roi_skip_map, scs_ptr->sb_total_count);
+    }
     return EB_ErrorNone;
 }
 /*
@@ -1254,6 +1353,35 @@ EbErrorType tpl_disp_results_creator(
     return EB_ErrorNone;
 }
 
+/*
+   GM search task ctor
+*/
+EbErrorType gm_search_task_ctor(
+    GmSearchTask *context_ptr,
+    EbPtr object_init_data_ptr)
+{
+    (void)context_ptr;
+    (void)object_init_data_ptr;
+
+    return EB_ErrorNone;
+}
+
+/*
+   GM search task creator
+*/
+EbErrorType gm_search_task_creator(
+    EbPtr *object_dbl_ptr,
+    EbPtr object_init_data_ptr)
+{
+    GmSearchTask* obj;
+
+    *object_dbl_ptr = NULL;
+    EB_NEW(obj, gm_search_task_ctor, object_init_data_ptr);
+    *object_dbl_ptr = obj;
+
+    return EB_ErrorNone;
+}
+
 EbErrorType cdef_results_ctor(
     CdefResults *context_ptr,
     EbPtr object_init_data_ptr)
@@ -1545,6 +1673,7 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
         input_data.tpl_synth_size = get_tpl_synthesizer_block_size( enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->tpl_level,
             input_data.picture_width, input_data.picture_height);
         input_data.enable_adaptive_quantization = enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->static_config.enable_adaptive_quantization;
+        input_data.enable_roi_map = enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->static_config.enable_roi_map;
         input_data.calculate_variance = enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->calculate_variance;
         input_data.scene_change_detection = enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->static_config.scene_change_detection ||
                                             enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->vq_ctrls.sharpness_ctrls.scene_transition;
@@ -1718,6 +1847,8 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
 
     enc_dec_ports[ENCDEC_INPUT_PORT_MDC].count = enc_handle_ptr->scs_instance_array[0]->scs_ptr->mode_decision_configuration_process_init_count;
     enc_dec_ports[ENCDEC_INPUT_PORT_ENCDEC].count = enc_handle_ptr->scs_instance_array[0]->scs_ptr->enc_dec_process_init_count;
+    dlf_ports[DLF_INPUT_PORT_ENCDEC].count = enc_handle_ptr->scs_instance_array[0]->scs_ptr->enc_dec_process_init_count;
+    dlf_ports[DLF_INPUT_PORT_DLF].count = enc_handle_ptr->scs_instance_array[0]->scs_ptr->dlf_process_init_count;
     tpl_ports[TPL_INPUT_PORT_SOP].count = enc_handle_ptr->scs_instance_array[0]->scs_ptr->source_based_operations_process_init_count;
     tpl_ports[TPL_INPUT_PORT_TPL].count = enc_handle_ptr->scs_instance_array[0]->scs_ptr->tpl_disp_process_init_count;
     for (instance_index = 0; instance_index < enc_handle_ptr->encode_instance_total_count; ++instance_index) {
@@ -1790,11 +1921,23 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
     enc_handle_ptr->input_y8b_buffer_resource_ptr->empty_queue->log = 1;
 #endif
     enc_handle_ptr->input_y8b_buffer_producer_fifo_ptr = svt_system_resource_get_producer_fifo(enc_handle_ptr->input_y8b_buffer_resource_ptr, 0);
+    if (enc_handle_ptr->scs_instance_array[0]->scs_ptr->zero_copy_input) {
+        // the y8b buffer is the last one released, hand the planes back to the application then
+        enc_handle_ptr->input_y8b_buffer_resource_ptr->release_callback = svt_release_input_y8b;
+        enc_handle_ptr->input_y8b_buffer_resource_ptr->release_callback_ctx =
+            enc_handle_ptr->scs_instance_array[0]->scs_ptr;
+    }
 
     // EbBufferHeaderType Output Stream
     EB_ALLOC_PTR_ARRAY(enc_handle_ptr->output_stream_buffer_resource_ptr_array, enc_handle_ptr->encode_instance_total_count);
 
     for (instance_index = 0; instance_index < enc_handle_ptr->encode_instance_total_count; ++instance_index) {
+        // The frame statistics hold the size of each tile
+        uint32_t stats_tile_count = 0;
+        if (enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->static_config.enable_frame_stats) {
+            PictureParentControlSet *parent_pcs = (PictureParentControlSet *)enc_handle_ptr->picture_parent_control_set_pool_ptr_array[instance_index]->wrapper_ptr_pool[0]->object_ptr;
+            stats_tile_count = parent_pcs->av1_cm->tiles_info.tile_rows * parent_pcs->av1_cm->tiles_info.tile_cols;
+        }
         EB_NEW(
             enc_handle_ptr->output_stream_buffer_resource_ptr_array[instance_index],
             svt_system_resource_ctor,
@@ -1802,7 +1945,7 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
             enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->total_process_init_count,//EB_PacketizationProcessInitCount,
             1,
             svt_output_buffer_header_creator,
-            &enc_handle_ptr->scs_instance_array[0]->scs_ptr->static_config,
+            &stats_tile_count,
             svt_output_buffer_header_destroyer);
     }
     enc_handle_ptr->output_stream_buffer_consumer_fifo_ptr = svt_system_resource_get_consumer_fifo(enc_handle_ptr->output_stream_buffer_resource_ptr_array[0], 0);
@@ -1930,6 +2073,19 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
             NULL);
     }
 
+    // GM search tasks, each ME process posts at most one task per reference of a list
+    if (enc_handle_ptr->scs_instance_array[0]->scs_ptr->gm_search_process_init_count) {
+        EB_NEW(
+            enc_handle_ptr->gm_search_task_resource_ptr,
+            svt_system_resource_ctor,
+            enc_handle_ptr->scs_instance_array[0]->scs_ptr->motion_estimation_process_init_count * (REF_LIST_MAX_DEPTH - 1),
+            enc_handle_ptr->scs_instance_array[0]->scs_ptr->motion_estimation_process_init_count,
+            enc_handle_ptr->scs_instance_array[0]->scs_ptr->gm_search_process_init_count,
+            gm_search_task_creator,
+            NULL,
+            NULL);
+    }
+
     // Rate Control Tasks
     {
         RateControlTasksInitData rate_control_tasks_init_data;
@@ -1991,7 +2147,7 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
             enc_handle_ptr->enc_dec_results_resource_ptr,
             svt_system_resource_ctor,
             enc_handle_ptr->scs_instance_array[0]->scs_ptr->enc_dec_fifo_init_count,
-            enc_handle_ptr->scs_instance_array[0]->scs_ptr->enc_dec_process_init_count,
+            dlf_port_total_count(),
             enc_handle_ptr->scs_instance_array[0]->scs_ptr->dlf_process_init_count,
             enc_dec_results_creator,
             &enc_dec_result_init_data,
@@ -2150,6 +2306,16 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
                 tpl_port_lookup(TPL_INPUT_PORT_TPL, process_index)
             );
         }
+        // GM search
+        EB_ALLOC_PTR_ARRAY(enc_handle_ptr->gm_search_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs_ptr->gm_search_process_init_count);
+
+        for (process_index = 0; process_index < enc_handle_ptr->scs_instance_array[0]->scs_ptr->gm_search_process_init_count; ++process_index) {
+            EB_NEW(
+                enc_handle_ptr->gm_search_context_ptr_array[process_index],
+                gm_search_context_ctor,
+                enc_handle_ptr,
+                process_index);
+        }
         // Picture Manager Context
         EB_NEW(
             enc_handle_ptr->picture_manager_context_ptr,
@@ -2203,7 +2369,8 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
                 enc_handle_ptr->dlf_context_ptr_array[process_index],
                 dlf_context_ctor,
                 enc_handle_ptr,
-                process_index);
+                process_index,
+                dlf_port_lookup(DLF_INPUT_PORT_DLF, process_index));
         }
 
         //CDEF Contexts
@@ -2262,7 +2429,7 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
 
     // Resource Coordination
     EB_CREATE_THREAD(enc_handle_ptr->resource_coordination_thread_handle, resource_coordination_kernel, enc_handle_ptr->resource_coordination_context_ptr);
-    EB_CREATE_THREAD_ARRAY(enc_handle_ptr->picture_analysis_thread_handle_array,control_set_ptr->picture_analysis_process_init_count,
+    EB_CREATE_THREAD_ARRAY(enc_handle_ptr->picture_analysis_thread_handle_array,process_thread_count(control_set_ptr, control_set_ptr->picture_analysis_process_init_count),
         picture_analysis_kernel,
         enc_handle_ptr->picture_analysis_context_ptr_array);
 
@@ -2270,10 +2437,15 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
     EB_CREATE_THREAD(enc_handle_ptr->picture_decision_thread_handle, picture_decision_kernel, enc_handle_ptr->picture_decision_context_ptr);
 
     // Motion Estimation
-    EB_CREATE_THREAD_ARRAY(enc_handle_ptr->motion_estimation_thread_handle_array, control_set_ptr->motion_estimation_process_init_count,
+    EB_CREATE_THREAD_ARRAY(enc_handle_ptr->motion_estimation_thread_handle_array, process_thread_count(control_set_ptr, control_set_ptr->motion_estimation_process_init_count),
         motion_estimation_kernel,
         enc_handle_ptr->motion_estimation_context_ptr_array);
 
+    // GM search
+    EB_CREATE_THREAD_ARRAY(enc_handle_ptr->gm_search_thread_handle_array, control_set_ptr->gm_search_process_init_count,
+        gm_search_kernel,
+        enc_handle_ptr->gm_search_context_ptr_array);
+
         // Initial Rate Control
         EB_CREATE_THREAD(enc_handle_ptr->initial_rate_control_thread_handle, initial_rate_control_kernel, enc_handle_ptr->initial_rate_control_context_ptr);
 
@@ -2283,7 +2455,7 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
             enc_handle_ptr->source_based_operations_context_ptr_array);
 
         // TPL dispenser
-        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->tpl_disp_thread_handle_array, control_set_ptr->tpl_disp_process_init_count,
+        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->tpl_disp_thread_handle_array, process_thread_count(control_set_ptr, control_set_ptr->tpl_disp_process_init_count),
             tpl_disp_kernel,//TODOOMK
             enc_handle_ptr->tpl_disp_context_ptr_array);
         // Picture Manager
@@ -2292,39 +2464,67 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
         EB_CREATE_THREAD(enc_handle_ptr->rate_control_thread_handle, rate_control_kernel, enc_handle_ptr->rate_control_context_ptr);
 
         // Mode Decision Configuration Process
-        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->mode_decision_configuration_thread_handle_array, control_set_ptr->mode_decision_configuration_process_init_count,
+        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->mode_decision_configuration_thread_handle_array, process_thread_count(control_set_ptr, control_set_ptr->mode_decision_configuration_process_init_count),
             mode_decision_configuration_kernel,
             enc_handle_ptr->mode_decision_configuration_context_ptr_array);
 
 
         // EncDec Process
-        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->enc_dec_thread_handle_array, control_set_ptr->enc_dec_process_init_count,
+        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->enc_dec_thread_handle_array, process_thread_count(control_set_ptr, control_set_ptr->enc_dec_process_init_count),
             mode_decision_kernel,
             enc_handle_ptr->enc_dec_context_ptr_array);
 
         // Dlf Process
-        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->dlf_thread_handle_array, control_set_ptr->dlf_process_init_count,
+        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->dlf_thread_handle_array, process_thread_count(control_set_ptr, control_set_ptr->dlf_process_init_count),
             dlf_kernel,
             enc_handle_ptr->dlf_context_ptr_array);
 
         // Cdef Process
-        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->cdef_thread_handle_array, control_set_ptr->cdef_process_init_count,
+        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->cdef_thread_handle_array, process_thread_count(control_set_ptr, control_set_ptr->cdef_process_init_count),
             cdef_kernel,
             enc_handle_ptr->cdef_context_ptr_array);
 
         // Rest Process
-        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->rest_thread_handle_array, control_set_ptr->rest_process_init_count,
+        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->rest_thread_handle_array, process_thread_count(control_set_ptr, control_set_ptr->rest_process_init_count),
             rest_kernel,
             enc_handle_ptr->rest_context_ptr_array);
 
         // Entropy Coding Process
-        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->entropy_coding_thread_handle_array, control_set_ptr->entropy_coding_process_init_count,
+        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->entropy_coding_thread_handle_array, process_thread_count(control_set_ptr, control_set_ptr->entropy_coding_process_init_count),
             entropy_coding_kernel,
             enc_handle_ptr->entropy_coding_context_ptr_array);
 
+    // Worker Pool, context 0 of each process belongs to its dedicated thread
+    if (control_set_ptr->worker_pool_size) {
+        EB_NEW(enc_handle_ptr->worker_pool, svt_worker_pool_ctor, control_set_ptr->worker_pool_size);
+        EbWorkerPool *pool_ptr = enc_handle_ptr->worker_pool;
+        svt_worker_pool_add_stage(pool_ptr, enc_handle_ptr->resource_coordination_results_resource_ptr,
+            picture_analysis_process_task, enc_handle_ptr->picture_analysis_context_ptr_array + 1);
+        svt_worker_pool_add_stage(pool_ptr, enc_handle_ptr->picture_decision_results_resource_ptr,
+            motion_estimation_process_task, enc_handle_ptr->motion_estimation_context_ptr_array + 1);
+        svt_worker_pool_add_stage(pool_ptr, enc_handle_ptr->tpl_disp_res_srm,
+            tpl_disp_process_task, enc_handle_ptr->tpl_disp_context_ptr_array + 1);
+        svt_worker_pool_add_stage(pool_ptr, enc_handle_ptr->rate_control_results_resource_ptr,
+            mode_decision_configuration_process_task, enc_handle_ptr->mode_decision_configuration_context_ptr_array + 1);
+        svt_worker_pool_add_stage(pool_ptr, enc_handle_ptr->enc_dec_tasks_resource_ptr,
+            mode_decision_process_task, enc_handle_ptr->enc_dec_context_ptr_array + 1);
+        svt_worker_pool_add_stage(pool_ptr, enc_handle_ptr->enc_dec_results_resource_ptr,
+            dlf_process_task, enc_handle_ptr->dlf_context_ptr_array + 1);
+        svt_worker_pool_add_stage(pool_ptr, enc_handle_ptr->dlf_results_resource_ptr,
+            cdef_process_task, enc_handle_ptr->cdef_context_ptr_array + 1);
+        svt_worker_pool_add_stage(pool_ptr, enc_handle_ptr->cdef_results_resource_ptr,
+            rest_process_task, enc_handle_ptr->rest_context_ptr_array + 1);
+        svt_worker_pool_add_stage(pool_ptr, enc_handle_ptr->rest_results_resource_ptr,
+            entropy_coding_process_task, enc_handle_ptr->entropy_coding_context_ptr_array + 1);
+        for (uint32_t i = 0; i < pool_ptr->worker_count; i++)
+            EB_CREATE_THREAD(pool_ptr->thread_handle_array[i], svt_worker_pool_kernel, &pool_ptr->worker_array[i]);
+    }
+
     // Packetization
     EB_CREATE_THREAD(enc_handle_ptr->packetization_thread_handle, packetization_kernel, enc_handle_ptr->packetization_context_ptr);
 
+    enc_handle_ptr->start_time = svt_av1_get_time_us();
+
     svt_print_memory_usage();
 
     return return_error;
@@ -2348,6 +2548,7 @@ EB_API EbErrorType svt_av1_enc_deinit(EbComponentType *svt_enc_component){
         svt_shutdown_process(handle->initial_rate_control_results_resource_ptr);
         svt_shutdown_process(handle->picture_demux_results_resource_ptr);
         svt_shutdown_process(handle->tpl_disp_res_srm);
+        svt_shutdown_process(handle->gm_search_task_resource_ptr);
         svt_shutdown_process(handle->rate_control_tasks_resource_ptr);
         svt_shutdown_process(handle->rate_control_results_resource_ptr);
         svt_shutdown_process(handle->enc_dec_tasks_resource_ptr);
@@ -3241,6 +3442,8 @@ void set_multi_pass_params(SequenceControlSet *scs_ptr)
 
     if (config->rate_control_mode == 0 && config->pass == 2)
         scs_ptr->static_config.pass = 3; //use last pass for 2nd pass CRF
+    scs_ptr->chunk_start_frame = config->chunk_start_frame > 0 ? (uint64_t)config->chunk_start_frame
+                                                               : 0;
 
     switch (config->pass) {
 
@@ -3358,6 +3561,11 @@ void set_param_based_on_input(SequenceControlSet *scs_ptr)
 {
     set_multi_pass_params(
         scs_ptr);
+    // Input planes can only be lent to the pipeline when they are used as-is
+    scs_ptr->zero_copy_input = scs_ptr->static_config.release_input_picture != NULL &&
+        scs_ptr->static_config.encoder_bit_depth == EB_8BIT &&
+        scs_ptr->static_config.encoder_color_format == EB_YUV420 &&
+        !scs_ptr->mid_pass_ctrls.ds && !scs_ptr->ipp_pass_ctrls.ds;
 #if TUNE_4L_M9 || TUNE_4L_M10
 #if FIX_AQ_MODE
     scs_ptr->tpl_level = get_tpl_level(scs_ptr->static_config.enc_mode, scs_ptr->static_config.pass, scs_ptr->lap_rc, scs_ptr->static_config.pred_structure, scs_ptr->static_config.superres_mode, scs_ptr->static_config.hierarchical_levels, scs_ptr->static_config.enable_adaptive_quantization);
@@ -3393,9 +3601,12 @@ void set_param_based_on_input(SequenceControlSet *scs_ptr)
     scs_ptr->seq_header.max_frame_height = scs_ptr->max_input_luma_height;
     scs_ptr->static_config.source_width = scs_ptr->max_input_luma_width;
     scs_ptr->static_config.source_height = scs_ptr->max_input_luma_height;
+    // SUPERRES_FIXED without scaling only stays on when svt_av1_enc_reconfigure()
+    // may reduce the coded width later
     if (scs_ptr->static_config.superres_mode == SUPERRES_FIXED &&
         scs_ptr->static_config.superres_denom == SCALE_NUMERATOR &&
-        scs_ptr->static_config.superres_kf_denom == SCALE_NUMERATOR) {
+        scs_ptr->static_config.superres_kf_denom == SCALE_NUMERATOR &&
+        !scs_ptr->static_config.superres_reconfig) {
         scs_ptr->static_config.superres_mode = SUPERRES_NONE;
     }
     if (scs_ptr->static_config.superres_mode == SUPERRES_QTHRESH &&
@@ -3534,6 +3745,9 @@ void set_param_based_on_input(SequenceControlSet *scs_ptr)
             scs_ptr->super_block_size = 64;
     if (scs_ptr->static_config.rate_control_mode && !(scs_ptr->static_config.pass == ENC_MIDDLE_PASS || scs_ptr->static_config.pass == ENC_LAST_PASS) && !scs_ptr->lap_rc)
         scs_ptr->super_block_size = 64;
+    // The ROI map segments are 64x64 blocks
+    if (scs_ptr->static_config.enable_roi_map)
+        scs_ptr->super_block_size = 64;
 
     // scs_ptr->static_config.hierarchical_levels = (scs_ptr->static_config.rate_control_mode > 1) ? 3 : scs_ptr->static_config.hierarchical_levels;
     if (scs_ptr->static_config.restricted_motion_vector && scs_ptr->super_block_size == 128) {
@@ -3869,6 +4083,8 @@ void copy_api_from_app(
 
     scs_ptr->static_config.rc_stats_buffer = ((EbSvtAv1EncConfiguration*)config_struct)->rc_stats_buffer;
     scs_ptr->static_config.pass = ((EbSvtAv1EncConfiguration*)config_struct)->pass;
+    scs_ptr->static_config.chunk_start_frame = ((EbSvtAv1EncConfiguration*)config_struct)->chunk_start_frame;
+    scs_ptr->static_config.chunk_frame_count = ((EbSvtAv1EncConfiguration*)config_struct)->chunk_frame_count;
     // Deblock Filter
     scs_ptr->static_config.enable_dlf_flag = ((EbSvtAv1EncConfiguration*)config_struct)->enable_dlf_flag;
 
@@ -3882,6 +4098,8 @@ void copy_api_from_app(
 
     // Decoder Optimization Flag
     scs_ptr->static_config.fast_decode = ((EbSvtAv1EncConfiguration*)config_struct)->fast_decode;
+    scs_ptr->static_config.release_input_picture = ((EbSvtAv1EncConfiguration*)config_struct)->release_input_picture;
+    scs_ptr->static_config.release_input_private_data = ((EbSvtAv1EncConfiguration*)config_struct)->release_input_private_data;
     //If the set fast_decode value is in the allowable range, check that the value is supported for the current preset.
     // If the value is valid, but not supported in the current preset, change the value to one that is supported.
 #if TUNE_FAST_DECODE
@@ -3941,8 +4159,8 @@ void copy_api_from_app(
     // MD Parameters
     scs_ptr->enable_hbd_mode_decision = ((EbSvtAv1EncConfiguration*)config_struct)->encoder_bit_depth > 8 ? DEFAULT : 0;
     // Adaptive Loop Filter
-    scs_ptr->static_config.tile_rows = scs_ptr->static_config.pass == ENC_FIRST_PASS ? 0 : ((EbSvtAv1EncConfiguration*)config_struct)->tile_rows;
-    scs_ptr->static_config.tile_columns = scs_ptr->static_config.pass == ENC_FIRST_PASS ? 0 : ((EbSvtAv1EncConfiguration*)config_struct)->tile_columns;
+    scs_ptr->static_config.tile_rows = scs_ptr->static_config.pass == ENC_FIRST_PASS || config_struct->lookahead_only ? 0 : ((EbSvtAv1EncConfiguration*)config_struct)->tile_rows;
+    scs_ptr->static_config.tile_columns = scs_ptr->static_config.pass == ENC_FIRST_PASS || config_struct->lookahead_only ? 0 : ((EbSvtAv1EncConfiguration*)config_struct)->tile_columns;
     scs_ptr->static_config.restricted_motion_vector = ((EbSvtAv1EncConfiguration*)config_struct)->restricted_motion_vector;
 
     // Rate Control
@@ -4037,6 +4255,7 @@ void copy_api_from_app(
     scs_ptr->static_config.starting_buffer_level_ms = ((EbSvtAv1EncConfiguration*)config_struct)->starting_buffer_level_ms;
     scs_ptr->static_config.optimal_buffer_level_ms  = ((EbSvtAv1EncConfiguration*)config_struct)->optimal_buffer_level_ms;
     scs_ptr->static_config.recode_loop         = ((EbSvtAv1EncConfiguration*)config_struct)->recode_loop;
+    scs_ptr->static_config.sb_row_recode       = ((EbSvtAv1EncConfiguration*)config_struct)->sb_row_recode;
 #if FRFCTR_RC_P9
     if (scs_ptr->static_config.rate_control_mode == 1 && scs_ptr->static_config.pass == ENC_SINGLE_PASS)
 #else
@@ -4048,6 +4267,12 @@ void copy_api_from_app(
     //Segmentation
     //TODO: check RC mode and set only when RC is enabled in the final version.
     scs_ptr->static_config.enable_adaptive_quantization = config_struct->enable_adaptive_quantization;
+    scs_ptr->static_config.enable_roi_map = config_struct->enable_roi_map;
+    scs_ptr->static_config.enable_frame_stats = config_struct->enable_frame_stats;
+    // The lookahead only mode returns its analysis through the frame statistics
+    scs_ptr->static_config.lookahead_only = config_struct->lookahead_only;
+    if (scs_ptr->static_config.lookahead_only)
+        scs_ptr->static_config.enable_frame_stats = TRUE;
 
     // Misc
     scs_ptr->static_config.encoder_bit_depth = ((EbSvtAv1EncConfiguration*)config_struct)->encoder_bit_depth;
@@ -4089,6 +4314,7 @@ void copy_api_from_app(
 #endif
     scs_ptr->static_config.pin_threads = ((EbSvtAv1EncConfiguration*)config_struct)->pin_threads;
     scs_ptr->static_config.target_socket = ((EbSvtAv1EncConfiguration*)config_struct)->target_socket;
+    scs_ptr->static_config.enable_worker_pool = ((EbSvtAv1EncConfiguration*)config_struct)->enable_worker_pool;
     if ((scs_ptr->static_config.pin_threads == 0) && (scs_ptr->static_config.target_socket != -1)){
         SVT_WARN("threads pinning 0 and ss %d is not a valid combination: unpin will be set to 0\n", scs_ptr->static_config.target_socket);
         scs_ptr->static_config.pin_threads = 1;
@@ -4118,6 +4344,7 @@ void copy_api_from_app(
     scs_ptr->static_config.superres_kf_denom = config_struct->superres_kf_denom;
     scs_ptr->static_config.superres_qthres = config_struct->superres_qthres;
     scs_ptr->static_config.superres_kf_qthres = config_struct->superres_kf_qthres;
+    scs_ptr->static_config.superres_reconfig = config_struct->superres_reconfig;
     if (scs_ptr->static_config.superres_mode == SUPERRES_AUTO)
     {
         // TODO: set search mode based on preset
@@ -4264,6 +4491,7 @@ EB_API EbErrorType svt_av1_enc_stream_header(
     output_stream_buffer->size = sizeof(EbBufferHeaderType);
     output_stream_buffer->n_alloc_len = output_buffer_size;
     output_stream_buffer->p_app_private = NULL;
+    output_stream_buffer->frame_stats = NULL;
     output_stream_buffer->pic_type = EB_AV1_INVALID_PICTURE;
     output_stream_buffer->n_filled_len = 0;
 
@@ -4803,6 +5031,26 @@ static EbErrorType copy_frame_buffer(
  Copy the input buffer header content
 from the sample application to the library buffers
 */
+/*
+ Point the library buffers at the application planes
+ (zero-copy input, the planes follow the SVT_AV1_STREAM_INFO_INPUT_LAYOUT layout)
+*/
+static void lend_frame_buffer(
+    SequenceControlSet            *scs_ptr,
+    EbPictureBufferDesc           *input_picture_ptr,
+    EbPictureBufferDesc           *y8b_input_picture_ptr,
+    EbSvtIOFormat                 *input_ptr)
+{
+    uint32_t luma_buffer_offset = y8b_input_picture_ptr->stride_y * scs_ptr->top_padding +
+        scs_ptr->left_padding;
+    uint32_t chroma_buffer_offset = input_picture_ptr->stride_cb * (scs_ptr->top_padding >> 1) +
+        (scs_ptr->left_padding >> 1);
+
+    y8b_input_picture_ptr->buffer_y = input_ptr->luma - luma_buffer_offset;
+    input_picture_ptr->buffer_cb = input_ptr->cb - chroma_buffer_offset;
+    input_picture_ptr->buffer_cr = input_ptr->cr - chroma_buffer_offset;
+}
+
 static void copy_input_buffer(
     SequenceControlSet*    sequenceControlSet,
     EbBufferHeaderType*     dst,
@@ -4826,7 +5074,20 @@ static void copy_input_buffer(
         copy_frame = (((src->pts % 8) == 0) || ((src->pts % 8) == 6) || ((src->pts % 8) == 7));
     else if (sequenceControlSet->ipp_pass_ctrls.skip_frame_first_pass == 2)
         copy_frame = ((src->pts < 7) || ((src->pts % 8) == 0) || ((src->pts % 8) == 6) || ((src->pts % 8) == 7));
-    if (sequenceControlSet->mid_pass_ctrls.ds || sequenceControlSet->ipp_pass_ctrls.ds) {
+    if (sequenceControlSet->zero_copy_input) {
+        // Reference the application planes; released through release_input_picture.
+        // The application header may be reused once sent, keep what the callback needs
+        EbBufferHeaderType *lent_hdr = (EbBufferHeaderType*)dst_y8b->p_app_private;
+        lent_hdr->p_buffer = src->p_buffer;
+        lent_hdr->p_app_private = src->p_app_private;
+        lent_hdr->pts = src->pts;
+        if (src->p_buffer != NULL)
+            lend_frame_buffer(sequenceControlSet,
+                              (EbPictureBufferDesc*)dst->p_buffer,
+                              (EbPictureBufferDesc*)dst_y8b->p_buffer,
+                              (EbSvtIOFormat*)src->p_buffer);
+    }
+    else if (sequenceControlSet->mid_pass_ctrls.ds || sequenceControlSet->ipp_pass_ctrls.ds) {
         // Copy the picture buffer
         if (src->p_buffer != NULL)
             downsample_copy_frame_buffer(sequenceControlSet, dst->p_buffer, dst_y8b->p_buffer, src->p_buffer, pass);
@@ -4861,14 +5122,107 @@ static EbErrorType copy_metadata_buffer(EbBufferHeaderType *dst, EbBufferHeaderT
 /**********************************
 * Empty This Buffer
 **********************************/
+/**********************************
+* Reconfigure
+**********************************/
+EB_API EbErrorType svt_av1_enc_reconfigure(
+    EbComponentType         *svt_enc_component,
+    const SvtAv1EncReconfig *reconfig)
+{
+    if (svt_enc_component == NULL || reconfig == NULL)
+        return EB_ErrorBadParameter;
+    EbEncHandle                    *enc_handle_ptr = (EbEncHandle*)svt_enc_component->p_component_private;
+    EbSequenceControlSetInstance   *scs_instance   = enc_handle_ptr->scs_instance_array[0];
+    const EbSvtAv1EncConfiguration *config         = &scs_instance->scs_ptr->static_config;
+    EbErrorType                     return_error   = EB_ErrorNone;
+
+    if (config->pass != ENC_SINGLE_PASS || scs_instance->scs_ptr->passes > 1) {
+        SVT_ERROR("svt_av1_enc_reconfigure: only available for single pass encodes\n");
+        return_error = EB_ErrorBadParameter;
+    }
+    if (reconfig->target_bit_rate && !config->rate_control_mode) {
+        SVT_ERROR("svt_av1_enc_reconfigure: target_bit_rate needs VBR or CBR\n");
+        return_error = EB_ErrorBadParameter;
+    }
+    if (reconfig->max_bit_rate && !config->max_bit_rate) {
+        SVT_ERROR("svt_av1_enc_reconfigure: max_bit_rate needs a configured maximum bitrate\n");
+        return_error = EB_ErrorBadParameter;
+    }
+    if (reconfig->maximum_buffer_size_ms &&
+        (config->rate_control_mode != 2 || reconfig->maximum_buffer_size_ms < 0)) {
+        SVT_ERROR("svt_av1_enc_reconfigure: maximum_buffer_size_ms must be positive and needs CBR\n");
+        return_error = EB_ErrorBadParameter;
+    }
+    if (reconfig->superres_denom &&
+        (config->superres_mode != SUPERRES_FIXED || !config->superres_reconfig ||
+         reconfig->superres_denom < MIN_SUPERRES_DENOM ||
+         reconfig->superres_denom > MAX_SUPERRES_DENOM)) {
+        SVT_ERROR("svt_av1_enc_reconfigure: superres_denom needs superres_mode %d, "
+                  "superres_reconfig and a value within [%d, %d]\n",
+                  SUPERRES_FIXED,
+                  MIN_SUPERRES_DENOM,
+                  MAX_SUPERRES_DENOM);
+        return_error = EB_ErrorBadParameter;
+    }
+    if (return_error != EB_ErrorNone)
+        return return_error;
+
+    // Merge with the changes not sent yet, svt_av1_enc_send_picture() takes them
+    svt_block_on_mutex(scs_instance->config_mutex);
+    SvtAv1EncReconfig *pending = &enc_handle_ptr->reconfig;
+    if (!enc_handle_ptr->reconfig_pending)
+        memset(pending, 0, sizeof(*pending));
+    if (reconfig->target_bit_rate)
+        pending->target_bit_rate = reconfig->target_bit_rate;
+    if (reconfig->max_bit_rate)
+        pending->max_bit_rate = reconfig->max_bit_rate;
+    if (reconfig->maximum_buffer_size_ms)
+        pending->maximum_buffer_size_ms = reconfig->maximum_buffer_size_ms;
+    if (reconfig->superres_denom)
+        pending->superres_denom = reconfig->superres_denom;
+    enc_handle_ptr->reconfig_pending = TRUE;
+    svt_release_mutex(scs_instance->config_mutex);
+    return EB_ErrorNone;
+}
+
 EB_API EbErrorType svt_av1_enc_send_picture(
     EbComponentType      *svt_enc_component,
     EbBufferHeaderType   *p_buffer)
 {
     EbEncHandle          *enc_handle_ptr = (EbEncHandle*)svt_enc_component->p_component_private;
+    SequenceControlSet   *scs_ptr = enc_handle_ptr->scs_instance_array[0]->scs_ptr;
     EbObjectWrapper      *eb_wrapper_ptr;
     EbBufferHeaderType   *app_hdr = p_buffer;
 
+    if (scs_ptr->zero_copy_input && p_buffer != NULL && p_buffer->p_buffer != NULL) {
+        // Lent planes must follow the library layout, they are padded in place
+        EbSvtIOFormat *input_ptr = (EbSvtIOFormat*)p_buffer->p_buffer;
+        EbBufferHeaderType *y8b_hdr = (EbBufferHeaderType*)
+            enc_handle_ptr->input_y8b_buffer_resource_ptr->wrapper_ptr_pool[0]->object_ptr;
+        EbPictureBufferDesc *y8b_desc = (EbPictureBufferDesc*)y8b_hdr->p_buffer;
+        if (input_ptr->y_stride != y8b_desc->stride_y ||
+            input_ptr->cb_stride != (y8b_desc->stride_y >> 1) ||
+            input_ptr->cr_stride != (y8b_desc->stride_y >> 1)) {
+            SVT_ERROR("Zero-copy input strides do not match SVT_AV1_STREAM_INFO_INPUT_LAYOUT\n");
+            return EB_ErrorBadParameter;
+        }
+    }
+
+    // The first pass ignores the ROI map
+    const SvtAv1RoiMap *roi_map = scs_ptr->static_config.enable_roi_map &&
+        scs_ptr->static_config.pass != ENC_FIRST_PASS && p_buffer != NULL &&
+        p_buffer->p_buffer != NULL ? p_buffer->roi_map : NULL;
+    if (roi_map) {
+        int16_t seg_qp[MAX_SEGMENTS];
+        uint8_t seg_count;
+        if (roi_map->b64_count != scs_ptr->sb_total_count ||
+            roi_map_to_segments(roi_map, NULL, seg_qp, &seg_count) != EB_ErrorNone) {
+            SVT_ERROR("The ROI map needs %u offsets in [-%d, %d], with at most %d distinct values\n",
+                scs_ptr->sb_total_count, MAXQ, MAXQ, MAX_SEGMENTS);
+            return EB_ErrorBadParameter;
+        }
+    }
+
     // Get new Luma-8b buffer & a new (Chroma-8b + Luma-Chroma-2bit) buffers; Lib will release once done.
     EbObjectWrapper  *eb_y8b_wrapper_ptr;
     svt_get_empty_object(
@@ -4899,6 +5253,12 @@ EB_API EbErrorType svt_av1_enc_send_picture(
             lib_y8b_hdr,
             app_hdr,
             enc_handle_ptr->scs_instance_array[0]->scs_ptr->static_config.pass == ENC_FIRST_PASS);
+
+        // The picture has been copied, the application planes can be reused right away
+        if (!scs_ptr->zero_copy_input && scs_ptr->static_config.release_input_picture &&
+            app_hdr->p_buffer != NULL)
+            scs_ptr->static_config.release_input_picture(
+                app_hdr, scs_ptr->static_config.release_input_private_data);
     }
 
     //Take a new App-RessCoord command
@@ -4910,6 +5270,23 @@ EB_API EbErrorType svt_av1_enc_send_picture(
     //Fill the command with two picture buffers
     input_cmd_obj->eb_input_wrapper_ptr = eb_wrapper_ptr;
     input_cmd_obj->eb_y8b_wrapper_ptr = eb_y8b_wrapper_ptr;
+    // Attach the pending svt_av1_enc_reconfigure() changes
+    svt_block_on_mutex(enc_handle_ptr->scs_instance_array[0]->config_mutex);
+    input_cmd_obj->reconfig_present = enc_handle_ptr->reconfig_pending;
+    input_cmd_obj->reconfig = enc_handle_ptr->reconfig;
+    enc_handle_ptr->reconfig_pending = FALSE;
+    svt_release_mutex(enc_handle_ptr->scs_instance_array[0]->config_mutex);
+    // Copy the ROI map, the application can reuse it once the picture is sent
+    input_cmd_obj->roi_map_present = roi_map != NULL;
+    if (roi_map) {
+        roi_map_to_segments(roi_map,
+            input_cmd_obj->roi_seg_map,
+            input_cmd_obj->roi_seg_qp,
+            &input_cmd_obj->roi_seg_count);
+        input_cmd_obj->roi_skip_present = roi_map->skip != NULL;
+        if (roi_map->skip)
+            svt_memcpy(input_cmd_obj->roi_skip_map, roi_map->skip, roi_map->b64_count);
+    }
     //Send to Lib
     svt_post_full_object(input_cmd_wrp);
 
@@ -5140,7 +5517,9 @@ static EbErrorType allocate_frame_buffer(
 
     input_pic_buf_desc_init_data.split_mode = is_16bit ? TRUE : FALSE;
 
-    input_pic_buf_desc_init_data.buffer_enable_mask = PICTURE_BUFFER_DESC_FULL_MASK;
+    // zero-copy input pictures reference the application planes
+    input_pic_buf_desc_init_data.buffer_enable_mask = noy8b && scs_ptr->zero_copy_input ?
+        0 : PICTURE_BUFFER_DESC_FULL_MASK;
     input_pic_buf_desc_init_data.is_16bit_pipeline = 0;
 
     // Enhanced Picture Buffer
@@ -5196,7 +5575,8 @@ static EbErrorType allocate_y8b_frame_buffer(
 
     input_pic_buf_desc_init_data.split_mode = is_16bit ? TRUE : FALSE;
 
-    input_pic_buf_desc_init_data.buffer_enable_mask = PICTURE_BUFFER_DESC_LUMA_MASK; //allocate for 8bit Luma only
+    input_pic_buf_desc_init_data.buffer_enable_mask = scs_ptr->zero_copy_input ?
+        0 : PICTURE_BUFFER_DESC_LUMA_MASK; //allocate for 8bit Luma only
     input_pic_buf_desc_init_data.is_16bit_pipeline = 0;
 
 
@@ -5237,9 +5617,33 @@ EbErrorType svt_input_y8b_creator(
         return return_error;
 
     input_buffer->p_app_private = NULL;
+    // zero-copy input: copy of the header of the lent picture, handed to release_input_picture
+    if (scs_ptr->zero_copy_input) {
+        EbBufferHeaderType *lent_hdr;
+        EB_CALLOC(lent_hdr, 1, sizeof(EbBufferHeaderType));
+        lent_hdr->size = sizeof(EbBufferHeaderType);
+        input_buffer->p_app_private = lent_hdr;
+    }
 
     return EB_ErrorNone;
 }
+/*
+  hand a lent input picture back to the application (zero-copy input)
+*/
+void svt_release_input_y8b(EbPtr object_ptr, EbPtr context_ptr)
+{
+    EbBufferHeaderType *obj = (EbBufferHeaderType*)object_ptr;
+    SequenceControlSet *scs_ptr = (SequenceControlSet*)context_ptr;
+    EbBufferHeaderType *lent_hdr = (EbBufferHeaderType*)obj->p_app_private;
+
+    if (lent_hdr->p_buffer) {
+        ((EbPictureBufferDesc*)obj->p_buffer)->buffer_y = NULL;
+        scs_ptr->static_config.release_input_picture(
+            lent_hdr, scs_ptr->static_config.release_input_private_data);
+        lent_hdr->p_buffer = NULL;
+        lent_hdr->p_app_private = NULL;
+    }
+}
 /*
   free a luma 8bit buffer descriptor
 */
@@ -5254,6 +5658,8 @@ void svt_input_y8b_destroyer(EbPtr p)
     }
 
     EB_DELETE(buf);
+    if (obj->p_app_private)
+        EB_FREE(obj->p_app_private);
     EB_FREE(obj);
 }
 
@@ -5331,7 +5737,8 @@ EbErrorType svt_output_buffer_header_creator(
     EbPtr *object_dbl_ptr,
     EbPtr object_init_data_ptr)
 {
-    (void)object_init_data_ptr;
+    // tile count of the frame statistics, 0 when enable_frame_stats is off
+    const uint32_t stats_tile_count = *(uint32_t*)object_init_data_ptr;
     EbBufferHeaderType* out_buf_ptr;
 
     *object_dbl_ptr = NULL;
@@ -5343,6 +5750,10 @@ EbErrorType svt_output_buffer_header_creator(
     // p_buffer and n_alloc_len are dynamically set in EbPacketizationProcess
     // out_buf_ptr->n_alloc_len;
     out_buf_ptr->p_app_private = NULL;
+    if (stats_tile_count) {
+        EB_CALLOC(out_buf_ptr->frame_stats, 1, sizeof(SvtAv1FrameStats));
+        EB_CALLOC_ARRAY(out_buf_ptr->frame_stats->tile_size, stats_tile_count);
+    }
 
     return EB_ErrorNone;
 }
@@ -5350,6 +5761,10 @@ EbErrorType svt_output_buffer_header_creator(
 void svt_output_buffer_header_destroyer(    EbPtr p)
 {
     EbBufferHeaderType* obj = (EbBufferHeaderType*)p;
+    if (obj->frame_stats) {
+        EB_FREE_ARRAY(obj->frame_stats->tile_size);
+        EB_FREE(obj->frame_stats);
+    }
     EB_FREE(obj);
 }
 
@@ -5393,6 +5808,67 @@ void svt_output_recon_buffer_header_destroyer(    EbPtr p)
     EB_FREE(obj);
 }
 
+static void get_pool_stats(const EbSystemResource *resource_ptr, SvtAv1PoolStats *pool_stats) {
+    EbSystemResourceStats stats;
+    svt_system_resource_get_stats(resource_ptr, &stats);
+    pool_stats->total_count   = stats.object_total_count;
+    pool_stats->in_use_count  = stats.object_total_count - MIN(stats.empty_count, stats.object_total_count);
+    pool_stats->stall_time_us = stats.producer_wait_time;
+}
+
+/**********************************
+* get_pipeline_stats
+*   Each stage is described by its input queue: the time its
+*   threads sleep on it is the stage idle time.
+**********************************/
+static void get_pipeline_stats(EbEncHandle *enc_handle_ptr, SvtAv1PipelineStats *pipeline_stats) {
+    SequenceControlSet *scs_ptr = enc_handle_ptr->scs_instance_array[0]->scs_ptr;
+    const struct {
+        EbSystemResource *input_resource_ptr;
+        uint32_t          thread_count;
+    } stages[SVT_AV1_STAGE_COUNT] = {
+        {enc_handle_ptr->input_cmd_resource_ptr, EB_ResourceCoordinationProcessInitCount},
+        {enc_handle_ptr->resource_coordination_results_resource_ptr, process_thread_count(scs_ptr, scs_ptr->picture_analysis_process_init_count)},
+        {enc_handle_ptr->picture_analysis_results_resource_ptr, EB_PictureDecisionProcessInitCount},
+        {enc_handle_ptr->picture_decision_results_resource_ptr, process_thread_count(scs_ptr, scs_ptr->motion_estimation_process_init_count)},
+        {enc_handle_ptr->motion_estimation_results_resource_ptr, EB_InitialRateControlProcessInitCount},
+        {enc_handle_ptr->initial_rate_control_results_resource_ptr, scs_ptr->source_based_operations_process_init_count},
+        {enc_handle_ptr->tpl_disp_res_srm, process_thread_count(scs_ptr, scs_ptr->tpl_disp_process_init_count)},
+        {enc_handle_ptr->picture_demux_results_resource_ptr, EB_PictureManagerProcessInitCount},
+        {enc_handle_ptr->rate_control_tasks_resource_ptr, EB_RateControlProcessInitCount},
+        {enc_handle_ptr->rate_control_results_resource_ptr, process_thread_count(scs_ptr, scs_ptr->mode_decision_configuration_process_init_count)},
+        {enc_handle_ptr->enc_dec_tasks_resource_ptr, process_thread_count(scs_ptr, scs_ptr->enc_dec_process_init_count)},
+        {enc_handle_ptr->enc_dec_results_resource_ptr, process_thread_count(scs_ptr, scs_ptr->dlf_process_init_count)},
+        {enc_handle_ptr->dlf_results_resource_ptr, process_thread_count(scs_ptr, scs_ptr->cdef_process_init_count)},
+        {enc_handle_ptr->cdef_results_resource_ptr, process_thread_count(scs_ptr, scs_ptr->rest_process_init_count)},
+        {enc_handle_ptr->rest_results_resource_ptr, process_thread_count(scs_ptr, scs_ptr->entropy_coding_process_init_count)},
+        {enc_handle_ptr->entropy_coding_results_resource_ptr, EB_PacketizationProcessInitCount},
+    };
+    const uint64_t elapsed_time = svt_av1_get_time_us() - enc_handle_ptr->start_time;
+
+    pipeline_stats->elapsed_time_us = elapsed_time;
+    for (int i = 0; i < SVT_AV1_STAGE_COUNT; i++) {
+        SvtAv1StageStats     *stage_stats = &pipeline_stats->stage[i];
+        EbSystemResourceStats stats;
+        svt_system_resource_get_stats(stages[i].input_resource_ptr, &stats);
+        const uint64_t thread_time = stages[i].thread_count * elapsed_time;
+        stage_stats->thread_count = stages[i].thread_count;
+        stage_stats->queue_depth  = stats.full_count;
+        stage_stats->task_count   = stats.full_get_count;
+        stage_stats->idle_time_us = MIN(stats.consumer_wait_time, thread_time);
+        stage_stats->busy_time_us = thread_time - stage_stats->idle_time_us;
+        if (enc_handle_ptr->worker_pool)
+            stage_stats->busy_time_us += svt_worker_pool_get_busy_time(
+                enc_handle_ptr->worker_pool, stages[i].input_resource_ptr);
+    }
+    get_pool_stats(enc_handle_ptr->input_buffer_resource_ptr, &pipeline_stats->input_pool);
+    get_pool_stats(enc_handle_ptr->picture_parent_control_set_pool_ptr_array[0], &pipeline_stats->parent_pcs_pool);
+    get_pool_stats(enc_handle_ptr->picture_control_set_pool_ptr_array[0], &pipeline_stats->child_pcs_pool);
+    get_pool_stats(enc_handle_ptr->pa_reference_picture_pool_ptr_array[0], &pipeline_stats->pa_reference_pool);
+    get_pool_stats(enc_handle_ptr->reference_picture_pool_ptr_array[0], &pipeline_stats->reference_pool);
+    get_pool_stats(enc_handle_ptr->output_stream_buffer_resource_ptr_array[0], &pipeline_stats->output_stream_pool);
+}
+
 /**********************************
 * svt_av1_enc_get_stream_info get stream information from encoder
 **********************************/
@@ -5410,6 +5886,51 @@ EB_API EbErrorType svt_av1_enc_get_stream_info(EbComponentType *    svt_enc_comp
         first_pass_stats->sz = context->stats_out.size * sizeof(FIRSTPASS_STATS);
         return EB_ErrorNone;
     }
+    if (stream_info_id == SVT_AV1_STREAM_INFO_INPUT_LAYOUT) {
+        // Only available after svt_av1_enc_init() for streams eligible to zero-copy input
+        if (!enc_handle->input_y8b_buffer_resource_ptr ||
+            !enc_handle->scs_instance_array[0]->scs_ptr->zero_copy_input)
+            return EB_ErrorBadParameter;
+        EbBufferHeaderType *y8b_hdr = (EbBufferHeaderType*)
+            enc_handle->input_y8b_buffer_resource_ptr->wrapper_ptr_pool[0]->object_ptr;
+        EbPictureBufferDesc *y8b_desc = (EbPictureBufferDesc*)y8b_hdr->p_buffer;
+        SvtAv1InputLayout   *layout = (SvtAv1InputLayout*)info;
+        layout->y_stride = y8b_desc->stride_y;
+        layout->uv_stride = y8b_desc->stride_y >> 1;
+        layout->origin_x = y8b_desc->origin_x;
+        layout->origin_y = y8b_desc->origin_y;
+        layout->luma_size = y8b_desc->luma_size;
+        layout->chroma_size = y8b_desc->luma_size >> 2;
+        return EB_ErrorNone;
+    }
+    if (stream_info_id == SVT_AV1_STREAM_INFO_PIPELINE_STATS) {
+        // The pipeline only exists after svt_av1_enc_init()
+        if (!enc_handle->start_time)
+            return EB_ErrorBadParameter;
+        get_pipeline_stats(enc_handle, (SvtAv1PipelineStats*)info);
+        return EB_ErrorNone;
+    }
     return EB_ErrorBadParameter;
 }
+
+/**********************************
+* svt_av1_enc_init_stats_header / svt_av1_enc_map_stats / svt_av1_enc_unmap_stats
+* multi-pass stats file helpers, see firstpass.c
+**********************************/
+EB_API void svt_av1_enc_init_stats_header(SvtAv1StatsHeader *header,
+                                          const SvtAv1FixedBuf *rc_stats_buffer)
+{
+    svt_av1_init_stats_header(header, rc_stats_buffer->sz);
+}
+EB_API EbErrorType svt_av1_enc_map_stats(const char *path, uint64_t first_frame,
+                                         uint64_t frame_count, SvtAv1FixedBuf *rc_stats_buffer)
+{
+    if (!path || !rc_stats_buffer)
+        return EB_ErrorBadParameter;
+    return svt_av1_map_stats(path, first_frame, frame_count, rc_stats_buffer);
+}
+EB_API void svt_av1_enc_unmap_stats(SvtAv1FixedBuf *rc_stats_buffer)
+{
+    svt_av1_unmap_stats(rc_stats_buffer);
+}
 // clang-format on
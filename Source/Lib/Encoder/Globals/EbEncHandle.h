@@ -18,6 +18,7 @@
 #include "EbSystemResourceManager.h"
 #include "EbSequenceControlSet.h"
 #include "EbObject.h"
+#include "EbWorkerPool.h"
 
 struct _EbThreadContext {
     EbDctor dctor;
@@ -69,6 +70,7 @@ struct _EbEncHandle {
     EbHandle  initial_rate_control_thread_handle;
     EbHandle *source_based_operations_thread_handle_array;
     EbHandle *tpl_disp_thread_handle_array;
+    EbHandle *gm_search_thread_handle_array;
     EbHandle  picture_manager_thread_handle;
     EbHandle  rate_control_thread_handle;
     EbHandle *mode_decision_configuration_thread_handle_array;
@@ -77,6 +79,7 @@ struct _EbEncHandle {
     EbHandle *dlf_thread_handle_array;
     EbHandle *cdef_thread_handle_array;
     EbHandle *rest_thread_handle_array;
+    EbWorkerPool *worker_pool;
 
     EbHandle packetization_thread_handle;
 
@@ -88,6 +91,7 @@ struct _EbEncHandle {
     EbThreadContext  *initial_rate_control_context_ptr;
     EbThreadContext **source_based_operations_context_ptr_array;
     EbThreadContext **tpl_disp_context_ptr_array;
+    EbThreadContext **gm_search_context_ptr_array;
     EbThreadContext  *picture_manager_context_ptr;
     EbThreadContext  *rate_control_context_ptr;
     EbThreadContext **mode_decision_configuration_context_ptr_array;
@@ -112,6 +116,7 @@ struct _EbEncHandle {
     EbSystemResource  *initial_rate_control_results_resource_ptr;
     EbSystemResource  *picture_demux_results_resource_ptr;
     EbSystemResource  *tpl_disp_res_srm;
+    EbSystemResource  *gm_search_task_resource_ptr;
     EbSystemResource  *rate_control_tasks_resource_ptr;
     EbSystemResource  *rate_control_results_resource_ptr;
     EbSystemResource  *enc_dec_tasks_resource_ptr;
@@ -129,6 +134,14 @@ struct _EbEncHandle {
     EbFifo *input_y8b_buffer_producer_fifo_ptr;
     EbFifo *output_stream_buffer_consumer_fifo_ptr;
     EbFifo *output_recon_buffer_consumer_fifo_ptr;
+
+    // start_time - end of svt_av1_enc_init, origin of the pipeline stats (in us)
+    uint64_t start_time;
+
+    // reconfig - svt_av1_enc_reconfigure() changes waiting for the next picture,
+    //   protected by the config_mutex of the instance
+    SvtAv1EncReconfig reconfig;
+    Bool              reconfig_pending;
 };
 
 #endif // EbEncHandle_h
@@ -526,6 +526,27 @@ EbErrorType svt_av1_verify_settings(SequenceControlSet *scs_ptr) {
         return_error = EB_ErrorBadParameter;
     }
 
+    if (config->enable_roi_map &&
+        (config->enable_adaptive_quantization == 1 || config->tile_columns > 0 ||
+         config->tile_rows > 0 || config->superres_mode != SUPERRES_NONE)) {
+        SVT_ERROR(
+            "Instance %u: The ROI map is not supported in combination with aq-mode 1, tiles or "
+            "super-resolution.\n",
+            channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->lookahead_only &&
+        (config->rate_control_mode != 0 || config->pass != ENC_SINGLE_PASS ||
+         config->superres_mode != SUPERRES_NONE || config->recon_enabled ||
+         config->stat_report)) {
+        SVT_ERROR(
+            "Instance %u: The lookahead only mode requires the CRF / CQP rate control and a "
+            "single pass, it does not support super-resolution, recon output or stat report.\n",
+            channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
     if (config->pass > 0 && scs_ptr->static_config.enable_overlays) {
         SVT_ERROR(
             "Instance %u: The overlay frames feature is currently not supported with multi-pass "
@@ -553,6 +574,27 @@ EbErrorType svt_av1_verify_settings(SequenceControlSet *scs_ptr) {
         return_error = EB_ErrorBadParameter;
     }
 
+    if (config->chunk_start_frame >= 0) {
+        if (pass == 1 || (pass == 2 && config->rate_control_mode)) {
+            SVT_ERROR(
+                "Instance %u: Chunked encoding is only supported in single pass and final pass\n",
+                channel_number + 1);
+            return_error = EB_ErrorBadParameter;
+        }
+        if (config->intra_refresh_type != SVT_AV1_KF_REFRESH || config->intra_period_length < 0 ||
+            config->scene_change_detection) {
+            SVT_ERROR(
+                "Instance %u: Chunked encoding needs a closed GOP with a fixed intra period\n",
+                channel_number + 1);
+            return_error = EB_ErrorBadParameter;
+        } else if (config->chunk_start_frame % (config->intra_period_length + 1)) {
+            SVT_ERROR("Instance %u: The chunk must start on a key frame, every %d frames\n",
+                      channel_number + 1,
+                      config->intra_period_length + 1);
+            return_error = EB_ErrorBadParameter;
+        }
+    }
+
 #if FIX_AQ_MODE
     if (config->enable_adaptive_quantization == 0 && config->rate_control_mode) {
         SVT_ERROR("Instance %u: Adaptive quantization can not be turned OFF when RC ON\n", channel_number + 1);
@@ -696,6 +738,9 @@ EbErrorType svt_av1_set_default_params(EbSvtAv1EncConfiguration *config_ptr) {
     config_ptr->min_qp_allowed         = 1;
 
     config_ptr->enable_adaptive_quantization = 2;
+    config_ptr->enable_roi_map               = FALSE;
+    config_ptr->enable_frame_stats           = FALSE;
+    config_ptr->lookahead_only               = FALSE;
     config_ptr->enc_mode                     = 12;
     config_ptr->intra_period_length          = -2;
     config_ptr->intra_refresh_type           = 2;
@@ -721,6 +766,9 @@ EbErrorType svt_av1_set_default_params(EbSvtAv1EncConfiguration *config_ptr) {
     config_ptr->starting_buffer_level_ms = 4000;
     config_ptr->optimal_buffer_level_ms  = 5000;
     config_ptr->recode_loop              = ALLOW_RECODE_DEFAULT;
+    config_ptr->sb_row_recode            = FALSE;
+    config_ptr->chunk_start_frame        = -1;
+    config_ptr->chunk_frame_count        = 0;
     // Bitstream options
     //config_ptr->codeVpsSpsPps = 0;
     //config_ptr->codeEosNal = 0;
@@ -744,6 +792,7 @@ EbErrorType svt_av1_set_default_params(EbSvtAv1EncConfiguration *config_ptr) {
     config_ptr->logical_processors   = 0;
     config_ptr->pin_threads          = 0;
     config_ptr->target_socket        = -1;
+    config_ptr->enable_worker_pool   = FALSE;
     config_ptr->channel_id           = 0;
     config_ptr->active_channel_count = 1;
 
@@ -760,6 +809,7 @@ EbErrorType svt_av1_set_default_params(EbSvtAv1EncConfiguration *config_ptr) {
     config_ptr->superres_kf_denom  = 8;
     config_ptr->superres_qthres    = 43; // random threshold, change
     config_ptr->superres_kf_qthres = 43; // random threshold, change
+    config_ptr->superres_reconfig  = FALSE;
 
     // Color description default values
     config_ptr->color_description_present_flag = FALSE;
@@ -770,6 +820,10 @@ EbErrorType svt_av1_set_default_params(EbSvtAv1EncConfiguration *config_ptr) {
     config_ptr->pass                           = 0;
     memset(&config_ptr->mastering_display, 0, sizeof(config_ptr->mastering_display));
     memset(&config_ptr->content_light_level, 0, sizeof(config_ptr->content_light_level));
+
+    // Zero-copy input default values
+    config_ptr->release_input_picture      = NULL;
+    config_ptr->release_input_private_data = NULL;
     return return_error;
 }
 
@@ -1321,6 +1375,7 @@ EB_API EbErrorType svt_av1_enc_parse_parameter(EbSvtAv1EncConfiguration *config_
         {"lookahead", &config_struct->look_ahead_distance},
         {"tbr", &config_struct->target_bit_rate},
         {"mbr", &config_struct->max_bit_rate},
+        {"chunk-frames", &config_struct->chunk_frame_count},
 #if !FTR_CBR
         {"vbv-bufsize", &config_struct->vbv_bufsize},
 #endif
@@ -1382,6 +1437,7 @@ EB_API EbErrorType svt_av1_enc_parse_parameter(EbSvtAv1EncConfiguration *config_
         {"buf-initial-sz", &config_struct->starting_buffer_level_ms},
         {"buf-optimal-sz", &config_struct->optimal_buffer_level_ms},
         {"buf-sz", &config_struct->maximum_buffer_size_ms},
+        {"chunk-start", &config_struct->chunk_start_frame},
     };
     const size_t int64_opts_size = sizeof(int64_opts) / sizeof(int64_opts[0]);
 
@@ -1451,6 +1507,9 @@ EB_API EbErrorType svt_av1_enc_parse_parameter(EbSvtAv1EncConfiguration *config_
         {"enable-tf", &config_struct->enable_tf},
         {"enable-overlays", &config_struct->enable_overlays},
         {"enable-hdr", &config_struct->high_dynamic_range_input},
+        {"worker-pool", &config_struct->enable_worker_pool},
+        {"sb-row-recode", &config_struct->sb_row_recode},
+        {"superres-reconfig", &config_struct->superres_reconfig},
     };
     const size_t bool_opts_size = sizeof(bool_opts) / sizeof(bool_opts[0]);
 
@@ -0,0 +1,380 @@
+/*
+ * Copyright(c) 2022 Intel Corporation
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * https://www.aomedia.org/license/patent-license.
+ */
+
+/******************************************************************************
+ * @file FilmGrainSynthesisTest.cc
+ *
+ * @brief Unit test of the film grain application kernels:
+ * - svt_av1_add_luma_grain_{avx2,avx512}
+ * - svt_av1_add_luma_grain_hbd_{avx2,avx512}
+ * - svt_av1_add_chroma_grain_{avx2,avx512}
+ * - svt_av1_add_chroma_grain_hbd_{avx2,avx512}
+ *
+ ******************************************************************************/
+
+#include <string.h>
+#include "gtest/gtest.h"
+#include "common_dsp_rtcd.h"
+#include "EbDefinitions.h"
+#include "random.h"
+#include "util.h"
+
+namespace {
+using svt_av1_test_tool::SVTRandom;
+
+typedef void (*AddLumaGrainFunc)(uint8_t *luma, int32_t luma_stride,
+                                 const int32_t *grain, int32_t grain_stride,
+                                 int32_t width, int32_t height,
+                                 const int32_t *scaling_lut,
+                                 int32_t scaling_shift, int32_t min_luma,
+                                 int32_t max_luma);
+typedef void (*AddLumaGrainHbdFunc)(uint16_t *luma, int32_t luma_stride,
+                                    const int32_t *grain, int32_t grain_stride,
+                                    int32_t width, int32_t height,
+                                    const int32_t *scaling_lut,
+                                    int32_t scaling_shift, int32_t min_luma,
+                                    int32_t max_luma, int32_t bit_depth);
+typedef void (*AddChromaGrainFunc)(
+    uint8_t *chroma, int32_t chroma_stride, const uint8_t *luma,
+    int32_t luma_stride, const int32_t *grain, int32_t grain_stride,
+    int32_t width, int32_t height, const int32_t *scaling_lut,
+    int32_t luma_mult, int32_t mult, int32_t offset, int32_t scaling_shift,
+    int32_t min_chroma, int32_t max_chroma, int32_t chroma_subsamp_y,
+    int32_t chroma_subsamp_x);
+typedef void (*AddChromaGrainHbdFunc)(
+    uint16_t *chroma, int32_t chroma_stride, const uint16_t *luma,
+    int32_t luma_stride, const int32_t *grain, int32_t grain_stride,
+    int32_t width, int32_t height, const int32_t *scaling_lut,
+    int32_t luma_mult, int32_t mult, int32_t offset, int32_t scaling_shift,
+    int32_t min_chroma, int32_t max_chroma, int32_t chroma_subsamp_y,
+    int32_t chroma_subsamp_x, int32_t bit_depth);
+
+// The grain is added by blocks of at most 32x32 luma samples, the tests also
+// cover wider blocks
+static const int kWidth = 96;
+static const int kHeight = 34;
+static const int kStride = 2 * kWidth + 8;
+static const int kTestNum = 1000;
+static const int kSubsampling[3][2] = {{1, 1}, {1, 0}, {0, 0}};
+
+template <typename Func>
+class GrainSynthesisTest : public ::testing::TestWithParam<Func> {
+  public:
+    GrainSynthesisTest() : rnd_(0, 65535) {
+    }
+
+  protected:
+    // Random parameters of a block with grain of bit_depth
+    void init_params(int bit_depth, bool extreme) {
+        const int max_val = (1 << bit_depth) - 1;
+        const int grain_center = 128 << (bit_depth - 8);
+        for (int i = 0; i < 256; ++i)
+            scaling_lut_[i] = extreme ? 255 : rnd_.random() & 255;
+        // the SIMD kernels interpolate with the entry after the last one
+        scaling_lut_[256] = scaling_lut_[255];
+        for (int i = 0; i < kHeight * kStride; ++i) {
+            grain_[i] = extreme ? (i & 1 ? grain_center - 1 : -grain_center)
+                                : rnd_.random() % (2 * grain_center) -
+                    grain_center;
+            const int l = extreme ? (i & 2 ? max_val : 0)
+                                  : rnd_.random() & max_val;
+            const int c = extreme ? (i & 4 ? max_val : 0)
+                                  : rnd_.random() & max_val;
+            luma8_[i] = l;
+            luma16_[i] = l;
+            chroma8_ref_[i] = chroma8_tst_[i] = c;
+            chroma16_ref_[i] = chroma16_tst_[i] = c;
+        }
+        memcpy(luma8_ref_, luma8_, sizeof(luma8_));
+        memcpy(luma8_tst_, luma8_, sizeof(luma8_));
+        memcpy(luma16_ref_, luma16_, sizeof(luma16_));
+        memcpy(luma16_tst_, luma16_, sizeof(luma16_));
+
+        scaling_shift_ = 8 + rnd_.random() % 4;
+        if (rnd_.random() & 1) {
+            min_ = 16 << (bit_depth - 8);
+            max_ = 235 << (bit_depth - 8);
+        } else {
+            min_ = 0;
+            max_ = max_val;
+        }
+        luma_mult_ = rnd_.random() % 256 - 128;
+        mult_ = rnd_.random() % 256 - 128;
+        offset_ = ((rnd_.random() % 512) << (bit_depth - 8)) - (1 << bit_depth);
+        if (extreme) {
+            luma_mult_ = rnd_.random() & 1 ? 127 : -128;
+            mult_ = rnd_.random() & 1 ? 127 : -128;
+        }
+        width_ = 1 + rnd_.random() % kWidth;
+        height_ = 1 + rnd_.random() % (kHeight / 2);
+    }
+
+    SVTRandom rnd_;
+    int32_t scaling_lut_[257];
+    int32_t grain_[kHeight * kStride];
+    uint8_t luma8_[kHeight * kStride];
+    uint8_t luma8_ref_[kHeight * kStride];
+    uint8_t luma8_tst_[kHeight * kStride];
+    uint16_t luma16_[kHeight * kStride];
+    uint16_t luma16_ref_[kHeight * kStride];
+    uint16_t luma16_tst_[kHeight * kStride];
+    uint8_t chroma8_ref_[kHeight * kStride];
+    uint8_t chroma8_tst_[kHeight * kStride];
+    uint16_t chroma16_ref_[kHeight * kStride];
+    uint16_t chroma16_tst_[kHeight * kStride];
+    int32_t scaling_shift_;
+    int32_t min_, max_;
+    int32_t luma_mult_, mult_, offset_;
+    int32_t width_, height_;
+};
+
+class AddLumaGrainTest : public GrainSynthesisTest<AddLumaGrainFunc> {
+  protected:
+    void run_test(bool extreme) {
+        for (int k = 0; k < kTestNum; ++k) {
+            init_params(8, extreme);
+            svt_av1_add_luma_grain_c(luma8_ref_,
+                                     kStride,
+                                     grain_,
+                                     kStride,
+                                     width_,
+                                     height_,
+                                     scaling_lut_,
+                                     scaling_shift_,
+                                     min_,
+                                     max_);
+            GetParam()(luma8_tst_,
+                       kStride,
+                       grain_,
+                       kStride,
+                       width_,
+                       height_,
+                       scaling_lut_,
+                       scaling_shift_,
+                       min_,
+                       max_);
+            ASSERT_EQ(memcmp(luma8_ref_, luma8_tst_, sizeof(luma8_ref_)), 0)
+                << width_ << "x" << height_ << " at test " << k;
+        }
+    }
+};
+
+TEST_P(AddLumaGrainTest, MatchTest) {
+    run_test(false);
+}
+
+TEST_P(AddLumaGrainTest, ExtremeTest) {
+    run_test(true);
+}
+
+INSTANTIATE_TEST_CASE_P(AVX2, AddLumaGrainTest,
+                        ::testing::Values(svt_av1_add_luma_grain_avx2));
+#if EN_AVX512_SUPPORT
+INSTANTIATE_TEST_CASE_P(AVX512, AddLumaGrainTest,
+                        ::testing::Values(svt_av1_add_luma_grain_avx512));
+#endif
+
+class AddLumaGrainHbdTest : public GrainSynthesisTest<AddLumaGrainHbdFunc> {
+  protected:
+    void run_test(bool extreme) {
+        for (int bit_depth = 8; bit_depth <= 12; bit_depth += 2) {
+            for (int k = 0; k < kTestNum; ++k) {
+                init_params(bit_depth, extreme);
+                svt_av1_add_luma_grain_hbd_c(luma16_ref_,
+                                             kStride,
+                                             grain_,
+                                             kStride,
+                                             width_,
+                                             height_,
+                                             scaling_lut_,
+                                             scaling_shift_,
+                                             min_,
+                                             max_,
+                                             bit_depth);
+                GetParam()(luma16_tst_,
+                           kStride,
+                           grain_,
+                           kStride,
+                           width_,
+                           height_,
+                           scaling_lut_,
+                           scaling_shift_,
+                           min_,
+                           max_,
+                           bit_depth);
+                ASSERT_EQ(
+                    memcmp(luma16_ref_, luma16_tst_, sizeof(luma16_ref_)), 0)
+                    << "bit depth " << bit_depth << " " << width_ << "x"
+                    << height_ << " at test " << k;
+            }
+        }
+    }
+};
+
+TEST_P(AddLumaGrainHbdTest, MatchTest) {
+    run_test(false);
+}
+
+TEST_P(AddLumaGrainHbdTest, ExtremeTest) {
+    run_test(true);
+}
+
+INSTANTIATE_TEST_CASE_P(AVX2, AddLumaGrainHbdTest,
+                        ::testing::Values(svt_av1_add_luma_grain_hbd_avx2));
+#if EN_AVX512_SUPPORT
+INSTANTIATE_TEST_CASE_P(AVX512, AddLumaGrainHbdTest,
+                        ::testing::Values(svt_av1_add_luma_grain_hbd_avx512));
+#endif
+
+class AddChromaGrainTest : public GrainSynthesisTest<AddChromaGrainFunc> {
+  protected:
+    void run_test(bool extreme) {
+        for (int s = 0; s < 3; ++s) {
+            const int sy = kSubsampling[s][0];
+            const int sx = kSubsampling[s][1];
+            for (int k = 0; k < kTestNum; ++k) {
+                init_params(8, extreme);
+                svt_av1_add_chroma_grain_c(chroma8_ref_,
+                                           kStride,
+                                           luma8_,
+                                           kStride,
+                                           grain_,
+                                           kStride,
+                                           width_,
+                                           height_,
+                                           scaling_lut_,
+                                           luma_mult_,
+                                           mult_,
+                                           offset_,
+                                           scaling_shift_,
+                                           min_,
+                                           max_,
+                                           sy,
+                                           sx);
+                GetParam()(chroma8_tst_,
+                           kStride,
+                           luma8_,
+                           kStride,
+                           grain_,
+                           kStride,
+                           width_,
+                           height_,
+                           scaling_lut_,
+                           luma_mult_,
+                           mult_,
+                           offset_,
+                           scaling_shift_,
+                           min_,
+                           max_,
+                           sy,
+                           sx);
+                ASSERT_EQ(
+                    memcmp(chroma8_ref_, chroma8_tst_, sizeof(chroma8_ref_)),
+                    0)
+                    << "subsampling " << sx << sy << " " << width_ << "x"
+                    << height_ << " at test " << k;
+            }
+        }
+    }
+};
+
+TEST_P(AddChromaGrainTest, MatchTest) {
+    run_test(false);
+}
+
+TEST_P(AddChromaGrainTest, ExtremeTest) {
+    run_test(true);
+}
+
+INSTANTIATE_TEST_CASE_P(AVX2, AddChromaGrainTest,
+                        ::testing::Values(svt_av1_add_chroma_grain_avx2));
+#if EN_AVX512_SUPPORT
+INSTANTIATE_TEST_CASE_P(AVX512, AddChromaGrainTest,
+                        ::testing::Values(svt_av1_add_chroma_grain_avx512));
+#endif
+
+class AddChromaGrainHbdTest
+    : public GrainSynthesisTest<AddChromaGrainHbdFunc> {
+  protected:
+    void run_test(bool extreme) {
+        for (int bit_depth = 8; bit_depth <= 12; bit_depth += 2) {
+            for (int s = 0; s < 3; ++s) {
+                const int sy = kSubsampling[s][0];
+                const int sx = kSubsampling[s][1];
+                for (int k = 0; k < kTestNum; ++k) {
+                    init_params(bit_depth, extreme);
+                    svt_av1_add_chroma_grain_hbd_c(chroma16_ref_,
+                                                   kStride,
+                                                   luma16_,
+                                                   kStride,
+                                                   grain_,
+                                                   kStride,
+                                                   width_,
+                                                   height_,
+                                                   scaling_lut_,
+                                                   luma_mult_,
+                                                   mult_,
+                                                   offset_,
+                                                   scaling_shift_,
+                                                   min_,
+                                                   max_,
+                                                   sy,
+                                                   sx,
+                                                   bit_depth);
+                    GetParam()(chroma16_tst_,
+                               kStride,
+                               luma16_,
+                               kStride,
+                               grain_,
+                               kStride,
+                               width_,
+                               height_,
+                               scaling_lut_,
+                               luma_mult_,
+                               mult_,
+                               offset_,
+                               scaling_shift_,
+                               min_,
+                               max_,
+                               sy,
+                               sx,
+                               bit_depth);
+                    ASSERT_EQ(memcmp(chroma16_ref_,
+                                     chroma16_tst_,
+                                     sizeof(chroma16_ref_)),
+                              0)
+                        << "bit depth " << bit_depth << " subsampling " << sx
+                        << sy << " " << width_ << "x" << height_
+                        << " at test " << k;
+                }
+            }
+        }
+    }
+};
+
+TEST_P(AddChromaGrainHbdTest, MatchTest) {
+    run_test(false);
+}
+
+TEST_P(AddChromaGrainHbdTest, ExtremeTest) {
+    run_test(true);
+}
+
+INSTANTIATE_TEST_CASE_P(AVX2, AddChromaGrainHbdTest,
+                        ::testing::Values(svt_av1_add_chroma_grain_hbd_avx2));
+#if EN_AVX512_SUPPORT
+INSTANTIATE_TEST_CASE_P(
+    AVX512, AddChromaGrainHbdTest,
+    ::testing::Values(svt_av1_add_chroma_grain_hbd_avx512));
+#endif
+
+}  // namespace
@@ -268,6 +268,56 @@ TEST_F(AddFilmGrainTest, MatchTest) {
     }
 }
 
+// The stripes added by separate calls, in any order, give the same picture
+// as the whole picture at once
+TEST_F(AddFilmGrainTest, StripesMatchTest) {
+    libaom_test::ACMRandom rnd(libaom_test::ACMRandom::DeterministicSeed());
+    uint8_t *ref = (uint8_t *)svt_aom_malloc(luma_size + 2 * chroma_size);
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < luma_size + 2 * chroma_size; ++j)
+            ref[j] = rnd.Rand8();
+        memcpy(luma_, ref, luma_size);
+        memcpy(cb_, ref + luma_size, chroma_size);
+        memcpy(cr_, ref + luma_size + chroma_size, chroma_size);
+        svt_av1_add_film_grain_run(film_grain_test_vectors + i,
+                                   ref,
+                                   ref + luma_size,
+                                   ref + luma_size + chroma_size,
+                                   kHeight,
+                                   kWidth,
+                                   kWidth,
+                                   kWidth / 2,
+                                   0,
+                                   1,
+                                   1);
+
+        FilmGrainFrame fg;
+        svt_av1_film_grain_init(&fg,
+                                film_grain_test_vectors + i,
+                                luma_,
+                                cb_,
+                                cr_,
+                                kHeight,
+                                kWidth,
+                                kWidth,
+                                kWidth / 2,
+                                0,
+                                1,
+                                1);
+        const int num_stripes = svt_av1_film_grain_num_stripes(&fg);
+        for (int s = num_stripes - 1; s >= 0; --s)
+            svt_av1_film_grain_add_stripes(&fg, s, s + 1);
+        svt_av1_film_grain_free(&fg);
+
+        EXPECT_EQ(memcmp(luma_, ref, luma_size), 0) << "luma vector " << i;
+        EXPECT_EQ(memcmp(cb_, ref + luma_size, chroma_size), 0)
+            << "cb vector " << i;
+        EXPECT_EQ(memcmp(cr_, ref + luma_size + chroma_size, chroma_size), 0)
+            << "cr vector " << i;
+    }
+    svt_aom_free(ref);
+}
+
 extern "C" {
 #include "EbPictureControlSet.h"
 #include "EbPictureBufferDesc.h"
@@ -307,18 +357,6 @@ double randn(libaom_test::ACMRandom *random, double sigma) {
     return 0;
 }
 
-static void denoise_and_model_dctor(EbPtr p) {
-    AomDenoiseAndModel *obj = (AomDenoiseAndModel *)p;
-
-    free(obj->flat_blocks);
-    for (int32_t i = 0; i < 3; ++i) {
-        EB_FREE_ARRAY(obj->denoised[i]);
-        EB_FREE_ARRAY(obj->packed[i]);
-    }
-    svt_aom_noise_model_free(&obj->noise_model);
-    svt_aom_flat_block_finder_free(&obj->flat_block_finder);
-}
-
 /* clang-format off */
 static AomFilmGrain expected_film_grain = {
     1 /* apply_grain */,
@@ -399,7 +437,7 @@ class DenoiseModelRunTest : public ::testing::Test {
 
     ~DenoiseModelRunTest() {
         svt_picture_buffer_desc_dctor(&in_pic_);
-        denoise_and_model_dctor(&noise_model);
+        noise_model.dctor(&noise_model);
     }
 
     void SetUp() override {
@@ -462,3 +500,15 @@ TEST_F(DenoiseModelRunTest, OutputFilmGrainCheck) {
     check_filmgrain();
     EXPECT_FALSE(HasFailure());
 }
+
+// The encoder keeps one denoise context per thread, a second picture must
+// get the same film grain as with a fresh context
+TEST_F(DenoiseModelRunTest, ReuseContextCheck) {
+    run_test();
+    check_filmgrain();
+    random_.Reset(100171);
+    memset(&output_film_grain, 0, sizeof(output_film_grain));
+    run_test();
+    check_filmgrain();
+    EXPECT_FALSE(HasFailure());
+}
@@ -362,3 +362,204 @@ TEST(MotionEstimation_avx512, DISABLED_sadMxNx4d_speed) {
 }
 
 #endif  // EN_AVX512_SUPPORT
+
+typedef void (*FullpelSearchRowFunc)(
+    uint8_t *src, uint32_t src_stride, uint8_t *ref, uint32_t ref_stride,
+    uint32_t mv, uint32_t search_area_width, uint8_t out_8x8, Bool sub_sad,
+    uint32_t *p_best_sad_8x8, uint32_t *p_best_sad_16x16,
+    uint32_t *p_best_sad_32x32, uint32_t *p_best_sad_64x64,
+    uint32_t *p_best_mv8x8, uint32_t *p_best_mv16x16, uint32_t *p_best_mv32x32,
+    uint32_t *p_best_mv64x64);
+
+// best sad / mv of the 64x64, 4 32x32, 16 16x16 and 64 8x8 blocks
+struct FullpelSearchResults {
+    uint32_t sad[85];
+    uint32_t mv[85];
+
+    void run(FullpelSearchRowFunc func, uint8_t *src, uint32_t src_stride,
+             uint8_t *ref, uint32_t ref_stride, uint32_t mv_row,
+             uint32_t width, uint8_t out_8x8, Bool sub_sad) {
+        func(src,
+             src_stride,
+             ref,
+             ref_stride,
+             mv_row,
+             width,
+             out_8x8,
+             sub_sad,
+             sad + 21,
+             sad + 5,
+             sad + 1,
+             sad,
+             mv + 21,
+             mv + 5,
+             mv + 1,
+             mv);
+    }
+};
+
+class FullpelSearchRowTest
+    : public ::testing::TestWithParam<FullpelSearchRowFunc> {
+  protected:
+    static const uint32_t kMaxWidth = 64;
+
+    void SetUp() override {
+        src_stride_ = svt_create_random_aligned_stride(64, 64);
+        ref_stride_ = svt_create_random_aligned_stride(64 + kMaxWidth + 8, 64);
+        src_ = (uint8_t *)malloc(64 * src_stride_);
+        ref_ = (uint8_t *)malloc(64 * ref_stride_);
+    }
+
+    void TearDown() override {
+        free(src_);
+        free(ref_);
+    }
+
+    // mode 0: random samples, 1: flat samples (all the positions tie), 2:
+    // small differences (many ties)
+    void prepare_data(int mode) {
+        if (mode == 1) {
+            memset(src_, 128, 64 * src_stride_);
+            memset(ref_, 128, 64 * ref_stride_);
+        } else {
+            svt_buf_random_u8(src_, 64 * src_stride_);
+            svt_buf_random_u8(ref_, 64 * ref_stride_);
+            if (mode == 2) {
+                for (uint32_t i = 0; i < 64 * src_stride_; i++)
+                    src_[i] &= 3;
+                for (uint32_t i = 0; i < 64 * ref_stride_; i++)
+                    ref_[i] &= 3;
+            }
+        }
+        // start from previous results of the block
+        svt_buf_random_u32_with_max(ref_res_.sad, 85, MAX_SAD_VALUE);
+        svt_buf_random_u32(ref_res_.mv, 85);
+        tst_res_ = ref_res_;
+    }
+
+    void run_match_test(int mode) {
+        const FullpelSearchRowFunc test_func = GetParam();
+        for (uint32_t width = 8; width <= kMaxWidth; width += 8) {
+            for (int sub_sad = 0; sub_sad < 2; sub_sad++) {
+                for (uint8_t out_8x8 = 0; out_8x8 < 2; out_8x8++) {
+                    prepare_data(mode);
+                    // x in [-512, 511], y in [-256, 255]
+                    const int16_t x = (int16_t)(rand() % 1024 - 512);
+                    const int16_t y = (int16_t)(rand() % 512 - 256);
+                    const uint32_t mv = ((uint32_t)(uint16_t)y << 18) |
+                                        (uint16_t)((uint16_t)x << 2);
+                    ref_res_.run(svt_ext_fullpel_search_row_c,
+                                 src_,
+                                 src_stride_,
+                                 ref_,
+                                 ref_stride_,
+                                 mv,
+                                 width,
+                                 out_8x8,
+                                 (Bool)sub_sad);
+                    tst_res_.run(test_func,
+                                 src_,
+                                 src_stride_,
+                                 ref_,
+                                 ref_stride_,
+                                 mv,
+                                 width,
+                                 out_8x8,
+                                 (Bool)sub_sad);
+                    for (int i = 0; i < 85; i++) {
+                        ASSERT_EQ(ref_res_.sad[i], tst_res_.sad[i])
+                            << "sad " << i << " width " << width
+                            << " sub_sad " << sub_sad;
+                        // the C version always outputs the 8x8 mvs
+                        if (out_8x8 || i < 21) {
+                            ASSERT_EQ(ref_res_.mv[i], tst_res_.mv[i])
+                                << "mv " << i << " width " << width
+                                << " sub_sad " << sub_sad;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void run_speed_test() {
+        const FullpelSearchRowFunc test_func = GetParam();
+        const uint32_t width = kMaxWidth;
+        const uint32_t num_loop = 20000;
+        double time_c, time_o;
+        uint64_t start_time_seconds, start_time_useconds;
+        uint64_t middle_time_seconds, middle_time_useconds;
+        uint64_t finish_time_seconds, finish_time_useconds;
+
+        prepare_data(0);
+        svt_av1_get_time(&start_time_seconds, &start_time_useconds);
+        for (uint32_t i = 0; i < num_loop; i++)
+            ref_res_.run(svt_ext_fullpel_search_row_c,
+                         src_,
+                         src_stride_,
+                         ref_,
+                         ref_stride_,
+                         0,
+                         width,
+                         1,
+                         FALSE);
+        svt_av1_get_time(&middle_time_seconds, &middle_time_useconds);
+        for (uint32_t i = 0; i < num_loop; i++)
+            tst_res_.run(test_func,
+                         src_,
+                         src_stride_,
+                         ref_,
+                         ref_stride_,
+                         0,
+                         width,
+                         1,
+                         FALSE);
+        svt_av1_get_time(&finish_time_seconds, &finish_time_useconds);
+        time_c = svt_av1_compute_overall_elapsed_time_ms(start_time_seconds,
+                                                         start_time_useconds,
+                                                         middle_time_seconds,
+                                                         middle_time_useconds);
+        time_o = svt_av1_compute_overall_elapsed_time_ms(middle_time_seconds,
+                                                         middle_time_useconds,
+                                                         finish_time_seconds,
+                                                         finish_time_useconds);
+        for (int i = 0; i < 85; i++)
+            EXPECT_EQ(ref_res_.sad[i], tst_res_.sad[i]);
+
+        printf("Average Nanoseconds per Row of %u Positions\n", width);
+        printf("    fullpel_search_row_c()   : %8.2f\n",
+               1000000 * time_c / num_loop);
+        printf("    fullpel_search_row_opt() : %8.2f   (Comparison: %5.2fx)\n",
+               1000000 * time_o / num_loop,
+               time_c / time_o);
+    }
+
+    uint8_t *src_, *ref_;
+    uint32_t src_stride_, ref_stride_;
+    FullpelSearchResults ref_res_, tst_res_;
+};
+
+TEST_P(FullpelSearchRowTest, MatchTest) {
+    run_match_test(0);
+}
+
+TEST_P(FullpelSearchRowTest, FlatTest) {
+    run_match_test(1);
+}
+
+TEST_P(FullpelSearchRowTest, TieTest) {
+    run_match_test(2);
+}
+
+TEST_P(FullpelSearchRowTest, DISABLED_SpeedTest) {
+    run_speed_test();
+}
+
+INSTANTIATE_TEST_CASE_P(AVX2, FullpelSearchRowTest,
+                        ::testing::Values(svt_ext_fullpel_search_row_avx2));
+
+#if EN_AVX512_SUPPORT
+INSTANTIATE_TEST_CASE_P(
+    AVX512, FullpelSearchRowTest,
+    ::testing::Values(svt_ext_fullpel_search_row_avx512));
+#endif  // EN_AVX512_SUPPORT
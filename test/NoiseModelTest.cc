@@ -0,0 +1,241 @@
+/*
+ * Copyright(c) 2022 Intel Corporation
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * https://www.aomedia.org/license/patent-license.
+ */
+
+/******************************************************************************
+ * @file NoiseModelTest.cc
+ *
+ * @brief Unit test of the film grain noise model kernels:
+ * - svt_av1_get_block_mean_avx2
+ * - svt_av1_get_noise_var_avx2
+ * - svt_av1_add_block_observations_internal_avx2
+ *
+ ******************************************************************************/
+
+#include <string.h>
+#include "gtest/gtest.h"
+#include "aom_dsp_rtcd.h"
+#include "EbDefinitions.h"
+#include "random.h"
+#include "util.h"
+
+namespace {
+using svt_av1_test_tool::SVTRandom;
+
+typedef double (*GetBlockMeanFunc)(const uint8_t *data, int32_t w, int32_t h,
+                                   int32_t stride, int32_t x_o, int32_t y_o,
+                                   int32_t block_size, int32_t use_highbd);
+typedef double (*GetNoiseVarFunc)(const uint8_t *data, const uint8_t *denoised,
+                                  int32_t stride, int32_t w, int32_t h,
+                                  int32_t x_o, int32_t y_o,
+                                  int32_t block_size_x, int32_t block_size_y,
+                                  int32_t use_highbd);
+typedef void (*AddBlockObservationsFunc)(uint32_t n, const double val,
+                                         const double recp_sqr_norm,
+                                         double *buffer, double *buffer_norm,
+                                         double *b, double *A);
+
+static const int kWidth = 160;
+static const int kHeight = 96;
+static const int kTestNum = 1000;
+static const int kBlockSizes[] = {8, 16, 32, 64};
+
+template <typename Func>
+class NoiseModelPlaneTest : public ::testing::TestWithParam<Func> {
+  public:
+    NoiseModelPlaneTest() : rnd_(0, 1023) {
+    }
+
+  protected:
+    void init_data(bool use_highbd, bool extreme) {
+        const int mask = use_highbd ? 1023 : 255;
+        for (int i = 0; i < kWidth * kHeight; ++i) {
+            const int v = extreme ? mask : rnd_.random() & mask;
+            const int d = extreme ? (i & 1 ? 0 : mask) : rnd_.random() & mask;
+            if (use_highbd) {
+                data16_[i] = v;
+                denoised16_[i] = d;
+            } else {
+                data8_[i] = v;
+                denoised8_[i] = d;
+            }
+        }
+    }
+
+    void run_block_mean_test(GetBlockMeanFunc test_func, bool extreme) {
+        for (int use_highbd = 0; use_highbd < 2; ++use_highbd) {
+            const uint8_t *data =
+                use_highbd ? (const uint8_t *)data16_ : data8_;
+            for (int k = 0; k < kTestNum; ++k) {
+                init_data(use_highbd, extreme);
+                const int block_size = kBlockSizes[k % 4];
+                // partial blocks on the right and bottom borders
+                const int w = block_size + rnd_.random() % (kWidth - 64);
+                const int h = block_size + rnd_.random() % (kHeight - 64);
+                const int x_o = rnd_.random() % w;
+                const int y_o = rnd_.random() % h;
+                const double ref = svt_av1_get_block_mean_c(
+                    data, w, h, kWidth, x_o, y_o, block_size, use_highbd);
+                const double tst = test_func(
+                    data, w, h, kWidth, x_o, y_o, block_size, use_highbd);
+                ASSERT_EQ(ref, tst) << "highbd " << use_highbd << " block "
+                                    << block_size << " at test " << k;
+            }
+        }
+    }
+
+    void run_noise_var_test(GetNoiseVarFunc test_func, bool extreme) {
+        for (int use_highbd = 0; use_highbd < 2; ++use_highbd) {
+            const uint8_t *data =
+                use_highbd ? (const uint8_t *)data16_ : data8_;
+            const uint8_t *denoised =
+                use_highbd ? (const uint8_t *)denoised16_ : denoised8_;
+            for (int k = 0; k < kTestNum; ++k) {
+                init_data(use_highbd, extreme);
+                const int block_size_x = kBlockSizes[k % 4];
+                const int block_size_y = kBlockSizes[(k / 4) % 4];
+                const int w = block_size_x + rnd_.random() % (kWidth - 64);
+                const int h = block_size_y + rnd_.random() % (kHeight - 64);
+                const int x_o = rnd_.random() % w;
+                const int y_o = rnd_.random() % h;
+                const double ref = svt_av1_get_noise_var_c(data,
+                                                           denoised,
+                                                           kWidth,
+                                                           w,
+                                                           h,
+                                                           x_o,
+                                                           y_o,
+                                                           block_size_x,
+                                                           block_size_y,
+                                                           use_highbd);
+                const double tst = test_func(data,
+                                             denoised,
+                                             kWidth,
+                                             w,
+                                             h,
+                                             x_o,
+                                             y_o,
+                                             block_size_x,
+                                             block_size_y,
+                                             use_highbd);
+                ASSERT_EQ(ref, tst) << "highbd " << use_highbd << " block "
+                                    << block_size_x << "x" << block_size_y
+                                    << " at test " << k;
+            }
+        }
+    }
+
+    SVTRandom rnd_;
+    uint8_t data8_[kWidth * kHeight];
+    uint8_t denoised8_[kWidth * kHeight];
+    uint16_t data16_[kWidth * kHeight];
+    uint16_t denoised16_[kWidth * kHeight];
+};
+
+class GetBlockMeanTest : public NoiseModelPlaneTest<GetBlockMeanFunc> {};
+
+TEST_P(GetBlockMeanTest, MatchTest) {
+    run_block_mean_test(GetParam(), false);
+}
+
+TEST_P(GetBlockMeanTest, ExtremeTest) {
+    run_block_mean_test(GetParam(), true);
+}
+
+INSTANTIATE_TEST_CASE_P(AVX2, GetBlockMeanTest,
+                        ::testing::Values(svt_av1_get_block_mean_avx2));
+
+class GetNoiseVarTest : public NoiseModelPlaneTest<GetNoiseVarFunc> {};
+
+TEST_P(GetNoiseVarTest, MatchTest) {
+    run_noise_var_test(GetParam(), false);
+}
+
+TEST_P(GetNoiseVarTest, ExtremeTest) {
+    run_noise_var_test(GetParam(), true);
+}
+
+INSTANTIATE_TEST_CASE_P(AVX2, GetNoiseVarTest,
+                        ::testing::Values(svt_av1_get_noise_var_avx2));
+
+// The AR model of lag 3 has 2 * lag * (lag + 1) coefficients, plus the luma
+// coefficient for the chroma planes
+static const uint32_t kMaxEqns = 2 * 3 * 4 + 1;
+
+class AddBlockObservationsTest
+    : public ::testing::TestWithParam<AddBlockObservationsFunc> {
+  public:
+    AddBlockObservationsTest() : rnd_(0, 1 << 16) {
+    }
+
+  protected:
+    double random_value() {
+        return (rnd_.random() - (1 << 15)) / 256.0;
+    }
+
+    void run_test() {
+        AddBlockObservationsFunc test_func = GetParam();
+        for (uint32_t n = 1; n <= kMaxEqns; ++n) {
+            for (uint32_t i = 0; i < n; ++i) {
+                b_ref_[i] = b_tst_[i] = random_value();
+                for (uint32_t j = 0; j < n; ++j)
+                    A_ref_[i * n + j] = A_tst_[i * n + j] = random_value();
+            }
+            for (int k = 0; k < kTestNum; ++k) {
+                for (uint32_t i = 0; i < n; ++i)
+                    buffer_[i] = random_value();
+                const double val = random_value();
+                const double recp_sqr_norm = 1.0 / (1 + rnd_.random());
+                svt_av1_add_block_observations_internal_c(n,
+                                                          val,
+                                                          recp_sqr_norm,
+                                                          buffer_,
+                                                          buffer_norm_ref_,
+                                                          b_ref_,
+                                                          A_ref_);
+                test_func(n,
+                          val,
+                          recp_sqr_norm,
+                          buffer_,
+                          buffer_norm_tst_,
+                          b_tst_,
+                          A_tst_);
+            }
+            ASSERT_EQ(memcmp(buffer_norm_ref_, buffer_norm_tst_,
+                             n * sizeof(double)),
+                      0)
+                << "buffer_norm mismatch n " << n;
+            ASSERT_EQ(memcmp(b_ref_, b_tst_, n * sizeof(double)), 0)
+                << "b mismatch n " << n;
+            ASSERT_EQ(memcmp(A_ref_, A_tst_, n * n * sizeof(double)), 0)
+                << "A mismatch n " << n;
+        }
+    }
+
+    SVTRandom rnd_;
+    double buffer_[kMaxEqns];
+    double buffer_norm_ref_[kMaxEqns];
+    double buffer_norm_tst_[kMaxEqns];
+    double b_ref_[kMaxEqns];
+    double b_tst_[kMaxEqns];
+    double A_ref_[kMaxEqns * kMaxEqns];
+    double A_tst_[kMaxEqns * kMaxEqns];
+};
+
+TEST_P(AddBlockObservationsTest, MatchTest) {
+    run_test();
+}
+
+INSTANTIATE_TEST_CASE_P(
+    AVX2, AddBlockObservationsTest,
+    ::testing::Values(svt_av1_add_block_observations_internal_avx2));
+
+}  // namespace
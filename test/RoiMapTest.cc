@@ -0,0 +1,78 @@
+/*
+ * Copyright(c) 2022 Intel Corporation
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * https://www.aomedia.org/license/patent-license.
+ */
+
+/******************************************************************************
+ * @file RoiMapTest.cc
+ *
+ * @brief Unit test of the conversion of a ROI map to segments:
+ * - roi_map_to_segments
+ *
+ ******************************************************************************/
+
+#include <vector>
+#include "gtest/gtest.h"
+#include "EbDefinitions.h"
+extern "C" {
+#include "EbSegmentation.h"
+}
+
+namespace {
+
+TEST(RoiMapTest, Segments) {
+    std::vector<int16_t> qp_offset = {0, -40, 30, -40, 255, -255, 0, 30};
+    SvtAv1RoiMap roi_map = {(uint32_t)qp_offset.size(), qp_offset.data(), nullptr};
+    std::vector<uint8_t> seg_map(qp_offset.size());
+    int16_t seg_qp[MAX_SEGMENTS];
+    uint8_t seg_count;
+
+    ASSERT_EQ(roi_map_to_segments(&roi_map, seg_map.data(), seg_qp, &seg_count),
+              EB_ErrorNone);
+    ASSERT_EQ(seg_count, 5);
+    // segments are assigned in the order of the first use
+    const int16_t expected_qp[] = {0, -40, 30, 255, -255};
+    const uint8_t expected_map[] = {0, 1, 2, 1, 3, 4, 0, 2};
+    for (uint8_t i = 0; i < seg_count; i++) EXPECT_EQ(seg_qp[i], expected_qp[i]);
+    for (size_t i = 0; i < seg_map.size(); i++)
+        EXPECT_EQ(seg_map[i], expected_map[i]) << "block " << i;
+
+    // validation only
+    EXPECT_EQ(roi_map_to_segments(&roi_map, nullptr, seg_qp, &seg_count),
+              EB_ErrorNone);
+    EXPECT_EQ(seg_count, 5);
+}
+
+TEST(RoiMapTest, Invalid) {
+    int16_t seg_qp[MAX_SEGMENTS];
+    uint8_t seg_count;
+
+    std::vector<int16_t> out_of_range = {0, 256};
+    SvtAv1RoiMap roi_map = {
+        (uint32_t)out_of_range.size(), out_of_range.data(), nullptr};
+    EXPECT_EQ(roi_map_to_segments(&roi_map, nullptr, seg_qp, &seg_count),
+              EB_ErrorBadParameter);
+    out_of_range[1] = -256;
+    EXPECT_EQ(roi_map_to_segments(&roi_map, nullptr, seg_qp, &seg_count),
+              EB_ErrorBadParameter);
+
+    // one more distinct offset than the AV1 segments
+    std::vector<int16_t> qp_offset;
+    for (int i = 0; i <= MAX_SEGMENTS; i++) qp_offset.push_back(i * 10);
+    roi_map = {(uint32_t)qp_offset.size(), qp_offset.data(), nullptr};
+    EXPECT_EQ(roi_map_to_segments(&roi_map, nullptr, seg_qp, &seg_count),
+              EB_ErrorBadParameter);
+    qp_offset.back() = 0;
+    EXPECT_EQ(roi_map_to_segments(&roi_map, nullptr, seg_qp, &seg_count),
+              EB_ErrorNone);
+    EXPECT_EQ(seg_count, MAX_SEGMENTS);
+}
+
+}  // namespace
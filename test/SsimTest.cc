@@ -0,0 +1,151 @@
+/*
+ * Copyright(c) 2022 Intel Corporation
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * https://www.aomedia.org/license/patent-license.
+ */
+
+/******************************************************************************
+ * @file SsimTest.cc
+ *
+ * @brief Unit test of the SSIM 8x8 window statistics used by stat_report:
+ * - svt_aom_ssim_parms_8x8_{avx2,avx512}
+ * - svt_aom_highbd_ssim_parms_8x8_{avx2,avx512}
+ *
+ ******************************************************************************/
+
+#include "gtest/gtest.h"
+#include "aom_dsp_rtcd.h"
+#include "EbDefinitions.h"
+#include "random.h"
+#include "util.h"
+
+namespace {
+using svt_av1_test_tool::SVTRandom;
+
+typedef void (*SsimParmsFunc)(const uint8_t *s, int sp, const uint8_t *r,
+                              int rp, uint32_t *sum_s, uint32_t *sum_r,
+                              uint32_t *sum_sq_s, uint32_t *sum_sq_r,
+                              uint32_t *sum_sxr);
+typedef void (*HbdSsimParmsFunc)(const uint8_t *s, int sp, const uint8_t *sinc,
+                                 int spinc, const uint16_t *r, int rp,
+                                 uint32_t *sum_s, uint32_t *sum_r,
+                                 uint32_t *sum_sq_s, uint32_t *sum_sq_r,
+                                 uint32_t *sum_sxr);
+
+static const int kBufStride = 64;
+static const int kBufSize = kBufStride * 16;
+static const int kTestNum = 10000;
+
+class SsimParmsTest : public ::testing::TestWithParam<SsimParmsFunc> {
+  public:
+    SsimParmsTest() : rnd_(0, 255) {
+    }
+
+  protected:
+    void run_test(bool extreme) {
+        SsimParmsFunc test_func = GetParam();
+        for (int k = 0; k < kTestNum; ++k) {
+            for (int i = 0; i < kBufSize; ++i) {
+                src_[i] = extreme ? 255 : rnd_.random();
+                ref_[i] = extreme ? 255 : rnd_.random();
+            }
+            // random strides and misaligned origins
+            const int sp = 8 + rnd_.random() % (kBufStride - 16);
+            const int rp = 8 + rnd_.random() % (kBufStride - 16);
+            const int so = rnd_.random() % 8, ro = rnd_.random() % 8;
+            uint32_t sums_ref[5], sums_tst[5];
+            for (int i = 0; i < 5; ++i)
+                sums_ref[i] = sums_tst[i] = k;
+            svt_aom_ssim_parms_8x8_c(src_ + so, sp, ref_ + ro, rp,
+                                     &sums_ref[0], &sums_ref[1], &sums_ref[2],
+                                     &sums_ref[3], &sums_ref[4]);
+            test_func(src_ + so, sp, ref_ + ro, rp, &sums_tst[0],
+                      &sums_tst[1], &sums_tst[2], &sums_tst[3], &sums_tst[4]);
+            for (int i = 0; i < 5; ++i)
+                ASSERT_EQ(sums_ref[i], sums_tst[i])
+                    << "sum " << i << " mismatch at test " << k;
+        }
+    }
+
+    SVTRandom rnd_;
+    uint8_t src_[kBufSize];
+    uint8_t ref_[kBufSize];
+};
+
+TEST_P(SsimParmsTest, MatchTest) {
+    run_test(false);
+}
+
+TEST_P(SsimParmsTest, ExtremeTest) {
+    run_test(true);
+}
+
+INSTANTIATE_TEST_CASE_P(AVX2, SsimParmsTest,
+                        ::testing::Values(svt_aom_ssim_parms_8x8_avx2));
+#if EN_AVX512_SUPPORT
+INSTANTIATE_TEST_CASE_P(AVX512, SsimParmsTest,
+                        ::testing::Values(svt_aom_ssim_parms_8x8_avx512));
+#endif
+
+class HbdSsimParmsTest : public ::testing::TestWithParam<HbdSsimParmsFunc> {
+  public:
+    HbdSsimParmsTest() : rnd8_(0, 255), rnd10_(0, 1023) {
+    }
+
+  protected:
+    void run_test(bool extreme) {
+        HbdSsimParmsFunc test_func = GetParam();
+        for (int k = 0; k < kTestNum; ++k) {
+            for (int i = 0; i < kBufSize; ++i) {
+                src_[i] = extreme ? 255 : rnd8_.random();
+                src_inc_[i] = extreme ? 255 : rnd8_.random();
+                ref_[i] = extreme ? 1023 : rnd10_.random();
+            }
+            const int sp = 8 + rnd8_.random() % (kBufStride - 16);
+            const int spinc = 8 + rnd8_.random() % (kBufStride - 16);
+            const int rp = 8 + rnd8_.random() % (kBufStride - 16);
+            uint32_t sums_ref[5], sums_tst[5];
+            for (int i = 0; i < 5; ++i)
+                sums_ref[i] = sums_tst[i] = k;
+            svt_aom_highbd_ssim_parms_8x8_c(src_, sp, src_inc_, spinc, ref_, rp,
+                                            &sums_ref[0], &sums_ref[1],
+                                            &sums_ref[2], &sums_ref[3],
+                                            &sums_ref[4]);
+            test_func(src_, sp, src_inc_, spinc, ref_, rp, &sums_tst[0],
+                      &sums_tst[1], &sums_tst[2], &sums_tst[3], &sums_tst[4]);
+            for (int i = 0; i < 5; ++i)
+                ASSERT_EQ(sums_ref[i], sums_tst[i])
+                    << "sum " << i << " mismatch at test " << k;
+        }
+    }
+
+    SVTRandom rnd8_;
+    SVTRandom rnd10_;
+    uint8_t src_[kBufSize];
+    uint8_t src_inc_[kBufSize];
+    uint16_t ref_[kBufSize];
+};
+
+TEST_P(HbdSsimParmsTest, MatchTest) {
+    run_test(false);
+}
+
+TEST_P(HbdSsimParmsTest, ExtremeTest) {
+    run_test(true);
+}
+
+INSTANTIATE_TEST_CASE_P(AVX2, HbdSsimParmsTest,
+                        ::testing::Values(svt_aom_highbd_ssim_parms_8x8_avx2));
+#if EN_AVX512_SUPPORT
+INSTANTIATE_TEST_CASE_P(
+    AVX512, HbdSsimParmsTest,
+    ::testing::Values(svt_aom_highbd_ssim_parms_8x8_avx512));
+#endif
+
+}  // namespace
@@ -0,0 +1,166 @@
+/*
+ * Copyright(c) 2022 Intel Corporation
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * https://www.aomedia.org/license/patent-license.
+ */
+
+/******************************************************************************
+ * @file StatsFileTest.cc
+ *
+ * @brief Unit test of the multi-pass stats file:
+ * - svt_av1_init_stats_header
+ * - svt_av1_check_stats_header
+ * - svt_av1_map_stats / svt_av1_unmap_stats
+ *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include "gtest/gtest.h"
+#include "EbDefinitions.h"
+#include "EbRateControlProcess.h"
+#include "firstpass.h"
+#include "random.h"
+
+namespace {
+using svt_av1_test_tool::SVTRandom;
+
+static const char *kStatsPath = "StatsFileTest.stat";
+static const uint64_t kFrameCount = 40;
+
+class StatsFileTest : public ::testing::Test {
+  public:
+    StatsFileTest() : rnd_(0, 1000) {
+    }
+
+  protected:
+    void SetUp() override {
+        // kFrameCount frame records followed by the totals
+        stats_.resize(kFrameCount + 1);
+        svt_av1_twopass_zero_stats(&stats_[kFrameCount]);
+        for (uint64_t i = 0; i < kFrameCount; i++) {
+            FIRSTPASS_STATS *s = &stats_[i];
+            memset(s, 0, sizeof(*s));
+            s->frame = (double)i;
+            s->weight = rnd_.random() / 100.0;
+            s->intra_error = rnd_.random();
+            s->coded_error = rnd_.random();
+            s->sr_coded_error = rnd_.random();
+            s->pcnt_inter = rnd_.random() / 1000.0;
+            s->count = 1.0;
+            s->duration = 1.0;
+            s->stat_struct.poc = i;
+            s->stat_struct.total_num_bits = rnd_.random();
+            svt_av1_accumulate_stats(&stats_[kFrameCount], s);
+        }
+
+        SvtAv1StatsHeader header;
+        svt_av1_init_stats_header(&header,
+                                  stats_.size() * sizeof(FIRSTPASS_STATS));
+        FILE *file = fopen(kStatsPath, "wb");
+        ASSERT_NE(file, nullptr);
+        fwrite(&header, 1, sizeof(header), file);
+        fwrite(stats_.data(), sizeof(FIRSTPASS_STATS), stats_.size(), file);
+        fclose(file);
+    }
+
+    void TearDown() override {
+        remove(kStatsPath);
+    }
+
+    SVTRandom rnd_;
+    std::vector<FIRSTPASS_STATS> stats_;
+};
+
+TEST_F(StatsFileTest, CheckHeader) {
+    const uint64_t sz = sizeof(SvtAv1StatsHeader) +
+                        stats_.size() * sizeof(FIRSTPASS_STATS);
+    SvtAv1StatsHeader header;
+    svt_av1_init_stats_header(&header,
+                              stats_.size() * sizeof(FIRSTPASS_STATS));
+    EXPECT_EQ(header.frame_count, kFrameCount);
+    EXPECT_EQ(header.record_size, sizeof(FIRSTPASS_STATS));
+    EXPECT_TRUE(svt_av1_check_stats_header(&header, sz));
+    // truncated file
+    EXPECT_FALSE(svt_av1_check_stats_header(&header, sz - 1));
+    SvtAv1StatsHeader bad = header;
+    bad.version = SVT_AV1_STATS_VERSION + 1;
+    EXPECT_FALSE(svt_av1_check_stats_header(&bad, sz));
+    bad = header;
+    bad.record_size += 8;
+    EXPECT_FALSE(svt_av1_check_stats_header(&bad, sz));
+    // legacy stats without header
+    EXPECT_FALSE(svt_av1_check_stats_header(
+        (const SvtAv1StatsHeader *)stats_.data(), sz));
+}
+
+TEST_F(StatsFileTest, MapAll) {
+    SvtAv1FixedBuf buf;
+    ASSERT_EQ(svt_av1_map_stats(kStatsPath, 0, 0, &buf), EB_ErrorNone);
+    ASSERT_EQ(buf.sz, stats_.size() * sizeof(FIRSTPASS_STATS));
+    EXPECT_EQ(memcmp(buf.buf, stats_.data(), buf.sz), 0);
+    // the mapping is private, writing it must not change the file
+    ((FIRSTPASS_STATS *)buf.buf)[kFrameCount].count = -1.0;
+    svt_av1_unmap_stats(&buf);
+    EXPECT_EQ(buf.buf, nullptr);
+    EXPECT_EQ(buf.sz, 0u);
+
+    ASSERT_EQ(svt_av1_map_stats(kStatsPath, 0, kFrameCount, &buf),
+              EB_ErrorNone);
+    EXPECT_EQ(memcmp(buf.buf, stats_.data(), buf.sz), 0);
+    svt_av1_unmap_stats(&buf);
+}
+
+TEST_F(StatsFileTest, MapRange) {
+    const uint64_t ranges[][2] = {{0, 1}, {7, 9}, {13, 17}, {39, 1}};
+    for (const auto &range : ranges) {
+        const uint64_t first = range[0], count = range[1];
+        SvtAv1FixedBuf buf;
+        ASSERT_EQ(svt_av1_map_stats(kStatsPath, first, count, &buf),
+                  EB_ErrorNone);
+        ASSERT_EQ(buf.sz, (count + 1) * sizeof(FIRSTPASS_STATS));
+        const FIRSTPASS_STATS *s = (const FIRSTPASS_STATS *)buf.buf;
+        EXPECT_EQ(memcmp(s, &stats_[first], count * sizeof(*s)), 0)
+            << "range " << first << " " << count;
+
+        FIRSTPASS_STATS total;
+        uint64_t total_num_bits = 0;
+        svt_av1_twopass_zero_stats(&total);
+        for (uint64_t i = first; i < first + count; i++) {
+            svt_av1_accumulate_stats(&total, &stats_[i]);
+            total_num_bits += stats_[i].stat_struct.total_num_bits;
+        }
+        EXPECT_EQ(s[count].count, total.count);
+        EXPECT_EQ(s[count].duration, total.duration);
+        EXPECT_EQ(s[count].coded_error, total.coded_error);
+        EXPECT_EQ(s[count].stat_struct.total_num_bits, total_num_bits);
+        svt_av1_unmap_stats(&buf);
+    }
+}
+
+TEST_F(StatsFileTest, MapInvalid) {
+    SvtAv1FixedBuf buf;
+    EXPECT_EQ(svt_av1_map_stats(kStatsPath, kFrameCount, 0, &buf),
+              EB_ErrorBadParameter);
+    EXPECT_EQ(svt_av1_map_stats(kStatsPath, 30, 11, &buf),
+              EB_ErrorBadParameter);
+    EXPECT_EQ(svt_av1_map_stats("StatsFileTest.missing", 0, 0, &buf),
+              EB_ErrorBadParameter);
+    EXPECT_EQ(buf.buf, nullptr);
+
+    // legacy stats without header
+    FILE *file = fopen(kStatsPath, "wb");
+    ASSERT_NE(file, nullptr);
+    fwrite(stats_.data(), sizeof(FIRSTPASS_STATS), stats_.size(), file);
+    fclose(file);
+    EXPECT_EQ(svt_av1_map_stats(kStatsPath, 0, 0, &buf), EB_ErrorBadParameter);
+}
+
+}  // namespace
@@ -0,0 +1,414 @@
+/*
+ * Copyright(c) 2022 Intel Corporation
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * https://www.aomedia.org/license/patent-license.
+ */
+
+/******************************************************************************
+ * @file SystemResourceManagerTest.cc
+ *
+ * @brief Unit test of the system resource manager fifos:
+ * - ordering and non blocking get
+ * - multiple producers / multiple consumers
+ * - shutdown of a blocked consumer
+ * - occupancy and wait time statistics
+ * - throughput compared to a mutex + semaphore fifo (DISABLED_Speed)
+ *
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include "gtest/gtest.h"
+#include "EbSystemResourceManager.h"
+#include "EbThreads.h"
+#include "EbTime.h"
+
+namespace {
+
+typedef struct TestObject {
+    int32_t value;
+} TestObject;
+
+static EbErrorType test_object_creator(EbPtr *object_dbl_ptr,
+                                       EbPtr object_init_data_ptr) {
+    (void)object_init_data_ptr;
+    TestObject *obj = (TestObject *)calloc(1, sizeof(*obj));
+    if (!obj)
+        return EB_ErrorInsufficientResources;
+    *object_dbl_ptr = obj;
+    return EB_ErrorNone;
+}
+
+static void test_object_destroyer(EbPtr p) {
+    free(p);
+}
+
+static EbSystemResource *create_resource(uint32_t object_count,
+                                         uint32_t producer_count,
+                                         uint32_t consumer_count) {
+    EbSystemResource *res =
+        (EbSystemResource *)calloc(1, sizeof(EbSystemResource));
+    if (svt_system_resource_ctor(res,
+                                 object_count,
+                                 producer_count,
+                                 consumer_count,
+                                 test_object_creator,
+                                 NULL,
+                                 test_object_destroyer) != EB_ErrorNone) {
+        res->dctor(res);
+        free(res);
+        return NULL;
+    }
+    return res;
+}
+
+static void destroy_resource(EbSystemResource *res) {
+    res->dctor(res);
+    free(res);
+}
+
+static const int32_t kEndOfStream = -1;
+
+typedef struct WorkerContext {
+    EbSystemResource *res;
+    EbFifo *fifo;
+    int32_t count;  // objects to produce
+    int32_t first;  // first value produced
+    int64_t sum;    // sum of the values consumed
+    int32_t received;
+    EbErrorType status;
+} WorkerContext;
+
+static void *producer_kernel(void *input) {
+    WorkerContext *ctx = (WorkerContext *)input;
+    EbObjectWrapper *wrapper;
+    for (int32_t i = 0; i <= ctx->count; ++i) {
+        svt_get_empty_object(ctx->fifo, &wrapper);
+        ((TestObject *)wrapper->object_ptr)->value =
+            i == ctx->count ? kEndOfStream : ctx->first + i;
+        svt_post_full_object(wrapper);
+    }
+    return NULL;
+}
+
+static void *consumer_kernel(void *input) {
+    WorkerContext *ctx = (WorkerContext *)input;
+    EbObjectWrapper *wrapper;
+    for (;;) {
+        ctx->status = svt_get_full_object(ctx->fifo, &wrapper);
+        if (ctx->status != EB_ErrorNone)
+            break;
+        const int32_t value = ((TestObject *)wrapper->object_ptr)->value;
+        svt_release_object(wrapper);
+        if (value == kEndOfStream)
+            break;
+        ctx->sum += value;
+        ctx->received++;
+    }
+    return NULL;
+}
+
+TEST(SystemResourceManagerTest, FifoOrder) {
+    EbSystemResource *res = create_resource(6, 1, 1);
+    ASSERT_NE(res, nullptr);
+    EbFifo *producer = svt_system_resource_get_producer_fifo(res, 0);
+    EbFifo *consumer = svt_system_resource_get_consumer_fifo(res, 0);
+    EbObjectWrapper *wrapper;
+
+    // several laps of the ring, with partial fill
+    for (int32_t lap = 0; lap < 10; ++lap) {
+        const int32_t count = 1 + lap % 6;
+        for (int32_t i = 0; i < count; ++i) {
+            svt_get_empty_object(producer, &wrapper);
+            ((TestObject *)wrapper->object_ptr)->value = lap * 100 + i;
+            svt_post_full_object(wrapper);
+        }
+        for (int32_t i = 0; i < count; ++i) {
+            ASSERT_EQ(svt_get_full_object(consumer, &wrapper), EB_ErrorNone);
+            ASSERT_EQ(((TestObject *)wrapper->object_ptr)->value,
+                      lap * 100 + i);
+            svt_release_object(wrapper);
+        }
+        svt_get_full_object_non_blocking(consumer, &wrapper);
+        ASSERT_EQ(wrapper, nullptr);
+    }
+    destroy_resource(res);
+}
+
+TEST(SystemResourceManagerTest, LiveCount) {
+    EbSystemResource *res = create_resource(1, 1, 1);
+    ASSERT_NE(res, nullptr);
+    EbFifo *producer = svt_system_resource_get_producer_fifo(res, 0);
+    EbFifo *consumer = svt_system_resource_get_consumer_fifo(res, 0);
+    EbObjectWrapper *wrapper, *other;
+
+    svt_get_empty_object(producer, &wrapper);
+    svt_object_inc_live_count(wrapper, 2);
+    svt_post_full_object(wrapper);
+    ASSERT_EQ(svt_get_full_object(consumer, &other), EB_ErrorNone);
+    ASSERT_EQ(other, wrapper);
+
+    // the object goes back to the empty queue on the last release only
+    svt_release_object(wrapper);
+    ASSERT_EQ(wrapper->live_count, 1u);
+    svt_release_object(wrapper);
+    ASSERT_EQ(wrapper->live_count, (uint32_t)EB_ObjectWrapperReleasedValue);
+    svt_get_empty_object(producer, &other);
+    ASSERT_EQ(other, wrapper);
+    ASSERT_EQ(wrapper->live_count, 0u);
+    svt_release_object(other);
+    destroy_resource(res);
+}
+
+TEST(SystemResourceManagerTest, MultiProducerMultiConsumer) {
+    const uint32_t kProducers = 3, kConsumers = 3;
+    const int32_t kCount = 20000;
+    // the objects are recycled many times
+    EbSystemResource *res = create_resource(5, kProducers, kConsumers);
+    ASSERT_NE(res, nullptr);
+
+    WorkerContext producers[kProducers], consumers[kConsumers];
+    EbHandle threads[kProducers + kConsumers];
+    for (uint32_t i = 0; i < kConsumers; ++i) {
+        memset(&consumers[i], 0, sizeof(consumers[i]));
+        consumers[i].res = res;
+        consumers[i].fifo = svt_system_resource_get_consumer_fifo(res, i);
+        threads[i] = svt_create_thread(consumer_kernel, &consumers[i]);
+        ASSERT_NE(threads[i], nullptr);
+    }
+    for (uint32_t i = 0; i < kProducers; ++i) {
+        memset(&producers[i], 0, sizeof(producers[i]));
+        producers[i].res = res;
+        producers[i].fifo = svt_system_resource_get_producer_fifo(res, i);
+        producers[i].count = kCount;
+        producers[i].first = i * kCount;
+        threads[kConsumers + i] =
+            svt_create_thread(producer_kernel, &producers[i]);
+        ASSERT_NE(threads[kConsumers + i], nullptr);
+    }
+    // each producer ends with one end of stream, one per consumer
+    for (uint32_t i = 0; i < kProducers + kConsumers; ++i)
+        svt_destroy_thread(threads[i]);
+
+    int64_t sum = 0;
+    int32_t received = 0;
+    for (uint32_t i = 0; i < kConsumers; ++i) {
+        EXPECT_EQ(consumers[i].status, EB_ErrorNone);
+        sum += consumers[i].sum;
+        received += consumers[i].received;
+    }
+    const int64_t total = (int64_t)kProducers * kCount;
+    EXPECT_EQ(received, total);
+    EXPECT_EQ(sum, total * (total - 1) / 2);
+    destroy_resource(res);
+}
+
+TEST(SystemResourceManagerTest, Shutdown) {
+    const uint32_t kConsumers = 2;
+    EbSystemResource *res = create_resource(4, 1, kConsumers);
+    ASSERT_NE(res, nullptr);
+
+    WorkerContext consumers[kConsumers];
+    EbHandle threads[kConsumers];
+    for (uint32_t i = 0; i < kConsumers; ++i) {
+        memset(&consumers[i], 0, sizeof(consumers[i]));
+        consumers[i].res = res;
+        consumers[i].fifo = svt_system_resource_get_consumer_fifo(res, i);
+        threads[i] = svt_create_thread(consumer_kernel, &consumers[i]);
+        ASSERT_NE(threads[i], nullptr);
+    }
+    svt_shutdown_process(res);
+    for (uint32_t i = 0; i < kConsumers; ++i) {
+        svt_destroy_thread(threads[i]);
+        EXPECT_EQ(consumers[i].status, EB_NoErrorFifoShutdown);
+    }
+
+    // no object is handed out once the queue is shut down
+    EbObjectWrapper *wrapper;
+    svt_get_empty_object(svt_system_resource_get_producer_fifo(res, 0),
+                         &wrapper);
+    svt_post_full_object(wrapper);
+    EXPECT_EQ(svt_get_full_object(consumers[0].fifo, &wrapper),
+              EB_NoErrorFifoShutdown);
+    EXPECT_EQ(wrapper, nullptr);
+    svt_get_full_object_non_blocking(consumers[0].fifo, &wrapper);
+    EXPECT_EQ(wrapper, nullptr);
+    destroy_resource(res);
+}
+
+TEST(SystemResourceManagerTest, Stats) {
+    EbSystemResource *res = create_resource(4, 1, 1);
+    ASSERT_NE(res, nullptr);
+    EbFifo *producer = svt_system_resource_get_producer_fifo(res, 0);
+    EbSystemResourceStats stats;
+    EbObjectWrapper *wrapper[2];
+
+    svt_get_empty_object(producer, &wrapper[0]);
+    svt_get_empty_object(producer, &wrapper[1]);
+    ((TestObject *)wrapper[0]->object_ptr)->value = 1;
+    svt_post_full_object(wrapper[0]);
+    svt_system_resource_get_stats(res, &stats);
+    EXPECT_EQ(stats.object_total_count, 4u);
+    EXPECT_EQ(stats.empty_count, 2u);
+    EXPECT_EQ(stats.full_count, 1u);
+    EXPECT_EQ(stats.full_get_count, 0u);
+    EXPECT_EQ(stats.producer_wait_time, 0u);
+    EXPECT_EQ(stats.consumer_wait_time, 0u);
+
+    // the consumer takes the queued object then sleeps on the empty queue,
+    // the ongoing sleep is included in the wait time
+    WorkerContext consumer;
+    memset(&consumer, 0, sizeof(consumer));
+    consumer.res = res;
+    consumer.fifo = svt_system_resource_get_consumer_fifo(res, 0);
+    EbHandle thread = svt_create_thread(consumer_kernel, &consumer);
+    ASSERT_NE(thread, nullptr);
+    do {
+        svt_system_resource_get_stats(res, &stats);
+    } while (stats.consumer_wait_time < 1000);
+    EXPECT_EQ(stats.full_count, 0u);
+    EXPECT_EQ(stats.full_get_count, 1u);
+
+    ((TestObject *)wrapper[1]->object_ptr)->value = kEndOfStream;
+    svt_post_full_object(wrapper[1]);
+    svt_destroy_thread(thread);
+    EXPECT_EQ(consumer.received, 1);
+
+    svt_system_resource_get_stats(res, &stats);
+    EXPECT_EQ(stats.empty_count, 4u);
+    EXPECT_EQ(stats.full_get_count, 2u);
+    EXPECT_GE(stats.consumer_wait_time, 1000u);
+    destroy_resource(res);
+}
+
+// Reference fifo with the locking scheme of the original resource manager:
+// one mutex protected list per queue and a counting semaphore.
+typedef struct RefQueue {
+    EbHandle mutex;
+    EbHandle semaphore;
+    TestObject **array;
+    uint32_t size, head, count;
+} RefQueue;
+
+static void ref_queue_init(RefQueue *q, uint32_t size) {
+    q->mutex = svt_create_mutex();
+    q->semaphore = svt_create_semaphore(0, size);
+    q->array = (TestObject **)calloc(size, sizeof(*q->array));
+    q->size = size;
+    q->head = q->count = 0;
+}
+
+static void ref_queue_deinit(RefQueue *q) {
+    svt_destroy_semaphore(q->semaphore);
+    svt_destroy_mutex(q->mutex);
+    free(q->array);
+}
+
+static void ref_queue_push(RefQueue *q, TestObject *obj) {
+    svt_block_on_mutex(q->mutex);
+    q->array[(q->head + q->count++) % q->size] = obj;
+    svt_release_mutex(q->mutex);
+    svt_post_semaphore(q->semaphore);
+}
+
+static TestObject *ref_queue_pop(RefQueue *q) {
+    svt_block_on_semaphore(q->semaphore);
+    svt_block_on_mutex(q->mutex);
+    TestObject *obj = q->array[q->head];
+    q->head = (q->head + 1) % q->size;
+    q->count--;
+    svt_release_mutex(q->mutex);
+    return obj;
+}
+
+typedef struct RefContext {
+    RefQueue *empty_queue;
+    RefQueue *full_queue;
+    int32_t count;
+    int64_t sum;
+} RefContext;
+
+static void *ref_producer_kernel(void *input) {
+    RefContext *ctx = (RefContext *)input;
+    for (int32_t i = 0; i <= ctx->count; ++i) {
+        TestObject *obj = ref_queue_pop(ctx->empty_queue);
+        obj->value = i == ctx->count ? kEndOfStream : i;
+        ref_queue_push(ctx->full_queue, obj);
+    }
+    return NULL;
+}
+
+static void *ref_consumer_kernel(void *input) {
+    RefContext *ctx = (RefContext *)input;
+    for (;;) {
+        TestObject *obj = ref_queue_pop(ctx->full_queue);
+        const int32_t value = obj->value;
+        ref_queue_push(ctx->empty_queue, obj);
+        if (value == kEndOfStream)
+            break;
+        ctx->sum += value;
+    }
+    return NULL;
+}
+
+TEST(SystemResourceManagerTest, DISABLED_Speed) {
+    const uint32_t kObjects = 8;
+    const int32_t kCount = 1000000;
+    uint64_t start_s, start_us, finish_s, finish_us;
+    EbHandle threads[2];
+
+    // lock-free fifo of the resource manager
+    EbSystemResource *res = create_resource(kObjects, 1, 1);
+    ASSERT_NE(res, nullptr);
+    WorkerContext producer, consumer;
+    memset(&producer, 0, sizeof(producer));
+    memset(&consumer, 0, sizeof(consumer));
+    producer.res = consumer.res = res;
+    producer.fifo = svt_system_resource_get_producer_fifo(res, 0);
+    producer.count = kCount;
+    consumer.fifo = svt_system_resource_get_consumer_fifo(res, 0);
+    svt_av1_get_time(&start_s, &start_us);
+    threads[0] = svt_create_thread(consumer_kernel, &consumer);
+    threads[1] = svt_create_thread(producer_kernel, &producer);
+    svt_destroy_thread(threads[0]);
+    svt_destroy_thread(threads[1]);
+    svt_av1_get_time(&finish_s, &finish_us);
+    const double time_srm = svt_av1_compute_overall_elapsed_time_ms(
+        start_s, start_us, finish_s, finish_us);
+    EXPECT_EQ(consumer.received, kCount);
+    destroy_resource(res);
+
+    // mutex + semaphore reference
+    RefQueue empty_queue, full_queue;
+    TestObject objects[kObjects];
+    ref_queue_init(&empty_queue, kObjects);
+    ref_queue_init(&full_queue, kObjects);
+    for (uint32_t i = 0; i < kObjects; ++i)
+        ref_queue_push(&empty_queue, &objects[i]);
+    RefContext ref_ctx[2] = {{&empty_queue, &full_queue, kCount, 0},
+                             {&empty_queue, &full_queue, kCount, 0}};
+    svt_av1_get_time(&start_s, &start_us);
+    threads[0] = svt_create_thread(ref_consumer_kernel, &ref_ctx[0]);
+    threads[1] = svt_create_thread(ref_producer_kernel, &ref_ctx[1]);
+    svt_destroy_thread(threads[0]);
+    svt_destroy_thread(threads[1]);
+    svt_av1_get_time(&finish_s, &finish_us);
+    const double time_ref = svt_av1_compute_overall_elapsed_time_ms(
+        start_s, start_us, finish_s, finish_us);
+    EXPECT_EQ(ref_ctx[0].sum, consumer.sum);
+    ref_queue_deinit(&empty_queue);
+    ref_queue_deinit(&full_queue);
+
+    printf("%d objects: lock-free fifo %6.2f ms, mutex fifo %6.2f ms (x%.2f)\n",
+           kCount,
+           time_srm,
+           time_ref,
+           time_ref / time_srm);
+}
+
+}  // namespace
@@ -18,6 +18,9 @@
  * @author Cidana-Edmond, Cidana-Ryan, Cidana-Wenyao
  *
  ******************************************************************************/
+#include <stdint.h>
+#include <string.h>
+#include <vector>
 #include "EbSvtAv1Enc.h"
 #include "gtest/gtest.h"
 #include "SvtAv1EncApiTest.h"
@@ -100,6 +103,8 @@ TEST(EncApiTest, check_null_pointer) {
     // return value, just feed nullptr as parameter. release output buffer with
     // null pointer
     svt_av1_enc_release_out_buffer(nullptr);
+    // reconfigure encoder with null pointer
+    EXPECT_EQ(EB_ErrorBadParameter, svt_av1_enc_reconfigure(nullptr, nullptr));
     // close encoder with null pointer
     EXPECT_EQ(EB_ErrorBadParameter, svt_av1_enc_deinit(nullptr));
     // destory encoder handle with null pointer
@@ -203,4 +208,177 @@ TEST(EncApiTest, DISABLED_repeat_normal_setup) {
     }
 }
 
+/** Encodes frame_count synthetic 8-bit frames in VBR, calls
+ *  svt_av1_enc_reconfigure() with reconfig (when not null) before sending
+ *  the frame switch_frame, and returns the bytes of the packets of each
+ *  frame, indexed by pts */
+static std::vector<uint32_t> encode_vbr_stream(
+    const SvtAv1EncReconfig *reconfig, uint32_t switch_frame,
+    uint32_t frame_count) {
+    std::vector<uint32_t> sizes(frame_count, 0);
+    SvtAv1Context context;
+    memset(&context, 0, sizeof(context));
+
+    const uint32_t width = 320;
+    const uint32_t height = 240;
+
+    EXPECT_EQ(EB_ErrorNone,
+              svt_av1_enc_init_handle(
+                  &context.enc_handle, &context, &context.enc_params))
+        << "svt_av1_enc_init_handle failed";
+    EbSvtAv1EncConfiguration &params = context.enc_params;
+    params.source_width = width;
+    params.source_height = height;
+    params.enc_mode = 10;
+    params.rate_control_mode = 1;
+    params.intra_period_length = 31;
+    params.target_bit_rate = 200000;
+    params.superres_mode = SUPERRES_FIXED;
+    params.superres_denom = 8;
+    params.superres_kf_denom = 8;
+    params.superres_reconfig = TRUE;
+    params.logical_processors = 1;
+    EXPECT_EQ(EB_ErrorNone,
+              svt_av1_enc_set_parameter(context.enc_handle, &params))
+        << "svt_av1_enc_set_parameter failed";
+    EXPECT_EQ(EB_ErrorNone, svt_av1_enc_init(context.enc_handle))
+        << "svt_av1_enc_init failed";
+
+    std::vector<uint8_t> frame(width * height * 3 / 2);
+    uint32_t seed = 1;
+    bool eos = false;
+    for (uint32_t i = 0; i <= frame_count && !eos; ++i) {
+        EbBufferHeaderType header;
+        memset(&header, 0, sizeof(header));
+        header.size = sizeof(header);
+        header.pic_type = EB_AV1_INVALID_PICTURE;
+        EbSvtIOFormat io;
+        memset(&io, 0, sizeof(io));
+        if (i < frame_count) {
+            // moving gradient with some noise, so that every frame costs
+            // bits and a reduced width shows in the frame sizes
+            for (uint32_t y = 0; y < height; ++y) {
+                for (uint32_t x = 0; x < width; ++x) {
+                    seed = seed * 1103515245 + 12345;
+                    frame[y * width + x] =
+                        (uint8_t)(((x + 2 * i) ^ (y + i)) + (seed >> 28));
+                }
+            }
+            memset(&frame[width * height], 128, width * height / 2);
+            io.luma = frame.data();
+            io.cb = io.luma + width * height;
+            io.cr = io.cb + width * height / 4;
+            io.y_stride = width;
+            io.cb_stride = width / 2;
+            io.cr_stride = width / 2;
+            header.p_buffer = (uint8_t *)&io;
+            header.n_filled_len = (uint32_t)frame.size();
+            header.pts = i;
+            if (reconfig && i == switch_frame) {
+                EXPECT_EQ(EB_ErrorNone,
+                          svt_av1_enc_reconfigure(context.enc_handle,
+                                                  reconfig))
+                    << "svt_av1_enc_reconfigure failed";
+            }
+        } else
+            header.flags = EB_BUFFERFLAG_EOS;
+        EXPECT_EQ(EB_ErrorNone,
+                  svt_av1_enc_send_picture(context.enc_handle, &header))
+            << "svt_av1_enc_send_picture failed";
+
+        for (;;) {
+            EbBufferHeaderType *packet = NULL;
+            const EbErrorType ret = svt_av1_enc_get_packet(
+                context.enc_handle, &packet, i == frame_count);
+            if (ret == EB_NoErrorEmptyQueue)
+                break;
+            EXPECT_EQ(EB_ErrorNone, ret) << "svt_av1_enc_get_packet failed";
+            if (ret != EB_ErrorNone) {
+                eos = true;
+                break;
+            }
+            if (packet->pts >= 0 && packet->pts < (int64_t)frame_count)
+                sizes[packet->pts] += packet->n_filled_len;
+            eos = (packet->flags & EB_BUFFERFLAG_EOS) != 0;
+            svt_av1_enc_release_out_buffer(&packet);
+            if (eos)
+                break;
+        }
+    }
+
+    EXPECT_EQ(EB_ErrorNone, svt_av1_enc_deinit(context.enc_handle))
+        << "svt_av1_enc_deinit failed";
+    EXPECT_EQ(EB_ErrorNone, svt_av1_enc_deinit_handle(context.enc_handle))
+        << "svt_av1_enc_deinit_handle failed";
+    return sizes;
+}
+
+/** @brief reconfigure_rate_and_superres is a api test case
+ * EncApiTest.reconfigure_rate_and_superres is a test case to check that
+ * svt_av1_enc_reconfigure() changes the target bitrate and the
+ * super-resolution denominator of a running encode
+ *
+ * Test strategy: <br>
+ * Encode the same frames twice in VBR, the second time raise the target
+ * bitrate and reduce the coded width (superres_denom 16) in the middle of
+ * the stream. Compare the bytes of the frames after the change in both
+ * encodes. Also check that a superres_denom change is rejected without
+ * superres_reconfig.
+ *
+ * Expected result: <br>
+ * The frames after the change take more bytes in the reconfigured encode.
+ *
+ * Test coverage:
+ * svt_av1_enc_reconfigure
+ */
+TEST(EncApiTest, reconfigure_rate_and_superres) {
+    const uint32_t frame_count = 64;
+    const uint32_t switch_frame = 32;
+
+    SvtAv1EncReconfig reconfig;
+    memset(&reconfig, 0, sizeof(reconfig));
+    reconfig.target_bit_rate = 1000000;
+    reconfig.superres_denom = 16;
+
+    const std::vector<uint32_t> ref_sizes =
+        encode_vbr_stream(NULL, switch_frame, frame_count);
+    const std::vector<uint32_t> sizes =
+        encode_vbr_stream(&reconfig, switch_frame, frame_count);
+
+    uint64_t ref_bytes = 0, bytes = 0;
+    for (uint32_t i = switch_frame; i < frame_count; ++i) {
+        EXPECT_NE(0u, sizes[i]) << "frame " << i << " is missing";
+        ref_bytes += ref_sizes[i];
+        bytes += sizes[i];
+    }
+    EXPECT_GT(bytes, ref_bytes) << "the reconfigure did not raise the rate";
+
+    // superres_denom needs superres_reconfig
+    SvtAv1Context context;
+    memset(&context, 0, sizeof(context));
+    ASSERT_EQ(EB_ErrorNone,
+              svt_av1_enc_init_handle(
+                  &context.enc_handle, &context, &context.enc_params))
+        << "svt_av1_enc_init_handle failed";
+    context.enc_params.source_width = 320;
+    context.enc_params.source_height = 240;
+    context.enc_params.rate_control_mode = 1;
+    context.enc_params.intra_period_length = 31;
+    context.enc_params.superres_mode = SUPERRES_FIXED;
+    context.enc_params.superres_denom = 9;
+    EXPECT_EQ(EB_ErrorNone,
+              svt_av1_enc_set_parameter(context.enc_handle,
+                                        &context.enc_params))
+        << "svt_av1_enc_set_parameter failed";
+    EXPECT_EQ(EB_ErrorNone, svt_av1_enc_init(context.enc_handle))
+        << "svt_av1_enc_init failed";
+    EXPECT_EQ(EB_ErrorBadParameter,
+              svt_av1_enc_reconfigure(context.enc_handle, &reconfig))
+        << "superres_denom accepted without superres_reconfig";
+    EXPECT_EQ(EB_ErrorNone, svt_av1_enc_deinit(context.enc_handle))
+        << "svt_av1_enc_deinit failed";
+    EXPECT_EQ(EB_ErrorNone, svt_av1_enc_deinit_handle(context.enc_handle))
+        << "svt_av1_enc_deinit_handle failed";
+}
+
 }  // namespace
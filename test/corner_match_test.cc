@@ -157,4 +157,11 @@ INSTANTIATE_TEST_CASE_P(
                       make_tuple(0, &svt_av1_compute_cross_correlation_avx2),
                       make_tuple(1, &svt_av1_compute_cross_correlation_avx2)));
 
+#if EN_AVX512_SUPPORT
+INSTANTIATE_TEST_CASE_P(
+    AV1CornerMatchTestAVX512, AV1CornerMatchTest,
+    ::testing::Values(make_tuple(0, &svt_av1_compute_cross_correlation_avx512),
+                      make_tuple(1, &svt_av1_compute_cross_correlation_avx512)));
+#endif
+
 }  // namespace